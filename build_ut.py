@@ -37,6 +37,7 @@ suiteInfo = {
     "client" : {"suite" : "RialtoClientUnitTests", "path" : "/tests/media/client/main/"},
     "clientipc" : {"suite" : "RialtoClientIpcUnitTests", "path" : "/tests/media/client/ipc/"},
     "common" : {"suite" : "RialtoPlayerCommonUnitTests", "path" : "/tests/media/common/"},
+    "rialtocommon" : {"suite" : "RialtoCommonUnitTests", "path" : "/tests/common/"},
     "logging" : {"suite" : "RialtoLoggingUnitTests", "path" : "/tests/logging/"},
     "manager" : {"suite" : "RialtoServerManagerUnitTests", "path" : "/tests/serverManager/"},
     "ipc" : {"suite" : "RialtoIpcUnitTests", "path" : "/tests/ipc/"},
@@ -21,12 +21,10 @@
 #define FIREBOLT_RIALTO_COMMON_EVENT_THREAD_H_
 
 #include "IEventThread.h"
+#include "MpscQueue.h"
 #include <atomic>
-#include <condition_variable>
 #include <functional>
-#include <list>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -55,9 +53,7 @@ private:
 private:
     const std::string m_kThreadName;
 
-    std::list<std::function<void()>> m_funcs;
-    std::mutex m_lock;
-    std::condition_variable m_cond;
+    MpscQueue<std::function<void()>> m_funcs;
 
     std::atomic<bool> m_shutdown;
     std::thread m_thread;
@@ -23,10 +23,15 @@
 #include "ITimer.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <thread>
+#include <vector>
 
 namespace firebolt::rialto::common
 {
@@ -45,6 +50,117 @@ public:
                                         TimerType timerType = TimerType::ONE_SHOT) const override;
 };
 
+/**
+ * @brief Single thread, that expires all the timers of the process.
+ *
+ * Pending timers are kept in a min-heap ordered by their deadline. The thread blocks on a timerfd, that is armed for
+ * the earliest deadline. Callbacks are executed on the timer thread, one at a time.
+ */
+class TimerService
+{
+public:
+    /**
+     * @brief State of a single timer, shared between the timer object and the service.
+     */
+    struct Entry
+    {
+        std::function<void()> callback;                 /**< Function called after timeout. */
+        std::chrono::milliseconds timeout;              /**< Timeout, and period of the periodic timers. */
+        TimerType timerType;                            /**< Type of timer. */
+        std::chrono::steady_clock::time_point deadline; /**< The next expiry time. */
+        std::atomic<bool> active{true};                 /**< Whether the timer is armed or running. */
+    };
+
+    /**
+     * @brief Gets the timer service of the process.
+     *
+     * The service is created on first use and lives until the process exits, so that timers can be cancelled
+     * safely from static destructors and from their own callbacks.
+     *
+     * @retval the timer service.
+     */
+    static TimerService &instance();
+
+    TimerService(const TimerService &) = delete;
+    TimerService(TimerService &&) = delete;
+    TimerService &operator=(const TimerService &) = delete;
+    TimerService &operator=(TimerService &&) = delete;
+
+    /**
+     * @brief Arms a new timer.
+     *
+     * @param[in] timeout   : Timeout after which callback will be called
+     * @param[in] callback  : Function which is called after timeout
+     * @param[in] timerType : Type of timer
+     *
+     * @retval the armed timer entry.
+     */
+    std::shared_ptr<Entry> arm(const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
+                               TimerType timerType);
+
+    /**
+     * @brief Cancels the timer.
+     *
+     * If the callback of the timer is being executed, waits for it to finish, unless called from the callback.
+     *
+     * @param[in] entry : The timer entry.
+     */
+    void cancel(const std::shared_ptr<Entry> &entry);
+
+    /**
+     * @brief Gets the number of timers in the heap, including the cancelled ones that are not removed yet.
+     *
+     * @retval the number of scheduled timers.
+     */
+    std::size_t getNumOfScheduledTimers();
+
+private:
+    /**
+     * @brief Timer entry in the heap, with the deadline it was scheduled for.
+     */
+    struct ScheduledEntry
+    {
+        std::chrono::steady_clock::time_point deadline; /**< The deadline at the time of scheduling. */
+        std::shared_ptr<Entry> entry;                   /**< The scheduled timer. */
+
+        bool operator>(const ScheduledEntry &other) const { return deadline > other.deadline; }
+    };
+
+    TimerService();
+    ~TimerService() = default;
+
+    /**
+     * @brief The loop of the timer thread.
+     */
+    void timerThreadLoop();
+
+    /**
+     * @brief Executes the callbacks of expired timers. Must be called with m_mutex locked.
+     *
+     * @param[in] lock : The lock of m_mutex.
+     */
+    void expireTimers(std::unique_lock<std::mutex> &lock);
+
+    /**
+     * @brief Arms the timerfd for the earliest deadline, or disarms it. Must be called with m_mutex locked.
+     */
+    void updateTimerFd();
+
+    /**
+     * @brief Removes cancelled timers from the heap, when they make up most of it. Must be called with m_mutex locked.
+     */
+    void compactHeap();
+
+    int m_timerFd;
+    std::mutex m_mutex;
+    std::condition_variable m_callbackDoneCv;
+    std::priority_queue<ScheduledEntry, std::vector<ScheduledEntry>, std::greater<ScheduledEntry>> m_heap;
+    std::size_t m_numOfCancelledEntries;
+    std::chrono::steady_clock::time_point m_timerFdDeadline;
+    std::shared_ptr<Entry> m_runningEntry;
+    std::thread m_thread;
+};
+
 class Timer : public ITimer
 {
 public:
@@ -60,12 +176,7 @@ public:
     bool isActive() const override;
 
 private:
-    std::atomic<bool> m_active;
-    std::chrono::milliseconds m_timeout;
-    std::function<void()> m_callback;
-    mutable std::mutex m_mutex;
-    std::thread m_thread;
-    std::condition_variable m_cv;
+    std::shared_ptr<TimerService::Entry> m_entry;
 };
 } // namespace firebolt::rialto::common
 
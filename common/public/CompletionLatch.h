@@ -0,0 +1,92 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_COMPLETION_LATCH_H_
+#define FIREBOLT_RIALTO_COMMON_COMPLETION_LATCH_H_
+
+#include "Futex.h"
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief One shot latch, that a thread waits on until another thread marks the work as done.
+ *
+ * Sleeps on a futex, so it needs no mutex or condition variable and can live on the stack of the waiting thread.
+ * The thread marking the latch as done enters the kernel only if the other thread is already asleep.
+ */
+class CompletionLatch
+{
+public:
+    CompletionLatch() = default;
+    ~CompletionLatch() = default;
+    CompletionLatch(const CompletionLatch &) = delete;
+    CompletionLatch(CompletionLatch &&) = delete;
+    CompletionLatch &operator=(const CompletionLatch &) = delete;
+    CompletionLatch &operator=(CompletionLatch &&) = delete;
+
+    /**
+     * @brief Marks the work as done and wakes the waiting threads.
+     */
+    void setDone()
+    {
+        if (m_state.exchange(kDone, std::memory_order_acq_rel) == kWaiting)
+        {
+            futexWake(m_state, INT_MAX);
+        }
+    }
+
+    /**
+     * @brief Blocks until the work is marked as done.
+     */
+    void wait()
+    {
+        std::uint32_t state{kPending};
+        if (!m_state.compare_exchange_strong(state, kWaiting, std::memory_order_acquire) && state == kDone)
+        {
+            return;
+        }
+        while (m_state.load(std::memory_order_acquire) != kDone)
+        {
+            futexWait(m_state, kWaiting);
+        }
+    }
+
+    /**
+     * @brief Checks if the work is marked as done.
+     *
+     * @retval true if done.
+     */
+    bool isDone() const { return m_state.load(std::memory_order_acquire) == kDone; }
+
+private:
+    static constexpr std::uint32_t kPending{0};
+    static constexpr std::uint32_t kWaiting{1};
+    static constexpr std::uint32_t kDone{2};
+
+    /**
+     * @brief The futex word holding the state of the latch.
+     */
+    std::atomic<std::uint32_t> m_state{kPending};
+};
+} // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_COMPLETION_LATCH_H_
@@ -0,0 +1,58 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_FUTEX_H_
+#define FIREBOLT_RIALTO_COMMON_FUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace firebolt::rialto::common
+{
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex word must be a plain 32 bit integer");
+
+/**
+ * @brief Blocks the calling thread, while the futex word holds the expected value.
+ *
+ * May return spuriously, the caller has to check the value again.
+ *
+ * @param[in] word      : The futex word.
+ * @param[in] expected  : The value, that the word has to hold for the thread to sleep.
+ */
+inline void futexWait(std::atomic<std::uint32_t> &word, std::uint32_t expected)
+{
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief Wakes threads blocked on the futex word.
+ *
+ * @param[in] word          : The futex word.
+ * @param[in] numOfThreads  : The maximum number of threads to wake.
+ */
+inline void futexWake(std::atomic<std::uint32_t> &word, int numOfThreads)
+{
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE_PRIVATE, numOfThreads, nullptr, nullptr, 0);
+}
+} // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_FUTEX_H_
@@ -0,0 +1,310 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_MPSC_QUEUE_H_
+#define FIREBOLT_RIALTO_COMMON_MPSC_QUEUE_H_
+
+#include "Futex.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief Unbounded multi producer, single consumer queue.
+ *
+ * Any thread may push, but only one thread at a time may pop. Pushing never blocks: a producer swaps the head
+ * pointer and links the previous head to its node. The elements are stored inline in the queue nodes, which come
+ * from a fixed pool, so that a queue that stays within the pool size does not allocate. When the pool is exhausted,
+ * nodes are allocated on the heap and freed again when popped.
+ *
+ * The consumer can sleep on a futex, while the queue is empty. Producers enter the kernel only if it does.
+ */
+template <typename T> class MpscQueue
+{
+public:
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] poolSize : The number of preallocated nodes.
+     */
+    explicit MpscQueue(std::uint32_t poolSize) : m_poolSize{poolSize}, m_pool{new Node[poolSize]}
+    {
+        for (std::uint32_t i = 0; i < m_poolSize; ++i)
+        {
+            m_pool[i].index = i;
+            m_pool[i].nextFree.store(i + 1 < m_poolSize ? i + 2 : 0, std::memory_order_relaxed);
+        }
+        m_freeList.store(m_poolSize > 0 ? 1 : 0, std::memory_order_relaxed);
+
+        Node *stub = acquireNode();
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+
+    /**
+     * @brief The destructor. Destroys the elements left in the queue.
+     */
+    ~MpscQueue()
+    {
+        while (popNode())
+        {
+        }
+        releaseNode(m_tail);
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue(MpscQueue &&) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+    MpscQueue &operator=(MpscQueue &&) = delete;
+
+    /**
+     * @brief Adds an element at the end of the queue. Can be called from any thread.
+     *
+     * @param[in] value : The element to add.
+     */
+    void push(T &&value)
+    {
+        Node *node = acquireNode();
+        new (node->storage) T(std::move(value));
+        node->next.store(nullptr, std::memory_order_relaxed);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        Node *previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+
+        wakeConsumer();
+    }
+
+    /**
+     * @brief Removes the element at the front of the queue, if any. Can be called only from the consumer thread.
+     *
+     * @param[out] value : The removed element.
+     *
+     * @retval true if an element was removed.
+     */
+    bool tryPop(T &value)
+    {
+        Node *next = m_tail->next.load(std::memory_order_acquire);
+        if (!next)
+        {
+            return false;
+        }
+        T *element = next->getValue();
+        value = std::move(*element);
+        element->~T();
+        releaseNode(m_tail);
+        m_tail = next;
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Removes the element at the front of the queue, sleeping while the queue is empty. Can be called only
+     *        from the consumer thread.
+     *
+     * Returns without an element, when the queue is closed or on a spurious wake up.
+     *
+     * @param[out] value : The removed element.
+     *
+     * @retval true if an element was removed.
+     */
+    bool popOrWait(T &value)
+    {
+        if (tryPop(value))
+        {
+            return true;
+        }
+        m_isConsumerWaiting.store(true, std::memory_order_seq_cst);
+        const std::uint32_t kSequence{m_sequence.load(std::memory_order_seq_cst)};
+        bool isPopped{tryPop(value)};
+        if (!isPopped && !m_isClosed.load(std::memory_order_seq_cst))
+        {
+            futexWait(m_sequence, kSequence);
+        }
+        m_isConsumerWaiting.store(false, std::memory_order_relaxed);
+        return isPopped || tryPop(value);
+    }
+
+    /**
+     * @brief Wakes the consumer sleeping in popOrWait() and makes further calls return without sleeping, so that
+     *        the consumer can check its shutdown condition. Elements can still be pushed and popped.
+     */
+    void close()
+    {
+        m_isClosed.store(true, std::memory_order_seq_cst);
+        wakeConsumer();
+    }
+
+    /**
+     * @brief Checks if the queue is empty. Can be called only from the consumer thread.
+     *
+     * @retval true if there is no element to pop.
+     */
+    bool isEmpty() const { return !m_tail->next.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Gets the number of elements in the queue. Can be called from any thread.
+     *
+     * @retval the number of elements, approximate while the queue is modified concurrently.
+     */
+    std::size_t getSize() const { return m_size.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Node of the queue, holding a single element.
+     */
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};           /**< The next node in the queue. */
+        std::atomic<std::uint32_t> nextFree{0};      /**< The next free pool node, as index + 1, 0 if none. */
+        std::uint32_t index{kNotPooled};             /**< The index of the node in the pool. */
+        alignas(T) unsigned char storage[sizeof(T)]; /**< The storage of the element. */
+
+        T *getValue() { return reinterpret_cast<T *>(storage); }
+    };
+
+    static constexpr std::uint32_t kNotPooled{std::numeric_limits<std::uint32_t>::max()};
+    static constexpr std::uint64_t kIndexMask{0xFFFFFFFFULL};
+    static constexpr std::uint64_t kTagIncrement{0x100000000ULL};
+
+    /**
+     * @brief Takes a node from the pool, or allocates it, if the pool is exhausted. Can be called from any thread.
+     */
+    Node *acquireNode()
+    {
+        // The free list head carries a tag, that changes on every update, so a stale compare exchange cannot succeed
+        std::uint64_t freeList{m_freeList.load(std::memory_order_acquire)};
+        while ((freeList & kIndexMask) != 0)
+        {
+            Node &node = m_pool[(freeList & kIndexMask) - 1];
+            const std::uint64_t kNewFreeList{((freeList & ~kIndexMask) + kTagIncrement) |
+                                             node.nextFree.load(std::memory_order_relaxed)};
+            if (m_freeList.compare_exchange_weak(freeList, kNewFreeList, std::memory_order_acquire,
+                                                 std::memory_order_acquire))
+            {
+                return &node;
+            }
+        }
+        return new Node{};
+    }
+
+    /**
+     * @brief Returns the node to the pool, or frees it, if it was allocated on the heap.
+     */
+    void releaseNode(Node *node)
+    {
+        if (node->index == kNotPooled)
+        {
+            delete node;
+            return;
+        }
+        std::uint64_t freeList{m_freeList.load(std::memory_order_relaxed)};
+        std::uint64_t newFreeList{0};
+        do
+        {
+            node->nextFree.store(static_cast<std::uint32_t>(freeList & kIndexMask), std::memory_order_relaxed);
+            newFreeList = ((freeList & ~kIndexMask) + kTagIncrement) | (node->index + 1);
+        } while (!m_freeList.compare_exchange_weak(freeList, newFreeList, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Removes and destroys the element at the front of the queue, if any.
+     */
+    bool popNode()
+    {
+        Node *next = m_tail->next.load(std::memory_order_acquire);
+        if (!next)
+        {
+            return false;
+        }
+        next->getValue()->~T();
+        releaseNode(m_tail);
+        m_tail = next;
+        return true;
+    }
+
+    /**
+     * @brief Wakes the consumer, if it sleeps in popOrWait().
+     */
+    void wakeConsumer()
+    {
+        m_sequence.fetch_add(1, std::memory_order_seq_cst);
+        // Only the first producer after the consumer went to sleep enters the kernel
+        if (m_isConsumerWaiting.load(std::memory_order_seq_cst) &&
+            m_isConsumerWaiting.exchange(false, std::memory_order_seq_cst))
+        {
+            futexWake(m_sequence, 1);
+        }
+    }
+
+    /**
+     * @brief The number of preallocated nodes.
+     */
+    const std::uint32_t m_poolSize;
+
+    /**
+     * @brief The preallocated nodes.
+     */
+    std::unique_ptr<Node[]> m_pool;
+
+    /**
+     * @brief The head of the free node list, the index + 1 of the first free node and a tag in the upper half.
+     */
+    std::atomic<std::uint64_t> m_freeList{0};
+
+    /**
+     * @brief The most recently pushed node, updated by the producers.
+     */
+    std::atomic<Node *> m_head{nullptr};
+
+    /**
+     * @brief The futex word, incremented on every push and when the queue is closed.
+     */
+    std::atomic<std::uint32_t> m_sequence{0};
+
+    /**
+     * @brief Whether close() was called.
+     */
+    std::atomic<bool> m_isClosed{false};
+
+    /**
+     * @brief Whether the consumer is about to sleep or sleeps in popOrWait() and has not been woken yet.
+     */
+    std::atomic<bool> m_isConsumerWaiting{false};
+
+    /**
+     * @brief The number of elements in the queue.
+     */
+    std::atomic<std::size_t> m_size{0};
+
+    /**
+     * @brief The node preceding the front element, owned by the consumer.
+     */
+    Node *m_tail{nullptr};
+};
+} // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_MPSC_QUEUE_H_
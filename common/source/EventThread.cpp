@@ -18,14 +18,22 @@
  */
 
 #include "EventThread.h"
+#include "CompletionLatch.h"
 #include "RialtoCommonLogging.h"
 
 #include <pthread.h>
-#include <semaphore.h>
 #include <unistd.h>
 
 namespace firebolt::rialto::common
 {
+namespace
+{
+/**
+ * @brief The number of queued functions, that the event thread holds without allocating queue nodes.
+ */
+constexpr std::uint32_t kFuncPoolSize{32};
+} // namespace
+
 std::shared_ptr<IEventThreadFactory> IEventThreadFactory::createFactory()
 {
     std::shared_ptr<IEventThreadFactory> factory;
@@ -47,20 +55,17 @@ std::unique_ptr<IEventThread> EventThreadFactory::createEventThread(std::string
     return std::make_unique<EventThread>(threadName);
 }
 
-EventThread::EventThread(std::string threadName) : m_kThreadName(std::move(threadName)), m_shutdown(false)
+EventThread::EventThread(std::string threadName)
+    : m_kThreadName(std::move(threadName)), m_funcs(kFuncPoolSize), m_shutdown(false)
 {
     m_thread = std::thread(&EventThread::threadExecutor, this);
 }
 
 EventThread::~EventThread()
 {
-    std::unique_lock<std::mutex> locker(m_lock);
-
     m_shutdown = true;
 
-    m_cond.notify_all();
-
-    locker.unlock();
+    m_funcs.close();
 
     if (m_thread.joinable())
         m_thread.join();
@@ -73,50 +78,33 @@ void EventThread::threadExecutor()
         pthread_setname_np(pthread_self(), m_kThreadName.c_str());
     }
 
-    std::unique_lock<std::mutex> locker(m_lock);
-
-    while (true)
+    std::function<void()> func;
+    while (!m_shutdown)
     {
-        while (!m_shutdown && m_funcs.empty())
-            m_cond.wait(locker);
-
-        if (m_shutdown)
-            break;
-
-        std::function<void()> func = std::move(m_funcs.front());
-        m_funcs.pop_front();
-
-        m_lock.unlock();
+        if (!m_funcs.popOrWait(func) || m_shutdown)
+            continue;
 
         if (func)
             func();
 
-        m_lock.lock();
+        func = nullptr;
     }
 }
 
 void EventThread::flush()
 {
-    sem_t semaphore;
-    sem_init(&semaphore, 0, 0);
-
-    // add a simple function to release the semaphore in the context of the event thread
-    addImpl(
-        [sem = &semaphore]()
-        {
-            if (sem_post(sem) != 0)
-                RIALTO_COMMON_LOG_SYS_ERROR(errno, "failed to signal semaphore");
-        });
-
-    // wait for the above call to unblock the semaphore
-    TEMP_FAILURE_RETRY(sem_wait(&semaphore));
+    CompletionLatch completion;
+
+    // add a simple function to mark the latch as done in the context of the event thread
+    addImpl([&completion]() { completion.setDone(); });
+
+    // wait for the above call to release the latch
+    completion.wait();
 }
 
 void EventThread::addImpl(std::function<void()> &&func)
 {
-    std::lock_guard<std::mutex> locker(m_lock);
-    m_funcs.emplace_back(std::move(func));
-    m_cond.notify_all();
+    m_funcs.push(std::move(func));
 }
 
 }; // namespace firebolt::rialto::common
@@ -20,6 +20,12 @@
 #include "Timer.h"
 #include "RialtoCommonLogging.h"
 
+#include <algorithm>
+#include <pthread.h>
+#include <stdexcept>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
 namespace firebolt::rialto::common
 {
 std::weak_ptr<ITimerFactory> TimerFactory::m_factory;
@@ -51,46 +57,184 @@ std::unique_ptr<ITimer> TimerFactory::createTimer(const std::chrono::millisecond
     return std::make_unique<Timer>(timeout, callback, timerType);
 }
 
-Timer::Timer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback, TimerType timerType)
-    : m_active{true}, m_timeout{timeout}, m_callback{callback}
+TimerService &TimerService::instance()
+{
+    // Intentionally never destroyed, see the header
+    static TimerService *service{new TimerService()};
+    return *service;
+}
+
+TimerService::TimerService() : m_timerFd{-1}, m_numOfCancelledEntries{0}
+{
+    m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (m_timerFd < 0)
+    {
+        RIALTO_COMMON_LOG_SYS_ERROR(errno, "Failed to create timerfd");
+        throw std::runtime_error("Failed to create timerfd");
+    }
+    m_thread = std::thread(&TimerService::timerThreadLoop, this);
+}
+
+std::shared_ptr<TimerService::Entry> TimerService::arm(const std::chrono::milliseconds &timeout,
+                                                       const std::function<void()> &callback, TimerType timerType)
 {
-    m_thread = std::thread(
-        [this, timerType]()
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    entry->callback = callback;
+    entry->timeout = timeout;
+    entry->timerType = timerType;
+    entry->deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_heap.push(ScheduledEntry{entry->deadline, entry});
+    updateTimerFd();
+    return entry;
+}
+
+void TimerService::cancel(const std::shared_ptr<Entry> &entry)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (entry->active.exchange(false) && m_runningEntry != entry)
+    {
+        // The entry stays in the heap until it expires or the heap is compacted
+        ++m_numOfCancelledEntries;
+        compactHeap();
+    }
+    if (std::this_thread::get_id() != m_thread.get_id())
+    {
+        m_callbackDoneCv.wait(lock, [&]() { return m_runningEntry != entry; });
+    }
+}
+
+std::size_t TimerService::getNumOfScheduledTimers()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_heap.size();
+}
+
+void TimerService::timerThreadLoop()
+{
+    pthread_setname_np(pthread_self(), "rialto-timer");
+    while (true)
+    {
+        uint64_t numOfExpirations{0};
+        if (read(m_timerFd, &numOfExpirations, sizeof(numOfExpirations)) < 0 && EINTR != errno)
         {
-            do
-            {
-                std::unique_lock<std::mutex> lock{m_mutex};
-                if (!m_cv.wait_until(lock, std::chrono::system_clock::now() + m_timeout, [this]() { return !m_active; }))
-                {
-                    if (m_active && m_callback)
-                    {
-                        lock.unlock();
-                        m_callback();
-                    }
-                }
-            } while (timerType == TimerType::PERIODIC && m_active);
-            m_active = false;
-        });
+            RIALTO_COMMON_LOG_SYS_ERROR(errno, "Failed to read timerfd");
+        }
+
+        std::unique_lock<std::mutex> lock{m_mutex};
+        expireTimers(lock);
+        updateTimerFd();
+    }
 }
 
-Timer::~Timer()
+void TimerService::expireTimers(std::unique_lock<std::mutex> &lock)
 {
-    cancel();
+    auto now = std::chrono::steady_clock::now();
+    while (!m_heap.empty() && m_heap.top().deadline <= now)
+    {
+        std::shared_ptr<Entry> entry = m_heap.top().entry;
+        m_heap.pop();
+        if (!entry->active)
+        {
+            --m_numOfCancelledEntries;
+            continue;
+        }
+
+        m_runningEntry = entry;
+        lock.unlock();
+        if (entry->callback)
+        {
+            entry->callback();
+        }
+        lock.lock();
+        m_runningEntry.reset();
+
+        now = std::chrono::steady_clock::now();
+        if (TimerType::PERIODIC == entry->timerType && entry->active)
+        {
+            entry->deadline = now + entry->timeout;
+            m_heap.push(ScheduledEntry{entry->deadline, entry});
+        }
+        else
+        {
+            entry->active = false;
+        }
+        m_callbackDoneCv.notify_all();
+    }
 }
 
-void Timer::cancel()
+void TimerService::updateTimerFd()
 {
-    m_active = false;
+    std::chrono::steady_clock::time_point deadline{};
+    if (!m_heap.empty())
+    {
+        deadline = m_heap.top().deadline;
+    }
+    if (deadline == m_timerFdDeadline)
+    {
+        return;
+    }
 
-    if (std::this_thread::get_id() != m_thread.get_id() && m_thread.joinable())
+    // A zero deadline disarms the timerfd. Deadlines in the past expire immediately.
+    itimerspec spec{};
+    if (!m_heap.empty())
     {
-        m_cv.notify_one();
-        m_thread.join();
+        auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+        spec.it_value.tv_sec = std::max<int64_t>(sinceEpoch.count() / 1000000000, 0);
+        spec.it_value.tv_nsec = std::max<int64_t>(sinceEpoch.count() % 1000000000, 1);
     }
+    if (timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+    {
+        RIALTO_COMMON_LOG_SYS_ERROR(errno, "Failed to arm timerfd");
+        return;
+    }
+    m_timerFdDeadline = deadline;
+}
+
+void TimerService::compactHeap()
+{
+    constexpr std::size_t kMinNumOfCancelledEntries{64};
+    if (m_numOfCancelledEntries < kMinNumOfCancelledEntries || m_numOfCancelledEntries * 2 < m_heap.size())
+    {
+        return;
+    }
+
+    std::vector<ScheduledEntry> activeEntries;
+    activeEntries.reserve(m_heap.size() - m_numOfCancelledEntries);
+    while (!m_heap.empty())
+    {
+        if (m_heap.top().entry->active)
+        {
+            activeEntries.push_back(m_heap.top());
+        }
+        m_heap.pop();
+    }
+    for (auto &scheduledEntry : activeEntries)
+    {
+        m_heap.push(std::move(scheduledEntry));
+    }
+    m_numOfCancelledEntries = 0;
+    updateTimerFd();
+}
+
+Timer::Timer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback, TimerType timerType)
+    : m_entry{TimerService::instance().arm(timeout, callback, timerType)}
+{
+}
+
+Timer::~Timer()
+{
+    cancel();
+}
+
+void Timer::cancel()
+{
+    TimerService::instance().cancel(m_entry);
 }
 
 bool Timer::isActive() const
 {
-    return m_active;
+    return m_entry->active;
 }
 } // namespace firebolt::rialto::common
@@ -134,6 +134,31 @@ public:
      */
     virtual bool process() = 0;
 
+    /**
+     * @brief Starts batching the method calls made on the channel from the calling thread.
+     *
+     * \threadsafe
+     *
+     * The method calls made from the thread are not sent until flushBatch() is called from the
+     * same thread, which sends them to the server together in a single message.  The server makes
+     * the calls in order and sends all their replies back together.  Calls made from other threads
+     * are not affected.
+     *
+     * As the calls are only sent by flushBatch(), their closures must not be waited on before it is
+     * called.  Calls passing file descriptors are not batched, they are sent on their own after the
+     * calls batched so far.
+     */
+    virtual void beginBatch() = 0;
+
+    /**
+     * @brief Sends the method calls batched since beginBatch() was called from the calling thread.
+     *
+     * \threadsafe
+     *
+     * @retval true on success, false if no batch was started or the calls could not be sent.
+     */
+    virtual bool flushBatch() = 0;
+
     /**
      * @brief Subscribe for event message.
      *
@@ -92,8 +92,9 @@ std::shared_ptr<IChannel> ChannelFactory::createChannel(const std::string &socke
 }
 
 ChannelImpl::ChannelImpl(int sock)
-    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1), m_serialCounter(1), m_defaultTimeout(3000),
-      m_eventTagCounter(1)
+    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1), m_serialCounter(1), m_framedMessages(false),
+      m_numericIds(false), m_multiCalls(false), m_ringDoorbellFd(-1), m_ringSending(false),
+      m_socketBehindRing(false), m_defaultTimeout(3000), m_numOfBatches(0), m_eventTagCounter(1)
 {
     if (!attachSocket(sock))
     {
@@ -112,8 +113,9 @@ ChannelImpl::ChannelImpl(int sock)
 }
 
 ChannelImpl::ChannelImpl(const std::string &socketPath)
-    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1), m_serialCounter(1), m_defaultTimeout(3000),
-      m_eventTagCounter(1)
+    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1), m_serialCounter(1), m_framedMessages(false),
+      m_numericIds(false), m_multiCalls(false), m_ringDoorbellFd(-1), m_ringSending(false),
+      m_socketBehindRing(false), m_defaultTimeout(3000), m_numOfBatches(0), m_eventTagCounter(1)
 {
     if (!createConnectedSocket(socketPath))
     {
@@ -253,9 +255,124 @@ bool ChannelImpl::initChannel()
         return false;
     }
 
+    return sendCapabilities();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Tells the server which optional transport features the channel supports.
+    Until the server replies with the features it supports, method calls are
+    sent as legacy transport messages, so a server that doesn't know about the
+    capabilities message just ignores it.
+
+ */
+bool ChannelImpl::sendCapabilities()
+{
+    transport::MessageToServer message;
+    message.mutable_capabilities()->set_framed_messages(true);
+    message.mutable_capabilities()->set_numeric_ids(true);
+    message.mutable_capabilities()->set_multi_call(true);
+    message.mutable_capabilities()->set_shm_ring(true);
+
+    const std::string data = message.SerializeAsString();
+    if (TEMP_FAILURE_RETRY(send(m_sock, data.data(), data.size(), MSG_NOSIGNAL)) != static_cast<ssize_t>(data.size()))
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the transport capabilities");
+        return false;
+    }
+
     return true;
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Creates the shared memory rings and passes them to the server, called once
+    the server has said it supports them.  The server starts writing to the
+    response ring once it has attached them, and the channel switches to the
+    request ring when it reads the start record.
+
+    \note Must be called while holding the m_receiveLock mutex.
+
+ */
+bool ChannelImpl::setupRing()
+{
+    std::unique_ptr<ShmRingTransport> ring = ShmRingTransport::create();
+    if (!ring)
+        return false;
+
+    epoll_event ringEvent = {.events = EPOLLIN, .data = {.fd = ring->doorbellFd()}};
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, ring->doorbellFd(), &ringEvent) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add ring doorbell");
+        return false;
+    }
+
+    transport::MessageToServer message;
+    transport::RingSetup *ringSetup = message.mutable_ring_setup();
+    ringSetup->set_memory(ring->memoryFd());
+    ringSetup->set_server_doorbell(ring->serverDoorbellFd());
+    ringSetup->set_client_doorbell(ring->clientDoorbellFd());
+    ringSetup->set_ring_capacity(ring->ringCapacity());
+
+    std::shared_ptr<msghdr> header =
+        populateMessage(message, {ring->memoryFd(), ring->serverDoorbellFd(), ring->clientDoorbellFd()});
+
+    std::lock_guard<std::mutex> locker(m_lock);
+
+    if (!header || (m_sock < 0) ||
+        (sendmsg(m_sock, header.get(), MSG_NOSIGNAL) != static_cast<ssize_t>(header->msg_iov[0].iov_len)))
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the ring setup");
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_DEL, ring->doorbellFd(), nullptr) != 0)
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to remove ring doorbell");
+        return false;
+    }
+
+    m_ringDoorbellFd = ring->doorbellFd();
+    m_ring = std::move(ring);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends a message to the server, on the request ring once the server reads
+    it.  Messages passing fds, or too big for the ring, are sent on the socket
+    with a barrier record in the ring.  If the ring is full, waits for the
+    server to make room for up to the default timeout.
+
+    \note Must be called while holding the m_lock mutex.
+
+ */
+bool ChannelImpl::sendNoLock(const struct msghdr *msg, size_t length)
+{
+    if (!m_ringSending)
+        return sendmsg(m_sock, msg, MSG_NOSIGNAL) == static_cast<ssize_t>(length);
+
+    const auto deadline = std::chrono::steady_clock::now() + m_defaultTimeout;
+    bool sent = false;
+    if ((msg->msg_controllen == 0) && (length <= m_ring->maxMessageLength()))
+    {
+        sent = m_ring->waitForRoom(length, deadline) && m_ring->send(ShmRing::RecordType::MESSAGE, msg);
+    }
+    else if (m_ring->waitForRoom(0, deadline) &&
+             (sendmsg(m_sock, msg, MSG_NOSIGNAL) == static_cast<ssize_t>(length)))
+    {
+        struct msghdr barrier = {nullptr};
+        sent = m_ring->send(ShmRing::RecordType::BARRIER, &barrier);
+    }
+
+    m_ring->flush();
+
+    return sent;
+}
+
 void ChannelImpl::termChannel()
 {
     // close the socket and the epoll and timer fds
@@ -268,6 +385,8 @@ void ChannelImpl::termChannel()
     if ((m_eventFd >= 0) && (close(m_eventFd) != 0))
         RIALTO_IPC_LOG_SYS_ERROR(errno, "closing event fd failed");
 
+    m_ring.reset();
+
     // if any method calls are still outstanding then complete them with errors now
     for (auto &entry : m_methodCalls)
     {
@@ -376,8 +495,8 @@ bool ChannelImpl::process()
     if (!isConnected())
         return false;
 
-    struct epoll_event events[3];
-    int rc = TEMP_FAILURE_RETRY(epoll_wait(m_epollFd, events, 3, 0));
+    struct epoll_event events[4];
+    int rc = TEMP_FAILURE_RETRY(epoll_wait(m_epollFd, events, 4, 0));
     if (rc < 0)
     {
         RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_wait failed");
@@ -388,7 +507,8 @@ bool ChannelImpl::process()
     {
         HaveSocketEvent = 0x1,
         HaveTimeoutEvent = 0x2,
-        HaveWakeEvent = 0x4
+        HaveWakeEvent = 0x4,
+        HaveRingEvent = 0x8
     };
     unsigned eventsMask = 0;
     for (int i = 0; i < rc; i++)
@@ -399,11 +519,16 @@ bool ChannelImpl::process()
             eventsMask |= HaveTimeoutEvent;
         else if (events[i].data.fd == m_eventFd)
             eventsMask |= HaveWakeEvent;
+        else if (events[i].data.fd == m_ringDoorbellFd)
+            eventsMask |= HaveRingEvent;
     }
 
     if ((eventsMask & HaveSocketEvent) && !processSocketEvent())
         return false;
 
+    if ((eventsMask & HaveRingEvent) && !processRingEvent())
+        return false;
+
     if (eventsMask & HaveTimeoutEvent)
         processTimeoutEvent();
 
@@ -435,32 +560,60 @@ bool ChannelImpl::unsubscribe(int eventTag)
 /*!
     \internal
 
+    Called from process() when the socket is readable.
 
  */
 bool ChannelImpl::processSocketEvent()
 {
+    std::lock_guard<std::mutex> receiveLocker(m_receiveLock);
+    return readSocketMessages();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Reads and processes all the messages available on the socket.  The server
+    sends the events of a dispatch cycle together, so the messages are read
+    in batches of up to 8 per recvmmsg() call.
+
+    Once the server writes to the response ring, the messages are queued to
+    be processed when their barrier records are read from the ring.
+
+    \note Must be called while holding the m_receiveLock mutex.
+
+ */
+bool ChannelImpl::readSocketMessages()
+{
+    const unsigned kMaxBatch = 8;
+
     static std::mutex bufLock;
     std::lock_guard<std::mutex> bufLocker(bufLock);
 
-    static std::vector<uint8_t> dataBuf(m_kMaxMessageSize);
-    static std::vector<uint8_t> ctrlBuf(CMSG_SPACE(SCM_MAX_FD * sizeof(int)));
+    static std::vector<uint8_t> dataBufs(kMaxBatch * m_kMaxMessageSize);
+    static std::vector<uint8_t> ctrlBufs(kMaxBatch * CMSG_SPACE(SCM_MAX_FD * sizeof(int)));
+    const size_t kCtrlBufSize = ctrlBufs.size() / kMaxBatch;
+
+    struct iovec ios[kMaxBatch];
+    struct mmsghdr msgs[kMaxBatch];
 
     // read all messages from the client socket, we break out if the socket is closed
     // or EWOULDBLOCK is returned on a read (ie. no more messages to read)
     while (true)
     {
-        struct msghdr msg = {nullptr};
-        struct iovec io = {.iov_base = dataBuf.data(), .iov_len = dataBuf.size()};
-
-        bzero(&msg, sizeof(msg));
-        msg.msg_iov = &io;
-        msg.msg_iovlen = 1;
-        msg.msg_control = ctrlBuf.data();
-        msg.msg_controllen = ctrlBuf.size();
+        bzero(msgs, sizeof(msgs));
+        for (unsigned i = 0; i < kMaxBatch; i++)
+        {
+            ios[i] = {.iov_base = dataBufs.data() + (i * m_kMaxMessageSize), .iov_len = m_kMaxMessageSize};
+            msgs[i].msg_hdr.msg_iov = &ios[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = ctrlBufs.data() + (i * kCtrlBufSize);
+            msgs[i].msg_hdr.msg_controllen = kCtrlBufSize;
+        }
 
-        // read one message
-        ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(m_sock, &msg, MSG_CMSG_CLOEXEC));
-        if (rd < 0)
+        // read a batch of messages
+        int numMsgs = TEMP_FAILURE_RETRY(recvmmsg(m_sock, msgs, kMaxBatch, MSG_CMSG_CLOEXEC, nullptr));
+        if (numMsgs < 0)
         {
             if (errno != EWOULDBLOCK)
             {
@@ -473,36 +626,130 @@ bool ChannelImpl::processSocketEvent()
 
             break;
         }
-        else if (rd == 0)
+
+        for (int i = 0; i < numMsgs; i++)
         {
-            // server closed connection, and we've read all data
-            RIALTO_IPC_LOG_INFO("socket remote end closed, disconnecting channel");
+            struct msghdr &msg = msgs[i].msg_hdr;
+            const size_t rd = msgs[i].msg_len;
+            if (rd == 0)
+            {
+                // server closed connection, and we've read all data
+                RIALTO_IPC_LOG_INFO("socket remote end closed, disconnecting channel");
 
-            std::lock_guard<std::mutex> locker(m_lock);
-            disconnectNoLock();
-            return false;
+                std::lock_guard<std::mutex> locker(m_lock);
+                disconnectNoLock();
+                return false;
+            }
+            else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+            {
+                RIALTO_IPC_LOG_WARN("received truncated message from server, discarding");
+
+                // make sure to close all the fds, otherwise we'll leak them, this
+                // will read the fds and return in a vector, which will then be
+                // destroyed, closing all the fds
+                readMessageFds(&msg, 16);
+            }
+            else
+            {
+                // if there is control data then assume fd(s) have been passed
+                std::vector<FileDescriptor> fds;
+                if (msg.msg_controllen > 0)
+                {
+                    fds = readMessageFds(&msg, 32);
+                }
+
+                // process the message from the server, unless it has to wait for its barrier
+                const auto *data = reinterpret_cast<const uint8_t *>(ios[i].iov_base);
+                if (m_socketBehindRing)
+                    m_socketMessages.emplace_back(ReceivedMessage{std::vector<uint8_t>(data, data + rd), std::move(fds)});
+                else
+                    processServerMessage(data, rd, &fds);
+            }
         }
-        else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+
+        // a partial batch means there's nothing more to read
+        if (numMsgs < static_cast<int>(kMaxBatch))
+            break;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Called from process() when the server has rung the doorbell of the channel,
+    processes the records written to the response ring.  A barrier record
+    stands for the next message on the socket, which the server sends there
+    because it passes fds or doesn't fit in the ring.
+
+ */
+bool ChannelImpl::processRingEvent()
+{
+    std::lock_guard<std::mutex> receiveLocker(m_receiveLock);
+    if (!m_ring)
+        return true;
+
+    m_ring->clearDoorbell();
+
+    ShmRing::Record record;
+    ShmRing::ReadStatus status;
+    while ((status = m_ring->receive(&record)) == ShmRing::ReadStatus::RECORD)
+    {
+        if (record.type == ShmRing::RecordType::MESSAGE)
+        {
+            std::vector<FileDescriptor> fds;
+            processServerMessage(record.data, record.length, &fds);
+            m_ring->release();
+        }
+        else if ((record.type == ShmRing::RecordType::START) && !m_socketBehindRing)
         {
-            RIALTO_IPC_LOG_WARN("received truncated message from server, discarding");
+            // the messages the server sent on the socket before switching to the ring come first
+            m_ring->release();
+            if (!readSocketMessages())
+                return false;
+
+            m_socketBehindRing = true;
 
-            // make sure to close all the fds, otherwise we'll leak them, this
-            // will read the fds and return in a vector, which will then be
-            // destroyed, closing all the fds
-            readMessageFds(&msg, 16);
+            // and tell the server the calls are sent on the request ring from now on, the ring
+            // is still empty so there's room for the start record
+            std::lock_guard<std::mutex> locker(m_lock);
+            struct msghdr start = {nullptr};
+            m_ring->send(ShmRing::RecordType::START, &start);
+            m_ring->flush();
+            m_ringSending = true;
         }
-        else
+        else if ((record.type == ShmRing::RecordType::BARRIER) && m_socketBehindRing)
         {
-            // if there is control data then assume fd(s) have been passed
-            std::vector<FileDescriptor> fds;
-            if (msg.msg_controllen > 0)
+            // the server sends the message before the barrier, so it's either queued or can be read now
+            m_ring->release();
+            if (m_socketMessages.empty() && !readSocketMessages())
+                return false;
+            if (m_socketMessages.empty())
             {
-                fds = readMessageFds(&msg, 32);
+                RIALTO_IPC_LOG_ERROR("missing socket message for barrier in response ring");
+                continue;
             }
 
-            // process the message from the server
-            processServerMessage(dataBuf.data(), rd, &fds);
+            ReceivedMessage message = std::move(m_socketMessages.front());
+            m_socketMessages.pop_front();
+            processServerMessage(message.data.data(), message.data.size(), &message.fds);
         }
+        else
+        {
+            status = ShmRing::ReadStatus::CORRUPT;
+            break;
+        }
+    }
+
+    if (status == ShmRing::ReadStatus::CORRUPT)
+    {
+        RIALTO_IPC_LOG_ERROR("invalid record in response ring, disconnecting channel");
+
+        std::lock_guard<std::mutex> locker(m_lock);
+        disconnectNoLock();
+        return false;
     }
 
     return true;
@@ -649,6 +896,13 @@ void ChannelImpl::updateTimeoutTimer()
  */
 void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std::vector<FileDescriptor> *fds)
 {
+    // once the server knows the channel supports them, it sends frames rather than transport messages
+    if (isFrame(data, dataLen))
+    {
+        processServerFrame(data, dataLen, fds);
+        return;
+    }
+
     // parse the message
     transport::MessageFromServer message;
     if (!message.ParseFromArray(data, static_cast<int>(dataLen)))
@@ -660,15 +914,36 @@ void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std:
     // check if an event or a reply to a request
     if (message.has_reply())
     {
-        processReplyFromServer(message.reply(), fds);
+        const std::string &replyMessage = message.reply().reply_message();
+        processReplyFromServer(message.reply().reply_id(), reinterpret_cast<const uint8_t *>(replyMessage.data()),
+                               replyMessage.size(), fds);
     }
     else if (message.has_error())
     {
-        processErrorFromServer(message.error());
+        processErrorFromServer(message.error().reply_id(), message.error().error_reason());
     }
     else if (message.has_event())
     {
-        processEventFromServer(message.event(), fds);
+        const std::string &eventMessage = message.event().message();
+        processEventFromServer(message.event().event_name(), reinterpret_cast<const uint8_t *>(eventMessage.data()),
+                               eventMessage.size(), fds);
+    }
+    else if (message.has_capabilities())
+    {
+        const transport::TransportCapabilities &capabilities = message.capabilities();
+        RIALTO_IPC_LOG_INFO("server %s framed messages, %s numeric ids, %s multi calls, %s shm rings",
+                            capabilities.framed_messages() ? "supports" : "doesn't support",
+                            capabilities.numeric_ids() ? "supports" : "doesn't support",
+                            capabilities.multi_call() ? "supports" : "doesn't support",
+                            capabilities.shm_ring() ? "supports" : "doesn't support");
+
+        m_numericIds = capabilities.framed_messages() && capabilities.numeric_ids();
+        m_framedMessages = capabilities.framed_messages();
+        m_multiCalls = capabilities.multi_call();
+
+        // calls are sent on the socket until the server has attached the rings
+        if (capabilities.shm_ring() && !m_ring && !setupRing())
+            RIALTO_IPC_LOG_WARN("failed to set up the shm rings, staying on the socket");
     }
     else
     {
@@ -676,24 +951,95 @@ void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std:
     }
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes a single framed message from the server, the payload is parsed
+    straight from the receive buffer.
+
+ */
+void ChannelImpl::processServerFrame(const uint8_t *data, size_t dataLen, std::vector<FileDescriptor> *fds)
+{
+    FrameHeader frame;
+    if (!readFrameHeader(data, dataLen, &frame))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid frame from server");
+        return;
+    }
+
+    const uint8_t *payload = data + sizeof(FrameHeader) + frame.nameLength;
+    const size_t payloadLen = dataLen - sizeof(FrameHeader) - frame.nameLength;
+
+    switch (frame.type)
+    {
+    case FrameType::REPLY:
+        processReplyFromServer(frame.serial, payload, payloadLen, fds);
+        break;
+    case FrameType::ERROR:
+        processErrorFromServer(frame.serial, std::string(reinterpret_cast<const char *>(payload), payloadLen));
+        break;
+    case FrameType::EVENT:
+        processEventFrame(frame, data, payload, payloadLen, fds);
+        break;
+    default:
+        RIALTO_IPC_LOG_ERROR("unexpected frame type %u from server", static_cast<unsigned>(frame.type));
+        break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes an event frame, the event type is either identified by the name
+    in the frame, or by an id the server defined in an earlier frame.
+
+ */
+void ChannelImpl::processEventFrame(const FrameHeader &frame, const uint8_t *data, const uint8_t *payload,
+                                    size_t payloadLen, std::vector<FileDescriptor> *fds)
+{
+    if ((frame.id == kFrameNoId) || (frame.flags & kFrameFlagDefinesId))
+    {
+        std::string eventName(reinterpret_cast<const char *>(data + sizeof(FrameHeader)), frame.nameLength);
+        if (frame.id != kFrameNoId)
+        {
+            if (frame.id >= m_eventNames.size())
+                m_eventNames.resize(frame.id + 1);
+
+            m_eventNames[frame.id] = eventName;
+        }
+
+        processEventFromServer(eventName, payload, payloadLen, fds);
+    }
+    else if ((frame.id < m_eventNames.size()) && !m_eventNames[frame.id].empty())
+    {
+        processEventFromServer(m_eventNames[frame.id], payload, payloadLen, fds);
+    }
+    else
+    {
+        RIALTO_IPC_LOG_ERROR("event with unknown id %u from server", static_cast<unsigned>(frame.id));
+    }
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
 
 
  */
-void ChannelImpl::processReplyFromServer(const transport::MethodCallReply &reply, std::vector<FileDescriptor> *fds)
+void ChannelImpl::processReplyFromServer(uint64_t serialId, const uint8_t *data, size_t dataLen,
+                                         std::vector<FileDescriptor> *fds)
 {
     RIALTO_IPC_LOG_DEBUG("processing reply from server");
 
     std::unique_lock<std::mutex> locker(m_lock);
 
     // find the original request
-    const uint64_t serialId = reply.reply_id();
     auto it = m_methodCalls.find(serialId);
     if (it == m_methodCalls.end())
     {
-        RIALTO_IPC_LOG_ERROR("failed to find request for received reply with id %" PRIu64 "", reply.reply_id());
+        RIALTO_IPC_LOG_ERROR("failed to find request for received reply with id %" PRIu64 "", serialId);
         return;
     }
 
@@ -708,7 +1054,7 @@ void ChannelImpl::processReplyFromServer(const transport::MethodCallReply &reply
     locker.unlock();
 
     // this is an actual reply so try and read it
-    if (!methodCall.response->ParseFromString(reply.reply_message()))
+    if (!methodCall.response->ParseFromArray(data, static_cast<int>(dataLen)))
     {
         RIALTO_IPC_LOG_ERROR("failed to parse method reply from server");
         completeWithError(&methodCall, "Failed to parse reply message");
@@ -733,18 +1079,17 @@ void ChannelImpl::processReplyFromServer(const transport::MethodCallReply &reply
 
 
  */
-void ChannelImpl::processErrorFromServer(const transport::MethodCallError &error)
+void ChannelImpl::processErrorFromServer(uint64_t serialId, const std::string &reason)
 {
     RIALTO_IPC_LOG_DEBUG("processing error from server");
 
     std::unique_lock<std::mutex> locker(m_lock);
 
     // find the original request
-    const uint64_t serialId = error.reply_id();
     auto it = m_methodCalls.find(serialId);
     if (it == m_methodCalls.end())
     {
-        RIALTO_IPC_LOG_ERROR("failed to find request for received reply with id %" PRIu64 "", error.reply_id());
+        RIALTO_IPC_LOG_ERROR("failed to find request for received reply with id %" PRIu64 "", serialId);
         return;
     }
 
@@ -758,10 +1103,10 @@ void ChannelImpl::processErrorFromServer(const transport::MethodCallError &error
     // can now drop the lock
     locker.unlock();
 
-    RIALTO_IPC_LOG_DEBUG("error{ serial %" PRIu64 " } - %s", serialId, error.error_reason().c_str());
+    RIALTO_IPC_LOG_DEBUG("error{ serial %" PRIu64 " } - %s", serialId, reason.c_str());
 
     // complete the call with an error
-    completeWithError(&methodCall, error.error_reason());
+    completeWithError(&methodCall, reason);
 }
 
 // -----------------------------------------------------------------------------
@@ -770,12 +1115,11 @@ void ChannelImpl::processErrorFromServer(const transport::MethodCallError &error
 
 
  */
-void ChannelImpl::processEventFromServer(const transport::EventFromServer &event, std::vector<FileDescriptor> *fds)
+void ChannelImpl::processEventFromServer(const std::string &eventName, const uint8_t *data, size_t dataLen,
+                                         std::vector<FileDescriptor> *fds)
 {
     RIALTO_IPC_LOG_DEBUG("processing event from server");
 
-    const std::string &eventName = event.event_name();
-
     std::lock_guard<std::mutex> locker(m_eventsLock);
 
     auto range = m_eventHandlers.equal_range(eventName);
@@ -802,7 +1146,7 @@ void ChannelImpl::processEventFromServer(const transport::EventFromServer &event
         return;
     }
 
-    if (!message->ParseFromString(event.message()))
+    if (!message->ParseFromArray(data, static_cast<int>(dataLen)))
     {
         RIALTO_IPC_LOG_ERROR("failed to parse message for event %s", eventName.c_str());
     }
@@ -1057,6 +1401,109 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     //
     const uint64_t serialId = m_serialCounter++;
 
+    // check if the method is expecting a reply
+    const bool noReplyExpected = method->options().HasExtension(::firebolt::rialto::ipc::no_reply) &&
+                                 method->options().GetExtension(::firebolt::rialto::ipc::no_reply);
+
+    // extract the fds from the message
+    const std::vector<int> fds = getMessageFds(*request);
+
+    // calls made by a thread with an open batch are sent by flushBatch()
+    if (m_numOfBatches > 0)
+    {
+        std::unique_lock<std::mutex> locker(m_lock);
+        auto batch = m_batches.find(std::this_thread::get_id());
+        if ((batch != m_batches.end()) && fds.empty())
+        {
+            batch->second.emplace_back(
+                BatchedCall{serialId, method, request->SerializeAsString(), noReplyExpected, methodCall});
+            return;
+        }
+        else if (batch != m_batches.end())
+        {
+            // calls passing fds are sent on their own, after the calls batched so far
+            std::vector<BatchedCall> calls;
+            calls.swap(batch->second);
+            locker.unlock();
+
+            sendBatch(std::move(calls));
+        }
+    }
+
+    // build the socket message to send, as a frame if the server supports them
+    const bool framed = m_framedMessages;
+    std::shared_ptr<msghdr> header;
+    if (framed)
+        header = populateFramedCall(serialId, method, *request, fds, noReplyExpected);
+    else
+        header = populateCall(serialId, method, *request, fds);
+
+    if (!header)
+    {
+        completeWithError(&methodCall, "Method call to big");
+        return;
+    }
+
+    // finally, send the message
+    std::unique_lock<std::mutex> locker(m_lock);
+
+    // refer to the method by id, the id is assigned under the lock so a frame
+    // using it can't be sent before the frame defining it
+    uint16_t newMethodId = kFrameNoId;
+    if (framed && m_numericIds)
+        newMethodId = m_methodIds.apply(header.get(), method);
+
+    size_t requiredDataLen = 0;
+    for (size_t i = 0; i < header->msg_iovlen; i++)
+        requiredDataLen += header->msg_iov[i].iov_len;
+
+    if (m_sock < 0)
+    {
+        locker.unlock();
+        completeWithError(&methodCall, "Not connected");
+    }
+    else if (!sendNoLock(header.get(), requiredDataLen))
+    {
+        locker.unlock();
+        completeWithError(&methodCall, "Failed to send message");
+    }
+    else
+    {
+        m_methodIds.defined(method, newMethodId);
+
+        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s { %s }", serialId, method->full_name().c_str(),
+                             request->ShortDebugString().c_str());
+
+        if (noReplyExpected)
+        {
+            // no reply from server is expected, however if the caller supplied
+            // a closure (it shouldn't) we should still call it now to indicate
+            // the method call has been made
+            if (done)
+                done->Run();
+        }
+        else
+        {
+            // add the message to the queue so we pick-up the reply
+            m_methodCalls.emplace(serialId, methodCall);
+
+            // update the single timeout timer
+            updateTimeoutTimer();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Builds the socket message for a method call, wrapped in a transport message.
+    Used until the server has confirmed that it supports framed messages.
+
+ */
+std::shared_ptr<msghdr> ChannelImpl::populateCall(uint64_t serialId, const google::protobuf::MethodDescriptor *method,
+                                                  const google::protobuf::Message &request, const std::vector<int> &fds)
+{
     // create the transport request
     transport::MessageToServer message;
     transport::MethodCall *call = message.mutable_call();
@@ -1065,19 +1512,29 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     call->set_method_name(method->name());
 
     // copy in the actual message data
-    std::string reqString = request->SerializeAsString();
+    std::string reqString = request.SerializeAsString();
     call->set_request_message(std::move(reqString));
 
+    return populateMessage(message, fds);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Builds the socket message for a transport message.
+
+ */
+std::shared_ptr<msghdr> ChannelImpl::populateMessage(const transport::MessageToServer &message,
+                                                     const std::vector<int> &fds)
+{
     const size_t requiredDataLen = message.ByteSizeLong();
     if (requiredDataLen > m_kMaxMessageSize)
     {
         RIALTO_IPC_LOG_ERROR("method call to big to send (%zu, max %zu", requiredDataLen, m_kMaxMessageSize);
-        completeWithError(&methodCall, "Method call to big");
-        return;
+        return nullptr;
     }
 
-    // extract the fds from the message
-    const std::vector<int> fds = getMessageFds(*request);
     const size_t requiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
 
     // build the socket message to send
@@ -1103,62 +1560,261 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     message.SerializeWithCachedSizesToArray(data);
 
     // next check if the request is sending any fd's
-    if (!fds.empty())
+    if (!addMessageFds(header, fds))
+        return nullptr;
+
+    // std::reinterpret_pointer_cast is only implemented in C++17 and newer, so for
+    // now do it manually
+    return std::shared_ptr<msghdr>(msgBuf, header);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Builds the socket message for a method call as a frame.  The request is
+    serialised once, straight into the send buffer, and the method name is
+    sent from the method descriptor using a separate iovec.
+
+ */
+std::shared_ptr<msghdr> ChannelImpl::populateFramedCall(uint64_t serialId,
+                                                        const google::protobuf::MethodDescriptor *method,
+                                                        const google::protobuf::Message &request,
+                                                        const std::vector<int> &fds, bool noReply)
+{
+    // the descriptor (and therefore the name) outlives the socket message
+    const std::string &methodName = method->full_name();
+    const size_t payloadLen = request.ByteSizeLong();
+
+    const size_t requiredDataLen = sizeof(FrameHeader) + methodName.size() + payloadLen;
+    if ((requiredDataLen > m_kMaxMessageSize) || (methodName.size() > UINT16_MAX))
     {
-        struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
-        if (!cmsg)
+        RIALTO_IPC_LOG_ERROR("method call to big to send (%zu, max %zu", requiredDataLen, m_kMaxMessageSize);
+        return nullptr;
+    }
+
+    const size_t requiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
+
+    // build the socket message to send, the iovecs point to the frame header, the name and the payload
+    auto msgBuf = m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + requiredCtrlLen + (3 * sizeof(iovec)) +
+                                                        sizeof(FrameHeader) + payloadLen);
+
+    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
+    bzero(header, sizeof(msghdr));
+
+    auto *ctrl = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr));
+    header->msg_control = ctrl;
+    header->msg_controllen = requiredCtrlLen;
+
+    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr) + requiredCtrlLen);
+    header->msg_iov = iov;
+    header->msg_iovlen = 3;
+
+    auto *frame =
+        reinterpret_cast<FrameHeader *>(msgBuf.get() + sizeof(msghdr) + requiredCtrlLen + (3 * sizeof(iovec)));
+    frame->magic = kFrameMagic;
+    frame->type = FrameType::CALL;
+    frame->flags = noReply ? kFrameFlagNoReply : 0;
+    frame->id = kFrameNoId;
+    frame->nameLength = static_cast<uint16_t>(methodName.size());
+    frame->serial = serialId;
+
+    auto *payload = reinterpret_cast<uint8_t *>(frame + 1);
+
+    iov[0].iov_base = frame;
+    iov[0].iov_len = sizeof(FrameHeader);
+    iov[1].iov_base = const_cast<char *>(methodName.data());
+    iov[1].iov_len = methodName.size();
+    iov[2].iov_base = payload;
+    iov[2].iov_len = payloadLen;
+
+    // serialise the request straight into the send buffer
+    request.SerializeWithCachedSizesToArray(payload);
+
+    // next check if the request is sending any fd's
+    if (!addMessageFds(header, fds))
+        return nullptr;
+
+    return std::shared_ptr<msghdr>(msgBuf, header);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Adds the \a fds to the control part of the socket message.
+
+ */
+bool ChannelImpl::addMessageFds(msghdr *header, const std::vector<int> &fds)
+{
+    if (fds.empty())
+        return true;
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
+    if (!cmsg)
+    {
+        RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
+        return false;
+    }
+
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+    memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+    header->msg_controllen = cmsg->cmsg_len;
+
+    return true;
+}
+
+void ChannelImpl::beginBatch()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+
+    if (m_batches.emplace(std::this_thread::get_id(), std::vector<BatchedCall>()).second)
+        m_numOfBatches++;
+}
+
+bool ChannelImpl::flushBatch()
+{
+    std::unique_lock<std::mutex> locker(m_lock);
+
+    auto batch = m_batches.find(std::this_thread::get_id());
+    if (batch == m_batches.end())
+    {
+        RIALTO_IPC_LOG_ERROR("no batch started by the calling thread");
+        return false;
+    }
+
+    std::vector<BatchedCall> calls = std::move(batch->second);
+    m_batches.erase(batch);
+    m_numOfBatches--;
+
+    locker.unlock();
+
+    return sendBatch(std::move(calls));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends the batched calls to the server, packing as many calls as fit in a
+    MultiCall message.  If the server doesn't support multi calls, the calls
+    are sent one by one.
+
+ */
+bool ChannelImpl::sendBatch(std::vector<BatchedCall> &&calls)
+{
+    // allows for the tag and length of each call in the multi call
+    const size_t kCallOverhead = 16;
+    const bool kMultiCalls = m_multiCalls;
+
+    bool success = true;
+    auto begin = calls.begin();
+    while (begin != calls.end())
+    {
+        transport::MessageToServer message;
+        size_t messageLen = 0;
+
+        auto end = begin;
+        while (end != calls.end())
         {
-            RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
-            completeWithError(&methodCall, "Internal error");
-            return;
+            transport::MethodCall call;
+            call.set_serial_id(end->serialId);
+            call.set_service_name(end->method->service()->full_name());
+            call.set_method_name(end->method->name());
+            call.set_request_message(std::move(end->request));
+
+            const size_t callLen = call.ByteSizeLong() + kCallOverhead;
+            if (!kMultiCalls)
+            {
+                message.mutable_call()->Swap(&call);
+                ++end;
+                break;
+            }
+            else if ((end != begin) && ((messageLen + callLen) > m_kMaxMessageSize))
+            {
+                // doesn't fit, so restore the request for the next message
+                end->request = std::move(*call.mutable_request_message());
+                break;
+            }
+
+            message.mutable_multi_call()->add_calls()->Swap(&call);
+            messageLen += callLen;
+            ++end;
         }
 
-        cmsg->cmsg_level = SOL_SOCKET;
-        cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
-        memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
-        header->msg_controllen = cmsg->cmsg_len;
+        success &= sendBatchMessage(message, begin, end);
+        begin = end;
     }
 
-    // check if the method is expecting a reply
-    const bool noReplyExpected = method->options().HasExtension(::firebolt::rialto::ipc::no_reply) &&
-                                 method->options().GetExtension(::firebolt::rialto::ipc::no_reply);
+    return success;
+}
 
-    // finally, send the message
-    std::unique_lock<std::mutex> locker(m_lock);
+// -----------------------------------------------------------------------------
+/*!
+    \internal
 
-    if (m_sock < 0)
+    Sends a message holding the batched calls from \a begin to \a end, and
+    registers the calls to pick up their replies.
+
+ */
+bool ChannelImpl::sendBatchMessage(const transport::MessageToServer &message, std::vector<BatchedCall>::iterator begin,
+                                   std::vector<BatchedCall>::iterator end)
+{
+    std::shared_ptr<msghdr> header = populateMessage(message, {});
+    if (!header)
     {
-        locker.unlock();
-        completeWithError(&methodCall, "Not connected");
+        for (auto it = begin; it != end; ++it)
+            completeWithError(&it->methodCall, "Method call to big");
+        return false;
     }
-    else if (sendmsg(m_sock, header, MSG_NOSIGNAL) != static_cast<ssize_t>(requiredDataLen))
+
+    std::unique_lock<std::mutex> locker(m_lock);
+
+    const char *error = nullptr;
+    if (m_sock < 0)
+        error = "Not connected";
+    else if (!sendNoLock(header.get(), header->msg_iov[0].iov_len))
+        error = "Failed to send message";
+
+    if (error)
     {
         locker.unlock();
-        completeWithError(&methodCall, "Failed to send message");
+        for (auto it = begin; it != end; ++it)
+            completeWithError(&it->methodCall, error);
+        return false;
     }
-    else
+
+    std::vector<google::protobuf::Closure *> noReplyClosures;
+    for (auto it = begin; it != end; ++it)
     {
-        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s.%s { %s }", serialId, call->service_name().c_str(),
-                             call->method_name().c_str(), request->ShortDebugString().c_str());
+        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s (batched)", it->serialId,
+                             it->method->full_name().c_str());
 
-        if (noReplyExpected)
+        if (it->noReply)
         {
-            // no reply from server is expected, however if the caller supplied
-            // a closure (it shouldn't) we should still call it now to indicate
-            // the method call has been made
-            if (done)
-                done->Run();
+            if (it->methodCall.closure)
+                noReplyClosures.push_back(it->methodCall.closure);
         }
         else
         {
-            // add the message to the queue so we pick-up the reply
-            m_methodCalls.emplace(serialId, methodCall);
-
-            // update the single timeout timer
-            updateTimeoutTimer();
+            // the timeout starts once the call is sent
+            it->methodCall.timeoutDeadline = std::chrono::steady_clock::now() + m_defaultTimeout;
+            m_methodCalls.emplace(it->serialId, it->methodCall);
         }
     }
+
+    updateTimeoutTimer();
+
+    locker.unlock();
+
+    // no reply is expected, but the closures still indicate the calls have been made
+    for (google::protobuf::Closure *closure : noReplyClosures)
+        closure->Run();
+
+    return true;
 }
 
 int ChannelImpl::subscribeImpl(const std::string &eventName, const google::protobuf::Descriptor *descriptor,
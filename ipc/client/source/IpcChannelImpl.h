@@ -20,21 +20,25 @@
 #ifndef FIREBOLT_RIALTO_IPC_IPC_CHANNEL_IMPL_H_
 #define FIREBOLT_RIALTO_IPC_IPC_CHANNEL_IMPL_H_
 
+#include "BufferPool.h"
 #include "FileDescriptor.h"
+#include "FrameHeader.h"
 #include "IIpcChannel.h"
 #include "IpcClientControllerImpl.h"
-#include "SimpleBufferPool.h"
+#include "ShmRing.h"
 
 #include "rialtoipc-transport.pb.h"
 #include <google/protobuf/service.h>
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <sys/socket.h>
@@ -65,6 +69,13 @@ public:
     bool wait(int timeoutMSecs) override;
     bool process() override;
     bool unsubscribe(int eventTag) override;
+    void beginBatch() override;
+    bool flushBatch() override;
+
+    /**
+     * @brief Checks if the server has agreed to receive method calls as frames.
+     */
+    bool isFramingNegotiated() const { return m_framedMessages; }
 
     void CallMethod(const google::protobuf::MethodDescriptor *method, google::protobuf::RpcController *controller,
                     const google::protobuf::Message *request, google::protobuf::Message *response,
@@ -79,19 +90,26 @@ private:
     void disconnectNoLock();
 
     bool processSocketEvent();
+    bool readSocketMessages();
+    bool processRingEvent();
     void processTimeoutEvent();
     void processWakeEvent();
 
     void processServerMessage(const uint8_t *data, size_t len, std::vector<FileDescriptor> *fds);
-    void processReplyFromServer(const ::firebolt::rialto::ipc::transport::MethodCallReply &reply,
-                                std::vector<FileDescriptor> *fds);
-    void processErrorFromServer(const ::firebolt::rialto::ipc::transport::MethodCallError &error);
-    void processEventFromServer(const ::firebolt::rialto::ipc::transport::EventFromServer &event,
+    void processServerFrame(const uint8_t *data, size_t len, std::vector<FileDescriptor> *fds);
+    void processEventFrame(const FrameHeader &frame, const uint8_t *data, const uint8_t *payload, size_t payloadLen,
+                           std::vector<FileDescriptor> *fds);
+    void processReplyFromServer(uint64_t serialId, const uint8_t *data, size_t len, std::vector<FileDescriptor> *fds);
+    void processErrorFromServer(uint64_t serialId, const std::string &reason);
+    void processEventFromServer(const std::string &eventName, const uint8_t *data, size_t len,
                                 std::vector<FileDescriptor> *fds);
 
     bool createConnectedSocket(const std::string &socketPath);
     bool attachSocket(int sockFd);
     bool initChannel();
+    bool sendCapabilities();
+    bool setupRing();
+    bool sendNoLock(const struct msghdr *msg, size_t length);
     void termChannel();
     bool isConnectedInternal() const; // to avoid calling virtual method in constructor
 
@@ -99,6 +117,14 @@ private:
     static std::vector<int> getMessageFds(const google::protobuf::Message &message);
 
     static bool addReplyFileDescriptors(google::protobuf::Message *reply, std::vector<FileDescriptor> *fds);
+    static bool addMessageFds(msghdr *header, const std::vector<int> &fds);
+
+    std::shared_ptr<msghdr> populateMessage(const transport::MessageToServer &message, const std::vector<int> &fds);
+    std::shared_ptr<msghdr> populateCall(uint64_t serialId, const google::protobuf::MethodDescriptor *method,
+                                         const google::protobuf::Message &request, const std::vector<int> &fds);
+    std::shared_ptr<msghdr> populateFramedCall(uint64_t serialId, const google::protobuf::MethodDescriptor *method,
+                                               const google::protobuf::Message &request, const std::vector<int> &fds,
+                                               bool noReply);
 
     struct MethodCall
     {
@@ -110,6 +136,19 @@ private:
 
     void updateTimeoutTimer();
 
+    struct BatchedCall
+    {
+        uint64_t serialId;
+        const google::protobuf::MethodDescriptor *method;
+        std::string request;
+        bool noReply;
+        MethodCall methodCall;
+    };
+
+    bool sendBatch(std::vector<BatchedCall> &&calls);
+    bool sendBatchMessage(const transport::MessageToServer &message, std::vector<BatchedCall>::iterator begin,
+                          std::vector<BatchedCall>::iterator end);
+
     static void complete(MethodCall *call);
     static void completeWithError(MethodCall *call, std::string reason);
 
@@ -121,15 +160,50 @@ private:
     int m_timerFd;
     int m_eventFd;
 
-    SimpleBufferPool m_sendBufPool;
+    BufferPool m_sendBufPool;
 
     mutable std::mutex m_lock;
     std::atomic<uint64_t> m_serialCounter;
 
+    std::atomic<bool> m_framedMessages;
+    std::atomic<bool> m_numericIds;
+    std::atomic<bool> m_multiCalls;
+
+    // the shared memory rings, set while holding both m_lock and m_receiveLock, and
+    // used to send while holding m_lock once the server has started reading them
+    std::unique_ptr<ShmRingTransport> m_ring;
+    std::atomic<int> m_ringDoorbellFd;
+    bool m_ringSending;
+
+    // serialises reading the socket and the response ring, once the server has
+    // started writing to the ring the socket messages are queued until their
+    // barrier record is read
+    std::mutex m_receiveLock;
+    bool m_socketBehindRing;
+
+    struct ReceivedMessage
+    {
+        std::vector<uint8_t> data;
+        std::vector<FileDescriptor> fds;
+    };
+
+    std::deque<ReceivedMessage> m_socketMessages;
+
+    // the ids of the methods called as frames, guarded by m_lock
+    FrameIds<const google::protobuf::MethodDescriptor *> m_methodIds;
+
+    // the names of the event types, indexed by the ids defined by the server,
+    // only accessed while processing messages from the server
+    std::vector<std::string> m_eventNames;
+
     std::chrono::milliseconds m_defaultTimeout;
 
     std::map<uint64_t, MethodCall> m_methodCalls;
 
+    // the calls batched by each thread that has called beginBatch(), guarded by m_lock
+    std::map<std::thread::id, std::vector<BatchedCall>> m_batches;
+    std::atomic<size_t> m_numOfBatches;
+
     std::mutex m_eventsLock;
 
     int m_eventTagCounter;
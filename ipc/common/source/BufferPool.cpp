@@ -0,0 +1,385 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferPool.h"
+#include "IpcLogging.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+constexpr size_t kNumSizeClasses = BufferPool::kNumOfSizeClasses;
+constexpr size_t kMinClassSizeShift = 8;
+constexpr size_t kMaxClassSize = size_t(1) << (kMinClassSizeShift + kNumSizeClasses - 1);
+
+// upper limit on the number of buffers of each size class kept by a thread
+constexpr uint32_t kMaxCachedBlocks = 16;
+
+// number of pools a thread keeps caches for, the least recently attached one is flushed to make room
+constexpr size_t kNumCachedArenas = 2;
+
+// hits counted by a thread cache are added to the pool statistics in batches of this size
+constexpr uint64_t kHitsBatchSize = 64;
+
+constexpr uint32_t kNoBlock = 0;
+
+size_t sizeClassFor(size_t bytes)
+{
+    size_t sizeClass = 0;
+    while ((size_t(1) << (kMinClassSizeShift + sizeClass)) < bytes)
+        sizeClass++;
+
+    return sizeClass;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+/*!
+    \class BufferPool::Arena
+    \brief The buffers of a pool, shared with the thread caches.
+
+    Each size class is a contiguous run of equally sized blocks in a single
+    slab.  Free blocks are kept on a Treiber stack, linked by index rather than
+    by pointer so the head can hold both the index of the top block and an ABA
+    tag in a single 64-bit word.  Indices are stored off by one, so that 0
+    means no block.
+
+*/
+class BufferPool::Arena
+{
+public:
+    explicit Arena(size_t capacity);
+    ~Arena();
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *pop(size_t sizeClass);
+    void push(size_t sizeClass, void *p);
+
+    bool contains(const void *p) const { return (p >= m_slab) && (p < (m_slab + m_slabSize)); }
+    size_t slabSize() const { return m_slabSize; }
+    size_t sizeClassOf(const void *p) const;
+    uint32_t cacheLimit(size_t sizeClass) const { return m_classes[sizeClass].cacheLimit; }
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+
+private:
+    struct SizeClass
+    {
+        alignas(64) std::atomic<uint64_t> head{0};
+        uint8_t *base = nullptr;
+        size_t blockSize = 0;
+        uint32_t numBlocks = 0;
+        uint32_t cacheLimit = 0;
+        std::unique_ptr<std::atomic<uint32_t>[]> next;
+    };
+
+    uint8_t *m_slab;
+    size_t m_slabSize;
+    std::array<SizeClass, kNumSizeClasses> m_classes;
+};
+
+BufferPool::Arena::Arena(size_t capacity) : m_slab(nullptr), m_slabSize(0)
+{
+    const size_t kClassCapacity = capacity / kNumSizeClasses;
+    for (size_t i = 0; i < kNumSizeClasses; i++)
+    {
+        SizeClass &sizeClass = m_classes[i];
+        sizeClass.blockSize = size_t(1) << (kMinClassSizeShift + i);
+        sizeClass.numBlocks = static_cast<uint32_t>(kClassCapacity / sizeClass.blockSize);
+
+        // let each thread cache up to a quarter of the blocks, so one thread can't hoard the whole class
+        sizeClass.cacheLimit = std::min(kMaxCachedBlocks, sizeClass.numBlocks / 4);
+
+        m_slabSize += sizeClass.blockSize * sizeClass.numBlocks;
+    }
+
+    // the slab is only written to when the blocks are used, so the pages of unused blocks are never touched
+    m_slab = (m_slabSize > 0) ? reinterpret_cast<uint8_t *>(malloc(m_slabSize)) : nullptr;
+    if (!m_slab && (m_slabSize > 0))
+    {
+        RIALTO_IPC_LOG_ERROR("failed to allocate %zu bytes for the buffer pool", m_slabSize);
+        m_slabSize = 0;
+    }
+
+    uint8_t *base = m_slab;
+    for (SizeClass &sizeClass : m_classes)
+    {
+        if (!m_slab)
+            sizeClass.numBlocks = 0;
+
+        sizeClass.base = base;
+        base += sizeClass.blockSize * sizeClass.numBlocks;
+
+        // initially all blocks are free, linked in address order
+        sizeClass.next = std::make_unique<std::atomic<uint32_t>[]>(sizeClass.numBlocks);
+        for (uint32_t block = 0; block < sizeClass.numBlocks; block++)
+            sizeClass.next[block].store((block + 1 < sizeClass.numBlocks) ? (block + 2) : kNoBlock);
+
+        sizeClass.head.store((sizeClass.numBlocks > 0) ? 1 : kNoBlock);
+    }
+}
+
+BufferPool::Arena::~Arena()
+{
+    free(m_slab);
+}
+
+size_t BufferPool::Arena::sizeClassOf(const void *p) const
+{
+    size_t sizeClass = 0;
+    while ((sizeClass < (kNumSizeClasses - 1)) && (p >= m_classes[sizeClass + 1].base))
+        sizeClass++;
+
+    return sizeClass;
+}
+
+void *BufferPool::Arena::pop(size_t sizeClass)
+{
+    SizeClass &entry = m_classes[sizeClass];
+
+    uint64_t head = entry.head.load(std::memory_order_acquire);
+    while (static_cast<uint32_t>(head) != kNoBlock)
+    {
+        const uint32_t block = static_cast<uint32_t>(head) - 1;
+        const uint64_t tag = (head >> 32) + 1;
+        const uint64_t newHead = (tag << 32) | entry.next[block].load(std::memory_order_relaxed);
+
+        // the tag changes on every push and pop, so the exchange fails if the block was popped and pushed back
+        if (entry.head.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+            return entry.base + (block * entry.blockSize);
+    }
+
+    return nullptr;
+}
+
+void BufferPool::Arena::push(size_t sizeClass, void *p)
+{
+    SizeClass &entry = m_classes[sizeClass];
+    const uint32_t block = static_cast<uint32_t>((reinterpret_cast<uint8_t *>(p) - entry.base) / entry.blockSize);
+
+    uint64_t head = entry.head.load(std::memory_order_relaxed);
+    uint64_t newHead;
+    do
+    {
+        entry.next[block].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        newHead = (((head >> 32) + 1) << 32) | (block + 1);
+    } while (!entry.head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+namespace
+{
+// -----------------------------------------------------------------------------
+/*!
+    \class ThreadCache
+    \brief The blocks a thread holds back from the free lists of the pools it uses.
+
+    The cache keeps a reference on the arena of each pool it holds blocks of,
+    so that it can always return them, even if the pool was destroyed while
+    the thread was still running.
+
+*/
+class ThreadCache
+{
+public:
+    struct CachedArena
+    {
+        std::shared_ptr<BufferPool::Arena> arena;
+        std::array<std::array<void *, kMaxCachedBlocks>, kNumSizeClasses> blocks;
+        std::array<uint32_t, kNumSizeClasses> count{};
+        uint64_t hits = 0;
+    };
+
+    ThreadCache() = default;
+    ~ThreadCache()
+    {
+        for (CachedArena &cached : m_arenas)
+            flush(&cached);
+
+        m_destroyed = true;
+    }
+
+    static CachedArena *get(const std::shared_ptr<BufferPool::Arena> &arena)
+    {
+        // buffers may still be released by static objects after the thread cache was destroyed
+        if (m_destroyed)
+            return nullptr;
+
+        return m_cache.find(arena);
+    }
+
+    static void flushHits(const std::shared_ptr<BufferPool::Arena> &arena)
+    {
+        if (m_destroyed)
+            return;
+
+        for (CachedArena &cached : m_cache.m_arenas)
+        {
+            if (cached.arena == arena)
+            {
+                arena->m_hits.fetch_add(cached.hits, std::memory_order_relaxed);
+                cached.hits = 0;
+            }
+        }
+    }
+
+    static void countHit(CachedArena *cached)
+    {
+        if (++cached->hits == kHitsBatchSize)
+        {
+            cached->arena->m_hits.fetch_add(cached->hits, std::memory_order_relaxed);
+            cached->hits = 0;
+        }
+    }
+
+private:
+    CachedArena *find(const std::shared_ptr<BufferPool::Arena> &arena)
+    {
+        for (CachedArena &cached : m_arenas)
+        {
+            if (cached.arena == arena)
+                return &cached;
+        }
+
+        CachedArena &evicted = m_arenas[m_nextEvicted];
+        m_nextEvicted = (m_nextEvicted + 1) % kNumCachedArenas;
+
+        flush(&evicted);
+        evicted.arena = arena;
+        return &evicted;
+    }
+
+    static void flush(CachedArena *cached)
+    {
+        if (!cached->arena)
+            return;
+
+        for (size_t sizeClass = 0; sizeClass < kNumSizeClasses; sizeClass++)
+        {
+            while (cached->count[sizeClass] > 0)
+                cached->arena->push(sizeClass, cached->blocks[sizeClass][--cached->count[sizeClass]]);
+        }
+
+        cached->arena->m_hits.fetch_add(cached->hits, std::memory_order_relaxed);
+        cached->hits = 0;
+        cached->arena.reset();
+    }
+
+private:
+    std::array<CachedArena, kNumCachedArenas> m_arenas;
+    size_t m_nextEvicted = 0;
+
+    static thread_local ThreadCache m_cache;
+    static thread_local bool m_destroyed;
+};
+
+thread_local ThreadCache ThreadCache::m_cache;
+thread_local bool ThreadCache::m_destroyed = false;
+} // namespace
+
+BufferPool::BufferPool(size_t capacity) : m_kArena(std::make_shared<Arena>(capacity)) {}
+
+BufferPool::~BufferPool() = default;
+
+void *BufferPool::allocateImpl(size_t bytes)
+{
+    if (bytes <= kMaxClassSize)
+    {
+        const size_t sizeClass = sizeClassFor(bytes);
+        const uint32_t cacheLimit = m_kArena->cacheLimit(sizeClass);
+
+        ThreadCache::CachedArena *cached = (cacheLimit > 0) ? ThreadCache::get(m_kArena) : nullptr;
+        if (cached)
+        {
+            // refill half the cache in one go, so the next allocations don't touch the free list
+            uint32_t &count = cached->count[sizeClass];
+            if (count == 0)
+            {
+                const uint32_t kRefillCount = std::max(cacheLimit / 2, 1U);
+                void *p = nullptr;
+                while ((count < kRefillCount) && (p = m_kArena->pop(sizeClass)))
+                    cached->blocks[sizeClass][count++] = p;
+            }
+
+            if (count > 0)
+            {
+                ThreadCache::countHit(cached);
+                return cached->blocks[sizeClass][--count];
+            }
+        }
+        else if (void *p = m_kArena->pop(sizeClass))
+        {
+            m_kArena->m_hits.fetch_add(1, std::memory_order_relaxed);
+            return p;
+        }
+    }
+
+    // RIALTO_IPC_LOG_DEBUG("no pooled buffers for alloc of size %zu", bytes);
+
+    // failed, so revert to dynamic allocation
+    m_kArena->m_misses.fetch_add(1, std::memory_order_relaxed);
+    return malloc(bytes);
+}
+
+void BufferPool::deallocate(void *p)
+{
+    // if the pointer is not within the slab then it was dynamically allocated, in which case just free it
+    if (!m_kArena->contains(p))
+    {
+        free(p);
+        return;
+    }
+
+    const size_t sizeClass = m_kArena->sizeClassOf(p);
+    const uint32_t cacheLimit = m_kArena->cacheLimit(sizeClass);
+
+    ThreadCache::CachedArena *cached = (cacheLimit > 0) ? ThreadCache::get(m_kArena) : nullptr;
+    if (!cached)
+    {
+        m_kArena->push(sizeClass, p);
+        return;
+    }
+
+    // when the cache is full return half of it to the free list, so other threads can use the blocks
+    uint32_t &count = cached->count[sizeClass];
+    if (count == cacheLimit)
+    {
+        while (count > (cacheLimit / 2))
+            m_kArena->push(sizeClass, cached->blocks[sizeClass][--count]);
+    }
+
+    cached->blocks[sizeClass][count++] = p;
+}
+
+BufferPool::Stats BufferPool::stats() const
+{
+    // only the hits of the calling thread can be flushed, the other threads add theirs in their next batch
+    ThreadCache::flushHits(m_kArena);
+
+    return Stats{m_kArena->m_hits.load(std::memory_order_relaxed), m_kArena->m_misses.load(std::memory_order_relaxed)};
+}
+
+size_t BufferPool::capacity() const
+{
+    return m_kArena->slabSize();
+}
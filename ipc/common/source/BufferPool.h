@@ -0,0 +1,115 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUFFER_POOL_H_
+#define BUFFER_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Pool of buffers for building socket messages.
+ *
+ * Buffers are grouped in power of two size classes, from 256 bytes up to 128KB, carved from a single slab of
+ * the capacity given to the constructor.  The capacity is shared equally between the size classes, so each size
+ * class has a fixed number of buffers, held on a lock-free free list, and each thread keeps a small cache of
+ * buffers per size class so that most allocations and deallocations don't touch any memory shared with other
+ * threads.
+ *
+ * Allocations that are larger than the biggest size class, or made while all the buffers of the size class are
+ * in use, fall back to malloc and are counted as misses.
+ *
+ * The pool must outlive all the buffers allocated from it.
+ */
+class BufferPool
+{
+public:
+    /**
+     * @brief The number of size classes.
+     */
+    static constexpr size_t kNumOfSizeClasses = 10;
+
+    /**
+     * @brief The default size of the slab.
+     */
+    static constexpr size_t kDefaultCapacity = 256 * 1024;
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] capacity : The size in bytes of the slab the buffers are carved from.  Each size class gets
+     *                       capacity / kNumOfSizeClasses bytes of it, so a size class whose buffers are bigger than
+     *                       that share has no pooled buffers.
+     */
+    explicit BufferPool(size_t capacity = kDefaultCapacity);
+    ~BufferPool();
+    BufferPool(const BufferPool &) = delete;
+    BufferPool(BufferPool &&) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+    BufferPool &operator=(BufferPool &&) = delete;
+
+    template <class T = uint8_t> T *allocate(size_t count)
+    {
+        return reinterpret_cast<T *>(allocateImpl(count * sizeof(T)));
+    }
+
+    template <class T = uint8_t> std::shared_ptr<T> allocateShared(size_t count)
+    {
+        return std::shared_ptr<T>(allocate<T>(count), [this](T *p) { deallocate(p); });
+    }
+
+    void deallocate(void *p);
+
+    /**
+     * @brief Allocation statistics.
+     *
+     * Hits served from the caches of other threads are added in batches, so the counts can lag slightly behind.
+     */
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    /**
+     * @brief Gets the number of allocations served from the pool and from malloc.
+     *
+     * @retval the allocation statistics.
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Gets the number of bytes of the slab that are used for pooled buffers.
+     *
+     * @retval the size of the slab, never more than the capacity given to the constructor.
+     */
+    size_t capacity() const;
+
+    class Arena;
+
+private:
+    void *allocateImpl(size_t bytes);
+
+private:
+    // shared with the caches of the threads that used the pool, which may release it after the pool is destroyed
+    const std::shared_ptr<Arena> m_kArena;
+};
+
+#endif // BUFFER_POOL_H_
@@ -0,0 +1,202 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_FRAME_HEADER_H_
+#define FIREBOLT_RIALTO_IPC_FRAME_HEADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+#include <sys/socket.h>
+
+// -----------------------------------------------------------------------------
+/*!
+    \struct FrameHeader
+    \brief Fixed size header of a framed transport message.
+
+    Once both ends of a connection have agreed on it (see TransportCapabilities
+    in rialtoipc-transport.proto), method calls, replies, errors and events are
+    sent as a FrameHeader, followed by \c nameLength bytes holding the full name
+    of the method or the event type, followed by the payload.  The payload is the
+    serialised request / response / event message, or the reason string of an
+    error.
+
+    This avoids wrapping the already serialised message in a second transport
+    protobuf message, so each message is serialised and parsed only once, and
+    the payload is never copied in or out of a protobuf string.
+
+    The first byte of a frame is always kFrameMagic, which is never the first
+    byte of a serialised MessageToServer or MessageFromServer, so a receiver can
+    tell a frame apart from a legacy transport message.
+
+    If both ends also agreed on numeric ids, the sender of a frame may refer to
+    the method or event type by a 16-bit id instead of its name.  The first
+    frame for a given method or event type carries both the name and a newly
+    allocated id, flagged with kFrameFlagDefinesId; all later frames carry just
+    the id and no name, so the receiver resolves them with an array lookup.
+    Ids are allocated by the sender, per connection and per direction, so
+    methods and events exported / subscribed after connecting get ids too.
+
+*/
+
+namespace firebolt::rialto::ipc
+{
+constexpr uint8_t kFrameMagic = 0xf5;
+
+enum class FrameType : uint8_t
+{
+    CALL = 1,
+    REPLY = 2,
+    ERROR = 3,
+    EVENT = 4
+};
+
+/**
+ * @brief Set on method calls that don't expect a reply.
+ */
+constexpr uint16_t kFrameFlagNoReply = 0x0001;
+
+/**
+ * @brief Set on frames that define a new id for the name following the header.
+ */
+constexpr uint16_t kFrameFlagDefinesId = 0x0002;
+
+/**
+ * @brief The id of frames whose method or event type is identified by the name following the header.
+ */
+constexpr uint16_t kFrameNoId = 0;
+
+struct FrameHeader
+{
+    uint8_t magic;
+    FrameType type;
+    uint16_t flags;
+    uint16_t id;
+    uint16_t nameLength;
+    uint64_t serial;
+};
+
+static_assert(sizeof(FrameHeader) == 16, "unexpected padding in FrameHeader");
+
+/**
+ * @brief Checks if a received message is a frame rather than a legacy transport message.
+ *
+ * @param[in] data      : The received message.
+ * @param[in] dataLen   : The length of the received message.
+ *
+ * @retval true if the message starts with the frame magic.
+ */
+inline bool isFrame(const uint8_t *data, size_t dataLen)
+{
+    return (dataLen > 0) && (data[0] == kFrameMagic);
+}
+
+/**
+ * @brief Reads the frame header at the start of a received message.
+ *
+ * @param[in]  data     : The received message.
+ * @param[in]  dataLen  : The length of the received message.
+ * @param[out] header   : Set to the frame header.
+ *
+ * @retval true if the message is a valid frame, ie. the header and name fit in the message.
+ */
+inline bool readFrameHeader(const uint8_t *data, size_t dataLen, FrameHeader *header)
+{
+    if ((dataLen < sizeof(FrameHeader)) || !isFrame(data, dataLen))
+        return false;
+
+    // the receive buffers are byte arrays, so copy out rather than cast to avoid unaligned access
+    memcpy(header, data, sizeof(FrameHeader));
+    return (header->nameLength <= (dataLen - sizeof(FrameHeader)));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \class FrameIds
+    \brief The ids allocated by the sender of frames on a single connection.
+
+    The frames passed to apply() must have been built with the header in the
+    first iovec and the name in the second.  The class is not thread safe, the
+    caller must hold the lock that serialises the sends on the connection, so
+    a frame that only carries an id can never overtake the frame defining it.
+
+*/
+template <typename Key> class FrameIds
+{
+public:
+    /**
+     * @brief Makes the frame refer to its method or event type by id.
+     *
+     * If an id has already been defined for \a key, the name is dropped from
+     * the frame.  Otherwise a new id is sent along with the name, and must be
+     * committed with defined() once the frame has been sent.
+     *
+     * @param[in,out] msg : The socket message holding the frame.
+     * @param[in]     key : The method or event type.
+     *
+     * @retval the new id to commit, or kFrameNoId if none was allocated.
+     */
+    uint16_t apply(msghdr *msg, Key key) const
+    {
+        auto *frame = reinterpret_cast<FrameHeader *>(msg->msg_iov[0].iov_base);
+
+        auto it = m_ids.find(key);
+        if (it != m_ids.end())
+        {
+            frame->id = it->second;
+            frame->nameLength = 0;
+            msg->msg_iov[1].iov_len = 0;
+            return kFrameNoId;
+        }
+
+        // once the ids have run out, frames just carry the name
+        if (m_nextId != kFrameNoId)
+        {
+            frame->id = m_nextId;
+            frame->flags |= kFrameFlagDefinesId;
+        }
+
+        return m_nextId;
+    }
+
+    /**
+     * @brief Commits the id returned by apply(), after the frame defining it was sent.
+     *
+     * @param[in] key   : The method or event type.
+     * @param[in] id    : The id returned by apply().
+     */
+    void defined(Key key, uint16_t id)
+    {
+        if (id != kFrameNoId)
+        {
+            m_ids.emplace(key, id);
+            m_nextId++;
+        }
+    }
+
+private:
+    std::map<Key, uint16_t> m_ids;
+    uint16_t m_nextId = 1;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_FRAME_HEADER_H_
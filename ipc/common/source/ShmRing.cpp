@@ -0,0 +1,578 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmRing.h"
+#include "IpcLogging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <syscall.h>
+#include <unistd.h>
+
+#if !defined(SYS_memfd_create)
+#if defined(__NR_memfd_create)
+#define SYS_memfd_create __NR_memfd_create
+#elif defined(__arm__)
+#define SYS_memfd_create 385
+#endif
+#endif
+
+#if !defined(MFD_CLOEXEC)
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+#if !defined(MFD_ALLOW_SEALING)
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+#if !defined(F_ADD_SEALS)
+#if !defined(F_LINUX_SPECIFIC_BASE)
+#define F_LINUX_SPECIFIC_BASE 1024
+#endif
+#define F_ADD_SEALS (F_LINUX_SPECIFIC_BASE + 9)
+#define F_GET_SEALS (F_LINUX_SPECIFIC_BASE + 10)
+
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+
+#if defined(__SANITIZE_THREAD__)
+#define RIALTO_IPC_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define RIALTO_IPC_TSAN 1
+#endif
+#endif
+
+#if defined(RIALTO_IPC_TSAN)
+extern "C" void __tsan_acquire(void *addr); // NOLINT(build/include_what_you_use)
+extern "C" void __tsan_release(void *addr); // NOLINT(build/include_what_you_use)
+#endif
+
+namespace
+{
+// fills the rest of the ring when a record doesn't fit before the end of it
+constexpr uint32_t kPaddingRecord = 0xffffffff;
+
+constexpr uint32_t kMinRingCapacity = 4 * 1024;
+constexpr uint32_t kMaxRingCapacity = 1024 * 1024;
+
+constexpr unsigned kMinSpins = 32;
+constexpr unsigned kMaxSpins = 8192;
+
+bool isValidCapacity(uint32_t capacity)
+{
+    return (capacity >= kMinRingCapacity) && (capacity <= kMaxRingCapacity) && ((capacity & (capacity - 1)) == 0);
+}
+
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+bool isEventFd(int fd)
+{
+    char path[32];
+    char target[32];
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+    const ssize_t len = readlink(path, target, sizeof(target) - 1);
+    if (len < 0)
+        return false;
+    target[len] = '\0';
+
+    const int flags = fcntl(fd, F_GETFL);
+    return (strcmp(target, "anon_inode:[eventfd]") == 0) && (flags >= 0) && (flags & O_NONBLOCK);
+}
+
+int closeFd(int fd)
+{
+    return (fd >= 0) ? close(fd) : 0;
+}
+
+// ThreadSanitizer can't pair the atomics of the two ends of a ring when they're mapped at different addresses, so
+// the publishing and consuming of records is also reported on a key shared by both mappings
+inline void syncRelease(const void *key)
+{
+#if defined(RIALTO_IPC_TSAN)
+    __tsan_release(const_cast<void *>(key));
+#else
+    (void)key;
+#endif
+}
+
+inline void syncAcquire(const void *key)
+{
+#if defined(RIALTO_IPC_TSAN)
+    __tsan_acquire(const_cast<void *>(key));
+#else
+    (void)key;
+#endif
+}
+
+#if defined(RIALTO_IPC_TSAN)
+// the keys of the rings, indexed by the memory's inode and the ring within it
+char g_syncKeys[64];
+#endif
+} // namespace
+
+namespace firebolt::rialto::ipc
+{
+size_t ShmRing::memorySize(uint32_t capacity)
+{
+    return sizeof(Control) + capacity;
+}
+
+ShmRing::ShmRing(void *memory, uint32_t capacity, bool initialise)
+    : m_kCapacity(capacity), m_kControl(reinterpret_cast<Control *>(memory)),
+      m_kData(reinterpret_cast<uint8_t *>(memory) + sizeof(Control)), m_syncKey(memory), m_head(0), m_tail(0),
+      m_readSize(0)
+{
+    if (initialise)
+        m_kControl->consumerWaiting.store(1, std::memory_order_relaxed);
+}
+
+uint32_t ShmRing::recordSize(size_t length)
+{
+    return static_cast<uint32_t>((sizeof(RecordHeader) + length + 7) & ~static_cast<size_t>(7));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Checks if there are \a size free bytes in the ring, given the \a tail read
+    from the consumer.  A tail that is ahead of the head or too far behind it
+    can only come from a misbehaving consumer, so the ring is treated as full.
+
+ */
+bool ShmRing::hasRoom(uint32_t tail, uint32_t size) const
+{
+    const uint32_t used = m_head - tail;
+    return (used <= m_kCapacity) && ((m_kCapacity - used) >= size);
+}
+
+bool ShmRing::ensureRoom(size_t length)
+{
+    if (length > maxRecordLength())
+        return false;
+
+    // a record that doesn't fit before the end of the ring also uses the rest of it
+    const uint32_t size = recordSize(length);
+    const uint32_t contiguous = m_kCapacity - (m_head & (m_kCapacity - 1));
+    const uint32_t required = (size > contiguous) ? (size + contiguous) : size;
+
+    if (hasRoom(m_kControl->tail.load(std::memory_order_acquire), required))
+    {
+        syncAcquire(m_syncKey);
+        return true;
+    }
+
+    // flag that we're waiting, then check again in case the consumer released
+    // records before it could see the flag
+    m_kControl->producerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!hasRoom(m_kControl->tail.load(std::memory_order_acquire), required))
+        return false;
+
+    syncAcquire(m_syncKey);
+    return true;
+}
+
+bool ShmRing::write(RecordType type, const struct iovec *iov, size_t iovCount)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < iovCount; i++)
+        length += iov[i].iov_len;
+
+    if (!ensureRoom(length))
+        return false;
+
+    uint32_t offset = m_head & (m_kCapacity - 1);
+    const uint32_t contiguous = m_kCapacity - offset;
+    const uint32_t size = recordSize(length);
+    if (size > contiguous)
+    {
+        const RecordHeader padding = {contiguous - static_cast<uint32_t>(sizeof(RecordHeader)), kPaddingRecord};
+        memcpy(m_kData + offset, &padding, sizeof(padding));
+        m_head += contiguous;
+        offset = 0;
+    }
+
+    const RecordHeader header = {static_cast<uint32_t>(length), static_cast<uint32_t>(type)};
+    memcpy(m_kData + offset, &header, sizeof(header));
+
+    uint8_t *data = m_kData + offset + sizeof(header);
+    for (size_t i = 0; i < iovCount; i++)
+    {
+        memcpy(data, iov[i].iov_base, iov[i].iov_len);
+        data += iov[i].iov_len;
+    }
+
+    m_head += size;
+    syncRelease(m_syncKey);
+    m_kControl->head.store(m_head, std::memory_order_release);
+
+    return true;
+}
+
+bool ShmRing::waitForRoom(size_t length, std::chrono::steady_clock::time_point deadline)
+{
+    while (!ensureRoom(length))
+    {
+        // the consumer wakes the futex on the tail after releasing records, if
+        // the tail has already moved on the wait returns straight away
+        const uint32_t tail = m_kControl->tail.load(std::memory_order_acquire);
+
+        const auto now = std::chrono::steady_clock::now();
+        if ((length > maxRecordLength()) || (now >= deadline))
+            return false;
+
+        const auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+        struct timespec ts = {static_cast<time_t>(timeout.count() / 1000000000),
+                              static_cast<long>(timeout.count() % 1000000000)}; // NOLINT(runtime/int)
+
+        if ((syscall(SYS_futex, &m_kControl->tail, FUTEX_WAIT, tail, &ts, nullptr, 0) != 0) && (errno != EAGAIN) &&
+            (errno != EINTR) && (errno != ETIMEDOUT))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to wait for room in the ring");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ShmRing::wakeConsumer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return (m_kControl->consumerWaiting.load(std::memory_order_relaxed) != 0) &&
+           (m_kControl->consumerWaiting.exchange(0) != 0);
+}
+
+ShmRing::ReadStatus ShmRing::read(Record *record)
+{
+    const uint32_t head = m_kControl->head.load(std::memory_order_acquire);
+    syncAcquire(m_syncKey);
+    while (true)
+    {
+        const uint32_t available = head - m_tail;
+        if (available == 0)
+            return ReadStatus::EMPTY;
+        if ((available > m_kCapacity) || ((available % 8) != 0))
+            return ReadStatus::CORRUPT;
+
+        // the header is copied out so the producer can't change it after it's been checked
+        const uint32_t offset = m_tail & (m_kCapacity - 1);
+        const uint32_t contiguous = m_kCapacity - offset;
+        RecordHeader header;
+        memcpy(&header, m_kData + offset, sizeof(header));
+        if (header.length > (contiguous - sizeof(header)))
+            return ReadStatus::CORRUPT;
+
+        const uint32_t size = recordSize(header.length);
+        if (size > available)
+            return ReadStatus::CORRUPT;
+
+        if (header.type == kPaddingRecord)
+        {
+            if (size != contiguous)
+                return ReadStatus::CORRUPT;
+
+            m_tail += size;
+            syncRelease(m_syncKey);
+            m_kControl->tail.store(m_tail, std::memory_order_release);
+            continue;
+        }
+
+        if ((header.type < static_cast<uint32_t>(RecordType::MESSAGE)) ||
+            (header.type > static_cast<uint32_t>(RecordType::START)))
+            return ReadStatus::CORRUPT;
+
+        record->type = static_cast<RecordType>(header.type);
+        record->data = m_kData + offset + sizeof(header);
+        record->length = header.length;
+        m_readSize = size;
+
+        return ReadStatus::RECORD;
+    }
+}
+
+void ShmRing::release()
+{
+    m_tail += m_readSize;
+    m_readSize = 0;
+    syncRelease(m_syncKey);
+    m_kControl->tail.store(m_tail, std::memory_order_release);
+}
+
+bool ShmRing::prepareToSleep()
+{
+    m_kControl->consumerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    return m_kControl->head.load(std::memory_order_acquire) == m_tail;
+}
+
+bool ShmRing::wakeProducer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((m_kControl->producerWaiting.load(std::memory_order_relaxed) == 0) ||
+        (m_kControl->producerWaiting.exchange(0) == 0))
+        return false;
+
+    // the producer may be blocked on the futex, or waiting for the doorbell
+    if (syscall(SYS_futex, &m_kControl->tail, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0) < 0)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to wake the producer");
+
+    return true;
+}
+
+std::unique_ptr<ShmRingTransport> ShmRingTransport::create(uint32_t ringCapacity)
+{
+    if (!isValidCapacity(ringCapacity))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid ring capacity %u", ringCapacity);
+        return nullptr;
+    }
+
+    const size_t kMappingSize = 2 * ShmRing::memorySize(ringCapacity);
+
+    int memoryFd = static_cast<int>(syscall(SYS_memfd_create, "rialto_ipc_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+    if (memoryFd < 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to create the ring memory");
+        return nullptr;
+    }
+
+    void *mapping = MAP_FAILED;
+    if (ftruncate(memoryFd, static_cast<off_t>(kMappingSize)) != 0)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to resize the ring memory");
+    else if (fcntl(memoryFd, F_ADD_SEALS, (F_SEAL_SEAL | F_SEAL_GROW | F_SEAL_SHRINK)) != 0)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to seal the ring memory");
+    else if ((mapping = mmap(nullptr, kMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0)) == MAP_FAILED)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to map the ring memory");
+
+    int serverDoorbellFd = -1;
+    int clientDoorbellFd = -1;
+    if (mapping != MAP_FAILED)
+    {
+        serverDoorbellFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        clientDoorbellFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if ((serverDoorbellFd >= 0) && (clientDoorbellFd >= 0))
+        {
+            return std::unique_ptr<ShmRingTransport>(
+                new ShmRingTransport(false, memoryFd, serverDoorbellFd, clientDoorbellFd, ringCapacity, mapping));
+        }
+
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to create the ring doorbells");
+        munmap(mapping, kMappingSize);
+    }
+
+    closeFd(clientDoorbellFd);
+    closeFd(serverDoorbellFd);
+    closeFd(memoryFd);
+
+    return nullptr;
+}
+
+std::unique_ptr<ShmRingTransport> ShmRingTransport::attach(const FileDescriptor &memory,
+                                                           const FileDescriptor &serverDoorbell,
+                                                           const FileDescriptor &clientDoorbell,
+                                                           uint32_t ringCapacity)
+{
+    if (!isValidCapacity(ringCapacity))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid ring capacity %u", ringCapacity);
+        return nullptr;
+    }
+
+    // the client mustn't be able to shrink the memory once it's mapped, or
+    // accessing it would fault
+    const size_t kMappingSize = 2 * ShmRing::memorySize(ringCapacity);
+    struct stat details;
+    const int seals = fcntl(memory.fd(), F_GET_SEALS);
+    if ((fstat(memory.fd(), &details) != 0) || (seals < 0))
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to get the details of the ring memory");
+        return nullptr;
+    }
+    if ((details.st_size < static_cast<off_t>(kMappingSize)) || !(seals & F_SEAL_SHRINK))
+    {
+        RIALTO_IPC_LOG_ERROR("ring memory is too small or not sealed");
+        return nullptr;
+    }
+
+    // the doorbells must be non-blocking eventfds, so ringing them can't block the server
+    if (!isEventFd(serverDoorbell.fd()) || !isEventFd(clientDoorbell.fd()))
+    {
+        RIALTO_IPC_LOG_ERROR("ring doorbells are not eventfds");
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, kMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, memory.fd(), 0);
+    if (mapping == MAP_FAILED)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to map the ring memory");
+        return nullptr;
+    }
+
+    FileDescriptor memoryFd(memory);
+    FileDescriptor serverDoorbellFd(serverDoorbell);
+    FileDescriptor clientDoorbellFd(clientDoorbell);
+    if (!memoryFd.isValid() || !serverDoorbellFd.isValid() || !clientDoorbellFd.isValid())
+    {
+        munmap(mapping, kMappingSize);
+        return nullptr;
+    }
+
+    return std::unique_ptr<ShmRingTransport>(new ShmRingTransport(true, memoryFd.release(), serverDoorbellFd.release(),
+                                                                  clientDoorbellFd.release(), ringCapacity, mapping));
+}
+
+ShmRingTransport::ShmRingTransport(bool isServer, int memoryFd, int serverDoorbellFd, int clientDoorbellFd,
+                                   uint32_t ringCapacity, void *mapping)
+    : m_kIsServer(isServer), m_kRingCapacity(ringCapacity), m_kMappingSize(2 * ShmRing::memorySize(ringCapacity)),
+      m_memoryFd(memoryFd), m_serverDoorbellFd(serverDoorbellFd), m_clientDoorbellFd(clientDoorbellFd),
+      m_kMapping(mapping), m_spins(kMinSpins), m_kMaxSpins((std::thread::hardware_concurrency() > 1) ? kMaxSpins : 0)
+{
+    // the request ring is followed by the response ring
+    uint8_t *requests = reinterpret_cast<uint8_t *>(mapping);
+    uint8_t *responses = requests + ShmRing::memorySize(ringCapacity);
+
+    m_tx = std::make_unique<ShmRing>(isServer ? responses : requests, ringCapacity, !isServer);
+    m_rx = std::make_unique<ShmRing>(isServer ? requests : responses, ringCapacity, !isServer);
+
+#if defined(RIALTO_IPC_TSAN)
+    // the client and the server map the memory at different addresses, even in the same process
+    struct stat details;
+    if (fstat(memoryFd, &details) == 0)
+    {
+        const size_t kRequestsKey = (details.st_ino * 2) % sizeof(g_syncKeys);
+        const size_t kResponsesKey = kRequestsKey + 1;
+        m_tx->setSyncKey(&g_syncKeys[isServer ? kResponsesKey : kRequestsKey]);
+        m_rx->setSyncKey(&g_syncKeys[isServer ? kRequestsKey : kResponsesKey]);
+    }
+#endif
+
+    if (m_kMaxSpins == 0)
+        m_spins = 0;
+}
+
+ShmRingTransport::~ShmRingTransport()
+{
+    m_tx.reset();
+    m_rx.reset();
+
+    if (munmap(m_kMapping, m_kMappingSize) != 0)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to unmap the ring memory");
+
+    if ((closeFd(m_clientDoorbellFd) != 0) || (closeFd(m_serverDoorbellFd) != 0) || (closeFd(m_memoryFd) != 0))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close the ring fds");
+}
+
+bool ShmRingTransport::send(ShmRing::RecordType type, const struct msghdr *msg)
+{
+    return m_tx->write(type, msg->msg_iov, msg->msg_iovlen);
+}
+
+bool ShmRingTransport::waitForRoom(size_t length, std::chrono::steady_clock::time_point deadline)
+{
+    if (m_tx->ensureRoom(length))
+        return true;
+
+    // make sure the peer is awake to free some room
+    flush();
+    return m_tx->waitForRoom(length, deadline);
+}
+
+void ShmRingTransport::flush()
+{
+    if (m_tx->wakeConsumer())
+        ringDoorbell(m_kIsServer ? m_clientDoorbellFd : m_serverDoorbellFd);
+}
+
+void ShmRingTransport::clearDoorbell()
+{
+    uint64_t ignore;
+    if ((TEMP_FAILURE_RETRY(read(doorbellFd(), &ignore, sizeof(ignore))) != sizeof(ignore)) && (errno != EAGAIN))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to read the ring doorbell");
+}
+
+ShmRing::ReadStatus ShmRingTransport::receive(ShmRing::Record *record)
+{
+    ShmRing::ReadStatus status = m_rx->read(record);
+    if (status != ShmRing::ReadStatus::EMPTY)
+        return status;
+
+    // spin for a while before sleeping, the spin is worth extending while it
+    // keeps catching records
+    for (unsigned i = 0; i < m_spins; i++)
+    {
+        cpuRelax();
+        status = m_rx->read(record);
+        if (status != ShmRing::ReadStatus::EMPTY)
+        {
+            m_spins = std::min(m_spins * 2, m_kMaxSpins);
+            return status;
+        }
+    }
+    if (m_spins > 0)
+        m_spins = std::max(m_spins / 2, kMinSpins);
+
+    if (m_rx->prepareToSleep())
+        return ShmRing::ReadStatus::EMPTY;
+
+    return m_rx->read(record);
+}
+
+void ShmRingTransport::release()
+{
+    m_rx->release();
+
+    if (m_rx->wakeProducer())
+        ringDoorbell(m_kIsServer ? m_clientDoorbellFd : m_serverDoorbellFd);
+}
+
+void ShmRingTransport::ringDoorbell(int fd)
+{
+    const uint64_t kValue = 1;
+    if (TEMP_FAILURE_RETRY(write(fd, &kValue, sizeof(kValue))) != sizeof(kValue))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to ring the doorbell");
+}
+
+} // namespace firebolt::rialto::ipc
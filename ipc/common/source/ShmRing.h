@@ -0,0 +1,319 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_SHM_RING_H_
+#define FIREBOLT_RIALTO_IPC_SHM_RING_H_
+
+#include "FileDescriptor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <sys/socket.h>
+
+namespace firebolt::rialto::ipc
+{
+/**
+ * @brief Single producer, single consumer ring of variable length records, in memory shared by two processes.
+ *
+ * Each side keeps its own copy of the index it owns, so a misbehaving peer can't make it read or write outside
+ * the ring, and records read from the ring are checked before being returned.  Records are stored contiguously,
+ * so a record can be read in place, and are 8 byte aligned.
+ *
+ * The ring doesn't block, the waiting flags are used by the owner of the ring to know when to wake the peer.
+ */
+class ShmRing
+{
+public:
+    /**
+     * @brief The types of record.
+     */
+    enum class RecordType : uint32_t
+    {
+        MESSAGE = 1, ///< A transport message or frame.
+        BARRIER = 2, ///< The next message is sent on the socket, as it passes fds or is too big for the ring.
+        START = 3    ///< The first record sent by the server, the messages that follow are sent on the ring.
+    };
+
+    /**
+     * @brief The result of reading from the ring.
+     */
+    enum class ReadStatus
+    {
+        EMPTY,
+        RECORD,
+        CORRUPT
+    };
+
+    /**
+     * @brief A record read from the ring, valid until released.
+     */
+    struct Record
+    {
+        RecordType type;
+        const uint8_t *data;
+        size_t length;
+    };
+
+    /**
+     * @brief Gets the number of bytes of shared memory used by a ring.
+     *
+     * @param[in] capacity : The number of bytes available for records, a power of two.
+     *
+     * @retval the size of the ring in bytes.
+     */
+    static size_t memorySize(uint32_t capacity);
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] memory     : The shared memory holding the ring, zero filled when the ring is created.
+     * @param[in] capacity   : The number of bytes available for records, a power of two.
+     * @param[in] initialise : Set by the side creating the ring, the consumer starts off sleeping so the producer
+     *                         rings the doorbell for the first record.
+     */
+    ShmRing(void *memory, uint32_t capacity, bool initialise);
+
+    /**
+     * @brief Gets the largest record length, a quarter of the capacity so that a record always fits in an empty ring.
+     */
+    size_t maxRecordLength() const { return (m_kCapacity / 4) - sizeof(RecordHeader); }
+
+    /**
+     * @brief Writes a record, gathered from \a iovCount buffers.
+     *
+     * If there is no room for the record, the producer is flagged as waiting, so the consumer wakes it once it has
+     * released some records.
+     *
+     * @retval true if the record was written, false if there is no room for it.
+     */
+    bool write(RecordType type, const struct iovec *iov, size_t iovCount);
+
+    /**
+     * @brief Checks if there is room for a record, flagging the producer as waiting if not.
+     */
+    bool ensureRoom(size_t length);
+
+    /**
+     * @brief Blocks until there is room for a record or the deadline expires.
+     */
+    bool waitForRoom(size_t length, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Checks if the consumer has to be woken after writing records.
+     *
+     * @retval true if the consumer is sleeping, the caller should ring its doorbell.
+     */
+    bool wakeConsumer();
+
+    /**
+     * @brief Reads the next record, which must be released before reading any other record.
+     */
+    ReadStatus read(Record *record);
+
+    /**
+     * @brief Releases the last record read.
+     */
+    void release();
+
+    /**
+     * @brief Flags the consumer as sleeping, to be woken by the producer when it writes a record.
+     *
+     * @retval true if the ring is still empty, false if records were written meanwhile.
+     */
+    bool prepareToSleep();
+
+    /**
+     * @brief Checks if the producer has to be woken after releasing records.
+     *
+     * @retval true if the producer is waiting for room, the caller should ring its doorbell.
+     */
+    bool wakeProducer();
+
+    /**
+     * @brief Sets the key that the ring's synchronisation is reported on to ThreadSanitizer.
+     *
+     * Only needed when both ends of the ring are mapped at different addresses in the same process.
+     */
+    void setSyncKey(const void *key) { m_syncKey = key; }
+
+private:
+    struct RecordHeader
+    {
+        uint32_t length;
+        uint32_t type;
+    };
+
+    struct Control
+    {
+        alignas(64) std::atomic<uint32_t> head;
+        std::atomic<uint32_t> producerWaiting;
+        alignas(64) std::atomic<uint32_t> tail;
+        std::atomic<uint32_t> consumerWaiting;
+    };
+
+    static uint32_t recordSize(size_t length);
+    bool hasRoom(uint32_t tail, uint32_t size) const;
+
+private:
+    const uint32_t m_kCapacity;
+    Control *const m_kControl;
+    uint8_t *const m_kData;
+    const void *m_syncKey;
+
+    // the producer's head and the consumer's tail, the values in the shared memory are only written
+    uint32_t m_head;
+    uint32_t m_tail;
+
+    // the size of the record returned by the last read
+    uint32_t m_readSize;
+};
+
+/**
+ * @brief The shared memory transport of a channel, a pair of rings plus an eventfd doorbell for each side.
+ *
+ * The client creates the transport and passes the memory and the doorbells to the server over the socket.  The
+ * request ring carries the messages from the client to the server, and the response ring the messages from the
+ * server to the client.  The socket is still used for messages passing fds and for detecting disconnections.
+ *
+ * Before sleeping, the consumer spins on its ring for a while, the number of spins grows while records keep
+ * arriving during the spin and shrinks otherwise.  There's no spinning on single core systems.
+ */
+class ShmRingTransport
+{
+public:
+    /**
+     * @brief The default capacity of each ring.
+     */
+    static constexpr uint32_t kDefaultRingCapacity = 64 * 1024;
+
+    /**
+     * @brief Creates the transport on the client side.
+     *
+     * @param[in] ringCapacity : The capacity of each ring, a power of two.
+     *
+     * @retval the transport, or null on failure.
+     */
+    static std::unique_ptr<ShmRingTransport> create(uint32_t ringCapacity = kDefaultRingCapacity);
+
+    /**
+     * @brief Attaches the server side to a transport created by a client.
+     *
+     * The memory is checked to be sealed against shrinking, so the client can't make the server fault when
+     * accessing it.
+     *
+     * @retval the transport, or null if the memory or the capacity are not valid.
+     */
+    static std::unique_ptr<ShmRingTransport> attach(const FileDescriptor &memory, const FileDescriptor &serverDoorbell,
+                                                    const FileDescriptor &clientDoorbell, uint32_t ringCapacity);
+
+    ~ShmRingTransport();
+    ShmRingTransport(const ShmRingTransport &) = delete;
+    ShmRingTransport(ShmRingTransport &&) = delete;
+    ShmRingTransport &operator=(const ShmRingTransport &) = delete;
+    ShmRingTransport &operator=(ShmRingTransport &&) = delete;
+
+    int memoryFd() const { return m_memoryFd; }
+    int serverDoorbellFd() const { return m_serverDoorbellFd; }
+    int clientDoorbellFd() const { return m_clientDoorbellFd; }
+    uint32_t ringCapacity() const { return m_kRingCapacity; }
+
+    /**
+     * @brief Gets the doorbell rung by the peer when it has written records for this side, to poll on.
+     */
+    int doorbellFd() const { return m_kIsServer ? m_serverDoorbellFd : m_clientDoorbellFd; }
+
+    /**
+     * @brief Gets the largest message that can be sent on the ring.
+     */
+    size_t maxMessageLength() const { return m_tx->maxRecordLength(); }
+
+    /**
+     * @brief Writes a record holding the data of \a msg, the caller must serialise the calls.
+     *
+     * The peer isn't woken until flush() is called.
+     *
+     * @retval true if written, false if there's no room in the ring.
+     */
+    bool send(ShmRing::RecordType type, const struct msghdr *msg);
+
+    /**
+     * @brief Waits until there is room for a record of \a length bytes or \a deadline expires.
+     */
+    bool waitForRoom(size_t length, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Checks if there is room for a record of \a length bytes, if not the peer rings the doorbell once
+     *        there is.
+     */
+    bool ensureRoom(size_t length) { return m_tx->ensureRoom(length); }
+
+    /**
+     * @brief Rings the peer's doorbell if it is sleeping.
+     */
+    void flush();
+
+    /**
+     * @brief Clears the doorbell of this side.
+     */
+    void clearDoorbell();
+
+    /**
+     * @brief Reads the next record sent by the peer, spinning for a while if there is none yet.
+     *
+     * When EMPTY is returned the doorbell is armed, so it is rung when the next record is written.
+     */
+    ShmRing::ReadStatus receive(ShmRing::Record *record);
+
+    /**
+     * @brief Releases the last record received.
+     */
+    void release();
+
+private:
+    ShmRingTransport(bool isServer, int memoryFd, int serverDoorbellFd, int clientDoorbellFd, uint32_t ringCapacity,
+                     void *mapping);
+
+    void ringDoorbell(int fd);
+
+private:
+    const bool m_kIsServer;
+    const uint32_t m_kRingCapacity;
+    const size_t m_kMappingSize;
+
+    // owned by the transport
+    int m_memoryFd;
+    int m_serverDoorbellFd;
+    int m_clientDoorbellFd;
+    void *const m_kMapping;
+
+    std::unique_ptr<ShmRing> m_tx;
+    std::unique_ptr<ShmRing> m_rx;
+
+    // the number of times to poll the ring before arming the doorbell
+    unsigned m_spins;
+    const unsigned m_kMaxSpins;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_SHM_RING_H_
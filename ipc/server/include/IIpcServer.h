@@ -134,6 +134,11 @@ public:
  *  can do that by setting up a loop that calls wait() and then process(). Or
  *  you can get the fd() and add it to an external poll loop, and when woken call
  *  process().
+ *
+ *  By default the service methods are called from within process(). If the server
+ *  was created with IServerFactory::DISPATCH_ON_WORKER_THREADS, they are instead
+ *  called from a pool of worker threads, so a slow method call of one client
+ *  doesn't hold up the other clients.
  */
 class IServer
 {
@@ -222,6 +227,42 @@ public:
      * @retval false if there was an error, true otherwise
      */
     virtual bool process() = 0;
+
+    /**
+     * @brief How the events of a type are handled when a client falls behind.
+     *
+     * Events are queued for the client and sent together, at the end of the
+     * process() call they were sent in or the next one, and replies are sent
+     * straight away along with the events queued before them.  Messages are
+     * sent without blocking; if a client's socket buffer is full they stay
+     * queued until the client has read enough.  The policy decides what
+     * happens to an event sent while other events are queued for the client.
+     */
+    enum class EventPolicy
+    {
+        QUEUE,    ///< The event is queued, this is the default policy.
+        COALESCE, ///< The event is queued and replaces the queued events of the same type with the same key.
+        DROP      ///< The event is dropped if the client's socket buffer is full.
+    };
+
+    /**
+     * @brief Sets the policy for events of the given type.
+     *
+     * \threadsafe
+     *
+     * Events with the COALESCE or DROP policy are also the first to be removed
+     * from a client's queue if the queue is full.
+     *
+     * @param[in] eventType : The full name of the event message type.
+     * @param[in] policy    : The policy for the events.
+     * @param[in] keyField  : For COALESCE, the name of a field of the event, only the queued events with the same
+     *                        value in the field are replaced.  If empty, all queued events of the type are replaced.
+     */
+    inline void setEventPolicy(const std::string &eventType, EventPolicy policy)
+    {
+        setEventPolicy(eventType, policy, std::string());
+    }
+    virtual void setEventPolicy(const std::string &eventType, EventPolicy policy, const std::string &keyField) = 0;
 };
 
 } // namespace firebolt::rialto::ipc
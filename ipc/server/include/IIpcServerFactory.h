@@ -37,6 +37,15 @@ public:
         ALLOW_MONITORING = (1u << 0), ///< If set then a root user can install a
                                       ///  monitor socket to view all sent / recveived
                                       ///  message from / to the server
+        DISPATCH_ON_WORKER_THREADS = (1u << 1), ///< If set then method calls are executed on a pool of
+                                                ///  worker threads instead of the thread calling process().
+                                                ///  Calls from one client are still executed in order, one at
+                                                ///  a time, but calls from different clients run concurrently.
+                                                ///  The client disconnected callbacks are called on the pool,
+                                                ///  and calls may run until the server object is destroyed.
+        SHM_RING_TRANSPORT = (1u << 2), ///< If set then clients may move their messages onto a pair of shared
+                                        ///  memory rings, the socket is still used for messages passing fds
+                                        ///  and to detect the client disconnecting.
     };
 
     /**
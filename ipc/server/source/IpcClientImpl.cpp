@@ -62,7 +62,7 @@ bool ClientImpl::sendEvent(const std::shared_ptr<google::protobuf::Message> &mes
 {
     auto server = m_kServer.lock();
     if (server)
-        return server->sendEvent(m_kClientId, message);
+        return server->sendEvent(m_kClientId, m_framedMessages, message);
     else
         return false;
 }
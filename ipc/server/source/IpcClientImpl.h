@@ -24,9 +24,11 @@
 
 #include <sys/socket.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace firebolt::rialto::ipc
 {
@@ -61,6 +63,20 @@ private:
     const struct ucred m_kCredentials;
 
     std::map<std::string, std::shared_ptr<google::protobuf::Service>> m_services;
+
+    std::atomic<bool> m_framedMessages{false};
+    std::atomic<bool> m_numericIds{false};
+
+    struct Method
+    {
+        std::string fullName;
+        std::shared_ptr<google::protobuf::Service> service;
+        const google::protobuf::MethodDescriptor *descriptor = nullptr;
+    };
+
+    // the methods called as frames, indexed by the ids defined by the client, only
+    // accessed while processing the client's method calls
+    std::vector<Method> m_methods;
 };
 
 } // namespace firebolt::rialto::ipc
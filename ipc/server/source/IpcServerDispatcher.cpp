@@ -0,0 +1,201 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IpcServerDispatcher.h"
+#include "IpcLogging.h"
+
+#include <cinttypes>
+#include <iterator>
+#include <utility>
+
+namespace firebolt::rialto::ipc
+{
+ServerDispatcher::ServerDispatcher(unsigned numOfThreads) : m_kState(std::make_shared<State>())
+{
+    m_workerThreads.reserve(numOfThreads);
+    for (unsigned i = 0; i < numOfThreads; i++)
+    {
+        m_workerThreads.emplace_back(&ServerDispatcher::workerThreadLoop, m_kState);
+    }
+
+    RIALTO_IPC_LOG_INFO("dispatching method calls on %u worker threads", numOfThreads);
+}
+
+ServerDispatcher::~ServerDispatcher()
+{
+    std::vector<std::function<void()>> discardedTasks;
+
+    {
+        std::lock_guard<std::mutex> locker(m_kState->mutex);
+        m_kState->isRunning = false;
+
+        // drop the pending method calls, but leave the final tasks of the removed clients (the disconnect
+        // callbacks) queued so that the worker threads run them before leaving
+        for (auto &entry : m_kState->strands)
+        {
+            Strand &strand = entry.second;
+            if (strand.isRemoved)
+                continue;
+
+            std::move(strand.tasks.begin(), strand.tasks.end(), std::back_inserter(discardedTasks));
+            strand.tasks.clear();
+        }
+    }
+    m_kState->cv.notify_all();
+
+    // release anything captured by the discarded tasks without holding the lock
+    discardedTasks.clear();
+
+    for (std::thread &thread : m_workerThreads)
+    {
+        // the server may be released from within a method call, in which case the worker thread leaves its loop
+        // on its own once the call returns
+        if (thread.get_id() == std::this_thread::get_id())
+            thread.detach();
+        else
+            thread.join();
+    }
+}
+
+void ServerDispatcher::dispatch(uint64_t clientId, std::function<void()> &&task)
+{
+    std::lock_guard<std::mutex> locker(m_kState->mutex);
+    if (!m_kState->isRunning)
+    {
+        RIALTO_IPC_LOG_WARN("dropping task of client %" PRIu64 ", the dispatcher is stopping", clientId);
+        return;
+    }
+
+    Strand &strand = m_kState->strands[clientId];
+    if (strand.isRemoved)
+    {
+        RIALTO_IPC_LOG_WARN("dropping task of removed client %" PRIu64, clientId);
+        return;
+    }
+
+    strand.tasks.emplace_back(std::move(task));
+    schedule(*m_kState, clientId, strand);
+}
+
+void ServerDispatcher::removeClient(uint64_t clientId, std::function<void()> &&finalTask)
+{
+    std::deque<std::function<void()>> discardedTasks;
+
+    {
+        std::lock_guard<std::mutex> locker(m_kState->mutex);
+
+        Strand &strand = m_kState->strands[clientId];
+        if (strand.isRemoved)
+        {
+            RIALTO_IPC_LOG_ERROR("client %" PRIu64 " already removed", clientId);
+            return;
+        }
+
+        strand.tasks.swap(discardedTasks);
+        strand.tasks.emplace_back(std::move(finalTask));
+        strand.isRemoved = true;
+        schedule(*m_kState, clientId, strand);
+    }
+
+    if (!discardedTasks.empty())
+    {
+        RIALTO_IPC_LOG_DEBUG("discarded %zu pending tasks of client %" PRIu64, discardedTasks.size(), clientId);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Adds the \a strand to the queue of strands ready to run, unless it is already
+    queued or one of the worker threads is currently running a task of it.
+
+    Must be called with the state mutex held.
+
+ */
+void ServerDispatcher::schedule(State &state, uint64_t clientId, Strand &strand)
+{
+    if (!strand.isScheduled)
+    {
+        strand.isScheduled = true;
+        state.readyStrands.push_back(clientId);
+        state.cv.notify_one();
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Runs tasks until the dispatcher is destroyed and no strand is left ready to
+    run, so the final tasks of removed clients are not lost.  A worker takes a single task
+    from the strand at the head of the ready queue, and if the strand has more
+    tasks queued after that, puts it back at the tail.  A strand is therefore
+    only ever processed by one worker at a time and the clients are served
+    round robin.
+
+ */
+void ServerDispatcher::workerThreadLoop(const std::shared_ptr<State> &state)
+{
+    std::unique_lock<std::mutex> locker(state->mutex);
+    while (true)
+    {
+        state->cv.wait(locker, [&state]() { return !state->isRunning || !state->readyStrands.empty(); });
+        if (state->readyStrands.empty())
+            break;
+
+        const uint64_t clientId = state->readyStrands.front();
+        state->readyStrands.pop_front();
+
+        // the strand can't be erased while it is scheduled, so the iterator stays valid while the lock is dropped
+        auto it = state->strands.find(clientId);
+        if (it == state->strands.end())
+        {
+            RIALTO_IPC_LOG_ERROR("missing strand of client %" PRIu64, clientId);
+            continue;
+        }
+        if (it->second.tasks.empty())
+        {
+            // the pending tasks were discarded when the dispatcher was destroyed
+            it->second.isScheduled = false;
+            continue;
+        }
+
+        std::function<void()> task = std::move(it->second.tasks.front());
+        it->second.tasks.pop_front();
+
+        locker.unlock();
+        task();
+        // release anything captured by the task without holding the lock
+        task = nullptr;
+        locker.lock();
+
+        Strand &strand = it->second;
+        if (!strand.tasks.empty())
+            state->readyStrands.push_back(clientId);
+        else if (strand.isRemoved)
+            state->strands.erase(it);
+        else
+            strand.isScheduled = false;
+    }
+}
+
+} // namespace firebolt::rialto::ipc
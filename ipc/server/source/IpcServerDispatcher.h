@@ -0,0 +1,115 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_IPC_SERVER_DISPATCHER_H_
+#define FIREBOLT_RIALTO_IPC_IPC_SERVER_DISPATCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace firebolt::rialto::ipc
+{
+/**
+ * @brief Runs the method calls of the server clients on a pool of worker threads.
+ *
+ * Every client owns a strand: its tasks are executed in the order they were dispatched and never
+ * concurrently, while the tasks of different clients can run in parallel.
+ */
+class ServerDispatcher
+{
+public:
+    explicit ServerDispatcher(unsigned numOfThreads);
+
+    /**
+     * @brief Stops the worker threads.
+     *
+     * Tasks that have not been started yet are discarded, except for the final tasks of the removed clients, which
+     * are always executed before the worker threads leave.
+     */
+    ~ServerDispatcher();
+
+    ServerDispatcher(const ServerDispatcher &) = delete;
+    ServerDispatcher &operator=(const ServerDispatcher &) = delete;
+    ServerDispatcher(ServerDispatcher &&) = delete;
+    ServerDispatcher &operator=(ServerDispatcher &&) = delete;
+
+    /**
+     * @brief Queues the task on the strand of the client.
+     *
+     * \threadsafe
+     *
+     * @param[in] clientId  : The id of the client the task belongs to.
+     * @param[in] task      : The task to execute.
+     */
+    void dispatch(uint64_t clientId, std::function<void()> &&task);
+
+    /**
+     * @brief Removes the strand of the client.
+     *
+     * \threadsafe
+     *
+     * Tasks of the client that have not been started yet are discarded. The final task is executed once the
+     * task currently running for the client (if any) has finished, and any later tasks for the client are dropped.
+     *
+     * @param[in] clientId  : The id of the client.
+     * @param[in] finalTask : The last task to execute for the client.
+     */
+    void removeClient(uint64_t clientId, std::function<void()> &&finalTask);
+
+private:
+    struct Strand
+    {
+        std::deque<std::function<void()>> tasks;
+        bool isScheduled{false};
+        bool isRemoved{false};
+    };
+
+    /**
+     * @brief The state shared with the worker threads.
+     *
+     * It is reference counted, so that a worker thread that happens to drop the last reference to the server
+     * (and therefore destroys the dispatcher) can still safely leave its loop.
+     */
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool isRunning{true};
+        std::map<uint64_t, Strand> strands;
+        std::deque<uint64_t> readyStrands;
+    };
+
+    static void schedule(State &state, uint64_t clientId, Strand &strand);
+    static void workerThreadLoop(const std::shared_ptr<State> &state);
+
+private:
+    const std::shared_ptr<State> m_kState;
+    std::vector<std::thread> m_workerThreads;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_IPC_SERVER_DISPATCHER_H_
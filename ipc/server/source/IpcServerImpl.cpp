@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstdarg>
+#include <cstdlib>
 #include <string>
 #include <utility>
 #include <vector>
@@ -47,11 +48,52 @@
 #define WAKE_EVENT_ID uint64_t(0)
 #define FIRST_LISTENING_SOCKET_ID uint64_t(1)
 #define FIRST_CLIENT_ID uint64_t(10000)
+#define RING_DOORBELL_FLAG (uint64_t(1) << 63)
+
+#define DEFAULT_DISPATCH_THREADS 4u
+#define MAX_DISPATCH_THREADS 16u
 
 namespace firebolt::rialto::ipc
 {
 const size_t ServerImpl::m_kMaxMessageLen = (128 * 1024);
 
+// limit on the data queued for a client that isn't reading its socket
+const size_t ServerImpl::m_kMaxOutboundBytes = (1024 * 1024);
+
+// limit on the socket messages read ahead of their barrier in the client's ring
+static const size_t kMaxSocketMessagesBehindRing = 32;
+
+// with the dispatcher, the start of each message is read into a pooled buffer that is handed over to the client's
+// strand when the whole message fits in it
+static const size_t kRecvPooledLen = 2 * 1024;
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Returns the number of worker threads to dispatch method calls on, which can
+    be overridden with the RIALTO_IPC_DISPATCH_THREADS environment variable.
+
+ */
+static unsigned getNumOfDispatchThreads()
+{
+    unsigned numOfThreads = DEFAULT_DISPATCH_THREADS;
+
+    const char *dispatchThreads = getenv("RIALTO_IPC_DISPATCH_THREADS");
+    if (dispatchThreads)
+    {
+        char *end = nullptr;
+        const unsigned long value = strtoul(dispatchThreads, &end, 10);
+        if ((end == dispatchThreads) || (*end != '\0') || (value < 1) || (value > MAX_DISPATCH_THREADS))
+            RIALTO_IPC_LOG_WARN("invalid RIALTO_IPC_DISPATCH_THREADS value '%s', ignoring", dispatchThreads);
+        else
+            numOfThreads = static_cast<unsigned>(value);
+    }
+
+    return numOfThreads;
+}
+
 std::shared_ptr<IServerFactory> IServerFactory::createFactory()
 {
     std::shared_ptr<IServerFactory> factory;
@@ -73,12 +115,17 @@ std::shared_ptr<IServer> ServerFactory::create(unsigned flags)
     if (monitor && (strstr(monitor, "ON") || strstr(monitor, "1")))
         flags |= ServerFactory::ALLOW_MONITORING;
 
+    const char *shmRing = getenv("RIALTO_IPC_SHM_RING");
+    if (shmRing && (strstr(shmRing, "ON") || strstr(shmRing, "1")))
+        flags |= ServerFactory::SHM_RING_TRANSPORT;
+
     return std::make_shared<ServerImpl>(flags);
 }
 
 ServerImpl::ServerImpl(unsigned flags)
     : m_pollFd(-1), m_wakeEventFd(-1),
       m_kMonitor(flags & ServerFactory::ALLOW_MONITORING ? std::make_unique<ServerMonitor>() : nullptr),
+      m_kShmRings(flags & ServerFactory::SHM_RING_TRANSPORT),
       m_socketIdCounter(FIRST_LISTENING_SOCKET_ID),
       m_clientIdCounter(FIRST_CLIENT_ID), m_recvDataBuf{0}, m_recvCtrlBuf{0}
 {
@@ -104,10 +151,19 @@ ServerImpl::ServerImpl(unsigned flags)
     {
         RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add eventfd");
     }
+
+    // start the worker threads if method calls should not be executed inside process()
+    if (flags & ServerFactory::DISPATCH_ON_WORKER_THREADS)
+    {
+        m_dispatcher = std::make_unique<ServerDispatcher>(getNumOfDispatchThreads());
+    }
 }
 
 ServerImpl::~ServerImpl()
 {
+    // stop the worker threads first, method calls they may still be running use the server
+    m_dispatcher.reset();
+
     if ((m_pollFd >= 0) && (close(m_pollFd) != 0))
         RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close epoll");
 
@@ -414,6 +470,12 @@ bool ServerImpl::process()
         return false;
     }
 
+    // events sent while dispatching are queued until the end of the cycle
+    {
+        std::lock_guard<std::mutex> locker(m_clientsLock);
+        m_dispatching = true;
+    }
+
     // process the events (maybe 0 if timed out)
     for (int i = 0; i < rc; i++)
     {
@@ -429,6 +491,12 @@ bool ServerImpl::process()
             }
         }
 
+        // check for the doorbell of a client's ring
+        else if (event.data.u64 & RING_DOORBELL_FLAG)
+        {
+            processClientRing(event.data.u64 & ~RING_DOORBELL_FLAG);
+        }
+
         // check for events on the listening socket
         else if (event.data.u64 < FIRST_CLIENT_ID)
         {
@@ -445,9 +513,20 @@ bool ServerImpl::process()
         }
     }
 
+    std::unique_lock<std::mutex> locker(m_clientsLock);
+
+    // send the events queued in this dispatch cycle, or by other threads since the last one
+    m_dispatching = false;
+    for (uint64_t clientId : m_unflushedClients)
+    {
+        auto it = m_clients.find(clientId);
+        if ((it != m_clients.end()) && (it->second.sock >= 0))
+            flushMessages(clientId, &it->second);
+    }
+    m_unflushedClients.clear();
+
     // if we have client sockets that are condemned then we need to shut down
     // and close them as well as remove from epoll
-    std::unique_lock<std::mutex> locker(m_clientsLock);
     if (!m_condemnedClients.empty())
     {
         // take a copy of the set so we can process without the lock held
@@ -463,7 +542,7 @@ bool ServerImpl::process()
                 continue;
             }
 
-            ClientDetails details = it->second;
+            ClientDetails details = std::move(it->second);
 
             // remove from the list of clients
             m_clients.erase(it);
@@ -483,9 +562,30 @@ bool ServerImpl::process()
                     RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close socket");
             }
 
-            // let the installed handler know a client has disconnected
-            if (details.disconnectedCb)
+            // and the same for the doorbell of the client's ring, which is unmapped with the last reference
+            if (details.ring)
+            {
+                if (epoll_ctl(m_pollFd, EPOLL_CTL_DEL, details.ring->doorbellFd(), nullptr) != 0)
+                    RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to remove ring doorbell from epoll");
+
+                details.ring.reset();
+            }
+
+            // let the installed handler know a client has disconnected, when dispatching on the worker threads
+            // this is done after the method call of the client that may still be running
+            if (m_dispatcher)
+            {
+                m_dispatcher->removeClient(clientId,
+                                           [details]()
+                                           {
+                                               if (details.disconnectedCb)
+                                                   details.disconnectedCb(details.client);
+                                           });
+            }
+            else if (details.disconnectedCb)
+            {
                 details.disconnectedCb(details.client);
+            }
 
             // tell any monitors that the client has disconnected
             if (m_kMonitor)
@@ -502,6 +602,24 @@ bool ServerImpl::process()
     return true;
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \threadsafe
+
+    Sets the \a policy for the events of type \a eventType, which is applied
+    when a client has messages queued.
+
+ */
+void ServerImpl::setEventPolicy(const std::string &eventType, EventPolicy policy, const std::string &keyField)
+{
+    std::lock_guard<std::mutex> locker(m_clientsLock);
+
+    if (policy == EventPolicy::QUEUE)
+        m_eventPolicies.erase(eventType);
+    else
+        m_eventPolicies[eventType] = EventPolicyDetails{policy, keyField};
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -687,6 +805,24 @@ static std::vector<FileDescriptor> readMessageFds(const struct msghdr *msg, size
     return fds;
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Returns the number of data bytes in the socket message \a msg, ie. the sum of
+    the lengths of all its iovecs.
+
+ */
+static size_t messageLength(const struct msghdr *msg)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < msg->msg_iovlen; i++)
+        length += msg->msg_iov[i].iov_len;
+
+    return length;
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -719,6 +855,9 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
     // get the client object
     std::shared_ptr<ClientImpl> clientObj = it->second.client;
 
+    // the details are only removed by this thread, so stay valid after releasing the lock
+    ClientDetails *details = &it->second;
+
     // can safely release the lock now we have the clientId and client object
     locker.unlock();
 
@@ -730,62 +869,215 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
         return;
     }
 
+    // send the messages queued while the client's socket buffer was full
+    if (events & EPOLLOUT)
+    {
+        processClientWritable(clientId);
+    }
+
     if (events & EPOLLIN)
     {
         // read all messages from the client socket, we break out if the socket is closed
         // or EWOULDBLOCK is returned on a read (ie. no more messages to read)
-        while (true)
+        while (readClientMessage(clientId, sockFd, clientObj, details))
         {
-            struct msghdr msg = {nullptr};
-            struct iovec io = {.iov_base = m_recvDataBuf, .iov_len = sizeof(m_recvDataBuf)};
-
-            bzero(&msg, sizeof(msg));
-            msg.msg_iov = &io;
-            msg.msg_iovlen = 1;
-            msg.msg_control = m_recvCtrlBuf;
-            msg.msg_controllen = sizeof(m_recvCtrlBuf);
-
-            // read one message
-            ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(sockFd, &msg, MSG_CMSG_CLOEXEC));
-            if (rd < 0)
-            {
-                if (errno != EWOULDBLOCK)
-                {
-                    RIALTO_IPC_LOG_SYS_ERROR(errno, "error reading client socket");
-                    disconnectClient(clientId);
-                }
+        }
+    }
+}
 
-                break;
-            }
-            else if (rd == 0)
-            {
-                // client closed connection, and we've read all data, add to the condemned set
-                // so is cleaned up once all the events are processed
-                disconnectClient(clientId);
+// -----------------------------------------------------------------------------
+/*!
+    \internal
 
-                break;
-            }
-            else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
-            {
-                RIALTO_IPC_LOG_WARN("received message from client %" PRIu64 " truncated, discarding", clientId);
+    Reads a single message from the client socket and processes it, or if the
+    client sends its messages on the ring, queues it until the barrier record
+    for it is read from the ring.
+
+    Returns false if there was no message to read or the socket was closed.
+
+ */
+bool ServerImpl::readClientMessage(uint64_t clientId, int sockFd, const std::shared_ptr<ClientImpl> &client,
+                                   ClientDetails *details)
+{
+    struct msghdr msg = {nullptr};
+    struct iovec io[2];
+    std::shared_ptr<uint8_t> pooledBuf;
+
+    bzero(&msg, sizeof(msg));
+    if (m_dispatcher)
+    {
+        pooledBuf = m_sendBufPool.allocateShared<uint8_t>(kRecvPooledLen);
+        io[0] = {.iov_base = pooledBuf.get(), .iov_len = kRecvPooledLen};
+        io[1] = {.iov_base = m_recvDataBuf, .iov_len = sizeof(m_recvDataBuf) - kRecvPooledLen};
+        msg.msg_iovlen = 2;
+    }
+    else
+    {
+        io[0] = {.iov_base = m_recvDataBuf, .iov_len = sizeof(m_recvDataBuf)};
+        msg.msg_iovlen = 1;
+    }
+    msg.msg_iov = io;
+    msg.msg_control = m_recvCtrlBuf;
+    msg.msg_controllen = sizeof(m_recvCtrlBuf);
+
+    // read one message
+    ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(sockFd, &msg, MSG_CMSG_CLOEXEC | MSG_DONTWAIT));
+    if (rd < 0)
+    {
+        if (errno != EWOULDBLOCK)
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "error reading client socket");
+            disconnectClient(clientId);
+        }
+
+        return false;
+    }
+    else if (rd == 0)
+    {
+        // client closed connection, and we've read all data, add to the condemned set
+        // so is cleaned up once all the events are processed
+        disconnectClient(clientId);
+
+        return false;
+    }
+    else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+    {
+        RIALTO_IPC_LOG_WARN("received message from client %" PRIu64 " truncated, discarding", clientId);
+
+        // make sure to close all the fds, otherwise we'll leak them
+        readMessageFds(&msg, 16);
+        return true;
+    }
+
+    // a message that didn't fit in the pooled buffer is made contiguous in the receive buffer
+    const uint8_t *data = m_recvDataBuf;
+    if (pooledBuf && (static_cast<size_t>(rd) <= kRecvPooledLen))
+    {
+        data = pooledBuf.get();
+    }
+    else if (pooledBuf)
+    {
+        memmove(m_recvDataBuf + kRecvPooledLen, m_recvDataBuf, rd - kRecvPooledLen);
+        memcpy(m_recvDataBuf, pooledBuf.get(), kRecvPooledLen);
+        pooledBuf.reset();
+    }
+
+    if (details->socketBehindRing)
+    {
+        if (details->socketMessages.size() >= kMaxSocketMessagesBehindRing)
+        {
+            RIALTO_IPC_LOG_ERROR("client %" PRIu64 " sent messages without barriers in its ring, disconnecting",
+                                 clientId);
+            readMessageFds(&msg, 16);
+            disconnectClient(clientId);
+            return false;
+        }
+
+        ReceivedMessage message;
+        message.data.assign(data, data + rd);
+        if (msg.msg_controllen > 0)
+            message.fds = readMessageFds(&msg, 16);
+
+        details->socketMessages.emplace_back(std::move(message));
+    }
+    else
+    {
+        // if there is control data then assume fd(s) have been passed
+        if (msg.msg_controllen > 0)
+        {
+            processClientMessage(client, data, rd, readMessageFds(&msg, 16), pooledBuf);
+        }
+        else
+        {
+            processClientMessage(client, data, rd, {}, pooledBuf);
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes the records the client has written to its request ring.  A
+    barrier record stands for the next message on the socket, which the client
+    sends there because it passes fds or doesn't fit in the ring.
+
+ */
+void ServerImpl::processClientRing(uint64_t clientId)
+{
+    std::unique_lock<std::mutex> locker(m_clientsLock);
+
+    auto it = m_clients.find(clientId);
+    if ((it == m_clients.end()) || !it->second.ring || (m_condemnedClients.count(clientId) != 0))
+        return;
+
+    const int sockFd = it->second.sock;
+    std::shared_ptr<ClientImpl> clientObj = it->second.client;
+    std::shared_ptr<ShmRingTransport> ring = it->second.ring;
+    ClientDetails *details = &it->second;
+
+    // the client also rings the doorbell after making room in the response ring
+    if (details->ringBlocked)
+    {
+        details->ringBlocked = false;
+        flushMessages(clientId, details);
+    }
+
+    locker.unlock();
 
-                // make sure to close all the fds, otherwise we'll leak them
-                readMessageFds(&msg, 16);
+    ring->clearDoorbell();
+
+    ShmRing::Record record;
+    ShmRing::ReadStatus status;
+    while ((status = ring->receive(&record)) == ShmRing::ReadStatus::RECORD)
+    {
+        if (record.type == ShmRing::RecordType::MESSAGE)
+        {
+            processClientMessage(clientObj, record.data, record.length);
+            ring->release();
+        }
+        else if ((record.type == ShmRing::RecordType::START) && !details->socketBehindRing)
+        {
+            // the messages the client sent on the socket before switching to the ring come first
+            ring->release();
+            while (readClientMessage(clientId, sockFd, clientObj, details))
+            {
             }
-            else
+
+            details->socketBehindRing = true;
+        }
+        else if ((record.type == ShmRing::RecordType::BARRIER) && details->socketBehindRing)
+        {
+            ring->release();
+
+            // the client sends the message before the barrier, so it's either queued or can be read now
+            if (details->socketMessages.empty())
+                readClientMessage(clientId, sockFd, clientObj, details);
+            if (details->socketMessages.empty())
             {
-                // if there is control data then assume fd(s) have been passed
-                if (msg.msg_controllen > 0)
-                {
-                    processClientMessage(clientObj, m_recvDataBuf, rd, readMessageFds(&msg, 16));
-                }
-                else
-                {
-                    processClientMessage(clientObj, m_recvDataBuf, rd);
-                }
+                RIALTO_IPC_LOG_ERROR("missing socket message for barrier in ring of client %" PRIu64, clientId);
+                status = ShmRing::ReadStatus::CORRUPT;
+                break;
             }
+
+            ReceivedMessage message = std::move(details->socketMessages.front());
+            details->socketMessages.pop_front();
+            processClientMessage(clientObj, message.data.data(), message.data.size(), std::move(message.fds));
+        }
+        else
+        {
+            status = ShmRing::ReadStatus::CORRUPT;
+            break;
         }
     }
+
+    if (status == ShmRing::ReadStatus::CORRUPT)
+    {
+        RIALTO_IPC_LOG_ERROR("invalid record in ring of client %" PRIu64 ", disconnecting", clientId);
+        disconnectClient(clientId);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -850,15 +1142,24 @@ static bool addRequestFileDescriptors(google::protobuf::Message *request, const
 /*!
     \internal
 
-    Processes a message received on a client socket.
+    Processes a message received on a client socket.  If \a buffer is set it
+    holds the message data, and a frame can be handed over to the dispatcher
+    with it rather than being copied.
 
  */
 void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
-                                      const std::vector<FileDescriptor> &fds)
+                                      std::vector<FileDescriptor> fds, const std::shared_ptr<uint8_t> &buffer)
 {
     RIALTO_IPC_LOG_DEBUG("processing client message of size %zu bytes (%zu fds) from client %" PRId64, dataLen,
                          fds.size(), client->id());
 
+    // once the client knows the server supports them, it sends method calls as frames
+    if (isFrame(data, dataLen))
+    {
+        processClientFrame(client, data, dataLen, std::move(fds), buffer);
+        return;
+    }
+
     // parse the message
     transport::MessageToServer message;
     if (!message.ParseFromArray(data, static_cast<int>(dataLen)))
@@ -867,14 +1168,48 @@ void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client,
         return;
     }
 
-    if (message.has_call())
+    if (message.has_call() && m_dispatcher)
+    {
+        // hand the call over to the client's strand, the message buffer is reused for the next read
+        auto call = std::make_shared<transport::MethodCall>();
+        call->Swap(message.mutable_call());
+        auto callFds = std::make_shared<std::vector<FileDescriptor>>(std::move(fds));
+
+        m_dispatcher->dispatch(client->id(),
+                               [this, client, call, callFds]() { processMethodCall(client, *call, *callFds); });
+    }
+    else if (message.has_call())
     {
         processMethodCall(client, message.call(), fds);
     }
+    else if (message.has_multi_call() && !fds.empty())
+    {
+        // the client sends the calls passing fds on their own
+        RIALTO_IPC_LOG_ERROR("fds sent with multi call from client %" PRIu64 ", ignoring", client->id());
+    }
+    else if (message.has_multi_call() && m_dispatcher)
+    {
+        auto multiCall = std::make_shared<transport::MultiCall>();
+        multiCall->Swap(message.mutable_multi_call());
+
+        m_dispatcher->dispatch(client->id(), [this, client, multiCall]() { processMultiCall(client, *multiCall); });
+    }
+    else if (message.has_multi_call())
+    {
+        processMultiCall(client, message.multi_call());
+    }
     else if (message.has_monitor())
     {
         processMonitorRequest(client, message.monitor(), fds);
     }
+    else if (message.has_capabilities())
+    {
+        processCapabilities(client, message.capabilities());
+    }
+    else if (message.has_ring_setup())
+    {
+        processRingSetup(client, message.ring_setup(), fds);
+    }
     else
     {
         RIALTO_IPC_LOG_WARN("received unknown message type from client");
@@ -885,115 +1220,864 @@ void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client,
 /*!
     \internal
 
-    Processes a method call requst from a client.
+    Processes a framed message received on a client socket.
 
  */
-void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
-                                   const std::vector<FileDescriptor> &fds)
+void ServerImpl::processClientFrame(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
+                                    std::vector<FileDescriptor> fds, const std::shared_ptr<uint8_t> &buffer)
 {
-    // try and find the service with the given name
-    const std::string &serviceName = call.service_name();
-    auto it = client->m_services.find(serviceName);
-    if (it == client->m_services.end())
-    {
-        RIALTO_IPC_LOG_ERROR("unknown service request '%s'", serviceName.c_str());
-
-        sendErrorReply(client, call.serial_id(), "Unknown service '%s'", serviceName.c_str());
-        return;
-    }
-
-    std::shared_ptr<google::protobuf::Service> service = it->second;
-
-    // try and find the method
-    const std::string &methodName = call.method_name();
-    const google::protobuf::MethodDescriptor *method = service->GetDescriptor()->FindMethodByName(methodName);
-    if (!method)
+    if (m_dispatcher)
     {
-        RIALTO_IPC_LOG_ERROR("no method with name '%s'", methodName.c_str());
-
-        sendErrorReply(client, call.serial_id(), "Unknown method '%s'", methodName.c_str());
-        return;
-    }
-
-    // check if the method is expecting a reply
-    const bool noReply = method->options().HasExtension(no_reply) && method->options().GetExtension(no_reply);
+        // hand the frame over to the client's strand, a frame in the receive buffer or the ring is copied as they
+        // are reused for the next read
+        std::shared_ptr<uint8_t> frame = buffer;
+        if (!frame)
+        {
+            frame = m_sendBufPool.allocateShared<uint8_t>(dataLen);
+            memcpy(frame.get(), data, dataLen);
+            data = frame.get();
+        }
+        auto callFds = std::make_shared<std::vector<FileDescriptor>>(std::move(fds));
 
-    // parse the request data
-    google::protobuf::Message *requestMessage = service->GetRequestPrototype(method).New();
-    if (!requestMessage->ParseFromString(call.request_message()))
-    {
-        RIALTO_IPC_LOG_ERROR("failed to parse method from array");
-    }
-    else if (!addRequestFileDescriptors(requestMessage, fds))
-    {
-        RIALTO_IPC_LOG_ERROR("mismatch of file descriptors to the request");
+        m_dispatcher->dispatch(client->id(), [this, client, frame, data, dataLen, callFds]()
+                               { processFramedMethodCall(client, data, dataLen, *callFds); });
     }
     else
     {
-        if (m_kMonitor)
-            m_kMonitor->monitorCall(client->id(), call, noReply);
-
-        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s.%s { %s }", call.serial_id(), serviceName.c_str(),
-                             methodName.c_str(), requestMessage->ShortDebugString().c_str());
-
-        // create a controller (TODO: use a pool of these rather alloc new one each time)
-        auto *controller = new ServerControllerImpl(client, call.serial_id());
-
-        if (noReply)
-        {
-            // we should not send a reply for this call, so call the code to handle the
-            // request, but no need to pass a controller, response or closure object
-            static google::protobuf::internal::FunctionClosure0 nullClosure(&google::protobuf::DoNothing, false);
-            service->CallMethod(method, controller, requestMessage, nullptr, &nullClosure);
-        }
-        else
-        {
-            // create a response
-            google::protobuf::Message *responseMessage = service->GetResponsePrototype(method).New();
-
-            // this is finally where we call the service implementation to process the request
-            service->CallMethod(method, controller, requestMessage, responseMessage,
-                                google::protobuf::NewCallback(this, &ServerImpl::handleResponse, controller,
-                                                              responseMessage));
-        }
+        processFramedMethodCall(client, data, dataLen, fds);
     }
-
-    delete requestMessage;
 }
 
 // -----------------------------------------------------------------------------
 /*!
     \internal
-    \threadsafe
 
-    Sends a message to the given client if still connected.
+    Processes the transport capabilities sent by a client when it connects.
 
  */
-void ServerImpl::sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg)
+void ServerImpl::processCapabilities(const std::shared_ptr<ClientImpl> &client,
+                                     const transport::TransportCapabilities &capabilities)
 {
-    // now take the lock (so the socket is not closed beneath us) and send the reply
-    std::lock_guard<std::mutex> locker(m_clientsLock);
+    RIALTO_IPC_LOG_INFO("client %" PRIu64 " %s framed messages, %s numeric ids, %s multi calls, %s shm rings",
+                        client->id(), capabilities.framed_messages() ? "supports" : "doesn't support",
+                        capabilities.numeric_ids() ? "supports" : "doesn't support",
+                        capabilities.multi_call() ? "supports" : "doesn't support",
+                        capabilities.shm_ring() ? "supports" : "doesn't support");
 
-    auto it = m_clients.find(clientId);
-    if (it == m_clients.end())
+    // reply with the features the server supports, the client only sends frames after receiving it
+    transport::MessageFromServer message;
+    message.mutable_capabilities()->set_framed_messages(true);
+    message.mutable_capabilities()->set_numeric_ids(true);
+    message.mutable_capabilities()->set_multi_call(true);
+    message.mutable_capabilities()->set_shm_ring(m_kShmRings);
+
+    const size_t replySize = message.ByteSizeLong();
+    auto msgBuf = m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + replySize);
+
+    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
+    bzero(header, sizeof(msghdr));
+
+    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr));
+    header->msg_iov = iov;
+    header->msg_iovlen = 1;
+
+    auto *data = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr) + sizeof(iovec));
+    iov->iov_base = data;
+    iov->iov_len = replySize;
+
+    message.SerializeWithCachedSizesToArray(data);
+
+    sendReply(client->id(), std::shared_ptr<msghdr>(msgBuf, header));
+
+    // from now on replies and events are sent to the client as frames
+    client->m_numericIds = capabilities.framed_messages() && capabilities.numeric_ids();
+    client->m_framedMessages = capabilities.framed_messages();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes a method call requst from a client, received as a transport message.
+
+    Returns true if a reply to the call has been or will be sent.
+
+ */
+bool ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
+                                   const std::vector<FileDescriptor> &fds)
+{
+    std::shared_ptr<google::protobuf::Service> service;
+    const google::protobuf::MethodDescriptor *method =
+        findMethod(client, call.serial_id(), call.service_name(), call.method_name(), &service);
+    if (!method)
+        return true;
+
+    const std::string &requestMessage = call.request_message();
+    return callMethod(client, call.serial_id(), service, method,
+                      reinterpret_cast<const uint8_t *>(requestMessage.data()), requestMessage.size(), fds);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes several method calls sent together by a client.  The calls are
+    made in order, and their replies are held back until all the calls have
+    completed, so they are sent to the client together.
+
+ */
+void ServerImpl::processMultiCall(const std::shared_ptr<ClientImpl> &client, const transport::MultiCall &multiCall)
+{
+    auto batch = std::make_shared<ReplyBatch>();
+    batch->pending = multiCall.calls_size();
+
+    {
+        std::lock_guard<std::mutex> locker(m_clientsLock);
+
+        auto it = m_clients.find(client->id());
+        if (it == m_clients.end())
+            return;
+
+        for (const transport::MethodCall &call : multiCall.calls())
+            it->second.heldReplies.emplace(call.serial_id(), batch);
+    }
+
+    for (const transport::MethodCall &call : multiCall.calls())
+    {
+        if (!processMethodCall(client, call, {}))
+            releaseHeldReply(client->id(), call.serial_id(), nullptr);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes a method call requst from a client, received as a frame.
+
+    The method is either identified by the name in the frame, or by an id the
+    client defined in an earlier frame, in which case it's looked up in the
+    client's method table rather than by name.
+
+ */
+void ServerImpl::processFramedMethodCall(const std::shared_ptr<ClientImpl> &client, const uint8_t *data,
+                                         size_t dataLen, const std::vector<FileDescriptor> &fds)
+{
+    FrameHeader frame;
+    if (!readFrameHeader(data, dataLen, &frame) || (frame.type != FrameType::CALL))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid frame from client %" PRIu64, client->id());
+        return;
+    }
+
+    const size_t headerLen = sizeof(FrameHeader) + frame.nameLength;
+    const uint8_t *requestData = data + headerLen;
+    const size_t requestDataLen = dataLen - headerLen;
+
+    if ((frame.id != kFrameNoId) && !(frame.flags & kFrameFlagDefinesId))
+    {
+        if ((frame.id >= client->m_methods.size()) || client->m_methods[frame.id].fullName.empty())
+        {
+            RIALTO_IPC_LOG_ERROR("unknown method id %u from client %" PRIu64, static_cast<unsigned>(frame.id),
+                                 client->id());
+
+            sendErrorReply(client, frame.serial, "Unknown method id %u", static_cast<unsigned>(frame.id));
+            return;
+        }
+
+        // the service may not have been exported when the id was defined, so retry the lookup
+        ClientImpl::Method &entry = client->m_methods[frame.id];
+        if (!entry.descriptor)
+            entry.descriptor = findMethod(client, frame.serial, entry.fullName, &entry.service);
+
+        if (entry.descriptor)
+            callMethod(client, frame.serial, entry.service, entry.descriptor, requestData, requestDataLen, fds);
+
+        return;
+    }
+
+    // the frame holds the full name of the method, ie. '<service name>.<method name>'
+    const std::string fullName(reinterpret_cast<const char *>(data + sizeof(FrameHeader)), frame.nameLength);
+
+    std::shared_ptr<google::protobuf::Service> service;
+    const google::protobuf::MethodDescriptor *method = findMethod(client, frame.serial, fullName, &service);
+
+    if (frame.id != kFrameNoId)
+    {
+        if (frame.id >= client->m_methods.size())
+            client->m_methods.resize(frame.id + 1);
+
+        client->m_methods[frame.id] = ClientImpl::Method{fullName, service, method};
+    }
+
+    if (method)
+        callMethod(client, frame.serial, service, method, requestData, requestDataLen, fds);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Finds the method with the given full name, ie. '<service name>.<method name>',
+    in the services exported to the client.  If not found an error reply is
+    sent to the client and \c nullptr returned.
+
+ */
+const google::protobuf::MethodDescriptor *ServerImpl::findMethod(const std::shared_ptr<ClientImpl> &client,
+                                                                 uint64_t serialId, const std::string &fullName,
+                                                                 std::shared_ptr<google::protobuf::Service> *service)
+{
+    const size_t separator = fullName.rfind('.');
+    if (separator == std::string::npos)
+    {
+        RIALTO_IPC_LOG_ERROR("invalid method name '%s'", fullName.c_str());
+
+        sendErrorReply(client, serialId, "Unknown method '%s'", fullName.c_str());
+        return nullptr;
+    }
+
+    return findMethod(client, serialId, fullName.substr(0, separator), fullName.substr(separator + 1), service);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Finds the method in the services exported to the client.  If not found an
+    error reply is sent to the client and \c nullptr returned.
+
+ */
+const google::protobuf::MethodDescriptor *ServerImpl::findMethod(const std::shared_ptr<ClientImpl> &client,
+                                                                 uint64_t serialId, const std::string &serviceName,
+                                                                 const std::string &methodName,
+                                                                 std::shared_ptr<google::protobuf::Service> *service)
+{
+    // try and find the service with the given name
+    auto it = client->m_services.find(serviceName);
+    if (it == client->m_services.end())
+    {
+        RIALTO_IPC_LOG_ERROR("unknown service request '%s'", serviceName.c_str());
+
+        sendErrorReply(client, serialId, "Unknown service '%s'", serviceName.c_str());
+        return nullptr;
+    }
+
+    // try and find the method
+    const google::protobuf::MethodDescriptor *method = it->second->GetDescriptor()->FindMethodByName(methodName);
+    if (!method)
+    {
+        RIALTO_IPC_LOG_ERROR("no method with name '%s'", methodName.c_str());
+
+        sendErrorReply(client, serialId, "Unknown method '%s'", methodName.c_str());
+        return nullptr;
+    }
+
+    *service = it->second;
+    return method;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Calls the service implementation of a method requested by a client.
+
+    Returns true if a reply to the call will be sent.
+
+ */
+bool ServerImpl::callMethod(const std::shared_ptr<ClientImpl> &client, uint64_t serialId,
+                            const std::shared_ptr<google::protobuf::Service> &service,
+                            const google::protobuf::MethodDescriptor *method, const uint8_t *requestData,
+                            size_t requestDataLen, const std::vector<FileDescriptor> &fds)
+{
+    // check if the method is expecting a reply
+    const bool noReply = method->options().HasExtension(no_reply) && method->options().GetExtension(no_reply);
+
+    // parse the request data
+    bool replyExpected = false;
+    google::protobuf::Message *requestMessage = service->GetRequestPrototype(method).New();
+    if (!requestMessage->ParseFromArray(requestData, static_cast<int>(requestDataLen)))
+    {
+        RIALTO_IPC_LOG_ERROR("failed to parse method from array");
+    }
+    else if (!addRequestFileDescriptors(requestMessage, fds))
+    {
+        RIALTO_IPC_LOG_ERROR("mismatch of file descriptors to the request");
+    }
+    else
+    {
+        replyExpected = !noReply;
+
+        if (m_kMonitor)
+        {
+            transport::MethodCall call;
+            call.set_serial_id(serialId);
+            call.set_service_name(method->service()->full_name());
+            call.set_method_name(method->name());
+            call.set_request_message(requestData, requestDataLen);
+            m_kMonitor->monitorCall(client->id(), call, noReply);
+        }
+
+        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s { %s }", serialId, method->full_name().c_str(),
+                             requestMessage->ShortDebugString().c_str());
+
+        if (noReply)
+        {
+            // we should not send a reply for this call, so call the code to handle the request
+            // without a response, the controller is only valid for the duration of the call
+            static google::protobuf::internal::FunctionClosure0 nullClosure(&google::protobuf::DoNothing, false);
+            ServerControllerImpl controller(client, serialId);
+            service->CallMethod(method, &controller, requestMessage, nullptr, &nullClosure);
+        }
+        else
+        {
+            // create a controller (TODO: use a pool of these rather alloc new one each time)
+            auto *controller = new ServerControllerImpl(client, serialId);
+
+            // create a response
+            google::protobuf::Message *responseMessage = service->GetResponsePrototype(method).New();
+
+            // this is finally where we call the service implementation to process the request
+            service->CallMethod(method, controller, requestMessage, responseMessage,
+                                google::protobuf::NewCallback(this, &ServerImpl::handleResponse, controller,
+                                                              responseMessage));
+        }
+    }
+
+    delete requestMessage;
+
+    return replyExpected;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Sends a message to the given client if still connected.
+
+ */
+void ServerImpl::sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg)
+{
+    // now take the lock (so the socket is not closed beneath us) and send the reply
+    std::lock_guard<std::mutex> locker(m_clientsLock);
+
+    auto it = m_clients.find(clientId);
+    if (it == m_clients.end())
+    {
+        RIALTO_IPC_LOG_WARN("socket removed before error reply could be sent");
+    }
+    else if (it->second.sock < 0)
+    {
+        RIALTO_IPC_LOG_WARN("socket closed before error reply could be sent");
+    }
+    else if (!msg)
+    {
+        RIALTO_IPC_LOG_WARN("invalid msg to send on socket, ignoring");
+    }
+    else
+    {
+        OutboundMessage message;
+        message.msg = msg;
+        message.length = messageLength(msg.get());
+        sendMessage(clientId, &it->second, std::move(message));
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Returns true if the socket message \a msg is a frame that defines a new
+    method or event id, these must never be dropped from a queue as later
+    frames refer to the id.
+
+ */
+static bool definesFrameId(const struct msghdr *msg)
+{
+    FrameHeader frame;
+    const auto *data = reinterpret_cast<const uint8_t *>(msg->msg_iov[0].iov_base);
+    return readFrameHeader(data, msg->msg_iov[0].iov_len, &frame) && (frame.flags & kFrameFlagDefinesId);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Replaces the file descriptors in the control data of a queued message by
+    duplicates owned by the message, as the caller's are only guaranteed to
+    be valid until the send call returns.
+
+ */
+static bool keepMessageFds(struct msghdr *msg, std::vector<FileDescriptor> *fds)
+{
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+        if ((cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_RIGHTS))
+            continue;
+
+        const size_t numFds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        auto *cmsgFds = reinterpret_cast<int *>(CMSG_DATA(cmsg));
+        for (size_t i = 0; i < numFds; i++)
+        {
+            FileDescriptor fd(cmsgFds[i]);
+            if (!fd.isValid())
+            {
+                RIALTO_IPC_LOG_ERROR("failed to duplicate fd of queued message");
+                return false;
+            }
+
+            cmsgFds[i] = fd.fd();
+            fds->emplace_back(std::move(fd));
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Adds the reply \a msg to the replies held back for the multi call that
+    the call with \a serialId is part of, or just counts the call as
+    completed if \a msg is \c nullptr.  Once all the calls of the multi call
+    have completed, the held replies are sent together.
+
+    Returns false if the call is not part of a multi call, in which case the
+    caller should send the reply itself.
+
+ */
+bool ServerImpl::releaseHeldReply(uint64_t clientId, uint64_t serialId, const std::shared_ptr<msghdr> &msg)
+{
+    std::lock_guard<std::mutex> locker(m_clientsLock);
+
+    auto it = m_clients.find(clientId);
+    if (it == m_clients.end())
+        return false;
+
+    ClientDetails &details = it->second;
+    auto held = details.heldReplies.find(serialId);
+    if (held == details.heldReplies.end())
+        return false;
+
+    std::shared_ptr<ReplyBatch> batch = held->second;
+    details.heldReplies.erase(held);
+
+    // the reply may be sent after the caller has released the objects holding its fds
+    if (msg)
+    {
+        OutboundMessage message;
+        message.msg = msg;
+        message.length = messageLength(msg.get());
+        if (keepMessageFds(message.msg.get(), &message.fds))
+            batch->replies.emplace_back(std::move(message));
+    }
+
+    if (--batch->pending > 0)
+        return true;
+
+    if (details.sock >= 0)
+    {
+        for (OutboundMessage &message : batch->replies)
+            queueMessage(clientId, &details, std::move(message));
+
+        flushMessages(clientId, &details);
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends the message to the client straight away, along with any messages
+    already queued for the client, without blocking.  If the client's socket
+    buffer is full the message stays queued and is sent from
+    processClientWritable() once epoll reports the socket is writable again.
+
+    Must be called with m_clientsLock held.
+
+    Returns false if the message was neither sent nor queued.
+
+ */
+bool ServerImpl::sendMessage(uint64_t clientId, ClientDetails *details, OutboundMessage &&message)
+{
+    // nothing else to send, so avoid the queue if the socket takes the message
+    if (details->outbound.empty() && !details->blocked && !details->ring)
+    {
+        const ssize_t wr = TEMP_FAILURE_RETRY(sendmsg(details->sock, message.msg.get(), MSG_NOSIGNAL | MSG_DONTWAIT));
+        if (wr == static_cast<ssize_t>(message.length))
+            return true;
+
+        if ((wr >= 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete message to client %" PRIu64, clientId);
+            return false;
+        }
+    }
+
+    if (!queueMessage(clientId, details, std::move(message)))
+        return false;
+
+    flushMessages(clientId, details);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Adds the message to the client's outbound queue, the queue is sent by
+    flushMessages().  If the message is an event the policy of its type is
+    applied.
+
+    Must be called with m_clientsLock held.
+
+    Returns false if the message was dropped.
+
+ */
+bool ServerImpl::queueMessage(uint64_t clientId, ClientDetails *details, OutboundMessage &&message)
+{
+    if (message.event)
+    {
+        const EventPolicyDetails *policy = findEventPolicy(*message.event);
+        if (policy && (policy->policy == EventPolicy::DROP) && (details->blocked || details->ringBlocked))
+        {
+            RIALTO_IPC_LOG_DEBUG("dropping event %s for client %" PRIu64, message.event->GetTypeName().c_str(),
+                                 clientId);
+            return false;
+        }
+        else if (policy && (policy->policy == EventPolicy::COALESCE))
+        {
+            coalesceEvents(details, *message.event, policy->keyField);
+        }
+    }
+
+    while (((details->outboundBytes + message.length) > m_kMaxOutboundBytes) && dropStaleEvent(details))
+    {
+    }
+
+    if ((details->outboundBytes + message.length) > m_kMaxOutboundBytes)
+    {
+        // replies can't be dropped without breaking the client's method calls
+        if (message.event)
+        {
+            RIALTO_IPC_LOG_WARN("queue of client %" PRIu64 " is full, dropping event %s", clientId,
+                                message.event->GetTypeName().c_str());
+        }
+        else
+        {
+            RIALTO_IPC_LOG_ERROR("client %" PRIu64 " is not reading its replies, disconnecting", clientId);
+            m_condemnedClients.insert(clientId);
+            wakeEventLoop();
+        }
+
+        return false;
+    }
+
+    if (message.fds.empty() && !keepMessageFds(message.msg.get(), &message.fds))
+        return false;
+
+    details->outboundBytes += message.length;
+    details->outbound.emplace_back(std::move(message));
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends the messages queued for the client, in batches of up to 32 messages
+    per sendmmsg() call, until the queue is empty or the client's socket
+    buffer is full.  In the latter case the socket is polled for EPOLLOUT and
+    no more messages are sent until processClientWritable() is called.
+
+    Must be called with m_clientsLock held.
+
+ */
+void ServerImpl::flushMessages(uint64_t clientId, ClientDetails *details)
+{
+    if (details->ring)
+    {
+        flushMessagesToRing(clientId, details);
+        return;
+    }
+
+    const size_t kMaxBatch = 32;
+    struct mmsghdr msgs[kMaxBatch];
+
+    while (!details->blocked && !details->outbound.empty())
+    {
+        const size_t numMsgs = std::min(details->outbound.size(), kMaxBatch);
+        for (size_t i = 0; i < numMsgs; i++)
+        {
+            msgs[i].msg_hdr = *details->outbound[i].msg;
+            msgs[i].msg_len = 0;
+        }
+
+        const int sent = TEMP_FAILURE_RETRY(sendmmsg(details->sock, msgs, numMsgs, MSG_NOSIGNAL | MSG_DONTWAIT));
+        if ((sent < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        {
+            // wait for the socket to become writable again
+            details->blocked = true;
+            setPollEvents(clientId, details->sock, EPOLLIN | EPOLLOUT);
+            return;
+        }
+        else if (sent < 0)
+        {
+            // drop the message that couldn't be sent
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send queued message to client %" PRIu64, clientId);
+
+            details->outboundBytes -= details->outbound.front().length;
+            details->outbound.pop_front();
+            continue;
+        }
+
+        for (int i = 0; i < sent; i++)
+        {
+            const OutboundMessage &message = details->outbound.front();
+            if (msgs[i].msg_len != message.length)
+                RIALTO_IPC_LOG_ERROR("failed to send the complete queued message to client %" PRIu64, clientId);
+
+            details->outboundBytes -= message.length;
+            details->outbound.pop_front();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Writes the messages queued for a client using the shared memory rings to
+    the response ring, until the queue is empty or the ring is full.  In the
+    latter case the client rings the doorbell once it has made room, and
+    processClientRing() flushes the queue again.
+
+    Messages passing fds, or too big for the ring, are sent on the socket with
+    a barrier record in the ring, so the client reads them in order.
+
+    Must be called with m_clientsLock held.
+
+ */
+void ServerImpl::flushMessagesToRing(uint64_t clientId, ClientDetails *details)
+{
+    ShmRingTransport &ring = *details->ring;
+
+    while (!details->blocked && !details->ringBlocked && !details->outbound.empty())
+    {
+        const OutboundMessage &message = details->outbound.front();
+        if ((message.msg->msg_controllen == 0) && (message.length <= ring.maxMessageLength()))
+        {
+            if (!ring.send(ShmRing::RecordType::MESSAGE, message.msg.get()))
+            {
+                details->ringBlocked = true;
+                break;
+            }
+        }
+        else
+        {
+            // the barrier can only be written after the message is sent, so make sure it fits first
+            if (!ring.ensureRoom(0))
+            {
+                details->ringBlocked = true;
+                break;
+            }
+
+            const ssize_t wr = TEMP_FAILURE_RETRY(sendmsg(details->sock, message.msg.get(), MSG_NOSIGNAL | MSG_DONTWAIT));
+            if ((wr < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+            {
+                details->blocked = true;
+                setPollEvents(clientId, details->sock, EPOLLIN | EPOLLOUT);
+                break;
+            }
+            else if (wr != static_cast<ssize_t>(message.length))
+            {
+                RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send queued message to client %" PRIu64, clientId);
+            }
+            else
+            {
+                struct msghdr barrier = {nullptr};
+                ring.send(ShmRing::RecordType::BARRIER, &barrier);
+            }
+        }
+
+        details->outboundBytes -= message.length;
+        details->outbound.pop_front();
+    }
+
+    ring.flush();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Returns the policy set for the type of \a event, or \c nullptr if the
+    default policy applies.
+
+    Must be called with m_clientsLock held.
+
+ */
+const ServerImpl::EventPolicyDetails *ServerImpl::findEventPolicy(const google::protobuf::Message &event) const
+{
+    if (m_eventPolicies.empty())
+        return nullptr;
+
+    auto it = m_eventPolicies.find(event.GetDescriptor()->full_name());
+    return (it != m_eventPolicies.end()) ? &it->second : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Returns true if the \a keyField of the events \a a and \b b, which are of
+    the same type, holds the same value.
+
+ */
+static bool haveSameKey(const google::protobuf::Message &a, const google::protobuf::Message &b,
+                        const std::string &keyField)
+{
+    if (keyField.empty())
+        return true;
+
+    const google::protobuf::FieldDescriptor *field = a.GetDescriptor()->FindFieldByName(keyField);
+    if (!field || field->is_repeated())
     {
-        RIALTO_IPC_LOG_WARN("socket removed before error reply could be sent");
+        RIALTO_IPC_LOG_ERROR("invalid key field '%s' for event %s", keyField.c_str(), a.GetTypeName().c_str());
+        return false;
     }
-    else if (it->second.sock < 0)
+
+    const google::protobuf::Reflection *reflection = a.GetReflection();
+    switch (field->cpp_type())
+    {
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+        return reflection->GetInt32(a, field) == reflection->GetInt32(b, field);
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+        return reflection->GetInt64(a, field) == reflection->GetInt64(b, field);
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+        return reflection->GetUInt32(a, field) == reflection->GetUInt32(b, field);
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+        return reflection->GetUInt64(a, field) == reflection->GetUInt64(b, field);
+    case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+        return reflection->GetBool(a, field) == reflection->GetBool(b, field);
+    case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+        return reflection->GetEnumValue(a, field) == reflection->GetEnumValue(b, field);
+    case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+        return reflection->GetString(a, field) == reflection->GetString(b, field);
+    default:
+        RIALTO_IPC_LOG_ERROR("unsupported type of key field '%s'", keyField.c_str());
+        return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Removes the queued events superseded by \a event.
+
+    Must be called with m_clientsLock held.
+
+ */
+void ServerImpl::coalesceEvents(ClientDetails *details, const google::protobuf::Message &event,
+                                const std::string &keyField)
+{
+    auto it = details->outbound.begin();
+    while (it != details->outbound.end())
     {
-        RIALTO_IPC_LOG_WARN("socket closed before error reply could be sent");
+        if (it->event && (it->event->GetDescriptor() == event.GetDescriptor()) && !definesFrameId(it->msg.get()) &&
+            haveSameKey(*it->event, event, keyField))
+        {
+            details->outboundBytes -= it->length;
+            it = details->outbound.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
     }
-    else if (!msg)
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Makes room in a full queue by removing the oldest queued event with the
+    COALESCE or DROP policy.
+
+    Must be called with m_clientsLock held.
+
+    Returns false if there are no such events in the queue.
+
+ */
+bool ServerImpl::dropStaleEvent(ClientDetails *details)
+{
+    for (auto it = details->outbound.begin(); it != details->outbound.end(); ++it)
     {
-        RIALTO_IPC_LOG_WARN("invalid msg to send on socket, ignoring");
+        const EventPolicyDetails *policy = it->event ? findEventPolicy(*it->event) : nullptr;
+        if (policy && (policy->policy != EventPolicy::QUEUE) && !definesFrameId(it->msg.get()))
+        {
+            RIALTO_IPC_LOG_DEBUG("dropping queued event %s", it->event->GetTypeName().c_str());
+
+            details->outboundBytes -= it->length;
+            details->outbound.erase(it);
+            return true;
+        }
     }
-    else if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, msg.get(), MSG_NOSIGNAL)) !=
-             static_cast<ssize_t>(msg->msg_iov->iov_len))
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sets the epoll events to wait for on a client socket.
+
+ */
+void ServerImpl::setPollEvents(uint64_t clientId, int sock, uint32_t events)
+{
+    epoll_event event = {.events = events, .data = {.u64 = clientId}};
+    if (epoll_ctl(m_pollFd, EPOLL_CTL_MOD, sock, &event) != 0)
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete error reply message");
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to modify client socket");
     }
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Called when a client socket with queued messages becomes writable, sends
+    as many of the queued messages as the socket buffer takes.
+
+ */
+void ServerImpl::processClientWritable(uint64_t clientId)
+{
+    std::lock_guard<std::mutex> locker(m_clientsLock);
+
+    auto it = m_clients.find(clientId);
+    if ((it == m_clients.end()) || (it->second.sock < 0))
+        return;
+
+    ClientDetails &details = it->second;
+    details.blocked = false;
+    flushMessages(clientId, &details);
+
+    // all sent, so no longer wait for the socket to become writable
+    if (!details.blocked)
+        setPollEvents(clientId, details.sock, EPOLLIN);
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -1013,8 +2097,9 @@ void ServerImpl::sendErrorReply(const std::shared_ptr<ClientImpl> &client, uint6
     // construct the reply message
     auto msg = populateErrorReply(client, serialId, reason);
 
-    // and send it
-    sendReply(client->id(), msg);
+    // and send it, unless held back for the other calls of a multi call
+    if (!releaseHeldReply(client->id(), serialId, msg))
+        sendReply(client->id(), msg);
 }
 
 // -----------------------------------------------------------------------------
@@ -1037,23 +2122,25 @@ void ServerImpl::handleResponse(ServerControllerImpl *controller, google::protob
 
     const std::shared_ptr<const ClientImpl> client = controller->m_kClient;
     const uint64_t clientId = client->id();
+    const uint64_t serialId = controller->m_kSerialId;
 
     std::shared_ptr<msghdr> message;
     if (!controller->m_failed)
     {
-        message = populateReply(client, controller->m_kSerialId, response);
+        message = populateReply(client, serialId, response);
     }
     else
     {
-        message = populateErrorReply(client, controller->m_kSerialId, controller->m_failureReason);
+        message = populateErrorReply(client, serialId, controller->m_failureReason);
     }
 
     // no longer need the controller or the response objects
     delete response;
     delete controller;
 
-    // send the reply message to the given client
-    sendReply(clientId, message);
+    // send the reply message to the given client, unless held back for the other calls of a multi call
+    if (!releaseHeldReply(clientId, serialId, message))
+        sendReply(clientId, message);
 }
 
 // -----------------------------------------------------------------------------
@@ -1116,6 +2203,45 @@ static std::vector<int> getResponseFileDescriptors(google::protobuf::Message *re
 std::shared_ptr<msghdr> ServerImpl::populateReply(const std::shared_ptr<const ClientImpl> &client, uint64_t serialId,
                                                   google::protobuf::Message *response)
 {
+    if (client->m_framedMessages)
+    {
+        // the fds are replaced by -1 in the response, so need to get them before serialising it
+        const std::vector<int> fds = getResponseFileDescriptors(response);
+
+        const size_t payloadLen = response->ByteSizeLong();
+        if ((sizeof(FrameHeader) + payloadLen) > m_kMaxMessageLen)
+        {
+            RIALTO_IPC_LOG_ERROR("reply exceeds maximum message limit (%zu, max %zu)", sizeof(FrameHeader) + payloadLen,
+                                 m_kMaxMessageLen);
+
+            // error message is too big, replace with a generic error
+            return populateErrorReply(client, serialId, "Internal error - reply message to large");
+        }
+
+        // send to any monitors
+        if (m_kMonitor)
+        {
+            transport::MethodCallReply reply;
+            reply.set_reply_id(serialId);
+            reply.set_reply_message(response->SerializeAsString());
+            m_kMonitor->monitorReply(client->id(), reply);
+        }
+
+        uint8_t *payload = nullptr;
+        const FrameHeader kFrame{kFrameMagic, FrameType::REPLY, 0, kFrameNoId, 0, serialId};
+        std::shared_ptr<msghdr> msg = populateFrame(kFrame, std::string(), payloadLen, fds, &payload);
+        if (msg)
+        {
+            // serialise the response straight into the send buffer
+            response->SerializeWithCachedSizesToArray(payload);
+
+            RIALTO_IPC_LOG_DEBUG("reply{ serial %" PRIu64 " } - { %s }", serialId,
+                                 response->ShortDebugString().c_str());
+        }
+
+        return msg;
+    }
+
     // create the base reply
     transport::MessageFromServer message;
     transport::MethodCallReply *reply = message.mutable_reply();
@@ -1207,6 +2333,37 @@ std::shared_ptr<msghdr> ServerImpl::populateReply(const std::shared_ptr<const Cl
 std::shared_ptr<msghdr> ServerImpl::populateErrorReply(const std::shared_ptr<const ClientImpl> &client,
                                                        uint64_t serialId, const std::string &reason)
 {
+    if (client->m_framedMessages)
+    {
+        // the payload of an error frame is the reason string
+        std::string errorReason = reason;
+        if ((sizeof(FrameHeader) + errorReason.size()) > m_kMaxMessageLen)
+        {
+            RIALTO_IPC_LOG_ERROR("error reply exceeds max message size");
+
+            // error message is to big, replace with a generic error
+            errorReason = "Error message truncated";
+        }
+
+        if (m_kMonitor)
+        {
+            transport::MethodCallError error;
+            error.set_reply_id(serialId);
+            error.set_error_reason(errorReason);
+            m_kMonitor->monitorError(client->id(), error);
+        }
+
+        RIALTO_IPC_LOG_DEBUG("error{ serial %" PRIu64 " } - \"%s\"", serialId, errorReason.c_str());
+
+        uint8_t *payload = nullptr;
+        const FrameHeader kFrame{kFrameMagic, FrameType::ERROR, 0, kFrameNoId, 0, serialId};
+        std::shared_ptr<msghdr> msg = populateFrame(kFrame, std::string(), errorReason.size(), {}, &payload);
+        if (msg)
+            memcpy(payload, errorReason.data(), errorReason.size());
+
+        return msg;
+    }
+
     // create the base reply
     transport::MessageFromServer message;
     transport::MethodCallError *error = message.mutable_error();
@@ -1251,6 +2408,79 @@ std::shared_ptr<msghdr> ServerImpl::populateErrorReply(const std::shared_ptr<con
     return std::shared_ptr<msghdr>(msgBuf, reinterpret_cast<msghdr *>(msgBuf.get()));
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Allocates the socket message for a frame with the given \a name and a
+    payload of \a payloadLen bytes.  The iovecs of the message point to the
+    frame header, the name and the payload, the name is not copied so must
+    outlive the message.  On return \a payload points to the buffer the caller
+    should write the payload to.
+
+ */
+std::shared_ptr<msghdr> ServerImpl::populateFrame(const FrameHeader &frame, const std::string &name,
+                                                  size_t payloadLen, const std::vector<int> &fds, uint8_t **payload)
+{
+    const size_t requiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
+
+    auto msgBuf = m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + requiredCtrlLen + (3 * sizeof(iovec)) +
+                                                        sizeof(FrameHeader) + payloadLen);
+
+    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
+    bzero(header, sizeof(msghdr));
+
+    auto *ctrl = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr));
+    header->msg_control = ctrl;
+    header->msg_controllen = requiredCtrlLen;
+
+    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr) + requiredCtrlLen);
+    header->msg_iov = iov;
+
+    auto *frameHeader =
+        reinterpret_cast<FrameHeader *>(msgBuf.get() + sizeof(msghdr) + requiredCtrlLen + (3 * sizeof(iovec)));
+    *frameHeader = frame;
+    frameHeader->nameLength = static_cast<uint16_t>(name.size());
+
+    *payload = reinterpret_cast<uint8_t *>(frameHeader + 1);
+
+    iov[0].iov_base = frameHeader;
+    iov[0].iov_len = sizeof(FrameHeader);
+    if (name.empty())
+    {
+        iov[1].iov_base = *payload;
+        iov[1].iov_len = payloadLen;
+        header->msg_iovlen = 2;
+    }
+    else
+    {
+        iov[1].iov_base = const_cast<char *>(name.data());
+        iov[1].iov_len = name.size();
+        iov[2].iov_base = *payload;
+        iov[2].iov_len = payloadLen;
+        header->msg_iovlen = 3;
+    }
+
+    // add the fds
+    if (!fds.empty())
+    {
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
+        if (!cmsg)
+        {
+            RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
+            return nullptr;
+        }
+
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+        header->msg_controllen = cmsg->cmsg_len;
+    }
+
+    return std::shared_ptr<msghdr>(msgBuf, header);
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \threadsafe
@@ -1294,10 +2524,87 @@ void ServerImpl::disconnectClient(uint64_t clientId)
     The \a clientId is the client to send the event to.
 
  */
-bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &eventMessage)
+bool ServerImpl::sendEvent(uint64_t clientId, bool framedMessages,
+                           const std::shared_ptr<google::protobuf::Message> &eventMessage)
 {
     // gets the file descriptors from the event message
     const std::vector<int> fds = getResponseFileDescriptors(eventMessage.get());
+
+    // build the socket message, as a frame if the client supports them
+    std::shared_ptr<msghdr> header;
+    if (framedMessages)
+        header = populateFramedEvent(*eventMessage, fds);
+    else
+        header = populateEvent(*eventMessage, fds);
+
+    if (!header)
+        return false;
+
+    // finally, take the lock (so the socket is not closed beneath us) and send the reply
+    std::unique_lock<std::mutex> locker(m_clientsLock);
+
+    auto it = m_clients.find(clientId);
+    if ((it == m_clients.end()) || (it->second.sock < 0))
+    {
+        RIALTO_IPC_LOG_WARN("socket closed before event could be sent");
+        return false;
+    }
+
+    // refer to the event type by id, the id is assigned under the lock so an
+    // event using it can't be sent before the event defining it
+    const google::protobuf::Descriptor *descriptor = eventMessage->GetDescriptor();
+    uint16_t newEventId = kFrameNoId;
+    if (framedMessages && it->second.client->m_numericIds)
+        newEventId = it->second.eventIds.apply(header.get(), descriptor);
+
+    OutboundMessage message;
+    message.msg = header;
+    message.length = messageLength(header.get());
+    message.event = eventMessage;
+    if (!queueMessage(clientId, &it->second, std::move(message)))
+        return false;
+
+    it->second.eventIds.defined(descriptor, newEventId);
+
+    // the event is sent with the others queued in the current dispatch cycle, so wake the
+    // event loop if it's not in one and hasn't been woken already
+    bool wake = false;
+    if (!it->second.blocked && !it->second.ringBlocked)
+    {
+        wake = !m_dispatching && m_unflushedClients.empty();
+        m_unflushedClients.insert(clientId);
+    }
+
+    locker.unlock();
+
+    if (wake)
+        wakeEventLoop();
+
+    if (m_kMonitor)
+    {
+        transport::EventFromServer event;
+        event.set_event_name(eventMessage->GetTypeName());
+        event.set_message(eventMessage->SerializeAsString());
+        m_kMonitor->monitorEvent(clientId, event);
+    }
+
+    RIALTO_IPC_LOG_DEBUG("event{ %s } - { %s }", eventMessage->GetTypeName().c_str(),
+                         eventMessage->ShortDebugString().c_str());
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Populates the socket message buffer with the event wrapped in a transport
+    message, for clients that don't support framed messages.
+
+ */
+std::shared_ptr<msghdr> ServerImpl::populateEvent(const google::protobuf::Message &eventMessage,
+                                                  const std::vector<int> &fds)
+{
     const size_t requiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
 
     // create the base reply
@@ -1306,13 +2613,13 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
     if (!event)
     {
         RIALTO_IPC_LOG_ERROR("failed to create mutable event object");
-        return false;
+        return nullptr;
     }
 
-    event->set_event_name(eventMessage->GetTypeName());
+    event->set_event_name(eventMessage.GetTypeName());
 
     // convert the event to a data string
-    std::string respString = eventMessage->SerializeAsString();
+    std::string respString = eventMessage.SerializeAsString();
 
     // wrap in a transport response and send that
     event->set_message(std::move(respString));
@@ -1323,7 +2630,7 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
     {
         RIALTO_IPC_LOG_ERROR("event message to big to fit in buffer (size %zu, max size %zu)", requiredDataLen,
                              m_kMaxMessageLen);
-        return false;
+        return nullptr;
     }
 
     // build the socket message to send
@@ -1355,7 +2662,7 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
         if (!cmsg)
         {
             RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
-            return false;
+            return nullptr;
         }
 
         cmsg->cmsg_level = SOL_SOCKET;
@@ -1365,30 +2672,100 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
         header->msg_controllen = cmsg->cmsg_len;
     }
 
-    // finally, take the lock (so the socket is not closed beneath us) and send the reply
-    std::unique_lock<std::mutex> locker(m_clientsLock);
+    return std::shared_ptr<msghdr>(msgBuf, header);
+}
 
-    auto it = m_clients.find(clientId);
-    if (it->second.sock < 0)
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Populates the socket message buffer with the event as a frame.  The event is
+    serialised once, straight into the send buffer, and its type name is sent
+    from the message descriptor.
+
+ */
+std::shared_ptr<msghdr> ServerImpl::populateFramedEvent(const google::protobuf::Message &eventMessage,
+                                                        const std::vector<int> &fds)
+{
+    // the descriptor (and therefore the name) outlives the socket message
+    const std::string &eventName = eventMessage.GetDescriptor()->full_name();
+    const size_t payloadLen = eventMessage.ByteSizeLong();
+
+    const size_t requiredDataLen = sizeof(FrameHeader) + eventName.size() + payloadLen;
+    if ((requiredDataLen > m_kMaxMessageLen) || (eventName.size() > UINT16_MAX))
     {
-        RIALTO_IPC_LOG_WARN("socket closed before event could be sent");
-        return false;
+        RIALTO_IPC_LOG_ERROR("event message to big to fit in buffer (size %zu, max size %zu)", requiredDataLen,
+                             m_kMaxMessageLen);
+        return nullptr;
+    }
+
+    uint8_t *payload = nullptr;
+    const FrameHeader kFrame{kFrameMagic, FrameType::EVENT, 0, kFrameNoId, 0, 0};
+    std::shared_ptr<msghdr> msg = populateFrame(kFrame, eventName, payloadLen, fds, &payload);
+    if (msg)
+        eventMessage.SerializeWithCachedSizesToArray(payload);
+
+    return msg;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Attaches the shared memory rings set up by the client.  From now on the
+    messages to the client are written to the response ring, after a start
+    record.  The client keeps sending on the socket until it has read the start
+    record, and then writes its own start record to the request ring.
+
+ */
+void ServerImpl::processRingSetup(const std::shared_ptr<ClientImpl> &client, const transport::RingSetup &ringSetup,
+                                  const std::vector<FileDescriptor> &fds)
+{
+    const uint64_t clientId = client->id();
+
+    if (!m_kShmRings)
+    {
+        RIALTO_IPC_LOG_WARN("received request to set up rings from client %" PRIu64 " but they are disabled", clientId);
+        return;
     }
-    else if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, header, MSG_NOSIGNAL)) != static_cast<ssize_t>(requiredDataLen))
+    if (fds.size() != 3)
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete event message");
-        return false;
+        RIALTO_IPC_LOG_WARN("invalid number of fds passed in ring setup from client %" PRIu64, clientId);
+        return;
     }
 
-    locker.unlock();
+    std::shared_ptr<ShmRingTransport> ring = ShmRingTransport::attach(fds[0], fds[1], fds[2], ringSetup.ring_capacity());
+    if (!ring)
+    {
+        RIALTO_IPC_LOG_ERROR("failed to attach the rings of client %" PRIu64, clientId);
+        return;
+    }
 
-    if (m_kMonitor)
-        m_kMonitor->monitorEvent(clientId, *event);
+    std::lock_guard<std::mutex> locker(m_clientsLock);
 
-    RIALTO_IPC_LOG_DEBUG("event{ %s } - { %s }", eventMessage->GetTypeName().c_str(),
-                         eventMessage->ShortDebugString().c_str());
+    auto it = m_clients.find(clientId);
+    if ((it == m_clients.end()) || (it->second.sock < 0) || it->second.ring)
+    {
+        RIALTO_IPC_LOG_WARN("ignoring ring setup from client %" PRIu64, clientId);
+        return;
+    }
 
-    return true;
+    epoll_event event = {.events = EPOLLIN, .data = {.u64 = clientId | RING_DOORBELL_FLAG}};
+    if (epoll_ctl(m_pollFd, EPOLL_CTL_ADD, ring->doorbellFd(), &event) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add ring doorbell");
+        return;
+    }
+
+    // the ring is empty, so always has room for the start record
+    struct msghdr start = {nullptr};
+    ring->send(ShmRing::RecordType::START, &start);
+    ring->flush();
+
+    it->second.ring = ring;
+    flushMessages(clientId, &it->second);
+
+    RIALTO_IPC_LOG_INFO("client %" PRIu64 " moved onto shm rings of %u bytes", clientId, ring->ringCapacity());
 }
 
 // -----------------------------------------------------------------------------
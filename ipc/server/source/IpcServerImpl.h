@@ -20,18 +20,22 @@
 #ifndef FIREBOLT_RIALTO_IPC_IPC_SERVER_IMPL_H_
 #define FIREBOLT_RIALTO_IPC_IPC_SERVER_IMPL_H_
 
+#include "BufferPool.h"
 #include "FileDescriptor.h"
+#include "FrameHeader.h"
 #include "IIpcServer.h"
 #include "IIpcServerFactory.h"
 #include "IpcServerControllerImpl.h"
+#include "IpcServerDispatcher.h"
 #include "IpcServerMonitor.h"
-#include "SimpleBufferPool.h"
+#include "ShmRing.h"
 
 #include "rialtoipc-transport.pb.h"
 
 #include <sys/socket.h>
 
 #include <atomic>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
@@ -75,9 +79,11 @@ public:
     bool wait(int timeoutMSecs) override;
     bool process() override;
 
+    void setEventPolicy(const std::string &eventType, EventPolicy policy, const std::string &keyField) override;
+
 protected:
     friend class ClientImpl;
-    bool sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &message);
+    bool sendEvent(uint64_t clientId, bool framedMessages, const std::shared_ptr<google::protobuf::Message> &message);
     bool isClientConnected(uint64_t clientId) const;
     void disconnectClient(uint64_t clientId);
 
@@ -91,11 +97,35 @@ private:
     void processNewConnection(uint64_t socketId);
 
     void processClientSocket(uint64_t clientId, unsigned events);
+    void processClientWritable(uint64_t clientId);
+    void processClientRing(uint64_t clientId);
     void processClientMessage(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
-                              const std::vector<FileDescriptor> &fds = {});
+                              std::vector<FileDescriptor> fds = {}, const std::shared_ptr<uint8_t> &buffer = nullptr);
+
+    void processClientFrame(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
+                            std::vector<FileDescriptor> fds, const std::shared_ptr<uint8_t> &buffer);
 
-    void processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
+    bool processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
                            const std::vector<FileDescriptor> &fds);
+    void processMultiCall(const std::shared_ptr<ClientImpl> &client, const transport::MultiCall &multiCall);
+    void processFramedMethodCall(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
+                                 const std::vector<FileDescriptor> &fds);
+    const google::protobuf::MethodDescriptor *findMethod(const std::shared_ptr<ClientImpl> &client, uint64_t serialId,
+                                                         const std::string &fullName,
+                                                         std::shared_ptr<google::protobuf::Service> *service);
+    const google::protobuf::MethodDescriptor *findMethod(const std::shared_ptr<ClientImpl> &client, uint64_t serialId,
+                                                         const std::string &serviceName, const std::string &methodName,
+                                                         std::shared_ptr<google::protobuf::Service> *service);
+    bool callMethod(const std::shared_ptr<ClientImpl> &client, uint64_t serialId,
+                    const std::shared_ptr<google::protobuf::Service> &service,
+                    const google::protobuf::MethodDescriptor *method, const uint8_t *requestData, size_t requestDataLen,
+                    const std::vector<FileDescriptor> &fds);
+
+    void processCapabilities(const std::shared_ptr<ClientImpl> &client,
+                             const transport::TransportCapabilities &capabilities);
+
+    void processRingSetup(const std::shared_ptr<ClientImpl> &client, const transport::RingSetup &ringSetup,
+                          const std::vector<FileDescriptor> &fds);
 
     void processMonitorRequest(const std::shared_ptr<ClientImpl> &client,
                                const transport::RegisterMonitor &registerMonitor, const std::vector<FileDescriptor> &fds);
@@ -104,6 +134,7 @@ private:
                                                 std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb);
 
     void sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg);
+    bool releaseHeldReply(uint64_t clientId, uint64_t serialId, const std::shared_ptr<msghdr> &msg);
 
     void sendErrorReply(const std::shared_ptr<ClientImpl> &client, uint64_t serialId, const char *format, ...)
         __attribute__((format(printf, 4, 5)));
@@ -114,14 +145,23 @@ private:
                                           google::protobuf::Message *response);
     std::shared_ptr<msghdr> populateErrorReply(const std::shared_ptr<const ClientImpl> &client, uint64_t serialId,
                                                const std::string &reason);
+    std::shared_ptr<msghdr> populateEvent(const google::protobuf::Message &eventMessage, const std::vector<int> &fds);
+    std::shared_ptr<msghdr> populateFramedEvent(const google::protobuf::Message &eventMessage,
+                                                const std::vector<int> &fds);
+    std::shared_ptr<msghdr> populateFrame(const FrameHeader &frame, const std::string &name, size_t payloadLen,
+                                          const std::vector<int> &fds, uint8_t **payload);
 
 private:
     static const size_t m_kMaxMessageLen;
+    static const size_t m_kMaxOutboundBytes;
 
     int m_pollFd;
     int m_wakeEventFd;
 
     const std::unique_ptr<ServerMonitor> m_kMonitor;
+    const bool m_kShmRings;
+
+    std::unique_ptr<ServerDispatcher> m_dispatcher;
 
     std::atomic<uint64_t> m_socketIdCounter;
     std::atomic<uint64_t> m_clientIdCounter;
@@ -139,22 +179,76 @@ private:
     std::mutex m_socketsLock;
     std::map<uint64_t, Socket> m_sockets;
 
+    struct OutboundMessage
+    {
+        std::shared_ptr<msghdr> msg;
+        size_t length = 0;
+        std::vector<FileDescriptor> fds;
+        std::shared_ptr<const google::protobuf::Message> event;
+    };
+
+    struct ReplyBatch
+    {
+        size_t pending = 0;
+        std::vector<OutboundMessage> replies;
+    };
+
+    struct ReceivedMessage
+    {
+        std::vector<uint8_t> data;
+        std::vector<FileDescriptor> fds;
+    };
+
     struct ClientDetails
     {
         int sock = -1;
         std::shared_ptr<ClientImpl> client;
         std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb;
+        FrameIds<const google::protobuf::Descriptor *> eventIds;
+        std::deque<OutboundMessage> outbound;
+        size_t outboundBytes = 0;
+        bool blocked = false;
+        std::map<uint64_t, std::shared_ptr<ReplyBatch>> heldReplies;
+
+        // the shared memory rings, once set up by the client, the ring and socketBehindRing are only
+        // changed and socketMessages only accessed by the thread calling process()
+        std::shared_ptr<ShmRingTransport> ring;
+        bool ringBlocked = false;
+        bool socketBehindRing = false;
+        std::deque<ReceivedMessage> socketMessages;
     };
 
+    struct EventPolicyDetails
+    {
+        EventPolicy policy = EventPolicy::QUEUE;
+        std::string keyField;
+    };
+
+    bool readClientMessage(uint64_t clientId, int sockFd, const std::shared_ptr<ClientImpl> &client,
+                           ClientDetails *details);
+    bool sendMessage(uint64_t clientId, ClientDetails *details, OutboundMessage &&message);
+    bool queueMessage(uint64_t clientId, ClientDetails *details, OutboundMessage &&message);
+    void flushMessages(uint64_t clientId, ClientDetails *details);
+    void flushMessagesToRing(uint64_t clientId, ClientDetails *details);
+    const EventPolicyDetails *findEventPolicy(const google::protobuf::Message &event) const;
+    void coalesceEvents(ClientDetails *details, const google::protobuf::Message &event, const std::string &keyField);
+    bool dropStaleEvent(ClientDetails *details);
+    void setPollEvents(uint64_t clientId, int sock, uint32_t events);
+
     mutable std::mutex m_clientsLock;
 
     std::map<uint64_t, ClientDetails> m_clients;
     std::set<uint64_t> m_condemnedClients;
+    std::set<uint64_t> m_unflushedClients;
+    bool m_dispatching = false;
+    std::map<std::string, EventPolicyDetails> m_eventPolicies;
 
     uint8_t m_recvDataBuf[128 * 1024];
     uint8_t m_recvCtrlBuf[SCM_MAX_FD * sizeof(int)];
 
-    SimpleBufferPool m_sendBufPool;
+    // shared by the messages of all the clients, including those queued for slow clients and the calls handed over
+    // to the dispatcher
+    BufferPool m_sendBufPool{1024 * 1024};
 };
 
 } // namespace firebolt::rialto::ipc
@@ -74,6 +74,8 @@ bool ServerMonitor::addMonitorSocket(const FileDescriptor &socket)
         return false;
     }
 
+    std::lock_guard<std::mutex> locker(m_lock);
+
     // send out details of all the currently connected sockets
     transport::MonitorMessage message;
     auto currentClients = message.mutable_current_clients();
@@ -90,6 +92,7 @@ bool ServerMonitor::addMonitorSocket(const FileDescriptor &socket)
 
     // finally, can add the socket to the internal list of monitors
     m_monitorSockets.emplace_back(socket);
+    m_hasMonitorSockets = true;
     return true;
 }
 
@@ -123,10 +126,13 @@ void ServerMonitor::clientConnected(const std::string &socketPath, uint64_t clie
     details.set_uid(client->getClientUserId());
     details.set_gid(client->getClientGroupId());
     details.set_socket_path(socketPath);
-    m_clientDetails.emplace(clientId, std::move(details));
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_clientDetails.emplace(clientId, std::move(details));
+    }
 
     // send notification to any monitors
-    if (m_monitorSockets.empty())
+    if (!m_hasMonitorSockets)
         return;
 
     transport::MonitorMessage message;
@@ -152,10 +158,13 @@ void ServerMonitor::clientConnected(const std::string &socketPath, uint64_t clie
 void ServerMonitor::clientDisconnected(uint64_t clientId)
 {
     // remove from the internal map of clients
-    m_clientDetails.erase(clientId);
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_clientDetails.erase(clientId);
+    }
 
     // send notification to any clients
-    if (m_monitorSockets.empty())
+    if (!m_hasMonitorSockets)
         return;
 
     transport::MonitorMessage message;
@@ -173,7 +182,7 @@ void ServerMonitor::clientDisconnected(uint64_t clientId)
 */
 void ServerMonitor::monitorCall(uint64_t clientId, const transport::MethodCall &call, bool noReply)
 {
-    if (m_monitorSockets.empty())
+    if (!m_hasMonitorSockets)
         return;
 
     transport::MonitorMessage message;
@@ -195,7 +204,7 @@ void ServerMonitor::monitorCall(uint64_t clientId, const transport::MethodCall &
 */
 void ServerMonitor::monitorReply(uint64_t clientId, const transport::MethodCallReply &reply)
 {
-    if (m_monitorSockets.empty())
+    if (!m_hasMonitorSockets)
         return;
 
     transport::MonitorMessage message;
@@ -215,7 +224,7 @@ void ServerMonitor::monitorReply(uint64_t clientId, const transport::MethodCallR
 */
 void ServerMonitor::monitorError(uint64_t clientId, const transport::MethodCallError &error)
 {
-    if (m_monitorSockets.empty())
+    if (!m_hasMonitorSockets)
         return;
 
     transport::MonitorMessage message;
@@ -235,7 +244,7 @@ void ServerMonitor::monitorError(uint64_t clientId, const transport::MethodCallE
 */
 void ServerMonitor::monitorEvent(uint64_t clientId, const transport::EventFromServer &event)
 {
-    if (m_monitorSockets.empty())
+    if (!m_hasMonitorSockets)
         return;
 
     transport::MonitorMessage message;
@@ -323,6 +332,7 @@ void ServerMonitor::sendToMonitors(const transport::MonitorMessage &message)
     msg.msg_controllen = 0;
 
     // send to each installed monitor socket, on any send failure we close the monitor socket
+    std::lock_guard<std::mutex> locker(m_lock);
     auto it = m_monitorSockets.begin();
     while (it != m_monitorSockets.end())
     {
@@ -343,6 +353,8 @@ void ServerMonitor::sendToMonitors(const transport::MonitorMessage &message)
         }
     }
 
+    m_hasMonitorSockets = !m_monitorSockets.empty();
+
     m_bufferPool.deallocate(dataBuf);
 }
 
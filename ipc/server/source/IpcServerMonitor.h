@@ -20,19 +20,26 @@
 #ifndef FIREBOLT_RIALTO_IPC_IPC_SERVER_MONITOR_H_
 #define FIREBOLT_RIALTO_IPC_IPC_SERVER_MONITOR_H_
 
+#include "BufferPool.h"
 #include "FileDescriptor.h"
 #include "IIpcServer.h"
-#include "SimpleBufferPool.h"
 
 #include "rialtoipc-transport.pb.h"
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace firebolt::rialto::ipc
 {
+/**
+ * @brief Forwards the messages of the server to the installed monitor sockets.
+ *
+ * The method calls may be replied to from the dispatcher's worker threads, so all the methods are thread safe.
+ */
 class ServerMonitor
 {
 public:
@@ -58,10 +65,13 @@ private:
 private:
     static const size_t m_kMaxMessageSize;
 
+    std::mutex m_lock;
+    std::atomic<bool> m_hasMonitorSockets{false}; // lets the calls skip building messages without taking the lock
     std::list<FileDescriptor> m_monitorSockets;
     std::map<uint64_t, transport::ClientDetails> m_clientDetails;
 
-    SimpleBufferPool m_bufferPool;
+    // only used while a monitor is installed, so kept small
+    BufferPool m_bufferPool{64 * 1024};
 };
 
 } // namespace firebolt::rialto::ipc
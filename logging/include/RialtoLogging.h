@@ -73,59 +73,123 @@ extern "C"
                                    const char *file, const char *func, int line, const char *fmt, ...)
         __attribute__((format(printf, 7, 8)));
 
+/**
+ * The least severe log level, that is compiled in. Calls of the less severe log macros are removed at compile time,
+ * for example -DRIALTO_LOG_MIN_LEVEL=RIALTO_DEBUG_LEVEL_MILESTONE removes all the INFO and DEBUG logs.
+ * External logs are not affected.
+ */
+#ifndef RIALTO_LOG_MIN_LEVEL
+#define RIALTO_LOG_MIN_LEVEL RIALTO_DEBUG_LEVEL_DEBUG
+#endif
+
+    /**
+     * Log levels for each component, 0 until resolved by the first log of the component.
+     * Only to be read by rialtoLogIsEnabled.
+     */
+    extern uint32_t g_rialtoLogLevels[RIALTO_COMPONENT_LAST];
+
+    /**
+     * Checks if the log level is enabled for the component. Used by the logging macros, so that the log arguments
+     * are not evaluated for disabled levels. Levels that are not yet resolved are reported as enabled.
+     */
+    static inline int rialtoLogIsEnabled(enum RIALTO_COMPONENT component, enum RIALTO_DEBUG_LEVEL level)
+    {
+        uint32_t levels;
+        if (component >= RIALTO_COMPONENT_LAST)
+            return 0;
+        levels = __atomic_load_n(&g_rialtoLogLevels[component], __ATOMIC_RELAXED);
+        return (0u == levels) || (0u != (levels & (uint32_t)level));
+    }
+
+#define RIALTO_LOG_IS_ENABLED(component, level)                                                                        \
+    (((level) <= RIALTO_LOG_MIN_LEVEL) && rialtoLogIsEnabled(component, level))
+
 /**
  * Macros to be used for logging
  */
 #define RIALTO_LOG_FATAL(component, fmt, args...)                                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);           \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_FATAL))                                                \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_SYS_FATAL(component, err, fmt, args...)                                                             \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);   \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_FATAL))                                                \
+        {                                                                                                              \
+            rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt,        \
+                               ##args);                                                                                \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_ERROR(component, fmt, args...)                                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);           \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_ERROR))                                                \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_SYS_ERROR(component, err, fmt, args...)                                                             \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);   \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_ERROR))                                                \
+        {                                                                                                              \
+            rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt,        \
+                               ##args);                                                                                \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_WARN(component, fmt, args...)                                                                       \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);         \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_WARNING))                                              \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);     \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_SYS_WARN(component, err, fmt, args...)                                                              \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt, ##args); \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_WARNING))                                              \
+        {                                                                                                              \
+            rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt,      \
+                               ##args);                                                                                \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_MIL(component, fmt, args...)                                                                        \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_MILESTONE, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_MILESTONE))                                            \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_MILESTONE, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);   \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_INFO(component, fmt, args...)                                                                       \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);            \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_INFO))                                                 \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);        \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_DEBUG(component, fmt, args...)                                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_DEBUG, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);           \
+        if (RIALTO_LOG_IS_ENABLED(component, RIALTO_DEBUG_LEVEL_DEBUG))                                                \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_DEBUG, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_EXTERNAL(fmt, args...)                                                                              \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(RIALTO_COMPONENT_EXTERNAL, RIALTO_DEBUG_LEVEL_EXTERNAL, __FILE__, __FUNCTION__, __LINE__, fmt, \
-                        ##args);                                                                                       \
+        if (rialtoLogIsEnabled(RIALTO_COMPONENT_EXTERNAL, RIALTO_DEBUG_LEVEL_EXTERNAL))                                \
+        {                                                                                                              \
+            rialtoLogPrintf(RIALTO_COMPONENT_EXTERNAL, RIALTO_DEBUG_LEVEL_EXTERNAL, __FILE__, __FUNCTION__, __LINE__,  \
+                            fmt, ##args);                                                                              \
+        }                                                                                                              \
     } while (false)
 
 #ifdef __cplusplus
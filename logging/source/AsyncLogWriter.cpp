@@ -0,0 +1,243 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncLogWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+/**
+ * @brief The maximum number of records passed to the sink at once.
+ */
+constexpr std::size_t kMaxBatchSize{64};
+
+/**
+ * @brief The maximum time flush() waits for the queued records to be written.
+ */
+constexpr std::chrono::seconds kFlushTimeout{1};
+
+void copyRecord(firebolt::rialto::logging::LogRecord &destination, const firebolt::rialto::logging::LogRecord &source)
+{
+    destination.level = source.level;
+    destination.file = source.file;
+    destination.line = source.line;
+    destination.function = source.function;
+    destination.timestamp = source.timestamp;
+    destination.threadId = source.threadId;
+    destination.messageLen = std::min(source.messageLen, sizeof(destination.message) - 1);
+    memcpy(destination.message, source.message, destination.messageLen);
+    destination.message[destination.messageLen] = '\0';
+}
+} // namespace
+
+namespace firebolt::rialto::logging
+{
+AsyncLogWriter::AsyncLogWriter(const Sink &sink, std::size_t capacity)
+    : m_sink{sink}, m_mask{1}, m_enqueuePos{0}, m_dequeuePos{0}, m_writtenPos{0}, m_numOfDroppedRecords{0},
+      m_numOfReportedDroppedRecords{0}, m_isRunning{true}, m_isWriterSleeping{false},
+      m_batch{new LogRecord[kMaxBatchSize]}
+{
+    std::size_t numOfCells{2};
+    while (numOfCells < capacity)
+    {
+        numOfCells <<= 1;
+    }
+    m_mask = numOfCells - 1;
+    m_cells.reset(new Cell[numOfCells]);
+    for (std::size_t i = 0; i < numOfCells; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_writerThread = std::thread(&AsyncLogWriter::writerThreadLoop, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    stop();
+}
+
+bool AsyncLogWriter::push(const LogRecord &record)
+{
+    if (!m_isRunning.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    Cell *cell{nullptr};
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        cell = &m_cells[pos & m_mask];
+        const std::size_t kSequence = cell->sequence.load(std::memory_order_acquire);
+        const auto kDiff = static_cast<std::intptr_t>(kSequence) - static_cast<std::intptr_t>(pos);
+        if (0 == kDiff)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (kDiff < 0)
+        {
+            // The ring is full, the writer reports the drop later
+            m_numOfDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    copyRecord(cell->record, record);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in writerThreadLoop, so either the writer sees the record or it is woken up here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_isWriterSleeping.load(std::memory_order_relaxed))
+    {
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+        }
+        m_writerCv.notify_one();
+    }
+    return true;
+}
+
+void AsyncLogWriter::flush()
+{
+    if (std::this_thread::get_id() == m_writerThread.get_id())
+    {
+        return;
+    }
+
+    const std::size_t kTargetPos = m_enqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_writerCv.notify_one();
+    m_writtenCv.wait_for(lock, kFlushTimeout,
+                         [&]() { return m_writtenPos.load(std::memory_order_acquire) >= kTargetPos || !m_isRunning; });
+}
+
+void AsyncLogWriter::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isRunning.store(false, std::memory_order_release);
+    }
+    m_writerCv.notify_one();
+
+    if (m_writerThread.joinable() && std::this_thread::get_id() != m_writerThread.get_id())
+    {
+        m_writerThread.join();
+
+        // The calling thread is the only consumer now, write out records pushed during stopping
+        while (writeQueuedRecords())
+        {
+        }
+    }
+}
+
+std::uint64_t AsyncLogWriter::getNumOfDroppedRecords() const
+{
+    return m_numOfDroppedRecords.load(std::memory_order_relaxed);
+}
+
+void AsyncLogWriter::writerThreadLoop()
+{
+    while (true)
+    {
+        if (writeQueuedRecords())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{m_mutex};
+        if (!m_isRunning.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        m_isWriterSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const Cell &kNextCell = m_cells[m_dequeuePos & m_mask];
+        if (kNextCell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+        {
+            m_writerCv.wait(lock);
+        }
+        m_isWriterSleeping.store(false, std::memory_order_relaxed);
+    }
+
+    while (writeQueuedRecords())
+    {
+    }
+}
+
+bool AsyncLogWriter::writeQueuedRecords()
+{
+    std::size_t numOfRecords{0};
+    while (numOfRecords < kMaxBatchSize)
+    {
+        Cell &cell = m_cells[m_dequeuePos & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+        {
+            break;
+        }
+        copyRecord(m_batch[numOfRecords++], cell.record);
+        cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePos;
+    }
+
+    if (numOfRecords > 0)
+    {
+        m_sink(m_batch.get(), numOfRecords);
+    }
+    reportDroppedRecords();
+
+    if (numOfRecords > 0)
+    {
+        m_writtenPos.store(m_dequeuePos, std::memory_order_release);
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_writtenCv.notify_all();
+    }
+    return numOfRecords > 0;
+}
+
+void AsyncLogWriter::reportDroppedRecords()
+{
+    const std::uint64_t kNumOfDroppedRecords = m_numOfDroppedRecords.load(std::memory_order_relaxed);
+    if (kNumOfDroppedRecords == m_numOfReportedDroppedRecords)
+    {
+        return;
+    }
+
+    LogRecord record{};
+    record.level = RIALTO_DEBUG_LEVEL_WARNING;
+    clock_gettime(CLOCK_MONOTONIC, &record.timestamp);
+    int len = snprintf(record.message, sizeof(record.message), "Log ring overflow, %" PRIu64 " log records dropped",
+                       kNumOfDroppedRecords - m_numOfReportedDroppedRecords);
+    record.messageLen = std::min(static_cast<std::size_t>(std::max(len, 0)), sizeof(record.message) - 1);
+    m_numOfReportedDroppedRecords = kNumOfDroppedRecords;
+    m_sink(&record, 1);
+}
+} // namespace firebolt::rialto::logging
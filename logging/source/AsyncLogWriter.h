@@ -0,0 +1,156 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_LOGGING_ASYNC_LOG_WRITER_H_
+#define FIREBOLT_RIALTO_LOGGING_ASYNC_LOG_WRITER_H_
+
+#include "RialtoLogging.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include <thread>
+
+namespace firebolt::rialto::logging
+{
+/**
+ * @brief A single formatted log message, with the context it was logged in.
+ */
+struct LogRecord
+{
+    RIALTO_DEBUG_LEVEL level; /**< The log level. */
+    const char *file;         /**< The file name, must have static storage duration. */
+    int line;                 /**< The line number. */
+    const char *function;     /**< The function name, must have static storage duration. */
+    timespec timestamp;       /**< The monotonic time of logging. */
+    pid_t threadId;           /**< The id of the logging thread. */
+    std::size_t messageLen;   /**< The length of the message. */
+    char message[256];        /**< The null terminated message. */
+};
+
+/**
+ * @brief Writes the log records on a background thread.
+ *
+ * Logging threads push records into a bounded lock-free multi-producer ring, without blocking. The writer
+ * thread passes the queued records to the sink in batches. Records pushed while the ring is full are dropped
+ * and reported with a warning record.
+ */
+class AsyncLogWriter
+{
+public:
+    /**
+     * @brief The function writing out a batch of records.
+     */
+    using Sink = std::function<void(const LogRecord *records, std::size_t numOfRecords)>;
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] sink     : The function writing out the records.
+     * @param[in] capacity : The number of records the ring can hold, rounded up to a power of two.
+     */
+    AsyncLogWriter(const Sink &sink, std::size_t capacity);
+
+    /**
+     * @brief The destructor. Writes out all the queued records.
+     */
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter &) = delete;
+    AsyncLogWriter(AsyncLogWriter &&) = delete;
+    AsyncLogWriter &operator=(const AsyncLogWriter &) = delete;
+    AsyncLogWriter &operator=(AsyncLogWriter &&) = delete;
+
+    /**
+     * @brief Queues the record to be written. Never blocks.
+     *
+     * @param[in] record : The record.
+     *
+     * @retval false if the writer has been stopped and the record must be written by the caller.
+     */
+    bool push(const LogRecord &record);
+
+    /**
+     * @brief Waits until all the records queued so far have been written.
+     */
+    void flush();
+
+    /**
+     * @brief Writes out all the queued records and stops the writer thread. Later records are rejected by push().
+     */
+    void stop();
+
+    /**
+     * @brief Gets the total number of records dropped because the ring was full.
+     *
+     * @retval the number of dropped records.
+     */
+    std::uint64_t getNumOfDroppedRecords() const;
+
+private:
+    /**
+     * @brief Ring cell. The sequence tells whether the cell is free for the producer or filled for the consumer.
+     */
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence; /**< The sequence number of the cell. */
+        LogRecord record;                  /**< The stored record. */
+    };
+
+    /**
+     * @brief The loop of the writer thread.
+     */
+    void writerThreadLoop();
+
+    /**
+     * @brief Passes the queued records to the sink.
+     *
+     * @retval true if any record has been written.
+     */
+    bool writeQueuedRecords();
+
+    /**
+     * @brief Writes the warning about the records dropped since the last report.
+     */
+    void reportDroppedRecords();
+
+    Sink m_sink;
+    std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    std::atomic<std::size_t> m_enqueuePos;
+    std::size_t m_dequeuePos;
+    std::atomic<std::size_t> m_writtenPos;
+    std::atomic<std::uint64_t> m_numOfDroppedRecords;
+    std::uint64_t m_numOfReportedDroppedRecords;
+    std::atomic<bool> m_isRunning;
+    std::atomic<bool> m_isWriterSleeping;
+    std::mutex m_mutex;
+    std::condition_variable m_writerCv;
+    std::condition_variable m_writtenCv;
+    std::unique_ptr<LogRecord[]> m_batch;
+    std::thread m_writerThread;
+};
+} // namespace firebolt::rialto::logging
+
+#endif // FIREBOLT_RIALTO_LOGGING_ASYNC_LOG_WRITER_H_
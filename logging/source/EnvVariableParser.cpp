@@ -45,6 +45,16 @@ std::string getRialtoConsoleLog()
     return "";
 }
 
+std::string getRialtoAsyncLog()
+{
+    const char *debugVar = getenv("RIALTO_ASYNC_LOG");
+    if (debugVar)
+    {
+        return std::string(debugVar);
+    }
+    return "";
+}
+
 inline bool isNumber(const std::string &str)
 {
     return std::find_if(str.begin(), str.end(), [](unsigned char c) { return !std::isdigit(c); }) == str.end();
@@ -134,10 +144,11 @@ EnvVariableParser::EnvVariableParser()
                     {RIALTO_COMPONENT_IPC, RIALTO_DEBUG_LEVEL_DEFAULT},
                     {RIALTO_COMPONENT_SERVER_MANAGER, RIALTO_DEBUG_LEVEL_DEFAULT},
                     {RIALTO_COMPONENT_COMMON, RIALTO_DEBUG_LEVEL_DEFAULT}},
-      m_logToConsole{false}
+      m_logToConsole{false}, m_logAsync{false}
 {
     configureRialtoDebug();
     configureRialtoConsoleLog();
+    configureRialtoAsyncLog();
 }
 
 void EnvVariableParser::configureRialtoDebug()
@@ -179,6 +190,15 @@ void EnvVariableParser::configureRialtoConsoleLog()
     }
 }
 
+void EnvVariableParser::configureRialtoAsyncLog()
+{
+    std::string debugFlagEnvVar = getRialtoAsyncLog();
+    if (debugFlagEnvVar == "1")
+    {
+        m_logAsync = true;
+    }
+}
+
 RIALTO_DEBUG_LEVEL EnvVariableParser::getLevel(const RIALTO_COMPONENT &component) const
 {
     if (RIALTO_COMPONENT_EXTERNAL == component)
@@ -195,4 +215,9 @@ bool EnvVariableParser::isConsoleLoggingEnabled() const
 {
     return m_logToConsole;
 }
+
+bool EnvVariableParser::isAsyncLoggingEnabled() const
+{
+    return m_logAsync;
+}
 } // namespace firebolt::rialto::logging
@@ -18,9 +18,11 @@
  */
 
 #include "RialtoLogging.h"
+#include "AsyncLogWriter.h"
 #include "EnvVariableParser.h"
-#include <atomic>
+#include <algorithm>
 #include <cstdarg>
+#include <cstdlib>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
@@ -31,39 +33,58 @@
 
 /**
  * Log levels for each component. By default will print all fatals, errors, warnings & milestones.
+ * Read without locking by the logging macros, so only accessed with atomic builtins.
  */
-static std::atomic<RIALTO_DEBUG_LEVEL> g_rialtoLogLevels[RIALTO_COMPONENT_LAST] = {};
+uint32_t g_rialtoLogLevels[RIALTO_COMPONENT_LAST] = {};
 
 /**
  * Default Log levels defined by RIALTO_DEBUG environment variable
  */
 static const firebolt::rialto::logging::EnvVariableParser g_envVariableParser;
 
+using firebolt::rialto::logging::AsyncLogWriter;
+using firebolt::rialto::logging::LogRecord;
+
 /**
- * Log handler for each component. By default will use journaldLogHandler.
+ * Gets the log levels of the component, resolving the default levels on first use.
+ */
+static RIALTO_DEBUG_LEVEL loadLogLevels(RIALTO_COMPONENT component)
+{
+    uint32_t levels = __atomic_load_n(&g_rialtoLogLevels[component], __ATOMIC_RELAXED);
+    if (!levels)
+    {
+        levels = g_envVariableParser.getLevel(component);
+        __atomic_store_n(&g_rialtoLogLevels[component], levels, __ATOMIC_RELAXED);
+    }
+    return static_cast<RIALTO_DEBUG_LEVEL>(levels);
+}
+
+/**
+ * Log handler for each component. By default will use the default log writer.
  */
-static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
-                              const char *message, size_t messageLen);
-static void journaldLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
-                               const char *message, size_t messageLen);
 static firebolt::rialto::logging::LogHandler g_logHandler[RIALTO_COMPONENT_LAST] = {};
 
 /**
- * Console logging function for the library.
+ * Number of records that can be queued by the asynchronous log writer.
  */
-static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
-                              const char *message, size_t messageLen)
-{
-    timespec ts = {0, 0};
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    struct iovec iov[5];
-    char tbuf[32];
+static constexpr size_t kAsyncLogRingCapacity{1024};
 
+/**
+ * Maximum number of records written to the console with a single writev.
+ */
+static constexpr size_t kMaxConsoleBatchSize{16};
+
+/**
+ * Fills the console output of the record into five iovecs, using the provided buffers for the prefixes.
+ */
+static void fillConsoleIov(const LogRecord &record, struct iovec *iov, char (&tbuf)[32], char (&fbuf)[180])
+{
     iov[0].iov_base = tbuf;
-    iov[0].iov_len = snprintf(tbuf, sizeof(tbuf), "%.010lu.%.06lu ", ts.tv_sec, ts.tv_nsec / 1000);
+    iov[0].iov_len = snprintf(tbuf, sizeof(tbuf), "%.010lu.%.06lu ", record.timestamp.tv_sec,
+                              record.timestamp.tv_nsec / 1000);
     iov[0].iov_len = std::min(iov[0].iov_len, sizeof(tbuf));
 
-    switch (level)
+    switch (record.level)
     {
     case RIALTO_DEBUG_LEVEL_FATAL:
         iov[1].iov_base = const_cast<void *>(reinterpret_cast<const void *>("FTL: "));
@@ -96,82 +117,136 @@ static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int li
         break;
     }
 
-    static thread_local pid_t threadId = 0;
-    if (threadId <= 0)
-        threadId = syscall(SYS_gettid);
-    char fbuf[180];
     iov[2].iov_base = reinterpret_cast<void *>(fbuf);
-    if (RIALTO_DEBUG_LEVEL_EXTERNAL == level)
+    if (RIALTO_DEBUG_LEVEL_EXTERNAL == record.level)
     {
-        iov[2].iov_len = snprintf(fbuf, sizeof(fbuf), "< T:%d >", threadId);
+        iov[2].iov_len = snprintf(fbuf, sizeof(fbuf), "< T:%d >", record.threadId);
     }
-    else if (!file || !function || (line <= 0))
+    else if (!record.file || !record.function || (record.line <= 0))
     {
-        iov[2].iov_len = snprintf(fbuf, sizeof(fbuf), "< T:%d M:? F:? L:? > ", threadId);
+        iov[2].iov_len = snprintf(fbuf, sizeof(fbuf), "< T:%d M:? F:? L:? > ", record.threadId);
     }
     else
     {
-        iov[2].iov_len =
-            snprintf(fbuf, sizeof(fbuf), "< T:%d M:%.*s F:%.*s L:%d > ", threadId, 64, file, 64, function, line);
+        iov[2].iov_len = snprintf(fbuf, sizeof(fbuf), "< T:%d M:%.*s F:%.*s L:%d > ", record.threadId, 64,
+                                  record.file, 64, record.function, record.line);
     }
     iov[2].iov_len = std::min(iov[2].iov_len, sizeof(fbuf));
-    iov[3].iov_base = const_cast<void *>(reinterpret_cast<const void *>(message));
-    iov[3].iov_len = messageLen;
+    iov[3].iov_base = const_cast<void *>(reinterpret_cast<const void *>(record.message));
+    iov[3].iov_len = record.messageLen;
     iov[4].iov_base = const_cast<void *>(reinterpret_cast<const void *>("\n"));
     iov[4].iov_len = 1;
-    // TODO(RIALTO-38): consider using standard write(2) and handle EINTR properly.
-    std::ignore = writev(STDERR_FILENO, iov, 5);
+}
+
+/**
+ * Console logging function for the library. Writes up to kMaxConsoleBatchSize records with a single writev.
+ */
+static void consoleLogWriter(const LogRecord *records, size_t numOfRecords)
+{
+    struct iovec iov[5 * kMaxConsoleBatchSize];
+    char tbuf[kMaxConsoleBatchSize][32];
+    char fbuf[kMaxConsoleBatchSize][180];
+
+    while (numOfRecords > 0)
+    {
+        const size_t kBatchSize = std::min(numOfRecords, kMaxConsoleBatchSize);
+        for (size_t i = 0; i < kBatchSize; ++i)
+        {
+            fillConsoleIov(records[i], &iov[5 * i], tbuf[i], fbuf[i]);
+        }
+        // TODO(RIALTO-38): consider using standard write(2) and handle EINTR properly.
+        std::ignore = writev(STDERR_FILENO, iov, 5 * kBatchSize);
+        records += kBatchSize;
+        numOfRecords -= kBatchSize;
+    }
 }
 
 /**
  * Journald logging function for the library.
  */
-static void journaldLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
-                               const char *message, size_t messageLen)
+static void journaldLogWriter(const LogRecord *records, size_t numOfRecords)
 {
-    static thread_local pid_t threadId = 0;
-    if (threadId <= 0)
-        threadId = syscall(SYS_gettid);
-    char fbuf[180];
-    if (RIALTO_DEBUG_LEVEL_EXTERNAL == level)
+    for (size_t i = 0; i < numOfRecords; ++i)
     {
-        snprintf(fbuf, sizeof(fbuf), "< T:%d >", threadId);
+        const LogRecord &record = records[i];
+        char fbuf[180];
+        if (RIALTO_DEBUG_LEVEL_EXTERNAL == record.level)
+        {
+            snprintf(fbuf, sizeof(fbuf), "< T:%d >", record.threadId);
+        }
+        else if (!record.file || !record.function || (record.line <= 0))
+        {
+            snprintf(fbuf, sizeof(fbuf), "< T:%d M:? F:? L:? >", record.threadId);
+        }
+        else
+        {
+            snprintf(fbuf, sizeof(fbuf), "< T:%d M:%.*s F:%.*s L:%d >", record.threadId, 64, record.file, 64,
+                     record.function, record.line);
+        }
+
+        switch (record.level)
+        {
+        case RIALTO_DEBUG_LEVEL_FATAL:
+            syslog(LOG_CRIT, "%s %s", fbuf, record.message);
+            break;
+        case RIALTO_DEBUG_LEVEL_ERROR:
+            syslog(LOG_ERR, "%s %s", fbuf, record.message);
+            break;
+        case RIALTO_DEBUG_LEVEL_WARNING:
+            syslog(LOG_WARNING, "%s %s", fbuf, record.message);
+            break;
+        case RIALTO_DEBUG_LEVEL_MILESTONE:
+            syslog(LOG_NOTICE, "%s %s", fbuf, record.message);
+            break;
+        case RIALTO_DEBUG_LEVEL_INFO:
+            syslog(LOG_INFO, "%s %s", fbuf, record.message);
+            break;
+        case RIALTO_DEBUG_LEVEL_DEBUG:
+            syslog(LOG_DEBUG, "%s %s", fbuf, record.message);
+            break;
+        case RIALTO_DEBUG_LEVEL_EXTERNAL:
+            syslog(LOG_INFO, "%s %s", fbuf, record.message);
+            break;
+        default:
+            break;
+        }
     }
-    else if (!file || !function || (line <= 0))
+}
+
+/**
+ * Writes the records with the default log output, console or journald.
+ */
+static void defaultLogWriter(const LogRecord *records, size_t numOfRecords)
+{
+    if (g_envVariableParser.isConsoleLoggingEnabled())
     {
-        snprintf(fbuf, sizeof(fbuf), "< T:%d M:? F:? L:? >", threadId);
+        consoleLogWriter(records, numOfRecords);
     }
     else
     {
-        snprintf(fbuf, sizeof(fbuf), "< T:%d M:%.*s F:%.*s L:%d >", threadId, 64, file, 64, function, line);
+        journaldLogWriter(records, numOfRecords);
     }
+}
 
-    switch (level)
+/**
+ * Asynchronous writer of the default log output, enabled with RIALTO_ASYNC_LOG=1. Never destroyed, so that it can
+ * be used from static destructors. It is stopped at exit, after writing out the queued records.
+ */
+static void stopAsyncLogWriter();
+static AsyncLogWriter *createAsyncLogWriter()
+{
+    if (!g_envVariableParser.isAsyncLoggingEnabled())
     {
-    case RIALTO_DEBUG_LEVEL_FATAL:
-        syslog(LOG_CRIT, "%s %s", fbuf, message);
-        break;
-    case RIALTO_DEBUG_LEVEL_ERROR:
-        syslog(LOG_ERR, "%s %s", fbuf, message);
-        break;
-    case RIALTO_DEBUG_LEVEL_WARNING:
-        syslog(LOG_WARNING, "%s %s", fbuf, message);
-        break;
-    case RIALTO_DEBUG_LEVEL_MILESTONE:
-        syslog(LOG_NOTICE, "%s %s", fbuf, message);
-        break;
-    case RIALTO_DEBUG_LEVEL_INFO:
-        syslog(LOG_INFO, "%s %s", fbuf, message);
-        break;
-    case RIALTO_DEBUG_LEVEL_DEBUG:
-        syslog(LOG_DEBUG, "%s %s", fbuf, message);
-        break;
-    case RIALTO_DEBUG_LEVEL_EXTERNAL:
-        syslog(LOG_INFO, "%s %s", fbuf, message);
-        break;
-    default:
-        break;
+        return nullptr;
     }
+    AsyncLogWriter *writer = new AsyncLogWriter(defaultLogWriter, kAsyncLogRingCapacity);
+    std::atexit(stopAsyncLogWriter);
+    return writer;
+}
+static AsyncLogWriter *const g_asyncLogWriter{createAsyncLogWriter()};
+static void stopAsyncLogWriter()
+{
+    g_asyncLogWriter->stop();
 }
 
 static void rialtoLog(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, const char *file, const char *func,
@@ -182,24 +257,22 @@ static void rialtoLog(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, cons
         return;
 
     /* If log levels have not been set, set to Default */
-    if (!g_rialtoLogLevels[component])
-        g_rialtoLogLevels[component] = g_envVariableParser.getLevel(component);
-
-    if (!(level & g_rialtoLogLevels[component]))
+    if (!(level & loadLogLevels(component)))
         return;
-    char mbuf[256];
+    LogRecord record;
+    char *mbuf = record.message;
     int len;
-    len = vsnprintf(mbuf, sizeof(mbuf), fmt, ap);
+    len = vsnprintf(mbuf, sizeof(record.message), fmt, ap);
     if (len < 1)
         return;
-    if (len > static_cast<int>(sizeof(mbuf) - 1))
-        len = sizeof(mbuf) - 1;
+    if (len > static_cast<int>(sizeof(record.message) - 1))
+        len = sizeof(record.message) - 1;
     if (mbuf[len - 1] == '\n')
         len--;
     mbuf[len] = '\0';
-    if (append && (len < static_cast<int>(sizeof(mbuf) - 1)))
+    if (append && (len < static_cast<int>(sizeof(record.message) - 1)))
     {
-        size_t extra = std::min<size_t>(strlen(append), (sizeof(mbuf) - len - 1));
+        size_t extra = std::min<size_t>(strlen(append), (sizeof(record.message) - len - 1));
         memcpy(mbuf + len, append, extra);
         len += static_cast<int>(extra);
         mbuf[len] = '\0';
@@ -217,15 +290,28 @@ static void rialtoLog(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, cons
     if (g_logHandler[component])
     {
         g_logHandler[component](level, fname, line, func, mbuf, len);
+        return;
     }
-    else if (g_envVariableParser.isConsoleLoggingEnabled())
-    {
-        consoleLogHandler(level, fname, line, func, mbuf, len);
-    }
-    else
+
+    static thread_local pid_t threadId = 0;
+    if (threadId <= 0)
+        threadId = syscall(SYS_gettid);
+    record.level = level;
+    record.file = fname;
+    record.line = line;
+    record.function = func;
+    record.threadId = threadId;
+    record.messageLen = len;
+    clock_gettime(CLOCK_MONOTONIC, &record.timestamp);
+
+    if (g_asyncLogWriter)
     {
-        journaldLogHandler(level, fname, line, func, mbuf, len);
+        /* Fatal logs are written synchronously, after all the queued records */
+        if ((RIALTO_DEBUG_LEVEL_FATAL != level) && g_asyncLogWriter->push(record))
+            return;
+        g_asyncLogWriter->flush();
     }
+    defaultLogWriter(&record, 1);
 }
 
 void rialtoLogVPrintf(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, const char *file, const char *func,
@@ -278,7 +364,7 @@ RialtoLoggingStatus setLogLevels(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL
     RialtoLoggingStatus status = RIALTO_LOGGING_STATUS_ERROR;
     if (component < RIALTO_COMPONENT_LAST)
     {
-        g_rialtoLogLevels[component] = logLevels;
+        __atomic_store_n(&g_rialtoLogLevels[component], static_cast<uint32_t>(logLevels), __ATOMIC_RELAXED);
         status = RIALTO_LOGGING_STATUS_OK;
     }
 
@@ -289,9 +375,7 @@ RIALTO_DEBUG_LEVEL getLogLevels(RIALTO_COMPONENT component)
 {
     if (component < RIALTO_COMPONENT_LAST)
     {
-        if (!g_rialtoLogLevels[component])
-            g_rialtoLogLevels[component] = g_envVariableParser.getLevel(component);
-        return g_rialtoLogLevels[component];
+        return loadLogLevels(component);
     }
     return RIALTO_DEBUG_LEVEL_DEFAULT;
 }
@@ -97,6 +97,8 @@ public:
 
     bool getVolume(double &volume) override;
 
+    bool getStatusPageOffset(std::uint32_t &offset) const override;
+
 private:
     /**
      * @brief The media player client ipc.
@@ -113,6 +115,16 @@ private:
      */
     std::atomic<int> m_sessionId;
 
+    /**
+     * @brief Whether the server provided a status page for the session. Set once, when the session is created.
+     */
+    bool m_hasStatusPage;
+
+    /**
+     * @brief The offset of the session status page in the shared memory.
+     */
+    std::uint32_t m_statusPageOffset;
+
     /**
      * @brief Thread for handling media player events from the server.
      */
@@ -157,6 +169,13 @@ private:
      */
     void onQos(const std::shared_ptr<firebolt::rialto::QosEvent> &event);
 
+    /**
+     * @brief Handler for a failure of the server to process the data of a haveData call.
+     *
+     * @param[in] event : The have data error event structure.
+     */
+    void onHaveDataError(const std::shared_ptr<firebolt::rialto::HaveDataErrorEvent> &event);
+
     /**
      * @brief Create a new player session.
      *
@@ -144,10 +144,13 @@ public:
     /**
      * @brief Notify server that the data has been written to the shared memory.
      *
+     * Does not wait for the server to process the data, a failure to do so is reported later with
+     * IMediaPipelineIpcClient::notifyHaveDataError().
+     *
      * @param[in] status    : The status.
      * @param[in] requestId : The Need data request id.
      *
-     * @retval true on success.
+     * @retval true if the notification was sent.
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId) = 0;
 
@@ -203,6 +206,17 @@ public:
      * @retval true on success false otherwise
      */
     virtual bool getVolume(double &volume) = 0;
+
+    /**
+     * @brief Gets the offset of the session status page in the shared memory.
+     *
+     * The status page is published by the server and can be read without an ipc call.
+     *
+     * @param[out] offset : The offset of the status page.
+     *
+     * @retval true if the server provided a status page for the session.
+     */
+    virtual bool getStatusPageOffset(std::uint32_t &offset) const = 0;
 };
 
 }; // namespace firebolt::rialto::client
@@ -86,6 +86,13 @@ public:
      * @param[in] qosInfo   : The information provided in the update.
      */
     virtual void notifyQos(int32_t sourceId, const QosInfo &qosInfo) = 0;
+
+    /**
+     * @brief Notifies the rialto client that the server failed to process the data of a haveData call.
+     *
+     * @param[in] requestId : Need data request id passed to haveData.
+     */
+    virtual void notifyHaveDataError(uint32_t requestId) = 0;
 };
 
 }; // namespace firebolt::rialto::client
@@ -70,7 +70,7 @@ MediaPipelineIpcFactory::createMediaPipelineIpc(IMediaPipelineIpcClient *client,
 MediaPipelineIpc::MediaPipelineIpc(IMediaPipelineIpcClient *client, const VideoRequirements &videoRequirements,
                                    const std::shared_ptr<IIpcClientFactory> &ipcClientFactory,
                                    const std::shared_ptr<common::IEventThreadFactory> &eventThreadFactory)
-    : IpcModule(ipcClientFactory), m_mediaPipelineIpcClient(client),
+    : IpcModule(ipcClientFactory), m_mediaPipelineIpcClient(client), m_hasStatusPage{false}, m_statusPageOffset{0},
       m_eventThread(eventThreadFactory->createEventThread("rialto-media-player-events"))
 {
     if (!attachChannel())
@@ -149,6 +149,13 @@ bool MediaPipelineIpc::subscribeToEvents()
         return false;
     m_eventTags.push_back(eventTag);
 
+    eventTag = m_ipcChannel->subscribe<firebolt::rialto::HaveDataErrorEvent>(
+        [this](const std::shared_ptr<firebolt::rialto::HaveDataErrorEvent> &event)
+        { m_eventThread->add(&MediaPipelineIpc::onHaveDataError, this, event); });
+    if (eventTag < 0)
+        return false;
+    m_eventTags.push_back(eventTag);
+
     return true;
 }
 
@@ -414,18 +421,20 @@ bool MediaPipelineIpc::haveData(MediaSourceStatus status, uint32_t numFrames, ui
     request.set_num_frames(numFrames);
     request.set_request_id(requestId);
 
+    // the server doesn't reply to haveDataNoReply, the closure is run as soon as the request has been sent and
+    // any failure to process the data is reported later with a HaveDataErrorEvent
     firebolt::rialto::HaveDataResponse response;
     auto ipcController = m_ipc->createRpcController();
     auto blockingClosure = m_ipc->createBlockingClosure();
-    m_mediaPipelineStub->haveData(ipcController.get(), &request, &response, blockingClosure.get());
+    m_mediaPipelineStub->haveDataNoReply(ipcController.get(), &request, &response, blockingClosure.get());
 
-    // wait for the call to complete
+    // wait for the request to be sent
     blockingClosure->wait();
 
     // check the result
     if (ipcController->Failed())
     {
-        RIALTO_CLIENT_LOG_ERROR("failed to stop due to '%s'", ipcController->ErrorText().c_str());
+        RIALTO_CLIENT_LOG_ERROR("failed to send have data due to '%s'", ipcController->ErrorText().c_str());
         return false;
     }
 
@@ -616,6 +625,16 @@ bool MediaPipelineIpc::getVolume(double &volume)
     return true;
 }
 
+bool MediaPipelineIpc::getStatusPageOffset(std::uint32_t &offset) const
+{
+    if (!m_hasStatusPage)
+    {
+        return false;
+    }
+    offset = m_statusPageOffset;
+    return true;
+}
+
 void MediaPipelineIpc::onPlaybackStateUpdated(const std::shared_ptr<firebolt::rialto::PlaybackStateChangeEvent> &event)
 {
     /* Ignore event if not for this session */
@@ -718,6 +737,10 @@ void MediaPipelineIpc::onNeedMediaData(const std::shared_ptr<firebolt::rialto::N
             shmInfo->metadataOffset = event->shm_info().metadata_offset();
             shmInfo->mediaDataOffset = event->shm_info().media_data_offset();
             shmInfo->maxMediaBytes = event->shm_info().max_media_bytes();
+            if (event->shm_info().has_max_metadata_version())
+            {
+                shmInfo->maxMetadataVersion = event->shm_info().max_metadata_version();
+            }
         }
         m_mediaPipelineIpcClient->notifyNeedMediaData(event->source_id(), event->frame_count(), event->request_id(),
                                                       shmInfo);
@@ -734,6 +757,15 @@ void MediaPipelineIpc::onQos(const std::shared_ptr<firebolt::rialto::QosEvent> &
     }
 }
 
+void MediaPipelineIpc::onHaveDataError(const std::shared_ptr<firebolt::rialto::HaveDataErrorEvent> &event)
+{
+    // Ignore event if not for this session
+    if (event->session_id() == m_sessionId)
+    {
+        m_mediaPipelineIpcClient->notifyHaveDataError(event->request_id());
+    }
+}
+
 bool MediaPipelineIpc::createSession(const VideoRequirements &videoRequirements)
 {
     if (!reattachChannelIfRequired())
@@ -763,6 +795,8 @@ bool MediaPipelineIpc::createSession(const VideoRequirements &videoRequirements)
     }
 
     m_sessionId = response.session_id();
+    m_hasStatusPage = response.has_status_page_offset();
+    m_statusPageOffset = response.status_page_offset();
 
     return true;
 }
@@ -129,6 +129,8 @@ public:
 
     void notifyQos(int32_t sourceId, const QosInfo &qosInfo) override;
 
+    void notifyHaveDataError(uint32_t requestId) override;
+
     bool renderFrame() override;
 
     bool setVolume(double volume) override;
@@ -178,10 +180,25 @@ protected:
     std::shared_ptr<common::IMediaFrameWriterFactory> m_mediaFrameWriterFactory;
 
     /**
-     * @brief The shared memory mutex.
+     * @brief The shared memory mutex. Held while the status page is read, so the buffer is not unmapped meanwhile.
      */
     std::mutex m_shmMutex;
 
+    /**
+     * @brief The last position returned by getPosition, or -1 when the next position can go back, e.g. after a seek.
+     */
+    int64_t m_lastPosition;
+
+    /**
+     * @brief Whether the returned positions are kept monotonic, false when playing backwards.
+     */
+    bool m_isPositionMonotonic;
+
+    /**
+     * @brief The last position mutex.
+     */
+    std::mutex m_lastPositionMutex;
+
     /**
      * @brief The current state of the MediaPipeline.
      */
@@ -226,6 +243,27 @@ protected:
      */
     bool handleSetPosition(int64_t position);
 
+    /**
+     * @brief Gets the playback position from the status page in the shared memory, without an ipc call.
+     *
+     * @param[out] position : The playback position in nanoseconds.
+     *
+     * @retval true if the status page holds a valid position, false if it should be requested from the server.
+     */
+    bool getPositionFromStatusPage(int64_t &position);
+
+    /**
+     * @brief Allows the next position returned by getPosition to be behind the last one, e.g. after a seek.
+     */
+    void resetLastPosition();
+
+    /**
+     * @brief Allows the next position returned by getPosition to be behind the last one, after a rate change.
+     *
+     * @param[in] playbackRate : The new playback rate. The positions are only kept monotonic when playing forwards.
+     */
+    void resetLastPosition(double playbackRate);
+
     /**
      * @brief Discards the need data request with id.
      *
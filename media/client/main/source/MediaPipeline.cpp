@@ -20,11 +20,31 @@
 #include "MediaPipeline.h"
 #include "KeyIdMap.h"
 #include "RialtoClientLogging.h"
+#include "ShmStatusPage.h"
+#include <chrono>
 #include <inttypes.h>
 #include <stdint.h>
 
 namespace
 {
+/**
+ * @brief The maximum age of the position published in the status page, that can be extrapolated while playing.
+ *
+ * Matches the interval of the position reports, so the extrapolation never runs ahead by more than one report.
+ */
+constexpr std::int64_t kMaxStatusPositionAgeNs{250000000};
+
+/**
+ * @brief The playback rate of a newly loaded playback.
+ */
+constexpr double kDefaultPlaybackRate{1.0};
+
+std::int64_t getMonotonicTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 const char *toString(const firebolt::rialto::client::MediaPipeline::State &state)
 {
     switch (state)
@@ -140,7 +160,8 @@ MediaPipeline::MediaPipeline(std::weak_ptr<IMediaPipelineClient> client, const V
                              const std::shared_ptr<IMediaPipelineIpcFactory> &mediaPipelineIpcFactory,
                              const std::shared_ptr<common::IMediaFrameWriterFactory> &mediaFrameWriterFactory,
                              const std::shared_ptr<ISharedMemoryManagerFactory> &sharedMemoryManagerFactory)
-    : m_mediaPipelineClient(client), m_mediaFrameWriterFactory(mediaFrameWriterFactory), m_currentState(State::IDLE)
+    : m_mediaPipelineClient(client), m_mediaFrameWriterFactory(mediaFrameWriterFactory), m_lastPosition(-1),
+      m_isPositionMonotonic(true), m_currentState(State::IDLE)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
@@ -181,6 +202,7 @@ bool MediaPipeline::load(MediaType type, const std::string &mimeType, const std:
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
+    resetLastPosition(kDefaultPlaybackRate);
     return m_mediaPipelineIpc->load(type, mimeType, url);
 }
 
@@ -225,6 +247,7 @@ bool MediaPipeline::stop()
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
     m_currentState = State::IDLE;
+    resetLastPosition();
 
     return m_mediaPipelineIpc->stop();
 }
@@ -233,6 +256,7 @@ bool MediaPipeline::setPlaybackRate(double rate)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
+    resetLastPosition(rate);
     return m_mediaPipelineIpc->setPlaybackRate(rate);
 }
 
@@ -259,7 +283,76 @@ bool MediaPipeline::setPosition(int64_t position)
 
 bool MediaPipeline::getPosition(int64_t &position)
 {
-    return m_mediaPipelineIpc->getPosition(position);
+    if (!getPositionFromStatusPage(position) && !m_mediaPipelineIpc->getPosition(position))
+    {
+        return false;
+    }
+
+    // The extrapolated position may run slightly ahead of the next report, so do not go back until the next seek
+    std::lock_guard<std::mutex> lock{m_lastPositionMutex};
+    if (m_isPositionMonotonic && m_lastPosition > position)
+    {
+        position = m_lastPosition;
+    }
+    m_lastPosition = position;
+    return true;
+}
+
+void MediaPipeline::resetLastPosition()
+{
+    std::lock_guard<std::mutex> lock{m_lastPositionMutex};
+    m_lastPosition = -1;
+}
+
+void MediaPipeline::resetLastPosition(double playbackRate)
+{
+    std::lock_guard<std::mutex> lock{m_lastPositionMutex};
+    m_lastPosition = -1;
+    m_isPositionMonotonic = playbackRate > 0.0;
+}
+
+bool MediaPipeline::getPositionFromStatusPage(int64_t &position)
+{
+    std::uint32_t statusPageOffset{0};
+    if (!m_mediaPipelineIpc->getStatusPageOffset(statusPageOffset))
+    {
+        return false;
+    }
+
+    common::PlaybackStatus status;
+    {
+        std::lock_guard<std::mutex> lock{m_shmMutex};
+        uint8_t *shmBuffer = m_sharedMemoryManager->getSharedMemoryBuffer();
+        if (nullptr == shmBuffer || !common::ShmStatusPage{shmBuffer + statusPageOffset}.read(status))
+        {
+            return false;
+        }
+    }
+
+    switch (status.playbackState)
+    {
+    case PlaybackState::PAUSED:
+    case PlaybackState::END_OF_STREAM:
+    {
+        position = status.position;
+        return true;
+    }
+    case PlaybackState::PLAYING:
+    {
+        // Position reports are sent every 250ms while playing, anything older means that the page is stale
+        const std::int64_t kNow{getMonotonicTimeNs()};
+        if (kNow - status.positionTimestamp > kMaxStatusPositionAgeNs)
+        {
+            return false;
+        }
+        position = common::extrapolatePosition(status, kNow);
+        return true;
+    }
+    default:
+    {
+        return false;
+    }
+    }
 }
 
 bool MediaPipeline::handleSetPosition(int64_t position)
@@ -269,6 +362,7 @@ bool MediaPipeline::handleSetPosition(int64_t position)
         std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
         m_needDataRequestMap.clear();
     }
+    resetLastPosition();
     return m_mediaPipelineIpc->setPosition(position);
 }
 
@@ -605,6 +699,7 @@ void MediaPipeline::notifyBufferTerm()
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
     // If shared memory in use, wait for it to finish before returning
+    std::lock_guard<std::mutex> shmLock{m_shmMutex};
     std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
     m_needDataRequestMap.clear();
 }
@@ -620,4 +715,16 @@ void MediaPipeline::notifyQos(int32_t sourceId, const QosInfo &qosInfo)
     }
 }
 
+void MediaPipeline::notifyHaveDataError(uint32_t requestId)
+{
+    RIALTO_CLIENT_LOG_ERROR("Server failed to process the data of NeedData request %u", requestId);
+
+    // haveData() has already returned to the caller, so the failure is reported as a playback failure,
+    // unless the server has already reported one
+    if (State::FAILURE != m_currentState)
+    {
+        notifyPlaybackState(PlaybackState::FAILURE);
+    }
+}
+
 }; // namespace firebolt::rialto::client
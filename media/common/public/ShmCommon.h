@@ -38,6 +38,41 @@ const uint32_t MAX_EXTRA_DATA_SIZE = 32U;
  * @brief Metadata v1 size per frame in bytes.
  */
 const uint32_t METADATA_V1_SIZE_PER_FRAME_BYTES = 104U;
+
+/**
+ * @brief The latest metadata version, that can be read by the server.
+ */
+const uint32_t LATEST_METADATA_VERSION = 3U;
+
+/**
+ * @brief The metadata version written by clients, until the server confirms support of a newer one.
+ */
+const uint32_t DEFAULT_METADATA_VERSION = 2U;
+
+/**
+ * @brief Size of the fixed part of the metadata v3 frame header in bytes.
+ */
+const uint32_t METADATA_V3_FIXED_HEADER_SIZE_BYTES = 56U;
+
+/**
+ * @brief Size of a single metadata v3 subsample table entry in bytes.
+ */
+const uint32_t METADATA_V3_SUBSAMPLE_SIZE_BYTES = 8U;
+
+/**
+ * @brief Metadata v3 frame header flag, set for encrypted frames.
+ */
+const uint8_t METADATA_V3_FLAG_ENCRYPTED = 0x01U;
+
+/**
+ * @brief Metadata v3 frame header flag, set when the type specific params carry sample rate and channels.
+ */
+const uint8_t METADATA_V3_FLAG_AUDIO_PARAMS = 0x02U;
+
+/**
+ * @brief Metadata v3 frame header flag, set when the type specific params carry width and height.
+ */
+const uint8_t METADATA_V3_FLAG_VIDEO_PARAMS = 0x04U;
 }; // namespace firebolt::rialto::common
 
 #endif // FIREBOLT_RIALTO_COMMON_SHM_COMMON_H_
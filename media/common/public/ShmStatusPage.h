@@ -0,0 +1,171 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_SHM_STATUS_PAGE_H_
+#define FIREBOLT_RIALTO_COMMON_SHM_STATUS_PAGE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "MediaCommon.h"
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief Size of the status page reserved in the shared memory for each playback session, in bytes.
+ */
+const uint32_t STATUS_PAGE_SIZE_BYTES = 256U;
+
+/**
+ * @brief The status of a playback session, as published by the server in the status page.
+ */
+struct PlaybackStatus
+{
+    int64_t position{0};                                 /**< The last known position in nanoseconds. */
+    int64_t positionTimestamp{0};                        /**< CLOCK_MONOTONIC time of the position in ns. */
+    double playbackRate{1.0};                            /**< The playback rate. */
+    PlaybackState playbackState{PlaybackState::UNKNOWN}; /**< The playback state. */
+    NetworkState networkState{NetworkState::UNKNOWN};    /**< The network state. */
+    uint64_t audioQueuedBytes{0};                        /**< The number of bytes queued in the audio app source. */
+    uint64_t videoQueuedBytes{0};                        /**< The number of bytes queued in the video app source. */
+    QosInfo audioQos{0, 0};                              /**< The last Qos update of the audio source. */
+    QosInfo videoQos{0, 0};                              /**< The last Qos update of the video source. */
+};
+
+/**
+ * @brief Gets the position of the playback at the given time, extrapolated from the last known position.
+ *
+ * The position only moves on while the playback is playing.
+ *
+ * @param[in] status    : The status of the playback.
+ * @param[in] timestamp : The CLOCK_MONOTONIC time in nanoseconds.
+ *
+ * @retval the position in nanoseconds.
+ */
+inline int64_t extrapolatePosition(const PlaybackStatus &status, int64_t timestamp)
+{
+    if ((PlaybackState::PLAYING != status.playbackState) || (timestamp <= status.positionTimestamp))
+    {
+        return status.position;
+    }
+    return status.position + static_cast<int64_t>(static_cast<double>(timestamp - status.positionTimestamp) *
+                                                  status.playbackRate);
+}
+
+/**
+ * @brief The status page of a playback session in the shared memory.
+ *
+ * The page is written by a single writer (the server main thread) and protected by a sequence lock, so readers in
+ * other processes never block the writer and never see a partially written status.
+ */
+class ShmStatusPage
+{
+public:
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] page : Pointer to the page in the shared memory, at least STATUS_PAGE_SIZE_BYTES long.
+     */
+    explicit ShmStatusPage(uint8_t *page) : m_layout{reinterpret_cast<Layout *>(page)} {}
+
+    /**
+     * @brief Publishes a new status, only to be called by the single writer of the page.
+     *
+     * @param[in] status : The status to publish.
+     */
+    void publish(const PlaybackStatus &status)
+    {
+        uint32_t words[kNumOfWords] = {};
+        memcpy(words, &status, sizeof(status));
+
+        const uint32_t kSequence = m_layout->sequence.load(std::memory_order_relaxed);
+        m_layout->sequence.store(kSequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (uint32_t i = 0; i < kNumOfWords; ++i)
+        {
+            m_layout->words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_layout->sequence.store(kSequence + 2, std::memory_order_release);
+        m_layout->magic.store(kMagic, std::memory_order_release);
+    }
+
+    /**
+     * @brief Invalidates the page, so that readers stop using it.
+     */
+    void invalidate() { m_layout->magic.store(0, std::memory_order_release); }
+
+    /**
+     * @brief Reads the last published status, without blocking the writer.
+     *
+     * @param[out] status : The status.
+     *
+     * @retval false if no status has been published or the writer kept updating the page.
+     */
+    bool read(PlaybackStatus &status) const
+    {
+        if (kMagic != m_layout->magic.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        uint32_t words[kNumOfWords];
+        for (uint32_t attempt = 0; attempt < kMaxReadAttempts; ++attempt)
+        {
+            const uint32_t kSequence = m_layout->sequence.load(std::memory_order_acquire);
+            if (kSequence & 1U)
+            {
+                continue;
+            }
+            for (uint32_t i = 0; i < kNumOfWords; ++i)
+            {
+                words[i] = m_layout->words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_layout->sequence.load(std::memory_order_relaxed) == kSequence)
+            {
+                memcpy(&status, words, sizeof(status));
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr uint32_t kMagic{0x52535450}; // "RSTP"
+    static constexpr uint32_t kMaxReadAttempts{16};
+    static constexpr uint32_t kNumOfWords{(sizeof(PlaybackStatus) + sizeof(uint32_t) - 1) / sizeof(uint32_t)};
+
+    /**
+     * @brief The layout of the page, the status is stored as words so that it can be copied with atomic accesses.
+     */
+    struct Layout
+    {
+        std::atomic<uint32_t> magic;
+        std::atomic<uint32_t> sequence;
+        std::atomic<uint32_t> words[kNumOfWords];
+    };
+    static_assert(sizeof(Layout) <= STATUS_PAGE_SIZE_BYTES, "Status does not fit in the status page");
+
+    Layout *m_layout;
+};
+}; // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_SHM_STATUS_PAGE_H_
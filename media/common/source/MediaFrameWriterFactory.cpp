@@ -20,14 +20,17 @@
 #include "MediaFrameWriterFactory.h"
 #include "MediaFrameWriterV1.h"
 #include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
 #include "RialtoCommonLogging.h"
+#include "ShmCommon.h"
 #include <algorithm>
 #include <string>
 #include <unistd.h>
 
 namespace
 {
-constexpr int kLatestMetadataVersion{2};
+constexpr int kLatestMetadataVersion{static_cast<int>(firebolt::rialto::common::LATEST_METADATA_VERSION)};
+constexpr int kDefaultMetadataVersion{static_cast<int>(firebolt::rialto::common::DEFAULT_METADATA_VERSION)};
 const char *kMetadataEnvVariableName{"RIALTO_METADATA_VERSION"};
 } // namespace
 
@@ -69,11 +72,26 @@ std::unique_ptr<IMediaFrameWriter>
 MediaFrameWriterFactory::createFrameWriter(uint8_t *shmBuffer, const std::shared_ptr<MediaPlayerShmInfo> &shmInfo)
 try
 {
-    if (1 == m_metadataVersion)
+    // Newer metadata is written only when the server has confirmed, that it can read it
+    int metadataVersion{m_metadataVersion};
+    if (shmInfo && 0 != shmInfo->maxMetadataVersion)
+    {
+        metadataVersion = std::min(metadataVersion, static_cast<int>(shmInfo->maxMetadataVersion));
+    }
+    else
+    {
+        metadataVersion = std::min(metadataVersion, kDefaultMetadataVersion);
+    }
+
+    if (1 == metadataVersion)
     {
         return std::make_unique<MediaFrameWriterV1>(shmBuffer, shmInfo);
     }
-    return std::make_unique<MediaFrameWriterV2>(shmBuffer, shmInfo);
+    if (2 == metadataVersion)
+    {
+        return std::make_unique<MediaFrameWriterV2>(shmBuffer, shmInfo);
+    }
+    return std::make_unique<MediaFrameWriterV3>(shmBuffer, shmInfo);
 }
 catch (const std::exception &e)
 {
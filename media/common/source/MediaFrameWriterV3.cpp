@@ -0,0 +1,160 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include "RialtoCommonLogging.h"
+#include "ShmCommon.h"
+#include <limits>
+
+namespace
+{
+/**
+ * @brief The version of metadata this object shall write.
+ */
+constexpr uint32_t kMetadataVersion = 3U;
+
+/**
+ * @brief Convert SegmentAlignment to its metadata v3 representation
+ */
+uint8_t convertSegmentAlignment(const firebolt::rialto::SegmentAlignment &alignment)
+{
+    switch (alignment)
+    {
+    case firebolt::rialto::SegmentAlignment::UNDEFINED:
+    {
+        return 0;
+    }
+    case firebolt::rialto::SegmentAlignment::NAL:
+    {
+        return 1;
+    }
+    case firebolt::rialto::SegmentAlignment::AU:
+    {
+        return 2;
+    }
+    }
+    return 0;
+}
+} // namespace
+
+namespace firebolt::rialto::common
+{
+MediaFrameWriterV3::MediaFrameWriterV3(uint8_t *shmBuffer, const std::shared_ptr<MediaPlayerShmInfo> &shmInfo)
+    : m_shmBuffer(shmBuffer), m_kMaxBytes(shmInfo->maxMediaBytes), m_bytesWritten(0U),
+      m_dataOffset(shmInfo->mediaDataOffset), m_numFrames{0}, m_lastTimeStamp{0}
+{
+    RIALTO_COMMON_LOG_INFO("We are using a writer for Metadata V3");
+
+    // Every frame carries its own header, so only the metadata region has to be zeroed
+    m_byteWriter.fillBytes(m_shmBuffer, shmInfo->metadataOffset, 0, shmInfo->maxMetadataBytes);
+
+    // Set metadata version
+    m_byteWriter.writeUint32(m_shmBuffer, shmInfo->metadataOffset, kMetadataVersion);
+}
+
+AddSegmentStatus MediaFrameWriterV3::writeFrame(const std::unique_ptr<IMediaPipeline::MediaSegment> &data)
+{
+    uint32_t param1{0};
+    uint32_t param2{0};
+    uint8_t flags{data->isEncrypted() ? METADATA_V3_FLAG_ENCRYPTED : static_cast<uint8_t>(0)};
+    const auto *kAudioSegment{dynamic_cast<const IMediaPipeline::MediaSegmentAudio *>(data.get())};
+    const auto *kVideoSegment{dynamic_cast<const IMediaPipeline::MediaSegmentVideo *>(data.get())};
+    if (MediaSourceType::AUDIO == data->getType() && kAudioSegment)
+    {
+        param1 = static_cast<uint32_t>(kAudioSegment->getSampleRate());
+        param2 = static_cast<uint32_t>(kAudioSegment->getNumberOfChannels());
+        flags |= METADATA_V3_FLAG_AUDIO_PARAMS;
+    }
+    else if (MediaSourceType::VIDEO == data->getType() && kVideoSegment)
+    {
+        param1 = static_cast<uint32_t>(kVideoSegment->getWidth());
+        param2 = static_cast<uint32_t>(kVideoSegment->getHeight());
+        flags |= METADATA_V3_FLAG_VIDEO_PARAMS;
+    }
+    else
+    {
+        RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - media source type not known");
+        return AddSegmentStatus::ERROR;
+    }
+
+    const bool kIsEncrypted{data->isEncrypted()};
+    const std::vector<uint8_t> kEmpty{};
+    const std::vector<uint8_t> &keyId{kIsEncrypted ? data->getKeyId() : kEmpty};
+    const std::vector<uint8_t> &initVector{kIsEncrypted ? data->getInitVector() : kEmpty};
+    const std::vector<uint8_t> &extraData{data->getExtraData()};
+    const size_t kSubSampleCount{kIsEncrypted ? data->getSubSamples().size() : 0};
+    if (keyId.size() > std::numeric_limits<uint8_t>::max() || initVector.size() > std::numeric_limits<uint8_t>::max())
+    {
+        RIALTO_COMMON_LOG_ERROR("Failed to write encryption metadata - key id or init vector too long");
+        return AddSegmentStatus::ERROR;
+    }
+
+    const uint32_t kHeaderSize{static_cast<uint32_t>(METADATA_V3_FIXED_HEADER_SIZE_BYTES + keyId.size() +
+                                                     initVector.size() + extraData.size() +
+                                                     kSubSampleCount * METADATA_V3_SUBSAMPLE_SIZE_BYTES)};
+    if (m_bytesWritten + kHeaderSize + data->getDataLength() > m_kMaxBytes)
+    {
+        RIALTO_COMMON_LOG_ERROR("Not enough memory available to write MediaSegment");
+        return AddSegmentStatus::NO_SPACE;
+    }
+
+    // Fixed part of the header
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, kHeaderSize);
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, data->getDataLength());
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, static_cast<uint32_t>(data->getId()));
+    m_dataOffset = m_byteWriter.writeByte(m_shmBuffer, m_dataOffset, flags);
+    m_dataOffset =
+        m_byteWriter.writeByte(m_shmBuffer, m_dataOffset, convertSegmentAlignment(data->getSegmentAlignment()));
+    m_dataOffset = m_byteWriter.writeByte(m_shmBuffer, m_dataOffset, static_cast<uint8_t>(keyId.size()));
+    m_dataOffset = m_byteWriter.writeByte(m_shmBuffer, m_dataOffset, static_cast<uint8_t>(initVector.size()));
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, static_cast<uint32_t>(extraData.size()));
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, static_cast<uint32_t>(kSubSampleCount));
+    m_dataOffset = m_byteWriter.writeInt64(m_shmBuffer, m_dataOffset, data->getTimeStamp() - m_lastTimeStamp);
+    m_dataOffset = m_byteWriter.writeInt64(m_shmBuffer, m_dataOffset, data->getDuration());
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, param1);
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, param2);
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset,
+                                            kIsEncrypted ? static_cast<uint32_t>(data->getMediaKeySessionId()) : 0);
+    m_dataOffset = m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, kIsEncrypted ? data->getInitWithLast15() : 0);
+
+    // Variable part of the header
+    m_dataOffset = m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset, keyId.data(), keyId.size());
+    m_dataOffset = m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset, initVector.data(), initVector.size());
+    m_dataOffset = m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset, extraData.data(), extraData.size());
+    if (kIsEncrypted)
+    {
+        for (const auto &subSample : data->getSubSamples())
+        {
+            m_dataOffset =
+                m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, static_cast<uint32_t>(subSample.numClearBytes));
+            m_dataOffset =
+                m_byteWriter.writeUint32(m_shmBuffer, m_dataOffset, static_cast<uint32_t>(subSample.numEncryptedBytes));
+        }
+    }
+
+    m_dataOffset = m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset, data->getData(), data->getDataLength());
+
+    // Track the amount of bytes written
+    m_bytesWritten += kHeaderSize + data->getDataLength();
+    m_lastTimeStamp = data->getTimeStamp();
+    ++m_numFrames;
+
+    return AddSegmentStatus::OK;
+}
+} // namespace firebolt::rialto::common
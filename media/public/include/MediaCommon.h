@@ -192,10 +192,11 @@ struct VideoRequirements
  */
 struct MediaPlayerShmInfo
 {
-    uint32_t maxMetadataBytes; /**< The maximum amount of metadata that can be written. */
-    uint32_t metadataOffset;   /**< The offset to write the metadata. */
-    uint32_t mediaDataOffset;  /**< The offset to write the media data. */
-    uint32_t maxMediaBytes;    /**< The maximum amount of mediadata that can be written. */
+    uint32_t maxMetadataBytes;      /**< The maximum amount of metadata that can be written. */
+    uint32_t metadataOffset;        /**< The offset to write the metadata. */
+    uint32_t mediaDataOffset;       /**< The offset to write the media data. */
+    uint32_t maxMediaBytes;         /**< The maximum amount of mediadata that can be written. */
+    uint32_t maxMetadataVersion{0}; /**< The latest metadata version supported by the server, 0 if unknown. */
 };
 
 /**
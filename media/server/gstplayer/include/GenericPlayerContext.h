@@ -24,6 +24,7 @@
 #include "IRdkGstreamerUtilsWrapper.h"
 #include "ITimer.h"
 #include "MediaCommon.h"
+#include "ShmBufferTracker.h"
 #include <gst/gst.h>
 #include <list>
 #include <map>
@@ -145,6 +146,13 @@ struct GenericPlayerContext
      */
     std::list<GstBuffer *> videoBuffers{};
 
+    /**
+     * @brief Tracks the buffers wrapping the shared memory. Set only, when zero copy mode is enabled.
+     *
+     * Tracker is thread safe, buffers are released from streaming threads.
+     */
+    std::shared_ptr<ShmBufferTracker> shmBufferTracker{nullptr};
+
     /**
      * @brief Flag used to check, if audio underflow callback occured
      *
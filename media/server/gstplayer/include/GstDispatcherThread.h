@@ -21,9 +21,12 @@
 #define FIREBOLT_RIALTO_SERVER_GST_DISPATCHER_THREAD_H_
 
 #include "IGstDispatcherThread.h"
-#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <gst/gst.h>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 namespace firebolt::rialto::server
@@ -37,41 +40,158 @@ public:
                               const std::shared_ptr<IGstWrapper> &gstWrapper) const override;
 };
 
-class GstDispatcherThread : public IGstDispatcherThread
+/**
+ * @brief Dispatcher of the bus messages of all the pipelines in the process.
+ *
+ * The poll fds of the registered buses are multiplexed with epoll on a single thread, so messages are handled as
+ * soon as they are posted. The dispatcher lives as long as any GstDispatcherThread is holding it.
+ */
+class GstBusDispatcher
 {
 public:
-    GstDispatcherThread(IGstDispatcherThreadClient &client, GstElement *pipeline,
-                        const std::shared_ptr<IGstWrapper> &gstWrapper);
-    ~GstDispatcherThread() override;
+    /**
+     * @brief The bus of a pipeline, registered for dispatching.
+     */
+    struct Registration
+    {
+        IGstDispatcherThreadClient &client;      /**< The listening client. */
+        GstElement *pipeline;                    /**< The pipeline. */
+        GstBus *bus;                             /**< The bus of the pipeline. */
+        int fd;                                  /**< The poll fd of the bus. */
+        std::shared_ptr<IGstWrapper> gstWrapper; /**< The gstreamer wrapper object. */
+        std::uint64_t id;                        /**< The id assigned by the dispatcher. */
+    };
+
+    /**
+     * @brief Gets the dispatcher of the process, creating it if no pipeline is using it.
+     *
+     * @retval the bus dispatcher.
+     */
+    static std::shared_ptr<GstBusDispatcher> instance();
+
+    GstBusDispatcher();
+    ~GstBusDispatcher();
+
+    GstBusDispatcher(const GstBusDispatcher &) = delete;
+    GstBusDispatcher(GstBusDispatcher &&) = delete;
+    GstBusDispatcher &operator=(const GstBusDispatcher &) = delete;
+    GstBusDispatcher &operator=(GstBusDispatcher &&) = delete;
+
+    /**
+     * @brief Starts dispatching the messages of the bus.
+     *
+     * @param[in] registration : The registered bus.
+     *
+     * @retval true on success.
+     */
+    bool addBus(const std::shared_ptr<Registration> &registration);
+
+    /**
+     * @brief Stops dispatching the messages of the bus.
+     *
+     * If the messages of the bus are being dispatched, waits for it to finish, unless called from the dispatcher
+     * thread.
+     *
+     * @param[in] registration : The registered bus.
+     */
+    void removeBus(const std::shared_ptr<Registration> &registration);
 
 private:
     /**
-     * @brief For handling gst bus messages in Gstreamer dispatcher thread
+     * @brief The loop of the dispatcher thread.
+     */
+    void dispatcherThreadLoop();
+
+    /**
+     * @brief Passes all the pending messages of the bus to its client.
+     *
+     * @param[in] registration : The registered bus.
+     *
+     * @retval false if the pipeline has stopped or failed, and the bus should no longer be dispatched.
+     */
+    bool dispatchMessages(const Registration &registration);
+
+    /**
+     * @brief Removes the bus from the epoll set. Must be called with m_mutex locked.
      *
-     * @param[in] pipeline : The pipeline
+     * @param[in] id : The id of the registration.
      */
-    void gstBusEventHandler(GstElement *pipeline);
+    void removeBusInternal(std::uint64_t id);
 
 private:
     /**
-     * @brief The listening client.
+     * @brief Mutex protecting the dispatcher instance.
+     */
+    static std::mutex m_instanceMutex;
+
+    /**
+     * @brief The dispatcher of the process.
+     */
+    static std::weak_ptr<GstBusDispatcher> m_instance;
+
+    /**
+     * @brief The epoll fd, that the poll fds of the buses are added to.
+     */
+    int m_epollFd;
+
+    /**
+     * @brief The eventfd used to stop the dispatcher thread.
+     */
+    int m_eventFd;
+
+    /**
+     * @brief Mutex protecting the registrations.
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Signalled when the messages of a bus have been dispatched.
+     */
+    std::condition_variable m_dispatchDoneCv;
+
+    /**
+     * @brief The registered buses, by the id used as the epoll data.
+     */
+    std::map<std::uint64_t, std::shared_ptr<Registration>> m_registrations;
+
+    /**
+     * @brief The id of the next registration.
+     */
+    std::uint64_t m_nextId;
+
+    /**
+     * @brief The registration, which messages are being dispatched.
      */
-    IGstDispatcherThreadClient &m_client;
+    std::shared_ptr<Registration> m_dispatchedRegistration;
+
+    /**
+     * @brief Thread for dispatching gst bus messages
+     */
+    std::thread m_dispatcherThread;
+};
 
+class GstDispatcherThread : public IGstDispatcherThread
+{
+public:
+    GstDispatcherThread(IGstDispatcherThreadClient &client, GstElement *pipeline,
+                        const std::shared_ptr<IGstWrapper> &gstWrapper);
+    ~GstDispatcherThread() override;
+
+private:
     /**
      * @brief The gstreamer wrapper object.
      */
     std::shared_ptr<IGstWrapper> m_gstWrapper;
 
     /**
-     * @brief Flag used to check, if task thread is active
+     * @brief The bus dispatcher, shared with the other pipelines.
      */
-    std::atomic<bool> m_isGstreamerDispatcherActive;
+    std::shared_ptr<GstBusDispatcher> m_dispatcher;
 
     /**
-     * @brief Thread for handling gst bus callbacks
+     * @brief The registered bus of the pipeline.
      */
-    std::thread m_gstBusDispatcherThread;
+    std::shared_ptr<GstBusDispatcher::Registration> m_registration;
 };
 } // namespace firebolt::rialto::server
 
@@ -113,6 +113,7 @@ public:
 private:
     void scheduleSourceSetupFinish() override;
     void scheduleNeedMediaData(GstAppSrc *src) override;
+    void scheduleNotifyNeedMediaData(MediaSourceType type) override;
     void scheduleEnoughData(GstAppSrc *src) override;
     void scheduleAudioUnderflow() override;
     void scheduleVideoUnderflow() override;
@@ -120,6 +121,8 @@ private:
     bool setWesterossinkSecondaryVideo() override;
     void notifyNeedMediaData(bool audioNotificationNeeded, bool videoNotificationNeeded) override;
     GstBuffer *createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const override;
+    GstBuffer *createZeroCopyBuffer(const IMediaPipeline::MediaSegment &mediaSegment,
+                                    const std::shared_ptr<IDataReader> &dataReader) const override;
     void attachAudioData() override;
     void attachVideoData() override;
     void updateAudioCaps(int32_t rate, int32_t channels) override;
@@ -149,6 +152,14 @@ private:
      */
     unsigned getGstPlayFlag(const char *nick);
 
+    /**
+     * @brief Adds the protection metadata and timestamps of the media segment to the buffer.
+     *
+     * @param[in] gstBuffer    : The buffer holding the media segment data.
+     * @param[in] mediaSegment : The media segment.
+     */
+    void addSegmentMetadata(GstBuffer *gstBuffer, const IMediaPipeline::MediaSegment &mediaSegment) const;
+
     /**
      * @brief Callback on source-setup. Called by the Gstreamer thread
      *
@@ -242,6 +242,8 @@ public:
         return gst_bus_timed_pop_filtered(bus, timeout, types);
     }
 
+    void gstBusGetPollfd(GstBus *bus, GPollFD *fd) override { gst_bus_get_pollfd(bus, fd); }
+
     void gstDebugBinToDotFileWithTs(GstBin *bin, GstDebugGraphDetails details, const gchar *file_name) override
     {
         GST_DEBUG_BIN_TO_DOT_FILE_WITH_TS(bin, details, file_name);
@@ -314,6 +316,12 @@ public:
         return gst_buffer_new_wrapped(data, size);
     }
 
+    GstBuffer *gstBufferNewWrappedFull(GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset, gsize size,
+                                       gpointer user_data, GDestroyNotify notify) const override
+    {
+        return gst_buffer_new_wrapped_full(flags, data, maxsize, offset, size, user_data, notify);
+    }
+
     GstCaps *gstCodecUtilsOpusCreateCapsFromHeader(gconstpointer data, guint size) const override
     {
 #if (GLIB_CHECK_VERSION(2, 67, 3))
@@ -20,6 +20,7 @@
 #ifndef FIREBOLT_RIALTO_SERVER_I_GST_GENERIC_PLAYER_PRIVATE_H_
 #define FIREBOLT_RIALTO_SERVER_I_GST_GENERIC_PLAYER_PRIVATE_H_
 
+#include "IDataReader.h"
 #include "IMediaPipeline.h"
 #include <gst/app/gstappsrc.h>
 #include <gst/gst.h>
@@ -47,6 +48,13 @@ public:
      */
     virtual void scheduleNeedMediaData(GstAppSrc *src) = 0;
 
+    /**
+     * @brief Schedules notify need media data task. Called by the worker thread.
+     *
+     * @param[in] type : The media source type, that needs more data.
+     */
+    virtual void scheduleNotifyNeedMediaData(MediaSourceType type) = 0;
+
     /**
      * @brief Schedules enough data task. Called by the worker thread.
      */
@@ -87,6 +95,18 @@ public:
      */
     virtual GstBuffer *createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const = 0;
 
+    /**
+     * @brief Constructs a new buffer, that wraps the media segment data in the shared memory without copying it.
+     *        The buffer holds the data reader of the shm slot, so the slot is not handed back to the client and the
+     *        partition is not unmapped until the buffer is released. Does not perform decryption.
+     *        Called by the worker thread.
+     *
+     * @param[in] mediaSegment : The media segment read from the slot.
+     * @param[in] dataReader   : The data reader of the slot.
+     */
+    virtual GstBuffer *createZeroCopyBuffer(const IMediaPipeline::MediaSegment &mediaSegment,
+                                            const std::shared_ptr<IDataReader> &dataReader) const = 0;
+
     /**
      * @brief Attach audio data. Called by the worker thread
      */
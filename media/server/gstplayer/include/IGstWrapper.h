@@ -585,6 +585,14 @@ public:
      */
     virtual GstMessage *gstBusTimedPopFiltered(GstBus *bus, GstClockTime timeout, GstMessageType types) = 0;
 
+    /**
+     * @brief Gets the file descriptor of the bus, that is readable while messages are pending on the bus.
+     *
+     * @param[in]  bus : the bus.
+     * @param[out] fd  : the poll file descriptor.
+     */
+    virtual void gstBusGetPollfd(GstBus *bus, GPollFD *fd) = 0;
+
     /**
      * @brief Gets a message fromt the bus
      *
@@ -786,6 +794,23 @@ public:
      */
     virtual GstBuffer *gstBufferNewWrapped(gpointer data, gsize size) const = 0;
 
+    /**
+     * @brief Allocates a new buffer that wraps the given memory. When the memory is freed, notify is called with
+     *        user_data. The memory is not copied.
+     *
+     * @param[in] flags     : GstMemoryFlags
+     * @param[in] data      : data to wrap
+     * @param[in] maxsize   : allocated size of data
+     * @param[in] offset    : offset in data
+     * @param[in] size      : size of valid data
+     * @param[in] user_data : user_data
+     * @param[in] notify    : called with user_data when the memory is freed
+     *
+     * @retval a new GstBuffer
+     */
+    virtual GstBuffer *gstBufferNewWrappedFull(GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset,
+                                               gsize size, gpointer user_data, GDestroyNotify notify) const = 0;
+
     /**
      * @brief Creates Opus caps from the given Opus header.
      *
@@ -21,6 +21,9 @@
 #define FIREBOLT_RIALTO_SERVER_I_WORKER_THREAD_H_
 
 #include "IPlayerTask.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace firebolt::rialto::server
@@ -38,6 +41,19 @@ public:
 class IWorkerThread
 {
 public:
+    /**
+     * @brief Metrics of the task queue.
+     */
+    struct Metrics
+    {
+        std::size_t queueDepth{0};                  /**< The number of tasks currently waiting in the queue. */
+        std::size_t maxQueueDepth{0};               /**< The highest number of tasks waiting in the queue. */
+        std::uint64_t executedTasks{0};             /**< The number of executed tasks. */
+        std::uint64_t coalescedTasks{0};            /**< The number of tasks dropped, as a newer one superseded them. */
+        std::chrono::microseconds totalWaitTime{0}; /**< The sum of the time executed tasks spent in the queue. */
+        std::chrono::microseconds maxWaitTime{0};   /**< The longest time an executed task spent in the queue. */
+    };
+
     IWorkerThread() = default;
     virtual ~IWorkerThread() = default;
     IWorkerThread(const IWorkerThread &) = delete;
@@ -57,8 +73,18 @@ public:
 
     /**
      * @brief Queues a task in the task queue.
+     *
+     * Tasks run in the order of their priority lanes and are queued in FIFO order within a lane. A task is dropped,
+     * if a newer task with the same coalescing key is queued before it starts.
      */
     virtual void enqueueTask(std::unique_ptr<IPlayerTask> &&task) = 0;
+
+    /**
+     * @brief Gets the metrics of the task queue.
+     *
+     * @retval the metrics.
+     */
+    virtual Metrics getMetrics() const = 0;
 };
 } // namespace firebolt::rialto::server
 
@@ -0,0 +1,159 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_BUFFER_TRACKER_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_BUFFER_TRACKER_H_
+
+#include "IDataReader.h"
+#include "MediaCommon.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Keeps track of the GstBuffers, that wrap the shared memory regions of a playback.
+ *
+ * Shared memory slot can't be handed back to the client until every buffer wrapping it has been released by the
+ * pipeline. Each buffer holds the data reader of its slot, so the slot (and the partition it belongs to) stays in use
+ * on the server side as long as the buffer is alive. Buffers are released from gstreamer streaming threads, so the
+ * tracker is thread safe.
+ */
+class ShmBufferTracker : public std::enable_shared_from_this<ShmBufferTracker>
+{
+public:
+    /**
+     * @brief Callback called, when the last buffer of a slot is released and the source was awaited.
+     */
+    using RegionReleasedCallback = std::function<void(MediaSourceType)>;
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] callback : Called when a slot of the deferred source becomes free.
+     */
+    explicit ShmBufferTracker(const RegionReleasedCallback &callback);
+    ~ShmBufferTracker() = default;
+
+    ShmBufferTracker(const ShmBufferTracker &) = delete;
+    ShmBufferTracker &operator=(const ShmBufferTracker &) = delete;
+    ShmBufferTracker(ShmBufferTracker &&) = delete;
+    ShmBufferTracker &operator=(ShmBufferTracker &&) = delete;
+
+    /**
+     * @brief Registers a new buffer wrapping a shared memory slot of the source.
+     *
+     * @param[in] type       : The media source type of the wrapped slot.
+     * @param[in] dataReader : The data reader of the slot. It is held until the buffer is released.
+     *
+     * @retval The user data, that has to be passed to onBufferReleased, when the buffer is freed.
+     */
+    void *trackBuffer(MediaSourceType type, const std::shared_ptr<IDataReader> &dataReader);
+
+    /**
+     * @brief GDestroyNotify compatible callback, called by gstreamer when the wrapped memory is freed.
+     *
+     * @param[in] userData : The user data returned by trackBuffer.
+     */
+    static void onBufferReleased(void *userData);
+
+    /**
+     * @brief Checks, if any slot of the source is still used and if so, requests the callback when a slot is released.
+     *
+     * @param[in] type : The media source type.
+     *
+     * @retval true if a slot is still used and the callback will be called later.
+     */
+    bool deferUntilReleased(MediaSourceType type);
+
+    /**
+     * @brief Gets the number of buffers, that still wrap the slots of the source.
+     *
+     * @param[in] type : The media source type.
+     *
+     * @retval number of buffers in use.
+     */
+    std::uint32_t getBuffersInUse(MediaSourceType type) const;
+
+    /**
+     * @brief Gets the number of slots of the source, that are still wrapped by buffers.
+     *
+     * @param[in] type : The media source type.
+     *
+     * @retval number of slots in use.
+     */
+    std::uint32_t getSlotsInUse(MediaSourceType type) const;
+
+    /**
+     * @brief Drops the callback and waits for the callbacks in progress. Buffers released afterwards only update the
+     *        counters. Must not be called from the callback.
+     */
+    void detach();
+
+private:
+    /**
+     * @brief Decrements the number of buffers in use and calls the callback, if it was requested.
+     *
+     * @param[in] type       : The media source type of the released buffer.
+     * @param[in] dataReader : The data reader of the slot, released before the callback is called.
+     */
+    void release(MediaSourceType type, std::shared_ptr<IDataReader> &&dataReader);
+
+    /**
+     * @brief The state of the shared memory slots of a source.
+     */
+    struct RegionInfo
+    {
+        std::map<const IDataReader *, std::uint32_t> buffersInSlot;
+        std::uint32_t buffersInUse{0};
+        bool releaseAwaited{false};
+    };
+
+    /**
+     * @brief Mutex protecting the tracker state.
+     */
+    mutable std::mutex m_mutex;
+
+    /**
+     * @brief Signalled when a callback in progress returns.
+     */
+    std::condition_variable m_callbacksFinished;
+
+    /**
+     * @brief The number of callbacks called outside of the lock, that haven't returned yet.
+     */
+    std::uint32_t m_callbacksInProgress{0};
+
+    /**
+     * @brief The state of the slots of each source.
+     */
+    std::map<MediaSourceType, RegionInfo> m_regions;
+
+    /**
+     * @brief The region released callback.
+     */
+    RegionReleasedCallback m_callback;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_BUFFER_TRACKER_H_
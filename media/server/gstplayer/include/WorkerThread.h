@@ -21,11 +21,14 @@
 #define FIREBOLT_RIALTO_SERVER_WORKER_THREAD_H_
 
 #include "IWorkerThread.h"
+#include "MpscQueue.h"
 #include "tasks/IPlayerTask.h"
-#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <thread>
 
 namespace firebolt::rialto::server
@@ -45,8 +48,19 @@ public:
     void stop() override;
     void join() override;
     void enqueueTask(std::unique_ptr<IPlayerTask> &&task) override;
+    Metrics getMetrics() const override;
 
 private:
+    /**
+     * @brief A task waiting in the queue.
+     */
+    struct QueuedTask
+    {
+        std::unique_ptr<IPlayerTask> task;                 /**< The task to execute. */
+        std::chrono::steady_clock::time_point enqueueTime; /**< The time the task entered the queue. */
+        std::uint64_t coalescingId{0};                     /**< The position of the task among the tasks of its key. */
+    };
+
     /**
      * @brief For handling new tasks in the worker thread.
      */
@@ -59,6 +73,25 @@ private:
      */
     std::unique_ptr<IPlayerTask> waitForTask();
 
+    /**
+     * @brief Moves the tasks pushed by the producers to their priority lanes.
+     */
+    void moveQueuedTasksToLanes();
+
+    /**
+     * @brief Appends the task to the lane of its priority and, if it has a coalescing key, supersedes the older ones.
+     *
+     * @param[in] queuedTask : The task popped from the queue.
+     */
+    void moveTaskToLane(QueuedTask &&queuedTask);
+
+    /**
+     * @brief Takes the next task to execute from the priority lanes, dropping the superseded ones.
+     *
+     * @retval the task, nullptr if the lanes are empty.
+     */
+    std::unique_ptr<IPlayerTask> takeTaskFromLanes();
+
 private:
     /**
      * @brief Flag used to check, if task thread is active
@@ -71,19 +104,49 @@ private:
     std::thread m_taskThread{};
 
     /**
-     * @brief Mutex to protect the task handling.
+     * @brief Queue to store new tasks, pushed from any thread and popped by the task thread.
+     */
+    common::MpscQueue<QueuedTask> m_taskQueue;
+
+    /**
+     * @brief The tasks popped from the queue, that wait for execution, ordered by priority. Task thread only.
+     */
+    std::map<IPlayerTask::Priority, std::deque<QueuedTask>> m_lanes;
+
+    /**
+     * @brief The id of the most recently queued task of each coalescing key. Task thread only.
+     */
+    std::map<IPlayerTask::CoalescingKey, std::uint64_t> m_latestCoalescingIds;
+
+    /**
+     * @brief The number of tasks waiting in the queue and in the lanes.
+     */
+    std::atomic<std::size_t> m_queueDepth{0};
+
+    /**
+     * @brief The highest number of waiting tasks.
+     */
+    std::atomic<std::size_t> m_maxQueueDepth{0};
+
+    /**
+     * @brief The number of executed tasks.
+     */
+    std::atomic<std::uint64_t> m_executedTasks{0};
+
+    /**
+     * @brief The number of tasks dropped, as a newer task with the same coalescing key superseded them.
      */
-    std::mutex m_taskMutex{};
+    std::atomic<std::uint64_t> m_coalescedTasks{0};
 
     /**
-     * @brief New task condition varaible.
+     * @brief The sum of the time executed tasks spent waiting, in microseconds.
      */
-    std::condition_variable m_taskCV{};
+    std::atomic<std::int64_t> m_totalWaitTimeUs{0};
 
     /**
-     * @brief Queue to store new tasks.
+     * @brief The longest time an executed task spent waiting, in microseconds.
      */
-    std::queue<std::unique_ptr<IPlayerTask>> m_taskQueue{};
+    std::atomic<std::int64_t> m_maxWaitTimeUs{0};
 };
 } // namespace firebolt::rialto::server
 
@@ -136,6 +136,17 @@ public:
      */
     virtual std::unique_ptr<IPlayerTask> createNeedData(GenericPlayerContext &context, GstAppSrc *src) const = 0;
 
+    /**
+     * @brief Creates a NotifyNeedMediaData task.
+     *
+     * @param[in] player        : The GstGenericPlayer instance
+     * @param[in] type          : The media source type, which needs new data.
+     *
+     * @retval the new NotifyNeedMediaData task instance.
+     */
+    virtual std::unique_ptr<IPlayerTask>
+    createNotifyNeedMediaData(IGstGenericPlayerPrivate &player, const firebolt::rialto::MediaSourceType &type) const = 0;
+
     /**
      * @brief Creates a Pause task.
      *
@@ -32,7 +32,42 @@ public:
     IPlayerTask &operator=(const IPlayerTask &) = delete;
     IPlayerTask &operator=(IPlayerTask &&) = delete;
 
+    /**
+     * @brief The priority lane of a task. A task runs only when the lanes of higher priority are empty.
+     */
+    enum class Priority
+    {
+        NORMAL,
+        LOW
+    };
+
+    /**
+     * @brief Key of tasks, that supersede each other. Only the most recently queued task with a key is executed.
+     */
+    enum class CoalescingKey
+    {
+        NONE,
+        SET_VOLUME,
+        SET_VIDEO_GEOMETRY,
+        REPORT_POSITION,
+        CHECK_AUDIO_UNDERFLOW
+    };
+
     virtual void execute() const = 0;
+
+    /**
+     * @brief Gets the priority lane of the task.
+     *
+     * @retval the priority, NORMAL unless overridden.
+     */
+    virtual Priority getPriority() const { return Priority::NORMAL; }
+
+    /**
+     * @brief Gets the coalescing key of the task.
+     *
+     * @retval the key, NONE unless overridden.
+     */
+    virtual CoalescingKey getCoalescingKey() const { return CoalescingKey::NONE; }
 };
 } // namespace firebolt::rialto::server
 
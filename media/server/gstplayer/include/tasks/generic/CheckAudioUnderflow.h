@@ -36,6 +36,8 @@ public:
                         IGstGenericPlayerClient *client, std::shared_ptr<IGstWrapper> gstWrapper);
     ~CheckAudioUnderflow() override = default;
     void execute() const override;
+    Priority getPriority() const override;
+    CoalescingKey getCoalescingKey() const override;
 
 private:
     GenericPlayerContext &m_context;
@@ -53,6 +53,9 @@ public:
     std::unique_ptr<IPlayerTask> createHandleBusMessage(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
                                                         GstMessage *message) const override;
     std::unique_ptr<IPlayerTask> createNeedData(GenericPlayerContext &context, GstAppSrc *src) const override;
+    std::unique_ptr<IPlayerTask>
+    createNotifyNeedMediaData(IGstGenericPlayerPrivate &player,
+                              const firebolt::rialto::MediaSourceType &type) const override;
     std::unique_ptr<IPlayerTask> createPause(IGstGenericPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createPlay(IGstGenericPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask>
@@ -35,6 +35,8 @@ public:
                    std::shared_ptr<IGstWrapper> gstWrapper);
     ~ReportPosition() override = default;
     void execute() const override;
+    Priority getPriority() const override;
+    CoalescingKey getCoalescingKey() const override;
 
 private:
     GenericPlayerContext &m_context;
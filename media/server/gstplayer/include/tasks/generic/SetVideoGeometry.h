@@ -32,6 +32,7 @@ public:
     SetVideoGeometry(GenericPlayerContext &context, IGstGenericPlayerPrivate &player, const Rectangle &rectangle);
     ~SetVideoGeometry() override;
     void execute() const override;
+    CoalescingKey getCoalescingKey() const override;
 
 private:
     GenericPlayerContext &m_context;
@@ -21,6 +21,7 @@
 #define FIREBOLT_RIALTO_SERVER_TASKS_GENERIC_SET_VOLUME_H_
 
 #include "GenericPlayerContext.h"
+#include "IGstGenericPlayerClient.h"
 #include "IGstWrapper.h"
 #include "IPlayerTask.h"
 #include <memory>
@@ -30,12 +31,15 @@ namespace firebolt::rialto::server::tasks::generic
 class SetVolume : public IPlayerTask
 {
 public:
-    SetVolume(GenericPlayerContext &context, std::shared_ptr<IGstWrapper> gstWrapper, double volume);
+    SetVolume(GenericPlayerContext &context, IGstGenericPlayerClient *client, std::shared_ptr<IGstWrapper> gstWrapper,
+              double volume);
     ~SetVolume() override;
     void execute() const override;
+    CoalescingKey getCoalescingKey() const override;
 
 private:
     GenericPlayerContext &m_context;
+    IGstGenericPlayerClient *m_gstPlayerClient;
     std::shared_ptr<IGstWrapper> m_gstWrapper;
     double m_volume;
 };
@@ -33,6 +33,7 @@ public:
     SetVolume(WebAudioPlayerContext &context, std::shared_ptr<IGstWrapper> gstWrapper, double volume);
     ~SetVolume() override;
     void execute() const override;
+    CoalescingKey getCoalescingKey() const override;
 
 private:
     WebAudioPlayerContext &m_context;
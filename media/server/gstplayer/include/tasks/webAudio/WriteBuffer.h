@@ -21,6 +21,7 @@
 #define FIREBOLT_RIALTO_SERVER_TASKS_WEBAUDIO_WRITE_BUFFER_H_
 
 #include "IGlibWrapper.h"
+#include "IGstWebAudioPlayerClient.h"
 #include "IGstWebAudioPlayerPrivate.h"
 #include "IGstWrapper.h"
 #include "IPlayerTask.h"
@@ -33,13 +34,15 @@ namespace firebolt::rialto::server::tasks::webaudio
 class WriteBuffer : public IPlayerTask
 {
 public:
-    WriteBuffer(WebAudioPlayerContext &context, std::shared_ptr<IGstWrapper> gstWrapper, uint8_t *mainPtr,
-                uint32_t mainLength, uint8_t *wrapPtr, uint32_t wrapLength);
+    WriteBuffer(WebAudioPlayerContext &context, IGstWebAudioPlayerClient *client,
+                std::shared_ptr<IGstWrapper> gstWrapper, uint8_t *mainPtr, uint32_t mainLength, uint8_t *wrapPtr,
+                uint32_t wrapLength);
     ~WriteBuffer() override;
     void execute() const override;
 
 private:
     WebAudioPlayerContext &m_context;
+    IGstWebAudioPlayerClient *m_gstPlayerClient;
     std::shared_ptr<IGstWrapper> m_gstWrapper;
     const uint8_t *m_mainPtr;
     const uint64_t m_mainLength;
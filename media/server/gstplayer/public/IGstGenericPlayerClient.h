@@ -83,7 +83,8 @@ public:
      *
      * @param[in] mediaSourceType      : The media type of source to read data from.
      *
-     * @retval True on success.
+     * @retval True if a data request is outstanding. False if none could be sent, for example because all shm
+     *         slots of the source are still used by the player.
      */
     virtual bool notifyNeedMediaData(MediaSourceType mediaSourceType) = 0;
 
@@ -140,6 +141,25 @@ public:
      * @param[in] sourceType    : The type of source that sent the message.
      */
     virtual void notifyQos(MediaSourceType mediaSourceType, const QosInfo &qosInfo) = 0;
+
+    /**
+     * @brief Notifies the client of the amount of data queued in the player for a source.
+     *
+     * Sampled together with the position, so typically every 0.25s.
+     *
+     * @param[in] mediaSourceType   : The type of source.
+     * @param[in] queuedBytes       : The number of bytes queued in the source.
+     */
+    virtual void notifyBufferLevel(MediaSourceType mediaSourceType, std::uint64_t queuedBytes) = 0;
+
+    /**
+     * @brief Notifies the client of the volume of the pipeline.
+     *
+     * Sampled together with the position and after every volume change.
+     *
+     * @param[in] volume : The linear volume of the pipeline.
+     */
+    virtual void notifyVolume(double volume) = 0;
 };
 
 }; // namespace firebolt::rialto::server
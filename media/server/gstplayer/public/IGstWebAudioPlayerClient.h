@@ -63,6 +63,15 @@ public:
      * @param[in] state : The new web audio state.
      */
     virtual void notifyState(WebAudioPlayerState state) = 0;
+
+    /**
+     * @brief Notifies the client of the amount of data queued in the player.
+     *
+     * Sampled after every buffer written to the player.
+     *
+     * @param[in] queuedBytes : The number of bytes queued in the player.
+     */
+    virtual void notifyBufferLevel(uint64_t queuedBytes) = 0;
 };
 
 }; // namespace firebolt::rialto::server
@@ -19,6 +19,9 @@
 
 #include "GstDispatcherThread.h"
 #include "RialtoServerLogging.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace firebolt::rialto::server
 {
@@ -29,83 +32,262 @@ GstDispatcherThreadFactory::createGstDispatcherThread(IGstDispatcherThreadClient
     return std::make_unique<GstDispatcherThread>(client, pipeline, gstWrapper);
 }
 
-GstDispatcherThread::GstDispatcherThread(IGstDispatcherThreadClient &client, GstElement *pipeline,
-                                         const std::shared_ptr<IGstWrapper> &gstWrapper)
-    : m_client{client}, m_gstWrapper{gstWrapper}, m_isGstreamerDispatcherActive{true}
+namespace
 {
-    RIALTO_SERVER_LOG_INFO("GstDispatcherThread is starting");
-    m_gstBusDispatcherThread = std::thread(&GstDispatcherThread::gstBusEventHandler, this, pipeline);
-}
+/**
+ * @brief The epoll data of the eventfd, that stops the dispatcher thread.
+ */
+constexpr std::uint64_t kStopEventId{0};
 
-GstDispatcherThread::~GstDispatcherThread()
+/**
+ * @brief The maximum number of events handled in one epoll_wait.
+ */
+constexpr int kMaxEvents{8};
+} // namespace
+
+std::mutex GstBusDispatcher::m_instanceMutex;
+std::weak_ptr<GstBusDispatcher> GstBusDispatcher::m_instance;
+
+std::shared_ptr<GstBusDispatcher> GstBusDispatcher::instance()
 {
-    RIALTO_SERVER_LOG_INFO("Stopping GstDispatcherThread");
-    m_isGstreamerDispatcherActive = false;
-    if (m_gstBusDispatcherThread.joinable())
+    std::unique_lock<std::mutex> lock{m_instanceMutex};
+    std::shared_ptr<GstBusDispatcher> dispatcher = m_instance.lock();
+    if (!dispatcher)
     {
-        m_gstBusDispatcherThread.join();
+        dispatcher = std::make_shared<GstBusDispatcher>();
+        m_instance = dispatcher;
     }
+    return dispatcher;
 }
 
-void GstDispatcherThread::gstBusEventHandler(GstElement *pipeline)
+GstBusDispatcher::GstBusDispatcher() : m_epollFd{-1}, m_eventFd{-1}, m_nextId{kStopEventId + 1}
 {
-    GstBus *bus = m_gstWrapper->gstPipelineGetBus(GST_PIPELINE(pipeline));
-    if (!bus)
+    RIALTO_SERVER_LOG_INFO("GstBusDispatcher is starting");
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0)
     {
-        RIALTO_SERVER_LOG_ERROR("Failed to get gst bus");
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "epoll_create1 failed");
         return;
     }
 
-    while (m_isGstreamerDispatcherActive)
+    m_eventFd = eventfd(0, EFD_CLOEXEC);
+    if (m_eventFd < 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "eventfd failed");
+        close(m_epollFd);
+        m_epollFd = -1;
+        return;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = kStopEventId;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_eventFd, &event) < 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "Failed to add eventfd to epoll");
+        close(m_eventFd);
+        close(m_epollFd);
+        m_eventFd = -1;
+        m_epollFd = -1;
+        return;
+    }
+
+    m_dispatcherThread = std::thread(&GstBusDispatcher::dispatcherThreadLoop, this);
+}
+
+GstBusDispatcher::~GstBusDispatcher()
+{
+    RIALTO_SERVER_LOG_INFO("Stopping GstBusDispatcher");
+    if (m_dispatcherThread.joinable())
+    {
+        uint64_t value{1};
+        if (write(m_eventFd, &value, sizeof(value)) != sizeof(value))
+        {
+            RIALTO_SERVER_LOG_SYS_ERROR(errno, "Failed to stop the dispatcher thread");
+        }
+
+        if (std::this_thread::get_id() != m_dispatcherThread.get_id())
+        {
+            m_dispatcherThread.join();
+        }
+        else
+        {
+            m_dispatcherThread.detach();
+        }
+    }
+
+    if (m_eventFd >= 0)
+    {
+        close(m_eventFd);
+    }
+    if (m_epollFd >= 0)
+    {
+        close(m_epollFd);
+    }
+}
+
+bool GstBusDispatcher::addBus(const std::shared_ptr<Registration> &registration)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (m_epollFd < 0)
     {
-        GstMessage *message =
-            m_gstWrapper->gstBusTimedPopFiltered(bus, 100 * GST_MSECOND,
-                                                 static_cast<GstMessageType>(GST_MESSAGE_STATE_CHANGED | GST_MESSAGE_QOS |
-                                                                             GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+        RIALTO_SERVER_LOG_ERROR("GstBusDispatcher is not running");
+        return false;
+    }
 
-        if (message)
+    registration->id = m_nextId++;
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = registration->id;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, registration->fd, &event) < 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "Failed to add bus fd %d to epoll", registration->fd);
+        return false;
+    }
+    m_registrations.emplace(registration->id, registration);
+    return true;
+}
+
+void GstBusDispatcher::removeBus(const std::shared_ptr<Registration> &registration)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    removeBusInternal(registration->id);
+    if (std::this_thread::get_id() != m_dispatcherThread.get_id())
+    {
+        m_dispatchDoneCv.wait(lock, [&]() { return m_dispatchedRegistration != registration; });
+    }
+}
+
+void GstBusDispatcher::removeBusInternal(std::uint64_t id)
+{
+    auto it = m_registrations.find(id);
+    if (it != m_registrations.end())
+    {
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_DEL, it->second->fd, nullptr) < 0)
         {
-            if (GST_MESSAGE_SRC(message) == GST_OBJECT(pipeline))
+            RIALTO_SERVER_LOG_SYS_ERROR(errno, "Failed to remove bus fd %d from epoll", it->second->fd);
+        }
+        m_registrations.erase(it);
+    }
+}
+
+void GstBusDispatcher::dispatcherThreadLoop()
+{
+    epoll_event events[kMaxEvents];
+    while (true)
+    {
+        int numOfEvents = epoll_wait(m_epollFd, events, kMaxEvents, -1);
+        if (numOfEvents < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            RIALTO_SERVER_LOG_SYS_ERROR(errno, "epoll_wait failed");
+            break;
+        }
+
+        for (int i = 0; i < numOfEvents; ++i)
+        {
+            if (kStopEventId == events[i].data.u64)
             {
-                switch (GST_MESSAGE_TYPE(message))
-                {
-                case GST_MESSAGE_STATE_CHANGED:
-                {
-                    GstState oldState, newState, pending;
-                    m_gstWrapper->gstMessageParseStateChanged(message, &oldState, &newState, &pending);
-                    switch (newState)
-                    {
-                    case GST_STATE_NULL:
-                    {
-                        m_isGstreamerDispatcherActive = false;
-                    }
-                    case GST_STATE_READY:
-                    case GST_STATE_PAUSED:
-                    case GST_STATE_PLAYING:
-                    case GST_STATE_VOID_PENDING:
-                    {
-                        break;
-                    }
-                    }
-                    break;
-                }
-                case GST_MESSAGE_ERROR:
-                {
-                    m_isGstreamerDispatcherActive = false;
-                    break;
-                }
-                default:
-                {
-                    break;
-                }
-                }
+                RIALTO_SERVER_LOG_INFO("Gstbus dispatcher exitting");
+                return;
             }
 
-            m_client.handleBusMessage(message);
+            std::unique_lock<std::mutex> lock{m_mutex};
+            auto it = m_registrations.find(events[i].data.u64);
+            if (it == m_registrations.end())
+            {
+                // The bus has been removed after the event was reported
+                continue;
+            }
+            std::shared_ptr<Registration> registration = it->second;
+            m_dispatchedRegistration = registration;
+            lock.unlock();
+
+            const bool keepDispatching = dispatchMessages(*registration);
+
+            lock.lock();
+            if (!keepDispatching)
+            {
+                removeBusInternal(registration->id);
+            }
+            m_dispatchedRegistration.reset();
+            m_dispatchDoneCv.notify_all();
         }
     }
+}
+
+bool GstBusDispatcher::dispatchMessages(const Registration &registration)
+{
+    const GstMessageType kMessageTypes{
+        static_cast<GstMessageType>(GST_MESSAGE_STATE_CHANGED | GST_MESSAGE_QOS | GST_MESSAGE_EOS | GST_MESSAGE_ERROR)};
 
-    RIALTO_SERVER_LOG_INFO("Gstbus dispatcher exitting");
-    m_gstWrapper->gstObjectUnref(bus);
+    // Messages of other types are dropped from the bus, so the poll fd is not readable when this returns
+    GstMessage *message{nullptr};
+    while ((message = registration.gstWrapper->gstBusTimedPopFiltered(registration.bus, 0, kMessageTypes)))
+    {
+        bool keepDispatching{true};
+        if (GST_MESSAGE_SRC(message) == GST_OBJECT(registration.pipeline))
+        {
+            switch (GST_MESSAGE_TYPE(message))
+            {
+            case GST_MESSAGE_STATE_CHANGED:
+            {
+                GstState oldState, newState, pending;
+                registration.gstWrapper->gstMessageParseStateChanged(message, &oldState, &newState, &pending);
+                keepDispatching = (GST_STATE_NULL != newState);
+                break;
+            }
+            case GST_MESSAGE_ERROR:
+            {
+                keepDispatching = false;
+                break;
+            }
+            default:
+            {
+                break;
+            }
+            }
+        }
+
+        registration.client.handleBusMessage(message);
+        if (!keepDispatching)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+GstDispatcherThread::GstDispatcherThread(IGstDispatcherThreadClient &client, GstElement *pipeline,
+                                         const std::shared_ptr<IGstWrapper> &gstWrapper)
+    : m_gstWrapper{gstWrapper}, m_dispatcher{GstBusDispatcher::instance()}
+{
+    GstBus *bus = m_gstWrapper->gstPipelineGetBus(GST_PIPELINE(pipeline));
+    if (!bus)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to get gst bus");
+        return;
+    }
+
+    GPollFD pollFd{};
+    m_gstWrapper->gstBusGetPollfd(bus, &pollFd);
+    m_registration = std::shared_ptr<GstBusDispatcher::Registration>(
+        new GstBusDispatcher::Registration{client, pipeline, bus, pollFd.fd, m_gstWrapper, 0});
+    if (!m_dispatcher->addBus(m_registration))
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to dispatch the gst bus messages");
+    }
+}
+
+GstDispatcherThread::~GstDispatcherThread()
+{
+    if (m_registration)
+    {
+        m_dispatcher->removeBus(m_registration);
+        m_gstWrapper->gstObjectUnref(m_registration->bus);
+    }
 }
 } // namespace firebolt::rialto::server
@@ -26,6 +26,8 @@
 #include "tasks/generic/GenericPlayerTaskFactory.h"
 #include <IMediaPipeline.h>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 
 namespace
 {
@@ -42,6 +44,17 @@ constexpr std::chrono::milliseconds kSourceSetupFinishTimeoutMs{200};
  *        whenever the session moves to another playback state.
  */
 constexpr std::chrono::milliseconds kPositionReportTimerMs{250};
+
+/**
+ * @brief Environment variable enabling GstBuffers, that wrap the shared memory instead of copying the samples.
+ */
+const char *kZeroCopyEnvVariableName{"RIALTO_ZERO_COPY_SHM"};
+
+bool isZeroCopyEnabled()
+{
+    const char *zeroCopy = getenv(kZeroCopyEnvVariableName);
+    return zeroCopy && (0 == strcmp(zeroCopy, "ON") || 0 == strcmp(zeroCopy, "1"));
+}
 } // namespace
 
 namespace firebolt::rialto::server
@@ -160,6 +173,13 @@ GstGenericPlayer::GstGenericPlayer(IGstGenericPlayerClient *client, IDecryptionS
         throw std::runtime_error("Cannot create protection metadata wrapper");
     }
 
+    if (isZeroCopyEnabled())
+    {
+        RIALTO_SERVER_LOG_INFO("Zero copy shared memory buffers enabled");
+        m_context.shmBufferTracker =
+            std::make_shared<ShmBufferTracker>([this](MediaSourceType type) { scheduleNotifyNeedMediaData(type); });
+    }
+
     // Ensure that rialtosrc has been initalised
     m_context.gstSrc->initSrc();
 
@@ -191,6 +211,12 @@ GstGenericPlayer::~GstGenericPlayer()
 {
     RIALTO_SERVER_LOG_DEBUG("GstGenericPlayer is destructed.");
 
+    if (m_context.shmBufferTracker)
+    {
+        // Buffers may outlive the player, so they must not schedule any tasks from now on
+        m_context.shmBufferTracker->detach();
+    }
+
     m_gstDispatcherThread.reset();
 
     for (const auto &signal : m_context.connectedSignals)
@@ -389,7 +415,33 @@ GstBuffer *GstGenericPlayer::createBuffer(const IMediaPipeline::MediaSegment &me
 {
     GstBuffer *gstBuffer = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.getDataLength(), nullptr);
     m_gstWrapper->gstBufferFill(gstBuffer, 0, mediaSegment.getData(), mediaSegment.getDataLength());
+    addSegmentMetadata(gstBuffer, mediaSegment);
+    return gstBuffer;
+}
 
+GstBuffer *GstGenericPlayer::createZeroCopyBuffer(const IMediaPipeline::MediaSegment &mediaSegment,
+                                                  const std::shared_ptr<IDataReader> &dataReader) const
+{
+    if (!m_context.shmBufferTracker)
+    {
+        RIALTO_SERVER_LOG_WARN("Zero copy is not enabled, copying the segment data");
+        return createBuffer(mediaSegment);
+    }
+
+    // Memory is marked as read only, so any element writing to it (for example the decryptor working in place)
+    // gets its own copy and the shared memory is never modified by the pipeline.
+    gpointer userData = m_context.shmBufferTracker->trackBuffer(mediaSegment.getType(), dataReader);
+    GstBuffer *gstBuffer =
+        m_gstWrapper->gstBufferNewWrappedFull(GST_MEMORY_FLAG_READONLY,
+                                              const_cast<gpointer>(static_cast<gconstpointer>(mediaSegment.getData())),
+                                              mediaSegment.getDataLength(), 0, mediaSegment.getDataLength(), userData,
+                                              &ShmBufferTracker::onBufferReleased);
+    addSegmentMetadata(gstBuffer, mediaSegment);
+    return gstBuffer;
+}
+
+void GstGenericPlayer::addSegmentMetadata(GstBuffer *gstBuffer, const IMediaPipeline::MediaSegment &mediaSegment) const
+{
     if (mediaSegment.isEncrypted())
     {
         GstBuffer *keyId = nullptr;
@@ -447,7 +499,6 @@ GstBuffer *GstGenericPlayer::createBuffer(const IMediaPipeline::MediaSegment &me
 
     GST_BUFFER_TIMESTAMP(gstBuffer) = mediaSegment.getTimeStamp();
     GST_BUFFER_DURATION(gstBuffer) = mediaSegment.getDuration();
-    return gstBuffer;
 }
 
 void GstGenericPlayer::notifyNeedMediaData(bool audioNotificationNeeded, bool videoNotificationNeeded)
@@ -460,6 +511,14 @@ void GstGenericPlayer::notifyNeedMediaData(bool audioNotificationNeeded, bool vi
         if (m_gstPlayerClient && m_context.audioNeedData)
         {
             m_context.audioNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::AUDIO);
+            if (!m_context.audioNeedDataPending && m_context.shmBufferTracker)
+            {
+                // All shm slots are still wrapped by buffers in the pipeline. The request is resent when a slot is
+                // released, or right away if it was released in the meantime.
+                m_context.audioNeedDataPending =
+                    m_context.shmBufferTracker->deferUntilReleased(MediaSourceType::AUDIO) ||
+                    m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::AUDIO);
+            }
         }
     }
     else if (videoNotificationNeeded)
@@ -470,6 +529,14 @@ void GstGenericPlayer::notifyNeedMediaData(bool audioNotificationNeeded, bool vi
         if (m_gstPlayerClient && m_context.videoNeedData)
         {
             m_context.videoNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::VIDEO);
+            if (!m_context.videoNeedDataPending && m_context.shmBufferTracker)
+            {
+                // All shm slots are still wrapped by buffers in the pipeline. The request is resent when a slot is
+                // released, or right away if it was released in the meantime.
+                m_context.videoNeedDataPending =
+                    m_context.shmBufferTracker->deferUntilReleased(MediaSourceType::VIDEO) ||
+                    m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::VIDEO);
+            }
         }
     }
 }
@@ -611,6 +678,14 @@ void GstGenericPlayer::scheduleNeedMediaData(GstAppSrc *src)
     }
 }
 
+void GstGenericPlayer::scheduleNotifyNeedMediaData(MediaSourceType type)
+{
+    if (m_workerThread)
+    {
+        m_workerThread->enqueueTask(m_taskFactory->createNotifyNeedMediaData(*this, type));
+    }
+}
+
 void GstGenericPlayer::scheduleEnoughData(GstAppSrc *src)
 {
     if (m_workerThread)
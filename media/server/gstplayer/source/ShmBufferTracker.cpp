@@ -0,0 +1,137 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmBufferTracker.h"
+#include "RialtoServerLogging.h"
+#include <utility>
+
+namespace
+{
+/**
+ * @brief User data attached to every wrapped buffer. Keeps the tracker and the data reader of the slot alive until
+ *        the buffer is freed.
+ */
+struct TrackedBuffer
+{
+    std::shared_ptr<firebolt::rialto::server::ShmBufferTracker> tracker;
+    firebolt::rialto::MediaSourceType type;
+    std::shared_ptr<firebolt::rialto::server::IDataReader> dataReader;
+};
+} // namespace
+
+namespace firebolt::rialto::server
+{
+ShmBufferTracker::ShmBufferTracker(const RegionReleasedCallback &callback) : m_callback{callback} {}
+
+void *ShmBufferTracker::trackBuffer(MediaSourceType type, const std::shared_ptr<IDataReader> &dataReader)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    RegionInfo &region = m_regions[type];
+    ++region.buffersInSlot[dataReader.get()];
+    ++region.buffersInUse;
+    return new TrackedBuffer{shared_from_this(), type, dataReader};
+}
+
+void ShmBufferTracker::onBufferReleased(void *userData)
+{
+    std::unique_ptr<TrackedBuffer> trackedBuffer{static_cast<TrackedBuffer *>(userData)};
+    if (trackedBuffer && trackedBuffer->tracker)
+    {
+        trackedBuffer->tracker->release(trackedBuffer->type, std::move(trackedBuffer->dataReader));
+    }
+}
+
+bool ShmBufferTracker::deferUntilReleased(MediaSourceType type)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto region = m_regions.find(type);
+    if (m_regions.end() == region || 0 == region->second.buffersInUse)
+    {
+        return false;
+    }
+    RIALTO_SERVER_LOG_DEBUG("Shm slots still used by %u buffers, waiting for release", region->second.buffersInUse);
+    region->second.releaseAwaited = true;
+    return true;
+}
+
+std::uint32_t ShmBufferTracker::getBuffersInUse(MediaSourceType type) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto region = m_regions.find(type);
+    if (m_regions.end() == region)
+    {
+        return 0;
+    }
+    return region->second.buffersInUse;
+}
+
+std::uint32_t ShmBufferTracker::getSlotsInUse(MediaSourceType type) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto region = m_regions.find(type);
+    if (m_regions.end() == region)
+    {
+        return 0;
+    }
+    return region->second.buffersInSlot.size();
+}
+
+void ShmBufferTracker::detach()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_callback = nullptr;
+    m_callbacksFinished.wait(lock, [this]() { return 0 == m_callbacksInProgress; });
+}
+
+void ShmBufferTracker::release(MediaSourceType type, std::shared_ptr<IDataReader> &&dataReader)
+{
+    RegionReleasedCallback callback;
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        RegionInfo &region = m_regions[type];
+        auto slot = region.buffersInSlot.find(dataReader.get());
+        if (region.buffersInSlot.end() == slot || 0 == region.buffersInUse)
+        {
+            RIALTO_SERVER_LOG_WARN("Released buffer, that was not tracked");
+            return;
+        }
+        --region.buffersInUse;
+        if (0 != --slot->second)
+        {
+            return;
+        }
+        region.buffersInSlot.erase(slot);
+        if (!region.releaseAwaited || !m_callback)
+        {
+            return;
+        }
+        region.releaseAwaited = false;
+        callback = m_callback;
+        ++m_callbacksInProgress;
+    }
+
+    // The slot has to be free on the server side, before the callback requests more data
+    dataReader.reset();
+    callback(type);
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    --m_callbacksInProgress;
+    m_callbacksFinished.notify_all();
+}
+} // namespace firebolt::rialto::server
@@ -19,9 +19,18 @@
 
 #include "WorkerThread.h"
 #include "RialtoServerLogging.h"
+#include <utility>
 
 namespace firebolt::rialto::server
 {
+namespace
+{
+/**
+ * @brief The number of queued tasks, that the worker thread holds without allocating queue nodes.
+ */
+constexpr std::uint32_t kTaskPoolSize{64};
+} // namespace
+
 std::unique_ptr<IWorkerThread> WorkerThreadFactory::createWorkerThread() const
 {
     std::unique_ptr<IWorkerThread> workerThread;
@@ -36,7 +45,7 @@ std::unique_ptr<IWorkerThread> WorkerThreadFactory::createWorkerThread() const
     return workerThread;
 }
 
-WorkerThread::WorkerThread()
+WorkerThread::WorkerThread() : m_taskQueue{kTaskPoolSize}
 {
     RIALTO_SERVER_LOG_INFO("Worker thread is starting");
     m_taskThread = std::thread(&WorkerThread::taskHandler, this);
@@ -48,6 +57,17 @@ WorkerThread::~WorkerThread()
     {
         m_taskThread.join();
     }
+
+    const Metrics kMetrics{getMetrics()};
+    const long long kAverageWaitTime{kMetrics.executedTasks > 0
+                                         ? static_cast<long long>(kMetrics.totalWaitTime.count() /
+                                                                  kMetrics.executedTasks)
+                                         : 0};
+    RIALTO_SERVER_LOG_INFO("Worker thread finished, executed tasks: %llu, coalesced tasks: %llu, max queue depth: %zu, "
+                           "average wait time: %lldus, max wait time: %lldus",
+                           static_cast<unsigned long long>(kMetrics.executedTasks),
+                           static_cast<unsigned long long>(kMetrics.coalescedTasks), kMetrics.maxQueueDepth,
+                           kAverageWaitTime, static_cast<long long>(kMetrics.maxWaitTime.count()));
 }
 
 void WorkerThread::stop()
@@ -69,11 +89,25 @@ void WorkerThread::join()
 
 void WorkerThread::enqueueTask(std::unique_ptr<IPlayerTask> &&task)
 {
+    const std::size_t kQueueDepth{m_queueDepth.fetch_add(1, std::memory_order_relaxed) + 1};
+    std::size_t maxQueueDepth{m_maxQueueDepth.load(std::memory_order_relaxed)};
+    while (kQueueDepth > maxQueueDepth &&
+           !m_maxQueueDepth.compare_exchange_weak(maxQueueDepth, kQueueDepth, std::memory_order_relaxed))
     {
-        std::unique_lock<std::mutex> lock(m_taskMutex);
-        m_taskQueue.push(std::move(task));
     }
-    m_taskCV.notify_one();
+    m_taskQueue.push(QueuedTask{std::move(task), std::chrono::steady_clock::now(), 0});
+}
+
+IWorkerThread::Metrics WorkerThread::getMetrics() const
+{
+    Metrics metrics;
+    metrics.queueDepth = m_queueDepth.load(std::memory_order_relaxed);
+    metrics.maxQueueDepth = m_maxQueueDepth.load(std::memory_order_relaxed);
+    metrics.executedTasks = m_executedTasks.load(std::memory_order_relaxed);
+    metrics.coalescedTasks = m_coalescedTasks.load(std::memory_order_relaxed);
+    metrics.totalWaitTime = std::chrono::microseconds{m_totalWaitTimeUs.load(std::memory_order_relaxed)};
+    metrics.maxWaitTime = std::chrono::microseconds{m_maxWaitTimeUs.load(std::memory_order_relaxed)};
+    return metrics;
 }
 
 void WorkerThread::taskHandler()
@@ -87,13 +121,72 @@ void WorkerThread::taskHandler()
 
 std::unique_ptr<IPlayerTask> WorkerThread::waitForTask()
 {
-    std::unique_lock<std::mutex> lock(m_taskMutex);
-    if (m_taskQueue.empty())
+    while (true)
+    {
+        // Tasks pushed in the meantime may have a higher priority or supersede the queued ones
+        moveQueuedTasksToLanes();
+        std::unique_ptr<IPlayerTask> task = takeTaskFromLanes();
+        if (task)
+        {
+            return task;
+        }
+        QueuedTask queuedTask;
+        if (m_taskQueue.popOrWait(queuedTask))
+        {
+            moveTaskToLane(std::move(queuedTask));
+        }
+    }
+}
+
+void WorkerThread::moveQueuedTasksToLanes()
+{
+    QueuedTask queuedTask;
+    while (m_taskQueue.tryPop(queuedTask))
     {
-        m_taskCV.wait(lock, [this] { return !m_taskQueue.empty(); });
+        moveTaskToLane(std::move(queuedTask));
+    }
+}
+
+void WorkerThread::moveTaskToLane(QueuedTask &&queuedTask)
+{
+    const IPlayerTask::CoalescingKey kCoalescingKey{queuedTask.task->getCoalescingKey()};
+    if (kCoalescingKey != IPlayerTask::CoalescingKey::NONE)
+    {
+        queuedTask.coalescingId = ++m_latestCoalescingIds[kCoalescingKey];
+    }
+    m_lanes[queuedTask.task->getPriority()].push_back(std::move(queuedTask));
+}
+
+std::unique_ptr<IPlayerTask> WorkerThread::takeTaskFromLanes()
+{
+    for (auto &lane : m_lanes)
+    {
+        while (!lane.second.empty())
+        {
+            QueuedTask queuedTask = std::move(lane.second.front());
+            lane.second.pop_front();
+            m_queueDepth.fetch_sub(1, std::memory_order_relaxed);
+
+            const IPlayerTask::CoalescingKey kCoalescingKey{queuedTask.task->getCoalescingKey()};
+            if (kCoalescingKey != IPlayerTask::CoalescingKey::NONE &&
+                queuedTask.coalescingId != m_latestCoalescingIds[kCoalescingKey])
+            {
+                m_coalescedTasks.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            const std::int64_t kWaitTimeUs{std::chrono::duration_cast<std::chrono::microseconds>(
+                                               std::chrono::steady_clock::now() - queuedTask.enqueueTime)
+                                               .count()};
+            m_totalWaitTimeUs.fetch_add(kWaitTimeUs, std::memory_order_relaxed);
+            if (kWaitTimeUs > m_maxWaitTimeUs.load(std::memory_order_relaxed))
+            {
+                m_maxWaitTimeUs.store(kWaitTimeUs, std::memory_order_relaxed);
+            }
+            m_executedTasks.fetch_add(1, std::memory_order_relaxed);
+            return std::move(queuedTask.task);
+        }
     }
-    std::unique_ptr<IPlayerTask> task = std::move(m_taskQueue.front());
-    m_taskQueue.pop();
-    return task;
+    return nullptr;
 }
 } // namespace firebolt::rialto::server
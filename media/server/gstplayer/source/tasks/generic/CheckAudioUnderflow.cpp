@@ -55,4 +55,13 @@ void CheckAudioUnderflow::execute() const
     }
 }
 
+IPlayerTask::Priority CheckAudioUnderflow::getPriority() const
+{
+    return Priority::LOW;
+}
+
+IPlayerTask::CoalescingKey CheckAudioUnderflow::getCoalescingKey() const
+{
+    return CoalescingKey::CHECK_AUDIO_UNDERFLOW;
+}
 } // namespace firebolt::rialto::server::tasks::generic
@@ -27,6 +27,7 @@
 #include "tasks/generic/FinishSetupSource.h"
 #include "tasks/generic/HandleBusMessage.h"
 #include "tasks/generic/NeedData.h"
+#include "tasks/generic/NotifyNeedMediaData.h"
 #include "tasks/generic/Pause.h"
 #include "tasks/generic/Play.h"
 #include "tasks/generic/ReadShmDataAndAttachSamples.h"
@@ -109,6 +110,13 @@ std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createNeedData(GenericPla
     return std::make_unique<tasks::generic::NeedData>(context, m_client, src);
 }
 
+std::unique_ptr<IPlayerTask>
+GenericPlayerTaskFactory::createNotifyNeedMediaData(IGstGenericPlayerPrivate &player,
+                                                    const firebolt::rialto::MediaSourceType &type) const
+{
+    return std::make_unique<tasks::generic::NotifyNeedMediaData>(player, type);
+}
+
 std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createPause(IGstGenericPlayerPrivate &player) const
 {
     return std::make_unique<tasks::generic::Pause>(player);
@@ -178,7 +186,7 @@ std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createSetVideoGeometry(Ge
 
 std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createSetVolume(GenericPlayerContext &context, double volume) const
 {
-    return std::make_unique<tasks::generic::SetVolume>(context, m_gstWrapper, volume);
+    return std::make_unique<tasks::generic::SetVolume>(context, m_client, m_gstWrapper, volume);
 }
 
 std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createShutdown(IGstGenericPlayerPrivate &player) const
@@ -48,6 +48,14 @@ void NeedData::execute() const
             if (m_gstPlayerClient && !m_context.audioNeedDataPending && !m_context.audioSourceRemoved)
             {
                 m_context.audioNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::AUDIO);
+                if (!m_context.audioNeedDataPending && m_context.shmBufferTracker)
+                {
+                    // All shm slots are still wrapped by buffers in the pipeline. The request is resent when a slot
+                    // is released, or right away if it was released in the meantime.
+                    m_context.audioNeedDataPending =
+                        m_context.shmBufferTracker->deferUntilReleased(MediaSourceType::AUDIO) ||
+                        m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::AUDIO);
+                }
             }
         }
     }
@@ -60,6 +68,14 @@ void NeedData::execute() const
             if (m_gstPlayerClient && !m_context.videoNeedDataPending)
             {
                 m_context.videoNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::VIDEO);
+                if (!m_context.videoNeedDataPending && m_context.shmBufferTracker)
+                {
+                    // All shm slots are still wrapped by buffers in the pipeline. The request is resent when a slot
+                    // is released, or right away if it was released in the meantime.
+                    m_context.videoNeedDataPending =
+                        m_context.shmBufferTracker->deferUntilReleased(MediaSourceType::VIDEO) ||
+                        m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::VIDEO);
+                }
             }
         }
     }
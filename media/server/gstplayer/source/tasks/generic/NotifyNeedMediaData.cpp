@@ -0,0 +1,42 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tasks/generic/NotifyNeedMediaData.h"
+#include "IGstGenericPlayerPrivate.h"
+#include "RialtoServerLogging.h"
+
+namespace firebolt::rialto::server::tasks::generic
+{
+NotifyNeedMediaData::NotifyNeedMediaData(IGstGenericPlayerPrivate &player, const MediaSourceType &type)
+    : m_player{player}, m_type{type}
+{
+    RIALTO_SERVER_LOG_DEBUG("Constructing NotifyNeedMediaData");
+}
+
+NotifyNeedMediaData::~NotifyNeedMediaData()
+{
+    RIALTO_SERVER_LOG_DEBUG("NotifyNeedMediaData finished");
+}
+
+void NotifyNeedMediaData::execute() const
+{
+    RIALTO_SERVER_LOG_DEBUG("Executing NotifyNeedMediaData");
+    m_player.notifyNeedMediaData(MediaSourceType::AUDIO == m_type, MediaSourceType::VIDEO == m_type);
+}
+} // namespace firebolt::rialto::server::tasks::generic
@@ -46,7 +46,8 @@ void ReadShmDataAndAttachSamples::execute() const
 
     for (const auto &mediaSegment : mediaSegments)
     {
-        GstBuffer *gstBuffer = m_player.createBuffer(*mediaSegment);
+        GstBuffer *gstBuffer = m_context.shmBufferTracker ? m_player.createZeroCopyBuffer(*mediaSegment, m_dataReader)
+                                                          : m_player.createBuffer(*mediaSegment);
         if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::VIDEO)
         {
             try
@@ -80,10 +81,11 @@ void ReadShmDataAndAttachSamples::execute() const
             m_player.attachAudioData();
         }
     }
-    // All segments in vector have the same type
-    m_player.notifyNeedMediaData((!mediaSegments.empty() &&
-                                  mediaSegments.front()->getType() == firebolt::rialto::MediaSourceType::AUDIO),
-                                 (!mediaSegments.empty() &&
-                                  mediaSegments.front()->getType() == firebolt::rialto::MediaSourceType::VIDEO));
+    if (!mediaSegments.empty())
+    {
+        // The shm slot stays busy while this task holds its data reader, so more data is requested from a separate
+        // task, that runs after this one is destroyed. All segments in vector have the same type.
+        m_player.scheduleNotifyNeedMediaData(mediaSegments.front()->getType());
+    }
 }
 } // namespace firebolt::rialto::server::tasks::generic
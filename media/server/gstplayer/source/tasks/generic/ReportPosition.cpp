@@ -42,5 +42,27 @@ void ReportPosition::execute() const
             m_gstPlayerClient->notifyPosition(position);
         }
     }
+    if (m_gstPlayerClient)
+    {
+        for (const auto &streamInfo : m_context.streamInfo)
+        {
+            const guint64 kQueuedBytes{m_gstWrapper->gstAppSrcGetCurrentLevelBytes(GST_APP_SRC(streamInfo.second))};
+            m_gstPlayerClient->notifyBufferLevel(streamInfo.first, kQueuedBytes);
+        }
+        const gdouble kVolume{m_gstWrapper->gstStreamVolumeGetVolume(GST_STREAM_VOLUME(m_context.pipeline),
+                                                                     GST_STREAM_VOLUME_FORMAT_LINEAR)};
+        m_gstPlayerClient->notifyVolume(kVolume);
+    }
+}
+
+IPlayerTask::Priority ReportPosition::getPriority() const
+{
+    // Periodic housekeeping must not delay the state changes queued after it
+    return Priority::LOW;
+}
+
+IPlayerTask::CoalescingKey ReportPosition::getCoalescingKey() const
+{
+    return CoalescingKey::REPORT_POSITION;
 }
 } // namespace firebolt::rialto::server::tasks::generic
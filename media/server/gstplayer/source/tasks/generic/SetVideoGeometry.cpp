@@ -44,4 +44,9 @@ void SetVideoGeometry::execute() const
         m_player.setWesterossinkRectangle();
     }
 }
+
+IPlayerTask::CoalescingKey SetVideoGeometry::getCoalescingKey() const
+{
+    return CoalescingKey::SET_VIDEO_GEOMETRY;
+}
 } // namespace firebolt::rialto::server::tasks::generic
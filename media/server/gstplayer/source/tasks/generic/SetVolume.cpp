@@ -23,8 +23,9 @@
 
 namespace firebolt::rialto::server::tasks::generic
 {
-SetVolume::SetVolume(GenericPlayerContext &context, std::shared_ptr<IGstWrapper> gstWrapper, double volume)
-    : m_context{context}, m_gstWrapper{gstWrapper}, m_volume{volume}
+SetVolume::SetVolume(GenericPlayerContext &context, IGstGenericPlayerClient *client,
+                     std::shared_ptr<IGstWrapper> gstWrapper, double volume)
+    : m_context{context}, m_gstPlayerClient{client}, m_gstWrapper{gstWrapper}, m_volume{volume}
 {
     RIALTO_SERVER_LOG_DEBUG("Constructing SetVolume");
 }
@@ -44,5 +45,14 @@ void SetVolume::execute() const
     }
     m_gstWrapper->gstStreamVolumeSetVolume(GST_STREAM_VOLUME(m_context.pipeline), GST_STREAM_VOLUME_FORMAT_LINEAR,
                                            m_volume);
+    if (m_gstPlayerClient)
+    {
+        m_gstPlayerClient->notifyVolume(m_volume);
+    }
+}
+
+IPlayerTask::CoalescingKey SetVolume::getCoalescingKey() const
+{
+    return CoalescingKey::SET_VOLUME;
 }
 } // namespace firebolt::rialto::server::tasks::generic
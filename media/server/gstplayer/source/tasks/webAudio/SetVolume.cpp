@@ -40,4 +40,9 @@ void SetVolume::execute() const
     m_gstWrapper->gstStreamVolumeSetVolume(GST_STREAM_VOLUME(m_context.pipeline), GST_STREAM_VOLUME_FORMAT_LINEAR,
                                            m_volume);
 }
+
+IPlayerTask::CoalescingKey SetVolume::getCoalescingKey() const
+{
+    return CoalescingKey::SET_VOLUME;
+}
 } // namespace firebolt::rialto::server::tasks::webaudio
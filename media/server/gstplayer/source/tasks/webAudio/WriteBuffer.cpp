@@ -25,10 +25,11 @@
 
 namespace firebolt::rialto::server::tasks::webaudio
 {
-WriteBuffer::WriteBuffer(WebAudioPlayerContext &context, std::shared_ptr<IGstWrapper> gstWrapper, uint8_t *mainPtr,
-                         uint32_t mainLength, uint8_t *wrapPtr, uint32_t wrapLength)
-    : m_context{context}, m_gstWrapper{gstWrapper}, m_mainPtr{mainPtr}, m_mainLength{mainLength}, m_wrapPtr{wrapPtr},
-      m_wrapLength{wrapLength}
+WriteBuffer::WriteBuffer(WebAudioPlayerContext &context, IGstWebAudioPlayerClient *client,
+                         std::shared_ptr<IGstWrapper> gstWrapper, uint8_t *mainPtr, uint32_t mainLength,
+                         uint8_t *wrapPtr, uint32_t wrapLength)
+    : m_context{context}, m_gstPlayerClient{client}, m_gstWrapper{gstWrapper}, m_mainPtr{mainPtr},
+      m_mainLength{mainLength}, m_wrapPtr{wrapPtr}, m_wrapLength{wrapLength}
 {
     RIALTO_SERVER_LOG_DEBUG("Constructing WriteBuffer");
 }
@@ -42,7 +43,8 @@ void WriteBuffer::execute() const
 {
     RIALTO_SERVER_LOG_DEBUG("Executing WriteBuffer");
 
-    uint64_t freeBytes = kMaxWebAudioBytes - m_gstWrapper->gstAppSrcGetCurrentLevelBytes(GST_APP_SRC(m_context.source));
+    uint64_t queuedBytes = m_gstWrapper->gstAppSrcGetCurrentLevelBytes(GST_APP_SRC(m_context.source));
+    uint64_t freeBytes = kMaxWebAudioBytes - queuedBytes;
     uint64_t bytesToWrite = std::min(freeBytes, m_mainLength + m_wrapLength);
     uint64_t bytesWritten = 0;
 
@@ -82,6 +84,12 @@ void WriteBuffer::execute() const
         RIALTO_SERVER_LOG_ERROR("Failed to create the gst buffer");
     }
 
+    if (m_gstPlayerClient)
+    {
+        // The app source level sampled before the push, plus what has just been pushed
+        m_gstPlayerClient->notifyBufferLevel(queuedBytes + bytesWritten);
+    }
+
     {
         std::unique_lock<std::mutex> lock(m_context.m_writeBufferMutex);
         m_context.m_lastBytesWritten = bytesWritten;
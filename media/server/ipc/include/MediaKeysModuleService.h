@@ -22,8 +22,10 @@
 
 #include "ICdmService.h"
 #include "IMediaKeysModuleService.h"
+#include "SessionExecutors.h"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 
 namespace firebolt::rialto::server::ipc
@@ -40,7 +42,8 @@ public:
 class MediaKeysModuleService : public IMediaKeysModuleService
 {
 public:
-    explicit MediaKeysModuleService(service::ICdmService &cdmService);
+    MediaKeysModuleService(service::ICdmService &cdmService,
+                           const std::shared_ptr<IMainThreadFactory> &mainThreadFactory);
     ~MediaKeysModuleService() override;
 
     void clientConnected(const std::shared_ptr<::firebolt::rialto::ipc::IClient> &ipcClient) override;
@@ -114,6 +117,8 @@ public:
 private:
     service::ICdmService &m_cdmService;
     std::map<std::shared_ptr<::firebolt::rialto::ipc::IClient>, std::set<int>> m_clientMediaKeysHandles;
+    std::mutex m_clientMediaKeysHandlesMutex;
+    SessionExecutors m_sessionExecutors;
 };
 } // namespace firebolt::rialto::server::ipc
 
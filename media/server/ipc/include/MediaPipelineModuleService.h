@@ -23,8 +23,10 @@
 #include "IMediaPipelineClient.h"
 #include "IMediaPipelineModuleService.h"
 #include "IMediaPipelineService.h"
+#include "SessionExecutors.h"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 
 namespace firebolt::rialto::server::ipc
@@ -41,7 +43,8 @@ public:
 class MediaPipelineModuleService : public IMediaPipelineModuleService
 {
 public:
-    explicit MediaPipelineModuleService(service::IMediaPipelineService &mediaPipelineService);
+    MediaPipelineModuleService(service::IMediaPipelineService &mediaPipelineService,
+                               const std::shared_ptr<IMainThreadFactory> &mainThreadFactory);
     ~MediaPipelineModuleService() override;
 
     void clientConnected(const std::shared_ptr<::firebolt::rialto::ipc::IClient> &ipcClient) override;
@@ -74,6 +77,9 @@ public:
                      ::firebolt::rialto::SetPositionResponse *response, ::google::protobuf::Closure *done) override;
     void haveData(::google::protobuf::RpcController *controller, const ::firebolt::rialto::HaveDataRequest *request,
                   ::firebolt::rialto::HaveDataResponse *response, ::google::protobuf::Closure *done) override;
+    void haveDataNoReply(::google::protobuf::RpcController *controller,
+                         const ::firebolt::rialto::HaveDataRequest *request,
+                         ::firebolt::rialto::HaveDataResponse *response, ::google::protobuf::Closure *done) override;
     void setPlaybackRate(::google::protobuf::RpcController *controller,
                          const ::firebolt::rialto::SetPlaybackRateRequest *request,
                          ::firebolt::rialto::SetPlaybackRateResponse *response,
@@ -90,6 +96,8 @@ public:
 private:
     service::IMediaPipelineService &m_mediaPipelineService;
     std::map<std::shared_ptr<::firebolt::rialto::ipc::IClient>, std::set<int>> m_clientSessions;
+    std::mutex m_clientSessionsMutex;
+    SessionExecutors m_sessionExecutors;
 };
 } // namespace firebolt::rialto::server::ipc
 
@@ -0,0 +1,115 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_IPC_SESSION_EXECUTORS_H_
+#define FIREBOLT_RIALTO_SERVER_IPC_SESSION_EXECUTORS_H_
+
+#include "IMainThread.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace firebolt::rialto::server::ipc
+{
+/**
+ * @brief Executors of the sessions created by a module service.
+ *
+ * Each session gets its own strand on the main thread. The module service handlers post the work of a request to
+ * the strand of the session and complete the request closure from there, so the IPC threads never wait for media or
+ * DRM operations. The session objects are created by a task on their strand, so the main thread clients they register
+ * share it and execute their own tasks in place.
+ */
+class SessionExecutors
+{
+public:
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] mainThreadFactory : The main thread factory.
+     */
+    explicit SessionExecutors(const std::shared_ptr<IMainThreadFactory> &mainThreadFactory);
+
+    /**
+     * @brief The destructor.
+     */
+    ~SessionExecutors();
+
+    SessionExecutors(const SessionExecutors &) = delete;
+    SessionExecutors(SessionExecutors &&) = delete;
+    SessionExecutors &operator=(const SessionExecutors &) = delete;
+    SessionExecutors &operator=(SessionExecutors &&) = delete;
+
+    /**
+     * @brief Creates the executor of a session and enqueues the task, that creates the session, on it.
+     *
+     * @param[in] handle : The handle of the session.
+     * @param[in] task   : The task to execute.
+     */
+    void create(int handle, IMainThread::Task &&task);
+
+    /**
+     * @brief Enqueues the task on the executor of a session.
+     *
+     * Executes the task on the calling thread, if the session has no executor.
+     *
+     * @param[in] handle : The handle of the session.
+     * @param[in] task   : The task to execute.
+     */
+    void execute(int handle, IMainThread::Task &&task);
+
+    /**
+     * @brief Enqueues the last task of a session and releases its executor, once the task is done.
+     *
+     * Executes the task on the calling thread, if the session has no executor.
+     *
+     * @param[in] handle : The handle of the session.
+     * @param[in] task   : The task to execute.
+     */
+    void destroy(int handle, IMainThread::Task &&task);
+
+    /**
+     * @brief Enqueues the last task of a session, waits for it and releases the executor of the session.
+     *
+     * Executes the task on the calling thread, if the session has no executor.
+     *
+     * @param[in] handle : The handle of the session.
+     * @param[in] task   : The task to execute.
+     */
+    void destroyAndWait(int handle, IMainThread::Task &&task);
+
+private:
+    /**
+     * @brief The main thread, that the executors are strands of.
+     */
+    std::shared_ptr<IMainThread> m_mainThread;
+
+    /**
+     * @brief Mutex protecting the executors.
+     */
+    std::mutex m_executorsMutex;
+
+    /**
+     * @brief The main thread client ids of the executors, by session handle.
+     */
+    std::map<int, uint32_t> m_executors;
+};
+} // namespace firebolt::rialto::server::ipc
+
+#endif // FIREBOLT_RIALTO_SERVER_IPC_SESSION_EXECUTORS_H_
@@ -23,6 +23,7 @@
 #include "RialtoServerLogging.h"
 #include <IIpcServer.h>
 #include <memory>
+#include <mutex>
 #include <set>
 
 namespace firebolt::rialto::server::ipc
@@ -44,6 +45,7 @@ public:
 
 private:
     std::set<std::shared_ptr<::firebolt::rialto::ipc::IClient>> m_connectedClients;
+    std::mutex m_connectedClientsMutex;
 };
 } // namespace firebolt::rialto::server::ipc
 
@@ -23,8 +23,10 @@
 #include "IWebAudioPlayerClient.h"
 #include "IWebAudioPlayerModuleService.h"
 #include "IWebAudioPlayerService.h"
+#include "SessionExecutors.h"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 
 namespace firebolt::rialto::server::ipc
@@ -42,7 +44,8 @@ public:
 class WebAudioPlayerModuleService : public IWebAudioPlayerModuleService
 {
 public:
-    explicit WebAudioPlayerModuleService(service::IWebAudioPlayerService &webAudioPlayerService);
+    WebAudioPlayerModuleService(service::IWebAudioPlayerService &webAudioPlayerService,
+                                const std::shared_ptr<IMainThreadFactory> &mainThreadFactory);
     ~WebAudioPlayerModuleService() override;
 
     void clientConnected(const std::shared_ptr<::firebolt::rialto::ipc::IClient> &ipcClient) override;
@@ -88,6 +91,8 @@ public:
 private:
     service::IWebAudioPlayerService &m_webAudioPlayerService;
     std::map<std::shared_ptr<::firebolt::rialto::ipc::IClient>, std::set<int>> m_clientWebAudioPlayerHandles;
+    std::mutex m_clientWebAudioPlayerHandlesMutex;
+    SessionExecutors m_sessionExecutors;
 };
 } // namespace firebolt::rialto::server::ipc
 
@@ -23,13 +23,14 @@
 #include "RialtoServerLogging.h"
 #include <IIpcController.h>
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 
 namespace
 {
 int generateHandle()
 {
-    static int mediaKeysHandle{0};
+    static std::atomic<int> mediaKeysHandle{0};
     return mediaKeysHandle++;
 }
 
@@ -118,7 +119,7 @@ std::shared_ptr<IMediaKeysModuleService> MediaKeysModuleServiceFactory::create(s
 
     try
     {
-        mediaKeysModule = std::make_shared<MediaKeysModuleService>(cdmService);
+        mediaKeysModule = std::make_shared<MediaKeysModuleService>(cdmService, IMainThreadFactory::createFactory());
     }
     catch (const std::exception &e)
     {
@@ -128,7 +129,11 @@ std::shared_ptr<IMediaKeysModuleService> MediaKeysModuleServiceFactory::create(s
     return mediaKeysModule;
 }
 
-MediaKeysModuleService::MediaKeysModuleService(service::ICdmService &cdmService) : m_cdmService{cdmService} {}
+MediaKeysModuleService::MediaKeysModuleService(service::ICdmService &cdmService,
+                                               const std::shared_ptr<IMainThreadFactory> &mainThreadFactory)
+    : m_cdmService{cdmService}, m_sessionExecutors{mainThreadFactory}
+{
+}
 
 MediaKeysModuleService::~MediaKeysModuleService() {}
 
@@ -136,6 +141,7 @@ void MediaKeysModuleService::clientConnected(const std::shared_ptr<::firebolt::r
 {
     RIALTO_SERVER_LOG_INFO("Client Connected!");
     {
+        std::lock_guard<std::mutex> lock{m_clientMediaKeysHandlesMutex};
         m_clientMediaKeysHandles.emplace(ipcClient, std::set<int>());
     }
     ipcClient->exportService(shared_from_this());
@@ -146,6 +152,7 @@ void MediaKeysModuleService::clientDisconnected(const std::shared_ptr<::firebolt
     RIALTO_SERVER_LOG_INFO("Client disconnected!");
     std::set<int> mediaKeysHandles;
     {
+        std::lock_guard<std::mutex> lock{m_clientMediaKeysHandlesMutex};
         auto handleIter = m_clientMediaKeysHandles.find(ipcClient);
         if (handleIter == m_clientMediaKeysHandles.end())
         {
@@ -157,7 +164,8 @@ void MediaKeysModuleService::clientDisconnected(const std::shared_ptr<::firebolt
     }
     for (const auto &mediaKeysHandle : mediaKeysHandles)
     {
-        m_cdmService.destroyMediaKeys(mediaKeysHandle);
+        m_sessionExecutors.destroyAndWait(mediaKeysHandle, [this, mediaKeysHandle]()
+                                          { m_cdmService.destroyMediaKeys(mediaKeysHandle); });
     }
 }
 
@@ -176,19 +184,28 @@ void MediaKeysModuleService::createMediaKeys(::google::protobuf::RpcController *
         return;
     }
     int mediaKeysHandle = generateHandle();
-    bool mediaKeysCreated = m_cdmService.createMediaKeys(mediaKeysHandle, request->key_system());
-    if (mediaKeysCreated)
-    {
-        // Assume that IPC library works well and client is present
-        m_clientMediaKeysHandles[ipcController->getClient()].insert(mediaKeysHandle);
-        response->set_media_keys_handle(mediaKeysHandle);
-    }
-    else
+    auto task = [this, controller, ipcController, response, done, mediaKeysHandle, keySystem = request->key_system()]()
     {
-        RIALTO_SERVER_LOG_ERROR("Create media keys failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        bool mediaKeysCreated = m_cdmService.createMediaKeys(mediaKeysHandle, keySystem);
+        if (mediaKeysCreated)
+        {
+            // Assume that IPC library works well and client is present
+            {
+                std::lock_guard<std::mutex> lock{m_clientMediaKeysHandlesMutex};
+                m_clientMediaKeysHandles[ipcController->getClient()].insert(mediaKeysHandle);
+            }
+            response->set_media_keys_handle(mediaKeysHandle);
+        }
+        else
+        {
+            RIALTO_SERVER_LOG_ERROR("Create media keys failed");
+            controller->SetFailed("Operation failed");
+            m_sessionExecutors.destroy(mediaKeysHandle, []() {});
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.create(mediaKeysHandle, std::move(task));
 }
 
 void MediaKeysModuleService::destroyMediaKeys(::google::protobuf::RpcController *controller,
@@ -205,19 +222,28 @@ void MediaKeysModuleService::destroyMediaKeys(::google::protobuf::RpcController
         done->Run();
         return;
     }
-    if (!m_cdmService.destroyMediaKeys(request->media_keys_handle()))
+    int mediaKeysHandle = request->media_keys_handle();
+    auto task = [this, controller, ipcController, done, mediaKeysHandle]()
     {
-        RIALTO_SERVER_LOG_ERROR("Destroy session failed");
-        controller->SetFailed("Operation failed");
+        if (!m_cdmService.destroyMediaKeys(mediaKeysHandle))
+        {
+            RIALTO_SERVER_LOG_ERROR("Destroy session failed");
+            controller->SetFailed("Operation failed");
+            done->Run();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{m_clientMediaKeysHandlesMutex};
+            auto handleIter = m_clientMediaKeysHandles.find(ipcController->getClient());
+            if (handleIter != m_clientMediaKeysHandles.end())
+            {
+                handleIter->second.erase(mediaKeysHandle);
+            }
+        }
         done->Run();
-        return;
-    }
-    auto handleIter = m_clientMediaKeysHandles.find(ipcController->getClient());
-    if (handleIter != m_clientMediaKeysHandles.end())
-    {
-        handleIter->second.erase(request->media_keys_handle());
-    }
-    done->Run();
+    };
+
+    m_sessionExecutors.destroy(mediaKeysHandle, std::move(task));
 }
 
 void MediaKeysModuleService::selectKeyId(::google::protobuf::RpcController *controller,
@@ -238,10 +264,16 @@ void MediaKeysModuleService::containsKey(::google::protobuf::RpcController *cont
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    bool result = m_cdmService.containsKey(request->media_keys_handle(), request->key_session_id(),
-                                           std::vector<std::uint8_t>{request->key_id().begin(), request->key_id().end()});
-    response->set_contains_key(result);
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        bool result =
+            m_cdmService.containsKey(request.media_keys_handle(), request.key_session_id(),
+                                     std::vector<std::uint8_t>{request.key_id().begin(), request.key_id().end()});
+        response->set_contains_key(result);
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::createKeySession(::google::protobuf::RpcController *controller,
@@ -259,18 +291,23 @@ void MediaKeysModuleService::createKeySession(::google::protobuf::RpcController
         return;
     }
 
-    int32_t keySessionId;
-    MediaKeyErrorStatus status =
-        m_cdmService.createKeySession(request->media_keys_handle(), convertKeySessionType(request->session_type()),
-                                      std::make_shared<MediaKeysClient>(request->media_keys_handle(),
-                                                                        ipcController->getClient()),
-                                      request->is_ldl(), keySessionId);
-    if (MediaKeyErrorStatus::OK == status)
+    std::shared_ptr<::firebolt::rialto::ipc::IClient> ipcClient = ipcController->getClient();
+    auto task = [this, response, done, request = *request, ipcClient]()
     {
-        response->set_key_session_id(keySessionId);
-    }
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+        int32_t keySessionId;
+        MediaKeyErrorStatus status =
+            m_cdmService.createKeySession(request.media_keys_handle(), convertKeySessionType(request.session_type()),
+                                          std::make_shared<MediaKeysClient>(request.media_keys_handle(), ipcClient),
+                                          request.is_ldl(), keySessionId);
+        if (MediaKeyErrorStatus::OK == status)
+        {
+            response->set_key_session_id(keySessionId);
+        }
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::generateRequest(::google::protobuf::RpcController *controller,
@@ -280,12 +317,18 @@ void MediaKeysModuleService::generateRequest(::google::protobuf::RpcController *
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.generateRequest(request->media_keys_handle(), request->key_session_id(),
-                                                              covertInitDataType(request->init_data_type()),
-                                                              std::vector<std::uint8_t>{request->init_data().begin(),
-                                                                                        request->init_data().end()});
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status =
+            m_cdmService.generateRequest(request.media_keys_handle(), request.key_session_id(),
+                                         covertInitDataType(request.init_data_type()),
+                                         std::vector<std::uint8_t>{request.init_data().begin(),
+                                                                   request.init_data().end()});
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::loadSession(::google::protobuf::RpcController *controller,
@@ -295,9 +338,14 @@ void MediaKeysModuleService::loadSession(::google::protobuf::RpcController *cont
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.loadSession(request->media_keys_handle(), request->key_session_id());
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status = m_cdmService.loadSession(request.media_keys_handle(), request.key_session_id());
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::updateSession(::google::protobuf::RpcController *controller,
@@ -307,11 +355,17 @@ void MediaKeysModuleService::updateSession(::google::protobuf::RpcController *co
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.updateSession(request->media_keys_handle(), request->key_session_id(),
-                                                            std::vector<std::uint8_t>{request->response_data().begin(),
-                                                                                      request->response_data().end()});
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status =
+            m_cdmService.updateSession(request.media_keys_handle(), request.key_session_id(),
+                                       std::vector<std::uint8_t>{request.response_data().begin(),
+                                                                 request.response_data().end()});
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::setDrmHeader(::google::protobuf::RpcController *controller,
@@ -321,11 +375,17 @@ void MediaKeysModuleService::setDrmHeader(::google::protobuf::RpcController *con
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.setDrmHeader(request->media_keys_handle(), request->key_session_id(),
-                                                           std::vector<std::uint8_t>{request->request_data().begin(),
-                                                                                     request->request_data().end()});
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status =
+            m_cdmService.setDrmHeader(request.media_keys_handle(), request.key_session_id(),
+                                      std::vector<std::uint8_t>{request.request_data().begin(),
+                                                                request.request_data().end()});
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::closeKeySession(::google::protobuf::RpcController *controller,
@@ -335,9 +395,15 @@ void MediaKeysModuleService::closeKeySession(::google::protobuf::RpcController *
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.closeKeySession(request->media_keys_handle(), request->key_session_id());
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status =
+            m_cdmService.closeKeySession(request.media_keys_handle(), request.key_session_id());
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::removeKeySession(::google::protobuf::RpcController *controller,
@@ -347,9 +413,15 @@ void MediaKeysModuleService::removeKeySession(::google::protobuf::RpcController
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.removeKeySession(request->media_keys_handle(), request->key_session_id());
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status =
+            m_cdmService.removeKeySession(request.media_keys_handle(), request.key_session_id());
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::deleteDrmStore(::google::protobuf::RpcController *controller,
@@ -359,9 +431,14 @@ void MediaKeysModuleService::deleteDrmStore(::google::protobuf::RpcController *c
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.deleteDrmStore(request->media_keys_handle());
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status = m_cdmService.deleteDrmStore(request.media_keys_handle());
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::deleteKeyStore(::google::protobuf::RpcController *controller,
@@ -371,9 +448,14 @@ void MediaKeysModuleService::deleteKeyStore(::google::protobuf::RpcController *c
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.deleteKeyStore(request->media_keys_handle());
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        MediaKeyErrorStatus status = m_cdmService.deleteKeyStore(request.media_keys_handle());
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::getDrmStoreHash(::google::protobuf::RpcController *controller,
@@ -381,16 +463,21 @@ void MediaKeysModuleService::getDrmStoreHash(::google::protobuf::RpcController *
                                              ::firebolt::rialto::GetDrmStoreHashResponse *response,
                                              ::google::protobuf::Closure *done)
 {
-    std::vector<unsigned char> drmStoreHash;
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.getDrmStoreHash(request->media_keys_handle(), drmStoreHash);
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    for (const auto &item : drmStoreHash)
+    auto task = [this, response, done, request = *request]()
     {
-        response->add_drm_store_hash(item);
-    }
-    done->Run();
+        std::vector<unsigned char> drmStoreHash;
+        MediaKeyErrorStatus status = m_cdmService.getDrmStoreHash(request.media_keys_handle(), drmStoreHash);
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        for (const auto &item : drmStoreHash)
+        {
+            response->add_drm_store_hash(item);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::getKeyStoreHash(::google::protobuf::RpcController *controller,
@@ -398,16 +485,21 @@ void MediaKeysModuleService::getKeyStoreHash(::google::protobuf::RpcController *
                                              ::firebolt::rialto::GetKeyStoreHashResponse *response,
                                              ::google::protobuf::Closure *done)
 {
-    std::vector<unsigned char> keyStoreHash;
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.getKeyStoreHash(request->media_keys_handle(), keyStoreHash);
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    for (const auto &item : keyStoreHash)
+    auto task = [this, response, done, request = *request]()
     {
-        response->add_key_store_hash(item);
-    }
-    done->Run();
+        std::vector<unsigned char> keyStoreHash;
+        MediaKeyErrorStatus status = m_cdmService.getKeyStoreHash(request.media_keys_handle(), keyStoreHash);
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        for (const auto &item : keyStoreHash)
+        {
+            response->add_key_store_hash(item);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::getLdlSessionsLimit(::google::protobuf::RpcController *controller,
@@ -415,13 +507,18 @@ void MediaKeysModuleService::getLdlSessionsLimit(::google::protobuf::RpcControll
                                                  ::firebolt::rialto::GetLdlSessionsLimitResponse *response,
                                                  ::google::protobuf::Closure *done)
 {
-    uint32_t ldlLimit{0};
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.getLdlSessionsLimit(request->media_keys_handle(), ldlLimit);
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    response->set_ldl_limit(ldlLimit);
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        uint32_t ldlLimit{0};
+        MediaKeyErrorStatus status = m_cdmService.getLdlSessionsLimit(request.media_keys_handle(), ldlLimit);
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        response->set_ldl_limit(ldlLimit);
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::getLastDrmError(::google::protobuf::RpcController *controller,
@@ -429,14 +526,19 @@ void MediaKeysModuleService::getLastDrmError(::google::protobuf::RpcController *
                                              ::firebolt::rialto::GetLastDrmErrorResponse *response,
                                              ::google::protobuf::Closure *done)
 {
-    uint32_t errorCode{0};
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status =
-        m_cdmService.getLastDrmError(request->media_keys_handle(), request->key_session_id(), errorCode);
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    response->set_error_code(errorCode);
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        uint32_t errorCode{0};
+        MediaKeyErrorStatus status =
+            m_cdmService.getLastDrmError(request.media_keys_handle(), request.key_session_id(), errorCode);
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        response->set_error_code(errorCode);
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::getDrmTime(::google::protobuf::RpcController *controller,
@@ -444,13 +546,18 @@ void MediaKeysModuleService::getDrmTime(::google::protobuf::RpcController *contr
                                         ::firebolt::rialto::GetDrmTimeResponse *response,
                                         ::google::protobuf::Closure *done)
 {
-    uint64_t drmTime{0};
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status = m_cdmService.getDrmTime(request->media_keys_handle(), drmTime);
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    response->set_drm_time(drmTime);
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        uint64_t drmTime{0};
+        MediaKeyErrorStatus status = m_cdmService.getDrmTime(request.media_keys_handle(), drmTime);
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        response->set_drm_time(drmTime);
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 void MediaKeysModuleService::getCdmKeySessionId(::google::protobuf::RpcController *controller,
@@ -460,12 +567,17 @@ void MediaKeysModuleService::getCdmKeySessionId(::google::protobuf::RpcControlle
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    std::string cdmKeySessionId;
-    MediaKeyErrorStatus status =
-        m_cdmService.getCdmKeySessionId(request->media_keys_handle(), request->key_session_id(), cdmKeySessionId);
-    response->set_error_status(convertMediaKeyErrorStatus(status));
-    response->set_cdm_key_session_id(cdmKeySessionId);
-    done->Run();
+    auto task = [this, response, done, request = *request]()
+    {
+        std::string cdmKeySessionId;
+        MediaKeyErrorStatus status =
+            m_cdmService.getCdmKeySessionId(request.media_keys_handle(), request.key_session_id(), cdmKeySessionId);
+        response->set_error_status(convertMediaKeyErrorStatus(status));
+        response->set_cdm_key_session_id(cdmKeySessionId);
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->media_keys_handle(), std::move(task));
 }
 
 } // namespace firebolt::rialto::server::ipc
@@ -191,6 +191,7 @@ void MediaPipelineClient::notifyNeedMediaData(int32_t sourceId, size_t frameCoun
     event->mutable_shm_info()->set_metadata_offset(shmInfo->metadataOffset);
     event->mutable_shm_info()->set_media_data_offset(shmInfo->mediaDataOffset);
     event->mutable_shm_info()->set_max_media_bytes(shmInfo->maxMediaBytes);
+    event->mutable_shm_info()->set_max_metadata_version(shmInfo->maxMetadataVersion);
 
     m_ipcClient->sendEvent(event);
 }
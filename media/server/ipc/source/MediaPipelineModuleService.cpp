@@ -24,13 +24,14 @@
 #include "RialtoServerLogging.h"
 #include <IIpcController.h>
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 
 namespace
 {
 int generateSessionId()
 {
-    static int sessionId{0};
+    static std::atomic<int> sessionId{0};
     return sessionId++;
 }
 
@@ -177,7 +178,8 @@ MediaPipelineModuleServiceFactory::create(service::IMediaPipelineService &mediaP
 
     try
     {
-        mediaPipelineModule = std::make_shared<MediaPipelineModuleService>(mediaPipelineService);
+        mediaPipelineModule =
+            std::make_shared<MediaPipelineModuleService>(mediaPipelineService, IMainThreadFactory::createFactory());
     }
     catch (const std::exception &e)
     {
@@ -187,8 +189,9 @@ MediaPipelineModuleServiceFactory::create(service::IMediaPipelineService &mediaP
     return mediaPipelineModule;
 }
 
-MediaPipelineModuleService::MediaPipelineModuleService(service::IMediaPipelineService &mediaPipelineService)
-    : m_mediaPipelineService{mediaPipelineService}
+MediaPipelineModuleService::MediaPipelineModuleService(service::IMediaPipelineService &mediaPipelineService,
+                                                       const std::shared_ptr<IMainThreadFactory> &mainThreadFactory)
+    : m_mediaPipelineService{mediaPipelineService}, m_sessionExecutors{mainThreadFactory}
 {
 }
 
@@ -198,6 +201,7 @@ void MediaPipelineModuleService::clientConnected(const std::shared_ptr<::firebol
 {
     RIALTO_SERVER_LOG_INFO("Client Connected!");
     {
+        std::lock_guard<std::mutex> lock{m_clientSessionsMutex};
         m_clientSessions.emplace(ipcClient, std::set<int>());
     }
     ipcClient->exportService(shared_from_this());
@@ -208,6 +212,7 @@ void MediaPipelineModuleService::clientDisconnected(const std::shared_ptr<::fire
     RIALTO_SERVER_LOG_INFO("Client disconnected!");
     std::set<int> sessionIds;
     {
+        std::lock_guard<std::mutex> lock{m_clientSessionsMutex};
         auto sessionIter = m_clientSessions.find(ipcClient);
         if (sessionIter == m_clientSessions.end())
         {
@@ -219,7 +224,8 @@ void MediaPipelineModuleService::clientDisconnected(const std::shared_ptr<::fire
     }
     for (const auto &sessionId : sessionIds)
     {
-        m_mediaPipelineService.destroySession(sessionId);
+        m_sessionExecutors.destroyAndWait(sessionId,
+                                          [this, sessionId]() { m_mediaPipelineService.destroySession(sessionId); });
     }
 }
 
@@ -238,22 +244,38 @@ void MediaPipelineModuleService::createSession(::google::protobuf::RpcController
         return;
     }
     int sessionId = generateSessionId();
-    bool sessionCreated =
-        m_mediaPipelineService.createSession(sessionId,
-                                             std::make_shared<MediaPipelineClient>(sessionId, ipcController->getClient()),
-                                             request->max_width(), request->max_height());
-    if (sessionCreated)
-    {
-        // Assume that IPC library works well and client is present
-        m_clientSessions[ipcController->getClient()].insert(sessionId);
-        response->set_session_id(sessionId);
-    }
-    else
-    {
-        RIALTO_SERVER_LOG_ERROR("Create session failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+    std::shared_ptr<::firebolt::rialto::ipc::IClient> ipcClient = ipcController->getClient();
+    uint32_t maxWidth = request->max_width();
+    uint32_t maxHeight = request->max_height();
+    auto task = [this, controller, response, done, sessionId, ipcClient, maxWidth, maxHeight]()
+    {
+        bool sessionCreated =
+            m_mediaPipelineService.createSession(sessionId, std::make_shared<MediaPipelineClient>(sessionId, ipcClient),
+                                                 maxWidth, maxHeight);
+        if (sessionCreated)
+        {
+            // Assume that IPC library works well and client is present
+            {
+                std::lock_guard<std::mutex> lock{m_clientSessionsMutex};
+                m_clientSessions[ipcClient].insert(sessionId);
+            }
+            response->set_session_id(sessionId);
+            std::uint32_t statusPageOffset{0};
+            if (m_mediaPipelineService.getStatusPageOffset(sessionId, statusPageOffset))
+            {
+                response->set_status_page_offset(statusPageOffset);
+            }
+        }
+        else
+        {
+            RIALTO_SERVER_LOG_ERROR("Create session failed");
+            controller->SetFailed("Operation failed");
+            m_sessionExecutors.destroy(sessionId, []() {});
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.create(sessionId, std::move(task));
 }
 
 void MediaPipelineModuleService::destroySession(::google::protobuf::RpcController *controller,
@@ -270,19 +292,28 @@ void MediaPipelineModuleService::destroySession(::google::protobuf::RpcControlle
         done->Run();
         return;
     }
-    if (!m_mediaPipelineService.destroySession(request->session_id()))
+    int sessionId = request->session_id();
+    auto task = [this, controller, ipcController, done, sessionId]()
     {
-        RIALTO_SERVER_LOG_ERROR("Destroy session failed");
-        controller->SetFailed("Operation failed");
+        if (!m_mediaPipelineService.destroySession(sessionId))
+        {
+            RIALTO_SERVER_LOG_ERROR("Destroy session failed");
+            controller->SetFailed("Operation failed");
+            done->Run();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{m_clientSessionsMutex};
+            auto sessionIter = m_clientSessions.find(ipcController->getClient());
+            if (sessionIter != m_clientSessions.end())
+            {
+                sessionIter->second.erase(sessionId);
+            }
+        }
         done->Run();
-        return;
-    }
-    auto sessionIter = m_clientSessions.find(ipcController->getClient());
-    if (sessionIter != m_clientSessions.end())
-    {
-        sessionIter->second.erase(request->session_id());
-    }
-    done->Run();
+    };
+
+    m_sessionExecutors.destroy(sessionId, std::move(task));
 }
 
 void MediaPipelineModuleService::load(::google::protobuf::RpcController *controller,
@@ -290,13 +321,18 @@ void MediaPipelineModuleService::load(::google::protobuf::RpcController *control
                                       ::firebolt::rialto::LoadResponse *response, ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.load(request->session_id(), convertMediaType(request->type()), request->mime_type(),
-                                     request->url()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Load failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.load(request.session_id(), convertMediaType(request.type()), request.mime_type(),
+                                         request.url()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Load failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::setVideoWindow(::google::protobuf::RpcController *controller,
@@ -305,13 +341,18 @@ void MediaPipelineModuleService::setVideoWindow(::google::protobuf::RpcControlle
                                                 ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.setVideoWindow(request->session_id(), request->x(), request->y(), request->width(),
-                                               request->height()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Set Video Window failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.setVideoWindow(request.session_id(), request.x(), request.y(), request.width(),
+                                                   request.height()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Set Video Window failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::attachSource(::google::protobuf::RpcController *controller,
@@ -363,13 +404,21 @@ void MediaPipelineModuleService::attachSource(::google::protobuf::RpcController
                                                                           codecData);
     }
 
-    if (!m_mediaPipelineService.attachSource(request->session_id(), mediaSource))
+    // std::function requires a copyable callable, so the media source is handed over in a shared holder
+    auto mediaSourceHolder = std::make_shared<std::unique_ptr<IMediaPipeline::MediaSource>>(std::move(mediaSource));
+    auto task = [this, controller, response, done, sessionId = request->session_id(), mediaSourceHolder]()
     {
-        RIALTO_SERVER_LOG_ERROR("Attach source failed");
-        controller->SetFailed("Operation failed");
-    }
-    response->set_source_id(mediaSource->getId());
-    done->Run();
+        std::unique_ptr<IMediaPipeline::MediaSource> &mediaSource = *mediaSourceHolder;
+        if (!m_mediaPipelineService.attachSource(sessionId, mediaSource))
+        {
+            RIALTO_SERVER_LOG_ERROR("Attach source failed");
+            controller->SetFailed("Operation failed");
+        }
+        response->set_source_id(mediaSource->getId());
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::removeSource(::google::protobuf::RpcController *controller,
@@ -378,12 +427,17 @@ void MediaPipelineModuleService::removeSource(::google::protobuf::RpcController
                                               ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.removeSource(request->session_id(), request->source_id()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Remove source failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.removeSource(request.session_id(), request.source_id()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Remove source failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::play(::google::protobuf::RpcController *controller,
@@ -391,12 +445,17 @@ void MediaPipelineModuleService::play(::google::protobuf::RpcController *control
                                       ::firebolt::rialto::PlayResponse *response, ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.play(request->session_id()))
+    auto task = [this, controller, done, sessionId = request->session_id()]()
     {
-        RIALTO_SERVER_LOG_ERROR("Play failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.play(sessionId))
+        {
+            RIALTO_SERVER_LOG_ERROR("Play failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::pause(::google::protobuf::RpcController *controller,
@@ -404,12 +463,17 @@ void MediaPipelineModuleService::pause(::google::protobuf::RpcController *contro
                                        ::firebolt::rialto::PauseResponse *response, ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.pause(request->session_id()))
+    auto task = [this, controller, done, sessionId = request->session_id()]()
     {
-        RIALTO_SERVER_LOG_ERROR("pause failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.pause(sessionId))
+        {
+            RIALTO_SERVER_LOG_ERROR("pause failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::stop(::google::protobuf::RpcController *controller,
@@ -417,12 +481,17 @@ void MediaPipelineModuleService::stop(::google::protobuf::RpcController *control
                                       ::firebolt::rialto::StopResponse *response, ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.stop(request->session_id()))
+    auto task = [this, controller, done, sessionId = request->session_id()]()
     {
-        RIALTO_SERVER_LOG_ERROR("Stop failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.stop(sessionId))
+        {
+            RIALTO_SERVER_LOG_ERROR("Stop failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::setPosition(::google::protobuf::RpcController *controller,
@@ -431,12 +500,17 @@ void MediaPipelineModuleService::setPosition(::google::protobuf::RpcController *
                                              ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.setPosition(request->session_id(), request->position()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Set Position failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.setPosition(request.session_id(), request.position()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Set Position failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::haveData(::google::protobuf::RpcController *controller,
@@ -445,12 +519,51 @@ void MediaPipelineModuleService::haveData(::google::protobuf::RpcController *con
                                           ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    firebolt::rialto::MediaSourceStatus status{convertMediaSourceStatus(request->status())};
-    if (!m_mediaPipelineService.haveData(request->session_id(), status, request->num_frames(), request->request_id()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Have data failed");
-        controller->SetFailed("Operation failed");
+        firebolt::rialto::MediaSourceStatus status{convertMediaSourceStatus(request.status())};
+        if (!m_mediaPipelineService.haveData(request.session_id(), status, request.num_frames(), request.request_id()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Have data failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
+}
+
+void MediaPipelineModuleService::haveDataNoReply(::google::protobuf::RpcController *controller,
+                                                 const ::firebolt::rialto::HaveDataRequest *request,
+                                                 ::firebolt::rialto::HaveDataResponse *response,
+                                                 ::google::protobuf::Closure *done)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+    auto ipcController = dynamic_cast<firebolt::rialto::ipc::IController *>(controller);
+    if (!ipcController)
+    {
+        RIALTO_SERVER_LOG_ERROR("ipc library provided incompatible controller object");
+        done->Run();
+        return;
     }
+
+    // no reply is sent and the controller is only valid for the duration of this call, so failures
+    // are reported to the client with an event
+    std::shared_ptr<::firebolt::rialto::ipc::IClient> ipcClient = ipcController->getClient();
+    auto task = [this, ipcClient, request = *request]()
+    {
+        firebolt::rialto::MediaSourceStatus status{convertMediaSourceStatus(request.status())};
+        if (!m_mediaPipelineService.haveData(request.session_id(), status, request.num_frames(), request.request_id()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Have data failed for request id %u", request.request_id());
+            auto event = std::make_shared<firebolt::rialto::HaveDataErrorEvent>();
+            event->set_session_id(request.session_id());
+            event->set_request_id(request.request_id());
+            ipcClient->sendEvent(event);
+        }
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
     done->Run();
 }
 
@@ -460,12 +573,17 @@ void MediaPipelineModuleService::setPlaybackRate(::google::protobuf::RpcControll
                                                  ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_mediaPipelineService.setPlaybackRate(request->session_id(), request->rate()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Set playback rate failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_mediaPipelineService.setPlaybackRate(request.session_id(), request.rate()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Set playback rate failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::getPosition(::google::protobuf::RpcController *controller,
@@ -474,17 +592,32 @@ void MediaPipelineModuleService::getPosition(::google::protobuf::RpcController *
                                              ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    int64_t position{};
-    if (!m_mediaPipelineService.getPosition(request->session_id(), position))
+
+    // A fresh snapshot answers without waiting behind the tasks queued on the session strand
+    int64_t snapshotPosition{};
+    if (m_mediaPipelineService.getPositionFromSnapshot(request->session_id(), snapshotPosition))
     {
-        RIALTO_SERVER_LOG_ERROR("Get position failed");
-        controller->SetFailed("Operation failed");
+        response->set_position(snapshotPosition);
+        done->Run();
+        return;
     }
-    else
+
+    auto task = [this, controller, response, done, sessionId = request->session_id()]()
     {
-        response->set_position(position);
-    }
-    done->Run();
+        int64_t position{};
+        if (!m_mediaPipelineService.getPosition(sessionId, position))
+        {
+            RIALTO_SERVER_LOG_ERROR("Get position failed");
+            controller->SetFailed("Operation failed");
+        }
+        else
+        {
+            response->set_position(position);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::renderFrame(::google::protobuf::RpcController *controller,
@@ -494,13 +627,18 @@ void MediaPipelineModuleService::renderFrame(::google::protobuf::RpcController *
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    if (!m_mediaPipelineService.renderFrame(request->session_id()))
+    auto task = [this, controller, done, sessionId = request->session_id()]()
     {
-        RIALTO_SERVER_LOG_ERROR("Render frame");
-        controller->SetFailed("Operation failed");
-    }
+        if (!m_mediaPipelineService.renderFrame(sessionId))
+        {
+            RIALTO_SERVER_LOG_ERROR("Render frame");
+            controller->SetFailed("Operation failed");
+        }
 
-    done->Run();
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::setVolume(::google::protobuf::RpcController *controller,
@@ -510,13 +648,18 @@ void MediaPipelineModuleService::setVolume(::google::protobuf::RpcController *co
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    if (!m_mediaPipelineService.setVolume(request->session_id(), request->volume()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("Set volume failed.");
-        controller->SetFailed("Operation failed");
-    }
+        if (!m_mediaPipelineService.setVolume(request.session_id(), request.volume()))
+        {
+            RIALTO_SERVER_LOG_ERROR("Set volume failed.");
+            controller->SetFailed("Operation failed");
+        }
 
-    done->Run();
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 
 void MediaPipelineModuleService::getVolume(::google::protobuf::RpcController *controller,
@@ -525,18 +668,32 @@ void MediaPipelineModuleService::getVolume(::google::protobuf::RpcController *co
                                            ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    double volume{};
 
-    if (!m_mediaPipelineService.getVolume(request->session_id(), volume))
+    // A fresh snapshot answers without waiting behind the tasks queued on the session strand
+    double snapshotVolume{};
+    if (m_mediaPipelineService.getVolumeFromSnapshot(request->session_id(), snapshotVolume))
     {
-        RIALTO_SERVER_LOG_ERROR("Get volume failed.");
-        controller->SetFailed("Operation failed");
+        response->set_volume(snapshotVolume);
+        done->Run();
+        return;
     }
-    else
+
+    auto task = [this, controller, response, done, sessionId = request->session_id()]()
     {
-        response->set_volume(volume);
-    }
+        double volume{};
+        if (!m_mediaPipelineService.getVolume(sessionId, volume))
+        {
+            RIALTO_SERVER_LOG_ERROR("Get volume failed.");
+            controller->SetFailed("Operation failed");
+        }
+        else
+        {
+            response->set_volume(volume);
+        }
 
-    done->Run();
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->session_id(), std::move(task));
 }
 } // namespace firebolt::rialto::server::ipc
@@ -0,0 +1,114 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SessionExecutors.h"
+#include "RialtoServerLogging.h"
+#include <stdexcept>
+#include <utility>
+
+namespace firebolt::rialto::server::ipc
+{
+SessionExecutors::SessionExecutors(const std::shared_ptr<IMainThreadFactory> &mainThreadFactory)
+{
+    if (!mainThreadFactory)
+    {
+        throw std::runtime_error("Main thread factory invalid");
+    }
+    m_mainThread = mainThreadFactory->getMainThread();
+    if (!m_mainThread)
+    {
+        throw std::runtime_error("Failed to get the main thread");
+    }
+}
+
+SessionExecutors::~SessionExecutors()
+{
+    std::lock_guard<std::mutex> lock{m_executorsMutex};
+    for (const auto &executor : m_executors)
+    {
+        m_mainThread->unregisterClient(executor.second);
+    }
+}
+
+void SessionExecutors::create(int handle, IMainThread::Task &&task)
+{
+    const uint32_t kExecutorId = m_mainThread->registerClient();
+    {
+        std::lock_guard<std::mutex> lock{m_executorsMutex};
+        m_executors[handle] = kExecutorId;
+    }
+    // The handle is not known to the client before the creation task completes, so it is the first task queued
+    m_mainThread->enqueueTask(kExecutorId, std::move(task));
+}
+
+void SessionExecutors::execute(int handle, IMainThread::Task &&task)
+{
+    {
+        // Enqueue under the lock, so that no task can be queued behind the last task of the session
+        std::lock_guard<std::mutex> lock{m_executorsMutex};
+        auto executorIt = m_executors.find(handle);
+        if (executorIt != m_executors.end())
+        {
+            m_mainThread->enqueueTask(executorIt->second, std::move(task));
+            return;
+        }
+    }
+    task();
+}
+
+void SessionExecutors::destroy(int handle, IMainThread::Task &&task)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_executorsMutex};
+        auto executorIt = m_executors.find(handle);
+        if (executorIt != m_executors.end())
+        {
+            const uint32_t kExecutorId = executorIt->second;
+            m_executors.erase(executorIt);
+            m_mainThread->enqueueTask(kExecutorId,
+                                      [mainThread = m_mainThread, kExecutorId, task = std::move(task)]()
+                                      {
+                                          task();
+                                          mainThread->unregisterClient(kExecutorId);
+                                      });
+            return;
+        }
+    }
+    task();
+}
+
+void SessionExecutors::destroyAndWait(int handle, IMainThread::Task &&task)
+{
+    std::unique_lock<std::mutex> lock{m_executorsMutex};
+    auto executorIt = m_executors.find(handle);
+    if (executorIt == m_executors.end())
+    {
+        lock.unlock();
+        task();
+        return;
+    }
+    const uint32_t kExecutorId = executorIt->second;
+    m_executors.erase(executorIt);
+    lock.unlock();
+
+    // The tasks queued before are executed first, no new tasks can be queued after the executor is erased
+    m_mainThread->enqueueTaskAndWait(kExecutorId, std::move(task));
+    m_mainThread->unregisterClient(kExecutorId);
+}
+} // namespace firebolt::rialto::server::ipc
@@ -47,7 +47,8 @@ SessionManagementServer::SessionManagementServer(
       m_webAudioPlayerModule{webAudioPlayerModuleFactory->create(playbackService.getWebAudioPlayerService())},
       m_rialtoControlModule{rialtoControlModuleFactory->create(playbackService)}
 {
-    m_ipcServer = ipcFactory->create();
+    // run the method calls of different clients concurrently, so one client's blocking call doesn't stall the others
+    m_ipcServer = ipcFactory->create(firebolt::rialto::ipc::IServerFactory::DISPATCH_ON_WORKER_THREADS);
 }
 
 SessionManagementServer::~SessionManagementServer()
@@ -57,6 +58,9 @@ SessionManagementServer::~SessionManagementServer()
     {
         m_ipcServerThread.join();
     }
+    // method calls and disconnection callbacks run on the ipc server's worker threads, release the server (which
+    // waits for them) while the services they use still exist
+    m_ipcServer.reset();
 }
 
 bool SessionManagementServer::initialize(const std::string &socketName)
@@ -68,6 +72,10 @@ bool SessionManagementServer::initialize(const std::string &socketName)
         return false;
     }
 
+    // a client that falls behind only needs the latest position of each session
+    m_ipcServer->setEventPolicy(firebolt::rialto::PositionChangeEvent::descriptor()->full_name(),
+                                firebolt::rialto::ipc::IServer::EventPolicy::COALESCE, "session_id");
+
     // add a socket for clients and associate with a streamer object
     if (!m_ipcServer->addSocket(socketName,
                                 std::bind(&SessionManagementServer::onClientConnected, this, std::placeholders::_1),
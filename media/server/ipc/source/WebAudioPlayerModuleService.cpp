@@ -23,13 +23,14 @@
 #include "WebAudioPlayerClient.h"
 #include <IIpcController.h>
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 
 namespace
 {
 int generateHandle()
 {
-    static int webAudioPlayerHandle{0};
+    static std::atomic<int> webAudioPlayerHandle{0};
     return webAudioPlayerHandle++;
 }
 } // namespace
@@ -59,7 +60,8 @@ WebAudioPlayerModuleServiceFactory::create(service::IWebAudioPlayerService &webA
 
     try
     {
-        webAudioPlayerModule = std::make_shared<WebAudioPlayerModuleService>(webAudioPlayerService);
+        webAudioPlayerModule =
+            std::make_shared<WebAudioPlayerModuleService>(webAudioPlayerService, IMainThreadFactory::createFactory());
     }
     catch (const std::exception &e)
     {
@@ -69,8 +71,9 @@ WebAudioPlayerModuleServiceFactory::create(service::IWebAudioPlayerService &webA
     return webAudioPlayerModule;
 }
 
-WebAudioPlayerModuleService::WebAudioPlayerModuleService(service::IWebAudioPlayerService &webAudioPlayerService)
-    : m_webAudioPlayerService{webAudioPlayerService}
+WebAudioPlayerModuleService::WebAudioPlayerModuleService(service::IWebAudioPlayerService &webAudioPlayerService,
+                                                         const std::shared_ptr<IMainThreadFactory> &mainThreadFactory)
+    : m_webAudioPlayerService{webAudioPlayerService}, m_sessionExecutors{mainThreadFactory}
 {
 }
 
@@ -80,6 +83,7 @@ void WebAudioPlayerModuleService::clientConnected(const std::shared_ptr<::firebo
 {
     RIALTO_SERVER_LOG_INFO("Client Connected!");
     {
+        std::lock_guard<std::mutex> lock{m_clientWebAudioPlayerHandlesMutex};
         m_clientWebAudioPlayerHandles.emplace(ipcClient, std::set<int>());
     }
     ipcClient->exportService(shared_from_this());
@@ -90,6 +94,7 @@ void WebAudioPlayerModuleService::clientDisconnected(const std::shared_ptr<::fir
     RIALTO_SERVER_LOG_INFO("Client disconnected!");
     std::set<int> webAudioPlayerHandles;
     {
+        std::lock_guard<std::mutex> lock{m_clientWebAudioPlayerHandlesMutex};
         auto handleIter = m_clientWebAudioPlayerHandles.find(ipcClient);
         if (handleIter == m_clientWebAudioPlayerHandles.end())
         {
@@ -101,7 +106,8 @@ void WebAudioPlayerModuleService::clientDisconnected(const std::shared_ptr<::fir
     }
     for (const auto &webAudioPlayerHandle : webAudioPlayerHandles)
     {
-        m_webAudioPlayerService.destroyWebAudioPlayer(webAudioPlayerHandle);
+        m_sessionExecutors.destroyAndWait(webAudioPlayerHandle, [this, webAudioPlayerHandle]()
+                                          { m_webAudioPlayerService.destroyWebAudioPlayer(webAudioPlayerHandle); });
     }
 }
 
@@ -134,23 +140,33 @@ void WebAudioPlayerModuleService::createWebAudioPlayer(::google::protobuf::RpcCo
         }
     }
     int handle = generateHandle();
-    bool webAudioPlayerCreated =
-        m_webAudioPlayerService.createWebAudioPlayer(handle,
-                                                     std::make_shared<WebAudioPlayerClient>(handle,
-                                                                                            ipcController->getClient()),
-                                                     request->audio_mime_type(), request->priority(), &config);
-    if (webAudioPlayerCreated)
+    std::shared_ptr<::firebolt::rialto::ipc::IClient> ipcClient = ipcController->getClient();
+    auto task = [this, controller, response, done, handle, ipcClient, config,
+                 audioMimeType = request->audio_mime_type(), priority = request->priority()]()
     {
-        // Assume that IPC library works well and client is present
-        m_clientWebAudioPlayerHandles[ipcController->getClient()].insert(handle);
-        response->set_web_audio_player_handle(handle);
-    }
-    else
-    {
-        RIALTO_SERVER_LOG_ERROR("Create web audio player failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        bool webAudioPlayerCreated =
+            m_webAudioPlayerService.createWebAudioPlayer(handle,
+                                                         std::make_shared<WebAudioPlayerClient>(handle, ipcClient),
+                                                         audioMimeType, priority, &config);
+        if (webAudioPlayerCreated)
+        {
+            // Assume that IPC library works well and client is present
+            {
+                std::lock_guard<std::mutex> lock{m_clientWebAudioPlayerHandlesMutex};
+                m_clientWebAudioPlayerHandles[ipcClient].insert(handle);
+            }
+            response->set_web_audio_player_handle(handle);
+        }
+        else
+        {
+            RIALTO_SERVER_LOG_ERROR("Create web audio player failed");
+            controller->SetFailed("Operation failed");
+            m_sessionExecutors.destroy(handle, []() {});
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.create(handle, std::move(task));
 }
 
 void WebAudioPlayerModuleService::destroyWebAudioPlayer(::google::protobuf::RpcController *controller,
@@ -167,19 +183,28 @@ void WebAudioPlayerModuleService::destroyWebAudioPlayer(::google::protobuf::RpcC
         done->Run();
         return;
     }
-    if (!m_webAudioPlayerService.destroyWebAudioPlayer(request->web_audio_player_handle()))
+    int handle = request->web_audio_player_handle();
+    auto task = [this, controller, ipcController, done, handle]()
     {
-        RIALTO_SERVER_LOG_ERROR("Destroy web audio player failed");
-        controller->SetFailed("Operation failed");
+        if (!m_webAudioPlayerService.destroyWebAudioPlayer(handle))
+        {
+            RIALTO_SERVER_LOG_ERROR("Destroy web audio player failed");
+            controller->SetFailed("Operation failed");
+            done->Run();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{m_clientWebAudioPlayerHandlesMutex};
+            auto handleIter = m_clientWebAudioPlayerHandles.find(ipcController->getClient());
+            if (handleIter != m_clientWebAudioPlayerHandles.end())
+            {
+                handleIter->second.erase(handle);
+            }
+        }
         done->Run();
-        return;
-    }
-    auto handleIter = m_clientWebAudioPlayerHandles.find(ipcController->getClient());
-    if (handleIter != m_clientWebAudioPlayerHandles.end())
-    {
-        handleIter->second.erase(request->web_audio_player_handle());
-    }
-    done->Run();
+    };
+
+    m_sessionExecutors.destroy(handle, std::move(task));
 }
 
 void WebAudioPlayerModuleService::play(::google::protobuf::RpcController *controller,
@@ -188,12 +213,17 @@ void WebAudioPlayerModuleService::play(::google::protobuf::RpcController *contro
                                        ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_webAudioPlayerService.play(request->web_audio_player_handle()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("play failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_webAudioPlayerService.play(request.web_audio_player_handle()))
+        {
+            RIALTO_SERVER_LOG_ERROR("play failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::pause(::google::protobuf::RpcController *controller,
@@ -202,12 +232,17 @@ void WebAudioPlayerModuleService::pause(::google::protobuf::RpcController *contr
                                         ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_webAudioPlayerService.pause(request->web_audio_player_handle()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("pause failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_webAudioPlayerService.pause(request.web_audio_player_handle()))
+        {
+            RIALTO_SERVER_LOG_ERROR("pause failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::setEos(::google::protobuf::RpcController *controller,
@@ -216,12 +251,17 @@ void WebAudioPlayerModuleService::setEos(::google::protobuf::RpcController *cont
                                          ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_webAudioPlayerService.setEos(request->web_audio_player_handle()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("setEos failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_webAudioPlayerService.setEos(request.web_audio_player_handle()))
+        {
+            RIALTO_SERVER_LOG_ERROR("setEos failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::getBufferAvailable(::google::protobuf::RpcController *controller,
@@ -230,23 +270,27 @@ void WebAudioPlayerModuleService::getBufferAvailable(::google::protobuf::RpcCont
                                                      ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-
-    uint32_t availableFrames{};
-    std::shared_ptr<WebAudioShmInfo> shmInfo = std::make_shared<WebAudioShmInfo>();
-    if (!m_webAudioPlayerService.getBufferAvailable(request->web_audio_player_handle(), availableFrames, shmInfo))
-    {
-        RIALTO_SERVER_LOG_ERROR("getBufferAvailable failed");
-        controller->SetFailed("Operation failed");
-    }
-    else
+    auto task = [this, controller, response, done, request = *request]()
     {
-        response->set_available_frames(availableFrames);
-        response->mutable_shm_info()->set_offset_main(shmInfo->offsetMain);
-        response->mutable_shm_info()->set_length_main(shmInfo->lengthMain);
-        response->mutable_shm_info()->set_offset_wrap(shmInfo->offsetWrap);
-        response->mutable_shm_info()->set_length_wrap(shmInfo->lengthWrap);
-    }
-    done->Run();
+        uint32_t availableFrames{};
+        std::shared_ptr<WebAudioShmInfo> shmInfo = std::make_shared<WebAudioShmInfo>();
+        if (!m_webAudioPlayerService.getBufferAvailable(request.web_audio_player_handle(), availableFrames, shmInfo))
+        {
+            RIALTO_SERVER_LOG_ERROR("getBufferAvailable failed");
+            controller->SetFailed("Operation failed");
+        }
+        else
+        {
+            response->set_available_frames(availableFrames);
+            response->mutable_shm_info()->set_offset_main(shmInfo->offsetMain);
+            response->mutable_shm_info()->set_length_main(shmInfo->lengthMain);
+            response->mutable_shm_info()->set_offset_wrap(shmInfo->offsetWrap);
+            response->mutable_shm_info()->set_length_wrap(shmInfo->lengthWrap);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::getBufferDelay(::google::protobuf::RpcController *controller,
@@ -256,17 +300,31 @@ void WebAudioPlayerModuleService::getBufferDelay(::google::protobuf::RpcControll
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    uint32_t delayFrames{};
-    if (!m_webAudioPlayerService.getBufferDelay(request->web_audio_player_handle(), delayFrames))
+    // A fresh snapshot answers without waiting behind the tasks queued on the session strand
+    uint32_t snapshotDelayFrames{};
+    if (m_webAudioPlayerService.getBufferDelayFromSnapshot(request->web_audio_player_handle(), snapshotDelayFrames))
     {
-        RIALTO_SERVER_LOG_ERROR("getBufferDelay failed");
-        controller->SetFailed("Operation failed");
+        response->set_delay_frames(snapshotDelayFrames);
+        done->Run();
+        return;
     }
-    else
+
+    auto task = [this, controller, response, done, request = *request]()
     {
-        response->set_delay_frames(delayFrames);
-    }
-    done->Run();
+        uint32_t delayFrames{};
+        if (!m_webAudioPlayerService.getBufferDelay(request.web_audio_player_handle(), delayFrames))
+        {
+            RIALTO_SERVER_LOG_ERROR("getBufferDelay failed");
+            controller->SetFailed("Operation failed");
+        }
+        else
+        {
+            response->set_delay_frames(delayFrames);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::writeBuffer(::google::protobuf::RpcController *controller,
@@ -275,12 +333,18 @@ void WebAudioPlayerModuleService::writeBuffer(::google::protobuf::RpcController
                                               ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_webAudioPlayerService.writeBuffer(request->web_audio_player_handle(), request->number_of_frames(), nullptr))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("writeBuffer failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_webAudioPlayerService.writeBuffer(request.web_audio_player_handle(), request.number_of_frames(),
+                                                 nullptr))
+        {
+            RIALTO_SERVER_LOG_ERROR("writeBuffer failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::getDeviceInfo(::google::protobuf::RpcController *controller,
@@ -289,23 +353,27 @@ void WebAudioPlayerModuleService::getDeviceInfo(::google::protobuf::RpcControlle
                                                 ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-
-    uint32_t preferredFrames{};
-    uint32_t maximumFrames{};
-    bool supportDeferredPlay{};
-    if (!m_webAudioPlayerService.getDeviceInfo(request->web_audio_player_handle(), preferredFrames, maximumFrames,
-                                               supportDeferredPlay))
+    auto task = [this, controller, response, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("getDeviceInfo failed");
-        controller->SetFailed("Operation failed");
-    }
-    else
-    {
-        response->set_preferred_frames(preferredFrames);
-        response->set_maximum_frames(maximumFrames);
-        response->set_support_deferred_play(supportDeferredPlay);
-    }
-    done->Run();
+        uint32_t preferredFrames{};
+        uint32_t maximumFrames{};
+        bool supportDeferredPlay{};
+        if (!m_webAudioPlayerService.getDeviceInfo(request.web_audio_player_handle(), preferredFrames, maximumFrames,
+                                                   supportDeferredPlay))
+        {
+            RIALTO_SERVER_LOG_ERROR("getDeviceInfo failed");
+            controller->SetFailed("Operation failed");
+        }
+        else
+        {
+            response->set_preferred_frames(preferredFrames);
+            response->set_maximum_frames(maximumFrames);
+            response->set_support_deferred_play(supportDeferredPlay);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::setVolume(::google::protobuf::RpcController *controller,
@@ -314,12 +382,17 @@ void WebAudioPlayerModuleService::setVolume(::google::protobuf::RpcController *c
                                             ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_webAudioPlayerService.setVolume(request->web_audio_player_handle(), request->volume()))
+    auto task = [this, controller, done, request = *request]()
     {
-        RIALTO_SERVER_LOG_ERROR("setVolume failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+        if (!m_webAudioPlayerService.setVolume(request.web_audio_player_handle(), request.volume()))
+        {
+            RIALTO_SERVER_LOG_ERROR("setVolume failed");
+            controller->SetFailed("Operation failed");
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 void WebAudioPlayerModuleService::getVolume(::google::protobuf::RpcController *controller,
@@ -328,18 +401,22 @@ void WebAudioPlayerModuleService::getVolume(::google::protobuf::RpcController *c
                                             ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-
-    double volume{};
-    if (!m_webAudioPlayerService.getVolume(request->web_audio_player_handle(), volume))
-    {
-        RIALTO_SERVER_LOG_ERROR("getVolume failed");
-        controller->SetFailed("Operation failed");
-    }
-    else
+    auto task = [this, controller, response, done, request = *request]()
     {
-        response->set_volume(volume);
-    }
-    done->Run();
+        double volume{};
+        if (!m_webAudioPlayerService.getVolume(request.web_audio_player_handle(), volume))
+        {
+            RIALTO_SERVER_LOG_ERROR("getVolume failed");
+            controller->SetFailed("Operation failed");
+        }
+        else
+        {
+            response->set_volume(volume);
+        }
+        done->Run();
+    };
+
+    m_sessionExecutors.execute(request->web_audio_player_handle(), std::move(task));
 }
 
 } // namespace firebolt::rialto::server::ipc
@@ -38,8 +38,11 @@ public:
     IActiveRequests &operator=(const IActiveRequests &) = delete;
     IActiveRequests &operator=(IActiveRequests &&) = delete;
 
-    virtual std::uint32_t insert(const MediaSourceType &mediaSourceType, std::uint32_t maxMediaBytes) = 0;
+    virtual std::uint32_t insert(const MediaSourceType &mediaSourceType, std::uint32_t maxMediaBytes,
+                                 std::uint32_t shmSlot) = 0;
     virtual MediaSourceType getType(std::uint32_t requestId) const = 0;
+    virtual std::uint32_t getShmSlot(std::uint32_t requestId) const = 0;
+    virtual bool isShmSlotUsed(const MediaSourceType &mediaSourceType, std::uint32_t shmSlot) const = 0;
     virtual void erase(std::uint32_t requestId) = 0;
     virtual void erase(const MediaSourceType &mediaSourceType) = 0;
     virtual void clear() = 0;
@@ -20,16 +20,20 @@
 #ifndef FIREBOLT_RIALTO_SERVER_MAIN_THREAD_H_
 #define FIREBOLT_RIALTO_SERVER_MAIN_THREAD_H_
 
+#include "CompletionLatch.h"
 #include "IMainThread.h"
+#include "MpscQueue.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
-#include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace firebolt::rialto::server
 {
@@ -52,12 +56,16 @@ protected:
 };
 
 /**
- * @brief The definition of the MediaKeys.
+ * @brief The definition of the MainThread.
+ *
+ * Tasks are executed by a small pool of worker threads. Each registered client owns a strand, a serial queue that
+ * guarantees its tasks run in order and never concurrently, while the strands of different clients run in parallel.
  */
 class MainThread : public IMainThread
 {
 public:
     MainThread();
+    explicit MainThread(std::size_t numOfWorkerThreads);
     virtual ~MainThread();
 
     int32_t registerClient() override;
@@ -66,54 +74,89 @@ public:
     void enqueueTask(uint32_t clientId, Task task) override;
     void enqueueTaskAndWait(uint32_t clientId, Task task) override;
 
+    bool getStrandMetrics(uint32_t clientId, StrandMetrics &metrics) const override;
+
 private:
+    /**
+     * @brief The number of queued tasks, that a strand holds without allocating queue nodes.
+     */
+    static constexpr std::uint32_t kTaskPoolSize{32};
+
     /**
      * @brief Information of a task.
      */
     struct TaskInfo
     {
-        uint32_t clientId;                           /**< The id of the client creating the task. */
-        Task task;                                   /**< The task to execute. */
-        std::unique_ptr<std::mutex> mutex;           /**< Mutex for the task condition variable. */
-        std::unique_ptr<std::condition_variable> cv; /**< The condition variable of the task. */
+        uint32_t clientId{0};                              /**< The id of the client creating the task. */
+        Task task;                                         /**< The task to execute. */
+        std::chrono::steady_clock::time_point enqueueTime; /**< The time the task entered the queue. */
+        common::CompletionLatch *completion{nullptr};      /**< The latch of the thread waiting for the task. */
+    };
+
+    /**
+     * @brief Serial queue of tasks, shared by the clients registered on it.
+     */
+    struct Strand
+    {
+        const MainThread *owner{nullptr};                     /**< The main thread the strand belongs to. */
+        common::MpscQueue<TaskInfo> taskQueue{kTaskPoolSize}; /**< The tasks waiting for execution. */
+        bool isScheduled{false};                              /**< Whether the strand is ready or running. */
+        std::size_t numOfClients{0};                          /**< The number of clients registered on the strand. */
+        StrandMetrics metrics;                                /**< The metrics of the strand. */
     };
 
     /**
-     * @brief Starts a loop that listens for enqueued tasks.
+     * @brief Loop of a worker thread, that executes the tasks of the ready strands.
      */
-    void mainThreadLoop();
+    void workerThreadLoop();
 
     /**
-     * @brief Waits for tasks to enter the queue and returns the next task.
+     * @brief Adds a task to the strand of the client and schedules the strand, if needed.
      *
-     * @retval The next task in the queue.
+     * @param[in] taskInfo : The task to enqueue.
+     *
+     * @retval true if the task was enqueued, false if the client is not registered.
+     */
+    bool pushTask(TaskInfo &&taskInfo);
+
+    /**
+     * @brief Checks if the calling thread is executing a task on the strand of the client.
+     *
+     * @param[in] clientId : The id of the registered client.
+     *
+     * @retval true if called from a task running on the strand of the client.
+     */
+    bool isRunningOnStrandOf(uint32_t clientId) const;
+
+    /**
+     * @brief The strand of the task being executed by the current thread, if any.
      */
-    const std::shared_ptr<TaskInfo> waitForTask();
+    static thread_local std::shared_ptr<Strand> m_currentStrand;
 
     /**
-     * @brief Whether the main thread is running.
+     * @brief Whether the worker threads are running.
      */
     bool m_isMainThreadRunning;
 
     /**
-     * @brief The main thread.
+     * @brief The worker threads.
      */
-    std::thread m_thread;
+    std::vector<std::thread> m_workerThreads;
 
     /**
-     * @brief A mutex protecting access to the task queue.
+     * @brief A mutex protecting access to the strands and the ready queue.
      */
-    std::mutex m_taskQueueMutex;
+    mutable std::mutex m_mutex;
 
     /**
-     * @brief A condition variable used to notify of tasks entering the task queue.
+     * @brief A condition variable used to notify of strands entering the ready queue.
      */
-    std::condition_variable m_taskQueueCv;
+    std::condition_variable m_readyQueueCv;
 
     /**
-     * @brief The queue of tasks and there infomation.
+     * @brief The strands that have tasks to execute and wait for a worker thread.
      */
-    std::queue<std::shared_ptr<TaskInfo>> m_taskQueue;
+    std::queue<std::shared_ptr<Strand>> m_readyQueue;
 
     /**
      * @brief The main thread objects client id, for registering new clients.
@@ -126,9 +169,9 @@ private:
     std::atomic<uint32_t> m_nextClientId;
 
     /**
-     * @brief Clients registered on this thread.
+     * @brief Clients registered on this thread and their strands.
      */
-    std::set<uint32_t> m_registeredClients;
+    std::map<uint32_t, std::shared_ptr<Strand>> m_registeredClients;
 };
 } // namespace firebolt::rialto::server
 
@@ -26,6 +26,7 @@
 #include "IOcdmSystem.h"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -54,12 +55,32 @@ namespace firebolt::rialto::server
 class MediaKeysServerInternal : public IMediaKeysServerInternal
 {
 public:
-    struct MediaKeySessionUsage
+    /**
+     * @brief Serialises the calls to a session, which are made both by the main thread and the streaming threads.
+     *
+     * It also holds the number of buffers using the session, counted by the streaming threads, and whether closing
+     * of the session has been deferred until none use it.
+     */
+    struct MediaKeySessionGuard
     {
-        std::unique_ptr<IMediaKeySession> mediaKeySession;
+        std::mutex mutex;
+        bool isClosed = false;
         uint32_t bufCounter = 0;
         bool shouldBeDestroyed = false;
     };
+    /**
+     * @brief A session as seen by the streaming threads.
+     */
+    struct SharedMediaKeySession
+    {
+        std::shared_ptr<IMediaKeySession> mediaKeySession;
+        std::shared_ptr<MediaKeySessionGuard> guard;
+    };
+    struct MediaKeySessionUsage
+    {
+        std::shared_ptr<IMediaKeySession> mediaKeySession;
+        std::shared_ptr<MediaKeySessionGuard> guard = std::make_shared<MediaKeySessionGuard>();
+    };
     /**
      * @brief The constructor.
      *
@@ -146,6 +167,14 @@ private:
      */
     std::map<int32_t, MediaKeySessionUsage> m_mediaKeySessions;
 
+    /**
+     * @brief Read-only copy of the created sessions, used by the decryption from the streaming threads.
+     *
+     * Replaced as a whole on the main thread whenever m_mediaKeySessions changes. Must be accessed with
+     * std::atomic_load and std::atomic_store. Sessions are kept alive by the usage counter while buffers use them.
+     */
+    std::shared_ptr<const std::map<int32_t, SharedMediaKeySession>> m_mediaKeySessionsSnapshot;
+
     /**
      * @brief KeySystem type of the MediaKeysServerInternal.
      */
@@ -228,26 +257,6 @@ private:
      */
     MediaKeyErrorStatus getCdmKeySessionIdInternal(int32_t keySessionId, std::string &cdmKeySessionId);
 
-    /**
-     * @brief Decrypt internally, only to be called on the main thread.
-     *
-     * @param[in] keySessionId    : The session id for the session.
-     * @param[in]  encrypted      : Gstreamer buffer containing encrypted data and related meta data. If applicable,
-     *                              decrypted data will be stored here after this call returns.
-     * @param[in]  subSample      : Gstreamer buffer containing subsamples size which has been parsed from protection
-     *                              meta data.
-     * @param[in]  subSampleCount : count of subsamples
-     * @param[in]  IV             : Gstreamer buffer containing initial vector (IV) used during decryption.
-     * @param[in]  keyId          : Gstreamer buffer containing keyID to use for decryption
-     * @param[in]  initWithLast15 : The value deciding whether decryption context needs to be initialized with
-     *                              last 15 bytes. Currently this only applies to PlayReady DRM.
-     *
-     * @retval an error status.
-     */
-    MediaKeyErrorStatus decryptInternal(int32_t keySessionId, GstBuffer *encrypted, GstBuffer *subSample,
-                                        const uint32_t subSampleCount, GstBuffer *IV, GstBuffer *keyId,
-                                        uint32_t initWithLast15);
-
     /**
      * @brief Selects the specified keyId for the key session internally, only to be called on the main thread.
      *
@@ -290,16 +299,37 @@ private:
     MediaKeyErrorStatus getLastDrmErrorInternal(int32_t keySessionId, uint32_t &errorCode);
 
     /**
-     * @brief Checks, if key system of media key session is Netflix internally, only to be called on the main thread.
+     * @brief Publishes the current set of sessions for the lock-free lookups, only to be called on the main thread.
+     */
+    void updateMediaKeySessionsSnapshot();
+
+    /**
+     * @brief Looks up a session without going through the main thread. Can be called from any thread.
      *
      * @param[in] keySessionId    : The session id for the session.
      *
-     * @retval true if key system is Netflix
+     * @retval the session with its guard, or an empty one if it does not exist.
      */
-    bool isNetflixKeySystemInternal(int32_t keySessionId) const;
+    SharedMediaKeySession findMediaKeySession(int32_t keySessionId) const;
 
-    void incrementSessionIdUsageCounterInternal(int32_t keySessionId);
-    void decrementSessionIdUsageCounterInternal(int32_t keySessionId);
+    /**
+     * @brief Closes the session and removes it, only to be called on the main thread.
+     *
+     * The session is unpublished before it is closed, so the streaming threads can not pick it up any more, and the
+     * close waits for a decryption that is already in progress. The session is restored if closing fails.
+     *
+     * @param[in] sessionIter    : The session to close.
+     *
+     * @retval the status of closing the session.
+     */
+    MediaKeyErrorStatus closeMediaKeySession(std::map<int32_t, MediaKeySessionUsage>::iterator sessionIter);
+
+    /**
+     * @brief Closes a session whose closing was deferred, once the last buffer using it has been released.
+     *
+     * @param[in] keySessionId : The key session id.
+     */
+    void closeDeferredMediaKeySession(int32_t keySessionId);
 };
 
 }; // namespace firebolt::rialto::server
@@ -26,6 +26,10 @@
 #include "IMainThread.h"
 #include "IMediaPipelineServerInternal.h"
 #include "ITimer.h"
+#include "PlayerSnapshot.h"
+#include "ShmStatusPage.h"
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -110,6 +114,8 @@ public:
 
     bool getPosition(int64_t &position) override;
 
+    bool getPositionFromSnapshot(int64_t &position) override;
+
     bool setVideoWindow(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
     bool haveData(MediaSourceStatus status, uint32_t needDataRequestId) override;
@@ -122,6 +128,8 @@ public:
 
     bool getVolume(double &volume) override;
 
+    bool getVolumeFromSnapshot(double &volume) override;
+
     AddSegmentStatus addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment) override;
 
     std::weak_ptr<IMediaPipelineClient> getClient() override;
@@ -140,6 +148,10 @@ public:
 
     void notifyQos(MediaSourceType mediaSourceType, const QosInfo &qosInfo) override;
 
+    void notifyBufferLevel(MediaSourceType mediaSourceType, std::uint64_t queuedBytes) override;
+
+    void notifyVolume(double volume) override;
+
 protected:
     /**
      * @brief The media player client.
@@ -176,6 +188,12 @@ protected:
      */
     std::shared_ptr<ISharedMemoryBuffer> m_shmBuffer;
 
+    /**
+     * @brief Lease of the mapped shm partition. Shared with every data reader handed over to the player, the
+     * partition is unmapped when the last owner releases it.
+     */
+    std::shared_ptr<void> m_partitionLease;
+
     /**
      * @brief DataReader factory
      */
@@ -216,6 +234,43 @@ protected:
      */
     std::map<MediaSourceType, std::int32_t> m_attachedSources;
 
+    /**
+     * @brief Data readers handed over to the gstreamer player, indexed by shm ring slot. A slot is not reused
+     * until the player has released its reader.
+     */
+    std::map<MediaSourceType, std::vector<std::weak_ptr<IDataReader>>> m_shmSlotReaders;
+
+    /**
+     * @brief The shm ring slot, from which the search for a free slot starts for the next NeedMediaData request.
+     */
+    std::map<MediaSourceType, std::uint32_t> m_nextShmSlot;
+
+    /**
+     * @brief The status page of the session in the shared memory, read by the client without an ipc call.
+     * Null if the page is not available. Only to be used on the main thread.
+     */
+    std::unique_ptr<common::ShmStatusPage> m_statusPage;
+
+    /**
+     * @brief The last status published in the status page. Only to be used on the main thread.
+     */
+    common::PlaybackStatus m_playbackStatus;
+
+    /**
+     * @brief The player state cached for the read-only getters, refreshed by the gstreamer player worker thread.
+     */
+    PlayerSnapshot m_playerSnapshot;
+
+    /**
+     * @brief The generation of the snapshot position that the position reports of the player are sampled in.
+     */
+    std::atomic<std::uint64_t> m_positionReportGeneration{0};
+
+    /**
+     * @brief The number of seeks requested from the player, which the player has not started yet.
+     */
+    std::atomic<std::uint32_t> m_pendingSeeks{0};
+
     /**
      * @brief Load internally, only to be called on the main thread.
      *
@@ -347,6 +402,8 @@ protected:
      * @brief Notify need media data internally, only to be called on the main thread.
      *
      * @param[in] mediaSourceType    : The media source type.
+     *
+     * @retval true if a request for the source is outstanding, false if none could be sent.
      */
     bool notifyNeedMediaDataInternal(MediaSourceType mediaSourceType);
 
@@ -358,6 +415,27 @@ protected:
      */
     void scheduleNotifyNeedMediaData(MediaSourceType mediaSourceType);
 
+    /**
+     * @brief Checks if the shm ring slot can be used for a new NeedMediaData request, only to be called on the main
+     * thread. Slot is busy as long as it has an outstanding request or its data has not been read by the player.
+     *
+     * @param[in] mediaSourceType    : The media source type.
+     * @param[in] shmSlot            : The index of the shm ring slot.
+     *
+     * @retval true if the slot is free.
+     */
+    bool isShmSlotFree(MediaSourceType mediaSourceType, std::uint32_t shmSlot) const;
+
+    /**
+     * @brief Checks if any shm ring slot of the source is still read by the player or wrapped by its buffers, only to
+     * be called on the main thread. Region of such source can't be resized.
+     *
+     * @param[in] mediaSourceType    : The media source type.
+     *
+     * @retval true if the region is still used by the player.
+     */
+    bool isShmRegionUsedByPlayer(MediaSourceType mediaSourceType) const;
+
     /**
      * @brief Set volume internally, only to be called on the main thread.
      *
@@ -375,6 +453,26 @@ protected:
      * @retval true on success false otherwise
      */
     bool getVolumeInternal(double &volume);
+
+    /**
+     * @brief Sets the position of the published status, timestamped with the current time, only to be called on
+     * the main thread.
+     *
+     * @param[in] position : The playback position in nanoseconds.
+     */
+    void setStatusPosition(std::int64_t position);
+
+    /**
+     * @brief Makes the position reports of the player belong to the current snapshot generation, unless a seek is
+     * still pending, in which case the reports sampled before the seek keep being dropped. Can be called from any
+     * thread.
+     */
+    void updatePositionReportGeneration();
+
+    /**
+     * @brief Publishes the current status in the status page, only to be called on the main thread.
+     */
+    void publishPlaybackStatus();
 };
 
 }; // namespace firebolt::rialto::server
@@ -34,7 +34,7 @@ class NeedMediaData
 public:
     NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActiveRequests &activeRequests,
                   const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType,
-                  std::int32_t sourceId, PlaybackState currentPlaybackState);
+                  std::int32_t sourceId, PlaybackState currentPlaybackState, std::uint32_t shmSlot);
     ~NeedMediaData() = default;
 
     bool send() const;
@@ -46,6 +46,7 @@ private:
     std::uint32_t m_frameCount;
     std::int32_t m_sourceId;
     std::uint32_t m_maxMediaBytes;
+    std::uint32_t m_shmSlot;
     std::shared_ptr<MediaPlayerShmInfo> m_shmInfo;
     bool m_isValid;
 };
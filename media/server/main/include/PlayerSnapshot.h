@@ -0,0 +1,270 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_PLAYER_SNAPSHOT_H_
+#define FIREBOLT_RIALTO_SERVER_PLAYER_SNAPSHOT_H_
+
+#include "MediaCommon.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Cached state of a gstreamer player.
+ *
+ * The values are refreshed by the gstreamer player worker thread, through the player client notifications, and read
+ * by the read-only getters from any thread, without a hop to the main thread. Each value is published together with
+ * the time of its refresh, so that a getter can fall back to a live query when the cached value is too old.
+ *
+ * Position reports are tagged with a generation. Every invalidation of the position starts a new generation, so a
+ * report sampled by the player before the invalidation, for example before a seek, can not publish the old position.
+ */
+class PlayerSnapshot
+{
+public:
+    /**
+     * @brief Publishes the position of the playback, unless it belongs to an older generation.
+     *
+     * @param[in] position   : The position in nanoseconds.
+     * @param[in] generation : The generation the position was sampled in.
+     *
+     * @retval false if the position was dropped, because the position has been invalidated since.
+     */
+    bool setPosition(std::int64_t position, std::uint64_t generation)
+    {
+        if (generation != m_positionGeneration.load())
+        {
+            return false;
+        }
+        m_position.store(position);
+        if (generation != m_positionGeneration.load())
+        {
+            // Invalidated while publishing, the invalidation must win
+            m_position.invalidate();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Drops the published position and starts a new generation, for example after a seek.
+     */
+    void invalidatePosition()
+    {
+        ++m_positionGeneration;
+        m_position.invalidate();
+    }
+
+    /**
+     * @brief Gets the current generation of the position.
+     *
+     * @retval the generation, increased by every invalidation of the position.
+     */
+    std::uint64_t getPositionGeneration() const { return m_positionGeneration.load(); }
+
+    /**
+     * @brief Sets the playback rate, used to extrapolate the position.
+     *
+     * @param[in] rate : The playback rate.
+     */
+    void setPlaybackRate(double rate) { m_playbackRate.store(rate, std::memory_order_relaxed); }
+
+    /**
+     * @brief Publishes the playback state.
+     *
+     * @param[in] state : The playback state.
+     */
+    void setPlaybackState(PlaybackState state) { m_playbackState.store(state, std::memory_order_relaxed); }
+
+    /**
+     * @brief Publishes the volume of the pipeline.
+     *
+     * @param[in] volume : The linear volume.
+     */
+    void setVolume(double volume) { m_volume.store(volume); }
+
+    /**
+     * @brief Drops the published volume, for example when a new volume is being set.
+     */
+    void invalidateVolume() { m_volume.invalidate(); }
+
+    /**
+     * @brief Publishes the number of bytes queued in the app source of the player.
+     *
+     * @param[in] queuedBytes : The number of queued bytes.
+     */
+    void setQueuedBytes(std::uint64_t queuedBytes) { m_queuedBytes.store(queuedBytes); }
+
+    /**
+     * @brief Drops all the published values, for example when the player is replaced.
+     */
+    void reset()
+    {
+        invalidatePosition();
+        m_volume.invalidate();
+        m_queuedBytes.invalidate();
+        m_playbackRate.store(1.0, std::memory_order_relaxed);
+        m_playbackState.store(PlaybackState::UNKNOWN, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the position of the playback, extrapolated with the playback rate since its refresh.
+     *
+     * Only served while playing, as the position reported before a pause may lag behind the paused position.
+     *
+     * @param[out] position : The position in nanoseconds.
+     * @param[in]  maxAge   : The maximum accepted age of the published position.
+     *
+     * @retval false if the position is not published, too old or the playback is not playing.
+     */
+    bool getPosition(std::int64_t &position, std::chrono::nanoseconds maxAge) const
+    {
+        if (PlaybackState::PLAYING != m_playbackState.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        std::int64_t age{0};
+        if (!m_position.load(position, maxAge, age))
+        {
+            return false;
+        }
+        const double kPlaybackRate{m_playbackRate.load(std::memory_order_relaxed)};
+        position += static_cast<std::int64_t>(static_cast<double>(age) * kPlaybackRate);
+        return true;
+    }
+
+    /**
+     * @brief Gets the volume of the pipeline.
+     *
+     * @param[out] volume : The linear volume.
+     * @param[in]  maxAge : The maximum accepted age of the published volume.
+     *
+     * @retval false if the volume is not published or too old.
+     */
+    bool getVolume(double &volume, std::chrono::nanoseconds maxAge) const
+    {
+        std::int64_t age{0};
+        return m_volume.load(volume, maxAge, age);
+    }
+
+    /**
+     * @brief Gets the number of bytes queued in the app source of the player.
+     *
+     * @param[out] queuedBytes : The number of queued bytes.
+     * @param[in]  maxAge      : The maximum accepted age of the published value.
+     *
+     * @retval false if the value is not published or too old.
+     */
+    bool getQueuedBytes(std::uint64_t &queuedBytes, std::chrono::nanoseconds maxAge) const
+    {
+        std::int64_t age{0};
+        return m_queuedBytes.load(queuedBytes, maxAge, age);
+    }
+
+private:
+    /**
+     * @brief A value published together with its refresh time.
+     *
+     * The refresh time doubles as the sequence of a sequence lock, so a reader never pairs a value with the time of
+     * another refresh. Each value has a single writer; invalidation is allowed from any thread.
+     */
+    template <typename T> class TimedValue
+    {
+    public:
+        void store(T value)
+        {
+            m_timestamp.store(kInvalidTimestamp, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_value.store(value, std::memory_order_relaxed);
+            m_timestamp.store(now(), std::memory_order_release);
+        }
+
+        void invalidate() { m_timestamp.store(kInvalidTimestamp, std::memory_order_release); }
+
+        bool load(T &value, std::chrono::nanoseconds maxAge, std::int64_t &age) const
+        {
+            const std::int64_t kTimestamp{m_timestamp.load(std::memory_order_acquire)};
+            if (kInvalidTimestamp == kTimestamp)
+            {
+                return false;
+            }
+            const T kValue{m_value.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (kTimestamp != m_timestamp.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            age = now() - kTimestamp;
+            if (age > maxAge.count())
+            {
+                return false;
+            }
+            value = kValue;
+            return true;
+        }
+
+    private:
+        static constexpr std::int64_t kInvalidTimestamp{-1};
+
+        static std::int64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        std::atomic<T> m_value{};
+        std::atomic<std::int64_t> m_timestamp{kInvalidTimestamp};
+    };
+
+    /**
+     * @brief The position of the playback in nanoseconds.
+     */
+    TimedValue<std::int64_t> m_position;
+
+    /**
+     * @brief The generation of the position, increased by every invalidation of the position.
+     */
+    std::atomic<std::uint64_t> m_positionGeneration{0};
+
+    /**
+     * @brief The linear volume of the pipeline.
+     */
+    TimedValue<double> m_volume;
+
+    /**
+     * @brief The number of bytes queued in the app source.
+     */
+    TimedValue<std::uint64_t> m_queuedBytes;
+
+    /**
+     * @brief The playback rate.
+     */
+    std::atomic<double> m_playbackRate{1.0};
+
+    /**
+     * @brief The playback state.
+     */
+    std::atomic<PlaybackState> m_playbackState{PlaybackState::UNKNOWN};
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_PLAYER_SNAPSHOT_H_
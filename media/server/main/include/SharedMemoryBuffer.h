@@ -23,6 +23,7 @@
 #include "ISharedMemoryBuffer.h"
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace firebolt::rialto::server
@@ -57,6 +58,18 @@ public:
     std::uint8_t *getDataPtr(MediaPlaybackType playbackType, int id,
                              const MediaSourceType &mediaSourceType) const override;
 
+    bool resizeData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                    std::uint32_t dataLen) override;
+
+    std::uint32_t getNumOfSlots(MediaPlaybackType playbackType, int id) const override;
+    bool clearSlotData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                       std::uint32_t slot) const override;
+    std::uint32_t getSlotDataOffset(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                                    std::uint32_t slot) const override;
+    std::uint32_t getMaxSlotDataLen(MediaPlaybackType playbackType, int id,
+                                    const MediaSourceType &mediaSourceType) const override;
+    std::uint32_t getStatusPageOffset(MediaPlaybackType playbackType, int id) const override;
+
     int getFd() const override;
     std::uint32_t getSize() const override;
     std::uint8_t *getBuffer() const override;
@@ -66,15 +79,36 @@ public:
         int id;
         std::uint32_t dataBufferAudioLen;
         std::uint32_t dataBufferVideoLen;
+        std::uint32_t numOfSlots;
+        std::uint32_t audioCapacity;
+        std::uint32_t videoCapacity;
     };
 
 private:
+    // The helpers below expect m_mutex to be locked by the caller
+    std::uint32_t getDataOffsetUnlocked(MediaPlaybackType playbackType, int id,
+                                        const MediaSourceType &mediaSourceType) const;
+    std::uint32_t getMaxDataLenUnlocked(MediaPlaybackType playbackType, int id,
+                                        const MediaSourceType &mediaSourceType) const;
+    std::uint8_t *getDataPtrUnlocked(MediaPlaybackType playbackType, int id,
+                                     const MediaSourceType &mediaSourceType) const;
+    std::uint32_t getNumOfSlotsUnlocked(MediaPlaybackType playbackType, int id) const;
+    std::uint32_t getMaxSlotDataLenUnlocked(MediaPlaybackType playbackType, int id,
+                                            const MediaSourceType &mediaSourceType) const;
+    std::uint32_t getStatusPageOffsetUnlocked(MediaPlaybackType playbackType, int id) const;
     size_t calculateBufferSize() const;
+    size_t calculateDataSize() const;
     bool getDataPtrForPartition(MediaPlaybackType playbackType, int id, std::uint8_t **ptr) const;
     const std::vector<Partition> *getPlaybackTypePartition(MediaPlaybackType playbackType) const;
     std::vector<Partition> *getPlaybackTypePartition(MediaPlaybackType playbackType);
+    const Partition *findPartition(MediaPlaybackType playbackType, int id) const;
+    void releaseMemory(std::uint8_t *ptr, std::uint32_t len) const;
 
 private:
+    /**
+     * @brief Protects the partition tables. Sessions map, resize and query their partitions from different threads.
+     */
+    mutable std::mutex m_mutex;
     std::vector<Partition> m_genericPartitions;
     std::vector<Partition> m_webAudioPartitions;
     std::uint32_t m_dataBufferLen;
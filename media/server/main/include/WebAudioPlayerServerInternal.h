@@ -25,7 +25,9 @@
 #include "ITimer.h"
 #include "IWebAudioPlayer.h"
 #include "IWebAudioPlayerServerInternalFactory.h"
+#include "PlayerSnapshot.h"
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 #include <string>
@@ -45,7 +47,7 @@ public:
                                                           const std::string &audioMimeType, const uint32_t priority,
                                                           const WebAudioConfig *config) const override;
 
-    std::unique_ptr<IWebAudioPlayer>
+    std::unique_ptr<IWebAudioPlayerServerInternal>
     createWebAudioPlayerServerInternal(std::weak_ptr<IWebAudioPlayerClient> client, const std::string &audioMimeType,
                                        const uint32_t priority, const WebAudioConfig *config,
                                        const std::shared_ptr<ISharedMemoryBuffer> &shmBuffer, int handle) const override;
@@ -54,7 +56,7 @@ public:
 /**
  * @brief The definition of the WebAudioPlayerServerInternal.
  */
-class WebAudioPlayerServerInternal : public IWebAudioPlayer, public IGstWebAudioPlayerClient
+class WebAudioPlayerServerInternal : public IWebAudioPlayerServerInternal, public IGstWebAudioPlayerClient
 {
 public:
     /**
@@ -92,6 +94,8 @@ public:
 
     bool getBufferDelay(uint32_t &delayFrames) override;
 
+    bool getBufferDelayFromSnapshot(uint32_t &delayFrames) override;
+
     bool writeBuffer(const uint32_t numberOfFrames, void *data) override;
 
     bool getDeviceInfo(uint32_t &preferredFrames, uint32_t &maximumFrames, bool &supportDeferredPlay) override;
@@ -104,6 +108,8 @@ public:
 
     void notifyState(WebAudioPlayerState state) override;
 
+    void notifyBufferLevel(uint64_t queuedBytes) override;
+
 protected:
     /**
      * @brief The web audio player client.
@@ -185,6 +191,16 @@ protected:
      */
     bool m_isEosRequested;
 
+    /**
+     * @brief The number of frames queued in the shared memory, for the getters called outside of the main thread.
+     */
+    std::atomic<uint32_t> m_queuedFramesInShm;
+
+    /**
+     * @brief The player state cached for the read-only getters, refreshed by the gstreamer player worker thread.
+     */
+    PlayerSnapshot m_playerSnapshot;
+
     /**
      * @brief Initalises the WebAudioPlayer.
      *
@@ -246,6 +262,17 @@ protected:
      * @retval The number of frames queued.
      */
     uint32_t getQueuedFramesInShm();
+
+    /**
+     * @brief Calculates the delay of the buffered audio.
+     *
+     * @param[in]  queuedBytes       : The number of bytes queued in the gstreamer player.
+     * @param[in]  queuedFramesInShm : The number of frames queued in the shared memory.
+     * @param[out] delayFrames       : The delay in frames.
+     *
+     * @retval true on success.
+     */
+    bool calculateBufferDelay(uint64_t queuedBytes, uint32_t queuedFramesInShm, uint32_t &delayFrames) const;
 };
 
 }; // namespace firebolt::rialto::server
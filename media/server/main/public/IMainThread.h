@@ -21,6 +21,9 @@
 #define FIREBOLT_RIALTO_SERVER_I_MAIN_THREAD_H_
 
 #include "IMainThread.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -61,6 +64,18 @@ class IMainThread
 public:
     using Task = std::function<void()>;
 
+    /**
+     * @brief Metrics of the strand, that the tasks of a client are serialised on.
+     */
+    struct StrandMetrics
+    {
+        std::size_t queueDepth{0};                  /**< The number of tasks currently waiting in the queue. */
+        std::size_t maxQueueDepth{0};               /**< The highest number of tasks waiting in the queue. */
+        std::uint64_t executedTasks{0};             /**< The number of tasks started on the strand. */
+        std::chrono::microseconds totalWaitTime{0}; /**< The sum of the time tasks spent waiting in the queue. */
+        std::chrono::microseconds maxWaitTime{0};   /**< The longest time a task spent waiting in the queue. */
+    };
+
     IMainThread() = default;
     virtual ~IMainThread() = default;
 
@@ -73,6 +88,8 @@ public:
      * @brief Register a client on the main thread.
      *
      * Required by clients who want to enqueue tasks on the main thread.
+     * Tasks of a client are executed in order, one at a time, but can run in parallel with the tasks of other
+     * clients. A client registered from within a task shares the strand of the client running that task.
      *
      * @retval The registered client id.
      */
@@ -99,10 +116,22 @@ public:
     /**
      * @brief Enqueue a task on the main thread and wait for it to finish before returning.
      *
+     * When called from a task running on the strand of the client, the task is executed immediately.
+     *
      * @param[in]  clientId : The id of the registered client.
      * @param[in]  task     : Task to queue.
      */
     virtual void enqueueTaskAndWait(uint32_t clientId, Task task) = 0;
+
+    /**
+     * @brief Gets the metrics of the strand, that the tasks of the client are executed on.
+     *
+     * @param[in]  clientId : The id of the registered client.
+     * @param[out] metrics  : The metrics of the strand.
+     *
+     * @retval true on success, false if the client is not registered.
+     */
+    virtual bool getStrandMetrics(uint32_t clientId, StrandMetrics &metrics) const = 0;
 };
 } // namespace firebolt::rialto::server
 
@@ -123,6 +123,8 @@ public:
     /**
      * @brief Decrements number of buffers using keySessionId
      *
+     * Returns without waiting for the counter to be updated.
+     *
      * @param[in] keySessionId    : The session id for the session.
      *
      */
@@ -97,6 +97,28 @@ public:
      * @param[in] needDataRequestId : Need data request id
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId) = 0;
+
+    /**
+     * @brief Gets the position from the player snapshot, without waiting for the main thread.
+     *
+     * Can be called from any thread.
+     *
+     * @param[out] position : The playback position in nanoseconds.
+     *
+     * @retval true if the snapshot is fresh, false if the position has to be read with getPosition().
+     */
+    virtual bool getPositionFromSnapshot(int64_t &position) = 0;
+
+    /**
+     * @brief Gets the volume from the player snapshot, without waiting for the main thread.
+     *
+     * Can be called from any thread.
+     *
+     * @param[out] volume : The current volume level (0.0 - 1.0)
+     *
+     * @retval true if the snapshot is fresh, false if the volume has to be read with getVolume().
+     */
+    virtual bool getVolumeFromSnapshot(double &volume) = 0;
 };
 
 }; // namespace firebolt::rialto::server
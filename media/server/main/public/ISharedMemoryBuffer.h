@@ -126,6 +126,82 @@ public:
     virtual std::uint8_t *getDataPtr(MediaPlaybackType playbackType, int id,
                                      const MediaSourceType &mediaSourceType) const = 0;
 
+    /**
+     * @brief Resizes the specified data partition, within the capacity reserved for it.
+     *
+     * Memory that is no longer used after shrinking the partition is released back to the kernel.
+     * The shared memory file descriptor and its size remain unchanged.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     * @param[in] mediaSourceType   : The type of media source partition.
+     * @param[in] dataLen           : The requested length of the data partition.
+     *
+     * @retval true on success.
+     */
+    virtual bool resizeData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                            std::uint32_t dataLen) = 0;
+
+    /**
+     * @brief Gets the number of ring slots, that each media source region of the partition is divided into.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     *
+     * @retval the number of slots, 0 if the partition could not be found.
+     */
+    virtual std::uint32_t getNumOfSlots(MediaPlaybackType playbackType, int id) const = 0;
+
+    /**
+     * @brief Clears the data in the specified ring slot of the partition.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     * @param[in] mediaSourceType   : The type of media source partition.
+     * @param[in] slot              : The index of the ring slot.
+     *
+     * @retval true on success.
+     */
+    virtual bool clearSlotData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                               std::uint32_t slot) const = 0;
+
+    /**
+     * @brief Gets the offset of the specified ring slot of the partition.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     * @param[in] mediaSourceType   : The type of media source partition.
+     * @param[in] slot              : The index of the ring slot.
+     *
+     * @retval the offset of the slot. Throws std::runtime_error on failure.
+     */
+    virtual std::uint32_t getSlotDataOffset(MediaPlaybackType playbackType, int id,
+                                            const MediaSourceType &mediaSourceType, std::uint32_t slot) const = 0;
+
+    /**
+     * @brief Gets the maximum length of a single ring slot of the partition.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     * @param[in] mediaSourceType   : The type of media source partition.
+     *
+     * @retval the length of the slot, 0 on failure.
+     */
+    virtual std::uint32_t getMaxSlotDataLen(MediaPlaybackType playbackType, int id,
+                                            const MediaSourceType &mediaSourceType) const = 0;
+
+    /**
+     * @brief Gets the offset of the playback status page of the partition.
+     *
+     * The status page is published by the server and read by the client without an ipc round trip.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     *
+     * @retval the offset of the status page. Throws std::runtime_error on failure.
+     */
+    virtual std::uint32_t getStatusPageOffset(MediaPlaybackType playbackType, int id) const = 0;
+
     /**
      * @brief Gets file descriptor of the shared memory.
      *
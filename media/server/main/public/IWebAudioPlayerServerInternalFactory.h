@@ -41,6 +41,8 @@
 
 namespace firebolt::rialto::server
 {
+class IWebAudioPlayerServerInternal;
+
 /**
  * @brief IWebAudioPlayer factory class, returns a concrete implementation of IWebAudioPlayer for internal server use
  */
@@ -69,11 +71,32 @@ public:
      *
      * @retval the new backend instance or null on error.
      */
-    virtual std::unique_ptr<IWebAudioPlayer>
+    virtual std::unique_ptr<IWebAudioPlayerServerInternal>
     createWebAudioPlayerServerInternal(std::weak_ptr<IWebAudioPlayerClient> client, const std::string &audioMimeType,
                                        const uint32_t priority, const WebAudioConfig *config,
                                        const std::shared_ptr<ISharedMemoryBuffer> &shmBuffer, int handle) const = 0;
 };
+
+/**
+ * @brief The definition of the IWebAudioPlayerServerInternal interface.
+ *
+ * This interface defines the internal server APIs for playback of web audio which
+ * should be implemented by Rialto Server only.
+ */
+class IWebAudioPlayerServerInternal : public IWebAudioPlayer
+{
+public:
+    /**
+     * @brief Gets the buffer delay from the player snapshot, without waiting for the main thread.
+     *
+     * Can be called from any thread.
+     *
+     * @param[out] delayFrames : The number of frames queued for playback.
+     *
+     * @retval true if the snapshot is fresh, false if the delay has to be read with getBufferDelay().
+     */
+    virtual bool getBufferDelayFromSnapshot(uint32_t &delayFrames) = 0;
+};
 }; // namespace firebolt::rialto::server
 
 #endif // FIREBOLT_RIALTO_SERVER_I_WEB_AUDIO_PLAYER_SERVER_INTERNAL_FACTORY_H_
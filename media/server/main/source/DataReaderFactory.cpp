@@ -20,6 +20,8 @@
 #include "DataReaderFactory.h"
 #include "DataReaderV1.h"
 #include "DataReaderV2.h"
+#include "DataReaderV3.h"
+#include "RialtoServerLogging.h"
 #include "ShmCommon.h"
 #include "ShmUtils.h"
 
@@ -36,6 +38,7 @@ namespace firebolt::rialto::server
 {
 std::shared_ptr<IDataReader> DataReaderFactory::createDataReader(const MediaSourceType &mediaSourceType,
                                                                  std::uint8_t *buffer, std::uint32_t dataOffset,
+                                                                 std::uint32_t maxDataLen,
                                                                  std::uint32_t numFrames) const
 {
     // Version is always first 4 bytes of data
@@ -51,6 +54,17 @@ std::shared_ptr<IDataReader> DataReaderFactory::createDataReader(const MediaSour
         std::uint32_t v2DataOffset = dataOffset + getMaxMetadataBytes();
         return std::make_shared<DataReaderV2>(mediaSourceType, buffer, v2DataOffset, numFrames);
     }
+    if (3 == version)
+    {
+        if (maxDataLen < getMaxMetadataBytes())
+        {
+            RIALTO_SERVER_LOG_ERROR("Shm slot of %u bytes is too small for metadata v3", maxDataLen);
+            return nullptr;
+        }
+        std::uint32_t v3DataOffset = dataOffset + getMaxMetadataBytes();
+        return std::make_shared<DataReaderV3>(mediaSourceType, buffer, v3DataOffset, maxDataLen - getMaxMetadataBytes(),
+                                              numFrames);
+    }
     return nullptr;
 }
 } // namespace firebolt::rialto::server
@@ -0,0 +1,184 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataReaderV3.h"
+#include "RialtoServerLogging.h"
+#include "ShmCommon.h"
+#include <algorithm>
+
+namespace
+{
+std::uint8_t readUint8(const std::uint8_t *&position)
+{
+    return *position++;
+}
+
+std::uint32_t readLEUint32(const std::uint8_t *&position)
+{
+    std::uint32_t value = static_cast<std::uint32_t>(position[3]) << 24 |
+                          static_cast<std::uint32_t>(position[2]) << 16 |
+                          static_cast<std::uint32_t>(position[1]) << 8 | static_cast<std::uint32_t>(position[0]);
+    position += sizeof(std::uint32_t);
+    return value;
+}
+
+std::int64_t readLEInt64(const std::uint8_t *&position)
+{
+    std::uint64_t value{0};
+    for (int i = sizeof(std::uint64_t) - 1; i >= 0; --i)
+    {
+        value = (value << 8) | position[i];
+    }
+    position += sizeof(std::uint64_t);
+    return static_cast<std::int64_t>(value);
+}
+
+firebolt::rialto::SegmentAlignment convertSegmentAlignment(std::uint8_t segmentAlignment)
+{
+    switch (segmentAlignment)
+    {
+    case 1:
+    {
+        return firebolt::rialto::SegmentAlignment::NAL;
+    }
+    case 2:
+    {
+        return firebolt::rialto::SegmentAlignment::AU;
+    }
+    default:
+    {
+        return firebolt::rialto::SegmentAlignment::UNDEFINED;
+    }
+    }
+}
+} // namespace
+
+namespace firebolt::rialto::server
+{
+DataReaderV3::DataReaderV3(const MediaSourceType &mediaSourceType, std::uint8_t *buffer, std::uint32_t dataOffset,
+                           std::uint32_t maxDataLen, std::uint32_t numFrames)
+    : m_mediaSourceType{mediaSourceType}, m_buffer{buffer}, m_dataOffset{dataOffset}, m_maxDataLen{maxDataLen},
+      m_numFrames{numFrames}
+{
+    RIALTO_SERVER_LOG_DEBUG("Detected Metadata in Version 3.");
+}
+
+IMediaPipeline::MediaSegmentVector DataReaderV3::readData() const
+{
+    IMediaPipeline::MediaSegmentVector mediaSegments;
+    // Frame count comes from the client, so it is not trusted more than the size of the slot
+    mediaSegments.reserve(std::min(m_numFrames, m_maxDataLen / common::METADATA_V3_FIXED_HEADER_SIZE_BYTES));
+    const std::uint8_t *currentReadPosition{m_buffer + m_dataOffset};
+    const std::uint8_t *const kEndPosition{m_buffer + m_dataOffset + m_maxDataLen};
+    std::int64_t timeStamp{0};
+    for (auto i = 0U; i < m_numFrames; ++i)
+    {
+        const std::uint64_t kBytesLeft{static_cast<std::uint64_t>(kEndPosition - currentReadPosition)};
+        if (kBytesLeft < common::METADATA_V3_FIXED_HEADER_SIZE_BYTES)
+        {
+            RIALTO_SERVER_LOG_ERROR("Metadata parsing failed - frame %u header exceeds the shm slot!", i);
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+        const std::uint32_t kHeaderSize{readLEUint32(currentReadPosition)};
+        const std::uint32_t kDataLength{readLEUint32(currentReadPosition)};
+        const std::int32_t kStreamId{static_cast<std::int32_t>(readLEUint32(currentReadPosition))};
+        const std::uint8_t kFlags{readUint8(currentReadPosition)};
+        const std::uint8_t kSegmentAlignment{readUint8(currentReadPosition)};
+        const std::uint8_t kKeyIdLength{readUint8(currentReadPosition)};
+        const std::uint8_t kInitVectorLength{readUint8(currentReadPosition)};
+        const std::uint32_t kExtraDataLength{readLEUint32(currentReadPosition)};
+        const std::uint32_t kSubSampleCount{readLEUint32(currentReadPosition)};
+        timeStamp += readLEInt64(currentReadPosition);
+        const std::int64_t kDuration{readLEInt64(currentReadPosition)};
+        const std::int32_t kParam1{static_cast<std::int32_t>(readLEUint32(currentReadPosition))};
+        const std::int32_t kParam2{static_cast<std::int32_t>(readLEUint32(currentReadPosition))};
+        const std::int32_t kMediaKeySessionId{static_cast<std::int32_t>(readLEUint32(currentReadPosition))};
+        const std::uint32_t kInitWithLast15{readLEUint32(currentReadPosition)};
+
+        const std::uint64_t kExpectedHeaderSize{common::METADATA_V3_FIXED_HEADER_SIZE_BYTES + kKeyIdLength +
+                                                kInitVectorLength + static_cast<std::uint64_t>(kExtraDataLength) +
+                                                static_cast<std::uint64_t>(kSubSampleCount) *
+                                                    common::METADATA_V3_SUBSAMPLE_SIZE_BYTES};
+        if (kHeaderSize != kExpectedHeaderSize)
+        {
+            RIALTO_SERVER_LOG_ERROR("Metadata parsing failed - inconsistent header size!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+        // Key id, init vector, extra data and subsample table are covered by the header size
+        if (kExpectedHeaderSize + kDataLength > kBytesLeft)
+        {
+            RIALTO_SERVER_LOG_ERROR("Metadata parsing failed - frame %u exceeds the shm slot!", i);
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+
+        std::unique_ptr<IMediaPipeline::MediaSegment> newSegment;
+        if (MediaSourceType::AUDIO == m_mediaSourceType && (kFlags & common::METADATA_V3_FLAG_AUDIO_PARAMS))
+        {
+            newSegment = std::make_unique<IMediaPipeline::MediaSegmentAudio>(kStreamId, timeStamp, kDuration, kParam1,
+                                                                             kParam2);
+        }
+        else if (MediaSourceType::VIDEO == m_mediaSourceType && (kFlags & common::METADATA_V3_FLAG_VIDEO_PARAMS))
+        {
+            newSegment = std::make_unique<IMediaPipeline::MediaSegmentVideo>(kStreamId, timeStamp, kDuration, kParam1,
+                                                                             kParam2);
+        }
+        else
+        {
+            RIALTO_SERVER_LOG_ERROR("Segment parsing failed - type specific metadata not present!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+
+        newSegment->setSegmentAlignment(convertSegmentAlignment(kSegmentAlignment));
+        const bool kIsEncrypted{static_cast<bool>(kFlags & common::METADATA_V3_FLAG_ENCRYPTED)};
+        newSegment->setEncrypted(kIsEncrypted);
+        if (kIsEncrypted)
+        {
+            newSegment->setMediaKeySessionId(kMediaKeySessionId);
+            newSegment->setInitWithLast15(kInitWithLast15);
+        }
+        if (kKeyIdLength)
+        {
+            newSegment->setKeyId(std::vector<uint8_t>(currentReadPosition, currentReadPosition + kKeyIdLength));
+            currentReadPosition += kKeyIdLength;
+        }
+        if (kInitVectorLength)
+        {
+            newSegment->setInitVector(
+                std::vector<uint8_t>(currentReadPosition, currentReadPosition + kInitVectorLength));
+            currentReadPosition += kInitVectorLength;
+        }
+        if (kExtraDataLength)
+        {
+            newSegment->setExtraData(std::vector<uint8_t>(currentReadPosition, currentReadPosition + kExtraDataLength));
+            currentReadPosition += kExtraDataLength;
+        }
+        for (auto j = 0U; j < kSubSampleCount; ++j)
+        {
+            const std::uint32_t kNumClearBytes{readLEUint32(currentReadPosition)};
+            const std::uint32_t kNumEncryptedBytes{readLEUint32(currentReadPosition)};
+            newSegment->addSubSample(kNumClearBytes, kNumEncryptedBytes);
+        }
+
+        newSegment->setData(kDataLength, currentReadPosition);
+        currentReadPosition += kDataLength;
+        mediaSegments.emplace_back(std::move(newSegment));
+    }
+    return mediaSegments;
+}
+} // namespace firebolt::rialto::server
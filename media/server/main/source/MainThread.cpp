@@ -19,13 +19,46 @@
 
 #include "MainThread.h"
 #include "RialtoServerLogging.h"
+#include <algorithm>
+#include <cstdlib>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace firebolt::rialto::server
 {
+namespace
+{
+constexpr std::size_t kMinNumOfWorkerThreads{1};
+constexpr std::size_t kMaxNumOfWorkerThreads{16};
+constexpr std::size_t kMinDefaultNumOfWorkers{2};
+constexpr std::size_t kMaxDefaultNumOfWorkers{4};
+const char *kNumOfWorkerThreadsEnvVariableName{"RIALTO_MAIN_THREAD_POOL_SIZE"};
+
+std::size_t getNumOfWorkerThreads()
+{
+    // By default, use a small pool, that lets a few sessions progress in parallel
+    std::size_t numOfWorkerThreads{
+        std::min(std::max<std::size_t>(std::thread::hardware_concurrency(), kMinDefaultNumOfWorkers),
+                 kMaxDefaultNumOfWorkers)};
+    const char *envVar = getenv(kNumOfWorkerThreadsEnvVariableName);
+    if (envVar)
+    {
+        try
+        {
+            numOfWorkerThreads = std::stoul(std::string{envVar});
+        }
+        catch (std::exception &e)
+        {
+            RIALTO_SERVER_LOG_WARN("Invalid value of %s: %s", kNumOfWorkerThreadsEnvVariableName, envVar);
+        }
+    }
+    return std::min(std::max(numOfWorkerThreads, kMinNumOfWorkerThreads), kMaxNumOfWorkerThreads);
+}
+} // namespace
+
 std::weak_ptr<IMainThread> MainThreadFactory::m_mainThread;
+thread_local std::shared_ptr<MainThread::Strand> MainThread::m_currentStrand;
 
 std::shared_ptr<IMainThreadFactory> IMainThreadFactory::createFactory()
 {
@@ -62,67 +95,145 @@ std::shared_ptr<IMainThread> MainThreadFactory::getMainThread() const
     return mainThread;
 }
 
-MainThread::MainThread() : m_isMainThreadRunning{true}, m_mainThreadClientId{0}, m_nextClientId{1}
+MainThread::MainThread() : MainThread(getNumOfWorkerThreads()) {}
+
+MainThread::MainThread(std::size_t numOfWorkerThreads)
+    : m_isMainThreadRunning{true}, m_mainThreadClientId{0}, m_nextClientId{1}
 {
-    RIALTO_SERVER_LOG_DEBUG("MainThread is constructed");
-    m_thread = std::thread(std::bind(&MainThread::mainThreadLoop, this));
+    RIALTO_SERVER_LOG_DEBUG("MainThread is constructed with %zu worker threads", numOfWorkerThreads);
 
     // Register itself
-    m_registeredClients.insert(m_mainThreadClientId);
+    std::shared_ptr<Strand> strand = std::make_shared<Strand>();
+    strand->owner = this;
+    strand->numOfClients = 1;
+    m_registeredClients.emplace(m_mainThreadClientId, strand);
+
+    for (std::size_t i = 0; i < std::max(numOfWorkerThreads, std::size_t{1}); ++i)
+    {
+        m_workerThreads.emplace_back(&MainThread::workerThreadLoop, this);
+    }
 }
 
 MainThread::~MainThread()
 {
     RIALTO_SERVER_LOG_DEBUG("MainThread is destructed");
-    auto shutdownTask = [this]() { m_isMainThreadRunning = false; };
-    enqueueTask(m_mainThreadClientId, shutdownTask);
-    m_thread.join();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isMainThreadRunning = false;
+    }
+    m_readyQueueCv.notify_all();
+    for (auto &thread : m_workerThreads)
+    {
+        thread.join();
+    }
 }
 
-void MainThread::mainThreadLoop()
+void MainThread::workerThreadLoop()
 {
-    while (m_isMainThreadRunning)
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
     {
-        const std::shared_ptr<TaskInfo> taskInfo = waitForTask();
-        if (m_registeredClients.find(taskInfo->clientId) != m_registeredClients.end())
+        // Strands that are already scheduled are drained, before the worker threads are stopped
+        m_readyQueueCv.wait(lock, [this] { return !m_readyQueue.empty() || !m_isMainThreadRunning; });
+        if (m_readyQueue.empty())
+        {
+            break;
+        }
+
+        std::shared_ptr<Strand> strand = m_readyQueue.front();
+        m_readyQueue.pop();
+        TaskInfo taskInfo;
+        static_cast<void>(strand->taskQueue.tryPop(taskInfo));
+
+        const auto kWaitTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                     taskInfo.enqueueTime);
+        strand->metrics.queueDepth = strand->taskQueue.getSize();
+        strand->metrics.totalWaitTime += kWaitTime;
+        strand->metrics.maxWaitTime = std::max(strand->metrics.maxWaitTime, kWaitTime);
+
+        auto clientIt = m_registeredClients.find(taskInfo.clientId);
+        const bool kIsClientRegistered{clientIt != m_registeredClients.end() && clientIt->second == strand};
+        if (kIsClientRegistered)
+        {
+            ++strand->metrics.executedTasks;
+        }
+        lock.unlock();
+
+        if (kIsClientRegistered)
         {
-            taskInfo->task();
+            m_currentStrand = strand;
+            taskInfo.task();
+            m_currentStrand.reset();
         }
         else
         {
-            RIALTO_SERVER_LOG_WARN("Task ignored, client '%d' not registered", taskInfo->clientId);
+            RIALTO_SERVER_LOG_WARN("Task ignored, client '%u' not registered", taskInfo.clientId);
+        }
+        if (taskInfo.completion)
+        {
+            taskInfo.completion->setDone();
         }
 
-        if (nullptr != taskInfo->cv)
+        // The task may hold the last reference to objects, that use the main thread in their destructors
+        taskInfo.task = nullptr;
+
+        lock.lock();
+        if (strand->taskQueue.isEmpty())
         {
-            std::unique_lock<std::mutex> lockTask(*(taskInfo->mutex));
-            taskInfo->cv->notify_one();
+            strand->isScheduled = false;
+        }
+        else
+        {
+            m_readyQueue.push(strand);
+            m_readyQueueCv.notify_one();
         }
     }
 }
 
-const std::shared_ptr<MainThread::TaskInfo> MainThread::waitForTask()
+bool MainThread::pushTask(TaskInfo &&taskInfo)
 {
-    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-    if (m_taskQueue.empty())
     {
-        m_taskQueueCv.wait(lock, [this] { return !m_taskQueue.empty(); });
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto clientIt = m_registeredClients.find(taskInfo.clientId);
+        if (clientIt == m_registeredClients.end())
+        {
+            lock.unlock();
+            RIALTO_SERVER_LOG_WARN("Task ignored, client '%u' not registered", taskInfo.clientId);
+            return false;
+        }
+
+        std::shared_ptr<Strand> &strand = clientIt->second;
+        taskInfo.enqueueTime = std::chrono::steady_clock::now();
+        strand->taskQueue.push(std::move(taskInfo));
+        strand->metrics.queueDepth = strand->taskQueue.getSize();
+        strand->metrics.maxQueueDepth = std::max(strand->metrics.maxQueueDepth, strand->metrics.queueDepth);
+        if (strand->isScheduled)
+        {
+            return true;
+        }
+        strand->isScheduled = true;
+        m_readyQueue.push(strand);
     }
-    const std::shared_ptr<TaskInfo> taskInfo = m_taskQueue.front();
-    m_taskQueue.pop();
-    return taskInfo;
+    m_readyQueueCv.notify_one();
+    return true;
 }
 
 int32_t MainThread::registerClient()
 {
     uint32_t clientId = m_nextClientId++;
 
-    auto task = [&, clientId]()
+    // Clients registered by a task, e.g. the key sessions of media keys, share its strand
+    std::shared_ptr<Strand> strand = m_currentStrand;
+    if (!strand || strand->owner != this)
     {
-        RIALTO_SERVER_LOG_INFO("Registering client '%u'", clientId);
-        m_registeredClients.insert(clientId);
-    };
-    enqueueTask(m_mainThreadClientId, task);
+        strand = std::make_shared<Strand>();
+        strand->owner = this;
+    }
+
+    RIALTO_SERVER_LOG_INFO("Registering client '%u'", clientId);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++strand->numOfClients;
+    m_registeredClients.emplace(clientId, strand);
 
     return clientId;
 }
@@ -130,39 +241,73 @@ int32_t MainThread::registerClient()
 void MainThread::unregisterClient(uint32_t clientId)
 {
     RIALTO_SERVER_LOG_INFO("Unregistering client '%u'", clientId);
-    m_registeredClients.erase(clientId);
+    StrandMetrics metrics;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto clientIt = m_registeredClients.find(clientId);
+        if (clientIt == m_registeredClients.end())
+        {
+            return;
+        }
+        std::shared_ptr<Strand> strand = clientIt->second;
+        m_registeredClients.erase(clientIt);
+        if (--strand->numOfClients > 0)
+        {
+            return;
+        }
+        metrics = strand->metrics;
+    }
+
+    const long long kAverageWaitTime{
+        metrics.executedTasks > 0 ? static_cast<long long>(metrics.totalWaitTime.count() / metrics.executedTasks) : 0};
+    RIALTO_SERVER_LOG_INFO("Strand of client '%u' released, executed tasks: %llu, max queue depth: %zu, average wait "
+                           "time: %lldus, max wait time: %lldus",
+                           clientId, static_cast<unsigned long long>(metrics.executedTasks), metrics.maxQueueDepth,
+                           kAverageWaitTime, static_cast<long long>(metrics.maxWaitTime.count()));
 }
 
 void MainThread::enqueueTask(uint32_t clientId, Task task)
 {
-    std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
-    newTask->clientId = clientId;
-    newTask->task = task;
-    {
-        std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-        m_taskQueue.push(newTask);
-    }
-    m_taskQueueCv.notify_one();
+    static_cast<void>(pushTask(TaskInfo{clientId, std::move(task), {}, nullptr}));
 }
 
 void MainThread::enqueueTaskAndWait(uint32_t clientId, Task task)
 {
-    std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
-    newTask->clientId = clientId;
-    newTask->task = task;
-    newTask->mutex = std::make_unique<std::mutex>();
-    newTask->cv = std::make_unique<std::condition_variable>();
+    if (isRunningOnStrandOf(clientId))
+    {
+        // Waiting for a task queued behind the running one would deadlock the strand, execute it in place instead
+        task();
+        return;
+    }
 
+    common::CompletionLatch completion;
+    if (pushTask(TaskInfo{clientId, std::move(task), {}, &completion}))
     {
-        std::unique_lock<std::mutex> lockTask(*(newTask->mutex));
-        {
-            std::unique_lock<std::mutex> lockQueue(m_taskQueueMutex);
-            m_taskQueue.push(newTask);
-        }
-        m_taskQueueCv.notify_one();
+        completion.wait();
+    }
+}
 
-        newTask->cv->wait(lockTask);
+bool MainThread::isRunningOnStrandOf(uint32_t clientId) const
+{
+    if (!m_currentStrand)
+    {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto clientIt = m_registeredClients.find(clientId);
+    return clientIt != m_registeredClients.end() && clientIt->second == m_currentStrand;
+}
+
+bool MainThread::getStrandMetrics(uint32_t clientId, StrandMetrics &metrics) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto clientIt = m_registeredClients.find(clientId);
+    if (clientIt == m_registeredClients.end())
+    {
+        return false;
     }
+    metrics = clientIt->second->metrics;
+    return true;
 }
 
 } // namespace firebolt::rialto::server
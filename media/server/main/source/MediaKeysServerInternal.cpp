@@ -17,7 +17,11 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <utility>
 
 #include "MediaKeysServerInternal.h"
 #include "RialtoServerLogging.h"
@@ -34,7 +38,8 @@ namespace firebolt::rialto::server
 {
 int32_t generateSessionId()
 {
-    static int32_t keySessionId{0};
+    // Media keys run on separate strands of the main thread, so ids can be generated concurrently
+    static std::atomic<int32_t> keySessionId{0};
     return keySessionId++;
 }
 
@@ -124,6 +129,12 @@ MediaKeysServerInternal::~MediaKeysServerInternal()
 
     auto task = [&]()
     {
+        std::atomic_store(&m_mediaKeySessionsSnapshot, {});
+        for (auto &session : m_mediaKeySessions)
+        {
+            std::lock_guard<std::mutex> lock{session.second.guard->mutex};
+            session.second.guard->isClosed = true;
+        }
         m_ocdmSystem.reset();
 
         m_mainThread->unregisterClient(m_mainThreadClientId);
@@ -152,6 +163,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::selectKeyIdInternal(int32_t keySess
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->selectKeyId(keyId);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -182,6 +194,7 @@ bool MediaKeysServerInternal::containsKeyInternal(int32_t keySessionId, const st
         return false;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     return sessionIter->second.mediaKeySession->containsKey(keyId);
 }
 
@@ -213,6 +226,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::createKeySessionInternal(KeySession
     }
     keySessionId = keySessionIdTemp;
     m_mediaKeySessions.emplace(std::make_pair(keySessionId, MediaKeySessionUsage{std::move(mediaKeySession)}));
+    updateMediaKeySessionsSnapshot();
 
     return MediaKeyErrorStatus::OK;
 }
@@ -239,6 +253,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::generateRequestInternal(int32_t key
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->generateRequest(initDataType, initData);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -268,6 +283,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::loadSessionInternal(int32_t keySess
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->loadSession();
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -298,6 +314,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::updateSessionInternal(int32_t keySe
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->updateSession(responseData);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -328,6 +345,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::setDrmHeaderInternal(int32_t keySes
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->setDrmHeader(requestData);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -358,21 +376,17 @@ MediaKeyErrorStatus MediaKeysServerInternal::closeKeySessionInternal(int32_t key
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
-    if (sessionIter->second.bufCounter == 0)
     {
-        MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->closeKeySession();
-        if (MediaKeyErrorStatus::OK != status)
+        std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
+        if (sessionIter->second.guard->bufCounter != 0)
         {
-            RIALTO_SERVER_LOG_ERROR("Failed to close the key session %d", keySessionId);
-            return status;
+            RIALTO_SERVER_LOG_INFO("Deferring closing of key session %d", keySessionId);
+            sessionIter->second.guard->shouldBeDestroyed = true;
+            return MediaKeyErrorStatus::OK;
         }
-        m_mediaKeySessions.erase(sessionIter);
-        return status;
     }
 
-    RIALTO_SERVER_LOG_INFO("Deferring closing of key session %d", keySessionId);
-    sessionIter->second.shouldBeDestroyed = true;
-    return MediaKeyErrorStatus::OK;
+    return closeMediaKeySession(sessionIter);
 }
 
 MediaKeyErrorStatus MediaKeysServerInternal::removeKeySession(int32_t keySessionId)
@@ -395,6 +409,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::removeKeySessionInternal(int32_t ke
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->removeKeySession();
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -481,6 +496,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::getLastDrmErrorInternal(int32_t key
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->getLastDrmError(errorCode);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -519,6 +535,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::getCdmKeySessionIdInternal(int32_t
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
     MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->getCdmKeySessionId(cdmKeySessionId);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -535,27 +552,24 @@ MediaKeyErrorStatus MediaKeysServerInternal::decrypt(int32_t keySessionId, GstBu
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status;
-    auto task = [&]()
-    { status = decryptInternal(keySessionId, encrypted, subSample, subSampleCount, IV, keyId, initWithLast15); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return status;
-}
-
-MediaKeyErrorStatus MediaKeysServerInternal::decryptInternal(int32_t keySessionId, GstBuffer *encrypted,
-                                                             GstBuffer *subSample, const uint32_t subSampleCount,
-                                                             GstBuffer *IV, GstBuffer *keyId, uint32_t initWithLast15)
-{
-    auto sessionIter = m_mediaKeySessions.find(keySessionId);
-    if (sessionIter == m_mediaKeySessions.end())
+    // Decryption is called for every encrypted sample from the streaming threads, so it does not wait for the main
+    // thread. Closing of the session is deferred by the usage counter, until the buffers using it are released, and
+    // the session guard keeps the main thread from using the session while it decrypts.
+    SharedMediaKeySession session = findMediaKeySession(keySessionId);
+    if (!session.mediaKeySession)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to find the session %d", keySessionId);
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::lock_guard<std::mutex> lock{session.guard->mutex};
+    if (session.guard->isClosed)
+    {
+        RIALTO_SERVER_LOG_ERROR("The session %d has been closed", keySessionId);
+        return MediaKeyErrorStatus::BAD_SESSION_ID;
+    }
     MediaKeyErrorStatus status =
-        sessionIter->second.mediaKeySession->decrypt(encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
+        session.mediaKeySession->decrypt(encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
     if (MediaKeyErrorStatus::OK != status)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to decrypt buffer.");
@@ -569,86 +583,136 @@ bool MediaKeysServerInternal::hasSession(int32_t keySessionId) const
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    bool result;
-    auto task = [&]() { result = m_mediaKeySessions.find(keySessionId) != m_mediaKeySessions.end(); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return result;
+    return nullptr != findMediaKeySession(keySessionId).mediaKeySession;
 }
 
 bool MediaKeysServerInternal::isNetflixKeySystem(int32_t keySessionId) const
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    bool result;
-    auto task = [&]() { result = isNetflixKeySystemInternal(keySessionId); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return result;
-}
 
-bool MediaKeysServerInternal::isNetflixKeySystemInternal(int32_t keySessionId) const
-{
-    auto sessionIter = m_mediaKeySessions.find(keySessionId);
-    if (sessionIter == m_mediaKeySessions.end())
+    // Only reads the key system of the session, so it does not need the session guard
+    std::shared_ptr<IMediaKeySession> mediaKeySession = findMediaKeySession(keySessionId).mediaKeySession;
+    if (!mediaKeySession)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to find the session %d", keySessionId);
         return false;
     }
-    return sessionIter->second.mediaKeySession->isNetflixKeySystem();
+    return mediaKeySession->isNetflixKeySystem();
 }
 
-void MediaKeysServerInternal::incrementSessionIdUsageCounter(int32_t keySessionId)
+void MediaKeysServerInternal::updateMediaKeySessionsSnapshot()
 {
-    RIALTO_SERVER_LOG_DEBUG("entry:");
-    auto task = [&]() { incrementSessionIdUsageCounterInternal(keySessionId); };
+    auto snapshot = std::make_shared<std::map<int32_t, SharedMediaKeySession>>();
+    for (const auto &session : m_mediaKeySessions)
+    {
+        snapshot->emplace(session.first, SharedMediaKeySession{session.second.mediaKeySession, session.second.guard});
+    }
+    std::atomic_store(&m_mediaKeySessionsSnapshot,
+                      std::shared_ptr<const std::map<int32_t, SharedMediaKeySession>>{std::move(snapshot)});
+}
 
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
+MediaKeysServerInternal::SharedMediaKeySession MediaKeysServerInternal::findMediaKeySession(int32_t keySessionId) const
+{
+    auto snapshot = std::atomic_load(&m_mediaKeySessionsSnapshot);
+    if (!snapshot)
+    {
+        return {};
+    }
+    auto sessionIter = snapshot->find(keySessionId);
+    if (sessionIter == snapshot->end())
+    {
+        return {};
+    }
+    return sessionIter->second;
 }
 
-void MediaKeysServerInternal::incrementSessionIdUsageCounterInternal(int32_t keySessionId)
+void MediaKeysServerInternal::incrementSessionIdUsageCounter(int32_t keySessionId)
 {
-    auto sessionIter = m_mediaKeySessions.find(keySessionId);
-    if (sessionIter == m_mediaKeySessions.end())
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    // Called for every buffer from the streaming threads, so the counter is kept under the session guard rather than
+    // on the main thread
+    SharedMediaKeySession session = findMediaKeySession(keySessionId);
+    if (!session.mediaKeySession)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to find the session %d", keySessionId);
         return;
     }
 
-    sessionIter->second.bufCounter++;
+    std::lock_guard<std::mutex> lock{session.guard->mutex};
+    session.guard->bufCounter++;
 }
 
 void MediaKeysServerInternal::decrementSessionIdUsageCounter(int32_t keySessionId)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    auto task = [&]() { decrementSessionIdUsageCounterInternal(keySessionId); };
+
+    SharedMediaKeySession session = findMediaKeySession(keySessionId);
+    if (!session.mediaKeySession)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to find the session %d", keySessionId);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{session.guard->mutex};
+        if (session.guard->bufCounter > 0)
+        {
+            session.guard->bufCounter--;
+        }
+
+        if (session.guard->bufCounter != 0 || !session.guard->shouldBeDestroyed)
+        {
+            return;
+        }
+    }
+
+    // The deferred close is waited for, so it has finished by the time the buffer is released
+    auto task = [&]() { closeDeferredMediaKeySession(keySessionId); };
 
     m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
 }
 
-void MediaKeysServerInternal::decrementSessionIdUsageCounterInternal(int32_t keySessionId)
+void MediaKeysServerInternal::closeDeferredMediaKeySession(int32_t keySessionId)
 {
+    // Another buffer may have released the session first
     auto sessionIter = m_mediaKeySessions.find(keySessionId);
     if (sessionIter == m_mediaKeySessions.end())
     {
-        RIALTO_SERVER_LOG_ERROR("Failed to find the session %d", keySessionId);
         return;
     }
 
-    if (sessionIter->second.bufCounter > 0)
     {
-        sessionIter->second.bufCounter--;
-    }
-
-    if (sessionIter->second.bufCounter == 0 && sessionIter->second.shouldBeDestroyed)
-    {
-        RIALTO_SERVER_LOG_INFO("Deferred closing of mksId %d", keySessionId);
-        MediaKeyErrorStatus status = sessionIter->second.mediaKeySession->closeKeySession();
-        if (MediaKeyErrorStatus::OK != status)
+        std::lock_guard<std::mutex> lock{sessionIter->second.guard->mutex};
+        if (sessionIter->second.guard->bufCounter != 0 || !sessionIter->second.guard->shouldBeDestroyed)
         {
-            RIALTO_SERVER_LOG_ERROR("Failed to close the key session %d", keySessionId);
             return;
         }
-        m_mediaKeySessions.erase(sessionIter);
     }
+
+    RIALTO_SERVER_LOG_INFO("Deferred closing of mksId %d", keySessionId);
+    closeMediaKeySession(sessionIter);
+}
+
+MediaKeyErrorStatus
+MediaKeysServerInternal::closeMediaKeySession(std::map<int32_t, MediaKeySessionUsage>::iterator sessionIter)
+{
+    const int32_t kKeySessionId = sessionIter->first;
+    MediaKeySessionUsage sessionUsage = std::move(sessionIter->second);
+    m_mediaKeySessions.erase(sessionIter);
+    updateMediaKeySessionsSnapshot();
+
+    std::unique_lock<std::mutex> lock{sessionUsage.guard->mutex};
+    MediaKeyErrorStatus status = sessionUsage.mediaKeySession->closeKeySession();
+    if (MediaKeyErrorStatus::OK != status)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to close the key session %d", kKeySessionId);
+        lock.unlock();
+        m_mediaKeySessions.emplace(kKeySessionId, std::move(sessionUsage));
+        updateMediaKeySessionsSnapshot();
+        return status;
+    }
+    sessionUsage.guard->isClosed = true;
+    return status;
 }
 }; // namespace firebolt::rialto::server
@@ -26,10 +26,82 @@
 #include "NeedMediaData.h"
 #include "RialtoServerLogging.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
 
 namespace
 {
 constexpr std::chrono::milliseconds kNeedMediaDataResendTimeMs{100};
+// Position and volume are refreshed every 250ms while playing, so a snapshot survives one missed refresh
+constexpr std::chrono::milliseconds kMaxPlayerSnapshotAgeMs{500};
+constexpr std::uint32_t kHdVideoRegionSize{4 * 1024 * 1024};    // up to 1080p
+constexpr std::uint32_t kUhdVideoRegionSize{7 * 1024 * 1024};   // up to 2160p
+constexpr std::uint32_t kFuhdVideoRegionSize{14 * 1024 * 1024}; // above 2160p
+constexpr std::uint32_t kLowBitrateAudioRegionSize{256 * 1024};
+constexpr std::uint32_t kAudioRegionSize{1 * 1024 * 1024};
+constexpr std::uint64_t kHdPixels{1920 * 1080};
+constexpr std::uint64_t kUhdPixels{3840 * 2160};
+
+/**
+ * @brief Data reader handed over to the player together with the lease of the shm partition it reads from.
+ */
+struct LeasedDataReader
+{
+    std::shared_ptr<firebolt::rialto::server::IDataReader> dataReader;
+    std::shared_ptr<void> partitionLease;
+};
+
+/**
+ * @brief Creates the lease of a mapped shm partition, that unmaps the partition when the last owner releases it.
+ */
+std::shared_ptr<void>
+createPartitionLease(const std::shared_ptr<firebolt::rialto::server::ISharedMemoryBuffer> &shmBuffer, int sessionId)
+{
+    using firebolt::rialto::server::ISharedMemoryBuffer;
+    return std::shared_ptr<void>(nullptr,
+                                 [shmBuffer, sessionId](void *)
+                                 {
+                                     if (!shmBuffer->unmapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                                    sessionId))
+                                     {
+                                         RIALTO_SERVER_LOG_ERROR("Unable to unmap shm partition");
+                                     }
+                                 });
+}
+
+std::uint32_t calculateShmRegionSize(const firebolt::rialto::IMediaPipeline::MediaSource &source,
+                                     const firebolt::rialto::VideoRequirements &videoRequirements)
+{
+    const std::string kMimeType{source.getMimeType()};
+    if (firebolt::rialto::MediaSourceType::AUDIO == source.getType())
+    {
+        if ("audio/mp4" == kMimeType || "audio/aac" == kMimeType || "audio/x-opus" == kMimeType)
+        {
+            return kLowBitrateAudioRegionSize;
+        }
+        return kAudioRegionSize;
+    }
+
+    if (0 == videoRequirements.maxWidth || 0 == videoRequirements.maxHeight)
+    {
+        return kUhdVideoRegionSize;
+    }
+    const std::uint64_t kPixels{static_cast<std::uint64_t>(videoRequirements.maxWidth) * videoRequirements.maxHeight};
+    // HEVC and Dolby Vision streams are usually encoded with a higher bitrate, so they get one size class more
+    const bool kIsHighBitrateCodec{"video/h265" == kMimeType || "video/x-h265" == kMimeType ||
+                                   firebolt::rialto::SourceConfigType::VIDEO_DOLBY_VISION == source.getConfigType()};
+    if (kPixels <= kHdPixels)
+    {
+        return kIsHighBitrateCodec ? kUhdVideoRegionSize : kHdVideoRegionSize;
+    }
+    if (kPixels <= kUhdPixels && !kIsHighBitrateCodec)
+    {
+        return kUhdVideoRegionSize;
+    }
+    return kFuhdVideoRegionSize;
+}
+
 const char *toString(const firebolt::rialto::MediaSourceStatus &status)
 {
     switch (status)
@@ -50,9 +122,16 @@ const char *toString(const firebolt::rialto::MediaSourceStatus &status)
 
 std::int32_t generateSourceId()
 {
-    static std::int32_t sourceId{1};
+    // Pipelines run on separate strands of the main thread, so ids can be generated concurrently
+    static std::atomic<std::int32_t> sourceId{1};
     return sourceId++;
 }
+
+std::int64_t getMonotonicTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
 } // namespace
 
 namespace firebolt::rialto
@@ -157,6 +236,18 @@ MediaPipelineServerInternal::MediaPipelineServerInternal(
         else
         {
             result = true;
+            m_partitionLease = createPartitionLease(m_shmBuffer, m_sessionId);
+            try
+            {
+                const std::uint32_t kStatusPageOffset{
+                    m_shmBuffer->getStatusPageOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId)};
+                m_statusPage = std::make_unique<common::ShmStatusPage>(m_shmBuffer->getBuffer() + kStatusPageOffset);
+                publishPlaybackStatus();
+            }
+            catch (const std::exception &e)
+            {
+                RIALTO_SERVER_LOG_WARN("Status page not available: %s", e.what());
+            }
         }
     };
 
@@ -180,10 +271,13 @@ MediaPipelineServerInternal::~MediaPipelineServerInternal()
                 timer.second->cancel();
             }
         }
-        if (!m_shmBuffer->unmapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId))
+        if (m_statusPage)
         {
-            RIALTO_SERVER_LOG_ERROR("Unable to unmap shm partition");
+            m_statusPage->invalidate();
+            m_statusPage.reset();
         }
+        // Zero copy buffers may still wrap the partition, it is unmapped when the last data reader is released
+        m_partitionLease.reset();
 
         m_shmBuffer.reset();
         m_mainThread->unregisterClient(m_mainThreadClientId);
@@ -209,6 +303,9 @@ bool MediaPipelineServerInternal::loadInternal(MediaType type, const std::string
     {
         m_gstPlayer.reset();
     }
+    m_playerSnapshot.reset();
+    m_pendingSeeks = 0;
+    updatePositionReportGeneration();
 
     m_gstPlayer = m_kGstPlayerFactory->createGstGenericPlayer(this, m_decryptionService, type, m_kVideoRequirements,
                                                               IRdkGstreamerUtilsWrapperFactory::getFactory());
@@ -255,6 +352,20 @@ bool MediaPipelineServerInternal::attachSourceInternal(const std::unique_ptr<Med
     const auto kSourceIter = m_attachedSources.find(source->getType());
     if (m_attachedSources.cend() == kSourceIter)
     {
+        // Shm region can be resized safely only when there are no NeedMediaData requests for this source yet and
+        // the player no longer uses data of the previously attached source. Resizing changes the slot layout and
+        // may release the memory pages.
+        if (isShmRegionUsedByPlayer(source->getType()))
+        {
+            RIALTO_SERVER_LOG_WARN("Shm region for session: %d is still in use, the previous size will be used",
+                                   m_sessionId);
+        }
+        else if (!m_shmBuffer->resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId,
+                                          source->getType(), calculateShmRegionSize(*source, m_kVideoRequirements)))
+        {
+            RIALTO_SERVER_LOG_WARN("Failed to resize shm region for session: %d, the previous size will be used",
+                                   m_sessionId);
+        }
         source->setId(generateSourceId());
         RIALTO_SERVER_LOG_DEBUG("New ID generated for MediaSourceType: %s: %d",
                                 (MediaSourceType::AUDIO == source->getType() ? "AUDIO" : "VIDEO"), source->getId());
@@ -395,6 +506,12 @@ bool MediaPipelineServerInternal::setPlaybackRateInternal(double rate)
     }
 
     m_gstPlayer->setPlaybackRate(rate);
+    m_playerSnapshot.invalidatePosition();
+    m_playerSnapshot.setPlaybackRate(rate);
+    updatePositionReportGeneration();
+    setStatusPosition(common::extrapolatePosition(m_playbackStatus, getMonotonicTimeNs()));
+    m_playbackStatus.playbackRate = rate;
+    publishPlaybackStatus();
     return true;
 }
 
@@ -417,7 +534,12 @@ bool MediaPipelineServerInternal::setPositionInternal(int64_t position)
         return false;
     }
 
+    // The seek is pending until the player notifies SEEKING, so the positions it reports before are dropped
+    ++m_pendingSeeks;
+    m_playerSnapshot.invalidatePosition();
     m_gstPlayer->setPosition(position);
+    setStatusPosition(position);
+    publishPlaybackStatus();
     return true;
 }
 
@@ -425,6 +547,12 @@ bool MediaPipelineServerInternal::getPosition(int64_t &position)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
+    // Can be called from any thread, falls back to the main thread when the snapshot is not fresh
+    if (getPositionFromSnapshot(position))
+    {
+        return true;
+    }
+
     bool result;
     auto task = [&]() { result = getPositionInternal(position); };
 
@@ -432,6 +560,11 @@ bool MediaPipelineServerInternal::getPosition(int64_t &position)
     return result;
 }
 
+bool MediaPipelineServerInternal::getPositionFromSnapshot(int64_t &position)
+{
+    return m_playerSnapshot.getPosition(position, kMaxPlayerSnapshotAgeMs);
+}
+
 bool MediaPipelineServerInternal::getPositionInternal(int64_t &position)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
@@ -548,6 +681,7 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
         RIALTO_SERVER_LOG_WARN("NeedData RequestID is not valid: %u", needDataRequestId);
         return true;
     }
+    const std::uint32_t kShmSlot{m_activeRequests->getShmSlot(needDataRequestId)};
     m_activeRequests->erase(needDataRequestId);
     if (status != MediaSourceStatus::OK && status != MediaSourceStatus::EOS)
     {
@@ -564,10 +698,13 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
     }
 
     std::uint32_t regionOffset = 0;
+    std::uint32_t maxRegionLen = 0;
     try
     {
-        regionOffset =
-            m_shmBuffer->getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+        regionOffset = m_shmBuffer->getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId,
+                                                      mediaSourceType, kShmSlot);
+        maxRegionLen = m_shmBuffer->getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId,
+                                                      mediaSourceType);
     }
     catch (const std::runtime_error &e)
     {
@@ -579,13 +716,23 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
     if (0 != numFrames)
     {
         std::shared_ptr<IDataReader> dataReader =
-            m_dataReaderFactory->createDataReader(mediaSourceType, buffer, regionOffset, numFrames);
+            m_dataReaderFactory->createDataReader(mediaSourceType, buffer, regionOffset, maxRegionLen, numFrames);
         if (!dataReader)
         {
             RIALTO_SERVER_LOG_ERROR("Metadata version not supported for request id: %u", needDataRequestId);
             notifyPlaybackState(PlaybackState::FAILURE);
             return false;
         }
+        // The player holds the reader as long as it uses the slot data, so the reader keeps the partition mapped
+        std::shared_ptr<LeasedDataReader> leasedDataReader{
+            std::make_shared<LeasedDataReader>(LeasedDataReader{dataReader, m_partitionLease})};
+        dataReader = std::shared_ptr<IDataReader>{leasedDataReader, leasedDataReader->dataReader.get()};
+        std::vector<std::weak_ptr<IDataReader>> &slotReaders = m_shmSlotReaders[mediaSourceType];
+        if (slotReaders.size() <= kShmSlot)
+        {
+            slotReaders.resize(kShmSlot + 1);
+        }
+        slotReaders[kShmSlot] = dataReader;
         m_gstPlayer->attachSamples(dataReader);
     }
     if (status == MediaSourceStatus::EOS)
@@ -639,6 +786,7 @@ bool MediaPipelineServerInternal::setVolumeInternal(double volume)
         RIALTO_SERVER_LOG_ERROR("Failed to set volume - Gstreamer player has not been loaded");
         return false;
     }
+    m_playerSnapshot.invalidateVolume();
     m_gstPlayer->setVolume(volume);
     return true;
 }
@@ -647,6 +795,12 @@ bool MediaPipelineServerInternal::getVolume(double &volume)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
+    // Can be called from any thread, falls back to the main thread when the snapshot is not fresh
+    if (getVolumeFromSnapshot(volume))
+    {
+        return true;
+    }
+
     bool result;
     auto task = [&]() { result = getVolumeInternal(volume); };
 
@@ -654,6 +808,11 @@ bool MediaPipelineServerInternal::getVolume(double &volume)
     return result;
 }
 
+bool MediaPipelineServerInternal::getVolumeFromSnapshot(double &volume)
+{
+    return m_playerSnapshot.getVolume(volume, kMaxPlayerSnapshotAgeMs);
+}
+
 bool MediaPipelineServerInternal::getVolumeInternal(double &volume)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
@@ -699,9 +858,21 @@ void MediaPipelineServerInternal::notifyPlaybackState(PlaybackState state)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
+    // The position reported before any transition, like a pause or a resume, may not match the new state
+    m_playerSnapshot.invalidatePosition();
+    if (PlaybackState::SEEKING == state && m_pendingSeeks > 0)
+    {
+        --m_pendingSeeks;
+    }
+    updatePositionReportGeneration();
+    m_playerSnapshot.setPlaybackState(state);
+
     auto task = [&, state]()
     {
         m_currentPlaybackState = state;
+        setStatusPosition(common::extrapolatePosition(m_playbackStatus, getMonotonicTimeNs()));
+        m_playbackStatus.playbackState = state;
+        publishPlaybackStatus();
         if (m_mediaPipelineClient)
         {
             m_mediaPipelineClient->notifyPlaybackState(state);
@@ -725,29 +896,98 @@ bool MediaPipelineServerInternal::notifyNeedMediaData(MediaSourceType mediaSourc
 bool MediaPipelineServerInternal::notifyNeedMediaDataInternal(MediaSourceType mediaSourceType)
 {
     m_needMediaDataTimers.erase(mediaSourceType);
-    m_shmBuffer->clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
     const auto kSourceIter = m_attachedSources.find(mediaSourceType);
     if (m_attachedSources.cend() == kSourceIter)
     {
         RIALTO_SERVER_LOG_WARN("NeedMediaData event sending failed - sourceId not found");
         return false;
     }
-    NeedMediaData event{m_mediaPipelineClient, *m_activeRequests,   *m_shmBuffer,          m_sessionId,
-                        mediaSourceType,       kSourceIter->second, m_currentPlaybackState};
-    if (!event.send())
+    const std::uint32_t kNumOfSlots{
+        m_shmBuffer->getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId)};
+    if (0 == kNumOfSlots)
     {
-        RIALTO_SERVER_LOG_WARN("NeedMediaData event sending failed");
+        RIALTO_SERVER_LOG_WARN("NeedMediaData event sending failed - no shm slots available");
         return false;
     }
-    return true;
+    // Request data for every free slot of the ring, so that the client can keep writing while the previous
+    // chunks are still being consumed by the player.
+    const std::uint32_t kFirstSlot{m_nextShmSlot[mediaSourceType] % kNumOfSlots};
+    bool isRequestSent{false};
+    for (std::uint32_t i = 0; i < kNumOfSlots; ++i)
+    {
+        const std::uint32_t kShmSlot{(kFirstSlot + i) % kNumOfSlots};
+        if (!isShmSlotFree(mediaSourceType, kShmSlot))
+        {
+            continue;
+        }
+        m_shmBuffer->clearSlotData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType,
+                                   kShmSlot);
+        NeedMediaData event{m_mediaPipelineClient, *m_activeRequests,   *m_shmBuffer,          m_sessionId,
+                            mediaSourceType,       kSourceIter->second, m_currentPlaybackState, kShmSlot};
+        if (!event.send())
+        {
+            RIALTO_SERVER_LOG_WARN("NeedMediaData event sending failed");
+            return false;
+        }
+        m_nextShmSlot[mediaSourceType] = (kShmSlot + 1) % kNumOfSlots;
+        isRequestSent = true;
+    }
+    if (isRequestSent)
+    {
+        return true;
+    }
+    // A request, that is still outstanding, brings the next data. Otherwise all slots are held by the player and
+    // the caller has to try again once one of them is released.
+    for (std::uint32_t shmSlot = 0; shmSlot < kNumOfSlots; ++shmSlot)
+    {
+        if (m_activeRequests->isShmSlotUsed(mediaSourceType, shmSlot))
+        {
+            return true;
+        }
+    }
+    RIALTO_SERVER_LOG_DEBUG("NeedMediaData not sent - all shm slots are still used by the player");
+    return false;
+}
+
+bool MediaPipelineServerInternal::isShmSlotFree(MediaSourceType mediaSourceType, std::uint32_t shmSlot) const
+{
+    if (m_activeRequests->isShmSlotUsed(mediaSourceType, shmSlot))
+    {
+        return false;
+    }
+    const auto kReadersIter = m_shmSlotReaders.find(mediaSourceType);
+    if (m_shmSlotReaders.cend() == kReadersIter || kReadersIter->second.size() <= shmSlot)
+    {
+        return true;
+    }
+    return kReadersIter->second[shmSlot].expired();
+}
+
+bool MediaPipelineServerInternal::isShmRegionUsedByPlayer(MediaSourceType mediaSourceType) const
+{
+    const auto kReadersIter = m_shmSlotReaders.find(mediaSourceType);
+    if (m_shmSlotReaders.cend() == kReadersIter)
+    {
+        return false;
+    }
+    return std::any_of(kReadersIter->second.cbegin(), kReadersIter->second.cend(),
+                       [](const std::weak_ptr<IDataReader> &reader) { return !reader.expired(); });
 }
 
 void MediaPipelineServerInternal::notifyPosition(std::int64_t position)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
+    if (!m_playerSnapshot.setPosition(position, m_positionReportGeneration))
+    {
+        RIALTO_SERVER_LOG_DEBUG("Dropping the position reported before the last invalidation");
+        return;
+    }
+
     auto task = [&, position]()
     {
+        setStatusPosition(position);
+        publishPlaybackStatus();
         if (m_mediaPipelineClient)
         {
             m_mediaPipelineClient->notifyPosition(position);
@@ -763,6 +1003,8 @@ void MediaPipelineServerInternal::notifyNetworkState(NetworkState state)
 
     auto task = [&, state]()
     {
+        m_playbackStatus.networkState = state;
+        publishPlaybackStatus();
         if (m_mediaPipelineClient)
         {
             m_mediaPipelineClient->notifyNetworkState(state);
@@ -796,6 +1038,15 @@ void MediaPipelineServerInternal::notifyQos(MediaSourceType mediaSourceType, con
 
     auto task = [&, mediaSourceType, qosInfo]()
     {
+        if (MediaSourceType::AUDIO == mediaSourceType)
+        {
+            m_playbackStatus.audioQos = qosInfo;
+        }
+        else if (MediaSourceType::VIDEO == mediaSourceType)
+        {
+            m_playbackStatus.videoQos = qosInfo;
+        }
+        publishPlaybackStatus();
         if (m_mediaPipelineClient)
         {
             const auto kSourceIter = m_attachedSources.find(mediaSourceType);
@@ -811,6 +1062,59 @@ void MediaPipelineServerInternal::notifyQos(MediaSourceType mediaSourceType, con
     m_mainThread->enqueueTask(m_mainThreadClientId, task);
 }
 
+void MediaPipelineServerInternal::notifyBufferLevel(MediaSourceType mediaSourceType, std::uint64_t queuedBytes)
+{
+    auto task = [&, mediaSourceType, queuedBytes]()
+    {
+        if (MediaSourceType::AUDIO == mediaSourceType)
+        {
+            m_playbackStatus.audioQueuedBytes = queuedBytes;
+        }
+        else if (MediaSourceType::VIDEO == mediaSourceType)
+        {
+            m_playbackStatus.videoQueuedBytes = queuedBytes;
+        }
+        publishPlaybackStatus();
+    };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, task);
+}
+
+void MediaPipelineServerInternal::notifyVolume(double volume)
+{
+    m_playerSnapshot.setVolume(volume);
+}
+
+void MediaPipelineServerInternal::setStatusPosition(std::int64_t position)
+{
+    m_playbackStatus.position = position;
+    m_playbackStatus.positionTimestamp = getMonotonicTimeNs();
+}
+
+void MediaPipelineServerInternal::updatePositionReportGeneration()
+{
+    // Read the generation before checking for pending seeks, so that the generation of a seek requested in between
+    // is never taken
+    const std::uint64_t kGeneration{m_playerSnapshot.getPositionGeneration()};
+    if (0 != m_pendingSeeks)
+    {
+        return;
+    }
+    std::uint64_t currentGeneration{m_positionReportGeneration};
+    while (currentGeneration < kGeneration &&
+           !m_positionReportGeneration.compare_exchange_weak(currentGeneration, kGeneration))
+    {
+    }
+}
+
+void MediaPipelineServerInternal::publishPlaybackStatus()
+{
+    if (m_statusPage)
+    {
+        m_statusPage->publish(m_playbackStatus);
+    }
+}
+
 void MediaPipelineServerInternal::scheduleNotifyNeedMediaData(MediaSourceType mediaSourceType)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
@@ -28,9 +28,9 @@ namespace firebolt::rialto::server
 {
 NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActiveRequests &activeRequests,
                              const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType,
-                             std::int32_t sourceId, PlaybackState currentPlaybackState)
+                             std::int32_t sourceId, PlaybackState currentPlaybackState, std::uint32_t shmSlot)
     : m_client{client}, m_activeRequests{activeRequests}, m_mediaSourceType{mediaSourceType}, m_frameCount{kMaxFrames},
-      m_sourceId{sourceId}
+      m_sourceId{sourceId}, m_shmSlot{shmSlot}
 {
     if (PlaybackState::PLAYING != currentPlaybackState)
     {
@@ -46,13 +46,14 @@ NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActive
     try
     {
         m_maxMediaBytes =
-            shmBuffer.getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, sessionId, mediaSourceType) -
+            shmBuffer.getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, sessionId, mediaSourceType) -
             getMaxMetadataBytes();
-        auto metadataOffset =
-            shmBuffer.getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, sessionId, mediaSourceType);
+        auto metadataOffset = shmBuffer.getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, sessionId,
+                                                          mediaSourceType, m_shmSlot);
         auto mediadataOffset = metadataOffset + getMaxMetadataBytes();
-        m_shmInfo = std::make_shared<MediaPlayerShmInfo>(
-            MediaPlayerShmInfo{getMaxMetadataBytes(), metadataOffset, mediadataOffset, m_maxMediaBytes});
+        m_shmInfo = std::make_shared<MediaPlayerShmInfo>(MediaPlayerShmInfo{getMaxMetadataBytes(), metadataOffset,
+                                                                            mediadataOffset, m_maxMediaBytes,
+                                                                            common::LATEST_METADATA_VERSION});
         m_isValid = true;
     }
     catch (const std::exception &e)
@@ -67,8 +68,8 @@ bool NeedMediaData::send() const
     auto client = m_client.lock();
     if (client && m_isValid)
     {
-        client->notifyNeedMediaData(m_sourceId, m_frameCount,
-                                    m_activeRequests.insert(m_mediaSourceType, m_maxMediaBytes), m_shmInfo);
+        const std::uint32_t kRequestId{m_activeRequests.insert(m_mediaSourceType, m_maxMediaBytes, m_shmSlot)};
+        client->notifyNeedMediaData(m_sourceId, m_frameCount, kRequestId, m_shmInfo);
         return true;
     }
     return false;
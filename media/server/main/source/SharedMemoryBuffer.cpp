@@ -19,11 +19,14 @@
 
 #include "SharedMemoryBuffer.h"
 #include "RialtoServerLogging.h"
+#include "ShmStatusPage.h"
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
 #include <numeric>
 #include <stdexcept>
+#include <string>
 #include <sys/mman.h>
 #include <syscall.h>
 #include <unistd.h>
@@ -57,28 +60,70 @@
 #define F_SEAL_WRITE 0x0008
 #endif
 
+#if !defined(FALLOC_FL_KEEP_SIZE)
+#define FALLOC_FL_KEEP_SIZE 0x01
+#endif
+
+#if !defined(FALLOC_FL_PUNCH_HOLE)
+#define FALLOC_FL_PUNCH_HOLE 0x02
+#endif
+
 namespace
 {
 const char *memoryBufferName{"rialto_avbuf"};
 constexpr int NO_ID_ASSIGNED{-1};
-constexpr uint32_t videoRegionSize = 7 * 1024 * 1024; // 7MB
-constexpr uint32_t audioRegionSize = 1 * 1024 * 1024; // 1MB
-constexpr uint32_t webAudioRegionSize = 10 * 1024;    // 10KB
+constexpr uint32_t videoRegionSize = 7 * 1024 * 1024;      // 7MB
+constexpr uint32_t audioRegionSize = 1 * 1024 * 1024;      // 1MB
+constexpr uint32_t webAudioRegionSize = 10 * 1024;         // 10KB
+constexpr uint32_t videoRegionCapacity = 14 * 1024 * 1024; // 14MB
+constexpr uint32_t audioRegionCapacity = 1 * 1024 * 1024;  // 1MB
+constexpr uint32_t kDefaultNumOfSlots{1};
+constexpr uint32_t kMaxNumOfSlots{8};
+constexpr uint32_t kSlotAlignment{8};
+const char *kNumOfSlotsEnvVariableName{"RIALTO_SHM_RING_SLOTS"};
+
+std::uint32_t getNumOfGenericSlots()
+{
+    const char *envVar = getenv(kNumOfSlotsEnvVariableName);
+    if (!envVar)
+    {
+        return kDefaultNumOfSlots;
+    }
+    std::uint32_t numOfSlots{kDefaultNumOfSlots};
+    try
+    {
+        numOfSlots = std::stoul(std::string{envVar});
+    }
+    catch (std::exception &e)
+    {
+    }
+    return std::min(std::max(numOfSlots, kDefaultNumOfSlots), kMaxNumOfSlots);
+}
 
-std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>
-calculatePartitionSize(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int num)
+firebolt::rialto::server::SharedMemoryBuffer::Partition
+createPartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType)
 {
     if (firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC == playbackType)
     {
-        // As (for now) resolution of playback (for example HD or UHD) is not known, partitions have the same size.
-        firebolt::rialto::server::SharedMemoryBuffer::Partition singlePlaybackDataBuffer{NO_ID_ASSIGNED, audioRegionSize,
-                                                                                         videoRegionSize};
-        return std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>(num, singlePlaybackDataBuffer);
+        // Regions start with the default size and are resized when the source is attached. The address space is
+        // reserved for the biggest supported region, but memfd pages are allocated only when they are touched.
+        // Audio and video regions may be divided into ring slots, so that more than one NeedMediaData request per
+        // source can be in flight at the same time.
+        return firebolt::rialto::server::SharedMemoryBuffer::Partition{NO_ID_ASSIGNED,      audioRegionSize,
+                                                                       videoRegionSize,     getNumOfGenericSlots(),
+                                                                       audioRegionCapacity, videoRegionCapacity};
     }
-    else if (firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO == playbackType)
+    return firebolt::rialto::server::SharedMemoryBuffer::Partition{NO_ID_ASSIGNED,     webAudioRegionSize, 0,
+                                                                   kDefaultNumOfSlots, webAudioRegionSize, 0};
+}
+
+std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>
+calculatePartitionSize(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int num)
+{
+    if (firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC == playbackType ||
+        firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO == playbackType)
     {
-        firebolt::rialto::server::SharedMemoryBuffer::Partition webAudioDataBuffer{NO_ID_ASSIGNED, webAudioRegionSize, 0};
-        return std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>(num, webAudioDataBuffer);
+        return std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>(num, createPartition(playbackType));
     }
     else
     {
@@ -181,6 +226,7 @@ SharedMemoryBuffer::~SharedMemoryBuffer()
 
 bool SharedMemoryBuffer::mapPartition(MediaPlaybackType playbackType, int id)
 {
+    std::unique_lock<std::mutex> lock{m_mutex};
     std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
     {
@@ -207,6 +253,7 @@ bool SharedMemoryBuffer::mapPartition(MediaPlaybackType playbackType, int id)
 
 bool SharedMemoryBuffer::unmapPartition(MediaPlaybackType playbackType, int id)
 {
+    std::unique_lock<std::mutex> lock{m_mutex};
     std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
     {
@@ -221,12 +268,22 @@ bool SharedMemoryBuffer::unmapPartition(MediaPlaybackType playbackType, int id)
         RIALTO_SERVER_LOG_WARN("Failed to unmap Shm partition for id: %d. - partition could not be found", id);
         return false;
     }
-    partition->id = NO_ID_ASSIGNED;
+    std::uint8_t *partitionDataPtr = nullptr;
+    if (getDataPtrForPartition(playbackType, id, &partitionDataPtr))
+    {
+        releaseMemory(partitionDataPtr, partition->videoCapacity + partition->audioCapacity);
+    }
+    if (MediaPlaybackType::GENERIC == playbackType)
+    {
+        memset(m_dataBuffer + getStatusPageOffsetUnlocked(playbackType, id), 0x00, common::STATUS_PAGE_SIZE_BYTES);
+    }
+    *partition = createPartition(playbackType);
     return true;
 }
 
 bool SharedMemoryBuffer::clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType) const
 {
+    std::unique_lock<std::mutex> lock{m_mutex};
     const std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
     {
@@ -251,7 +308,7 @@ bool SharedMemoryBuffer::clearData(MediaPlaybackType playbackType, int id, const
     }
     if (MediaSourceType::AUDIO == mediaSourceType)
     {
-        std::uint8_t *audioData = partitionDataPtr + partition->dataBufferVideoLen;
+        std::uint8_t *audioData = partitionDataPtr + partition->videoCapacity;
         memset(audioData, 0x00, partition->dataBufferAudioLen);
         return true;
     }
@@ -267,7 +324,14 @@ bool SharedMemoryBuffer::clearData(MediaPlaybackType playbackType, int id, const
 std::uint32_t SharedMemoryBuffer::getDataOffset(MediaPlaybackType playbackType, int id,
                                                 const MediaSourceType &mediaSourceType) const
 {
-    std::uint8_t *buffer = getDataPtr(playbackType, id, mediaSourceType);
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return getDataOffsetUnlocked(playbackType, id, mediaSourceType);
+}
+
+std::uint32_t SharedMemoryBuffer::getDataOffsetUnlocked(MediaPlaybackType playbackType, int id,
+                                                        const MediaSourceType &mediaSourceType) const
+{
+    std::uint8_t *buffer = getDataPtrUnlocked(playbackType, id, mediaSourceType);
     if (!buffer)
     {
         throw std::runtime_error("Buffer not found for playback type " + std::string(toString(playbackType)) +
@@ -278,6 +342,13 @@ std::uint32_t SharedMemoryBuffer::getDataOffset(MediaPlaybackType playbackType,
 
 std::uint32_t SharedMemoryBuffer::getMaxDataLen(MediaPlaybackType playbackType, int id,
                                                 const MediaSourceType &mediaSourceType) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return getMaxDataLenUnlocked(playbackType, id, mediaSourceType);
+}
+
+std::uint32_t SharedMemoryBuffer::getMaxDataLenUnlocked(MediaPlaybackType playbackType, int id,
+                                                        const MediaSourceType &mediaSourceType) const
 {
     const std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
@@ -308,6 +379,13 @@ std::uint32_t SharedMemoryBuffer::getMaxDataLen(MediaPlaybackType playbackType,
 
 std::uint8_t *SharedMemoryBuffer::getDataPtr(MediaPlaybackType playbackType, int id,
                                              const MediaSourceType &mediaSourceType) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return getDataPtrUnlocked(playbackType, id, mediaSourceType);
+}
+
+std::uint8_t *SharedMemoryBuffer::getDataPtrUnlocked(MediaPlaybackType playbackType, int id,
+                                                     const MediaSourceType &mediaSourceType) const
 {
     const std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
@@ -335,7 +413,7 @@ std::uint8_t *SharedMemoryBuffer::getDataPtr(MediaPlaybackType playbackType, int
     }
     if ((MediaSourceType::AUDIO == mediaSourceType) && (0 != partition->dataBufferAudioLen))
     {
-        return partitionDataPtr + partition->dataBufferVideoLen;
+        return partitionDataPtr + partition->videoCapacity;
     }
     if ((MediaSourceType::VIDEO == mediaSourceType) && (0 != partition->dataBufferVideoLen))
     {
@@ -344,6 +422,143 @@ std::uint8_t *SharedMemoryBuffer::getDataPtr(MediaPlaybackType playbackType, int
     return nullptr;
 }
 
+bool SharedMemoryBuffer::resizeData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                                    std::uint32_t dataLen)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
+    if (!partitions)
+    {
+        RIALTO_SERVER_LOG_ERROR("Cannot resize the data for playback type %s with id: %d", toString(playbackType), id);
+        return false;
+    }
+
+    auto partition = std::find_if(partitions->begin(), partitions->end(), [id](const auto &p) { return p.id == id; });
+    std::uint8_t *regionDataPtr = getDataPtrUnlocked(playbackType, id, mediaSourceType);
+    if (partition == partitions->end() || !regionDataPtr)
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to resize data for playback type %s with id: %d. - region could not be found",
+                               toString(playbackType), id);
+        return false;
+    }
+    std::uint32_t &regionLen =
+        (MediaSourceType::AUDIO == mediaSourceType) ? partition->dataBufferAudioLen : partition->dataBufferVideoLen;
+    const std::uint32_t kCapacity =
+        (MediaSourceType::AUDIO == mediaSourceType) ? partition->audioCapacity : partition->videoCapacity;
+    if (0 == dataLen)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to resize data for playback type %s with id: %d. - invalid length",
+                                toString(playbackType), id);
+        return false;
+    }
+    if (dataLen > kCapacity)
+    {
+        RIALTO_SERVER_LOG_WARN("Requested data length %u for playback type %s with id: %d exceeds the capacity: %u",
+                               dataLen, toString(playbackType), id, kCapacity);
+        dataLen = kCapacity;
+    }
+    if (dataLen < regionLen)
+    {
+        releaseMemory(regionDataPtr + dataLen, regionLen - dataLen);
+    }
+    RIALTO_SERVER_LOG_INFO("Data length for playback type %s with id: %d changed from %u to %u", toString(playbackType),
+                           id, regionLen, dataLen);
+    regionLen = dataLen;
+    return true;
+}
+
+std::uint32_t SharedMemoryBuffer::getNumOfSlots(MediaPlaybackType playbackType, int id) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return getNumOfSlotsUnlocked(playbackType, id);
+}
+
+std::uint32_t SharedMemoryBuffer::getNumOfSlotsUnlocked(MediaPlaybackType playbackType, int id) const
+{
+    const Partition *partition = findPartition(playbackType, id);
+    if (!partition)
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to get number of slots for playback type %s with id: %d", toString(playbackType),
+                               id);
+        return 0;
+    }
+    return partition->numOfSlots;
+}
+
+bool SharedMemoryBuffer::clearSlotData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                                       std::uint32_t slot) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    std::uint8_t *regionDataPtr = getDataPtrUnlocked(playbackType, id, mediaSourceType);
+    const std::uint32_t kSlotLen = getMaxSlotDataLenUnlocked(playbackType, id, mediaSourceType);
+    if (!regionDataPtr || 0 == kSlotLen || slot >= getNumOfSlotsUnlocked(playbackType, id))
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to clear slot %u data for playback type %s with id: %d", slot,
+                                toString(playbackType), id);
+        return false;
+    }
+    memset(regionDataPtr + slot * kSlotLen, 0x00, kSlotLen);
+    return true;
+}
+
+std::uint32_t SharedMemoryBuffer::getSlotDataOffset(MediaPlaybackType playbackType, int id,
+                                                    const MediaSourceType &mediaSourceType, std::uint32_t slot) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (slot >= getNumOfSlotsUnlocked(playbackType, id))
+    {
+        throw std::runtime_error("Slot " + std::to_string(slot) + " not found for playback type " +
+                                 std::string(toString(playbackType)) + " with id: " + std::to_string(id));
+    }
+    return getDataOffsetUnlocked(playbackType, id, mediaSourceType) +
+           slot * getMaxSlotDataLenUnlocked(playbackType, id, mediaSourceType);
+}
+
+std::uint32_t SharedMemoryBuffer::getMaxSlotDataLen(MediaPlaybackType playbackType, int id,
+                                                    const MediaSourceType &mediaSourceType) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return getMaxSlotDataLenUnlocked(playbackType, id, mediaSourceType);
+}
+
+std::uint32_t SharedMemoryBuffer::getMaxSlotDataLenUnlocked(MediaPlaybackType playbackType, int id,
+                                                            const MediaSourceType &mediaSourceType) const
+{
+    const std::uint32_t kNumOfSlots = getNumOfSlotsUnlocked(playbackType, id);
+    if (0 == kNumOfSlots)
+    {
+        return 0;
+    }
+    if (1 == kNumOfSlots)
+    {
+        return getMaxDataLenUnlocked(playbackType, id, mediaSourceType);
+    }
+    return (getMaxDataLenUnlocked(playbackType, id, mediaSourceType) / kNumOfSlots) & ~(kSlotAlignment - 1);
+}
+
+std::uint32_t SharedMemoryBuffer::getStatusPageOffset(MediaPlaybackType playbackType, int id) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return getStatusPageOffsetUnlocked(playbackType, id);
+}
+
+std::uint32_t SharedMemoryBuffer::getStatusPageOffsetUnlocked(MediaPlaybackType playbackType, int id) const
+{
+    // Status pages are kept together after the data of all partitions, one page for each generic partition
+    if (MediaPlaybackType::GENERIC == playbackType)
+    {
+        auto partition = std::find_if(m_genericPartitions.begin(), m_genericPartitions.end(),
+                                      [id](const auto &p) { return p.id == id; });
+        if (partition != m_genericPartitions.end())
+        {
+            const std::uint32_t kIndex = std::distance(m_genericPartitions.begin(), partition);
+            return calculateDataSize() + kIndex * common::STATUS_PAGE_SIZE_BYTES;
+        }
+    }
+    throw std::runtime_error("Status page not found for playback type " + std::string(toString(playbackType)) +
+                             " with id: " + std::to_string(id));
+}
+
 int SharedMemoryBuffer::getFd() const
 {
     return m_dataBufferFd;
@@ -360,13 +575,18 @@ std::uint8_t *SharedMemoryBuffer::getBuffer() const
 }
 
 size_t SharedMemoryBuffer::calculateBufferSize() const
+{
+    return calculateDataSize() + m_genericPartitions.size() * common::STATUS_PAGE_SIZE_BYTES;
+}
+
+size_t SharedMemoryBuffer::calculateDataSize() const
 {
     size_t genericSum = std::accumulate(m_genericPartitions.begin(), m_genericPartitions.end(), 0,
                                         [](size_t sum, const Partition &p)
-                                        { return sum + p.dataBufferAudioLen + p.dataBufferVideoLen; });
+                                        { return sum + p.audioCapacity + p.videoCapacity; });
     size_t webAudioSum = std::accumulate(m_webAudioPartitions.begin(), m_webAudioPartitions.end(), 0,
                                          [](size_t sum, const Partition &p)
-                                         { return sum + p.dataBufferAudioLen + p.dataBufferVideoLen; });
+                                         { return sum + p.audioCapacity + p.videoCapacity; });
     return genericSum + webAudioSum;
 }
 
@@ -381,7 +601,7 @@ bool SharedMemoryBuffer::getDataPtrForPartition(MediaPlaybackType playbackType,
             *ptr = result;
             return true;
         }
-        result += (partition.dataBufferVideoLen + partition.dataBufferAudioLen);
+        result += (partition.videoCapacity + partition.audioCapacity);
     }
 
     for (const auto &partition : m_webAudioPartitions)
@@ -391,7 +611,7 @@ bool SharedMemoryBuffer::getDataPtrForPartition(MediaPlaybackType playbackType,
             *ptr = result;
             return true;
         }
-        result += (partition.dataBufferVideoLen + partition.dataBufferAudioLen);
+        result += (partition.videoCapacity + partition.audioCapacity);
     }
 
     RIALTO_SERVER_LOG_ERROR("Could not find the data ptr for playback type %s with id: %d", toString(playbackType), id);
@@ -420,4 +640,41 @@ std::vector<SharedMemoryBuffer::Partition> *SharedMemoryBuffer::getPlaybackTypeP
     return const_cast<std::vector<SharedMemoryBuffer::Partition> *>(
         const_cast<const SharedMemoryBuffer *>(this)->getPlaybackTypePartition(playbackType));
 }
+
+const SharedMemoryBuffer::Partition *SharedMemoryBuffer::findPartition(MediaPlaybackType playbackType, int id) const
+{
+    const std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
+    if (!partitions)
+    {
+        return nullptr;
+    }
+    auto partition = std::find_if(partitions->begin(), partitions->end(), [id](const auto &p) { return p.id == id; });
+    if (partition == partitions->end())
+    {
+        return nullptr;
+    }
+    return &(*partition);
+}
+
+void SharedMemoryBuffer::releaseMemory(std::uint8_t *ptr, std::uint32_t len) const
+{
+    // Only whole pages can be given back, partially used pages at both ends of the range are kept
+    const std::uintptr_t kPageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const std::uintptr_t kBegin = (reinterpret_cast<std::uintptr_t>(ptr) + kPageSize - 1) & ~(kPageSize - 1);
+    const std::uintptr_t kEnd = (reinterpret_cast<std::uintptr_t>(ptr) + len) & ~(kPageSize - 1);
+    if (kEnd <= kBegin)
+    {
+        return;
+    }
+    const off_t kOffset = static_cast<off_t>(kBegin - reinterpret_cast<std::uintptr_t>(m_dataBuffer));
+    const off_t kLength = static_cast<off_t>(kEnd - kBegin);
+    if (fallocate(m_dataBufferFd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, kOffset, kLength) == 0)
+    {
+        return;
+    }
+    if (madvise(reinterpret_cast<void *>(kBegin), kLength, MADV_REMOVE) != 0)
+    {
+        RIALTO_SERVER_LOG_SYS_WARN(errno, "failed to release shared memory pages");
+    }
+}
 } // namespace firebolt::rialto::server
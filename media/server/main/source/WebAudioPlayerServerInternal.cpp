@@ -25,6 +25,8 @@ namespace
 {
 constexpr uint32_t kPreferredFrames{640};
 constexpr std::chrono::milliseconds kWriteDataTimeMs{100};
+// The queued bytes drain while the audio plays, so only a level sampled by a recent write is close enough
+constexpr std::chrono::milliseconds kMaxQueuedBytesAgeMs{20};
 } // namespace
 
 namespace firebolt::rialto
@@ -63,11 +65,11 @@ WebAudioPlayerServerInternalFactory::createWebAudioPlayer(std::weak_ptr<IWebAudi
     return nullptr;
 }
 
-std::unique_ptr<IWebAudioPlayer> WebAudioPlayerServerInternalFactory::createWebAudioPlayerServerInternal(
+std::unique_ptr<IWebAudioPlayerServerInternal> WebAudioPlayerServerInternalFactory::createWebAudioPlayerServerInternal(
     std::weak_ptr<IWebAudioPlayerClient> client, const std::string &audioMimeType, const uint32_t priority,
     const WebAudioConfig *config, const std::shared_ptr<ISharedMemoryBuffer> &shmBuffer, int handle) const
 {
-    std::unique_ptr<IWebAudioPlayer> webAudioPlayer;
+    std::unique_ptr<IWebAudioPlayerServerInternal> webAudioPlayer;
     try
     {
         webAudioPlayer = std::make_unique<server::WebAudioPlayerServerInternal>(client, audioMimeType, priority, config,
@@ -92,7 +94,7 @@ WebAudioPlayerServerInternal::WebAudioPlayerServerInternal(
     std::shared_ptr<common::ITimerFactory> timerFactory)
     : m_webAudioPlayerClient(client), m_shmBuffer{shmBuffer}, m_priority{priority}, m_shmId{handle}, m_shmPtr{nullptr},
       m_partitionOffset{0}, m_maxDataLength{0}, m_availableBuffer{}, m_expectWriteBuffer{false},
-      m_timerFactory{timerFactory}, m_bytesPerFrame{0}, m_isEosRequested{false}
+      m_timerFactory{timerFactory}, m_bytesPerFrame{0}, m_isEosRequested{false}, m_queuedFramesInShm{0}
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
@@ -273,26 +275,47 @@ bool WebAudioPlayerServerInternal::getBufferDelay(uint32_t &delayFrames)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
+    // Can be called from any thread, falls back to the main thread when the snapshot is not fresh
+    if (getBufferDelayFromSnapshot(delayFrames))
+    {
+        return true;
+    }
+
     bool status = false;
     auto task = [&]()
     {
-        // Gstreamer returns a uint64, so check the value first
-        uint64_t queuedFrames = (m_gstPlayer->getQueuedBytes() / m_bytesPerFrame) + getQueuedFramesInShm();
-        if (queuedFrames > std::numeric_limits<uint32_t>::max())
-        {
-            RIALTO_SERVER_LOG_ERROR("Queued frames are larger than the max uint32_t");
-        }
-        else
-        {
-            delayFrames = static_cast<uint32_t>(queuedFrames);
-            status = true;
-        }
+        const uint64_t kQueuedBytes{m_gstPlayer->getQueuedBytes()};
+        status = calculateBufferDelay(kQueuedBytes, getQueuedFramesInShm(), delayFrames);
     };
 
     m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
     return status;
 }
 
+bool WebAudioPlayerServerInternal::getBufferDelayFromSnapshot(uint32_t &delayFrames)
+{
+    uint64_t queuedBytes = 0;
+    if (!m_playerSnapshot.getQueuedBytes(queuedBytes, kMaxQueuedBytesAgeMs))
+    {
+        return false;
+    }
+    return calculateBufferDelay(queuedBytes, m_queuedFramesInShm, delayFrames);
+}
+
+bool WebAudioPlayerServerInternal::calculateBufferDelay(uint64_t queuedBytes, uint32_t queuedFramesInShm,
+                                                        uint32_t &delayFrames) const
+{
+    // Gstreamer returns a uint64, so check the value first
+    uint64_t queuedFrames = (queuedBytes / m_bytesPerFrame) + queuedFramesInShm;
+    if (queuedFrames > std::numeric_limits<uint32_t>::max())
+    {
+        RIALTO_SERVER_LOG_ERROR("Queued frames are larger than the max uint32_t");
+        return false;
+    }
+    delayFrames = static_cast<uint32_t>(queuedFrames);
+    return true;
+}
+
 bool WebAudioPlayerServerInternal::writeBuffer(const uint32_t numberOfFrames, void *data)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
@@ -463,6 +486,7 @@ void WebAudioPlayerServerInternal::updateAvailableBuffer(uint32_t bytesWrittenTo
             m_availableBuffer.lengthWrap = bytesWrittenToGst - newDataLengthAtEndOfShm;
         }
     }
+    m_queuedFramesInShm = getQueuedFramesInShm();
 }
 
 bool WebAudioPlayerServerInternal::getDeviceInfo(uint32_t &preferredFrames, uint32_t &maximumFrames,
@@ -506,6 +530,11 @@ std::weak_ptr<IWebAudioPlayerClient> WebAudioPlayerServerInternal::getClient()
     return m_webAudioPlayerClient;
 }
 
+void WebAudioPlayerServerInternal::notifyBufferLevel(uint64_t queuedBytes)
+{
+    m_playerSnapshot.setQueuedBytes(queuedBytes);
+}
+
 void WebAudioPlayerServerInternal::notifyState(WebAudioPlayerState state)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
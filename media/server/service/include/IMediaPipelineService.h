@@ -52,6 +52,7 @@ public:
     virtual bool setPlaybackRate(int sessionId, double rate) = 0;
     virtual bool setPosition(int sessionId, std::int64_t position) = 0;
     virtual bool getPosition(int sessionId, std::int64_t &position) = 0;
+    virtual bool getPositionFromSnapshot(int sessionId, std::int64_t &position) = 0;
     virtual bool setVideoWindow(int sessionId, std::uint32_t x, std::uint32_t y, std::uint32_t width,
                                 std::uint32_t height) = 0;
     virtual bool haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
@@ -59,6 +60,8 @@ public:
     virtual bool renderFrame(int sessionId) = 0;
     virtual bool setVolume(int sessionId, double volume) = 0;
     virtual bool getVolume(int sessionId, double &volume) = 0;
+    virtual bool getVolumeFromSnapshot(int sessionId, double &volume) = 0;
+    virtual bool getStatusPageOffset(int sessionId, std::uint32_t &offset) = 0;
     virtual std::vector<std::string> getSupportedMimeTypes(MediaSourceType type) = 0;
     virtual bool isMimeTypeSupported(const std::string &mimeType) = 0;
 };
@@ -50,6 +50,7 @@ public:
     virtual bool getBufferAvailable(int handle, uint32_t &availableFrames,
                                     std::shared_ptr<WebAudioShmInfo> &webAudioShmInfo) = 0;
     virtual bool getBufferDelay(int handle, uint32_t &delayFrames) = 0;
+    virtual bool getBufferDelayFromSnapshot(int handle, uint32_t &delayFrames) = 0;
     virtual bool writeBuffer(int handle, const uint32_t numberOfFrames, void *data) = 0;
     virtual bool getDeviceInfo(int handle, uint32_t &preferredFrames, uint32_t &maximumFrames,
                                bool &supportDeferredPlay) = 0;
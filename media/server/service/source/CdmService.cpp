@@ -55,6 +55,7 @@ void CdmService::switchToInactive()
     {
         std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
         m_mediaKeys.clear();
+        std::atomic_store(&m_keySessionsSnapshot, {});
     }
 }
 
@@ -100,6 +101,7 @@ bool CdmService::destroyMediaKeys(int mediaKeysHandle)
             RIALTO_SERVER_LOG_ERROR("Media keys handle: %d does not exists", mediaKeysHandle);
             return false;
         }
+        removeMediaKeysFromSnapshot(mediaKeysIter->second);
         m_mediaKeys.erase(mediaKeysIter);
     }
 
@@ -131,6 +133,7 @@ MediaKeyErrorStatus CdmService::createKeySession(int mediaKeysHandle, KeySession
             return MediaKeyErrorStatus::FAIL;
         }
         m_mediaKeysClients.emplace(std::make_pair(keySessionId, client));
+        addKeySessionToSnapshot(keySessionId, mediaKeysIter->second);
     }
 
     return status;
@@ -415,68 +418,110 @@ MediaKeyErrorStatus CdmService::decrypt(int32_t keySessionId, GstBuffer *encrypt
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to decrypt, key session id: %d", keySessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = findMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return MediaKeyErrorStatus::FAIL;
     }
-    return mediaKeysIter->second->decrypt(keySessionId, encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
+    return mediaKeys->decrypt(keySessionId, encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
 }
 
 bool CdmService::isNetflixKeySystem(int32_t keySessionId) const
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to check if key system is Netflix, key session id: %d", keySessionId);
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = findMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return false;
     }
-    return mediaKeysIter->second->isNetflixKeySystem(keySessionId);
+    return mediaKeys->isNetflixKeySystem(keySessionId);
 }
 
 MediaKeyErrorStatus CdmService::selectKeyId(int32_t keySessionId, const std::vector<uint8_t> &keyId)
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to select key id, key session id: %d", keySessionId);
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = findMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return MediaKeyErrorStatus::FAIL;
     }
-    return mediaKeysIter->second->selectKeyId(keySessionId, keyId);
+    return mediaKeys->selectKeyId(keySessionId, keyId);
 }
 
 void CdmService::incrementSessionIdUsageCounter(int32_t keySessionId)
 {
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = findMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return;
     }
 
-    mediaKeysIter->second->incrementSessionIdUsageCounter(keySessionId);
+    mediaKeys->incrementSessionIdUsageCounter(keySessionId);
 }
 
 void CdmService::decrementSessionIdUsageCounter(int32_t keySessionId)
 {
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = findMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return;
     }
 
-    mediaKeysIter->second->decrementSessionIdUsageCounter(keySessionId);
+    mediaKeys->decrementSessionIdUsageCounter(keySessionId);
+}
+
+void CdmService::addKeySessionToSnapshot(int32_t keySessionId,
+                                         const std::shared_ptr<IMediaKeysServerInternal> &mediaKeys)
+{
+    auto snapshot = std::make_shared<std::map<int32_t, std::shared_ptr<IMediaKeysServerInternal>>>();
+    auto currentSnapshot = std::atomic_load(&m_keySessionsSnapshot);
+    if (currentSnapshot)
+    {
+        *snapshot = *currentSnapshot;
+    }
+    (*snapshot)[keySessionId] = mediaKeys;
+    std::atomic_store(&m_keySessionsSnapshot,
+                      std::shared_ptr<const std::map<int32_t, std::shared_ptr<IMediaKeysServerInternal>>>{
+                          std::move(snapshot)});
+}
+
+void CdmService::removeMediaKeysFromSnapshot(const std::shared_ptr<IMediaKeysServerInternal> &mediaKeys)
+{
+    auto currentSnapshot = std::atomic_load(&m_keySessionsSnapshot);
+    if (!currentSnapshot)
+    {
+        return;
+    }
+    auto snapshot = std::make_shared<std::map<int32_t, std::shared_ptr<IMediaKeysServerInternal>>>();
+    for (const auto &keySession : *currentSnapshot)
+    {
+        if (keySession.second != mediaKeys)
+        {
+            snapshot->emplace(keySession);
+        }
+    }
+    std::atomic_store(&m_keySessionsSnapshot,
+                      std::shared_ptr<const std::map<int32_t, std::shared_ptr<IMediaKeysServerInternal>>>{
+                          std::move(snapshot)});
+}
+
+std::shared_ptr<IMediaKeysServerInternal> CdmService::findMediaKeysForKeySession(int32_t keySessionId) const
+{
+    auto snapshot = std::atomic_load(&m_keySessionsSnapshot);
+    if (!snapshot)
+    {
+        return nullptr;
+    }
+    auto keySessionIter = snapshot->find(keySessionId);
+    if (keySessionIter == snapshot->end())
+    {
+        return nullptr;
+    }
+    return keySessionIter->second;
 }
 } // namespace firebolt::rialto::server::service
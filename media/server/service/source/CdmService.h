@@ -27,6 +27,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -82,11 +83,22 @@ private:
     std::shared_ptr<IMediaKeysServerInternalFactory> m_mediaKeysFactory;
     std::shared_ptr<IMediaKeysCapabilitiesFactory> m_mediaKeysCapabilitiesFactory;
     std::atomic<bool> m_isActive;
-    std::map<int, std::unique_ptr<IMediaKeysServerInternal>> m_mediaKeys;
+    std::map<int, std::shared_ptr<IMediaKeysServerInternal>> m_mediaKeys;
     std::map<int, std::shared_ptr<IMediaKeysClient>> m_mediaKeysClients;
     std::mutex m_mediaKeysMutex;
 
+    /**
+     * @brief Read-only map of key session ids to the media keys owning them, used by the streaming threads.
+     *
+     * Replaced as a whole with m_mediaKeysMutex held and read without locking, with std::atomic_load.
+     * The media keys stay alive until all readers release the snapshot, that referenced them.
+     */
+    std::shared_ptr<const std::map<int32_t, std::shared_ptr<IMediaKeysServerInternal>>> m_keySessionsSnapshot;
+
     MediaKeyErrorStatus removeKeySessionInternal(int mediaKeysHandle, int32_t keySessionId);
+    void addKeySessionToSnapshot(int32_t keySessionId, const std::shared_ptr<IMediaKeysServerInternal> &mediaKeys);
+    void removeMediaKeysFromSnapshot(const std::shared_ptr<IMediaKeysServerInternal> &mediaKeys);
+    std::shared_ptr<IMediaKeysServerInternal> findMediaKeysForKeySession(int32_t keySessionId) const;
 };
 } // namespace firebolt::rialto::server::service
 
@@ -0,0 +1,83 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_SERVICE_CONTENTION_COUNTING_MUTEX_H_
+#define FIREBOLT_RIALTO_SERVER_SERVICE_CONTENTION_COUNTING_MUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace firebolt::rialto::server::service
+{
+/**
+ * @brief A mutex, that counts how many of its acquisitions had to wait for another thread.
+ *
+ * Meets the Lockable requirements, so it can be used with std::lock_guard and std::unique_lock.
+ */
+class ContentionCountingMutex
+{
+public:
+    ContentionCountingMutex() = default;
+    ~ContentionCountingMutex() = default;
+    ContentionCountingMutex(const ContentionCountingMutex &) = delete;
+    ContentionCountingMutex(ContentionCountingMutex &&) = delete;
+    ContentionCountingMutex &operator=(const ContentionCountingMutex &) = delete;
+    ContentionCountingMutex &operator=(ContentionCountingMutex &&) = delete;
+
+    void lock()
+    {
+        if (!m_mutex.try_lock())
+        {
+            m_contendedLocks.fetch_add(1, std::memory_order_relaxed);
+            m_mutex.lock();
+        }
+        m_locks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool try_lock()
+    {
+        if (!m_mutex.try_lock())
+        {
+            return false;
+        }
+        m_locks.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void unlock() { m_mutex.unlock(); }
+
+    /**
+     * @brief Gets the number of acquisitions of the mutex.
+     */
+    std::uint64_t getLocks() const { return m_locks.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of acquisitions, that found the mutex held by another thread.
+     */
+    std::uint64_t getContendedLocks() const { return m_contendedLocks.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex m_mutex;
+    std::atomic<std::uint64_t> m_locks{0};
+    std::atomic<std::uint64_t> m_contendedLocks{0};
+};
+} // namespace firebolt::rialto::server::service
+
+#endif // FIREBOLT_RIALTO_SERVER_SERVICE_CONTENTION_COUNTING_MUTEX_H_
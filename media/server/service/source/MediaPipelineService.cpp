@@ -20,6 +20,7 @@
 #include "MediaPipelineService.h"
 #include "IMediaPipelineServerInternal.h"
 #include "RialtoServerLogging.h"
+#include <cinttypes>
 #include <exception>
 #include <future>
 #include <string>
@@ -46,13 +47,20 @@ MediaPipelineService::MediaPipelineService(
 
 MediaPipelineService::~MediaPipelineService()
 {
+    RIALTO_SERVER_LOG_INFO("MediaPipelineService session lookups: %" PRIu64 ", contended: %" PRIu64,
+                           m_mediaPipelineMutex.getLocks(), m_mediaPipelineMutex.getContendedLocks());
     RIALTO_SERVER_LOG_DEBUG("MediaPipelineService is destructed");
 }
 
 void MediaPipelineService::clearMediaPipelines()
 {
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    m_mediaPipelines.clear();
+    std::map<int, std::shared_ptr<IMediaPipelineServerInternal>> mediaPipelines;
+    {
+        std::lock_guard<ContentionCountingMutex> lock{m_mediaPipelineMutex};
+        mediaPipelines.swap(m_mediaPipelines);
+    }
+    // Pipelines are destroyed without holding the lock, calls still in progress keep their pipeline alive
+    mediaPipelines.clear();
 }
 
 bool MediaPipelineService::createSession(int sessionId, const std::shared_ptr<IMediaPipelineClient> &mediaPipelineClient,
@@ -66,7 +74,7 @@ bool MediaPipelineService::createSession(int sessionId, const std::shared_ptr<IM
     }
 
     {
-        std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
+        std::lock_guard<ContentionCountingMutex> lock{m_mediaPipelineMutex};
         if (m_mediaPipelines.size() == static_cast<size_t>(m_playbackService.getMaxPlaybacks()))
         {
             RIALTO_SERVER_LOG_ERROR("Unable to create a session with id: %d. Max session number reached.", sessionId);
@@ -77,19 +85,33 @@ bool MediaPipelineService::createSession(int sessionId, const std::shared_ptr<IM
             RIALTO_SERVER_LOG_ERROR("Session with id: %d already exists", sessionId);
             return false;
         }
-        auto shmBuffer = m_playbackService.getShmBuffer();
-        m_mediaPipelines.emplace(
-            std::make_pair(sessionId,
-                           m_mediaPipelineFactory->createMediaPipelineServerInternal(mediaPipelineClient,
-                                                                                     VideoRequirements{maxWidth, maxHeight},
-                                                                                     sessionId, shmBuffer,
-                                                                                     m_decryptionService)));
-        if (!m_mediaPipelines.at(sessionId))
+        // Reserve the session id, the pipeline itself is created without holding the lock
+        m_mediaPipelines.emplace(sessionId, nullptr);
+    }
+
+    auto shmBuffer = m_playbackService.getShmBuffer();
+    std::shared_ptr<IMediaPipelineServerInternal> mediaPipeline =
+        m_mediaPipelineFactory->createMediaPipelineServerInternal(mediaPipelineClient,
+                                                                  VideoRequirements{maxWidth, maxHeight}, sessionId,
+                                                                  shmBuffer, m_decryptionService);
+    {
+        std::lock_guard<ContentionCountingMutex> lock{m_mediaPipelineMutex};
+        auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
+        if (!mediaPipeline)
         {
             RIALTO_SERVER_LOG_ERROR("Could not create MediaPipeline for session with id: %d", sessionId);
-            m_mediaPipelines.erase(sessionId);
+            if (mediaPipelineIter != m_mediaPipelines.end())
+            {
+                m_mediaPipelines.erase(mediaPipelineIter);
+            }
+            return false;
+        }
+        if (mediaPipelineIter == m_mediaPipelines.end())
+        {
+            RIALTO_SERVER_LOG_ERROR("Session with id: %d was removed during its creation", sessionId);
             return false;
         }
+        mediaPipelineIter->second = mediaPipeline;
     }
 
     RIALTO_SERVER_LOG_INFO("New session with id: %d created", sessionId);
@@ -99,16 +121,20 @@ bool MediaPipelineService::createSession(int sessionId, const std::shared_ptr<IM
 bool MediaPipelineService::destroySession(int sessionId)
 {
     RIALTO_SERVER_LOG_DEBUG("MediaPipelineService requested to destroy session with id: %d", sessionId);
+    std::shared_ptr<IMediaPipelineServerInternal> mediaPipeline;
     {
-        std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
+        std::lock_guard<ContentionCountingMutex> lock{m_mediaPipelineMutex};
         auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
         if (mediaPipelineIter == m_mediaPipelines.end())
         {
             RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
             return false;
         }
+        mediaPipeline = std::move(mediaPipelineIter->second);
         m_mediaPipelines.erase(mediaPipelineIter);
     }
+    // The pipeline is destroyed without holding the lock, a call still in progress keeps it alive until it returns
+    mediaPipeline.reset();
     RIALTO_SERVER_LOG_INFO("Session with id: %d destroyed", sessionId);
     return true;
 }
@@ -117,126 +143,124 @@ bool MediaPipelineService::load(int sessionId, MediaType type, const std::string
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to load session with id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->load(type, mimeType, url);
+    return mediaPipeline->load(type, mimeType, url);
 }
 
 bool MediaPipelineService::attachSource(int sessionId, const std::unique_ptr<IMediaPipeline::MediaSource> &source)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to attach source, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->attachSource(source);
+    return mediaPipeline->attachSource(source);
 }
 
 bool MediaPipelineService::removeSource(int sessionId, std::int32_t sourceId)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to remove source, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->removeSource(sourceId);
+    return mediaPipeline->removeSource(sourceId);
 }
 
 bool MediaPipelineService::play(int sessionId)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to play, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->play();
+    return mediaPipeline->play();
 }
 
 bool MediaPipelineService::pause(int sessionId)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to pause, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->pause();
+    return mediaPipeline->pause();
 }
 
 bool MediaPipelineService::stop(int sessionId)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to stop, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->stop();
+    return mediaPipeline->stop();
 }
 
 bool MediaPipelineService::setPlaybackRate(int sessionId, double rate)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to set playback rate, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->setPlaybackRate(rate);
+    return mediaPipeline->setPlaybackRate(rate);
 }
 
 bool MediaPipelineService::setPosition(int sessionId, std::int64_t position)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to set position, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->setPosition(position);
+    return mediaPipeline->setPosition(position);
 }
 
 bool MediaPipelineService::getPosition(int sessionId, std::int64_t &position)
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to get position, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->getPosition(position);
+    return mediaPipeline->getPosition(position);
+}
+
+bool MediaPipelineService::getPositionFromSnapshot(int sessionId, std::int64_t &position)
+{
+    // Called for every position request, a missing session is reported by getPosition()
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    return mediaPipeline && mediaPipeline->getPositionFromSnapshot(position);
 }
 
 bool MediaPipelineService::setVideoWindow(int sessionId, std::uint32_t x, std::uint32_t y, std::uint32_t width,
@@ -244,14 +268,13 @@ bool MediaPipelineService::setVideoWindow(int sessionId, std::uint32_t x, std::u
 {
     RIALTO_SERVER_LOG_INFO("MediaPipelineService requested to set video window, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->setVideoWindow(x, y, width, height);
+    return mediaPipeline->setVideoWindow(x, y, width, height);
 }
 
 bool MediaPipelineService::haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
@@ -259,55 +282,97 @@ bool MediaPipelineService::haveData(int sessionId, MediaSourceStatus status, std
 {
     RIALTO_SERVER_LOG_DEBUG("New data available, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->haveData(status, numFrames, needDataRequestId);
+    return mediaPipeline->haveData(status, numFrames, needDataRequestId);
 }
 
 bool MediaPipelineService::renderFrame(int sessionId)
 {
     RIALTO_SERVER_LOG_DEBUG("Render frame requested, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->renderFrame();
+    return mediaPipeline->renderFrame();
 }
+
 bool MediaPipelineService::setVolume(int sessionId, double volume)
 {
     RIALTO_SERVER_LOG_DEBUG("Set volume requested, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->setVolume(volume);
+    return mediaPipeline->setVolume(volume);
 }
 
 bool MediaPipelineService::getVolume(int sessionId, double &volume)
 {
     RIALTO_SERVER_LOG_DEBUG("Get volume requested, session id: %d", sessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
-    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
-    if (mediaPipelineIter == m_mediaPipelines.end())
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    if (!mediaPipeline)
+    {
+        RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
+        return false;
+    }
+    return mediaPipeline->getVolume(volume);
+}
+
+bool MediaPipelineService::getVolumeFromSnapshot(int sessionId, double &volume)
+{
+    // Called for every volume request, a missing session is reported by getVolume()
+    auto mediaPipeline = getMediaPipeline(sessionId);
+    return mediaPipeline && mediaPipeline->getVolumeFromSnapshot(volume);
+}
+
+bool MediaPipelineService::getStatusPageOffset(int sessionId, std::uint32_t &offset)
+{
+    RIALTO_SERVER_LOG_DEBUG("MediaPipelineService requested to get status page offset, session id: %d", sessionId);
+
+    if (!getMediaPipeline(sessionId))
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
         return false;
     }
-    return mediaPipelineIter->second->getVolume(volume);
+    auto shmBuffer = m_playbackService.getShmBuffer();
+    if (!shmBuffer)
+    {
+        RIALTO_SERVER_LOG_ERROR("Shared memory buffer is not available");
+        return false;
+    }
+    try
+    {
+        offset = shmBuffer->getStatusPageOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, sessionId);
+    }
+    catch (const std::exception &e)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to get status page offset: %s", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<IMediaPipelineServerInternal> MediaPipelineService::getMediaPipeline(int sessionId)
+{
+    std::lock_guard<ContentionCountingMutex> lock{m_mediaPipelineMutex};
+    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
+    if (mediaPipelineIter == m_mediaPipelines.end())
+    {
+        return nullptr;
+    }
+    return mediaPipelineIter->second;
 }
 
 std::vector<std::string> MediaPipelineService::getSupportedMimeTypes(MediaSourceType type)
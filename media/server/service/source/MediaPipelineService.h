@@ -20,6 +20,7 @@
 #ifndef FIREBOLT_RIALTO_SERVER_SERVICE_MEDIA_PIPELINE_SERVICE_H_
 #define FIREBOLT_RIALTO_SERVER_SERVICE_MEDIA_PIPELINE_SERVICE_H_
 
+#include "ContentionCountingMutex.h"
 #include "IDecryptionService.h"
 #include "IMediaPipelineCapabilities.h"
 #include "IMediaPipelineServerInternal.h"
@@ -64,6 +65,7 @@ public:
     bool setPlaybackRate(int sessionId, double rate) override;
     bool setPosition(int sessionId, std::int64_t position) override;
     bool getPosition(int sessionId, std::int64_t &position) override;
+    bool getPositionFromSnapshot(int sessionId, std::int64_t &position) override;
     bool setVideoWindow(int sessionId, std::uint32_t x, std::uint32_t y, std::uint32_t width,
                         std::uint32_t height) override;
     bool haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
@@ -71,18 +73,31 @@ public:
     bool renderFrame(int sessionId) override;
     bool setVolume(int sessionId, double volume) override;
     bool getVolume(int sessionId, double &volume) override;
+    bool getVolumeFromSnapshot(int sessionId, double &volume) override;
+    bool getStatusPageOffset(int sessionId, std::uint32_t &offset) override;
     std::vector<std::string> getSupportedMimeTypes(MediaSourceType type) override;
     bool isMimeTypeSupported(const std::string &mimeType) override;
 
     void clearMediaPipelines();
 
 private:
+    /**
+     * @brief Gets the media pipeline of the session.
+     *
+     * The session map is locked only for the lookup, so the pipeline call itself does not block other sessions.
+     *
+     * @param[in] sessionId : The id of the session.
+     *
+     * @retval the media pipeline, nullptr if the session does not exist or is still being created.
+     */
+    std::shared_ptr<IMediaPipelineServerInternal> getMediaPipeline(int sessionId);
+
     IPlaybackService &m_playbackService;
     std::shared_ptr<IMediaPipelineServerInternalFactory> m_mediaPipelineFactory;
     std::shared_ptr<IMediaPipelineCapabilities> m_mediaPipelineCapabilities;
     IDecryptionService &m_decryptionService;
-    std::map<int, std::unique_ptr<IMediaPipelineServerInternal>> m_mediaPipelines;
-    std::mutex m_mediaPipelineMutex;
+    std::map<int, std::shared_ptr<IMediaPipelineServerInternal>> m_mediaPipelines;
+    ContentionCountingMutex m_mediaPipelineMutex;
 };
 } // namespace firebolt::rialto::server::service
 
@@ -21,6 +21,7 @@
 #include "IWebAudioPlayer.h"
 #include "IWebAudioPlayerServerInternalFactory.h"
 #include "RialtoServerLogging.h"
+#include <cinttypes>
 #include <exception>
 #include <future>
 #include <string>
@@ -38,13 +39,19 @@ WebAudioPlayerService::WebAudioPlayerService(IPlaybackService &playbackService,
 
 WebAudioPlayerService::~WebAudioPlayerService()
 {
+    RIALTO_SERVER_LOG_INFO("WebAudioPlayerService player lookups: %" PRIu64 ", contended: %" PRIu64,
+                           m_webAudioPlayerMutex.getLocks(), m_webAudioPlayerMutex.getContendedLocks());
     RIALTO_SERVER_LOG_DEBUG("WebAudioPlayerService is destructed");
 }
 
 void WebAudioPlayerService::clearWebAudioPlayers()
 {
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    m_webAudioPlayers.clear();
+    std::map<int, std::shared_ptr<IWebAudioPlayerServerInternal>> webAudioPlayers;
+    {
+        std::lock_guard<ContentionCountingMutex> lock{m_webAudioPlayerMutex};
+        webAudioPlayers.swap(m_webAudioPlayers);
+    }
+    webAudioPlayers.clear();
 }
 
 bool WebAudioPlayerService::createWebAudioPlayer(int handle,
@@ -60,7 +67,7 @@ bool WebAudioPlayerService::createWebAudioPlayer(int handle,
     }
 
     {
-        std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
+        std::lock_guard<ContentionCountingMutex> lock{m_webAudioPlayerMutex};
         if (m_webAudioPlayers.size() == static_cast<size_t>(m_playbackService.getMaxWebAudioPlayers()))
         {
             RIALTO_SERVER_LOG_ERROR("Unable to create WebAudioPlayer with id: %d. Max instance number reached.", handle);
@@ -71,18 +78,32 @@ bool WebAudioPlayerService::createWebAudioPlayer(int handle,
             RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d already exists", handle);
             return false;
         }
-        auto shmBuffer = m_playbackService.getShmBuffer();
-        m_webAudioPlayers.emplace(
-            std::make_pair(handle,
-                           m_webAudioPlayerFactory->createWebAudioPlayerServerInternal(webAudioPlayerClient,
-                                                                                       audioMimeType, priority, config,
-                                                                                       shmBuffer, handle)));
-        if (!m_webAudioPlayers.at(handle))
+        // Reserve the handle, the player itself is created without holding the lock
+        m_webAudioPlayers.emplace(handle, nullptr);
+    }
+
+    auto shmBuffer = m_playbackService.getShmBuffer();
+    std::shared_ptr<IWebAudioPlayerServerInternal> webAudioPlayer =
+        m_webAudioPlayerFactory->createWebAudioPlayerServerInternal(webAudioPlayerClient, audioMimeType, priority,
+                                                                    config, shmBuffer, handle);
+    {
+        std::lock_guard<ContentionCountingMutex> lock{m_webAudioPlayerMutex};
+        auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
+        if (!webAudioPlayer)
         {
             RIALTO_SERVER_LOG_ERROR("Could not create WebAudioPlayer for handle: %d", handle);
-            m_webAudioPlayers.erase(handle);
+            if (webAudioPlayerIter != m_webAudioPlayers.end())
+            {
+                m_webAudioPlayers.erase(webAudioPlayerIter);
+            }
+            return false;
+        }
+        if (webAudioPlayerIter == m_webAudioPlayers.end())
+        {
+            RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d was removed during its creation", handle);
             return false;
         }
+        webAudioPlayerIter->second = webAudioPlayer;
     }
 
     RIALTO_SERVER_LOG_INFO("New WebAudioPlayer: %d created", handle);
@@ -92,16 +113,19 @@ bool WebAudioPlayerService::createWebAudioPlayer(int handle,
 bool WebAudioPlayerService::destroyWebAudioPlayer(int handle)
 {
     RIALTO_SERVER_LOG_DEBUG("WebAudioPlayerService requested to destroy WebAudioPlayer with handle: %d", handle);
+    std::shared_ptr<IWebAudioPlayerServerInternal> webAudioPlayer;
     {
-        std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
+        std::lock_guard<ContentionCountingMutex> lock{m_webAudioPlayerMutex};
         auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
         if (webAudioPlayerIter == m_webAudioPlayers.end())
         {
             RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
             return false;
         }
+        webAudioPlayer = std::move(webAudioPlayerIter->second);
         m_webAudioPlayers.erase(webAudioPlayerIter);
     }
+    webAudioPlayer.reset();
     RIALTO_SERVER_LOG_INFO("WebAudioPlayer: %d destroyed", handle);
     return true;
 }
@@ -110,42 +134,39 @@ bool WebAudioPlayerService::play(int handle)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to play WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->play();
+    return webAudioPlayer->play();
 }
 
 bool WebAudioPlayerService::pause(int handle)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to pause WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->pause();
+    return webAudioPlayer->pause();
 }
 
 bool WebAudioPlayerService::setEos(int handle)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to setEos WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->setEos();
+    return webAudioPlayer->setEos();
 }
 
 bool WebAudioPlayerService::getBufferAvailable(int handle, uint32_t &availableFrames,
@@ -154,42 +175,46 @@ bool WebAudioPlayerService::getBufferAvailable(int handle, uint32_t &availableFr
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to getBufferAvailable WebAudioPlayer with handle: %d",
                            handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->getBufferAvailable(availableFrames, webAudioShmInfo);
+    return webAudioPlayer->getBufferAvailable(availableFrames, webAudioShmInfo);
 }
 
 bool WebAudioPlayerService::getBufferDelay(int handle, uint32_t &delayFrames)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to getBufferDelay WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->getBufferDelay(delayFrames);
+    return webAudioPlayer->getBufferDelay(delayFrames);
+}
+
+bool WebAudioPlayerService::getBufferDelayFromSnapshot(int handle, uint32_t &delayFrames)
+{
+    // Called for every buffer delay request, a missing player is reported by getBufferDelay()
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    return webAudioPlayer && webAudioPlayer->getBufferDelayFromSnapshot(delayFrames);
 }
 
 bool WebAudioPlayerService::writeBuffer(int handle, const uint32_t numberOfFrames, void *data)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to writeBuffer WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->writeBuffer(numberOfFrames, data);
+    return webAudioPlayer->writeBuffer(numberOfFrames, data);
 }
 
 bool WebAudioPlayerService::getDeviceInfo(int handle, uint32_t &preferredFrames, uint32_t &maximumFrames,
@@ -197,42 +222,49 @@ bool WebAudioPlayerService::getDeviceInfo(int handle, uint32_t &preferredFrames,
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to getDeviceInfo WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->getDeviceInfo(preferredFrames, maximumFrames, supportDeferredPlay);
+    return webAudioPlayer->getDeviceInfo(preferredFrames, maximumFrames, supportDeferredPlay);
 }
 
 bool WebAudioPlayerService::setVolume(int handle, double volume)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to setVolume WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->setVolume(volume);
+    return webAudioPlayer->setVolume(volume);
 }
 
 bool WebAudioPlayerService::getVolume(int handle, double &volume)
 {
     RIALTO_SERVER_LOG_INFO("WebAudioPlayerService requested to getVolume WebAudioPlayer with handle: %d", handle);
 
-    std::lock_guard<std::mutex> lock{m_webAudioPlayerMutex};
-    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
-    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    auto webAudioPlayer = getWebAudioPlayer(handle);
+    if (!webAudioPlayer)
     {
         RIALTO_SERVER_LOG_ERROR("WebAudioPlayer with handle: %d does not exists", handle);
         return false;
     }
-    return webAudioPlayerIter->second->getVolume(volume);
+    return webAudioPlayer->getVolume(volume);
 }
 
+std::shared_ptr<IWebAudioPlayerServerInternal> WebAudioPlayerService::getWebAudioPlayer(int handle)
+{
+    std::lock_guard<ContentionCountingMutex> lock{m_webAudioPlayerMutex};
+    auto webAudioPlayerIter = m_webAudioPlayers.find(handle);
+    if (webAudioPlayerIter == m_webAudioPlayers.end())
+    {
+        return nullptr;
+    }
+    return webAudioPlayerIter->second;
+}
 } // namespace firebolt::rialto::server::service
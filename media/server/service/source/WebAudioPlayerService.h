@@ -20,6 +20,7 @@
 #ifndef FIREBOLT_RIALTO_SERVER_SERVICE_WEB_AUDIO_PLAYER_SERVICE_H_
 #define FIREBOLT_RIALTO_SERVER_SERVICE_WEB_AUDIO_PLAYER_SERVICE_H_
 
+#include "ContentionCountingMutex.h"
 #include "IPlaybackService.h"
 #include "IWebAudioPlayer.h"
 #include "IWebAudioPlayerServerInternalFactory.h"
@@ -58,6 +59,7 @@ public:
     bool getBufferAvailable(int handle, uint32_t &availableFrames,
                             std::shared_ptr<WebAudioShmInfo> &webAudioShmInfo) override;
     bool getBufferDelay(int handle, uint32_t &delayFrames) override;
+    bool getBufferDelayFromSnapshot(int handle, uint32_t &delayFrames) override;
     bool writeBuffer(int handle, const uint32_t numberOfFrames, void *data) override;
     bool getDeviceInfo(int handle, uint32_t &preferredFrames, uint32_t &maximumFrames, bool &supportDeferredPlay) override;
     bool setVolume(int handle, double volume) override;
@@ -66,10 +68,21 @@ public:
     void clearWebAudioPlayers();
 
 private:
+    /**
+     * @brief Gets the web audio player with the handle.
+     *
+     * The player map is locked only for the lookup, so the player call itself does not block other players.
+     *
+     * @param[in] handle : The handle of the web audio player.
+     *
+     * @retval the web audio player, nullptr if it does not exist or is still being created.
+     */
+    std::shared_ptr<IWebAudioPlayerServerInternal> getWebAudioPlayer(int handle);
+
     IPlaybackService &m_playbackService;
     std::shared_ptr<IWebAudioPlayerServerInternalFactory> m_webAudioPlayerFactory;
-    std::map<int, std::unique_ptr<IWebAudioPlayer>> m_webAudioPlayers;
-    std::mutex m_webAudioPlayerMutex;
+    std::map<int, std::shared_ptr<IWebAudioPlayerServerInternal>> m_webAudioPlayers;
+    ContentionCountingMutex m_webAudioPlayerMutex;
 };
 } // namespace firebolt::rialto::server::service
 
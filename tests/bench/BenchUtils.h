@@ -0,0 +1,103 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_UTILS_H_
+#define BENCH_UTILS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Helpers shared by the micro benchmarks.
+ *
+ * The benchmarks are plain executables that print their results, they are not run as part of the unit tests.
+ */
+namespace bench
+{
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Returns the time elapsed since start in microseconds.
+ */
+inline double elapsedUs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Collects latency samples and prints their distribution.
+ */
+class LatencyStats
+{
+public:
+    explicit LatencyStats(size_t expectedSamples = 0) { m_samples.reserve(expectedSamples); }
+
+    void add(double sampleUs) { m_samples.push_back(sampleUs); }
+
+    void merge(const LatencyStats &other)
+    {
+        m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+    }
+
+    /**
+     * @brief Prints the percentiles of the samples, in microseconds.
+     *
+     * @param[in] label : The name of the measurement.
+     */
+    void print(const std::string &label)
+    {
+        if (m_samples.empty())
+        {
+            printf("%-40s no samples\n", label.c_str());
+            return;
+        }
+
+        std::sort(m_samples.begin(), m_samples.end());
+        printf("%-40s us: p50 %8.2f  p90 %8.2f  p99 %8.2f  max %9.2f  (n=%zu)\n", label.c_str(), percentile(0.5),
+               percentile(0.9), percentile(0.99), m_samples.back(), m_samples.size());
+    }
+
+private:
+    double percentile(double fraction) const
+    {
+        const size_t kIndex = static_cast<size_t>(fraction * static_cast<double>(m_samples.size()));
+        return m_samples[std::min(m_samples.size() - 1, kIndex)];
+    }
+
+    std::vector<double> m_samples;
+};
+
+/**
+ * @brief Prints a rate.
+ *
+ * @param[in] label     : The name of the measurement.
+ * @param[in] count     : The number of operations.
+ * @param[in] elapsedUs : The time the operations took, in microseconds.
+ */
+inline void printRate(const std::string &label, size_t count, double elapsedUs)
+{
+    printf("%-40s %12.0f ops/s  (%zu ops in %.1f ms)\n", label.c_str(), count * 1000000.0 / elapsedUs, count,
+           elapsedUs / 1000.0);
+}
+} // namespace bench
+
+#endif // BENCH_UTILS_H_
@@ -0,0 +1,90 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the rate of allocate and deallocate pairs of the IPC buffer pool against plain malloc and free, with
+ * threads each holding a few buffers of message sizes at a time, and the share of allocations the pool served.
+ */
+
+#include "BenchUtils.h"
+#include "BufferPool.h"
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int kNumOfRounds{500000};
+constexpr int kNumOfHeldBuffers{4};
+constexpr size_t kSizes[] = {200, 700, 1500, 3000, 200, 600};
+constexpr size_t kNumOfSizes{sizeof(kSizes) / sizeof(kSizes[0])};
+
+/**
+ * @brief Runs the threads, each allocating kNumOfHeldBuffers buffers then releasing them, kNumOfRounds times.
+ */
+template <typename Allocate, typename Deallocate>
+void runThreads(const std::string &label, int numOfThreads, Allocate allocate, Deallocate deallocate)
+{
+    const auto kStart = bench::Clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numOfThreads; i++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                void *buffers[kNumOfHeldBuffers];
+                for (int round = 0; round < kNumOfRounds; round++)
+                {
+                    for (int k = 0; k < kNumOfHeldBuffers; k++)
+                    {
+                        buffers[k] = allocate(kSizes[(round + k) % kNumOfSizes]);
+                        *static_cast<volatile uint8_t *>(buffers[k]) = 1;
+                    }
+                    for (int k = 0; k < kNumOfHeldBuffers; k++)
+                        deallocate(buffers[k]);
+                }
+            });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    bench::printRate(label + " " + std::to_string(numOfThreads) + " threads",
+                     static_cast<size_t>(numOfThreads) * kNumOfRounds * kNumOfHeldBuffers, bench::elapsedUs(kStart));
+}
+} // namespace
+
+int main()
+{
+    for (int numOfThreads : {1, 2, 4, 8})
+    {
+        runThreads("malloc", numOfThreads, [](size_t size) { return malloc(size); }, [](void *p) { free(p); });
+
+        BufferPool pool;
+        runThreads("BufferPool", numOfThreads, [&pool](size_t size) { return pool.allocate<uint8_t>(size); },
+                   [&pool](void *p) { pool.deallocate(p); });
+
+        const BufferPool::Stats kStats = pool.stats();
+        printf("  slab %zu bytes, %.2f%% of the allocations pooled\n", pool.capacity(),
+               100.0 * kStats.hits / static_cast<double>(kStats.hits + kStats.misses));
+    }
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the rate of decrypts made by concurrent audio and video streaming threads through the CdmService, on
+ * their own and while the main thread is kept busy by slow OCDM control calls.
+ */
+
+#include "BenchUtils.h"
+#include "CdmService.h"
+#include "MainThread.h"
+#include "MediaKeySessionMock.h"
+#include "MediaKeysCapabilitiesFactoryMock.h"
+#include "MediaKeysServerInternal.h"
+#include "OcdmSystemMock.h"
+#include "RialtoLogging.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+using firebolt::rialto::IMediaKeysClient;
+using firebolt::rialto::KeySessionType;
+using firebolt::rialto::MediaKeyErrorStatus;
+using firebolt::rialto::MediaKeysCapabilitiesFactoryMock;
+using firebolt::rialto::server::IMediaKeySession;
+using firebolt::rialto::server::IMediaKeySessionFactory;
+using firebolt::rialto::server::IMediaKeysServerInternal;
+using firebolt::rialto::server::IMediaKeysServerInternalFactory;
+using firebolt::rialto::server::IOcdmSystem;
+using firebolt::rialto::server::IOcdmSystemFactory;
+using firebolt::rialto::server::MainThreadFactory;
+using firebolt::rialto::server::MediaKeySessionMock;
+using firebolt::rialto::server::MediaKeysServerInternal;
+using firebolt::rialto::server::OcdmSystemMock;
+using firebolt::rialto::server::service::CdmService;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+namespace
+{
+constexpr int kMediaKeysHandle{1};
+constexpr int kNumOfDecryptWorkIterations{200};
+constexpr int kDrmTimeMs{2};
+constexpr int kRunTimeMs{1000};
+
+/**
+ * @brief A session whose decrypt does a fixed amount of work, without going through the mock.
+ */
+class BenchMediaKeySession : public NiceMock<MediaKeySessionMock>
+{
+public:
+    MediaKeyErrorStatus decrypt(GstBuffer *encrypted, GstBuffer *subSample, const uint32_t subSampleCount,
+                                GstBuffer *IV, GstBuffer *keyId, uint32_t initWithLast15) override
+    {
+        volatile uint64_t work = 0;
+        for (int i = 0; i < kNumOfDecryptWorkIterations; i++)
+            work += i;
+        return MediaKeyErrorStatus::OK;
+    }
+};
+
+class BenchMediaKeySessionFactory : public IMediaKeySessionFactory
+{
+public:
+    std::unique_ptr<IMediaKeySession> createMediaKeySession(const std::string &keySystem, int32_t keySessionId,
+                                                            const IOcdmSystem &ocdmSystem, KeySessionType sessionType,
+                                                            std::weak_ptr<IMediaKeysClient> client,
+                                                            bool isLDL) const override
+    {
+        return std::make_unique<BenchMediaKeySession>();
+    }
+};
+
+/**
+ * @brief Creates OCDM systems whose getDrmTime blocks the main thread for a while.
+ */
+class BenchOcdmSystemFactory : public IOcdmSystemFactory
+{
+public:
+    std::unique_ptr<IOcdmSystem> createOcdmSystem(const std::string &keySystem) const override
+    {
+        auto ocdmSystem = std::make_unique<NiceMock<OcdmSystemMock>>();
+        ON_CALL(*ocdmSystem, getDrmTime(_))
+            .WillByDefault(Invoke(
+                [](uint64_t *drmTime)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(kDrmTimeMs));
+                    return MediaKeyErrorStatus::OK;
+                }));
+        return ocdmSystem;
+    }
+};
+
+class BenchMediaKeysFactory : public IMediaKeysServerInternalFactory
+{
+public:
+    std::unique_ptr<firebolt::rialto::IMediaKeys> createMediaKeys(const std::string &keySystem) const override
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<IMediaKeysServerInternal> createMediaKeysServerInternal(const std::string &keySystem) const override
+    {
+        return std::make_unique<MediaKeysServerInternal>(keySystem, std::make_shared<MainThreadFactory>(),
+                                                         std::make_shared<BenchOcdmSystemFactory>(),
+                                                         std::make_shared<BenchMediaKeySessionFactory>());
+    }
+};
+
+/**
+ * @brief Decrypts on an audio and a video streaming thread, optionally while another thread makes control calls.
+ */
+void benchDecrypt(CdmService &cdmService, int32_t keySessionId, bool withControlCalls, const std::string &label)
+{
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> numOfDecrypts{0};
+    auto stream = [&]()
+    {
+        GstBuffer buffer{};
+        uint64_t count = 0;
+        while (!stop)
+        {
+            cdmService.incrementSessionIdUsageCounter(keySessionId);
+            cdmService.decrypt(keySessionId, &buffer, &buffer, 0, &buffer, &buffer, 0);
+            cdmService.decrementSessionIdUsageCounter(keySessionId);
+            count++;
+        }
+        numOfDecrypts += count;
+    };
+
+    std::thread controlThread;
+    if (withControlCalls)
+    {
+        controlThread = std::thread(
+            [&]()
+            {
+                uint64_t drmTime = 0;
+                while (!stop)
+                    cdmService.getDrmTime(kMediaKeysHandle, drmTime);
+            });
+    }
+
+    const auto kStart = bench::Clock::now();
+    std::thread audioThread(stream);
+    std::thread videoThread(stream);
+    std::this_thread::sleep_for(std::chrono::milliseconds(kRunTimeMs));
+    stop = true;
+    audioThread.join();
+    videoThread.join();
+    const double kElapsedUs = bench::elapsedUs(kStart);
+    if (controlThread.joinable())
+        controlThread.join();
+
+    bench::printRate(label, numOfDecrypts, kElapsedUs);
+}
+} // namespace
+
+int main()
+{
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_SERVER, RIALTO_DEBUG_LEVEL_ERROR);
+
+    CdmService cdmService{std::make_shared<BenchMediaKeysFactory>(),
+                          std::make_shared<NiceMock<MediaKeysCapabilitiesFactoryMock>>()};
+    cdmService.switchToActive();
+    cdmService.createMediaKeys(kMediaKeysHandle, "com.widevine.alpha");
+
+    int32_t keySessionId = -1;
+    cdmService.createKeySession(kMediaKeysHandle, KeySessionType::TEMPORARY, nullptr, false, keySessionId);
+
+    benchDecrypt(cdmService, keySessionId, false, "audio+video decrypts");
+    benchDecrypt(cdmService, keySessionId, true, "audio+video decrypts, OCDM control");
+
+    cdmService.destroyMediaKeys(kMediaKeysHandle);
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the latency of short method calls while another client of the same server makes calls that block in
+ * the service, with the calls made inline on the server thread and on the dispatcher's worker threads, and the
+ * rate of back-to-back calls of a single client in both modes.
+ */
+
+#include "BenchUtils.h"
+#include "IIpcChannel.h"
+#include "IIpcControllerFactory.h"
+#include "IIpcServer.h"
+#include "IIpcServerFactory.h"
+#include "RialtoLogging.h"
+#include "testmodule.pb.h"
+
+#include <atomic>
+#include <memory>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::ipc::IChannel;
+using firebolt::rialto::ipc::IChannelFactory;
+using firebolt::rialto::ipc::IControllerFactory;
+using firebolt::rialto::ipc::IServer;
+using firebolt::rialto::ipc::IServerFactory;
+
+namespace
+{
+constexpr int kNumOfClients{4};
+constexpr int kNumOfPolls{500};
+constexpr int kBlockingCallMs{20};
+constexpr int kPollIntervalMs{2};
+constexpr int kNumOfEchoCalls{50000};
+
+/**
+ * @brief The service, TestRequestSingleVar blocks for var1 milliseconds and TestResponseSingleVar returns at once.
+ */
+class BenchModule : public firebolt::rialto::TestModule
+{
+public:
+    void TestRequestSingleVar(google::protobuf::RpcController *controller,
+                              const firebolt::rialto::TestSingleVar *request, firebolt::rialto::TestNoVar *response,
+                              google::protobuf::Closure *done) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(request->var1()));
+        done->Run();
+    }
+
+    void TestResponseSingleVar(google::protobuf::RpcController *controller, const firebolt::rialto::TestNoVar *request,
+                               firebolt::rialto::TestSingleVar *response, google::protobuf::Closure *done) override
+    {
+        response->set_var1(1234);
+        done->Run();
+    }
+};
+
+void onCallDone(bool *done)
+{
+    *done = true;
+}
+
+class BenchServer
+{
+public:
+    BenchServer(unsigned flags, int numOfClients)
+        : m_server(IServerFactory::createFactory()->create(flags)), m_module(std::make_shared<BenchModule>())
+    {
+        for (int i = 0; i < numOfClients; i++)
+        {
+            int socks[2];
+            socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, socks);
+            m_server->addClient(socks[0], nullptr)->exportService(m_module);
+            m_channels.push_back(IChannelFactory::createFactory()->createChannel(socks[1]));
+        }
+
+        m_serverThread = std::thread(
+            [this]()
+            {
+                while (!m_stop && m_server->process())
+                    m_server->wait(10);
+            });
+    }
+
+    ~BenchServer()
+    {
+        m_channels.clear();
+        m_stop = true;
+        m_serverThread.join();
+    }
+
+    const std::shared_ptr<IChannel> &channel(int index) const { return m_channels[index]; }
+
+private:
+    std::shared_ptr<IServer> m_server;
+    std::shared_ptr<BenchModule> m_module;
+    std::vector<std::shared_ptr<IChannel>> m_channels;
+    std::atomic<bool> m_stop{false};
+    std::thread m_serverThread;
+};
+
+void callBlocking(const std::shared_ptr<IChannel> &channel, int32_t blockMs)
+{
+    firebolt::rialto::TestModule_Stub stub(channel.get());
+    firebolt::rialto::TestSingleVar request;
+    firebolt::rialto::TestNoVar response;
+    request.set_var1(blockMs);
+
+    auto controller = IControllerFactory::createFactory()->create();
+    bool done = false;
+    stub.TestRequestSingleVar(controller.get(), &request, &response, google::protobuf::NewCallback(onCallDone, &done));
+    while (channel->process() && !done)
+        channel->wait(-1);
+}
+
+void callShort(const std::shared_ptr<IChannel> &channel)
+{
+    firebolt::rialto::TestModule_Stub stub(channel.get());
+    firebolt::rialto::TestNoVar request;
+    firebolt::rialto::TestSingleVar response;
+
+    auto controller = IControllerFactory::createFactory()->create();
+    bool done = false;
+    stub.TestResponseSingleVar(controller.get(), &request, &response, google::protobuf::NewCallback(onCallDone, &done));
+    while (channel->process() && !done)
+        channel->wait(-1);
+}
+
+/**
+ * @brief One client keeps making blocking calls while the other clients poll with short calls.
+ */
+void benchHeadOfLineBlocking(unsigned flags, const std::string &label)
+{
+    BenchServer server(flags, kNumOfClients);
+
+    std::atomic<bool> stopBlockingClient{false};
+    std::thread blockingClient(
+        [&]()
+        {
+            while (!stopBlockingClient)
+                callBlocking(server.channel(0), kBlockingCallMs);
+        });
+
+    std::vector<bench::LatencyStats> stats(kNumOfClients, bench::LatencyStats(kNumOfPolls));
+    std::vector<std::thread> pollingClients;
+    for (int i = 1; i < kNumOfClients; i++)
+    {
+        pollingClients.emplace_back(
+            [&, i]()
+            {
+                for (int poll = 0; poll < kNumOfPolls; poll++)
+                {
+                    const auto kStart = bench::Clock::now();
+                    callShort(server.channel(i));
+                    stats[i].add(bench::elapsedUs(kStart));
+                    std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+                }
+            });
+    }
+
+    for (std::thread &thread : pollingClients)
+        thread.join();
+    stopBlockingClient = true;
+    blockingClient.join();
+
+    bench::LatencyStats allStats;
+    for (const bench::LatencyStats &clientStats : stats)
+        allStats.merge(clientStats);
+    allStats.print(label + " short call latency");
+}
+
+/**
+ * @brief A single client makes back-to-back short calls.
+ */
+void benchEchoRate(unsigned flags, const std::string &label)
+{
+    BenchServer server(flags, 1);
+
+    const auto kStart = bench::Clock::now();
+    for (int i = 0; i < kNumOfEchoCalls; i++)
+        callShort(server.channel(0));
+    bench::printRate(label + " back-to-back calls", kNumOfEchoCalls, bench::elapsedUs(kStart));
+}
+} // namespace
+
+int main()
+{
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_IPC, RIALTO_DEBUG_LEVEL_DEFAULT);
+
+    benchHeadOfLineBlocking(0, "inline");
+    benchHeadOfLineBlocking(IServerFactory::DISPATCH_ON_WORKER_THREADS, "dispatch");
+
+    benchEchoRate(0, "inline");
+    benchEchoRate(IServerFactory::DISPATCH_ON_WORKER_THREADS, "dispatch");
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the cost per frame of writing the frames of a media segment request to the shared memory and reading
+ * them back on the server, with the protobuf metadata of V2 and the fixed layout headers of V3.  A writer is created
+ * for each request, as on the client, so the write cost includes clearing the shared memory the writer needs.
+ */
+
+#include "BenchUtils.h"
+#include "DataReaderV2.h"
+#include "DataReaderV3.h"
+#include "IMediaPipeline.h"
+#include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
+#include "RialtoLogging.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using firebolt::rialto::IMediaPipeline;
+using firebolt::rialto::server::IDataReader;
+using firebolt::rialto::MediaPlayerShmInfo;
+using firebolt::rialto::MediaSourceType;
+
+namespace
+{
+constexpr uint32_t kShmSize{1024 * 1024};
+constexpr uint32_t kDataOffset{4};
+constexpr int kNumOfFrames{24};
+constexpr int kNumOfIterations{20000};
+constexpr int64_t kFrameDurationNs{20000000};
+constexpr size_t kFrameSize{512};
+
+/**
+ * @brief Builds the encrypted audio frames of one request, as sent at 50 frames per second.
+ */
+std::vector<std::unique_ptr<IMediaPipeline::MediaSegment>> createSegments(const std::vector<uint8_t> &payload)
+{
+    std::vector<std::unique_ptr<IMediaPipeline::MediaSegment>> segments;
+    for (int i = 0; i < kNumOfFrames; i++)
+    {
+        auto segment = std::make_unique<IMediaPipeline::MediaSegmentAudio>(1, 1000000000LL + i * kFrameDurationNs,
+                                                                            kFrameDurationNs, 48000, 2);
+        segment->setData(payload.size(), payload.data());
+        segment->setEncrypted(true);
+        segment->setMediaKeySessionId(3);
+        segment->setKeyId(std::vector<uint8_t>(16, 1));
+        segment->setInitVector(std::vector<uint8_t>(16, 2));
+        segment->addSubSample(16, kFrameSize - 16);
+        segments.emplace_back(std::move(segment));
+    }
+
+    return segments;
+}
+
+/**
+ * @brief Writes and reads the frames with a writer and a reader of the same metadata version.
+ */
+template <class Writer>
+void benchMetadata(const std::vector<std::unique_ptr<IMediaPipeline::MediaSegment>> &segments,
+                   std::vector<uint8_t> &shm, const std::function<std::unique_ptr<IDataReader>()> &createReader,
+                   const std::string &label)
+{
+    auto shmInfo =
+        std::make_shared<MediaPlayerShmInfo>(MediaPlayerShmInfo{kDataOffset, 0, kDataOffset, kShmSize - kDataOffset});
+
+    const auto kWriteStart = bench::Clock::now();
+    for (int i = 0; i < kNumOfIterations; i++)
+    {
+        Writer writer(shm.data(), shmInfo);
+        for (const auto &segment : segments)
+            writer.writeFrame(segment);
+    }
+    const double kWriteUs = bench::elapsedUs(kWriteStart);
+
+    size_t numOfFramesRead = 0;
+    const auto kReadStart = bench::Clock::now();
+    for (int i = 0; i < kNumOfIterations; i++)
+    {
+        std::unique_ptr<IDataReader> reader = createReader();
+        numOfFramesRead += reader->readData().size();
+    }
+    const double kReadUs = bench::elapsedUs(kReadStart);
+
+    const double kNumOfFramesWritten = static_cast<double>(kNumOfIterations) * kNumOfFrames;
+    printf("%-40s write %8.1f ns/frame  read %8.1f ns/frame  (%zu frames read)\n", label.c_str(),
+           kWriteUs * 1000.0 / kNumOfFramesWritten, kReadUs * 1000.0 / kNumOfFramesWritten, numOfFramesRead);
+}
+} // namespace
+
+int main()
+{
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_COMMON, RIALTO_DEBUG_LEVEL_DEFAULT);
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_SERVER, RIALTO_DEBUG_LEVEL_DEFAULT);
+
+    std::vector<uint8_t> shm(kShmSize);
+    const std::vector<uint8_t> kPayload(kFrameSize, 7);
+    const auto kSegments = createSegments(kPayload);
+
+    benchMetadata<firebolt::rialto::common::MediaFrameWriterV2>(
+        kSegments, shm,
+        [&shm]()
+        {
+            return std::make_unique<firebolt::rialto::server::DataReaderV2>(MediaSourceType::AUDIO, shm.data(),
+                                                                            kDataOffset, kNumOfFrames);
+        },
+        "metadata V2");
+    benchMetadata<firebolt::rialto::common::MediaFrameWriterV3>(
+        kSegments, shm,
+        [&shm]()
+        {
+            return std::make_unique<firebolt::rialto::server::DataReaderV3>(MediaSourceType::AUDIO, shm.data(),
+                                                                            kDataOffset, kShmSize - kDataOffset,
+                                                                            kNumOfFrames);
+        },
+        "metadata V3");
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the round trip latency of short method calls on the socket and on the shared memory rings, both with
+ * back-to-back calls, where the server is still spinning on its ring when the next call arrives, and with calls
+ * spaced out so that the server sleeps and has to be woken by the doorbell.
+ */
+
+#include "BenchUtils.h"
+#include "IIpcChannel.h"
+#include "IIpcControllerFactory.h"
+#include "IIpcServer.h"
+#include "IIpcServerFactory.h"
+#include "RialtoLogging.h"
+#include "testmodule.pb.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+
+using firebolt::rialto::ipc::IChannel;
+using firebolt::rialto::ipc::IChannelFactory;
+using firebolt::rialto::ipc::IControllerFactory;
+using firebolt::rialto::ipc::IServer;
+using firebolt::rialto::ipc::IServerFactory;
+
+namespace
+{
+constexpr int kNumOfWarmUpCalls{100};
+constexpr int kNumOfBackToBackCalls{20000};
+constexpr int kNumOfSpacedCalls{2000};
+constexpr int kCallIntervalUs{500};
+
+/**
+ * @brief The service, TestResponseSingleVar returns at once.
+ */
+class BenchModule : public firebolt::rialto::TestModule
+{
+public:
+    void TestResponseSingleVar(google::protobuf::RpcController *controller, const firebolt::rialto::TestNoVar *request,
+                               firebolt::rialto::TestSingleVar *response, google::protobuf::Closure *done) override
+    {
+        response->set_var1(1234);
+        done->Run();
+    }
+};
+
+void onCallDone(bool *done)
+{
+    *done = true;
+}
+
+class BenchServer
+{
+public:
+    explicit BenchServer(unsigned flags)
+        : m_server(IServerFactory::createFactory()->create(flags)), m_module(std::make_shared<BenchModule>())
+    {
+        int socks[2];
+        socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, socks);
+        m_server->addClient(socks[0], nullptr)->exportService(m_module);
+        m_channel = IChannelFactory::createFactory()->createChannel(socks[1]);
+
+        m_serverThread = std::thread(
+            [this]()
+            {
+                while (!m_stop && m_server->process())
+                    m_server->wait(10);
+            });
+    }
+
+    ~BenchServer()
+    {
+        m_channel.reset();
+        m_stop = true;
+        m_serverThread.join();
+    }
+
+    const std::shared_ptr<IChannel> &channel() const { return m_channel; }
+
+private:
+    std::shared_ptr<IServer> m_server;
+    std::shared_ptr<BenchModule> m_module;
+    std::shared_ptr<IChannel> m_channel;
+    std::atomic<bool> m_stop{false};
+    std::thread m_serverThread;
+};
+
+void callShort(const std::shared_ptr<IChannel> &channel)
+{
+    firebolt::rialto::TestModule_Stub stub(channel.get());
+    firebolt::rialto::TestNoVar request;
+    firebolt::rialto::TestSingleVar response;
+
+    auto controller = IControllerFactory::createFactory()->create();
+    bool done = false;
+    stub.TestResponseSingleVar(controller.get(), &request, &response, google::protobuf::NewCallback(onCallDone, &done));
+    while (channel->process() && !done)
+        channel->wait(-1);
+}
+
+/**
+ * @brief Makes short calls, waiting \a intervalUs between them, and prints their round trip latency.
+ */
+void benchRoundTrip(unsigned flags, int numOfCalls, int intervalUs, const std::string &label)
+{
+    BenchServer server(flags);
+
+    // the first round trips move the channel onto the rings
+    for (int i = 0; i < kNumOfWarmUpCalls; i++)
+        callShort(server.channel());
+
+    bench::LatencyStats stats(numOfCalls);
+    for (int i = 0; i < numOfCalls; i++)
+    {
+        const auto kStart = bench::Clock::now();
+        callShort(server.channel());
+        stats.add(bench::elapsedUs(kStart));
+
+        if (intervalUs > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(intervalUs));
+    }
+
+    stats.print(label);
+}
+} // namespace
+
+int main()
+{
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_IPC, RIALTO_DEBUG_LEVEL_DEFAULT);
+
+    benchRoundTrip(0, kNumOfBackToBackCalls, 0, "socket back-to-back");
+    benchRoundTrip(IServerFactory::SHM_RING_TRANSPORT, kNumOfBackToBackCalls, 0, "ring back-to-back");
+
+    benchRoundTrip(0, kNumOfSpacedCalls, kCallIntervalUs, "socket spaced");
+    benchRoundTrip(IServerFactory::SHM_RING_TRANSPORT, kNumOfSpacedCalls, kCallIntervalUs, "ring spaced");
+
+    return 0;
+}
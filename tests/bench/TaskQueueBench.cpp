@@ -0,0 +1,207 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the enqueue-to-execute latency and the task rate of the task queues: the bare MpscQueue with a single
+ * consumer thread, the EventThread and the MainThread strands, with one and several producer threads.
+ *
+ * A burst run pushes the tasks as fast as the producers can, so its latency includes the time spent in the backlog.
+ * A paced run leaves a gap between the tasks of a producer, so its latency is that of a task queued on an idle
+ * consumer.
+ */
+
+#include "BenchUtils.h"
+#include "EventThread.h"
+#include "MainThread.h"
+#include "MpscQueue.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::common::EventThread;
+using firebolt::rialto::common::MpscQueue;
+using firebolt::rialto::server::MainThread;
+
+namespace
+{
+constexpr int kNumOfBurstTasks{50000};
+constexpr int kNumOfPacedTasks{5000};
+constexpr std::chrono::microseconds kPaceInterval{50};
+constexpr std::uint32_t kQueuePoolSize{1024};
+
+/**
+ * @brief Runs the producers, each enqueueing numOfTasks tasks that record their latency, and prints the results.
+ *
+ * @param[in] label          : The name of the measurement.
+ * @param[in] numOfProducers : The number of producer threads.
+ * @param[in] numOfTasks     : The number of tasks each producer enqueues.
+ * @param[in] isPaced        : Whether the producers leave a gap between their tasks.
+ * @param[in] enqueue        : Enqueues a task on behalf of the producer with the given index.
+ * @param[in] waitForTasks   : Returns once all the enqueued tasks have been executed.
+ */
+void runProducers(const std::string &label, int numOfProducers, int numOfTasks, bool isPaced,
+                  const std::function<void(int, std::function<void()> &&)> &enqueue,
+                  const std::function<void()> &waitForTasks)
+{
+    std::vector<std::vector<double>> latencies(numOfProducers, std::vector<double>(numOfTasks));
+
+    const auto kStart = bench::Clock::now();
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < numOfProducers; producer++)
+    {
+        producers.emplace_back(
+            [&, producer]()
+            {
+                std::vector<double> &producerLatencies = latencies[producer];
+                for (int i = 0; i < numOfTasks; i++)
+                {
+                    const auto kEnqueueTime = bench::Clock::now();
+                    enqueue(producer, [&producerLatencies, i, kEnqueueTime]()
+                            { producerLatencies[i] = bench::elapsedUs(kEnqueueTime); });
+                    if (isPaced)
+                        std::this_thread::sleep_for(kPaceInterval);
+                }
+            });
+    }
+    for (std::thread &thread : producers)
+        thread.join();
+    waitForTasks();
+    const double kElapsedUs = bench::elapsedUs(kStart);
+
+    bench::LatencyStats stats(numOfProducers * numOfTasks);
+    for (const std::vector<double> &producerLatencies : latencies)
+    {
+        for (double latency : producerLatencies)
+            stats.add(latency);
+    }
+
+    const std::string kFullLabel = label + " " + std::to_string(numOfProducers) + "p" + (isPaced ? " paced" : " burst");
+    stats.print(kFullLabel);
+    if (!isPaced)
+        bench::printRate(kFullLabel, numOfProducers * numOfTasks, kElapsedUs);
+}
+
+/**
+ * @brief A bare queue with one consumer thread running the popped tasks.
+ */
+void benchMpscQueue(int numOfProducers, bool isPaced)
+{
+    MpscQueue<std::function<void()>> queue{kQueuePoolSize};
+    std::atomic<int> numOfExecutedTasks{0};
+    std::atomic<bool> isRunning{true};
+
+    std::thread consumer(
+        [&]()
+        {
+            std::function<void()> task;
+            while (isRunning || !queue.isEmpty())
+            {
+                if (queue.popOrWait(task))
+                {
+                    task();
+                    ++numOfExecutedTasks;
+                }
+            }
+        });
+
+    const int kNumOfTasks{isPaced ? kNumOfPacedTasks : kNumOfBurstTasks};
+    runProducers("MpscQueue", numOfProducers, kNumOfTasks, isPaced,
+                 [&](int, std::function<void()> &&task) { queue.push(std::move(task)); },
+                 [&]()
+                 {
+                     while (numOfExecutedTasks < numOfProducers * kNumOfTasks)
+                         std::this_thread::yield();
+                 });
+
+    isRunning = false;
+    queue.close();
+    consumer.join();
+}
+
+void benchEventThread(int numOfProducers, bool isPaced)
+{
+    EventThread eventThread{"bench"};
+
+    runProducers("EventThread", numOfProducers, isPaced ? kNumOfPacedTasks : kNumOfBurstTasks, isPaced,
+                 [&](int, std::function<void()> &&task) { eventThread.add(std::move(task)); },
+                 [&]() { eventThread.flush(); });
+}
+
+/**
+ * @brief The producers enqueue on the strand of one client, or each on the strand of its own client.
+ */
+void benchMainThread(int numOfProducers, bool isSharedStrand, bool isPaced)
+{
+    MainThread mainThread;
+    std::vector<uint32_t> clients;
+    for (int producer = 0; producer < numOfProducers; producer++)
+    {
+        clients.push_back((isSharedStrand && producer > 0) ? clients[0] : mainThread.registerClient());
+    }
+
+    runProducers(std::string("MainThread ") + (isSharedStrand ? "1 strand" : "n strands"), numOfProducers,
+                 isPaced ? kNumOfPacedTasks : kNumOfBurstTasks, isPaced,
+                 [&](int producer, std::function<void()> &&task)
+                 { mainThread.enqueueTask(clients[producer], std::move(task)); },
+                 [&]()
+                 {
+                     for (uint32_t client : clients)
+                         mainThread.enqueueTaskAndWait(client, []() {});
+                 });
+}
+
+void benchMainThreadRoundTrip()
+{
+    MainThread mainThread;
+    const uint32_t kClient = mainThread.registerClient();
+
+    bench::LatencyStats stats(kNumOfBurstTasks);
+    const auto kStart = bench::Clock::now();
+    for (int i = 0; i < kNumOfBurstTasks; i++)
+    {
+        const auto kCallTime = bench::Clock::now();
+        mainThread.enqueueTaskAndWait(kClient, []() {});
+        stats.add(bench::elapsedUs(kCallTime));
+    }
+    const double kElapsedUs = bench::elapsedUs(kStart);
+
+    stats.print("MainThread enqueueTaskAndWait");
+    bench::printRate("MainThread enqueueTaskAndWait", kNumOfBurstTasks, kElapsedUs);
+}
+} // namespace
+
+int main()
+{
+    for (bool isPaced : {false, true})
+    {
+        for (int numOfProducers : {1, 4})
+        {
+            benchMpscQueue(numOfProducers, isPaced);
+            benchEventThread(numOfProducers, isPaced);
+            benchMainThread(numOfProducers, true, isPaced);
+        }
+        benchMainThread(4, false, isPaced);
+    }
+    benchMainThreadRoundTrip();
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompletionLatch.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using firebolt::rialto::common::CompletionLatch;
+
+TEST(CompletionLatchTest, shouldNotBlockWhenAlreadyDone)
+{
+    CompletionLatch sut;
+    EXPECT_FALSE(sut.isDone());
+    sut.setDone();
+    EXPECT_TRUE(sut.isDone());
+    sut.wait();
+}
+
+TEST(CompletionLatchTest, shouldWakeWaitingThread)
+{
+    CompletionLatch sut;
+    bool isWorkDone{false};
+    std::thread worker{[&]()
+                       {
+                           isWorkDone = true;
+                           sut.setDone();
+                       }};
+    sut.wait();
+    EXPECT_TRUE(isWorkDone);
+    worker.join();
+}
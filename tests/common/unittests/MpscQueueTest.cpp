@@ -0,0 +1,121 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MpscQueue.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::common::MpscQueue;
+
+namespace
+{
+constexpr std::uint32_t kPoolSize{4};
+constexpr std::uint32_t kNumOfProducers{4};
+constexpr std::uint32_t kNumOfElementsPerProducer{10000};
+} // namespace
+
+TEST(MpscQueueTest, shouldPopElementsInPushOrder)
+{
+    MpscQueue<int> sut{kPoolSize};
+    for (int i = 0; i < 10; ++i)
+    {
+        sut.push(int{i});
+    }
+    EXPECT_EQ(sut.getSize(), 10u);
+
+    int value{-1};
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(sut.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(sut.tryPop(value));
+    EXPECT_TRUE(sut.isEmpty());
+    EXPECT_EQ(sut.getSize(), 0u);
+}
+
+TEST(MpscQueueTest, shouldDestroyRemainingElements)
+{
+    std::shared_ptr<int> element{std::make_shared<int>(3)};
+    {
+        MpscQueue<std::shared_ptr<int>> sut{kPoolSize};
+        for (std::uint32_t i = 0; i < 2 * kPoolSize; ++i)
+        {
+            sut.push(std::shared_ptr<int>{element});
+        }
+        std::shared_ptr<int> value;
+        ASSERT_TRUE(sut.tryPop(value));
+        EXPECT_EQ(element.use_count(), 2 * kPoolSize + 1);
+    }
+    EXPECT_EQ(element.use_count(), 1);
+}
+
+TEST(MpscQueueTest, shouldPopAllElementsOfConcurrentProducers)
+{
+    MpscQueue<std::uint32_t> sut{kPoolSize};
+    std::vector<std::thread> producers;
+    for (std::uint32_t producer = 0; producer < kNumOfProducers; ++producer)
+    {
+        producers.emplace_back(
+            [&sut, producer]()
+            {
+                for (std::uint32_t i = 0; i < kNumOfElementsPerProducer; ++i)
+                {
+                    sut.push(producer * kNumOfElementsPerProducer + i);
+                }
+            });
+    }
+
+    std::vector<std::uint32_t> nextElements(kNumOfProducers, 0);
+    for (std::uint32_t i = 0; i < kNumOfProducers * kNumOfElementsPerProducer; ++i)
+    {
+        std::uint32_t value{0};
+        while (!sut.popOrWait(value))
+        {
+        }
+        const std::uint32_t kProducer{value / kNumOfElementsPerProducer};
+        ASSERT_LT(kProducer, kNumOfProducers);
+        EXPECT_EQ(value % kNumOfElementsPerProducer, nextElements[kProducer]++);
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_TRUE(sut.isEmpty());
+}
+
+TEST(MpscQueueTest, shouldReturnFromPopOrWaitWhenClosed)
+{
+    MpscQueue<int> sut{kPoolSize};
+    std::thread consumer{[&sut]()
+                         {
+                             int value{0};
+                             EXPECT_FALSE(sut.popOrWait(value));
+                         }};
+    sut.close();
+    consumer.join();
+
+    int value{0};
+    sut.push(1);
+    EXPECT_TRUE(sut.popOrWait(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(sut.popOrWait(value));
+}
@@ -0,0 +1,223 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Timer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr std::chrono::milliseconds kShortTimeout{10};
+constexpr std::chrono::milliseconds kLongTimeout{std::chrono::hours{1}};
+constexpr std::chrono::seconds kWaitTimeout{5};
+} // namespace
+
+class TimerServiceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Cancelled timers of the previous tests leave the heap when they expire
+        const auto kDeadline{std::chrono::steady_clock::now() + kWaitTimeout};
+        while (0 != TimerService::instance().getNumOfScheduledTimers() && std::chrono::steady_clock::now() < kDeadline)
+        {
+            std::this_thread::sleep_for(kShortTimeout);
+        }
+        ASSERT_EQ(0U, TimerService::instance().getNumOfScheduledTimers());
+    }
+
+    std::function<void()> recordExpiry(int id)
+    {
+        return [this, id]()
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_expiries.push_back(id);
+            m_cv.notify_all();
+        };
+    }
+
+    bool waitForExpiries(std::size_t numOfExpiries)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, kWaitTimeout, [&]() { return m_expiries.size() >= numOfExpiries; });
+    }
+
+    std::size_t getNumOfExpiries()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_expiries.size();
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<int> m_expiries;
+};
+
+/**
+ * Test that one-shot timers expire once, in the order of their deadlines.
+ */
+TEST_F(TimerServiceTest, OneShotTimersExpireInDeadlineOrder)
+{
+    Timer thirdTimer{std::chrono::milliseconds{60}, recordExpiry(3)};
+    Timer firstTimer{std::chrono::milliseconds{20}, recordExpiry(1)};
+    Timer secondTimer{std::chrono::milliseconds{40}, recordExpiry(2)};
+
+    ASSERT_TRUE(waitForExpiries(3));
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), m_expiries);
+    EXPECT_FALSE(firstTimer.isActive());
+    EXPECT_FALSE(secondTimer.isActive());
+    EXPECT_FALSE(thirdTimer.isActive());
+
+    std::this_thread::sleep_for(4 * kShortTimeout);
+    EXPECT_EQ(3U, getNumOfExpiries());
+}
+
+/**
+ * Test that a periodic timer expires until it is cancelled, interleaved with a one-shot timer in deadline order.
+ */
+TEST_F(TimerServiceTest, PeriodicTimerExpiresUntilCancelled)
+{
+    Timer periodicTimer{kShortTimeout, recordExpiry(1), TimerType::PERIODIC};
+    Timer oneShotTimer{std::chrono::milliseconds{35}, recordExpiry(2)};
+
+    // The fourth periodic expiry is due after the one-shot timer at the earliest
+    ASSERT_TRUE(waitForExpiries(5));
+    EXPECT_TRUE(periodicTimer.isActive());
+    periodicTimer.cancel();
+    EXPECT_FALSE(periodicTimer.isActive());
+    const std::size_t kNumOfExpiries{getNumOfExpiries()};
+
+    std::this_thread::sleep_for(4 * kShortTimeout);
+    EXPECT_EQ(kNumOfExpiries, getNumOfExpiries());
+    EXPECT_EQ(1, m_expiries[0]);
+    EXPECT_EQ(1, std::count(m_expiries.begin(), m_expiries.begin() + 5, 2));
+}
+
+/**
+ * Test that a timer cancelled before its deadline never expires.
+ */
+TEST_F(TimerServiceTest, CancelBeforeExpiry)
+{
+    Timer cancelledTimer{kShortTimeout, recordExpiry(1)};
+    Timer timer{2 * kShortTimeout, recordExpiry(2)};
+    cancelledTimer.cancel();
+    EXPECT_FALSE(cancelledTimer.isActive());
+
+    ASSERT_TRUE(waitForExpiries(1));
+    std::this_thread::sleep_for(2 * kShortTimeout);
+    EXPECT_EQ((std::vector<int>{2}), m_expiries);
+}
+
+/**
+ * Test that cancel waits for the callback that is being executed on the timer thread.
+ */
+TEST_F(TimerServiceTest, CancelWhileExpiring)
+{
+    std::atomic<bool> callbackStarted{false};
+    std::atomic<bool> callbackFinished{false};
+    Timer timer{kShortTimeout,
+                [&]()
+                {
+                    callbackStarted = true;
+                    std::this_thread::sleep_for(5 * kShortTimeout);
+                    callbackFinished = true;
+                },
+                TimerType::PERIODIC};
+
+    const auto kDeadline{std::chrono::steady_clock::now() + kWaitTimeout};
+    while (!callbackStarted && std::chrono::steady_clock::now() < kDeadline)
+    {
+        std::this_thread::yield();
+    }
+    ASSERT_TRUE(callbackStarted);
+
+    timer.cancel();
+    EXPECT_TRUE(callbackFinished);
+    EXPECT_FALSE(timer.isActive());
+}
+
+/**
+ * Test that a periodic timer can be cancelled from its own callback, without a deadlock.
+ */
+TEST_F(TimerServiceTest, CancelFromCallback)
+{
+    std::unique_ptr<Timer> timer;
+    std::mutex timerMutex;
+    {
+        std::unique_lock<std::mutex> lock{timerMutex};
+        timer = std::make_unique<Timer>(kShortTimeout,
+                                        [&]()
+                                        {
+                                            std::unique_lock<std::mutex> timerLock{timerMutex};
+                                            timer->cancel();
+                                            recordExpiry(1)();
+                                        },
+                                        TimerType::PERIODIC);
+    }
+
+    ASSERT_TRUE(waitForExpiries(1));
+    std::this_thread::sleep_for(4 * kShortTimeout);
+    EXPECT_EQ(1U, getNumOfExpiries());
+    EXPECT_FALSE(timer->isActive());
+}
+
+/**
+ * Test that cancelled timers are removed from the heap once they make up most of it, and that the remaining timers
+ * still expire.
+ */
+TEST_F(TimerServiceTest, HeapCompaction)
+{
+    constexpr std::size_t kNumOfTimers{128};
+    std::vector<std::unique_ptr<Timer>> timers;
+    for (std::size_t i = 0; i < kNumOfTimers; ++i)
+    {
+        timers.push_back(std::make_unique<Timer>(kLongTimeout, recordExpiry(0)));
+    }
+    EXPECT_EQ(kNumOfTimers, TimerService::instance().getNumOfScheduledTimers());
+
+    // Half of the heap has to be cancelled before it is compacted
+    for (std::size_t i = 0; i < kNumOfTimers / 2 - 1; ++i)
+    {
+        timers[i]->cancel();
+    }
+    EXPECT_EQ(kNumOfTimers, TimerService::instance().getNumOfScheduledTimers());
+    timers[kNumOfTimers / 2 - 1]->cancel();
+    EXPECT_EQ(kNumOfTimers / 2, TimerService::instance().getNumOfScheduledTimers());
+
+    Timer timer{kShortTimeout, recordExpiry(1)};
+    ASSERT_TRUE(waitForExpiries(1));
+    EXPECT_EQ((std::vector<int>{1}), m_expiries);
+    for (std::size_t i = kNumOfTimers / 2; i < kNumOfTimers; ++i)
+    {
+        EXPECT_TRUE(timers[i]->isActive());
+    }
+
+    timers.clear();
+    EXPECT_EQ(0U, TimerService::instance().getNumOfScheduledTimers());
+}
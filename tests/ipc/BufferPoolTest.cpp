@@ -0,0 +1,162 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferPool.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * Test that a released buffer is reused for the next allocation of the same size class.
+ */
+TEST(BufferPoolTest, ReusesReleasedBuffers)
+{
+    BufferPool pool;
+
+    uint8_t *buffer = pool.allocate<uint8_t>(100);
+    ASSERT_NE(buffer, nullptr);
+    pool.deallocate(buffer);
+
+    EXPECT_EQ(pool.allocate<uint8_t>(200), buffer);
+    pool.deallocate(buffer);
+
+    BufferPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 0u);
+}
+
+/**
+ * Test that buffers bigger than the largest size class are allocated with malloc.
+ */
+TEST(BufferPoolTest, AllocatesLargeBuffersWithMalloc)
+{
+    BufferPool pool;
+
+    uint8_t *buffer = pool.allocate<uint8_t>(256 * 1024);
+    ASSERT_NE(buffer, nullptr);
+    memset(buffer, 0xa5, 256 * 1024);
+    pool.deallocate(buffer);
+
+    BufferPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+/**
+ * Test that buffers are allocated with malloc once all the buffers of the size class are in use.
+ */
+TEST(BufferPoolTest, AllocatesWithMallocWhenExhausted)
+{
+    constexpr size_t kNumOfPooledBuffers{4};
+    BufferPool pool(kNumOfPooledBuffers * 256 * BufferPool::kNumOfSizeClasses);
+
+    std::vector<uint8_t *> buffers;
+    for (size_t i = 0; i < kNumOfPooledBuffers + 1; i++)
+    {
+        buffers.push_back(pool.allocate<uint8_t>(256));
+        ASSERT_NE(buffers.back(), nullptr);
+    }
+    for (uint8_t *buffer : buffers)
+    {
+        pool.deallocate(buffer);
+    }
+
+    BufferPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.hits, kNumOfPooledBuffers);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+/**
+ * Test that the slab is sized by the capacity given to the pool.
+ */
+TEST(BufferPoolTest, SlabSizedByCapacity)
+{
+    constexpr size_t kCapacity{64 * 1024};
+    BufferPool pool(kCapacity);
+    EXPECT_GT(pool.capacity(), 0u);
+    EXPECT_LE(pool.capacity(), kCapacity);
+
+    // the share of each size class is 6.4KB, so 8KB buffers and bigger are not pooled
+    uint8_t *buffer = pool.allocate<uint8_t>(8 * 1024);
+    ASSERT_NE(buffer, nullptr);
+    pool.deallocate(buffer);
+
+    BufferPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+/**
+ * Test that a pool without capacity allocates all the buffers with malloc.
+ */
+TEST(BufferPoolTest, AllocatesWithMallocWithoutCapacity)
+{
+    BufferPool pool(0);
+    EXPECT_EQ(pool.capacity(), 0u);
+
+    uint8_t *buffer = pool.allocate<uint8_t>(100);
+    ASSERT_NE(buffer, nullptr);
+    pool.deallocate(buffer);
+
+    BufferPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+/**
+ * Test that a buffer is never handed out to two threads at the same time.
+ */
+TEST(BufferPoolTest, ConcurrentAllocations)
+{
+    constexpr int kNumOfThreads{4};
+    constexpr int kNumOfIterations{20000};
+    constexpr size_t kSizes[] = {64, 300, 1000, 5000, 20000};
+    BufferPool pool;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumOfThreads; i++)
+    {
+        threads.emplace_back(
+            [&pool, &kSizes, i]()
+            {
+                const uint8_t kPattern = static_cast<uint8_t>(i + 1);
+                for (int j = 0; j < kNumOfIterations; j++)
+                {
+                    const size_t kSize = kSizes[j % (sizeof(kSizes) / sizeof(kSizes[0]))];
+                    auto buffer = pool.allocateShared<uint8_t>(kSize);
+                    memset(buffer.get(), kPattern, kSize);
+                    std::this_thread::yield();
+                    for (size_t k = 0; k < kSize; k += 64)
+                    {
+                        ASSERT_EQ(buffer.get()[k], kPattern);
+                    }
+                }
+            });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // the threads have exited, so all their hits have been counted
+    BufferPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.hits + stats.misses, static_cast<uint64_t>(kNumOfThreads * kNumOfIterations));
+}
@@ -21,7 +21,11 @@
 #include "ServerStub.h"
 #include "TestClientMock.h"
 #include "TestModuleMock.h"
+#include <IIpcServerFactory.h>
+#include <future>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using namespace firebolt::rialto;
 using namespace firebolt::rialto::ipc;
@@ -141,6 +145,57 @@ TEST_F(RialtoIpcTest, MultiVarResponse)
     EXPECT_EQ(m_str, retStr);
 }
 
+/**
+ * Test that IPC keeps working once the client and server have switched to framed messages,
+ * and calls to the same method refer to it by id.
+ */
+TEST_F(RialtoIpcTest, RequestsAfterFramingNegotiated)
+{
+    constexpr int kNumOfRequests{3};
+    for (int i = 0; i < kNumOfRequests; i++)
+    {
+        int32_t retInt = 0;
+
+        EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+            .WillOnce(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int + i)),
+                            WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))))
+            .RetiresOnSaturation();
+
+        EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+
+        EXPECT_EQ(m_int + i, retInt);
+    }
+    EXPECT_TRUE(m_clientStub->isFramingNegotiated());
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, _, _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::failureReturn)));
+
+    EXPECT_FALSE(m_clientStub->sendSingleVarRequest(m_int));
+}
+
+/**
+ * Test that IPC sends a batch of method calls together, and the server makes them in order.
+ */
+TEST_F(RialtoIpcTest, BatchedRequests)
+{
+    // a round trip makes sure both ends have agreed on the transport features
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+
+    const std::vector<int32_t> kVars{m_int + 1, m_int + 2, m_int + 3};
+    {
+        ::testing::InSequence seq;
+        for (int32_t var : kVars)
+        {
+            EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(var), _, _))
+                .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+        }
+    }
+
+    EXPECT_TRUE(m_clientStub->sendBatchedSingleVarRequests(kVars));
+}
+
 /**
  * Test that IPC client returns failure if server fails.
  */
@@ -183,3 +238,357 @@ TEST_F(RialtoIpcTest, MultiVarEvent)
 
     m_clientStub->waitForMultiVarEvent(retInt, retUint, retEnum, retStr);
 }
+
+/**
+ * Test that IPC client receives all events of the same type, once the server refers to the
+ * event type by id.
+ */
+TEST_F(RialtoIpcTest, RepeatedEventsAfterIdsNegotiated)
+{
+    // a round trip makes sure both ends have agreed on the transport features
+    int32_t retInt = 0;
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+    EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+
+    constexpr int kNumOfEvents{3};
+    for (int i = 0; i < kNumOfEvents; i++)
+    {
+        m_serverStub->sendSingleVarEvent(m_int + i);
+    }
+
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(kNumOfEvents, retInts);
+
+    EXPECT_EQ(retInts, std::vector<int32_t>({m_int, m_int + 1, m_int + 2}));
+}
+
+/**
+ * Test that events sent while the client isn't reading its socket are queued and all delivered in order.
+ */
+TEST_F(RialtoIpcTest, EventsQueuedForSlowClient)
+{
+    constexpr int kNumOfEvents{1000};
+    std::vector<int32_t> expectedInts;
+    for (int i = 0; i < kNumOfEvents; i++)
+    {
+        m_serverStub->sendSingleVarEvent(m_int + i);
+        expectedInts.push_back(m_int + i);
+    }
+
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(kNumOfEvents, retInts);
+
+    EXPECT_EQ(retInts, expectedInts);
+}
+
+/**
+ * Test that queued events with the coalesce policy are replaced by newer ones while the client isn't reading
+ * its socket.
+ */
+TEST_F(RialtoIpcTest, StaleEventsCoalescedForSlowClient)
+{
+    m_serverStub->setEventPolicy(firebolt::rialto::TestEventSingleVar::descriptor()->full_name(),
+                                 IServer::EventPolicy::COALESCE);
+
+    constexpr int kNumOfEvents{1000};
+    for (int i = 0; i < kNumOfEvents; i++)
+    {
+        m_serverStub->sendSingleVarEvent(m_int + i);
+    }
+
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(kNumOfEvents, retInts);
+
+    ASSERT_FALSE(retInts.empty());
+    EXPECT_LT(retInts.size(), static_cast<size_t>(kNumOfEvents));
+    EXPECT_EQ(retInts.back(), m_int + kNumOfEvents - 1);
+}
+
+/**
+ * Test that an event sent during a method call is received before the reply.
+ */
+TEST_F(RialtoIpcTest, EventSentDuringMethodCallReceivedBeforeReply)
+{
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .WillOnce(DoAll(Invoke([this](auto...) { m_serverStub->sendSingleVarEvent(m_int + 1); }),
+                        SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    int32_t retInt = 0;
+    EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+    EXPECT_EQ(retInt, m_int);
+
+    // no further processing, the event must have been handled already
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(0, retInts);
+
+    EXPECT_EQ(retInts, std::vector<int32_t>({m_int + 1}));
+}
+
+class RialtoIpcDispatchTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<StrictMock<TestModuleMock>> m_testModuleMock;
+    std::shared_ptr<StrictMock<TestClientMock>> m_testClientMock;
+    std::shared_ptr<ServerStub> m_serverStub;
+    std::shared_ptr<ClientStub> m_slowClientStub;
+    std::shared_ptr<ClientStub> m_fastClientStub;
+    std::string m_socketName = "/tmp/rialto-0";
+
+    virtual void SetUp()
+    {
+        m_testModuleMock = std::make_shared<StrictMock<TestModuleMock>>();
+        m_testClientMock = std::make_shared<StrictMock<TestClientMock>>();
+
+        m_serverStub = std::make_shared<ServerStub>(m_testModuleMock, IServerFactory::DISPATCH_ON_WORKER_THREADS);
+
+        m_slowClientStub = std::make_shared<ClientStub>(m_testClientMock, m_socketName);
+        m_slowClientStub->connect();
+        m_fastClientStub = std::make_shared<ClientStub>(m_testClientMock, m_socketName);
+        m_fastClientStub->connect();
+    }
+
+    virtual void TearDown()
+    {
+        m_fastClientStub->disconnect();
+        m_fastClientStub.reset();
+        m_slowClientStub->disconnect();
+        m_slowClientStub.reset();
+
+        m_serverStub.reset();
+
+        m_testClientMock.reset();
+        m_testModuleMock.reset();
+    }
+};
+
+/**
+ * Test that IPC can send requests and receive responses when the server dispatches them on worker threads.
+ */
+TEST_F(RialtoIpcDispatchTest, SingleVarResponse)
+{
+    int32_t retInt = 0;
+
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(123)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    EXPECT_TRUE(m_slowClientStub->sendRequestWithSingleVarResponse(retInt));
+
+    EXPECT_EQ(123, retInt);
+}
+
+/**
+ * Test that a method call that blocks on the server doesn't hold up the calls of other clients.
+ */
+TEST_F(RialtoIpcDispatchTest, BlockedCallDoesNotHoldUpOtherClients)
+{
+    std::promise<void> slowCallStarted;
+    std::promise<void> slowCallReleased;
+    std::shared_future<void> slowCallReleasedFuture = slowCallReleased.get_future().share();
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(1), _, _))
+        .WillOnce(WithArgs<3>(Invoke(
+            [&](::google::protobuf::Closure *done)
+            {
+                slowCallStarted.set_value();
+                slowCallReleasedFuture.wait();
+                done->Run();
+            })));
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(2), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+
+    std::thread slowClientThread([this]() { EXPECT_TRUE(m_slowClientStub->sendSingleVarRequest(1)); });
+    slowCallStarted.get_future().wait();
+
+    // the first call is still blocked in the service, but the call of the other client is handled
+    EXPECT_TRUE(m_fastClientStub->sendSingleVarRequest(2));
+
+    slowCallReleased.set_value();
+    slowClientThread.join();
+}
+
+/**
+ * Test that calls too big for the pooled receive buffers are handed over to the worker threads intact.
+ */
+TEST_F(RialtoIpcDispatchTest, LargeRequests)
+{
+    const std::string kLargeStr(64 * 1024, 'x');
+
+    // a round trip makes sure both ends have agreed on the transport features, so the calls are sent as frames
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(0), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_slowClientStub->sendSingleVarRequest(0));
+    EXPECT_TRUE(m_slowClientStub->isFramingNegotiated());
+
+    const firebolt::rialto::TestMultiVar_TestType kEnum = firebolt::rialto::TestMultiVar_TestType_ENUM1;
+    EXPECT_CALL(*m_testModuleMock, TestRequestMultiVar(_, MultiVarRequestMatcher(1, 2U, kEnum, kLargeStr), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_slowClientStub->sendMultiVarRequest(1, 2U, kEnum, kLargeStr));
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(3), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_slowClientStub->sendSingleVarRequest(3));
+}
+
+/**
+ * Test that the method calls of a client are made in order, while the calls of two clients are spread over the
+ * worker threads.
+ */
+TEST_F(RialtoIpcDispatchTest, CallsOfClientMadeInOrder)
+{
+    constexpr int32_t kNumOfCalls{200};
+    constexpr int32_t kSlowClientBase{1000};
+    constexpr int32_t kFastClientBase{2000};
+
+    // a round trip makes sure both ends have agreed on the transport features, so the calls are sent as frames
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(0), _, _))
+        .Times(2)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_slowClientStub->sendSingleVarRequest(0));
+    EXPECT_TRUE(m_fastClientStub->sendSingleVarRequest(0));
+
+    std::vector<int32_t> slowClientVars;
+    std::vector<int32_t> fastClientVars;
+    ::testing::Sequence slowClientSeq;
+    ::testing::Sequence fastClientSeq;
+    for (int32_t i = 0; i < kNumOfCalls; i++)
+    {
+        slowClientVars.push_back(kSlowClientBase + i);
+        fastClientVars.push_back(kFastClientBase + i);
+
+        // the calls of the slow client yield, giving the other worker threads a chance to overtake them
+        EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(kSlowClientBase + i), _, _))
+            .InSequence(slowClientSeq)
+            .WillOnce(DoAll(Invoke([](auto...) { std::this_thread::yield(); }),
+                            WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+        EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(kFastClientBase + i), _, _))
+            .InSequence(fastClientSeq)
+            .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    }
+
+    std::thread slowClientThread([&]()
+                                 { EXPECT_TRUE(m_slowClientStub->sendPipelinedSingleVarRequests(slowClientVars)); });
+    EXPECT_TRUE(m_fastClientStub->sendPipelinedSingleVarRequests(fastClientVars));
+    slowClientThread.join();
+}
+
+class RialtoIpcShmRingTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<StrictMock<TestModuleMock>> m_testModuleMock;
+    std::shared_ptr<StrictMock<TestClientMock>> m_testClientMock;
+    std::shared_ptr<ServerStub> m_serverStub;
+    std::shared_ptr<ClientStub> m_clientStub;
+    std::string m_socketName = "/tmp/rialto-0";
+
+    int32_t m_int = 432;
+    uint32_t m_uint = 678U;
+    firebolt::rialto::TestMultiVar_TestType m_enum = firebolt::rialto::TestMultiVar_TestType_ENUM1;
+
+    virtual void SetUp()
+    {
+        m_testModuleMock = std::make_shared<StrictMock<TestModuleMock>>();
+        m_testClientMock = std::make_shared<StrictMock<TestClientMock>>();
+
+        m_serverStub = std::make_shared<ServerStub>(m_testModuleMock, IServerFactory::SHM_RING_TRANSPORT);
+
+        m_clientStub = std::make_shared<ClientStub>(m_testClientMock, m_socketName);
+        m_clientStub->connect();
+
+        // a few round trips let both ends switch to the rings
+        for (int i = 0; i < 3; i++)
+        {
+            int32_t retInt = 0;
+            EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+                .WillOnce(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int + i)),
+                                WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))))
+                .RetiresOnSaturation();
+            EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+            EXPECT_EQ(m_int + i, retInt);
+        }
+    }
+
+    virtual void TearDown()
+    {
+        m_clientStub->disconnect();
+        m_clientStub.reset();
+
+        m_serverStub.reset();
+
+        m_testClientMock.reset();
+        m_testModuleMock.reset();
+    }
+};
+
+/**
+ * Test that IPC can send requests and receive responses and events once moved onto the shared memory rings.
+ */
+TEST_F(RialtoIpcShmRingTest, RequestsAndEvents)
+{
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .WillOnce(DoAll(Invoke([this](auto...) { m_serverStub->sendSingleVarEvent(m_int + 1); }),
+                        SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    int32_t retInt = 0;
+    EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+    EXPECT_EQ(retInt, m_int);
+
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(0, retInts);
+    EXPECT_EQ(retInts, std::vector<int32_t>({m_int + 1}));
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, _, _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::failureReturn)));
+    EXPECT_FALSE(m_clientStub->sendSingleVarRequest(m_int));
+}
+
+/**
+ * Test that messages too big for the rings are sent on the socket, in order with the messages on the rings.
+ */
+TEST_F(RialtoIpcShmRingTest, LargeMessagesSentOnSocket)
+{
+    const std::string kLargeStr(64 * 1024, 'x');
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestMultiVar(_, MultiVarRequestMatcher(m_int, m_uint, m_enum, kLargeStr), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_clientStub->sendMultiVarRequest(m_int, m_uint, m_enum, kLargeStr));
+
+    int32_t retInt = 0;
+    uint32_t retUint = 0;
+    firebolt::rialto::TestMultiVar_TestType retEnum = firebolt::rialto::TestMultiVar_TestType_ENUM2;
+    std::string retStr;
+    EXPECT_CALL(*m_testModuleMock, TestResponseMultiVar(_, _, _, _))
+        .WillOnce(DoAll(Invoke([this](auto...) { m_serverStub->sendSingleVarEvent(m_int + 1); }),
+                        SetArgPointee<2>(m_testModuleMock->getMultiVarResponse(m_int, m_uint, m_enum, kLargeStr)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+    EXPECT_TRUE(m_clientStub->sendRequestWithMultiVarResponse(retInt, retUint, retEnum, retStr));
+    EXPECT_EQ(retStr, kLargeStr);
+
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(0, retInts);
+    EXPECT_EQ(retInts, std::vector<int32_t>({m_int + 1}));
+}
+
+/**
+ * Test that events sent while the client isn't reading the response ring are queued once the ring is full, and
+ * all delivered in order.
+ */
+TEST_F(RialtoIpcShmRingTest, EventsQueuedForSlowClient)
+{
+    constexpr int kNumOfEvents{3000};
+    std::vector<int32_t> expectedInts;
+    for (int i = 0; i < kNumOfEvents; i++)
+    {
+        m_serverStub->sendSingleVarEvent(m_int + i);
+        expectedInts.push_back(m_int + i);
+    }
+
+    std::vector<int32_t> retInts;
+    m_clientStub->processSingleVarEvents(kNumOfEvents, retInts);
+
+    EXPECT_EQ(retInts, expectedInts);
+}
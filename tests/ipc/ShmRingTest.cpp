@@ -0,0 +1,221 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmRing.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+
+using firebolt::rialto::ipc::FileDescriptor;
+using firebolt::rialto::ipc::ShmRing;
+using firebolt::rialto::ipc::ShmRingTransport;
+
+namespace
+{
+constexpr uint32_t kCapacity = 4096;
+
+bool writeString(ShmRing &ring, ShmRing::RecordType type, const std::string &str)
+{
+    struct iovec iov = {const_cast<char *>(str.data()), str.size()};
+    return ring.write(type, &iov, 1);
+}
+
+std::string readString(ShmRing &ring, ShmRing::RecordType *type)
+{
+    ShmRing::Record record;
+    if (ring.read(&record) != ShmRing::ReadStatus::RECORD)
+        return "<none>";
+
+    *type = record.type;
+    std::string str(reinterpret_cast<const char *>(record.data), record.length);
+    ring.release();
+    return str;
+}
+
+bool isReadable(int fd)
+{
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return (poll(&pfd, 1, 0) == 1) && (pfd.revents & POLLIN);
+}
+} // namespace
+
+class ShmRingTest : public ::testing::Test
+{
+protected:
+    std::vector<uint64_t> m_memory = std::vector<uint64_t>(ShmRing::memorySize(kCapacity) / sizeof(uint64_t) + 1);
+    ShmRing m_producer{m_memory.data(), kCapacity, true};
+    ShmRing m_consumer{m_memory.data(), kCapacity, false};
+};
+
+/**
+ * Test that records of different sizes are read back in order, including records written after the ring has
+ * wrapped around.
+ */
+TEST_F(ShmRingTest, ReadsRecordsInOrderAcrossWrap)
+{
+    for (int i = 0; i < 200; i++)
+    {
+        const std::string kStr(static_cast<size_t>((i * 37) % 900), static_cast<char>('a' + (i % 26)));
+        ASSERT_TRUE(writeString(m_producer, ShmRing::RecordType::MESSAGE, kStr));
+        ASSERT_TRUE(writeString(m_producer, ShmRing::RecordType::BARRIER, ""));
+
+        ShmRing::RecordType type;
+        EXPECT_EQ(readString(m_consumer, &type), kStr);
+        EXPECT_EQ(type, ShmRing::RecordType::MESSAGE);
+        EXPECT_EQ(readString(m_consumer, &type), "");
+        EXPECT_EQ(type, ShmRing::RecordType::BARRIER);
+    }
+
+    ShmRing::Record record;
+    EXPECT_EQ(m_consumer.read(&record), ShmRing::ReadStatus::EMPTY);
+}
+
+/**
+ * Test that a full ring rejects records, and that the consumer is told to wake the producer once it has made room.
+ */
+TEST_F(ShmRingTest, FullRingWakesProducerOnceRoomIsMade)
+{
+    const std::string kStr(m_producer.maxRecordLength(), 'x');
+    int numOfRecords = 0;
+    while (writeString(m_producer, ShmRing::RecordType::MESSAGE, kStr))
+        numOfRecords++;
+
+    EXPECT_GT(numOfRecords, 0);
+
+    ShmRing::RecordType type;
+    EXPECT_EQ(readString(m_consumer, &type), kStr);
+    EXPECT_TRUE(m_consumer.wakeProducer());
+    EXPECT_FALSE(m_consumer.wakeProducer());
+
+    EXPECT_TRUE(writeString(m_producer, ShmRing::RecordType::MESSAGE, kStr));
+}
+
+/**
+ * Test that records that are longer than the ring allows are rejected.
+ */
+TEST_F(ShmRingTest, RejectsOversizedRecords)
+{
+    const std::string kStr(m_producer.maxRecordLength() + 1, 'x');
+    EXPECT_FALSE(writeString(m_producer, ShmRing::RecordType::MESSAGE, kStr));
+}
+
+/**
+ * Test that a record header overwritten with an invalid length is reported as corrupt.
+ */
+TEST_F(ShmRingTest, DetectsCorruptRecord)
+{
+    ASSERT_TRUE(writeString(m_producer, ShmRing::RecordType::MESSAGE, "hello"));
+
+    // the first record header follows the control block
+    uint8_t *header = reinterpret_cast<uint8_t *>(m_memory.data()) + ShmRing::memorySize(kCapacity) - kCapacity;
+    const uint32_t kLength = kCapacity;
+    memcpy(header, &kLength, sizeof(kLength));
+
+    ShmRing::Record record;
+    EXPECT_EQ(m_consumer.read(&record), ShmRing::ReadStatus::CORRUPT);
+}
+
+/**
+ * Test that the consumer is only woken when it has armed its doorbell.
+ */
+TEST_F(ShmRingTest, WakesConsumerOnlyWhenSleeping)
+{
+    // the consumer of a new ring starts off sleeping
+    ASSERT_TRUE(writeString(m_producer, ShmRing::RecordType::MESSAGE, "first"));
+    EXPECT_TRUE(m_producer.wakeConsumer());
+
+    ASSERT_TRUE(writeString(m_producer, ShmRing::RecordType::MESSAGE, "second"));
+    EXPECT_FALSE(m_producer.wakeConsumer());
+
+    ShmRing::RecordType type;
+    EXPECT_EQ(readString(m_consumer, &type), "first");
+    EXPECT_FALSE(m_consumer.prepareToSleep());
+    EXPECT_EQ(readString(m_consumer, &type), "second");
+    EXPECT_TRUE(m_consumer.prepareToSleep());
+
+    ASSERT_TRUE(writeString(m_producer, ShmRing::RecordType::MESSAGE, "third"));
+    EXPECT_TRUE(m_producer.wakeConsumer());
+}
+
+/**
+ * Test that the server side attaches to the transport created by the client, and the messages and doorbells
+ * work in both directions.
+ */
+TEST(ShmRingTransportTest, AttachesAndPassesMessages)
+{
+    std::unique_ptr<ShmRingTransport> client = ShmRingTransport::create();
+    ASSERT_NE(client, nullptr);
+
+    std::unique_ptr<ShmRingTransport> server =
+        ShmRingTransport::attach(FileDescriptor(client->memoryFd()), FileDescriptor(client->serverDoorbellFd()),
+                                 FileDescriptor(client->clientDoorbellFd()), client->ringCapacity());
+    ASSERT_NE(server, nullptr);
+
+    std::string request = "request";
+    struct iovec requestIov = {request.data(), request.size()};
+    struct msghdr requestMsg = {};
+    requestMsg.msg_iov = &requestIov;
+    requestMsg.msg_iovlen = 1;
+    ASSERT_TRUE(client->send(ShmRing::RecordType::MESSAGE, &requestMsg));
+    client->flush();
+    EXPECT_TRUE(isReadable(server->doorbellFd()));
+    server->clearDoorbell();
+
+    ShmRing::Record record;
+    ASSERT_EQ(server->receive(&record), ShmRing::ReadStatus::RECORD);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(record.data), record.length), request);
+    server->release();
+    EXPECT_EQ(server->receive(&record), ShmRing::ReadStatus::EMPTY);
+
+    std::string response = "response";
+    struct iovec responseIov = {response.data(), response.size()};
+    struct msghdr responseMsg = {};
+    responseMsg.msg_iov = &responseIov;
+    responseMsg.msg_iovlen = 1;
+    ASSERT_TRUE(server->send(ShmRing::RecordType::MESSAGE, &responseMsg));
+    server->flush();
+    EXPECT_TRUE(isReadable(client->doorbellFd()));
+
+    ASSERT_EQ(client->receive(&record), ShmRing::ReadStatus::RECORD);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(record.data), record.length), response);
+    client->release();
+}
+
+/**
+ * Test that the server refuses memory that the client could still shrink.
+ */
+TEST(ShmRingTransportTest, RefusesUnsealedMemory)
+{
+    std::unique_ptr<ShmRingTransport> client = ShmRingTransport::create();
+    ASSERT_NE(client, nullptr);
+
+    FILE *file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(ftruncate(fileno(file), 2 * ShmRing::memorySize(client->ringCapacity())), 0);
+
+    EXPECT_EQ(ShmRingTransport::attach(FileDescriptor(fileno(file)), FileDescriptor(client->serverDoorbellFd()),
+                                       FileDescriptor(client->clientDoorbellFd()), client->ringCapacity()),
+              nullptr);
+
+    fclose(file);
+}
@@ -39,6 +39,8 @@ public:
     MOCK_METHOD(bool, wait, (int timeoutMSecs), (override));
     MOCK_METHOD(bool, process, (), (override));
     MOCK_METHOD(bool, unsubscribe, (int eventTag), (override));
+    MOCK_METHOD(void, beginBatch, (), (override));
+    MOCK_METHOD(bool, flushBatch, (), (override));
     MOCK_METHOD(int, subscribeImpl,
                 (const std::string &eventName, const google::protobuf::Descriptor *descriptor,
                  std::function<void(const std::shared_ptr<google::protobuf::Message> &msg)> &&handler),
@@ -42,6 +42,8 @@ public:
     MOCK_METHOD(int, fd, (), (override, const));
     MOCK_METHOD(bool, wait, (int timeoutMSecs), (override));
     MOCK_METHOD(bool, process, (), (override));
+    MOCK_METHOD(void, setEventPolicy, (const std::string &eventType, EventPolicy policy, const std::string &keyField),
+                (override));
 };
 } // namespace firebolt::rialto::ipc
 
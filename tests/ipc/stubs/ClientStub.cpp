@@ -18,6 +18,7 @@
  */
 
 #include "ClientStub.h"
+#include "IpcChannelImpl.h"
 #include "TestClientMock.h"
 #include <IIpcChannel.h>
 #include <IIpcControllerFactory.h>
@@ -144,6 +145,85 @@ bool ClientStub::sendMultiVarRequest(int32_t var1, uint32_t var2, firebolt::rial
     return true;
 }
 
+bool ClientStub::sendBatchedSingleVarRequests(const std::vector<int32_t> &vars)
+{
+    std::vector<firebolt::rialto::TestSingleVar> requests(vars.size());
+    std::vector<firebolt::rialto::TestNoVar> responses(vars.size());
+    std::vector<std::shared_ptr<google::protobuf::RpcController>> controllers;
+    std::unique_ptr<bool[]> done(new bool[vars.size()]());
+
+    auto controllerFactory = firebolt::rialto::ipc::IControllerFactory::createFactory();
+
+    m_channel->beginBatch();
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        requests[i].set_var1(vars[i]);
+        controllers.push_back(controllerFactory->create());
+        m_testModuleStub->TestRequestSingleVar(controllers[i].get(), &requests[i], &responses[i],
+                                               google::protobuf::NewCallback(onMessageReceived, &done[i]));
+    }
+
+    // nothing is sent until the batch is flushed
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        EXPECT_FALSE(done[i]);
+    }
+
+    if (!m_channel->flushBatch())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        while (m_channel->process() && !done[i])
+        {
+            m_channel->wait(-1);
+        }
+
+        if (controllers[i]->Failed())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ClientStub::sendPipelinedSingleVarRequests(const std::vector<int32_t> &vars)
+{
+    std::vector<firebolt::rialto::TestSingleVar> requests(vars.size());
+    std::vector<firebolt::rialto::TestNoVar> responses(vars.size());
+    std::vector<std::shared_ptr<google::protobuf::RpcController>> controllers;
+    std::unique_ptr<bool[]> done(new bool[vars.size()]());
+
+    auto controllerFactory = firebolt::rialto::ipc::IControllerFactory::createFactory();
+
+    // every call is sent on its own, without waiting for the replies of the previous ones
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        requests[i].set_var1(vars[i]);
+        controllers.push_back(controllerFactory->create());
+        m_testModuleStub->TestRequestSingleVar(controllers[i].get(), &requests[i], &responses[i],
+                                               google::protobuf::NewCallback(onMessageReceived, &done[i]));
+    }
+
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        while (m_channel->process() && !done[i])
+        {
+            m_channel->wait(-1);
+        }
+
+        if (controllers[i]->Failed())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool ClientStub::sendRequestWithSingleVarResponse(int32_t &var1)
 {
     firebolt::rialto::TestNoVar request;
@@ -202,6 +282,12 @@ bool ClientStub::sendRequestWithMultiVarResponse(int32_t &var1, uint32_t &var2,
     return true;
 }
 
+bool ClientStub::isFramingNegotiated() const
+{
+    auto channel = std::dynamic_pointer_cast<firebolt::rialto::ipc::ChannelImpl>(m_channel);
+    return channel && channel->isFramingNegotiated();
+}
+
 void ClientStub::startMessageThread()
 {
     m_eventThread = std::thread{[this]()
@@ -250,9 +336,22 @@ void ClientStub::waitForMultiVarEvent(int32_t &var1, uint32_t &var2, firebolt::r
     var4 = m_multiVarEvent->var4();
 }
 
+void ClientStub::processSingleVarEvents(size_t numOfEvents, std::vector<int32_t> &vars)
+{
+    const auto kDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while ((m_singleVarEventVars.size() < numOfEvents) && (std::chrono::steady_clock::now() < kDeadline))
+    {
+        m_channel->wait(10);
+        m_channel->process();
+    }
+
+    vars = m_singleVarEventVars;
+}
+
 void ClientStub::onTestEventSingleVarReceived(const std::shared_ptr<firebolt::rialto::TestEventSingleVar> &event)
 {
     m_singleVarEvent = event;
+    m_singleVarEventVars.push_back(event->var1());
     m_messageReceived.store(true);
 }
 
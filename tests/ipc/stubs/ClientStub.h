@@ -41,14 +41,18 @@ public:
 
     bool sendSingleVarRequest(int32_t var1);
     bool sendMultiVarRequest(int32_t var1, uint32_t var2, firebolt::rialto::TestMultiVar_TestType var3, std::string var4);
+    bool sendBatchedSingleVarRequests(const std::vector<int32_t> &vars);
+    bool sendPipelinedSingleVarRequests(const std::vector<int32_t> &vars);
     bool sendRequestWithSingleVarResponse(int32_t &var1);
     bool sendRequestWithMultiVarResponse(int32_t &var1, uint32_t &var2, firebolt::rialto::TestMultiVar_TestType &var3,
                                          std::string &var4);
+    bool isFramingNegotiated() const;
 
     void startMessageThread();
     void waitForSingleVarEvent(int32_t &var1);
     void waitForMultiVarEvent(int32_t &var1, uint32_t &var2, firebolt::rialto::TestEventMultiVar_TestType &var3,
                               std::string &var4);
+    void processSingleVarEvents(size_t numOfEvents, std::vector<int32_t> &vars);
 
 private:
     void onTestEventSingleVarReceived(const std::shared_ptr<firebolt::rialto::TestEventSingleVar> &event);
@@ -66,6 +70,7 @@ private:
     std::mutex m_startThreadMutex;
     std::condition_variable m_startThreadCond;
     std::shared_ptr<firebolt::rialto::TestEventSingleVar> m_singleVarEvent;
+    std::vector<int32_t> m_singleVarEventVars;
     std::shared_ptr<firebolt::rialto::TestEventMultiVar> m_multiVarEvent;
     std::vector<int> m_eventTags;
 };
@@ -57,20 +57,21 @@ void ServerStub::clientConnected(const std::shared_ptr<::firebolt::rialto::ipc::
 
 ServerStub::ServerStub()
 {
-    init();
+    init(0);
 }
 
-ServerStub::ServerStub(std::shared_ptr<::firebolt::rialto::TestModule> moduleMock) : m_testMock{moduleMock}
+ServerStub::ServerStub(std::shared_ptr<::firebolt::rialto::TestModule> moduleMock, unsigned flags)
+    : m_testMock{moduleMock}
 {
-    init();
+    init(flags);
 }
 
-void ServerStub::init()
+void ServerStub::init(unsigned flags)
 {
     m_clientConnected = false;
     m_running = true;
     auto factory = ::firebolt::rialto::ipc::IServerFactory::createFactory();
-    m_server = factory->create(::firebolt::rialto::ipc::IServerFactory::ALLOW_MONITORING);
+    m_server = factory->create(::firebolt::rialto::ipc::IServerFactory::ALLOW_MONITORING | flags);
 
     const char *rialtoPath = getenv("RIALTO_SOCKET_PATH");
     m_server->addSocket(rialtoPath, std::bind(&ServerStub::clientConnected, this, std::placeholders::_1),
@@ -93,6 +94,14 @@ ServerStub::~ServerStub()
         m_running = false;
         m_serverThread.join();
     }
+
+    // the callbacks may be called from the server's worker threads until it is destroyed
+    m_server.reset();
+}
+
+void ServerStub::setEventPolicy(const std::string &eventType, ::firebolt::rialto::ipc::IServer::EventPolicy policy)
+{
+    m_server->setEventPolicy(eventType, policy);
 }
 
 void ServerStub::sendSingleVarEvent(int32_t var1)
@@ -34,7 +34,7 @@ class ServerStub
 {
 public:
     ServerStub();
-    explicit ServerStub(std::shared_ptr<::firebolt::rialto::TestModule> moduleMock);
+    explicit ServerStub(std::shared_ptr<::firebolt::rialto::TestModule> moduleMock, unsigned flags = 0);
     ~ServerStub();
 
     void clientDisconnected(const std::shared_ptr<::firebolt::rialto::ipc::IClient> &client);
@@ -43,6 +43,7 @@ public:
     void sendSingleVarEvent(int32_t var1);
     void sendMultiVarEvent(int32_t var1, uint32_t var2, firebolt::rialto::TestEventMultiVar_TestType var3,
                            std::string var4);
+    void setEventPolicy(const std::string &eventType, ::firebolt::rialto::ipc::IServer::EventPolicy policy);
 
 private:
     std::shared_ptr<::firebolt::rialto::ipc::IServer> m_server;
@@ -54,7 +55,7 @@ private:
     std::mutex m_clientConnectMutex;
     std::condition_variable m_clientConnectCond;
 
-    void init();
+    void init(unsigned flags);
 };
 
 #endif // SERVER_STUB_H_
@@ -0,0 +1,192 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncLogWriter.h"
+#include <condition_variable>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace firebolt::rialto::logging;
+
+class AsyncLogWriterTest : public ::testing::Test
+{
+protected:
+    void sink(const LogRecord *records, std::size_t numOfRecords)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_sinkCalled = true;
+        m_cv.notify_all();
+        m_cv.wait(lock, [this]() { return !m_isSinkBlocked; });
+        for (std::size_t i = 0; i < numOfRecords; ++i)
+        {
+            m_records.push_back(records[i]);
+        }
+    }
+
+    LogRecord createRecord(const std::string &message, pid_t threadId = 1)
+    {
+        LogRecord record{};
+        record.level = RIALTO_DEBUG_LEVEL_INFO;
+        record.threadId = threadId;
+        record.messageLen = message.size();
+        strncpy(record.message, message.c_str(), sizeof(record.message) - 1);
+        return record;
+    }
+
+    void createWriter(std::size_t capacity)
+    {
+        m_sut = std::make_unique<AsyncLogWriter>([this](const LogRecord *records, std::size_t numOfRecords)
+                                                 { sink(records, numOfRecords); },
+                                                 capacity);
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_isSinkBlocked{false};
+    bool m_sinkCalled{false};
+    std::vector<LogRecord> m_records;
+    std::unique_ptr<AsyncLogWriter> m_sut;
+};
+
+/**
+ * Test that the pushed records are written in order, after flush.
+ */
+TEST_F(AsyncLogWriterTest, RecordsAreWrittenInOrder)
+{
+    constexpr int kNumOfRecords{200};
+    createWriter(256);
+    for (int i = 0; i < kNumOfRecords; ++i)
+    {
+        EXPECT_TRUE(m_sut->push(createRecord(std::to_string(i))));
+    }
+    m_sut->flush();
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ASSERT_EQ(m_records.size(), kNumOfRecords);
+    for (int i = 0; i < kNumOfRecords; ++i)
+    {
+        EXPECT_EQ(std::string(m_records[i].message), std::to_string(i));
+        EXPECT_EQ(m_records[i].messageLen, std::to_string(i).size());
+    }
+}
+
+/**
+ * Test that the records pushed from multiple threads are all written, in order per thread.
+ */
+TEST_F(AsyncLogWriterTest, MultipleProducers)
+{
+    constexpr int kNumOfThreads{4};
+    constexpr int kNumOfRecords{1000};
+    createWriter(kNumOfThreads * kNumOfRecords);
+
+    std::vector<std::thread> producers;
+    for (int thread = 0; thread < kNumOfThreads; ++thread)
+    {
+        producers.emplace_back(
+            [this, thread]()
+            {
+                for (int i = 0; i < kNumOfRecords; ++i)
+                {
+                    m_sut->push(createRecord(std::to_string(i), thread));
+                }
+            });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    m_sut->flush();
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ASSERT_EQ(m_records.size(), kNumOfThreads * kNumOfRecords);
+    std::vector<int> nextRecord(kNumOfThreads, 0);
+    for (const auto &record : m_records)
+    {
+        EXPECT_EQ(std::string(record.message), std::to_string(nextRecord[record.threadId]++));
+    }
+    EXPECT_EQ(m_sut->getNumOfDroppedRecords(), 0U);
+}
+
+/**
+ * Test that records are dropped without blocking when the ring is full, and the drop is reported.
+ */
+TEST_F(AsyncLogWriterTest, OverflowIsReported)
+{
+    constexpr int kCapacity{4};
+    constexpr int kNumOfDroppedRecords{3};
+    createWriter(kCapacity);
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isSinkBlocked = true;
+    }
+
+    // The first record is taken by the writer thread, which then blocks in the sink
+    EXPECT_TRUE(m_sut->push(createRecord("first")));
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_cv.wait(lock, [this]() { return m_sinkCalled; });
+    }
+    for (int i = 0; i < kCapacity + kNumOfDroppedRecords; ++i)
+    {
+        EXPECT_TRUE(m_sut->push(createRecord("queued")));
+    }
+    EXPECT_EQ(m_sut->getNumOfDroppedRecords(), kNumOfDroppedRecords);
+
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isSinkBlocked = false;
+        m_cv.notify_all();
+    }
+    m_sut->flush();
+    m_sut->stop();
+
+    ASSERT_EQ(m_records.size(), 1 + kCapacity + 1);
+    int numOfWarnings{0};
+    for (const auto &record : m_records)
+    {
+        if (RIALTO_DEBUG_LEVEL_WARNING == record.level)
+        {
+            EXPECT_EQ(std::string(record.message), "Log ring overflow, 3 log records dropped");
+            ++numOfWarnings;
+        }
+    }
+    EXPECT_EQ(numOfWarnings, 1);
+}
+
+/**
+ * Test that stop writes out the queued records, and later records are rejected.
+ */
+TEST_F(AsyncLogWriterTest, StopWritesQueuedRecords)
+{
+    constexpr int kNumOfRecords{50};
+    createWriter(64);
+    for (int i = 0; i < kNumOfRecords; ++i)
+    {
+        EXPECT_TRUE(m_sut->push(createRecord(std::to_string(i))));
+    }
+    m_sut->stop();
+    EXPECT_EQ(m_records.size(), kNumOfRecords);
+
+    EXPECT_FALSE(m_sut->push(createRecord("rejected")));
+    EXPECT_EQ(m_records.size(), kNumOfRecords);
+}
@@ -161,3 +161,18 @@ TEST_F(EnvVariableParserTest, LogToConsoleDisabled)
     EnvVariableParser parser;
     EXPECT_FALSE(parser.isConsoleLoggingEnabled());
 }
+
+TEST_F(EnvVariableParserTest, AsyncLogDisabledWhenNoVarSet)
+{
+    unsetenv("RIALTO_ASYNC_LOG");
+    EnvVariableParser parser;
+    EXPECT_FALSE(parser.isAsyncLoggingEnabled());
+}
+
+TEST_F(EnvVariableParserTest, SetAsyncLog)
+{
+    setenv("RIALTO_ASYNC_LOG", "1", 1);
+    EnvVariableParser parser;
+    EXPECT_TRUE(parser.isAsyncLoggingEnabled());
+    unsetenv("RIALTO_ASYNC_LOG");
+}
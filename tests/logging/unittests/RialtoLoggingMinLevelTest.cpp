@@ -0,0 +1,57 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define RIALTO_LOG_MIN_LEVEL RIALTO_DEBUG_LEVEL_MILESTONE
+#include "RialtoLogging.h"
+#include <gtest/gtest.h>
+
+using namespace firebolt::rialto::logging;
+
+namespace
+{
+uint32_t g_minLevelHandlerCalledCount = 0U;
+
+void minLevelTestLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
+                            const char *message, size_t messageLen)
+{
+    g_minLevelHandlerCalledCount++;
+}
+} // namespace
+
+/**
+ * Test that the logs less severe than RIALTO_LOG_MIN_LEVEL are removed, even if enabled at runtime.
+ */
+TEST(RialtoLoggingMinLevelTest, LessSevereLevelsAreCompiledOut)
+{
+    g_minLevelHandlerCalledCount = 0U;
+    setLogHandler(RIALTO_COMPONENT_DEFAULT, minLevelTestLogHandler);
+    setLogLevels(RIALTO_COMPONENT_DEFAULT, static_cast<RIALTO_DEBUG_LEVEL>(RIALTO_DEBUG_LEVEL_DEFAULT |
+                                                                           RIALTO_DEBUG_LEVEL_INFO |
+                                                                           RIALTO_DEBUG_LEVEL_DEBUG));
+
+    RIALTO_LOG_DEBUG(RIALTO_COMPONENT_DEFAULT, "RIALTO_LOG_DEBUG");
+    RIALTO_LOG_INFO(RIALTO_COMPONENT_DEFAULT, "RIALTO_LOG_INFO");
+    EXPECT_EQ(g_minLevelHandlerCalledCount, 0U);
+
+    RIALTO_LOG_MIL(RIALTO_COMPONENT_DEFAULT, "RIALTO_LOG_MIL");
+    RIALTO_LOG_ERROR(RIALTO_COMPONENT_DEFAULT, "RIALTO_LOG_ERROR");
+    EXPECT_EQ(g_minLevelHandlerCalledCount, 2U);
+
+    setLogLevels(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL_DEFAULT);
+}
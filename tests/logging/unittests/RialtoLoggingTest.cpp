@@ -233,3 +233,28 @@ TEST_F(RialtoLoggingTest, GetLogLevelDebug)
 
     ASSERT_EQ(getLogLevels(RIALTO_COMPONENT_DEFAULT), logLevel);
 }
+
+/**
+ * Test that the log arguments are not evaluated, when the log level is disabled.
+ */
+TEST_F(RialtoLoggingTest, ArgumentsNotEvaluatedForDisabledLevel)
+{
+    uint32_t evaluatedCount = 0U;
+    auto argument = [&evaluatedCount]()
+    {
+        evaluatedCount++;
+        return "argument";
+    };
+
+    setLogHandler(RIALTO_COMPONENT_DEFAULT, RialtoLoggingTest::TestLogHandler);
+    setLogLevels(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL_ERROR);
+
+    RIALTO_LOG_DEBUG(RIALTO_COMPONENT_DEFAULT, "%s", argument());
+    RIALTO_LOG_SYS_WARN(RIALTO_COMPONENT_DEFAULT, 1, "%s", argument());
+    EXPECT_EQ(evaluatedCount, 0U);
+    EXPECT_EQ(g_handlerCalledCount, 0U);
+
+    RIALTO_LOG_ERROR(RIALTO_COMPONENT_DEFAULT, "%s", argument());
+    EXPECT_EQ(evaluatedCount, 1U);
+    EXPECT_EQ(g_handlerCalledCount, 1U);
+}
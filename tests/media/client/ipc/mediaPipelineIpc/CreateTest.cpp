@@ -65,6 +65,9 @@ TEST_F(RialtoClientCreateMediaPipelineIpcTest, CreateDestroy)
                                                                             m_eventThreadFactoryMock));
     EXPECT_NE(m_mediaPipelineIpc, nullptr);
 
+    std::uint32_t statusPageOffset{0};
+    EXPECT_FALSE(m_mediaPipelineIpc->getStatusPageOffset(statusPageOffset));
+
     /* destroy media player */
     expectIpcApiCallSuccess();
     expectUnsubscribeEvents();
@@ -76,6 +79,48 @@ TEST_F(RialtoClientCreateMediaPipelineIpcTest, CreateDestroy)
     EXPECT_EQ(m_mediaPipelineIpc, nullptr);
 }
 
+/**
+ * Test that the offset of the status page is stored when the server provides it.
+ */
+TEST_F(RialtoClientCreateMediaPipelineIpcTest, CreateWithStatusPage)
+{
+    constexpr std::uint32_t kStatusPageOffset{16 * 1024 * 1024};
+    expectInitIpc();
+    expectSubscribeEvents();
+    expectIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_eventThreadFactoryMock, createEventThread(_)).WillOnce(Return(ByMove(std::move(m_eventThread))));
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("createSession"), m_controllerMock.get(),
+                                           createSessionRequestMatcher(m_videoReq.maxWidth, m_videoReq.maxHeight), _,
+                                           m_blockingClosureMock.get()))
+        .WillOnce(WithArgs<3>(Invoke(
+            [&](google::protobuf::Message *response)
+            {
+                firebolt::rialto::CreateSessionResponse *createSessionResponse =
+                    dynamic_cast<firebolt::rialto::CreateSessionResponse *>(response);
+                createSessionResponse->set_session_id(m_sessionId);
+                createSessionResponse->set_status_page_offset(kStatusPageOffset);
+            })));
+
+    EXPECT_NO_THROW(m_mediaPipelineIpc = std::make_unique<MediaPipelineIpc>(m_clientMock, m_videoReq,
+                                                                            m_ipcClientFactoryMock,
+                                                                            m_eventThreadFactoryMock));
+    ASSERT_NE(m_mediaPipelineIpc, nullptr);
+
+    std::uint32_t statusPageOffset{0};
+    EXPECT_TRUE(m_mediaPipelineIpc->getStatusPageOffset(statusPageOffset));
+    EXPECT_EQ(statusPageOffset, kStatusPageOffset);
+
+    /* destroy media player */
+    expectIpcApiCallSuccess();
+    expectUnsubscribeEvents();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("destroySession"), m_controllerMock.get(),
+                                           destroySessionRequestMatcher(m_sessionId), _, m_blockingClosureMock.get()));
+
+    m_mediaPipelineIpc.reset();
+}
+
 /**
  * Test that a MediaPipelineIpc object not created when the client has not been created.
  */
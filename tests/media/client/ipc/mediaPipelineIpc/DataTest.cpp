@@ -27,7 +27,8 @@ MATCHER(IsNull, "")
 MATCHER_P(ShmInfoMatcher, shmInfo, "")
 {
     return ((arg->maxMetadataBytes == shmInfo->maxMetadataBytes) && (arg->metadataOffset == shmInfo->metadataOffset) &&
-            (arg->mediaDataOffset == shmInfo->mediaDataOffset) && (arg->maxMediaBytes == shmInfo->maxMediaBytes));
+            (arg->mediaDataOffset == shmInfo->mediaDataOffset) && (arg->maxMediaBytes == shmInfo->maxMediaBytes) &&
+            (arg->maxMetadataVersion == shmInfo->maxMetadataVersion));
 }
 
 MATCHER_P4(HaveDataRequestMatcher, sessionId, status, numFrames, requestId, "")
@@ -72,6 +73,7 @@ protected:
         m_shmInfo->metadataOffset = 6;
         m_shmInfo->mediaDataOffset = 7;
         m_shmInfo->maxMediaBytes = 4U;
+        m_shmInfo->maxMetadataVersion = 3U;
     }
 
     std::shared_ptr<firebolt::rialto::NeedMediaDataEvent> createNeedDataEvent(bool withShmInfo)
@@ -89,6 +91,7 @@ protected:
             shmInfoProto->set_metadata_offset(m_shmInfo->metadataOffset);
             shmInfoProto->set_media_data_offset(m_shmInfo->mediaDataOffset);
             shmInfoProto->set_max_media_bytes(m_shmInfo->maxMediaBytes);
+            shmInfoProto->set_max_metadata_version(m_shmInfo->maxMetadataVersion);
         }
 
         return needMediaDataEvent;
@@ -136,14 +139,14 @@ TEST_F(RialtoClientMediaPipelineIpcDataTest, NeedDataInvalidSessionId)
 }
 
 /**
- * Test that haveData can be called successfully.
+ * Test that haveData is sent without waiting for the server to process the data.
  */
 TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataSuccess)
 {
     expectIpcApiCallSuccess();
 
     EXPECT_CALL(*m_channelMock,
-                CallMethod(methodMatcher("haveData"), m_controllerMock.get(),
+                CallMethod(methodMatcher("haveDataNoReply"), m_controllerMock.get(),
                            HaveDataRequestMatcher(m_sessionId, firebolt::rialto::HaveDataRequest_MediaSourceStatus_OK,
                                                   m_numFrames, m_requestId),
                            _, m_blockingClosureMock.get()));
@@ -152,13 +155,13 @@ TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataSuccess)
 }
 
 /**
- * Test that haveData fails when ipc fails.
+ * Test that haveData fails when the ipc fails to send the request.
  */
 TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataFailure)
 {
     expectIpcApiCallFailure();
 
-    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveData"), _, _, _, _));
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataNoReply"), _, _, _, _));
 
     EXPECT_EQ(m_mediaPipelineIpc->haveData(MediaSourceStatus::OK, m_numFrames, m_requestId), false);
 }
@@ -187,7 +190,36 @@ TEST_F(RialtoClientMediaPipelineIpcDataTest, ReconnectChannel)
     expectUnsubscribeEvents();
     expectSubscribeEvents();
 
-    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveData"), _, _, _, _));
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataNoReply"), _, _, _, _));
 
     EXPECT_EQ(m_mediaPipelineIpc->haveData(MediaSourceStatus::OK, m_numFrames, m_requestId), true);
 }
+
+/**
+ * Test that a have data error event over IPC is forwarded to the client.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataError)
+{
+    auto haveDataErrorEvent = std::make_shared<firebolt::rialto::HaveDataErrorEvent>();
+    haveDataErrorEvent->set_session_id(m_sessionId);
+    haveDataErrorEvent->set_request_id(m_requestId);
+
+    EXPECT_CALL(*m_eventThreadMock, addImpl(_)).WillOnce(Invoke([](std::function<void()> &&func) { func(); }));
+    EXPECT_CALL(*m_clientMock, notifyHaveDataError(m_requestId));
+
+    m_haveDataErrorCb(haveDataErrorEvent);
+}
+
+/**
+ * Test that a have data error event for another session is ignored.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataErrorInvalidSessionId)
+{
+    auto haveDataErrorEvent = std::make_shared<firebolt::rialto::HaveDataErrorEvent>();
+    haveDataErrorEvent->set_session_id(-1);
+    haveDataErrorEvent->set_request_id(m_requestId);
+
+    EXPECT_CALL(*m_eventThreadMock, addImpl(_)).WillOnce(Invoke([](std::function<void()> &&func) { func(); }));
+
+    m_haveDataErrorCb(haveDataErrorEvent);
+}
@@ -103,6 +103,15 @@ void MediaPipelineIpcTestBase::expectSubscribeEvents()
                 return static_cast<int>(EventTags::QosEvent);
             }))
         .RetiresOnSaturation();
+    EXPECT_CALL(*m_channelMock, subscribeImpl("firebolt.rialto.HaveDataErrorEvent", _, _))
+        .WillOnce(Invoke(
+            [this](const std::string &eventName, const google::protobuf::Descriptor *descriptor,
+                   std::function<void(const std::shared_ptr<google::protobuf::Message> &msg)> &&handler)
+            {
+                m_haveDataErrorCb = std::move(handler);
+                return static_cast<int>(EventTags::HaveDataErrorEvent);
+            }))
+        .RetiresOnSaturation();
 }
 
 void MediaPipelineIpcTestBase::expectUnsubscribeEvents()
@@ -112,6 +121,7 @@ void MediaPipelineIpcTestBase::expectUnsubscribeEvents()
     EXPECT_CALL(*m_channelMock, unsubscribe(static_cast<int>(EventTags::NetworkStateChangeEvent))).WillOnce(Return(true));
     EXPECT_CALL(*m_channelMock, unsubscribe(static_cast<int>(EventTags::NeedMediaDataEvent))).WillOnce(Return(true));
     EXPECT_CALL(*m_channelMock, unsubscribe(static_cast<int>(EventTags::QosEvent))).WillOnce(Return(true));
+    EXPECT_CALL(*m_channelMock, unsubscribe(static_cast<int>(EventTags::HaveDataErrorEvent))).WillOnce(Return(true));
 }
 
 void MediaPipelineIpcTestBase::destroyMediaPipelineIpc()
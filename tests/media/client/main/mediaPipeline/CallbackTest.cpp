@@ -76,3 +76,25 @@ TEST_F(RialtoClientMediaPipelineCallbackTest, NotifyQos)
 
     m_mediaPipelineCallback->notifyQos(sourceId, qosInfo);
 }
+
+/**
+ * Test a failure of the server to process the data of a haveData call is reported as a playback failure.
+ */
+TEST_F(RialtoClientMediaPipelineCallbackTest, NotifyHaveDataError)
+{
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
+
+    m_mediaPipelineCallback->notifyHaveDataError(1);
+}
+
+/**
+ * Test a failure of the server to process the data of a haveData call is not reported again, if the playback has
+ * already failed.
+ */
+TEST_F(RialtoClientMediaPipelineCallbackTest, NotifyHaveDataErrorAfterFailure)
+{
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
+
+    m_mediaPipelineCallback->notifyPlaybackState(PlaybackState::FAILURE);
+    m_mediaPipelineCallback->notifyHaveDataError(1);
+}
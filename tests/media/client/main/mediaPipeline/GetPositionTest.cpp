@@ -18,10 +18,25 @@
  */
 
 #include "MediaPipelineTestBase.h"
+#include "ShmStatusPage.h"
+#include <chrono>
+
+namespace
+{
+constexpr int64_t kStatusPosition{987654321};
+
+int64_t getMonotonicTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
 
 class RialtoClientMediaPipelineGetPositionTest : public MediaPipelineTestBase
 {
 protected:
+    alignas(8) uint8_t m_statusPageBuffer[firebolt::rialto::common::STATUS_PAGE_SIZE_BYTES] = {0};
+
     virtual void SetUp()
     {
         MediaPipelineTestBase::SetUp();
@@ -35,6 +50,23 @@ protected:
 
         MediaPipelineTestBase::TearDown();
     }
+
+    void statusPageWillNotBeAvailable()
+    {
+        EXPECT_CALL(*m_mediaPipelineIpcMock, getStatusPageOffset(_)).WillOnce(Return(false));
+    }
+
+    void statusPageWillBePublished(PlaybackState playbackState, int64_t positionTimestamp)
+    {
+        firebolt::rialto::common::PlaybackStatus status;
+        status.position = kStatusPosition;
+        status.positionTimestamp = positionTimestamp;
+        status.playbackState = playbackState;
+        firebolt::rialto::common::ShmStatusPage{m_statusPageBuffer}.publish(status);
+
+        EXPECT_CALL(*m_mediaPipelineIpcMock, getStatusPageOffset(_)).WillOnce(DoAll(SetArgReferee<0>(0), Return(true)));
+        EXPECT_CALL(*m_sharedMemoryManagerMock, getSharedMemoryBuffer()).WillOnce(Return(m_statusPageBuffer));
+    }
 };
 
 /**
@@ -44,6 +76,7 @@ TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionSuccess)
 {
     constexpr int64_t expectedPosition{123};
     int64_t resultPosition{};
+    statusPageWillNotBeAvailable();
     EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(resultPosition))
         .WillOnce(Invoke(
             [&](int64_t &position)
@@ -61,6 +94,135 @@ TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionSuccess)
 TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionFailure)
 {
     int64_t resultPosition{};
+    statusPageWillNotBeAvailable();
     EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(resultPosition)).WillOnce(Return(false));
     EXPECT_FALSE(m_mediaPipeline->getPosition(resultPosition));
 }
+
+/**
+ * Test that the position is read from the status page without an IPC call when paused.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionFromStatusPageWhenPaused)
+{
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::PAUSED, 0);
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, kStatusPosition);
+}
+
+/**
+ * Test that the position from the status page is extrapolated when playing.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionFromStatusPageWhenPlaying)
+{
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::PLAYING, getMonotonicTimeNs());
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_GE(resultPosition, kStatusPosition);
+}
+
+/**
+ * Test that the position is requested from the server when the status page is stale.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionFromServerWhenStatusPageIsStale)
+{
+    constexpr int64_t kStaleTimeNs{2000000000};
+    constexpr int64_t kExpectedPosition{123};
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::PLAYING, getMonotonicTimeNs() - kStaleTimeNs);
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kExpectedPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, kExpectedPosition);
+}
+
+/**
+ * Test that the position is requested from the server while seeking.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionFromServerWhenSeeking)
+{
+    constexpr int64_t kExpectedPosition{123};
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::SEEKING, getMonotonicTimeNs());
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kExpectedPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, kExpectedPosition);
+}
+
+/**
+ * Test that the position is requested from the server when it would be extrapolated beyond one report interval.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionFromServerWhenExtrapolationExceedsReportInterval)
+{
+    constexpr int64_t kPositionAgeNs{300000000};
+    constexpr int64_t kExpectedPosition{123};
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::PLAYING, getMonotonicTimeNs() - kPositionAgeNs);
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kExpectedPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, kExpectedPosition);
+}
+
+/**
+ * Test that the position does not go back when the server reports a position behind the extrapolated one.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionDoesNotGoBackWhilePlaying)
+{
+    constexpr int64_t kServerPosition{kStatusPosition - 1000};
+    int64_t firstPosition{};
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::PLAYING, getMonotonicTimeNs());
+    EXPECT_TRUE(m_mediaPipeline->getPosition(firstPosition));
+
+    statusPageWillNotBeAvailable();
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kServerPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, firstPosition);
+}
+
+/**
+ * Test that the position can go back after a seek.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionGoesBackAfterSeek)
+{
+    constexpr int64_t kSeekPosition{123};
+    int64_t resultPosition{};
+    statusPageWillBePublished(PlaybackState::PLAYING, getMonotonicTimeNs());
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+
+    setPlaybackState(PlaybackState::PLAYING);
+    EXPECT_CALL(*m_mediaPipelineIpcMock, setPosition(kSeekPosition)).WillOnce(Return(true));
+    EXPECT_TRUE(m_mediaPipeline->setPosition(kSeekPosition));
+
+    statusPageWillNotBeAvailable();
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_)).WillOnce(DoAll(SetArgReferee<0>(kSeekPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, kSeekPosition);
+}
+
+/**
+ * Test that the position can go back when playing backwards.
+ */
+TEST_F(RialtoClientMediaPipelineGetPositionTest, GetPositionGoesBackWhenPlayingBackwards)
+{
+    constexpr double kRate{-1.0};
+    constexpr int64_t kFirstPosition{2000};
+    constexpr int64_t kSecondPosition{1000};
+    int64_t resultPosition{};
+    EXPECT_CALL(*m_mediaPipelineIpcMock, setPlaybackRate(kRate)).WillOnce(Return(true));
+    EXPECT_TRUE(m_mediaPipeline->setPlaybackRate(kRate));
+
+    statusPageWillNotBeAvailable();
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kFirstPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+
+    statusPageWillNotBeAvailable();
+    EXPECT_CALL(*m_mediaPipelineIpcMock, getPosition(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kSecondPosition), Return(true)));
+    EXPECT_TRUE(m_mediaPipeline->getPosition(resultPosition));
+    EXPECT_EQ(resultPosition, kSecondPosition);
+}
@@ -40,6 +40,7 @@ public:
                 (override));
     MOCK_METHOD(void, notifyPosition, (int64_t position), (override));
     MOCK_METHOD(void, notifyQos, (int32_t sourceId, const QosInfo &qosInfo), (override));
+    MOCK_METHOD(void, notifyHaveDataError, (uint32_t requestId), (override));
 };
 } // namespace firebolt::rialto::client
 
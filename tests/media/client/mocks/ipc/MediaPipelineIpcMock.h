@@ -48,6 +48,7 @@ public:
     MOCK_METHOD(bool, renderFrame, (), (override));
     MOCK_METHOD(bool, setVolume, (double volume), (override));
     MOCK_METHOD(bool, getVolume, (double &volume), (override));
+    MOCK_METHOD(bool, getStatusPageOffset, (std::uint32_t & offset), (const, override));
 };
 } // namespace firebolt::rialto::client
 
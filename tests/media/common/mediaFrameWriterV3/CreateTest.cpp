@@ -0,0 +1,191 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr uint32_t kMaxMetadataBytes{6};
+constexpr uint32_t kMaxMediaBytes{4};
+constexpr uint8_t kGarbage{0xAB};
+} // namespace
+
+class RialtoPlayerCommonCreateMediaFrameWriterV3Test : public ::testing::Test
+{
+protected:
+    std::shared_ptr<IMediaFrameWriterFactory> m_mediaFrameWriterFactory;
+
+    uint8_t m_shmBuffer[kMaxMetadataBytes + kMaxMediaBytes] = {0};
+    std::shared_ptr<MediaPlayerShmInfo> m_shmInfo;
+
+    virtual void SetUp()
+    {
+        m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+
+        // init shm info
+        m_shmInfo = std::make_shared<MediaPlayerShmInfo>();
+        m_shmInfo->maxMetadataBytes = kMaxMetadataBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMaxMetadataBytes;
+        m_shmInfo->maxMediaBytes = kMaxMediaBytes;
+        m_shmInfo->maxMetadataVersion = LATEST_METADATA_VERSION;
+    }
+
+    virtual void TearDown() { m_mediaFrameWriterFactory.reset(); }
+
+    uint32_t readLEUint32(const uint8_t *buffer)
+    {
+        uint32_t value = buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
+        return value;
+    }
+};
+
+/**
+ * Test that an MediaFrameWriterV3 object is created by default, when the server supports it.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriter)
+{
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV3 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV3 writes the version, zeroes the rest of the metadata and leaves the media data intact.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CheckSharedBufferData)
+{
+    memset(m_shmBuffer, kGarbage, sizeof(m_shmBuffer));
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+    EXPECT_NE(mediaFrameWriter, nullptr);
+
+    // Version should be set to 3
+    EXPECT_EQ(readLEUint32(m_shmBuffer), 3U);
+
+    // Rest of the metadata should be zeroed
+    constexpr size_t kZeroedMemSize{kMaxMetadataBytes - VERSION_SIZE_BYTES};
+    uint8_t zeroedMem[kZeroedMemSize] = {0};
+    EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES, kZeroedMemSize), 0);
+
+    // Media data is overwritten frame by frame, so it is not cleared
+    for (uint32_t i = kMaxMetadataBytes; i < kMaxMetadataBytes + kMaxMediaBytes; ++i)
+    {
+        EXPECT_EQ(m_shmBuffer[i], kGarbage);
+    }
+}
+
+/**
+ * Test that an MediaFrameWriterV3 writes data at the given offset.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, Offset)
+{
+    constexpr int kOffset{2};
+    m_shmInfo->metadataOffset += kOffset;
+    m_shmInfo->mediaDataOffset += kOffset;
+    m_shmInfo->maxMediaBytes -= kOffset;
+
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+    EXPECT_NE(mediaFrameWriter, nullptr);
+
+    // Version should be set to 3
+    EXPECT_EQ(readLEUint32(m_shmBuffer + m_shmInfo->metadataOffset), 3U);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 is created, when wrong version of metadata is set in env variable
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterWhenEnvVariableVersionIsTooBig)
+{
+    m_mediaFrameWriterFactory.reset();
+    setenv("RIALTO_METADATA_VERSION", "5", 1);
+    m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV3 &>(*mediaFrameWriter));
+    unsetenv("RIALTO_METADATA_VERSION");
+}
+
+/**
+ * Test that an MediaFrameWriterV3 is created, when invalid version of metadata is set in env variable
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterWhenEnvVariableVersionIsInvalid)
+{
+    m_mediaFrameWriterFactory.reset();
+    setenv("RIALTO_METADATA_VERSION", "HELLO", 1);
+    m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV3 &>(*mediaFrameWriter));
+    unsetenv("RIALTO_METADATA_VERSION");
+}
+
+/**
+ * Test that an MediaFrameWriterV2 is created, when the server did not report the supported metadata version.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterV2WhenServerVersionIsUnknown)
+{
+    m_shmInfo->maxMetadataVersion = 0;
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV2 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV2 is created, when the server supports only metadata version 2.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterV2WhenServerSupportsV2)
+{
+    m_shmInfo->maxMetadataVersion = 2;
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV2 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV3 is created, when the server supports a newer metadata version.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterV3WhenServerSupportsNewerVersion)
+{
+    m_shmInfo->maxMetadataVersion = LATEST_METADATA_VERSION + 1;
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV3 &>(*mediaFrameWriter));
+}
@@ -0,0 +1,381 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include "ShmCommon.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr uint32_t kMaxMetaBytes{6};
+constexpr uint32_t kMaxBytes{250};
+constexpr uint8_t kMediaData[]{0xD, 0xE, 0xA, 0xD, 0xB, 0xE, 0xE, 0xF};
+constexpr uint32_t kMediaDataLength{8};
+constexpr int32_t kSourceId{1};
+constexpr int64_t kTimeStamp{1423435};
+constexpr int64_t kTimeStampDelta{20000};
+constexpr int64_t kDuration{12324};
+constexpr int32_t kSampleRate{3536};
+constexpr int32_t kNumberOfChannels{3};
+constexpr int32_t kWidth{1024};
+constexpr int32_t kHeight{768};
+const std::vector<uint8_t> kExtraData{1, 2, 3, 4};
+const int32_t kMksId{43};
+const std::vector<uint8_t> kKeyId{9, 2, 6, 2, 0, 1};
+const std::vector<uint8_t> kInitVector{34, 53, 54, 62, 56};
+constexpr size_t kNumClearBytes{2};
+constexpr size_t kNumEncryptedBytes{7};
+constexpr uint32_t kInitWithLast15{1};
+
+struct FrameHeader
+{
+    uint32_t headerSize;
+    uint32_t dataLength;
+    uint32_t streamId;
+    uint8_t flags;
+    uint8_t segmentAlignment;
+    uint8_t keyIdLength;
+    uint8_t initVectorLength;
+    uint32_t extraDataLength;
+    uint32_t subSampleCount;
+    int64_t timeStampDelta;
+    int64_t duration;
+    uint32_t param1;
+    uint32_t param2;
+    uint32_t mediaKeySessionId;
+    uint32_t initWithLast15;
+    std::vector<uint8_t> keyId;
+    std::vector<uint8_t> initVector;
+    std::vector<uint8_t> extraData;
+    std::vector<std::pair<uint32_t, uint32_t>> subSamples;
+};
+
+uint32_t readLEUint32(const uint8_t *&buffer)
+{
+    uint32_t value = buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
+    buffer += sizeof(uint32_t);
+    return value;
+}
+
+int64_t readLEInt64(const uint8_t *&buffer)
+{
+    uint64_t low{readLEUint32(buffer)};
+    uint64_t high{readLEUint32(buffer)};
+    return static_cast<int64_t>(high << 32 | low);
+}
+
+std::vector<uint8_t> readBytes(const uint8_t *&buffer, size_t count)
+{
+    std::vector<uint8_t> result{buffer, buffer + count};
+    buffer += count;
+    return result;
+}
+
+FrameHeader readHeader(const uint8_t *&buffer)
+{
+    FrameHeader header;
+    header.headerSize = readLEUint32(buffer);
+    header.dataLength = readLEUint32(buffer);
+    header.streamId = readLEUint32(buffer);
+    header.flags = *buffer++;
+    header.segmentAlignment = *buffer++;
+    header.keyIdLength = *buffer++;
+    header.initVectorLength = *buffer++;
+    header.extraDataLength = readLEUint32(buffer);
+    header.subSampleCount = readLEUint32(buffer);
+    header.timeStampDelta = readLEInt64(buffer);
+    header.duration = readLEInt64(buffer);
+    header.param1 = readLEUint32(buffer);
+    header.param2 = readLEUint32(buffer);
+    header.mediaKeySessionId = readLEUint32(buffer);
+    header.initWithLast15 = readLEUint32(buffer);
+    header.keyId = readBytes(buffer, header.keyIdLength);
+    header.initVector = readBytes(buffer, header.initVectorLength);
+    header.extraData = readBytes(buffer, header.extraDataLength);
+    for (uint32_t i = 0; i < header.subSampleCount; ++i)
+    {
+        uint32_t numClearBytes{readLEUint32(buffer)};
+        uint32_t numEncryptedBytes{readLEUint32(buffer)};
+        header.subSamples.emplace_back(numClearBytes, numEncryptedBytes);
+    }
+    return header;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createAudioSegment(int64_t timeStamp = kTimeStamp)
+{
+    auto segment{std::make_unique<IMediaPipeline::MediaSegmentAudio>(kSourceId, timeStamp, kDuration, kSampleRate,
+                                                                     kNumberOfChannels)};
+    segment->setData(kMediaDataLength, kMediaData);
+    return segment;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createVideoSegment()
+{
+    auto segment{std::make_unique<IMediaPipeline::MediaSegmentVideo>(kSourceId, kTimeStamp, kDuration, kWidth, kHeight)};
+    segment->setData(kMediaDataLength, kMediaData);
+    return segment;
+}
+
+void addOptionalData(std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+{
+    segment->setSegmentAlignment(SegmentAlignment::NAL);
+    segment->setExtraData(kExtraData);
+}
+
+void addEncryptionData(std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+{
+    segment->setEncrypted(true);
+    segment->setMediaKeySessionId(kMksId);
+    segment->setKeyId(kKeyId);
+    segment->setInitVector(kInitVector);
+    segment->addSubSample(kNumClearBytes, kNumEncryptedBytes);
+    segment->setInitWithLast15(kInitWithLast15);
+}
+
+void checkMandatoryMetadata(const FrameHeader &header)
+{
+    EXPECT_EQ(header.headerSize, METADATA_V3_FIXED_HEADER_SIZE_BYTES + header.keyIdLength + header.initVectorLength +
+                                     header.extraDataLength + header.subSampleCount * METADATA_V3_SUBSAMPLE_SIZE_BYTES);
+    EXPECT_EQ(header.dataLength, kMediaDataLength);
+    EXPECT_EQ(header.streamId, kSourceId);
+    EXPECT_EQ(header.duration, kDuration);
+}
+
+void checkAudioMetadata(const FrameHeader &header)
+{
+    EXPECT_TRUE(header.flags & METADATA_V3_FLAG_AUDIO_PARAMS);
+    EXPECT_FALSE(header.flags & METADATA_V3_FLAG_VIDEO_PARAMS);
+    EXPECT_EQ(header.param1, kSampleRate);
+    EXPECT_EQ(header.param2, kNumberOfChannels);
+}
+
+void checkVideoMetadata(const FrameHeader &header)
+{
+    EXPECT_FALSE(header.flags & METADATA_V3_FLAG_AUDIO_PARAMS);
+    EXPECT_TRUE(header.flags & METADATA_V3_FLAG_VIDEO_PARAMS);
+    EXPECT_EQ(header.param1, kWidth);
+    EXPECT_EQ(header.param2, kHeight);
+}
+
+void checkOptionalMetadataNotPresent(const FrameHeader &header)
+{
+    EXPECT_EQ(header.segmentAlignment, 0);
+    EXPECT_TRUE(header.extraData.empty());
+}
+
+void checkOptionalMetadataPresent(const FrameHeader &header)
+{
+    EXPECT_EQ(header.segmentAlignment, 1);
+    EXPECT_EQ(header.extraData, kExtraData);
+}
+
+void checkEncryptionMetadataNotPresent(const FrameHeader &header)
+{
+    EXPECT_FALSE(header.flags & METADATA_V3_FLAG_ENCRYPTED);
+    EXPECT_EQ(header.mediaKeySessionId, 0);
+    EXPECT_TRUE(header.keyId.empty());
+    EXPECT_TRUE(header.initVector.empty());
+    EXPECT_EQ(header.initWithLast15, 0);
+    EXPECT_TRUE(header.subSamples.empty());
+}
+
+void checkEncryptionMetadataPresent(const FrameHeader &header)
+{
+    EXPECT_TRUE(header.flags & METADATA_V3_FLAG_ENCRYPTED);
+    EXPECT_EQ(header.mediaKeySessionId, kMksId);
+    EXPECT_EQ(header.keyId, kKeyId);
+    EXPECT_EQ(header.initVector, kInitVector);
+    EXPECT_EQ(header.initWithLast15, kInitWithLast15);
+    ASSERT_EQ(header.subSamples.size(), 1);
+    EXPECT_EQ(header.subSamples[0].first, kNumClearBytes);
+    EXPECT_EQ(header.subSamples[0].second, kNumEncryptedBytes);
+}
+
+void checkMediaData(const uint8_t *&readPosition)
+{
+    const std::vector<uint8_t> kExpectedData{kMediaData, kMediaData + kMediaDataLength};
+    EXPECT_EQ(readBytes(readPosition, kMediaDataLength), kExpectedData);
+}
+} // namespace
+
+class RialtoPlayerCommonWriteFrameV3Test : public ::testing::Test
+{
+protected:
+    uint8_t m_shmBuffer[kMaxBytes] = {0};
+    std::shared_ptr<MediaPlayerShmInfo> m_shmInfo;
+    const uint8_t *m_readPosition{m_shmBuffer + kMaxMetaBytes};
+
+    virtual void SetUp()
+    {
+        // init shm info
+        m_shmInfo = std::make_shared<MediaPlayerShmInfo>();
+        m_shmInfo->maxMetadataBytes = kMaxMetaBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMaxMetaBytes;
+        m_shmInfo->maxMediaBytes = kMaxBytes - kMaxMetaBytes;
+    }
+
+    FrameHeader readSegment()
+    {
+        const uint8_t *versionPosition{m_shmBuffer};
+        // Version should be set to 3
+        EXPECT_EQ(readLEUint32(versionPosition), 3U);
+
+        FrameHeader header{readHeader(m_readPosition)};
+        checkMandatoryMetadata(header);
+        checkMediaData(m_readPosition);
+        return header;
+    }
+};
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted audio without optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedAudioWithoutOptionalParams)
+{
+    auto segment = createAudioSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    EXPECT_EQ(header.timeStampDelta, kTimeStamp);
+    checkAudioMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted audio with optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedAudioWithOptionalParams)
+{
+    auto segment = createAudioSegment();
+    addOptionalData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkAudioMetadata(header);
+    checkOptionalMetadataPresent(header);
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write encrypted audio
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteEncryptedAudio)
+{
+    auto segment = createAudioSegment();
+    addEncryptionData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkAudioMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted video with optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedVideoWithOptionalParams)
+{
+    auto segment = createVideoSegment();
+    addOptionalData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkVideoMetadata(header);
+    checkOptionalMetadataPresent(header);
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write encrypted video
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteEncryptedVideo)
+{
+    auto segment = createVideoSegment();
+    addEncryptionData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkVideoMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 codes timestamps of consecutive frames as deltas
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteTimeStampsAsDeltas)
+{
+    auto firstSegment = createAudioSegment();
+    auto secondSegment = createAudioSegment(kTimeStamp + kTimeStampDelta);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(firstSegment));
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(secondSegment));
+    EXPECT_EQ(2, mediaFrameWriter.getNumFrames());
+    EXPECT_EQ(readSegment().timeStampDelta, kTimeStamp);
+    EXPECT_EQ(readSegment().timeStampDelta, kTimeStampDelta);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 will return NO_SPACE when we don't have enough memory
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, SkipWritingDueToNoSpaceAvailable)
+{
+    m_shmInfo->maxMediaBytes = METADATA_V3_FIXED_HEADER_SIZE_BYTES + kMediaDataLength - 1;
+    auto segment = createVideoSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::NO_SPACE, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
+}
+
+/**
+ * Test that an MediaFrameWriterV3 will return ERROR when MediaSegment has unknown media type
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, SkipWritingDueToUnknownDataType)
+{
+    auto segment = std::make_unique<IMediaPipeline::MediaSegment>();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::ERROR, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
+}
+
+/**
+ * Test that an MediaFrameWriterV3 will return ERROR when the key id does not fit the header
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, SkipWritingDueToTooLongKeyId)
+{
+    auto segment = createVideoSegment();
+    addEncryptionData(segment);
+    segment->setKeyId(std::vector<uint8_t>(256, 1));
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::ERROR, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
+}
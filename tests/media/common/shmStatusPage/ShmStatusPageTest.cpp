@@ -0,0 +1,140 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmStatusPage.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+class RialtoPlayerCommonShmStatusPageTest : public ::testing::Test
+{
+protected:
+    alignas(8) uint8_t m_page[STATUS_PAGE_SIZE_BYTES] = {0};
+    ShmStatusPage m_writer{m_page};
+    ShmStatusPage m_reader{m_page};
+};
+
+/**
+ * Test that a page that has not been published to can't be read.
+ */
+TEST_F(RialtoPlayerCommonShmStatusPageTest, EmptyPage)
+{
+    PlaybackStatus status;
+    EXPECT_FALSE(m_reader.read(status));
+}
+
+/**
+ * Test that the published status is read back.
+ */
+TEST_F(RialtoPlayerCommonShmStatusPageTest, PublishAndRead)
+{
+    PlaybackStatus published;
+    published.position = 1234;
+    published.positionTimestamp = 5678;
+    published.playbackRate = 2.0;
+    published.playbackState = PlaybackState::PLAYING;
+    published.networkState = NetworkState::BUFFERED;
+    published.audioQueuedBytes = 10;
+    published.videoQueuedBytes = 20;
+    published.audioQos = {30, 1};
+    published.videoQos = {40, 2};
+    m_writer.publish(published);
+
+    PlaybackStatus status;
+    ASSERT_TRUE(m_reader.read(status));
+    EXPECT_EQ(status.position, published.position);
+    EXPECT_EQ(status.positionTimestamp, published.positionTimestamp);
+    EXPECT_EQ(status.playbackRate, published.playbackRate);
+    EXPECT_EQ(status.playbackState, published.playbackState);
+    EXPECT_EQ(status.networkState, published.networkState);
+    EXPECT_EQ(status.audioQueuedBytes, published.audioQueuedBytes);
+    EXPECT_EQ(status.videoQueuedBytes, published.videoQueuedBytes);
+    EXPECT_EQ(status.audioQos.processed, published.audioQos.processed);
+    EXPECT_EQ(status.audioQos.dropped, published.audioQos.dropped);
+    EXPECT_EQ(status.videoQos.processed, published.videoQos.processed);
+    EXPECT_EQ(status.videoQos.dropped, published.videoQos.dropped);
+}
+
+/**
+ * Test that an invalidated page can't be read.
+ */
+TEST_F(RialtoPlayerCommonShmStatusPageTest, Invalidate)
+{
+    m_writer.publish(PlaybackStatus{});
+    m_writer.invalidate();
+
+    PlaybackStatus status;
+    EXPECT_FALSE(m_reader.read(status));
+}
+
+/**
+ * Test that a reader never sees a partially written status while the writer keeps publishing.
+ */
+TEST_F(RialtoPlayerCommonShmStatusPageTest, ConcurrentReadsAreConsistent)
+{
+    m_writer.publish(PlaybackStatus{});
+
+    std::atomic<bool> stop{false};
+    std::thread writer(
+        [&]()
+        {
+            PlaybackStatus status;
+            for (int64_t i = 1; !stop; ++i)
+            {
+                status.position = i;
+                status.positionTimestamp = i;
+                status.audioQueuedBytes = static_cast<uint64_t>(i);
+                m_writer.publish(status);
+            }
+        });
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        PlaybackStatus status;
+        if (m_reader.read(status))
+        {
+            ASSERT_EQ(status.position, status.positionTimestamp);
+            ASSERT_EQ(static_cast<uint64_t>(status.position), status.audioQueuedBytes);
+        }
+    }
+
+    stop = true;
+    writer.join();
+}
+
+/**
+ * Test that the position only moves on while playing.
+ */
+TEST_F(RialtoPlayerCommonShmStatusPageTest, ExtrapolatePosition)
+{
+    PlaybackStatus status;
+    status.position = 1000;
+    status.positionTimestamp = 500;
+    status.playbackRate = 2.0;
+
+    status.playbackState = PlaybackState::PAUSED;
+    EXPECT_EQ(extrapolatePosition(status, 600), 1000);
+
+    status.playbackState = PlaybackState::PLAYING;
+    EXPECT_EQ(extrapolatePosition(status, 600), 1200);
+    EXPECT_EQ(extrapolatePosition(status, 400), 1000);
+}
@@ -25,11 +25,13 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <mutex>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
 
 using namespace firebolt::rialto::server;
 
 using ::testing::_;
-using ::testing::ByMove;
 using ::testing::DoAll;
 using ::testing::InSequence;
 using ::testing::Invoke;
@@ -37,174 +39,226 @@ using ::testing::Return;
 using ::testing::SetArgPointee;
 using ::testing::StrictMock;
 
+namespace
+{
+constexpr std::chrono::milliseconds kTimeout{200};
+} // namespace
+
 class GstDispatcherThreadTest : public ::testing::Test
 {
 protected:
+    GstDispatcherThreadTest()
+    {
+        m_busFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        m_secondBusFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    }
+
+    ~GstDispatcherThreadTest() override
+    {
+        close(m_busFd);
+        close(m_secondBusFd);
+    }
+
+    void busWillBeCreated(GstElement &pipeline, GstBus &bus, int busFd)
+    {
+        EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&pipeline))).WillOnce(Return(&bus));
+        EXPECT_CALL(*m_gstWrapperMock, gstBusGetPollfd(&bus, _))
+            .WillOnce(Invoke([busFd](GstBus *, GPollFD *fd) { fd->fd = busFd; }));
+    }
+
+    void busWillBeReleased(GstBus &bus) { EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&bus)); }
+
+    void postMessage(int busFd)
+    {
+        uint64_t value{1};
+        EXPECT_EQ(write(busFd, &value, sizeof(value)), sizeof(value));
+    }
+
+    GstMessage *drainBus(int busFd)
+    {
+        uint64_t value{0};
+        EXPECT_EQ(read(busFd, &value, sizeof(value)), sizeof(value));
+        return nullptr;
+    }
+
+    void notifyMessageHandled()
+    {
+        std::unique_lock<std::mutex> lock(m_messagesMutex);
+        ++m_numOfHandledMessages;
+        m_messagesCond.notify_all();
+    }
+
+    bool waitForHandledMessages(unsigned numOfMessages)
+    {
+        std::unique_lock<std::mutex> lock(m_messagesMutex);
+        return m_messagesCond.wait_for(lock, kTimeout,
+                                       [&]() { return m_numOfHandledMessages >= numOfMessages; });
+    }
+
     GstElement m_pipeline{};
+    GstElement m_secondPipeline{};
     StrictMock<firebolt::rialto::server::GstDispatcherThreadClientMock> m_client;
+    StrictMock<firebolt::rialto::server::GstDispatcherThreadClientMock> m_secondClient;
     std::shared_ptr<StrictMock<GstWrapperMock>> m_gstWrapperMock{std::make_shared<StrictMock<GstWrapperMock>>()};
 
-    std::mutex m_dispatcherThreadMutex;
-    std::condition_variable m_dispatcherThreadCond;
-    bool m_dispatcherThreadDone{false};
+    std::mutex m_messagesMutex;
+    std::condition_variable m_messagesCond;
+    unsigned m_numOfHandledMessages{0};
     GstBus m_bus{};
+    GstBus m_secondBus{};
     GstMessage m_message{};
+    GstMessage m_secondMessage{};
+    int m_busFd;
+    int m_secondBusFd;
 };
 
 /**
- * Test when gstBusTimedPopFiltered exits with timeout
+ * Test that the dispatcher stops dispatching the bus after a pipeline error.
  */
-TEST_F(GstDispatcherThreadTest, PollTimeout)
+TEST_F(GstDispatcherThreadTest, Error)
 {
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_ERROR;
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-    {
-        InSequence seq;
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(nullptr));
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-        EXPECT_CALL(m_client, handleBusMessage(_));
-    }
-
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
+    busWillBeCreated(m_pipeline, m_bus, m_busFd);
+    busWillBeReleased(m_bus);
+    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _)).WillOnce(Return(&m_message));
+    EXPECT_CALL(m_client, handleBusMessage(&m_message))
+        .WillOnce(Invoke([this](GstMessage *) { notifyMessageHandled(); }));
 
     auto sut = std::make_unique<GstDispatcherThread>(m_client, &m_pipeline, m_gstWrapperMock);
+    postMessage(m_busFd);
+    EXPECT_TRUE(waitForHandledMessages(1));
+
+    // The bus fd is still readable, but must not be dispatched any more
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    sut.reset();
 }
-#if 0
+
 /**
- * Test that a GST_MESSAGE_STATE_CHANGED message is handled correctly.
+ * Test that a GST_MESSAGE_STATE_CHANGED message to paused is dispatched and the bus stays dispatched.
  */
 TEST_F(GstDispatcherThreadTest, StateChangedToPaused)
 {
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_STATE_CHANGED;
+    GST_MESSAGE_SRC(&m_secondMessage) = GST_OBJECT(&m_pipeline);
+    GST_MESSAGE_TYPE(&m_secondMessage) = GST_MESSAGE_EOS;
 
-    GstState oldState = GST_STATE_READY;
-    GstState newState = GST_STATE_PAUSED;
-    GstState pending = GST_STATE_VOID_PENDING;
-
-    GstMessage messageError = {};
-    GST_MESSAGE_SRC(&messageError) = GST_OBJECT(&m_pipeline);
-    GST_MESSAGE_TYPE(&messageError) = GST_MESSAGE_ERROR;
-
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-
+    busWillBeCreated(m_pipeline, m_bus, m_busFd);
+    busWillBeReleased(m_bus);
     EXPECT_CALL(*m_gstWrapperMock, gstMessageParseStateChanged(&m_message, _, _, _))
-        .WillOnce(DoAll(SetArgPointee<1>(oldState), SetArgPointee<2>(newState), SetArgPointee<3>(pending)));
-    std::unique_ptr<IPlayerTask> stateChangeTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*stateChangeTask), execute());
-    std::unique_ptr<IPlayerTask> errorTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*errorTask), execute());
-    EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-        .WillRepeatedly(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
-
+        .WillOnce(DoAll(SetArgPointee<1>(GST_STATE_READY), SetArgPointee<2>(GST_STATE_PAUSED),
+                        SetArgPointee<3>(GST_STATE_VOID_PENDING)));
     {
         InSequence seq;
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-        EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(stateChangeTask))));
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&messageError));
-        EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(errorTask))));
+        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _)).WillOnce(Return(&m_message));
+        EXPECT_CALL(m_client, handleBusMessage(&m_message));
+        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _))
+            .WillOnce(Invoke(
+                [this](GstBus *, GstClockTime, GstMessageType)
+                {
+                    GstMessage *message = drainBus(m_busFd);
+                    notifyMessageHandled();
+                    return message;
+                }));
+        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _)).WillOnce(Return(&m_secondMessage));
+        EXPECT_CALL(m_client, handleBusMessage(&m_secondMessage))
+            .WillOnce(Invoke([this](GstMessage *) { notifyMessageHandled(); }));
+        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _))
+            .WillOnce(Invoke([this](GstBus *, GstClockTime, GstMessageType) { return drainBus(m_busFd); }));
     }
 
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
-
     auto sut = std::make_unique<GstDispatcherThread>(m_client, &m_pipeline, m_gstWrapperMock);
+    postMessage(m_busFd);
+    EXPECT_TRUE(waitForHandledMessages(1));
+    postMessage(m_busFd);
+    EXPECT_TRUE(waitForHandledMessages(2));
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    sut.reset();
 }
 
 /**
- * Test that a GST_MESSAGE_STATE_CHANGED message is handled correctly.
+ * Test that the dispatcher stops dispatching the bus, when the pipeline changes state to null.
  */
-TEST_F(GstDispatcherThreadTest, StateChangedToStop)
+TEST_F(GstDispatcherThreadTest, StateChangedToNull)
 {
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_STATE_CHANGED;
 
-    GstState oldState = GST_STATE_PLAYING;
-    GstState newState = GST_STATE_NULL;
-    GstState pending = GST_STATE_VOID_PENDING;
-
+    busWillBeCreated(m_pipeline, m_bus, m_busFd);
+    busWillBeReleased(m_bus);
     EXPECT_CALL(*m_gstWrapperMock, gstMessageParseStateChanged(&m_message, _, _, _))
-        .WillOnce(DoAll(SetArgPointee<1>(oldState), SetArgPointee<2>(newState), SetArgPointee<3>(pending)));
-    std::unique_ptr<IPlayerTask> stateChangeTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-        .WillOnce(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*stateChangeTask), execute());
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-    EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(stateChangeTask))));
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
+        .WillOnce(DoAll(SetArgPointee<1>(GST_STATE_READY), SetArgPointee<2>(GST_STATE_NULL),
+                        SetArgPointee<3>(GST_STATE_VOID_PENDING)));
+    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _)).WillOnce(Return(&m_message));
+    EXPECT_CALL(m_client, handleBusMessage(&m_message))
+        .WillOnce(Invoke([this](GstMessage *) { notifyMessageHandled(); }));
 
     auto sut = std::make_unique<GstDispatcherThread>(m_client, &m_pipeline, m_gstWrapperMock);
+    postMessage(m_busFd);
+    EXPECT_TRUE(waitForHandledMessages(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    sut.reset();
 }
 
 /**
- * Test that a GST_MESSAGE_ERROR message is handled correctly.
+ * Test that the messages of several pipelines are dispatched by a single thread.
  */
-TEST_F(GstDispatcherThreadTest, Error)
+TEST_F(GstDispatcherThreadTest, MultiplePipelinesShareDispatcherThread)
 {
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_ERROR;
-    std::unique_ptr<IPlayerTask> errorTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*errorTask), execute());
-    EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-        .WillOnce(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-    EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(errorTask))));
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
+    GST_MESSAGE_SRC(&m_secondMessage) = GST_OBJECT(&m_secondPipeline);
+    GST_MESSAGE_TYPE(&m_secondMessage) = GST_MESSAGE_ERROR;
+    std::thread::id firstThreadId;
+    std::thread::id secondThreadId;
+
+    busWillBeCreated(m_pipeline, m_bus, m_busFd);
+    busWillBeReleased(m_bus);
+    busWillBeCreated(m_secondPipeline, m_secondBus, m_secondBusFd);
+    busWillBeReleased(m_secondBus);
+    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 0, _)).WillOnce(Return(&m_message));
+    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_secondBus, 0, _)).WillOnce(Return(&m_secondMessage));
+    EXPECT_CALL(m_client, handleBusMessage(&m_message))
+        .WillOnce(Invoke(
+            [&](GstMessage *)
+            {
+                firstThreadId = std::this_thread::get_id();
+                notifyMessageHandled();
+            }));
+    EXPECT_CALL(m_secondClient, handleBusMessage(&m_secondMessage))
         .WillOnce(Invoke(
-            [this](gpointer bus)
+            [&](GstMessage *)
             {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
+                secondThreadId = std::this_thread::get_id();
+                notifyMessageHandled();
             }));
 
     auto sut = std::make_unique<GstDispatcherThread>(m_client, &m_pipeline, m_gstWrapperMock);
+    auto secondSut = std::make_unique<GstDispatcherThread>(m_secondClient, &m_secondPipeline, m_gstWrapperMock);
+    postMessage(m_busFd);
+    postMessage(m_secondBusFd);
+    EXPECT_TRUE(waitForHandledMessages(2));
+
+    {
+        std::unique_lock<std::mutex> lock(m_messagesMutex);
+        EXPECT_EQ(firstThreadId, secondThreadId);
+        EXPECT_NE(firstThreadId, std::this_thread::get_id());
+    }
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    sut.reset();
+    secondSut.reset();
+}
+
+/**
+ * Test that nothing is dispatched, when the bus of the pipeline cannot be retrieved.
+ */
+TEST_F(GstDispatcherThreadTest, FailToGetBus)
+{
+    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(nullptr));
+
+    auto sut = std::make_unique<GstDispatcherThread>(m_client, &m_pipeline, m_gstWrapperMock);
+    sut.reset();
 }
-#endif
@@ -17,6 +17,7 @@
  * limitations under the License.
  */
 
+#include "DataReaderMock.h"
 #include "GstGenericPlayerTestCommon.h"
 #include "Matchers.h"
 #include "MediaSourceUtil.h"
@@ -123,6 +124,16 @@ TEST_F(GstGenericPlayerPrivateTest, shouldScheduleNeedData)
     m_sut->scheduleNeedMediaData(&appSrc);
 }
 
+TEST_F(GstGenericPlayerPrivateTest, shouldScheduleNotifyNeedMediaData)
+{
+    std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
+    EXPECT_CALL(m_taskFactoryMock, createNotifyNeedMediaData(_, MediaSourceType::VIDEO))
+        .WillOnce(Return(ByMove(std::move(task))));
+
+    m_sut->scheduleNotifyNeedMediaData(MediaSourceType::VIDEO);
+}
+
 TEST_F(GstGenericPlayerPrivateTest, shouldScheduleEnoughDataData)
 {
     GstAppSrc appSrc{};
@@ -267,6 +278,76 @@ TEST_F(GstGenericPlayerPrivateTest, shouldCreateClearGstBuffer)
     EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
 }
 
+TEST_F(GstGenericPlayerPrivateTest, shouldCreateZeroCopyGstBuffer)
+{
+    GstBuffer buffer{};
+    gpointer userData{nullptr};
+    GDestroyNotify notify{nullptr};
+    const uint8_t kData[]{1, 2, 3};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    mediaSegment.setData(sizeof(kData), kData);
+    std::shared_ptr<ShmBufferTracker> tracker{std::make_shared<ShmBufferTracker>([](MediaSourceType) {})};
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    std::weak_ptr<IDataReader> weakDataReader{dataReader};
+    modifyContext([&](GenericPlayerContext &context) { context.shmBufferTracker = tracker; });
+
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(GST_MEMORY_FLAG_READONLY, _, sizeof(kData), 0,
+                                                           sizeof(kData), _, _))
+        .WillOnce(Invoke(
+            [&](GstMemoryFlags, gpointer data, gsize, gsize, gsize, gpointer user_data, GDestroyNotify destroyNotify)
+            {
+                EXPECT_EQ(data, kData);
+                userData = user_data;
+                notify = destroyNotify;
+                return &buffer;
+            }));
+    m_sut->createZeroCopyBuffer(mediaSegment, dataReader);
+    EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
+    EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
+    EXPECT_EQ(tracker->getBuffersInUse(MediaSourceType::VIDEO), 1);
+
+    // Wrapped buffer keeps the shm slot in use
+    dataReader.reset();
+    EXPECT_FALSE(weakDataReader.expired());
+
+    ASSERT_TRUE(notify);
+    notify(userData);
+    EXPECT_EQ(tracker->getBuffersInUse(MediaSourceType::VIDEO), 0);
+    EXPECT_TRUE(weakDataReader.expired());
+}
+
+TEST_F(GstGenericPlayerPrivateTest, shouldCopyDataWhenZeroCopyIsDisabled)
+{
+    GstBuffer buffer{};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, mediaSegment.getDataLength(), nullptr))
+        .WillOnce(Return(&buffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, mediaSegment.getData(), mediaSegment.getDataLength()));
+    m_sut->createZeroCopyBuffer(mediaSegment, nullptr);
+}
+
+TEST_F(GstGenericPlayerPrivateTest, shouldDeferNeedAudioDataUntilShmRegionIsReleased)
+{
+    std::shared_ptr<ShmBufferTracker> tracker{std::make_shared<ShmBufferTracker>([](MediaSourceType) {})};
+    modifyContext(
+        [&](GenericPlayerContext &context)
+        {
+            context.audioNeedData = true;
+            context.shmBufferTracker = tracker;
+        });
+    void *trackedBuffer = tracker->trackBuffer(MediaSourceType::AUDIO, nullptr);
+
+    // All slots are wrapped by buffers, so the server can't send the request
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO)).WillOnce(Return(false));
+    m_sut->notifyNeedMediaData(true, false);
+    EXPECT_EQ(tracker->getBuffersInUse(MediaSourceType::AUDIO), 1);
+    modifyContext([&](GenericPlayerContext &context) { EXPECT_TRUE(context.audioNeedDataPending); });
+
+    ShmBufferTracker::onBufferReleased(trackedBuffer);
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO)).WillOnce(Return(true));
+    m_sut->notifyNeedMediaData(true, false);
+}
+
 TEST_F(GstGenericPlayerPrivateTest, shouldCreateEncryptedGstBuffer)
 {
     GstBuffer buffer{}, initVectorBuffer{}, keyIdBuffer{}, subSamplesBuffer{};
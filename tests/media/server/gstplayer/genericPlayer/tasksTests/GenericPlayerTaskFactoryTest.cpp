@@ -34,6 +34,7 @@
 #include "tasks/generic/FinishSetupSource.h"
 #include "tasks/generic/HandleBusMessage.h"
 #include "tasks/generic/NeedData.h"
+#include "tasks/generic/NotifyNeedMediaData.h"
 #include "tasks/generic/Pause.h"
 #include "tasks/generic/Play.h"
 #include "tasks/generic/ReadShmDataAndAttachSamples.h"
@@ -140,6 +141,13 @@ TEST_F(GenericPlayerTaskFactoryTest, ShouldCreatePause)
     EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::Pause &>(*task));
 }
 
+TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateNotifyNeedMediaData)
+{
+    auto task = m_sut.createNotifyNeedMediaData(m_gstPlayer, firebolt::rialto::MediaSourceType::AUDIO);
+    EXPECT_NE(task, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::NotifyNeedMediaData &>(*task));
+}
+
 TEST_F(GenericPlayerTaskFactoryTest, ShouldCreatePlay)
 {
     auto task = m_sut.createPlay(m_gstPlayer);
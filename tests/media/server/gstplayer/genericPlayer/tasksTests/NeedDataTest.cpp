@@ -112,7 +112,8 @@ TEST_F(NeedDataTest, shouldSkipToNotifyNeedAudioDataWhenAudioSourceIsRemoved)
 TEST_F(NeedDataTest, shouldNotifyNeedVideoData)
 {
     setupAppSource();
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO)).WillOnce(Return(true));
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(true));
     firebolt::rialto::server::tasks::generic::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
     task.execute();
     EXPECT_FALSE(m_context.audioNeedData);
@@ -124,7 +125,8 @@ TEST_F(NeedDataTest, shouldNotifyNeedVideoData)
 TEST_F(NeedDataTest, shouldFailToNotifyNeedVideoData)
 {
     setupAppSource();
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO)).WillOnce(Return(false));
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(false));
     firebolt::rialto::server::tasks::generic::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
     task.execute();
     EXPECT_FALSE(m_context.audioNeedData);
@@ -144,3 +146,60 @@ TEST_F(NeedDataTest, shouldSkipToNotifyNeedVideoData)
     EXPECT_TRUE(m_context.videoNeedData);
     EXPECT_TRUE(m_context.videoNeedDataPending);
 }
+
+TEST_F(NeedDataTest, shouldDeferNeedVideoDataWhenShmRegionIsStillUsed)
+{
+    setupAppSource();
+    m_context.shmBufferTracker =
+        std::make_shared<firebolt::rialto::server::ShmBufferTracker>([](firebolt::rialto::MediaSourceType) {});
+    void *trackedBuffer = m_context.shmBufferTracker->trackBuffer(firebolt::rialto::MediaSourceType::VIDEO, nullptr);
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(false));
+    firebolt::rialto::server::tasks::generic::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
+    task.execute();
+    EXPECT_TRUE(m_context.videoNeedData);
+    EXPECT_TRUE(m_context.videoNeedDataPending);
+    firebolt::rialto::server::ShmBufferTracker::onBufferReleased(trackedBuffer);
+}
+
+TEST_F(NeedDataTest, shouldNotifyNeedVideoDataWhenFreeShmSlotIsAvailable)
+{
+    setupAppSource();
+    m_context.shmBufferTracker =
+        std::make_shared<firebolt::rialto::server::ShmBufferTracker>([](firebolt::rialto::MediaSourceType) {});
+    void *trackedBuffer = m_context.shmBufferTracker->trackBuffer(firebolt::rialto::MediaSourceType::VIDEO, nullptr);
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(true));
+    firebolt::rialto::server::tasks::generic::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
+    task.execute();
+    EXPECT_TRUE(m_context.videoNeedData);
+    EXPECT_TRUE(m_context.videoNeedDataPending);
+    EXPECT_EQ(m_context.shmBufferTracker->getBuffersInUse(firebolt::rialto::MediaSourceType::VIDEO), 1);
+    firebolt::rialto::server::ShmBufferTracker::onBufferReleased(trackedBuffer);
+}
+
+TEST_F(NeedDataTest, shouldResendNeedAudioDataWhenShmSlotWasReleasedInTheMeantime)
+{
+    setupAppSource();
+    m_context.shmBufferTracker =
+        std::make_shared<firebolt::rialto::server::ShmBufferTracker>([](firebolt::rialto::MediaSourceType) {});
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO))
+        .WillOnce(Return(false))
+        .WillOnce(Return(true));
+    firebolt::rialto::server::tasks::generic::NeedData task{m_context, &m_gstPlayerClient, &m_audioSrc};
+    task.execute();
+    EXPECT_TRUE(m_context.audioNeedData);
+    EXPECT_TRUE(m_context.audioNeedDataPending);
+}
+
+TEST_F(NeedDataTest, shouldNotifyNeedAudioDataWhenShmRegionIsFree)
+{
+    setupAppSource();
+    m_context.shmBufferTracker =
+        std::make_shared<firebolt::rialto::server::ShmBufferTracker>([](firebolt::rialto::MediaSourceType) {});
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO)).WillOnce(Return(true));
+    firebolt::rialto::server::tasks::generic::NeedData task{m_context, &m_gstPlayerClient, &m_audioSrc};
+    task.execute();
+    EXPECT_TRUE(m_context.audioNeedData);
+    EXPECT_TRUE(m_context.audioNeedDataPending);
+}
@@ -0,0 +1,46 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tasks/generic/NotifyNeedMediaData.h"
+#include "GstGenericPlayerPrivateMock.h"
+#include <gtest/gtest.h>
+
+using testing::StrictMock;
+
+class NotifyNeedMediaDataTest : public testing::Test
+{
+protected:
+    StrictMock<firebolt::rialto::server::GstGenericPlayerPrivateMock> m_gstPlayer;
+};
+
+TEST_F(NotifyNeedMediaDataTest, shouldNotifyNeedAudioData)
+{
+    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(true, false));
+    firebolt::rialto::server::tasks::generic::NotifyNeedMediaData task{m_gstPlayer,
+                                                                       firebolt::rialto::MediaSourceType::AUDIO};
+    task.execute();
+}
+
+TEST_F(NotifyNeedMediaDataTest, shouldNotifyNeedVideoData)
+{
+    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(false, true));
+    firebolt::rialto::server::tasks::generic::NotifyNeedMediaData task{m_gstPlayer,
+                                                                       firebolt::rialto::MediaSourceType::VIDEO};
+    task.execute();
+}
@@ -27,6 +27,7 @@
 
 using testing::_;
 using testing::ByMove;
+using testing::Invoke;
 using testing::Return;
 using testing::StrictMock;
 
@@ -84,7 +85,7 @@ TEST_F(ReadShmDataAndAttachSamplesTest, shouldAttachAllAudioSamples)
     EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
     EXPECT_CALL(m_gstPlayer, updateAudioCaps(sampleRate, numberOfChannels)).Times(2);
     EXPECT_CALL(m_gstPlayer, attachAudioData()).Times(2);
-    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(true, false));
+    EXPECT_CALL(m_gstPlayer, scheduleNotifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO));
     firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
     task.execute();
     EXPECT_EQ(m_context.audioBuffers.size(), 2);
@@ -97,8 +98,53 @@ TEST_F(ReadShmDataAndAttachSamplesTest, shouldAttachAllVideoSamples)
     EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
     EXPECT_CALL(m_gstPlayer, updateVideoCaps(width, height)).Times(2);
     EXPECT_CALL(m_gstPlayer, attachVideoData()).Times(2);
-    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(false, true));
+    EXPECT_CALL(m_gstPlayer, scheduleNotifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO));
     firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
     task.execute();
     EXPECT_EQ(m_context.videoBuffers.size(), 2);
 }
+
+TEST_F(ReadShmDataAndAttachSamplesTest, shouldAttachZeroCopyVideoSamples)
+{
+    m_context.shmBufferTracker =
+        std::make_shared<firebolt::rialto::server::ShmBufferTracker>([](firebolt::rialto::MediaSourceType) {});
+    firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec = buildVideoSamples();
+    EXPECT_CALL(*m_dataReader, readData()).WillOnce(Return(ByMove(std::move(dataVec))));
+    std::shared_ptr<firebolt::rialto::server::IDataReader> dataReader{m_dataReader};
+    EXPECT_CALL(m_gstPlayer, createZeroCopyBuffer(_, dataReader))
+        .Times(2)
+        .WillRepeatedly(Return(&m_gstBuffer));
+    EXPECT_CALL(m_gstPlayer, updateVideoCaps(width, height)).Times(2);
+    EXPECT_CALL(m_gstPlayer, attachVideoData()).Times(2);
+    EXPECT_CALL(m_gstPlayer, scheduleNotifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO));
+    firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
+    task.execute();
+    EXPECT_EQ(m_context.videoBuffers.size(), 2);
+}
+
+TEST_F(ReadShmDataAndAttachSamplesTest, shouldReleaseDataReaderBeforeRequestingMoreData)
+{
+    auto dataReader{std::make_shared<StrictMock<firebolt::rialto::server::DataReaderMock>>()};
+    std::weak_ptr<firebolt::rialto::server::IDataReader> weakDataReader{dataReader};
+    firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec = buildVideoSamples();
+    EXPECT_CALL(*dataReader, readData()).WillOnce(Return(ByMove(std::move(dataVec))));
+    EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
+    EXPECT_CALL(m_gstPlayer, updateVideoCaps(width, height)).Times(2);
+    EXPECT_CALL(m_gstPlayer, attachVideoData()).Times(2);
+    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(_, _)).Times(0);
+    EXPECT_CALL(m_gstPlayer, scheduleNotifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO));
+    {
+        firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, dataReader};
+        dataReader.reset();
+        task.execute();
+    }
+    EXPECT_TRUE(weakDataReader.expired());
+}
+
+TEST_F(ReadShmDataAndAttachSamplesTest, shouldNotRequestMoreDataWhenNoSamplesWereRead)
+{
+    EXPECT_CALL(*m_dataReader, readData())
+        .WillOnce(Return(ByMove(firebolt::rialto::IMediaPipeline::MediaSegmentVector{})));
+    firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
+    task.execute();
+}
@@ -25,12 +25,17 @@
 #include <gst/gst.h>
 #include <gtest/gtest.h>
 
+using testing::_;
 using testing::Invoke;
+using testing::Return;
 using testing::StrictMock;
 
 namespace
 {
 gint64 position{1234};
+guint64 audioQueuedBytes{5678};
+guint64 videoQueuedBytes{91011};
+gdouble volume{0.7};
 } // namespace
 
 class ReportPositionTest : public testing::Test
@@ -41,8 +46,17 @@ protected:
     std::shared_ptr<firebolt::rialto::server::GstWrapperMock> m_gstWrapper{
         std::make_shared<StrictMock<firebolt::rialto::server::GstWrapperMock>>()};
     GstElement m_pipeline{};
+    GstElement m_audioSrc{};
+    GstElement m_videoSrc{};
 
     ReportPositionTest() { m_context.pipeline = &m_pipeline; }
+
+    void expectReportVolume()
+    {
+        EXPECT_CALL(*m_gstWrapper, gstStreamVolumeGetVolume(_, GST_STREAM_VOLUME_FORMAT_LINEAR))
+            .WillOnce(Return(volume));
+        EXPECT_CALL(m_gstPlayerClient, notifyVolume(volume));
+    }
 };
 
 TEST_F(ReportPositionTest, shouldReportPosition)
@@ -55,6 +69,7 @@ TEST_F(ReportPositionTest, shouldReportPosition)
                 return TRUE;
             }));
     EXPECT_CALL(m_gstPlayerClient, notifyPosition(position));
+    expectReportVolume();
     firebolt::rialto::server::tasks::generic::ReportPosition task{m_context, &m_gstPlayerClient, m_gstWrapper};
     task.execute();
 }
@@ -68,6 +83,37 @@ TEST_F(ReportPositionTest, shouldFailToReportPosition)
                 *cur = -1;
                 return TRUE;
             }));
+    expectReportVolume();
+    firebolt::rialto::server::tasks::generic::ReportPosition task{m_context, &m_gstPlayerClient, m_gstWrapper};
+    task.execute();
+}
+
+TEST_F(ReportPositionTest, shouldReportBufferLevelOfAttachedSources)
+{
+    m_context.streamInfo.emplace(firebolt::rialto::MediaSourceType::AUDIO, &m_audioSrc);
+    m_context.streamInfo.emplace(firebolt::rialto::MediaSourceType::VIDEO, &m_videoSrc);
+    EXPECT_CALL(*m_gstWrapper, gstElementQueryPosition(&m_pipeline, GST_FORMAT_TIME, NotNullMatcher()))
+        .WillOnce(Invoke(
+            [this](GstElement *element, GstFormat format, gint64 *cur)
+            {
+                *cur = position;
+                return TRUE;
+            }));
+    EXPECT_CALL(m_gstPlayerClient, notifyPosition(position));
+    EXPECT_CALL(*m_gstWrapper, gstAppSrcGetCurrentLevelBytes(GST_APP_SRC(&m_audioSrc)))
+        .WillOnce(Return(audioQueuedBytes));
+    EXPECT_CALL(*m_gstWrapper, gstAppSrcGetCurrentLevelBytes(GST_APP_SRC(&m_videoSrc)))
+        .WillOnce(Return(videoQueuedBytes));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(firebolt::rialto::MediaSourceType::AUDIO, audioQueuedBytes));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(firebolt::rialto::MediaSourceType::VIDEO, videoQueuedBytes));
+    expectReportVolume();
     firebolt::rialto::server::tasks::generic::ReportPosition task{m_context, &m_gstPlayerClient, m_gstWrapper};
     task.execute();
 }
+
+TEST_F(ReportPositionTest, shouldBeLowPriorityAndCoalesced)
+{
+    firebolt::rialto::server::tasks::generic::ReportPosition task{m_context, &m_gstPlayerClient, m_gstWrapper};
+    EXPECT_EQ(task.getPriority(), firebolt::rialto::server::IPlayerTask::Priority::LOW);
+    EXPECT_EQ(task.getCoalescingKey(), firebolt::rialto::server::IPlayerTask::CoalescingKey::REPORT_POSITION);
+}
@@ -19,6 +19,7 @@
 
 #include "tasks/generic/SetVolume.h"
 #include "GenericPlayerContext.h"
+#include "GstGenericPlayerClientMock.h"
 #include "GstWrapperMock.h"
 #include <gst/gst.h>
 #include <gtest/gtest.h>
@@ -38,6 +39,7 @@ public:
     SetVolumeTest() = default;
 
     firebolt::rialto::server::GenericPlayerContext m_context;
+    StrictMock<firebolt::rialto::server::GstGenericPlayerClientMock> m_gstPlayerClient;
     std::shared_ptr<firebolt::rialto::server::GstWrapperMock> m_gstWrapper{
         std::make_shared<StrictMock<firebolt::rialto::server::GstWrapperMock>>()};
     GstElement m_pipeline{};
@@ -45,7 +47,7 @@ public:
 
 TEST_F(SetVolumeTest, shouldFailToSetVolumeWhenPipelineIsNull)
 {
-    firebolt::rialto::server::tasks::generic::SetVolume task{m_context, m_gstWrapper, kVolume};
+    firebolt::rialto::server::tasks::generic::SetVolume task{m_context, &m_gstPlayerClient, m_gstWrapper, kVolume};
     task.execute();
 }
 
@@ -53,6 +55,14 @@ TEST_F(SetVolumeTest, shouldSetVolume)
 {
     m_context.pipeline = &m_pipeline;
     EXPECT_CALL(*m_gstWrapper, gstStreamVolumeSetVolume(_, GST_STREAM_VOLUME_FORMAT_LINEAR, kVolume));
-    firebolt::rialto::server::tasks::generic::SetVolume task{m_context, m_gstWrapper, kVolume};
+    EXPECT_CALL(m_gstPlayerClient, notifyVolume(kVolume));
+    firebolt::rialto::server::tasks::generic::SetVolume task{m_context, &m_gstPlayerClient, m_gstWrapper, kVolume};
     task.execute();
 }
+
+TEST_F(SetVolumeTest, shouldBeCoalesced)
+{
+    firebolt::rialto::server::tasks::generic::SetVolume task{m_context, &m_gstPlayerClient, m_gstWrapper, kVolume};
+    EXPECT_EQ(task.getPriority(), firebolt::rialto::server::IPlayerTask::Priority::NORMAL);
+    EXPECT_EQ(task.getCoalescingKey(), firebolt::rialto::server::IPlayerTask::CoalescingKey::SET_VOLUME);
+}
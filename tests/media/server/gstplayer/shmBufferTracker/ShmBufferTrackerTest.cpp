@@ -0,0 +1,203 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmBufferTracker.h"
+#include "DataReaderMock.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::MediaSourceType;
+using firebolt::rialto::server::DataReaderMock;
+using firebolt::rialto::server::IDataReader;
+using firebolt::rialto::server::ShmBufferTracker;
+
+class ShmBufferTrackerTest : public testing::Test
+{
+protected:
+    std::vector<MediaSourceType> m_releasedRegions;
+    std::shared_ptr<IDataReader> m_slot1{std::make_shared<DataReaderMock>()};
+    std::shared_ptr<IDataReader> m_slot2{std::make_shared<DataReaderMock>()};
+    std::shared_ptr<ShmBufferTracker> m_sut{
+        std::make_shared<ShmBufferTracker>([this](MediaSourceType type) { m_releasedRegions.push_back(type); })};
+};
+
+TEST_F(ShmBufferTrackerTest, shouldNotDeferWhenNoBuffersAreTracked)
+{
+    EXPECT_FALSE(m_sut->deferUntilReleased(MediaSourceType::AUDIO));
+    EXPECT_EQ(m_sut->getBuffersInUse(MediaSourceType::AUDIO), 0);
+    EXPECT_EQ(m_sut->getSlotsInUse(MediaSourceType::AUDIO), 0);
+}
+
+TEST_F(ShmBufferTrackerTest, shouldCountTrackedBuffersPerSource)
+{
+    void *audioBuffer = m_sut->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    void *videoBuffer1 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot2);
+    void *videoBuffer2 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot2);
+    EXPECT_EQ(m_sut->getBuffersInUse(MediaSourceType::AUDIO), 1);
+    EXPECT_EQ(m_sut->getBuffersInUse(MediaSourceType::VIDEO), 2);
+
+    ShmBufferTracker::onBufferReleased(videoBuffer1);
+    EXPECT_EQ(m_sut->getBuffersInUse(MediaSourceType::VIDEO), 1);
+
+    ShmBufferTracker::onBufferReleased(audioBuffer);
+    ShmBufferTracker::onBufferReleased(videoBuffer2);
+    EXPECT_EQ(m_sut->getBuffersInUse(MediaSourceType::AUDIO), 0);
+    EXPECT_EQ(m_sut->getBuffersInUse(MediaSourceType::VIDEO), 0);
+    EXPECT_TRUE(m_releasedRegions.empty());
+}
+
+TEST_F(ShmBufferTrackerTest, shouldCountSlotsInUse)
+{
+    void *buffer1 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot1);
+    void *buffer2 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot1);
+    void *buffer3 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot2);
+    EXPECT_EQ(m_sut->getSlotsInUse(MediaSourceType::VIDEO), 2);
+
+    ShmBufferTracker::onBufferReleased(buffer1);
+    EXPECT_EQ(m_sut->getSlotsInUse(MediaSourceType::VIDEO), 2);
+    ShmBufferTracker::onBufferReleased(buffer3);
+    EXPECT_EQ(m_sut->getSlotsInUse(MediaSourceType::VIDEO), 1);
+    ShmBufferTracker::onBufferReleased(buffer2);
+    EXPECT_EQ(m_sut->getSlotsInUse(MediaSourceType::VIDEO), 0);
+}
+
+TEST_F(ShmBufferTrackerTest, shouldHoldDataReaderUntilBufferIsReleased)
+{
+    std::weak_ptr<IDataReader> weakReader{m_slot1};
+    void *buffer = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot1);
+    m_slot1.reset();
+    EXPECT_FALSE(weakReader.expired());
+
+    ShmBufferTracker::onBufferReleased(buffer);
+    EXPECT_TRUE(weakReader.expired());
+}
+
+TEST_F(ShmBufferTrackerTest, shouldNotifyWhenLastBufferOfDeferredSlotIsReleased)
+{
+    void *buffer1 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot1);
+    void *buffer2 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot1);
+    EXPECT_TRUE(m_sut->deferUntilReleased(MediaSourceType::VIDEO));
+
+    ShmBufferTracker::onBufferReleased(buffer1);
+    EXPECT_TRUE(m_releasedRegions.empty());
+
+    ShmBufferTracker::onBufferReleased(buffer2);
+    ASSERT_EQ(m_releasedRegions.size(), 1);
+    EXPECT_EQ(m_releasedRegions.front(), MediaSourceType::VIDEO);
+}
+
+TEST_F(ShmBufferTrackerTest, shouldNotifyWhenAnySlotOfDeferredSourceIsReleased)
+{
+    void *buffer1 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot1);
+    void *buffer2 = m_sut->trackBuffer(MediaSourceType::VIDEO, m_slot2);
+    EXPECT_TRUE(m_sut->deferUntilReleased(MediaSourceType::VIDEO));
+
+    ShmBufferTracker::onBufferReleased(buffer2);
+    ASSERT_EQ(m_releasedRegions.size(), 1);
+    EXPECT_EQ(m_sut->getSlotsInUse(MediaSourceType::VIDEO), 1);
+
+    ShmBufferTracker::onBufferReleased(buffer1);
+    EXPECT_EQ(m_releasedRegions.size(), 1);
+}
+
+TEST_F(ShmBufferTrackerTest, shouldReleaseDataReaderBeforeNotifying)
+{
+    std::weak_ptr<IDataReader> weakReader{m_slot1};
+    bool isReaderReleased{false};
+    std::shared_ptr<ShmBufferTracker> tracker{
+        std::make_shared<ShmBufferTracker>([&](MediaSourceType) { isReaderReleased = weakReader.expired(); })};
+    void *buffer = tracker->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    m_slot1.reset();
+    EXPECT_TRUE(tracker->deferUntilReleased(MediaSourceType::AUDIO));
+
+    ShmBufferTracker::onBufferReleased(buffer);
+    EXPECT_TRUE(isReaderReleased);
+}
+
+TEST_F(ShmBufferTrackerTest, shouldNotifyOnlyOnceAfterDeferral)
+{
+    void *buffer1 = m_sut->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    EXPECT_TRUE(m_sut->deferUntilReleased(MediaSourceType::AUDIO));
+    ShmBufferTracker::onBufferReleased(buffer1);
+
+    void *buffer2 = m_sut->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    ShmBufferTracker::onBufferReleased(buffer2);
+    EXPECT_EQ(m_releasedRegions.size(), 1);
+}
+
+TEST_F(ShmBufferTrackerTest, shouldNotNotifyWhenDetached)
+{
+    void *buffer = m_sut->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    EXPECT_TRUE(m_sut->deferUntilReleased(MediaSourceType::AUDIO));
+    m_sut->detach();
+    ShmBufferTracker::onBufferReleased(buffer);
+    EXPECT_TRUE(m_releasedRegions.empty());
+}
+
+TEST_F(ShmBufferTrackerTest, shouldCallCallbackWithoutLockAndDetachAfterItReturns)
+{
+    std::promise<void> callbackEntered;
+    std::promise<void> callbackUnblocked;
+    std::shared_future<void> unblocked{callbackUnblocked.get_future().share()};
+    std::atomic<bool> callbackReturned{false};
+    std::shared_ptr<ShmBufferTracker> tracker{std::make_shared<ShmBufferTracker>(
+        [&](MediaSourceType)
+        {
+            callbackEntered.set_value();
+            unblocked.wait();
+            callbackReturned = true;
+        })};
+    void *buffer = tracker->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    EXPECT_TRUE(tracker->deferUntilReleased(MediaSourceType::AUDIO));
+
+    std::thread streamingThread{[&]() { ShmBufferTracker::onBufferReleased(buffer); }};
+    callbackEntered.get_future().wait();
+
+    // Tracker can be used by other threads, while the callback is running
+    EXPECT_EQ(tracker->getBuffersInUse(MediaSourceType::AUDIO), 0);
+    std::thread detachThread{[&]()
+                             {
+                                 tracker->detach();
+                                 EXPECT_TRUE(callbackReturned);
+                             }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    callbackUnblocked.set_value();
+    detachThread.join();
+    streamingThread.join();
+}
+
+TEST_F(ShmBufferTrackerTest, shouldOutliveItsOwnerUntilBuffersAreReleased)
+{
+    void *buffer = m_sut->trackBuffer(MediaSourceType::AUDIO, m_slot1);
+    std::weak_ptr<ShmBufferTracker> weakTracker{m_sut};
+    m_sut.reset();
+    EXPECT_FALSE(weakTracker.expired());
+    ShmBufferTracker::onBufferReleased(buffer);
+    EXPECT_TRUE(weakTracker.expired());
+}
+
+TEST_F(ShmBufferTrackerTest, shouldIgnoreNullUserData)
+{
+    ShmBufferTracker::onBufferReleased(nullptr);
+}
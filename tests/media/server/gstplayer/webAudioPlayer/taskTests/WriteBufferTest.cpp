@@ -19,6 +19,7 @@
 
 #include "tasks/webAudio/WriteBuffer.h"
 #include "GlibWrapperMock.h"
+#include "GstWebAudioPlayerClientMock.h"
 #include "GstWebAudioPlayerPrivateMock.h"
 #include "GstWrapperMock.h"
 #include "Matchers.h"
@@ -34,6 +35,7 @@ class WebAudioWriteBufferTest : public testing::Test
 {
 protected:
     firebolt::rialto::server::WebAudioPlayerContext m_context;
+    StrictMock<firebolt::rialto::server::GstWebAudioPlayerClientMock> m_gstPlayerClient;
     std::shared_ptr<firebolt::rialto::server::GstWrapperMock> m_gstWrapper{
         std::make_shared<StrictMock<firebolt::rialto::server::GstWrapperMock>>()};
 
@@ -55,9 +57,11 @@ TEST_F(WebAudioWriteBufferTest, shouldWriteBufferForAllData)
     EXPECT_CALL(*m_gstWrapper, gstBufferFill(&m_buffer, m_mainLength, &m_wrapPtr, m_wrapLength))
         .WillOnce(Return(m_wrapLength));
     EXPECT_CALL(*m_gstWrapper, gstAppSrcPushBuffer(GST_APP_SRC(&m_appSrc), &m_buffer)).WillOnce(Return(GST_FLOW_OK));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(m_mainLength + m_wrapLength));
 
-    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,    m_gstWrapper, &m_mainPtr,
-                                                                m_mainLength, &m_wrapPtr,   m_wrapLength};
+    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,  &m_gstPlayerClient, m_gstWrapper,
+                                                                &m_mainPtr, m_mainLength,       &m_wrapPtr,
+                                                                m_wrapLength};
     task.execute();
     EXPECT_EQ(m_context.m_lastBytesWritten, m_mainLength + m_wrapLength);
 }
@@ -70,9 +74,11 @@ TEST_F(WebAudioWriteBufferTest, shouldWriteBufferForAllMainDataAndPartialWrapDat
     EXPECT_CALL(*m_gstWrapper, gstBufferFill(&m_buffer, m_mainLength, &m_wrapPtr, m_wrapLength / 2))
         .WillOnce(Return(m_wrapLength / 2));
     EXPECT_CALL(*m_gstWrapper, gstAppSrcPushBuffer(GST_APP_SRC(&m_appSrc), &m_buffer)).WillOnce(Return(GST_FLOW_OK));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(m_mainLength + m_wrapLength));
 
-    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,    m_gstWrapper, &m_mainPtr,
-                                                                m_mainLength, &m_wrapPtr,   m_wrapLength};
+    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,  &m_gstPlayerClient, m_gstWrapper,
+                                                                &m_mainPtr, m_mainLength,       &m_wrapPtr,
+                                                                m_wrapLength};
     task.execute();
     EXPECT_EQ(m_context.m_lastBytesWritten, m_mainLength + m_wrapLength / 2);
 }
@@ -84,9 +90,11 @@ TEST_F(WebAudioWriteBufferTest, shouldWriteBufferForPartialMainDataAndNoWrapData
     EXPECT_CALL(*m_gstWrapper, gstBufferNewAllocate(_, m_mainLength / 2, _)).WillOnce(Return(&m_buffer));
     EXPECT_CALL(*m_gstWrapper, gstBufferFill(&m_buffer, 0, &m_mainPtr, m_mainLength / 2)).WillOnce(Return(m_mainLength / 2));
     EXPECT_CALL(*m_gstWrapper, gstAppSrcPushBuffer(GST_APP_SRC(&m_appSrc), &m_buffer)).WillOnce(Return(GST_FLOW_OK));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(m_mainLength + m_wrapLength));
 
-    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,    m_gstWrapper, &m_mainPtr,
-                                                                m_mainLength, &m_wrapPtr,   m_wrapLength};
+    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,  &m_gstPlayerClient, m_gstWrapper,
+                                                                &m_mainPtr, m_mainLength,       &m_wrapPtr,
+                                                                m_wrapLength};
     task.execute();
     EXPECT_EQ(m_context.m_lastBytesWritten, m_mainLength / 2);
 }
@@ -95,9 +103,11 @@ TEST_F(WebAudioWriteBufferTest, shouldNotWriteBufferIfNewAllocateFails)
 {
     EXPECT_CALL(*m_gstWrapper, gstAppSrcGetCurrentLevelBytes(GST_APP_SRC(&m_appSrc))).WillOnce(Return(0));
     EXPECT_CALL(*m_gstWrapper, gstBufferNewAllocate(_, m_mainLength + m_wrapLength, _)).WillOnce(Return(nullptr));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(0));
 
-    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,    m_gstWrapper, &m_mainPtr,
-                                                                m_mainLength, &m_wrapPtr,   m_wrapLength};
+    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,  &m_gstPlayerClient, m_gstWrapper,
+                                                                &m_mainPtr, m_mainLength,       &m_wrapPtr,
+                                                                m_wrapLength};
     task.execute();
     EXPECT_EQ(m_context.m_lastBytesWritten, 0);
 }
@@ -110,9 +120,11 @@ TEST_F(WebAudioWriteBufferTest, shouldWriteBufferIfBytesWrittenLessThanExpected)
     EXPECT_CALL(*m_gstWrapper, gstBufferFill(&m_buffer, m_mainLength - 1, &m_wrapPtr, m_wrapLength))
         .WillOnce(Return(m_wrapLength));
     EXPECT_CALL(*m_gstWrapper, gstAppSrcPushBuffer(GST_APP_SRC(&m_appSrc), &m_buffer)).WillOnce(Return(GST_FLOW_OK));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(m_mainLength + m_wrapLength - 1));
 
-    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,    m_gstWrapper, &m_mainPtr,
-                                                                m_mainLength, &m_wrapPtr,   m_wrapLength};
+    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,  &m_gstPlayerClient, m_gstWrapper,
+                                                                &m_mainPtr, m_mainLength,       &m_wrapPtr,
+                                                                m_wrapLength};
     task.execute();
     EXPECT_EQ(m_context.m_lastBytesWritten, m_mainLength + m_wrapLength - 1);
 }
@@ -126,9 +138,11 @@ TEST_F(WebAudioWriteBufferTest, shouldNotWriteBufferIfPushBufferFails)
         .WillOnce(Return(m_wrapLength));
     EXPECT_CALL(*m_gstWrapper, gstAppSrcPushBuffer(GST_APP_SRC(&m_appSrc), &m_buffer)).WillOnce(Return(GST_FLOW_ERROR));
     EXPECT_CALL(*m_gstWrapper, gstBufferUnref(&m_buffer));
+    EXPECT_CALL(m_gstPlayerClient, notifyBufferLevel(0));
 
-    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,    m_gstWrapper, &m_mainPtr,
-                                                                m_mainLength, &m_wrapPtr,   m_wrapLength};
+    firebolt::rialto::server::tasks::webaudio::WriteBuffer task{m_context,  &m_gstPlayerClient, m_gstWrapper,
+                                                                &m_mainPtr, m_mainLength,       &m_wrapPtr,
+                                                                m_wrapLength};
     task.execute();
     EXPECT_EQ(m_context.m_lastBytesWritten, 0);
 }
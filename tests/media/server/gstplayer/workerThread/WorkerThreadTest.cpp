@@ -20,13 +20,103 @@
 #include "WorkerThread.h"
 #include "PlayerTaskMock.h"
 #include <condition_variable>
+#include <functional>
 #include <gtest/gtest.h>
 #include <mutex>
+#include <string>
+#include <vector>
 
+using firebolt::rialto::server::IPlayerTask;
+using firebolt::rialto::server::IWorkerThread;
 using firebolt::rialto::server::PlayerTaskMock;
+using testing::ElementsAre;
 using testing::Invoke;
 using testing::StrictMock;
 
+namespace
+{
+class TestTask : public IPlayerTask
+{
+public:
+    TestTask(std::function<void()> &&callback, Priority priority = Priority::NORMAL,
+             CoalescingKey coalescingKey = CoalescingKey::NONE)
+        : m_callback{std::move(callback)}, m_priority{priority}, m_coalescingKey{coalescingKey}
+    {
+    }
+
+    void execute() const override { m_callback(); }
+    Priority getPriority() const override { return m_priority; }
+    CoalescingKey getCoalescingKey() const override { return m_coalescingKey; }
+
+private:
+    std::function<void()> m_callback;
+    Priority m_priority;
+    CoalescingKey m_coalescingKey;
+};
+
+class WorkerThreadOrderingTest : public testing::Test
+{
+protected:
+    std::unique_ptr<IWorkerThread> m_sut{firebolt::rialto::server::WorkerThreadFactory().createWorkerThread()};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_isBlocked{false};
+    bool m_isReleased{false};
+    bool m_isFinished{false};
+    std::vector<std::string> m_executed;
+
+    void blockWorker()
+    {
+        m_sut->enqueueTask(std::make_unique<TestTask>(
+            [this]()
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_isBlocked = true;
+                m_cv.notify_all();
+                m_cv.wait(lock, [this]() { return m_isReleased; });
+            }));
+        std::unique_lock<std::mutex> lock{m_mutex};
+        ASSERT_TRUE(m_cv.wait_for(lock, std::chrono::seconds(1), [this]() { return m_isBlocked; }));
+    }
+
+    std::unique_ptr<IPlayerTask> createTask(const std::string &name,
+                                            IPlayerTask::Priority priority = IPlayerTask::Priority::NORMAL,
+                                            IPlayerTask::CoalescingKey key = IPlayerTask::CoalescingKey::NONE)
+    {
+        return std::make_unique<TestTask>(
+            [this, name]()
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_executed.push_back(name);
+            },
+            priority, key);
+    }
+
+    void releaseWorkerAndWaitForQueuedTasks()
+    {
+        m_sut->enqueueTask(std::make_unique<TestTask>(
+            [this]()
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_isFinished = true;
+                m_cv.notify_all();
+            },
+            IPlayerTask::Priority::LOW));
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isReleased = true;
+        m_cv.notify_all();
+        ASSERT_TRUE(m_cv.wait_for(lock, std::chrono::seconds(1), [this]() { return m_isFinished; }));
+    }
+
+    void TearDown() override
+    {
+        IWorkerThread *worker{m_sut.get()};
+        m_sut->enqueueTask(std::make_unique<TestTask>([worker]() { worker->stop(); }, IPlayerTask::Priority::LOW));
+        m_sut.reset();
+    }
+};
+} // namespace
+
 TEST(WorkerThreadTest, shouldEnqueueTaskAndExit)
 {
     std::mutex m_taskMutex;
@@ -55,3 +145,32 @@ TEST(WorkerThreadTest, shouldEnqueueTaskAndExit)
 
     // sut.reset();
 }
+
+TEST_F(WorkerThreadOrderingTest, shouldExecuteOnlyTheLatestTaskOfCoalescingKey)
+{
+    blockWorker();
+    m_sut->enqueueTask(createTask("volume1", IPlayerTask::Priority::NORMAL, IPlayerTask::CoalescingKey::SET_VOLUME));
+    m_sut->enqueueTask(createTask("play"));
+    m_sut->enqueueTask(createTask("volume2", IPlayerTask::Priority::NORMAL, IPlayerTask::CoalescingKey::SET_VOLUME));
+    releaseWorkerAndWaitForQueuedTasks();
+
+    EXPECT_THAT(m_executed, ElementsAre("play", "volume2"));
+    const IWorkerThread::Metrics kMetrics{m_sut->getMetrics()};
+    EXPECT_EQ(kMetrics.coalescedTasks, 1u);
+    EXPECT_EQ(kMetrics.executedTasks, 4u);
+    EXPECT_EQ(kMetrics.queueDepth, 0u);
+    EXPECT_EQ(kMetrics.maxQueueDepth, 4u);
+}
+
+TEST_F(WorkerThreadOrderingTest, shouldExecuteNormalPriorityTasksBeforeLowPriorityTasks)
+{
+    blockWorker();
+    m_sut->enqueueTask(createTask("position1", IPlayerTask::Priority::LOW));
+    m_sut->enqueueTask(createTask("pause"));
+    m_sut->enqueueTask(createTask("position2", IPlayerTask::Priority::LOW));
+    m_sut->enqueueTask(createTask("play"));
+    releaseWorkerAndWaitForQueuedTasks();
+
+    EXPECT_THAT(m_executed, ElementsAre("pause", "play", "position1", "position2"));
+    EXPECT_EQ(m_sut->getMetrics().coalescedTasks, 0u);
+}
@@ -63,6 +63,14 @@ TEST_F(MediaKeysModuleServiceTests, shouldDestroyMediaKeys)
     sendDestroyMediaKeysRequestAndReceiveResponse();
 }
 
+TEST_F(MediaKeysModuleServiceTests, shouldDestroyMediaKeysOnSessionExecutor)
+{
+    cdmServiceWillCreateMediaKeys();
+    int mediaKeysHandle = sendCreateMediaKeysRequestAndReceiveResponse();
+    cdmServiceWillDestroyMediaKeysOnSessionExecutor(mediaKeysHandle);
+    sendDestroyMediaKeysRequestAndReceiveResponse(mediaKeysHandle);
+}
+
 TEST_F(MediaKeysModuleServiceTests, shouldFailToDestroyMediaKeysDueToInvalidIpc)
 {
     expectInvalidControllerRequestFailure();
@@ -135,6 +143,14 @@ TEST_F(MediaKeysModuleServiceTests, shouldCloseKeySession)
     sendCloseKeySessionRequestAndReceiveResponse();
 }
 
+TEST_F(MediaKeysModuleServiceTests, shouldCloseKeySessionOnSessionExecutor)
+{
+    cdmServiceWillCreateMediaKeys();
+    int mediaKeysHandle = sendCreateMediaKeysRequestAndReceiveResponse();
+    cdmServiceWillCloseKeySessionOnSessionExecutor(mediaKeysHandle);
+    sendCloseKeySessionRequestAndReceiveResponse(mediaKeysHandle);
+}
+
 TEST_F(MediaKeysModuleServiceTests, shouldFailToCloseKeySession)
 {
     cdmServiceWillFailToCloseKeySession();
@@ -37,6 +37,7 @@ namespace
 {
 const std::string keySystem{"expectedKeySystem"};
 constexpr int hardcodedMediaKeysHandle{2};
+constexpr int32_t kSessionExecutorId{7};
 constexpr firebolt::rialto::KeySessionType keySessionType{firebolt::rialto::KeySessionType::TEMPORARY};
 constexpr bool isLDL{false};
 constexpr int keySessionId{3};
@@ -184,9 +185,13 @@ MediaKeysModuleServiceTests::MediaKeysModuleServiceTests()
       m_serverMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ServerMock>>()},
       m_closureMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ClosureMock>>()},
       m_controllerMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ControllerMock>>()},
-      m_invalidControllerMock{std::make_shared<StrictMock<firebolt::rialto::ipc::RpcControllerMock>>()}
+      m_invalidControllerMock{std::make_shared<StrictMock<firebolt::rialto::ipc::RpcControllerMock>>()},
+      m_mainThreadFactoryMock{std::make_shared<StrictMock<firebolt::rialto::server::mock::MainThreadFactoryMock>>()},
+      m_mainThreadMock{std::make_shared<StrictMock<firebolt::rialto::server::mock::MainThreadMock>>()}
 {
-    m_service = std::make_shared<firebolt::rialto::server::ipc::MediaKeysModuleService>(m_cdmServiceMock);
+    EXPECT_CALL(*m_mainThreadFactoryMock, getMainThread()).WillOnce(Return(m_mainThreadMock));
+    m_service = std::make_shared<firebolt::rialto::server::ipc::MediaKeysModuleService>(m_cdmServiceMock,
+                                                                                        m_mainThreadFactoryMock);
     m_client = std::make_shared<firebolt::rialto::server::ipc::MediaKeysClient>(hardcodedMediaKeysHandle, m_clientMock);
 }
 
@@ -199,12 +204,15 @@ void MediaKeysModuleServiceTests::clientWillConnect()
 
 void MediaKeysModuleServiceTests::clientWillDisconnect()
 {
+    EXPECT_CALL(*m_mainThreadMock, enqueueTaskAndWait(kSessionExecutorId, _))
+        .WillOnce(Invoke([](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task) { task(); }));
     EXPECT_CALL(m_cdmServiceMock, destroyMediaKeys(hardcodedMediaKeysHandle));
 }
 
 void MediaKeysModuleServiceTests::cdmServiceWillCreateMediaKeys()
 {
     expectRequestSuccess();
+    mainThreadWillCreateSessionExecutor();
     EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
     EXPECT_CALL(m_cdmServiceMock, createMediaKeys(_, keySystem)).WillOnce(Return(true));
 }
@@ -212,6 +220,8 @@ void MediaKeysModuleServiceTests::cdmServiceWillCreateMediaKeys()
 void MediaKeysModuleServiceTests::cdmServiceWillFailToCreateMediaKeys()
 {
     expectRequestFailure();
+    mainThreadWillCreateSessionExecutor();
+    mainThreadWillEnqueueTask();
     EXPECT_CALL(m_cdmServiceMock, createMediaKeys(_, keySystem)).WillOnce(Return(false));
 }
 
@@ -222,6 +232,14 @@ void MediaKeysModuleServiceTests::cdmServiceWillDestroyMediaKeys()
     EXPECT_CALL(m_cdmServiceMock, destroyMediaKeys(hardcodedMediaKeysHandle)).WillOnce(Return(true));
 }
 
+void MediaKeysModuleServiceTests::cdmServiceWillDestroyMediaKeysOnSessionExecutor(int mediaKeysHandle)
+{
+    expectRequestSuccess();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
+    EXPECT_CALL(m_cdmServiceMock, destroyMediaKeys(mediaKeysHandle)).WillOnce(Return(true));
+}
+
 void MediaKeysModuleServiceTests::cdmServiceWillFailToDestroyMediaKeys()
 {
     expectRequestFailure();
@@ -292,6 +310,14 @@ void MediaKeysModuleServiceTests::cdmServiceWillCloseKeySession()
         .WillOnce(Return(firebolt::rialto::MediaKeyErrorStatus::OK));
 }
 
+void MediaKeysModuleServiceTests::cdmServiceWillCloseKeySessionOnSessionExecutor(int mediaKeysHandle)
+{
+    expectRequestSuccess();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(m_cdmServiceMock, closeKeySession(mediaKeysHandle, keySessionId))
+        .WillOnce(Return(firebolt::rialto::MediaKeyErrorStatus::OK));
+}
+
 void MediaKeysModuleServiceTests::cdmServiceWillFailToCloseKeySession()
 {
     expectRequestSuccess();
@@ -520,11 +546,16 @@ void MediaKeysModuleServiceTests::sendCreateMediaKeysRequestAndExpectFailure()
 }
 
 void MediaKeysModuleServiceTests::sendDestroyMediaKeysRequestAndReceiveResponse()
+{
+    sendDestroyMediaKeysRequestAndReceiveResponse(hardcodedMediaKeysHandle);
+}
+
+void MediaKeysModuleServiceTests::sendDestroyMediaKeysRequestAndReceiveResponse(int mediaKeysHandle)
 {
     firebolt::rialto::DestroyMediaKeysRequest request;
     firebolt::rialto::DestroyMediaKeysResponse response;
 
-    request.set_media_keys_handle(hardcodedMediaKeysHandle);
+    request.set_media_keys_handle(mediaKeysHandle);
 
     m_service->destroyMediaKeys(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
@@ -674,11 +705,16 @@ void MediaKeysModuleServiceTests::sendUpdateSessionRequestAndReceiveErrorRespons
 }
 
 void MediaKeysModuleServiceTests::sendCloseKeySessionRequestAndReceiveResponse()
+{
+    sendCloseKeySessionRequestAndReceiveResponse(hardcodedMediaKeysHandle);
+}
+
+void MediaKeysModuleServiceTests::sendCloseKeySessionRequestAndReceiveResponse(int mediaKeysHandle)
 {
     firebolt::rialto::CloseKeySessionRequest request;
     firebolt::rialto::CloseKeySessionResponse response;
 
-    request.set_media_keys_handle(hardcodedMediaKeysHandle);
+    request.set_media_keys_handle(mediaKeysHandle);
     request.set_key_session_id(keySessionId);
 
     m_service->closeKeySession(m_controllerMock.get(), &request, &response, m_closureMock.get());
@@ -991,6 +1027,21 @@ void MediaKeysModuleServiceTests::expectRequestFailure()
     EXPECT_CALL(*m_closureMock, Run());
 }
 
+void MediaKeysModuleServiceTests::mainThreadWillCreateSessionExecutor()
+{
+    EXPECT_CALL(*m_mainThreadMock, registerClient()).WillOnce(Return(kSessionExecutorId));
+    mainThreadWillEnqueueTask();
+    // The executor is released when the media keys are destroyed, or when the module service is destructed
+    EXPECT_CALL(*m_mainThreadMock, unregisterClient(kSessionExecutorId));
+}
+
+void MediaKeysModuleServiceTests::mainThreadWillEnqueueTask()
+{
+    EXPECT_CALL(*m_mainThreadMock, enqueueTask(kSessionExecutorId, _))
+        .WillOnce(Invoke([](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task) { task(); }))
+        .RetiresOnSaturation();
+}
+
 void MediaKeysModuleServiceTests::expectInvalidControllerRequestFailure()
 {
     EXPECT_CALL(*m_invalidControllerMock, SetFailed(_));
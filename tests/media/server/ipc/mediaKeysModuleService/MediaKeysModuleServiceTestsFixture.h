@@ -27,6 +27,8 @@
 #include "IpcClientMock.h"
 #include "IpcControllerMock.h"
 #include "IpcServerMock.h"
+#include "MainThreadFactoryMock.h"
+#include "MainThreadMock.h"
 #include "RpcControllerMock.h"
 #include <gtest/gtest.h>
 #include <memory>
@@ -44,6 +46,7 @@ public:
     void cdmServiceWillCreateMediaKeys();
     void cdmServiceWillFailToCreateMediaKeys();
     void cdmServiceWillDestroyMediaKeys();
+    void cdmServiceWillDestroyMediaKeysOnSessionExecutor(int mediaKeysHandle);
     void cdmServiceWillFailToDestroyMediaKeys();
     void cdmServiceWillCreateKeySession();
     void cdmServiceWillFailToCreateKeySession();
@@ -54,6 +57,7 @@ public:
     void cdmServiceWillUpdateSession();
     void cdmServiceWillFailToUpdateSession();
     void cdmServiceWillCloseKeySession();
+    void cdmServiceWillCloseKeySessionOnSessionExecutor(int mediaKeysHandle);
     void cdmServiceWillFailToCloseKeySession();
     void cdmServiceWillRemoveKeySession();
     void cdmServiceWillFailToRemoveKeySession();
@@ -88,6 +92,7 @@ public:
     void sendCreateMediaKeysRequestWithInvalidIpcAndReceiveFailedResponse();
     void sendCreateMediaKeysRequestAndExpectFailure();
     void sendDestroyMediaKeysRequestAndReceiveResponse();
+    void sendDestroyMediaKeysRequestAndReceiveResponse(int mediaKeysHandle);
     void sendDestroyMediaKeysRequestWithInvalidIpcAndReceiveFailedResponse();
     void sendCreateKeySessionRequestAndReceiveResponse();
     void sendCreateKeySessionRequestAndReceiveErrorResponse();
@@ -99,6 +104,7 @@ public:
     void sendUpdateSessionRequestAndReceiveResponse();
     void sendUpdateSessionRequestAndReceiveErrorResponse();
     void sendCloseKeySessionRequestAndReceiveResponse();
+    void sendCloseKeySessionRequestAndReceiveResponse(int mediaKeysHandle);
     void sendCloseKeySessionRequestAndReceiveErrorResponse();
     void sendRemoveKeySessionRequestAndReceiveResponse();
     void sendRemoveKeySessionRequestAndReceiveErrorResponse();
@@ -135,6 +141,8 @@ private:
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ClosureMock>> m_closureMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ControllerMock>> m_controllerMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::RpcControllerMock>> m_invalidControllerMock;
+    std::shared_ptr<StrictMock<firebolt::rialto::server::mock::MainThreadFactoryMock>> m_mainThreadFactoryMock;
+    std::shared_ptr<StrictMock<firebolt::rialto::server::mock::MainThreadMock>> m_mainThreadMock;
     StrictMock<firebolt::rialto::server::service::CdmServiceMock> m_cdmServiceMock;
     std::shared_ptr<firebolt::rialto::server::ipc::IMediaKeysModuleService> m_service;
     std::shared_ptr<firebolt::rialto::IMediaKeysClient> m_client;
@@ -142,6 +150,8 @@ private:
 
     void expectRequestSuccess();
     void expectRequestFailure();
+    void mainThreadWillCreateSessionExecutor();
+    void mainThreadWillEnqueueTask();
 
     void createKeyStatusVector();
 };
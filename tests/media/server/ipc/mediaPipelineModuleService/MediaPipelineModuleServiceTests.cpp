@@ -51,6 +51,14 @@ TEST_F(MediaPipelineModuleServiceTests, shouldDestroySessionWhenDisconnectClient
     sendClientDisconnected();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldDestroySessionOnSessionExecutor)
+{
+    mediaPipelineServiceWillCreateSession();
+    int sessionId = sendCreateSessionRequestAndReceiveResponse();
+    mediaPipelineServiceWillDestroySessionOnSessionExecutor(sessionId);
+    sendDestroySessionRequestAndReceiveResponse(sessionId);
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldDestroySession)
 {
     mediaPipelineServiceWillDestroySession();
@@ -99,6 +107,14 @@ TEST_F(MediaPipelineModuleServiceTests, shouldPlay)
     sendPlayRequestAndReceiveResponse();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldPlayOnSessionExecutor)
+{
+    mediaPipelineServiceWillCreateSession();
+    int sessionId = sendCreateSessionRequestAndReceiveResponse();
+    mediaPipelineServiceWillPlayOnSessionExecutor(sessionId);
+    sendPlayRequestAndReceiveResponse(sessionId);
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldFailToPlay)
 {
     mediaPipelineServiceWillFailToPlay();
@@ -153,6 +169,18 @@ TEST_F(MediaPipelineModuleServiceTests, shouldFailWhenHaveDataIsReceived)
     sendHaveDataRequestAndReceiveResponse();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldHaveDataWithoutReply)
+{
+    mediaPipelineServiceWillHaveDataWithoutReply();
+    sendHaveDataNoReplyRequest();
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldSendErrorEventWhenHaveDataWithoutReplyFails)
+{
+    mediaPipelineServiceWillFailToHaveDataWithoutReply();
+    sendHaveDataNoReplyRequest();
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldSetPlaybackRate)
 {
     mediaPipelineServiceWillSetPlaybackRate();
@@ -193,6 +221,18 @@ TEST_F(MediaPipelineModuleServiceTests, shouldFailToGetPosition)
     sendGetPositionRequestAndReceiveResponseWithoutPositionMatch();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldGetPositionFromSnapshotWhileTaskIsQueuedOnSessionExecutor)
+{
+    mediaPipelineServiceWillCreateSession();
+    int sessionId = sendCreateSessionRequestAndReceiveResponse();
+    mainThreadWillQueueTaskWithoutRunningIt();
+    sendPlayRequestAndReceiveResponse(sessionId);
+    mediaPipelineServiceWillGetPositionFromSnapshot(sessionId);
+    sendGetPositionRequestAndReceiveResponse(sessionId);
+    mediaPipelineServiceWillPlayQueuedTask(sessionId);
+    runQueuedTask();
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldSendPlaybackStateChangedEvent)
 {
     mediaPipelineServiceWillCreateSession();
@@ -267,8 +307,26 @@ TEST_F(MediaPipelineModuleServiceTests, shouldGetVolume)
     sendGetVolumeRequestAndReceiveResponse();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldGetVolumeFromSnapshotWhileTaskIsQueuedOnSessionExecutor)
+{
+    mediaPipelineServiceWillCreateSession();
+    int sessionId = sendCreateSessionRequestAndReceiveResponse();
+    mainThreadWillQueueTaskWithoutRunningIt();
+    sendPlayRequestAndReceiveResponse(sessionId);
+    mediaPipelineServiceWillGetVolumeFromSnapshot(sessionId);
+    sendGetVolumeRequestAndReceiveResponse(sessionId);
+    mediaPipelineServiceWillPlayQueuedTask(sessionId);
+    runQueuedTask();
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldFailToGetVolume)
 {
     mediaPipelineServiceWillFailToGetVolume();
     sendGetVolumeRequestAndReceiveResponseWithoutVolumeMatch();
 }
+
+TEST_F(MediaPipelineModuleServiceTests, shouldCreateSessionWithoutStatusPage)
+{
+    mediaPipelineServiceWillCreateSessionWithoutStatusPage();
+    sendCreateSessionRequestAndReceiveResponseWithoutStatusPage();
+}
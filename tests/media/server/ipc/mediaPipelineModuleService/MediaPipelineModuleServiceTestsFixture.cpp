@@ -39,6 +39,7 @@ constexpr firebolt::rialto::MediaSourceType mediaSourceType{firebolt::rialto::Me
 constexpr std::uint32_t width{1920};
 constexpr std::uint32_t height{1080};
 constexpr int hardcodedSessionId{2};
+constexpr int32_t kSessionExecutorId{7};
 const firebolt::rialto::MediaType mediaType{firebolt::rialto::MediaType::MSE};
 const std::string mimeType{"exampleMimeType"};
 constexpr uint32_t numberOfChannels{6};
@@ -57,12 +58,13 @@ constexpr std::uint64_t sourceId{12};
 constexpr size_t frameCount{5};
 constexpr std::uint32_t maxBytes{2};
 constexpr std::uint32_t needDataRequestId{32};
-constexpr firebolt::rialto::MediaPlayerShmInfo shmInfo{15, 16, 17};
+constexpr firebolt::rialto::MediaPlayerShmInfo shmInfo{15, 16, 17, 18, 3};
 constexpr firebolt::rialto::PlaybackState playbackState{firebolt::rialto::PlaybackState::PLAYING};
 constexpr firebolt::rialto::NetworkState networkState{firebolt::rialto::NetworkState::BUFFERED};
 constexpr firebolt::rialto::QosInfo qosInfo{5u, 2u};
 constexpr double rate{1.5};
 constexpr double volume{0.7};
+constexpr std::uint32_t statusPageOffset{16 * 1024 * 1024};
 } // namespace
 
 MATCHER_P(AttachedSourceMatcher, source, "")
@@ -106,7 +108,8 @@ MATCHER_P6(NeedMediaDataEventMatcher, sessionId, sourceId, needDataRequestId, fr
             (shmInfo->maxMetadataBytes == event->shm_info().max_metadata_bytes()) &&
             (shmInfo->metadataOffset == event->shm_info().metadata_offset()) &&
             (shmInfo->mediaDataOffset == event->shm_info().media_data_offset()) &&
-            (shmInfo->maxMediaBytes == event->shm_info().max_media_bytes()));
+            (shmInfo->maxMediaBytes == event->shm_info().max_media_bytes()) &&
+            (shmInfo->maxMetadataVersion == event->shm_info().max_metadata_version()));
 }
 
 MATCHER_P(PositionChangeEventMatcher, position, "")
@@ -123,6 +126,13 @@ MATCHER_P3(QosEventMatcher, sourceId, processed, dropped, "")
             (dropped == event->qos_info().dropped()));
 }
 
+MATCHER_P2(HaveDataErrorEventMatcher, sessionId, requestId, "")
+{
+    std::shared_ptr<firebolt::rialto::HaveDataErrorEvent> event =
+        std::dynamic_pointer_cast<firebolt::rialto::HaveDataErrorEvent>(arg);
+    return (event && (sessionId == event->session_id()) && (requestId == event->request_id()));
+}
+
 MATCHER_P(PlaybackStateChangeEventMatcher, playbackState, "")
 {
     std::shared_ptr<firebolt::rialto::PlaybackStateChangeEvent> event =
@@ -313,9 +323,13 @@ MediaPipelineModuleServiceTests::MediaPipelineModuleServiceTests()
     : m_clientMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ClientMock>>()},
       m_serverMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ServerMock>>()},
       m_closureMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ClosureMock>>()},
-      m_controllerMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ControllerMock>>()}
+      m_controllerMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ControllerMock>>()},
+      m_mainThreadFactoryMock{std::make_shared<StrictMock<firebolt::rialto::server::mock::MainThreadFactoryMock>>()},
+      m_mainThreadMock{std::make_shared<StrictMock<firebolt::rialto::server::mock::MainThreadMock>>()}
 {
-    m_service = std::make_shared<firebolt::rialto::server::ipc::MediaPipelineModuleService>(m_mediaPipelineServiceMock);
+    EXPECT_CALL(*m_mainThreadFactoryMock, getMainThread()).WillOnce(Return(m_mainThreadMock));
+    m_service = std::make_shared<firebolt::rialto::server::ipc::MediaPipelineModuleService>(m_mediaPipelineServiceMock,
+                                                                                            m_mainThreadFactoryMock);
 }
 
 MediaPipelineModuleServiceTests::~MediaPipelineModuleServiceTests() {}
@@ -327,20 +341,37 @@ void MediaPipelineModuleServiceTests::clientWillConnect()
 
 void MediaPipelineModuleServiceTests::clientWillDisconnect()
 {
+    EXPECT_CALL(*m_mainThreadMock, enqueueTaskAndWait(kSessionExecutorId, _))
+        .WillOnce(Invoke([](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task) { task(); }));
     EXPECT_CALL(m_mediaPipelineServiceMock, destroySession(hardcodedSessionId));
 }
 
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillCreateSession()
 {
     expectRequestSuccess();
-    EXPECT_CALL(*m_controllerMock, getClient()).Times(2).WillRepeatedly(Return(m_clientMock));
+    mainThreadWillCreateSessionExecutor();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
+    EXPECT_CALL(m_mediaPipelineServiceMock, createSession(_, _, width, height))
+        .WillOnce(DoAll(SaveArg<1>(&m_mediaPipelineClient), Return(true)));
+    EXPECT_CALL(m_mediaPipelineServiceMock, getStatusPageOffset(_, _))
+        .WillOnce(DoAll(SetArgReferee<1>(statusPageOffset), Return(true)));
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillCreateSessionWithoutStatusPage()
+{
+    expectRequestSuccess();
+    mainThreadWillCreateSessionExecutor();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
     EXPECT_CALL(m_mediaPipelineServiceMock, createSession(_, _, width, height))
         .WillOnce(DoAll(SaveArg<1>(&m_mediaPipelineClient), Return(true)));
+    EXPECT_CALL(m_mediaPipelineServiceMock, getStatusPageOffset(_, _)).WillOnce(Return(false));
 }
 
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToCreateSession()
 {
     expectRequestFailure();
+    mainThreadWillCreateSessionExecutor();
+    mainThreadWillEnqueueTask();
     EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
     EXPECT_CALL(m_mediaPipelineServiceMock, createSession(_, _, width, height)).WillOnce(Return(false));
 }
@@ -407,6 +438,21 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillPlay()
     EXPECT_CALL(m_mediaPipelineServiceMock, play(hardcodedSessionId)).WillOnce(Return(true));
 }
 
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillPlayOnSessionExecutor(int sessionId)
+{
+    expectRequestSuccess();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(m_mediaPipelineServiceMock, play(sessionId)).WillOnce(Return(true));
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillDestroySessionOnSessionExecutor(int sessionId)
+{
+    expectRequestSuccess();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
+    EXPECT_CALL(m_mediaPipelineServiceMock, destroySession(sessionId)).WillOnce(Return(true));
+}
+
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToPlay()
 {
     expectRequestFailure();
@@ -475,6 +521,24 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToHaveData()
         .WillOnce(Return(false));
 }
 
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillHaveDataWithoutReply()
+{
+    expectRequestSuccess();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
+    EXPECT_CALL(m_mediaPipelineServiceMock, haveData(hardcodedSessionId, mediaSourceStatus, numFrames, requestId))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_clientMock, sendEvent(_)).Times(0);
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToHaveDataWithoutReply()
+{
+    expectRequestSuccess();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
+    EXPECT_CALL(m_mediaPipelineServiceMock, haveData(hardcodedSessionId, mediaSourceStatus, numFrames, requestId))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*m_clientMock, sendEvent(HaveDataErrorEventMatcher(hardcodedSessionId, requestId)));
+}
+
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillSetPlaybackRate()
 {
     expectRequestSuccess();
@@ -490,6 +554,7 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToSetPlaybackR
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillGetPosition()
 {
     expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock, getPositionFromSnapshot(hardcodedSessionId, _)).WillOnce(Return(false));
     EXPECT_CALL(m_mediaPipelineServiceMock, getPosition(hardcodedSessionId, _))
         .WillOnce(Invoke(
             [&](int, std::int64_t &pos)
@@ -502,9 +567,17 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillGetPosition()
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToGetPosition()
 {
     expectRequestFailure();
+    EXPECT_CALL(m_mediaPipelineServiceMock, getPositionFromSnapshot(hardcodedSessionId, _)).WillOnce(Return(false));
     EXPECT_CALL(m_mediaPipelineServiceMock, getPosition(hardcodedSessionId, _)).WillOnce(Return(false));
 }
 
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillGetPositionFromSnapshot(int sessionId)
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock, getPositionFromSnapshot(sessionId, _))
+        .WillOnce(DoAll(SetArgReferee<1>(position), Return(true)));
+}
+
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillRenderFrame()
 {
     expectRequestSuccess();
@@ -532,6 +605,7 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToSetVolume()
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillGetVolume()
 {
     expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock, getVolumeFromSnapshot(hardcodedSessionId, _)).WillOnce(Return(false));
     EXPECT_CALL(m_mediaPipelineServiceMock, getVolume(hardcodedSessionId, _))
         .WillOnce(Invoke(
             [&](int, double &vol)
@@ -544,9 +618,23 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillGetVolume()
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToGetVolume()
 {
     expectRequestFailure();
+    EXPECT_CALL(m_mediaPipelineServiceMock, getVolumeFromSnapshot(hardcodedSessionId, _)).WillOnce(Return(false));
     EXPECT_CALL(m_mediaPipelineServiceMock, getVolume(hardcodedSessionId, _)).WillOnce(Return(false));
 }
 
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillGetVolumeFromSnapshot(int sessionId)
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock, getVolumeFromSnapshot(sessionId, _))
+        .WillOnce(DoAll(SetArgReferee<1>(volume), Return(true)));
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillPlayQueuedTask(int sessionId)
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock, play(sessionId)).WillOnce(Return(true));
+}
+
 void MediaPipelineModuleServiceTests::mediaClientWillSendPlaybackStateChangedEvent()
 {
     EXPECT_CALL(*m_clientMock, sendEvent(PlaybackStateChangeEventMatcher(convertPlaybackState(playbackState))));
@@ -599,10 +687,25 @@ int MediaPipelineModuleServiceTests::sendCreateSessionRequestAndReceiveResponse(
 
     m_service->createSession(m_controllerMock.get(), &request, &response, m_closureMock.get());
     EXPECT_GE(response.session_id(), 0);
+    EXPECT_TRUE(response.has_status_page_offset());
+    EXPECT_EQ(response.status_page_offset(), statusPageOffset);
 
     return response.session_id();
 }
 
+void MediaPipelineModuleServiceTests::sendCreateSessionRequestAndReceiveResponseWithoutStatusPage()
+{
+    firebolt::rialto::CreateSessionRequest request;
+    firebolt::rialto::CreateSessionResponse response;
+
+    request.set_max_width(width);
+    request.set_max_height(height);
+
+    m_service->createSession(m_controllerMock.get(), &request, &response, m_closureMock.get());
+    EXPECT_GE(response.session_id(), 0);
+    EXPECT_FALSE(response.has_status_page_offset());
+}
+
 void MediaPipelineModuleServiceTests::sendCreateSessionRequestAndExpectFailure()
 {
     firebolt::rialto::CreateSessionRequest request;
@@ -615,11 +718,16 @@ void MediaPipelineModuleServiceTests::sendCreateSessionRequestAndExpectFailure()
 }
 
 void MediaPipelineModuleServiceTests::sendDestroySessionRequestAndReceiveResponse()
+{
+    sendDestroySessionRequestAndReceiveResponse(hardcodedSessionId);
+}
+
+void MediaPipelineModuleServiceTests::sendDestroySessionRequestAndReceiveResponse(int sessionId)
 {
     firebolt::rialto::DestroySessionRequest request;
     firebolt::rialto::DestroySessionResponse response;
 
-    request.set_session_id(hardcodedSessionId);
+    request.set_session_id(sessionId);
 
     m_service->destroySession(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
@@ -667,11 +775,16 @@ void MediaPipelineModuleServiceTests::sendAttachAudioSourceWithAdditionalDataReq
 }
 
 void MediaPipelineModuleServiceTests::sendPlayRequestAndReceiveResponse()
+{
+    sendPlayRequestAndReceiveResponse(hardcodedSessionId);
+}
+
+void MediaPipelineModuleServiceTests::sendPlayRequestAndReceiveResponse(int sessionId)
 {
     firebolt::rialto::PlayRequest request;
     firebolt::rialto::PlayResponse response;
 
-    request.set_session_id(hardcodedSessionId);
+    request.set_session_id(sessionId);
 
     m_service->play(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
@@ -708,11 +821,16 @@ void MediaPipelineModuleServiceTests::sendSetPositionRequestAndReceiveResponse()
 }
 
 void MediaPipelineModuleServiceTests::sendGetPositionRequestAndReceiveResponse()
+{
+    sendGetPositionRequestAndReceiveResponse(hardcodedSessionId);
+}
+
+void MediaPipelineModuleServiceTests::sendGetPositionRequestAndReceiveResponse(int sessionId)
 {
     firebolt::rialto::GetPositionRequest request;
     firebolt::rialto::GetPositionResponse response;
 
-    request.set_session_id(hardcodedSessionId);
+    request.set_session_id(sessionId);
 
     m_service->getPosition(m_controllerMock.get(), &request, &response, m_closureMock.get());
 
@@ -742,6 +860,18 @@ void MediaPipelineModuleServiceTests::sendHaveDataRequestAndReceiveResponse()
     m_service->haveData(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
 
+void MediaPipelineModuleServiceTests::sendHaveDataNoReplyRequest()
+{
+    firebolt::rialto::HaveDataRequest request;
+
+    request.set_session_id(hardcodedSessionId);
+    request.set_status(convertHaveDataRequestMediaSourceStatus(mediaSourceStatus));
+    request.set_num_frames(numFrames);
+    request.set_request_id(requestId);
+
+    m_service->haveDataNoReply(m_controllerMock.get(), &request, nullptr, m_closureMock.get());
+}
+
 void MediaPipelineModuleServiceTests::sendSetPlaybackRateRequestAndReceiveResponse()
 {
     firebolt::rialto::SetPlaybackRateRequest request;
@@ -779,11 +909,16 @@ void MediaPipelineModuleServiceTests::sendSetVolumeRequestAndReceiveResponse()
 }
 
 void MediaPipelineModuleServiceTests::sendGetVolumeRequestAndReceiveResponse()
+{
+    sendGetVolumeRequestAndReceiveResponse(hardcodedSessionId);
+}
+
+void MediaPipelineModuleServiceTests::sendGetVolumeRequestAndReceiveResponse(int sessionId)
 {
     firebolt::rialto::GetVolumeRequest request;
     firebolt::rialto::GetVolumeResponse response;
 
-    request.set_session_id(hardcodedSessionId);
+    request.set_session_id(sessionId);
 
     m_service->getVolume(m_controllerMock.get(), &request, &response, m_closureMock.get());
 
@@ -843,6 +978,35 @@ void MediaPipelineModuleServiceTests::expectRequestFailure()
     EXPECT_CALL(*m_closureMock, Run());
 }
 
+void MediaPipelineModuleServiceTests::mainThreadWillCreateSessionExecutor()
+{
+    EXPECT_CALL(*m_mainThreadMock, registerClient()).WillOnce(Return(kSessionExecutorId));
+    mainThreadWillEnqueueTask();
+    // The executor is released when the session is destroyed, or when the module service is destructed
+    EXPECT_CALL(*m_mainThreadMock, unregisterClient(kSessionExecutorId));
+}
+
+void MediaPipelineModuleServiceTests::mainThreadWillEnqueueTask()
+{
+    EXPECT_CALL(*m_mainThreadMock, enqueueTask(kSessionExecutorId, _))
+        .WillOnce(Invoke([](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task) { task(); }))
+        .RetiresOnSaturation();
+}
+
+void MediaPipelineModuleServiceTests::mainThreadWillQueueTaskWithoutRunningIt()
+{
+    EXPECT_CALL(*m_mainThreadMock, enqueueTask(kSessionExecutorId, _))
+        .WillOnce(Invoke([this](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task)
+                         { m_queuedTask = std::move(task); }))
+        .RetiresOnSaturation();
+}
+
+void MediaPipelineModuleServiceTests::runQueuedTask()
+{
+    ASSERT_TRUE(m_queuedTask);
+    m_queuedTask();
+}
+
 void MediaPipelineModuleServiceTests::sendRenderFrameRequestAndReceiveResponse()
 {
     firebolt::rialto::RenderFrameRequest request;
@@ -25,6 +25,8 @@
 #include "IpcClientMock.h"
 #include "IpcControllerMock.h"
 #include "IpcServerMock.h"
+#include "MainThreadFactoryMock.h"
+#include "MainThreadMock.h"
 #include "MediaPipelineServiceMock.h"
 #include <gtest/gtest.h>
 #include <memory>
@@ -40,6 +42,7 @@ public:
     void clientWillConnect();
     void clientWillDisconnect();
     void mediaPipelineServiceWillCreateSession();
+    void mediaPipelineServiceWillCreateSessionWithoutStatusPage();
     void mediaPipelineServiceWillFailToCreateSession();
     void mediaPipelineServiceWillDestroySession();
     void mediaPipelineServiceWillFailToDestroySession();
@@ -50,6 +53,8 @@ public:
     void mediaPipelineServiceWillFailToAttachSource();
     void mediaPipelineServiceWillPlay();
     void mediaPipelineServiceWillFailToPlay();
+    void mediaPipelineServiceWillPlayOnSessionExecutor(int sessionId);
+    void mediaPipelineServiceWillDestroySessionOnSessionExecutor(int sessionId);
     void mediaPipelineServiceWillPause();
     void mediaPipelineServiceWillFailToPause();
     void mediaPipelineServiceWillStop();
@@ -60,16 +65,22 @@ public:
     void mediaPipelineServiceWillFailToSetVideoWindow();
     void mediaPipelineServiceWillHaveData();
     void mediaPipelineServiceWillFailToHaveData();
+    void mediaPipelineServiceWillHaveDataWithoutReply();
+    void mediaPipelineServiceWillFailToHaveDataWithoutReply();
     void mediaPipelineServiceWillSetPlaybackRate();
     void mediaPipelineServiceWillFailToSetPlaybackRate();
     void mediaPipelineServiceWillGetPosition();
     void mediaPipelineServiceWillFailToGetPosition();
+    void mediaPipelineServiceWillGetPositionFromSnapshot(int sessionId);
     void mediaPipelineServiceWillRenderFrame();
     void mediaPipelineServiceWillFailToRenderFrame();
     void mediaPipelineServiceWillSetVolume();
     void mediaPipelineServiceWillFailToSetVolume();
     void mediaPipelineServiceWillGetVolume();
     void mediaPipelineServiceWillFailToGetVolume();
+    void mediaPipelineServiceWillGetVolumeFromSnapshot(int sessionId);
+    void mediaPipelineServiceWillPlayQueuedTask(int sessionId);
+    void mainThreadWillQueueTaskWithoutRunningIt();
     void mediaClientWillSendPlaybackStateChangedEvent();
     void mediaClientWillSendNetworkStateChangedEvent();
     void mediaClientWillSendNeedMediaDataEvent(int sessionId);
@@ -79,22 +90,28 @@ public:
     void sendClientConnected();
     void sendClientDisconnected();
     int sendCreateSessionRequestAndReceiveResponse();
+    void sendCreateSessionRequestAndReceiveResponseWithoutStatusPage();
     void sendCreateSessionRequestAndExpectFailure();
     void sendDestroySessionRequestAndReceiveResponse();
+    void sendDestroySessionRequestAndReceiveResponse(int sessionId);
     void sendLoadRequestAndReceiveResponse();
     void sendAttachSourceRequestAndReceiveResponse();
     void sendAttachAudioSourceWithAdditionalDataRequestAndReceiveResponse();
     void sendPlayRequestAndReceiveResponse();
+    void sendPlayRequestAndReceiveResponse(int sessionId);
     void sendPauseRequestAndReceiveResponse();
     void sendStopRequestAndReceiveResponse();
     void sendSetPositionRequestAndReceiveResponse();
     void sendGetPositionRequestAndReceiveResponse();
+    void sendGetPositionRequestAndReceiveResponse(int sessionId);
     void sendGetPositionRequestAndReceiveResponseWithoutPositionMatch();
     void sendHaveDataRequestAndReceiveResponse();
+    void sendHaveDataNoReplyRequest();
     void sendSetPlaybackRateRequestAndReceiveResponse();
     void sendSetVideoWindowRequestAndReceiveResponse();
     void sendSetVolumeRequestAndReceiveResponse();
     void sendGetVolumeRequestAndReceiveResponse();
+    void sendGetVolumeRequestAndReceiveResponse(int sessionId);
     void sendGetVolumeRequestAndReceiveResponseWithoutVolumeMatch();
     void sendPlaybackStateChangedEvent();
     void sendNetworkStateChangedEvent();
@@ -102,19 +119,25 @@ public:
     void sendPostionChangeEvent();
     void sendQosEvent();
     void sendRenderFrameRequestAndReceiveResponse();
+    void runQueuedTask();
 
 private:
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ClientMock>> m_clientMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ServerMock>> m_serverMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ClosureMock>> m_closureMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ControllerMock>> m_controllerMock;
+    std::shared_ptr<StrictMock<firebolt::rialto::server::mock::MainThreadFactoryMock>> m_mainThreadFactoryMock;
+    std::shared_ptr<StrictMock<firebolt::rialto::server::mock::MainThreadMock>> m_mainThreadMock;
     StrictMock<firebolt::rialto::server::service::MediaPipelineServiceMock> m_mediaPipelineServiceMock;
     std::shared_ptr<firebolt::rialto::IMediaPipelineClient> m_mediaPipelineClient;
     std::shared_ptr<firebolt::rialto::server::ipc::IMediaPipelineModuleService> m_service;
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> m_source;
+    firebolt::rialto::server::IMainThread::Task m_queuedTask;
 
     void expectRequestSuccess();
     void expectRequestFailure();
+    void mainThreadWillCreateSessionExecutor();
+    void mainThreadWillEnqueueTask();
 };
 
 #endif // MEDIA_PIPELINE_MODULE_SERVICE_TESTS_FIXTURE_H_
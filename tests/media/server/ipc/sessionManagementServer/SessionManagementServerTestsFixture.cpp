@@ -120,6 +120,8 @@ SessionManagementServerTests::~SessionManagementServerTests() {}
 
 void SessionManagementServerTests::serverWillInitialize()
 {
+    EXPECT_CALL(*m_serverMock, setEventPolicy("firebolt.rialto.PositionChangeEvent",
+                                              firebolt::rialto::ipc::IServer::EventPolicy::COALESCE, "session_id"));
     EXPECT_CALL(*m_serverMock, addSocket(socketName, _, _))
         .WillOnce(Invoke(
             [this](const std::string &socketPath,
@@ -134,6 +136,8 @@ void SessionManagementServerTests::serverWillInitialize()
 
 void SessionManagementServerTests::serverWillFailToInitialize()
 {
+    EXPECT_CALL(*m_serverMock, setEventPolicy("firebolt.rialto.PositionChangeEvent",
+                                              firebolt::rialto::ipc::IServer::EventPolicy::COALESCE, "session_id"));
     EXPECT_CALL(*m_serverMock, addSocket(socketName, _, _)).WillOnce(Return(false));
 }
 
@@ -63,6 +63,14 @@ TEST_F(WebAudioPlayerModuleServiceTests, shouldDestroyWebAudioPlayer)
     sendDestroyWebAudioPlayerRequestAndReceiveResponse();
 }
 
+TEST_F(WebAudioPlayerModuleServiceTests, shouldDestroyWebAudioPlayerOnSessionExecutor)
+{
+    webAudioPlayerServiceWillCreateWebAudioPlayer();
+    int handle = sendCreateWebAudioPlayerRequestAndReceiveResponse();
+    webAudioPlayerServiceWillDestroyWebAudioPlayerOnSessionExecutor(handle);
+    sendDestroyWebAudioPlayerRequestAndReceiveResponse(handle);
+}
+
 TEST_F(WebAudioPlayerModuleServiceTests, shouldFailToDestroyWebAudioPlayer)
 {
     webAudioPlayerServiceWillFailToDestroyWebAudioPlayer();
@@ -75,6 +83,14 @@ TEST_F(WebAudioPlayerModuleServiceTests, shouldPlay)
     sendPlayRequestAndReceiveResponse();
 }
 
+TEST_F(WebAudioPlayerModuleServiceTests, shouldPlayOnSessionExecutor)
+{
+    webAudioPlayerServiceWillCreateWebAudioPlayer();
+    int handle = sendCreateWebAudioPlayerRequestAndReceiveResponse();
+    webAudioPlayerServiceWillPlayOnSessionExecutor(handle);
+    sendPlayRequestAndReceiveResponse(handle);
+}
+
 TEST_F(WebAudioPlayerModuleServiceTests, shouldFailToPlay)
 {
     webAudioPlayerServiceWillFailToPlay();
@@ -123,6 +139,18 @@ TEST_F(WebAudioPlayerModuleServiceTests, shouldGetBufferDelay)
     sendGetBufferDelayRequestAndReceiveResponse();
 }
 
+TEST_F(WebAudioPlayerModuleServiceTests, shouldGetBufferDelayFromSnapshotWhileTaskIsQueuedOnSessionExecutor)
+{
+    webAudioPlayerServiceWillCreateWebAudioPlayer();
+    int handle = sendCreateWebAudioPlayerRequestAndReceiveResponse();
+    mainThreadWillQueueTaskWithoutRunningIt();
+    sendPlayRequestAndReceiveResponse(handle);
+    webAudioPlayerServiceWillGetBufferDelayFromSnapshot(handle);
+    sendGetBufferDelayRequestAndReceiveResponse(handle);
+    webAudioPlayerServiceWillPlayQueuedTask(handle);
+    runQueuedTask();
+}
+
 TEST_F(WebAudioPlayerModuleServiceTests, shouldFailToGetBufferDelay)
 {
     webAudioPlayerServiceWillFailToGetBufferDelay();
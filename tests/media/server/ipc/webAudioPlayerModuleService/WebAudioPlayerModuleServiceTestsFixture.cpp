@@ -35,6 +35,7 @@ using testing::SetArgReferee;
 namespace
 {
 constexpr int webAudioPlayerHandle{0};
+constexpr int32_t kSessionExecutorId{7};
 const std::string audioMimeType{"audio/x-raw"};
 constexpr uint32_t priority{4};
 constexpr firebolt::rialto::WebAudioPcmConfig pcmConfig{1, 2, 3, false, true, false};
@@ -107,9 +108,14 @@ WebAudioPlayerModuleServiceTests::WebAudioPlayerModuleServiceTests()
       m_serverMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ServerMock>>()},
       m_closureMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ClosureMock>>()},
       m_controllerMock{std::make_shared<StrictMock<firebolt::rialto::ipc::ControllerMock>>()},
+      m_mainThreadFactoryMock{std::make_shared<StrictMock<firebolt::rialto::server::mock::MainThreadFactoryMock>>()},
+      m_mainThreadMock{std::make_shared<StrictMock<firebolt::rialto::server::mock::MainThreadMock>>()},
       m_shmInfo{std::make_shared<firebolt::rialto::WebAudioShmInfo>(shmInfo)}
 {
-    m_service = std::make_shared<firebolt::rialto::server::ipc::WebAudioPlayerModuleService>(m_webAudioPlayerServiceMock);
+    EXPECT_CALL(*m_mainThreadFactoryMock, getMainThread()).WillOnce(Return(m_mainThreadMock));
+    m_service =
+        std::make_shared<firebolt::rialto::server::ipc::WebAudioPlayerModuleService>(m_webAudioPlayerServiceMock,
+                                                                                     m_mainThreadFactoryMock);
 }
 
 WebAudioPlayerModuleServiceTests::~WebAudioPlayerModuleServiceTests() {}
@@ -121,13 +127,16 @@ void WebAudioPlayerModuleServiceTests::clientWillConnect()
 
 void WebAudioPlayerModuleServiceTests::clientWillDisconnect(int handle)
 {
+    EXPECT_CALL(*m_mainThreadMock, enqueueTaskAndWait(kSessionExecutorId, _))
+        .WillOnce(Invoke([](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task) { task(); }));
     EXPECT_CALL(m_webAudioPlayerServiceMock, destroyWebAudioPlayer(handle)).WillOnce(Return(true));
 }
 
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillCreateWebAudioPlayer()
 {
     expectRequestSuccess();
-    EXPECT_CALL(*m_controllerMock, getClient()).Times(2).WillRepeatedly(Return(m_clientMock));
+    mainThreadWillCreateSessionExecutor();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
     EXPECT_CALL(m_webAudioPlayerServiceMock, createWebAudioPlayer(_, _, audioMimeType, priority, _))
         .WillOnce(DoAll(SaveArg<1>(&m_webAudioPlayerClient), Return(true)));
 }
@@ -135,7 +144,8 @@ void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillCreateWebAudioPl
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillCreateWebAudioPlayerWithPcmConfig()
 {
     expectRequestSuccess();
-    EXPECT_CALL(*m_controllerMock, getClient()).Times(2).WillRepeatedly(Return(m_clientMock));
+    mainThreadWillCreateSessionExecutor();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
     EXPECT_CALL(m_webAudioPlayerServiceMock,
                 createWebAudioPlayer(_, _, audioMimeType, priority, PcmConfigMatcher(pcmConfig)))
         .WillOnce(DoAll(SaveArg<1>(&m_webAudioPlayerClient), Return(true)));
@@ -144,6 +154,8 @@ void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillCreateWebAudioPl
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillFailToCreateWebAudioPlayer()
 {
     expectRequestFailure();
+    mainThreadWillCreateSessionExecutor();
+    mainThreadWillEnqueueTask();
     EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
     EXPECT_CALL(m_webAudioPlayerServiceMock, createWebAudioPlayer(_, _, audioMimeType, priority, _)).WillOnce(Return(false));
 }
@@ -155,6 +167,14 @@ void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillDestroyWebAudioP
     EXPECT_CALL(m_webAudioPlayerServiceMock, destroyWebAudioPlayer(webAudioPlayerHandle)).WillOnce(Return(true));
 }
 
+void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillDestroyWebAudioPlayerOnSessionExecutor(int handle)
+{
+    expectRequestSuccess();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_controllerMock, getClient()).WillOnce(Return(m_clientMock));
+    EXPECT_CALL(m_webAudioPlayerServiceMock, destroyWebAudioPlayer(handle)).WillOnce(Return(true));
+}
+
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillFailToDestroyWebAudioPlayer()
 {
     expectRequestFailure();
@@ -167,6 +187,13 @@ void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillPlay()
     EXPECT_CALL(m_webAudioPlayerServiceMock, play(webAudioPlayerHandle)).WillOnce(Return(true));
 }
 
+void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillPlayOnSessionExecutor(int handle)
+{
+    expectRequestSuccess();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(m_webAudioPlayerServiceMock, play(handle)).WillOnce(Return(true));
+}
+
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillFailToPlay()
 {
     expectRequestFailure();
@@ -213,6 +240,8 @@ void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillFailToGetBufferA
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillGetBufferDelay()
 {
     expectRequestSuccess();
+    EXPECT_CALL(m_webAudioPlayerServiceMock, getBufferDelayFromSnapshot(webAudioPlayerHandle, _))
+        .WillOnce(Return(false));
     EXPECT_CALL(m_webAudioPlayerServiceMock, getBufferDelay(webAudioPlayerHandle, _))
         .WillOnce(DoAll(SetArgReferee<1>(delayFrames), Return(true)));
 }
@@ -220,9 +249,24 @@ void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillGetBufferDelay()
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillFailToGetBufferDelay()
 {
     expectRequestFailure();
+    EXPECT_CALL(m_webAudioPlayerServiceMock, getBufferDelayFromSnapshot(webAudioPlayerHandle, _))
+        .WillOnce(Return(false));
     EXPECT_CALL(m_webAudioPlayerServiceMock, getBufferDelay(webAudioPlayerHandle, _)).WillOnce(Return(false));
 }
 
+void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillGetBufferDelayFromSnapshot(int handle)
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_webAudioPlayerServiceMock, getBufferDelayFromSnapshot(handle, _))
+        .WillOnce(DoAll(SetArgReferee<1>(delayFrames), Return(true)));
+}
+
+void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillPlayQueuedTask(int handle)
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_webAudioPlayerServiceMock, play(handle)).WillOnce(Return(true));
+}
+
 void WebAudioPlayerModuleServiceTests::webAudioPlayerServiceWillWriteBuffer()
 {
     expectRequestSuccess();
@@ -345,21 +389,31 @@ void WebAudioPlayerModuleServiceTests::sendCreateWebAudioPlayerRequestAndExpectF
 }
 
 void WebAudioPlayerModuleServiceTests::sendDestroyWebAudioPlayerRequestAndReceiveResponse()
+{
+    sendDestroyWebAudioPlayerRequestAndReceiveResponse(webAudioPlayerHandle);
+}
+
+void WebAudioPlayerModuleServiceTests::sendDestroyWebAudioPlayerRequestAndReceiveResponse(int handle)
 {
     firebolt::rialto::DestroyWebAudioPlayerRequest request;
     firebolt::rialto::DestroyWebAudioPlayerResponse response;
 
-    request.set_web_audio_player_handle(webAudioPlayerHandle);
+    request.set_web_audio_player_handle(handle);
 
     m_service->destroyWebAudioPlayer(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
 
 void WebAudioPlayerModuleServiceTests::sendPlayRequestAndReceiveResponse()
+{
+    sendPlayRequestAndReceiveResponse(webAudioPlayerHandle);
+}
+
+void WebAudioPlayerModuleServiceTests::sendPlayRequestAndReceiveResponse(int handle)
 {
     firebolt::rialto::WebAudioPlayRequest request;
     firebolt::rialto::WebAudioPlayResponse response;
 
-    request.set_web_audio_player_handle(webAudioPlayerHandle);
+    request.set_web_audio_player_handle(handle);
 
     m_service->play(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
@@ -410,11 +464,16 @@ void WebAudioPlayerModuleServiceTests::sendGetBufferAvailableRequestAndExpectFai
 }
 
 void WebAudioPlayerModuleServiceTests::sendGetBufferDelayRequestAndReceiveResponse()
+{
+    sendGetBufferDelayRequestAndReceiveResponse(webAudioPlayerHandle);
+}
+
+void WebAudioPlayerModuleServiceTests::sendGetBufferDelayRequestAndReceiveResponse(int handle)
 {
     firebolt::rialto::WebAudioGetBufferDelayRequest request;
     firebolt::rialto::WebAudioGetBufferDelayResponse response;
 
-    request.set_web_audio_player_handle(webAudioPlayerHandle);
+    request.set_web_audio_player_handle(handle);
 
     m_service->getBufferDelay(m_controllerMock.get(), &request, &response, m_closureMock.get());
     EXPECT_EQ(response.delay_frames(), delayFrames);
@@ -512,3 +571,32 @@ void WebAudioPlayerModuleServiceTests::expectRequestFailure()
     EXPECT_CALL(*m_controllerMock, SetFailed(_));
     EXPECT_CALL(*m_closureMock, Run());
 }
+
+void WebAudioPlayerModuleServiceTests::mainThreadWillCreateSessionExecutor()
+{
+    EXPECT_CALL(*m_mainThreadMock, registerClient()).WillOnce(Return(kSessionExecutorId));
+    mainThreadWillEnqueueTask();
+    // The executor is released when the web audio player is destroyed, or when the module service is destructed
+    EXPECT_CALL(*m_mainThreadMock, unregisterClient(kSessionExecutorId));
+}
+
+void WebAudioPlayerModuleServiceTests::mainThreadWillEnqueueTask()
+{
+    EXPECT_CALL(*m_mainThreadMock, enqueueTask(kSessionExecutorId, _))
+        .WillOnce(Invoke([](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task) { task(); }))
+        .RetiresOnSaturation();
+}
+
+void WebAudioPlayerModuleServiceTests::mainThreadWillQueueTaskWithoutRunningIt()
+{
+    EXPECT_CALL(*m_mainThreadMock, enqueueTask(kSessionExecutorId, _))
+        .WillOnce(Invoke([this](uint32_t clientId, firebolt::rialto::server::IMainThread::Task task)
+                         { m_queuedTask = std::move(task); }))
+        .RetiresOnSaturation();
+}
+
+void WebAudioPlayerModuleServiceTests::runQueuedTask()
+{
+    ASSERT_TRUE(m_queuedTask);
+    m_queuedTask();
+}
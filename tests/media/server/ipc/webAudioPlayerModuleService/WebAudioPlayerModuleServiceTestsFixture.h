@@ -25,6 +25,8 @@
 #include "IpcClientMock.h"
 #include "IpcControllerMock.h"
 #include "IpcServerMock.h"
+#include "MainThreadFactoryMock.h"
+#include "MainThreadMock.h"
 #include "WebAudioPlayerServiceMock.h"
 #include <gtest/gtest.h>
 #include <memory>
@@ -43,8 +45,10 @@ public:
     void webAudioPlayerServiceWillCreateWebAudioPlayerWithPcmConfig();
     void webAudioPlayerServiceWillFailToCreateWebAudioPlayer();
     void webAudioPlayerServiceWillDestroyWebAudioPlayer();
+    void webAudioPlayerServiceWillDestroyWebAudioPlayerOnSessionExecutor(int handle);
     void webAudioPlayerServiceWillFailToDestroyWebAudioPlayer();
     void webAudioPlayerServiceWillPlay();
+    void webAudioPlayerServiceWillPlayOnSessionExecutor(int handle);
     void webAudioPlayerServiceWillFailToPlay();
     void webAudioPlayerServiceWillPause();
     void webAudioPlayerServiceWillFailToPause();
@@ -54,6 +58,9 @@ public:
     void webAudioPlayerServiceWillFailToGetBufferAvailable();
     void webAudioPlayerServiceWillGetBufferDelay();
     void webAudioPlayerServiceWillFailToGetBufferDelay();
+    void webAudioPlayerServiceWillGetBufferDelayFromSnapshot(int handle);
+    void webAudioPlayerServiceWillPlayQueuedTask(int handle);
+    void mainThreadWillQueueTaskWithoutRunningIt();
     void webAudioPlayerServiceWillWriteBuffer();
     void webAudioPlayerServiceWillFailToWriteBuffer();
     void webAudioPlayerServiceWillGetDeviceInfo();
@@ -71,12 +78,15 @@ public:
     int sendCreateWebAudioPlayerRequestWithPcmConfigAndReceiveResponse();
     void sendCreateWebAudioPlayerRequestAndExpectFailure();
     void sendDestroyWebAudioPlayerRequestAndReceiveResponse();
+    void sendDestroyWebAudioPlayerRequestAndReceiveResponse(int handle);
     void sendPlayRequestAndReceiveResponse();
+    void sendPlayRequestAndReceiveResponse(int handle);
     void sendPauseRequestAndReceiveResponse();
     void sendSetEosRequestAndReceiveResponse();
     void sendGetBufferAvailableRequestAndReceiveResponse();
     void sendGetBufferAvailableRequestAndExpectFailure();
     void sendGetBufferDelayRequestAndReceiveResponse();
+    void sendGetBufferDelayRequestAndReceiveResponse(int handle);
     void sendGetBufferDelayRequestAndExpectFailure();
     void sendWriteBufferRequestAndReceiveResponse();
     void sendGetDeviceInfoRequestAndReceiveResponse();
@@ -85,19 +95,25 @@ public:
     void sendGetVolumeRequestAndReceiveResponse();
     void sendGetVolumeRequestAndExpectFailure();
     void sendPlayerStateEvent();
+    void runQueuedTask();
 
 private:
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ClientMock>> m_clientMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ServerMock>> m_serverMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ClosureMock>> m_closureMock;
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ControllerMock>> m_controllerMock;
+    std::shared_ptr<StrictMock<firebolt::rialto::server::mock::MainThreadFactoryMock>> m_mainThreadFactoryMock;
+    std::shared_ptr<StrictMock<firebolt::rialto::server::mock::MainThreadMock>> m_mainThreadMock;
     StrictMock<firebolt::rialto::server::service::WebAudioPlayerServiceMock> m_webAudioPlayerServiceMock;
     std::shared_ptr<firebolt::rialto::IWebAudioPlayerClient> m_webAudioPlayerClient;
     std::shared_ptr<firebolt::rialto::WebAudioShmInfo> m_shmInfo;
     std::shared_ptr<firebolt::rialto::server::ipc::IWebAudioPlayerModuleService> m_service;
+    firebolt::rialto::server::IMainThread::Task m_queuedTask;
 
     void expectRequestSuccess();
     void expectRequestFailure();
+    void mainThreadWillCreateSessionExecutor();
+    void mainThreadWillEnqueueTask();
 };
 
 #endif // WEB_AUDIO_PLAYER_MODULE_SERVICE_TESTS_FIXTURE_H_
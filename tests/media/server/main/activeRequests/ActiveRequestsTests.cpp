@@ -45,7 +45,7 @@ TEST_F(ActiveRequestsTests, addSegmentShouldReturnErrorForInvalidData)
 {
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>();
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(m_sut.addSegment(0, segment), firebolt::rialto::AddSegmentStatus::ERROR);
 }
 
@@ -60,7 +60,7 @@ TEST_F(ActiveRequestsTests, addSegmentShouldReturnErrorForInvalidId)
 
 TEST_F(ActiveRequestsTests, addSegmentsOverLimitShouldReturnNoSpace)
 {
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, 5));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, 5, 0));
     std::vector<uint8_t> data{'T', 'E', 'S', 'T'};
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>();
@@ -76,13 +76,13 @@ TEST_F(ActiveRequestsTests, addSegmentsOverLimitShouldReturnNoSpace)
 TEST_F(ActiveRequestsTests, shouldGenerateGetAndEraseIds)
 {
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(0));
     m_sut.erase(0);
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
 
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(1));
-    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(1));
     m_sut.erase(1);
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(1));
@@ -91,8 +91,8 @@ TEST_F(ActiveRequestsTests, shouldGenerateGetAndEraseIds)
 TEST_F(ActiveRequestsTests, shouldClearIds)
 {
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(1));
     m_sut.clear();
@@ -103,10 +103,10 @@ TEST_F(ActiveRequestsTests, shouldClearIds)
 TEST_F(ActiveRequestsTests, shouldEraseAudioIds)
 {
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(2, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(3, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(2, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(3, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(1));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(2));
@@ -121,10 +121,10 @@ TEST_F(ActiveRequestsTests, shouldEraseAudioIds)
 TEST_F(ActiveRequestsTests, shouldEraseVideoIds)
 {
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(2, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(3, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(2, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(3, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(1));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(2));
@@ -142,7 +142,7 @@ TEST_F(ActiveRequestsTests, shouldAddAndGetSegments)
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentAudio>();
     segment->setData(data.size(), data.data());
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(m_sut.addSegment(0, segment), firebolt::rialto::AddSegmentStatus::OK);
     const firebolt::rialto::IMediaPipeline::MediaSegmentVector &segments = m_sut.getSegments(0);
     ASSERT_EQ(1, segments.size());
@@ -155,8 +155,29 @@ TEST_F(ActiveRequestsTests, shouldAddAndRemoveSegments)
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>();
     segment->setData(data.size(), data.data());
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(m_sut.addSegment(0, segment), firebolt::rialto::AddSegmentStatus::OK);
     m_sut.clear();
     EXPECT_THROW(m_sut.getSegments(0), std::runtime_error);
 }
+
+TEST_F(ActiveRequestsTests, shouldTrackShmSlotsOfOutstandingRequests)
+{
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, 5, 0));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, 5, 1));
+    EXPECT_EQ(2, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, 5, 0));
+    EXPECT_EQ(0, m_sut.getShmSlot(0));
+    EXPECT_EQ(1, m_sut.getShmSlot(1));
+    EXPECT_EQ(0, m_sut.getShmSlot(2));
+    EXPECT_TRUE(m_sut.isShmSlotUsed(firebolt::rialto::MediaSourceType::VIDEO, 0));
+    EXPECT_TRUE(m_sut.isShmSlotUsed(firebolt::rialto::MediaSourceType::VIDEO, 1));
+    EXPECT_FALSE(m_sut.isShmSlotUsed(firebolt::rialto::MediaSourceType::VIDEO, 2));
+    m_sut.erase(0);
+    EXPECT_FALSE(m_sut.isShmSlotUsed(firebolt::rialto::MediaSourceType::VIDEO, 0));
+    EXPECT_TRUE(m_sut.isShmSlotUsed(firebolt::rialto::MediaSourceType::AUDIO, 0));
+}
+
+TEST_F(ActiveRequestsTests, getShmSlotShouldThrowForInvalidId)
+{
+    EXPECT_THROW(m_sut.getShmSlot(123), std::runtime_error);
+}
@@ -20,11 +20,14 @@
 #include "DataReaderFactory.h"
 #include "DataReaderV1.h"
 #include "DataReaderV2.h"
+#include "DataReaderV3.h"
+#include "ShmUtils.h"
 #include <gtest/gtest.h>
 
 class DataReaderFactoryTests : public testing::Test
 {
 protected:
+    const std::uint32_t m_kMaxDataLen{firebolt::rialto::server::getMaxMetadataBytes() + 1024};
     firebolt::rialto::server::DataReaderFactory m_sut;
 };
 
@@ -34,7 +37,7 @@ TEST_F(DataReaderFactoryTests, shouldFailToCreateDataReaderForUnknownVersion)
     constexpr std::uint32_t numFrames{1};
     std::uint32_t version{23};
     std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
-    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, numFrames);
+    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, m_kMaxDataLen, numFrames);
     ASSERT_EQ(nullptr, reader);
 }
 
@@ -44,7 +47,7 @@ TEST_F(DataReaderFactoryTests, shouldCreateDataReaderV1)
     constexpr std::uint32_t numFrames{1};
     std::uint32_t version{1};
     std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
-    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, numFrames);
+    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, m_kMaxDataLen, numFrames);
     ASSERT_NE(nullptr, reader);
     firebolt::rialto::server::DataReaderV1 *v1Reader =
         dynamic_cast<firebolt::rialto::server::DataReaderV1 *>(reader.get());
@@ -57,9 +60,33 @@ TEST_F(DataReaderFactoryTests, shouldCreateDataReaderV2)
     constexpr std::uint32_t numFrames{1};
     std::uint32_t version{2};
     std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
-    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, numFrames);
+    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, m_kMaxDataLen, numFrames);
     ASSERT_NE(nullptr, reader);
     firebolt::rialto::server::DataReaderV2 *v2Reader =
         dynamic_cast<firebolt::rialto::server::DataReaderV2 *>(reader.get());
     ASSERT_NE(nullptr, v2Reader);
 }
+
+TEST_F(DataReaderFactoryTests, shouldCreateDataReaderV3)
+{
+    constexpr auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    constexpr std::uint32_t numFrames{1};
+    std::uint32_t version{3};
+    std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
+    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, m_kMaxDataLen, numFrames);
+    ASSERT_NE(nullptr, reader);
+    firebolt::rialto::server::DataReaderV3 *v3Reader =
+        dynamic_cast<firebolt::rialto::server::DataReaderV3 *>(reader.get());
+    ASSERT_NE(nullptr, v3Reader);
+}
+
+TEST_F(DataReaderFactoryTests, shouldFailToCreateDataReaderV3WhenSlotIsTooSmall)
+{
+    constexpr auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    constexpr std::uint32_t numFrames{1};
+    std::uint32_t version{3};
+    std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
+    auto reader = m_sut.createDataReader(mediaSourceType, data, 0, firebolt::rialto::server::getMaxMetadataBytes() - 1,
+                                         numFrames);
+    ASSERT_EQ(nullptr, reader);
+}
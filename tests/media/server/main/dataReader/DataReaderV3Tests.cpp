@@ -0,0 +1,400 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataReaderV3.h"
+#include "IMediaFrameWriter.h"
+#include "ShmCommon.h"
+#include <limits>
+#include <functional>
+#include <gtest/gtest.h>
+#include <vector>
+
+using firebolt::rialto::AddSegmentStatus;
+using firebolt::rialto::IMediaPipeline;
+using firebolt::rialto::MediaPlayerShmInfo;
+using firebolt::rialto::SegmentAlignment;
+using firebolt::rialto::common::IMediaFrameWriter;
+using firebolt::rialto::common::IMediaFrameWriterFactory;
+using firebolt::rialto::server::DataReaderV3;
+
+namespace
+{
+constexpr size_t kMetaDataSize{10};
+constexpr size_t kDataSize{246};
+constexpr auto kVideoMediaSourceType{firebolt::rialto::MediaSourceType::VIDEO};
+constexpr auto kVideoSourceId{static_cast<std::int32_t>(kVideoMediaSourceType)};
+constexpr auto kAudioMediaSourceType{firebolt::rialto::MediaSourceType::AUDIO};
+constexpr auto kAudioSourceId{static_cast<std::int32_t>(kAudioMediaSourceType)};
+constexpr int64_t kTimeStamp{4135000000000};
+constexpr int64_t kDuration{90000000000};
+constexpr int32_t kWidth{1024};
+constexpr int32_t kHeight{768};
+constexpr int32_t kSampleRate{13};
+constexpr int32_t kNumberOfChannels{4};
+std::vector<uint8_t> kMediaData{'T', 'E', 'S', 'T', '_', 'M', 'E', 'D', 'I', 'A'};
+constexpr int64_t kTimeStampDelta{20000000};
+std::uint32_t kNumFrames{1};
+const std::vector<uint8_t> kExtraData{1, 2, 3, 4};
+const int32_t kMksId{43};
+const std::vector<uint8_t> kKeyId{9, 2, 6, 2, 0, 1};
+const std::vector<uint8_t> kInitVector{34, 53, 54, 62, 56};
+constexpr size_t kNumClearBytes{2};
+constexpr size_t kNumEncryptedBytes{7};
+constexpr uint32_t kInitWithLast15{1};
+constexpr SegmentAlignment kSegmentAlignment{SegmentAlignment::AU};
+
+class Check
+{
+public:
+    explicit Check(std::unique_ptr<IMediaPipeline::MediaSegment> &segment) : m_segment{segment}
+    {
+        EXPECT_TRUE(segment);
+    }
+
+    Check &mandatoryDataPresent()
+    {
+        EXPECT_EQ(m_segment->getTimeStamp(), kTimeStamp);
+        EXPECT_EQ(m_segment->getDuration(), kDuration);
+        EXPECT_EQ(m_segment->getDataLength(), kMediaData.size());
+        std::vector<uint8_t> resultData{m_segment->getData(), m_segment->getData() + m_segment->getDataLength()};
+        EXPECT_EQ(resultData, kMediaData);
+        return *this;
+    }
+
+    Check &audioDataPresent()
+    {
+        IMediaPipeline::MediaSegmentAudio *resultSegment =
+            dynamic_cast<IMediaPipeline::MediaSegmentAudio *>(m_segment.get());
+        EXPECT_NE(nullptr, resultSegment);
+        EXPECT_EQ(resultSegment->getType(), kAudioMediaSourceType);
+        EXPECT_EQ(resultSegment->getSampleRate(), kSampleRate);
+        EXPECT_EQ(resultSegment->getNumberOfChannels(), kNumberOfChannels);
+        return *this;
+    }
+
+    Check &videoDataPresent()
+    {
+        IMediaPipeline::MediaSegmentVideo *resultSegment =
+            dynamic_cast<IMediaPipeline::MediaSegmentVideo *>(m_segment.get());
+        EXPECT_NE(nullptr, resultSegment);
+        EXPECT_EQ(resultSegment->getType(), kVideoMediaSourceType);
+        EXPECT_EQ(resultSegment->getWidth(), kWidth);
+        EXPECT_EQ(resultSegment->getHeight(), kHeight);
+        return *this;
+    }
+
+    Check &optionalDataPresent()
+    {
+        EXPECT_EQ(m_segment->getExtraData(), kExtraData);
+        EXPECT_EQ(m_segment->getSegmentAlignment(), kSegmentAlignment);
+        return *this;
+    }
+
+    Check &optionalDataNotPresent()
+    {
+        EXPECT_TRUE(m_segment->getExtraData().empty());
+        EXPECT_EQ(m_segment->getSegmentAlignment(), firebolt::rialto::SegmentAlignment::UNDEFINED);
+        return *this;
+    }
+
+    Check &encryptionDataPresent()
+    {
+        EXPECT_TRUE(m_segment->isEncrypted());
+        EXPECT_EQ(m_segment->getMediaKeySessionId(), kMksId);
+        EXPECT_EQ(m_segment->getKeyId(), kKeyId);
+        EXPECT_EQ(m_segment->getInitVector(), kInitVector);
+        EXPECT_EQ(m_segment->getSubSamples().size(), 1);
+        EXPECT_EQ(m_segment->getSubSamples().front().numClearBytes, kNumClearBytes);
+        EXPECT_EQ(m_segment->getSubSamples().front().numEncryptedBytes, kNumEncryptedBytes);
+        EXPECT_EQ(m_segment->getInitWithLast15(), kInitWithLast15);
+        return *this;
+    }
+
+    Check &encryptionDataNotPresent()
+    {
+        EXPECT_FALSE(m_segment->isEncrypted());
+        EXPECT_EQ(m_segment->getMediaKeySessionId(), 0);
+        EXPECT_TRUE(m_segment->getKeyId().empty());
+        EXPECT_TRUE(m_segment->getInitVector().empty());
+        EXPECT_TRUE(m_segment->getSubSamples().empty());
+        EXPECT_EQ(m_segment->getInitWithLast15(), 0);
+        return *this;
+    }
+
+private:
+    std::unique_ptr<IMediaPipeline::MediaSegment> &m_segment;
+};
+
+class Build
+{
+public:
+    Build &basicVideoSegment()
+    {
+        m_segment =
+            std::make_unique<IMediaPipeline::MediaSegmentVideo>(kVideoSourceId, kTimeStamp, kDuration, kWidth, kHeight);
+        m_segment->setData(kMediaData.size(), kMediaData.data());
+        return *this;
+    }
+
+    Build &basicAudioSegment(int64_t timeStamp = kTimeStamp)
+    {
+        m_segment = std::make_unique<IMediaPipeline::MediaSegmentAudio>(kAudioSourceId, timeStamp, kDuration,
+                                                                        kSampleRate, kNumberOfChannels);
+        m_segment->setData(kMediaData.size(), kMediaData.data());
+        return *this;
+    }
+
+    Build &withOptionalData()
+    {
+        m_segment->setExtraData(kExtraData);
+        m_segment->setSegmentAlignment(kSegmentAlignment);
+        return *this;
+    }
+
+    Build &withEncryptionData()
+    {
+        m_segment->setEncrypted(true);
+        m_segment->setMediaKeySessionId(kMksId);
+        m_segment->setKeyId(kKeyId);
+        m_segment->setInitVector(kInitVector);
+        m_segment->addSubSample(kNumClearBytes, kNumEncryptedBytes);
+        m_segment->setInitWithLast15(kInitWithLast15);
+        return *this;
+    }
+    std::unique_ptr<IMediaPipeline::MediaSegment> operator()() { return std::move(m_segment); }
+
+private:
+    std::unique_ptr<IMediaPipeline::MediaSegment> m_segment;
+};
+} // namespace
+
+class DataReaderV3Tests : public testing::Test
+{
+protected:
+    DataReaderV3Tests() = default;
+
+    std::unique_ptr<IMediaPipeline::MediaSegment> readData(const firebolt::rialto::MediaSourceType &sourceType,
+                                                           std::uint32_t maxDataLen = kDataSize)
+    {
+        m_sut = std::make_unique<DataReaderV3>(sourceType, m_shm, kMetaDataSize, maxDataLen, kNumFrames);
+        auto result = m_sut->readData();
+        if (result.size() != 1)
+            return nullptr;
+        return std::move(result.front());
+    }
+
+    IMediaPipeline::MediaSegmentVector readAllData(const firebolt::rialto::MediaSourceType &sourceType,
+                                                   std::uint32_t numFrames)
+    {
+        m_sut = std::make_unique<DataReaderV3>(sourceType, m_shm, kMetaDataSize, kDataSize, numFrames);
+        return m_sut->readData();
+    }
+
+    void writeBuffer(const std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+    {
+        writeBuffer(std::vector<std::reference_wrapper<const std::unique_ptr<IMediaPipeline::MediaSegment>>>{segment});
+    }
+
+    void writeBuffer(
+        const std::vector<std::reference_wrapper<const std::unique_ptr<IMediaPipeline::MediaSegment>>> &segments)
+    {
+        auto shmInfo = std::make_shared<MediaPlayerShmInfo>(MediaPlayerShmInfo{
+            kMetaDataSize, 0, kMetaDataSize, kDataSize, firebolt::rialto::common::LATEST_METADATA_VERSION});
+        auto mediaFrameWriter = IMediaFrameWriterFactory::getFactory()->createFrameWriter(m_shm, shmInfo);
+        for (const auto &segment : segments)
+        {
+            EXPECT_EQ(mediaFrameWriter->writeFrame(segment.get()), AddSegmentStatus::OK);
+        }
+    }
+
+    void writeHeaderField(std::uint32_t fieldOffset, std::uint32_t value)
+    {
+        std::uint8_t *field{m_shm + kMetaDataSize + fieldOffset};
+        for (std::uint32_t i = 0; i < sizeof(std::uint32_t); ++i)
+        {
+            field[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void doSomeMessInMemory()
+    {
+        m_shm[12] = 'S';
+        m_shm[13] = 'U';
+        m_shm[14] = 'R';
+        m_shm[15] = 'P';
+        m_shm[16] = 'R';
+        m_shm[17] = 'I';
+        m_shm[18] = 'S';
+        m_shm[19] = 'E';
+    }
+
+private:
+    uint8_t m_shm[kMetaDataSize + kDataSize];
+    std::unique_ptr<DataReaderV3> m_sut;
+};
+
+TEST_F(DataReaderV3Tests, shouldReadBasicVideoData)
+{
+    auto inputSegment = Build().basicVideoSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kVideoMediaSourceType);
+    Check(resultSegment).mandatoryDataPresent().videoDataPresent().optionalDataNotPresent().encryptionDataNotPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReadBasicAudioData)
+{
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kAudioMediaSourceType);
+    Check(resultSegment).mandatoryDataPresent().audioDataPresent().optionalDataNotPresent().encryptionDataNotPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReadVideoDataWithOptionalParams)
+{
+    auto inputSegment = Build().basicVideoSegment().withOptionalData()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kVideoMediaSourceType);
+    Check(resultSegment).mandatoryDataPresent().videoDataPresent().optionalDataPresent().encryptionDataNotPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReadAudioDataWithOptionalParams)
+{
+    auto inputSegment = Build().basicAudioSegment().withOptionalData()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kAudioMediaSourceType);
+    Check(resultSegment).mandatoryDataPresent().audioDataPresent().optionalDataPresent().encryptionDataNotPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReadEncryptedVideoData)
+{
+    auto inputSegment = Build().basicVideoSegment().withEncryptionData()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kVideoMediaSourceType);
+    Check(resultSegment).mandatoryDataPresent().videoDataPresent().optionalDataNotPresent().encryptionDataPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReadEncryptedAudioData)
+{
+    auto inputSegment = Build().basicAudioSegment().withEncryptionData()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kAudioMediaSourceType);
+    Check(resultSegment).mandatoryDataPresent().audioDataPresent().optionalDataNotPresent().encryptionDataPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenVideoSourceTypeIsSelectedForAudioData)
+{
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kVideoMediaSourceType);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenAudioSourceTypeIsSelectedForVideoData)
+{
+    auto inputSegment = Build().basicVideoSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kAudioMediaSourceType);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenHeaderIsCorrupted)
+{
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    doSomeMessInMemory();
+    auto resultSegment = readData(kAudioMediaSourceType);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReadMultipleFramesWithDeltaCodedTimeStamps)
+{
+    auto firstSegment = Build().basicAudioSegment().withEncryptionData()();
+    auto secondSegment = Build().basicAudioSegment(kTimeStamp + kTimeStampDelta).withOptionalData()();
+    writeBuffer({firstSegment, secondSegment});
+    auto result = readAllData(kAudioMediaSourceType, 2);
+    ASSERT_EQ(result.size(), 2);
+    Check(result[0]).mandatoryDataPresent().audioDataPresent().optionalDataNotPresent().encryptionDataPresent();
+    EXPECT_EQ(result[1]->getTimeStamp(), kTimeStamp + kTimeStampDelta);
+    EXPECT_EQ(result[1]->getDuration(), kDuration);
+    std::vector<uint8_t> resultData{result[1]->getData(), result[1]->getData() + result[1]->getDataLength()};
+    EXPECT_EQ(resultData, kMediaData);
+    Check(result[1]).audioDataPresent().optionalDataPresent().encryptionDataNotPresent();
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenFrameHeaderExceedsSlot)
+{
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment =
+        readData(kAudioMediaSourceType, firebolt::rialto::common::METADATA_V3_FIXED_HEADER_SIZE_BYTES - 1);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenFrameDataExceedsSlot)
+{
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kAudioMediaSourceType, firebolt::rialto::common::METADATA_V3_FIXED_HEADER_SIZE_BYTES +
+                                                             kMediaData.size() - 1);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenExtraDataExceedsSlot)
+{
+    constexpr std::uint32_t kExtraDataLength{0x7FFFFFFF};
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    // Header size and extra data length are consistent, but don't fit in the slot
+    writeHeaderField(0, firebolt::rialto::common::METADATA_V3_FIXED_HEADER_SIZE_BYTES + kExtraDataLength);
+    writeHeaderField(16, kExtraDataLength);
+    auto resultSegment = readData(kAudioMediaSourceType);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenSubSampleTableExceedsSlot)
+{
+    constexpr std::uint32_t kSubSampleCount{0x10000000};
+    auto inputSegment = Build().basicAudioSegment().withEncryptionData()();
+    writeBuffer(inputSegment);
+    writeHeaderField(0, firebolt::rialto::common::METADATA_V3_FIXED_HEADER_SIZE_BYTES + kKeyId.size() +
+                            kInitVector.size() +
+                            kSubSampleCount * firebolt::rialto::common::METADATA_V3_SUBSAMPLE_SIZE_BYTES);
+    writeHeaderField(20, kSubSampleCount);
+    auto resultSegment = readData(kAudioMediaSourceType);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorWhenKeyIdExceedsSlot)
+{
+    auto inputSegment = Build().basicAudioSegment().withEncryptionData()();
+    writeBuffer(inputSegment);
+    const std::uint32_t kFrameSize{static_cast<std::uint32_t>(
+        firebolt::rialto::common::METADATA_V3_FIXED_HEADER_SIZE_BYTES + kKeyId.size() + kInitVector.size() +
+        firebolt::rialto::common::METADATA_V3_SUBSAMPLE_SIZE_BYTES + kMediaData.size())};
+    auto resultSegment = readData(kAudioMediaSourceType, kFrameSize - kMediaData.size() - kInitVector.size());
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV3Tests, shouldReturnEmptyVectorForTooBigFrameCount)
+{
+    auto inputSegment = Build().basicAudioSegment()();
+    writeBuffer(inputSegment);
+    auto result = readAllData(kAudioMediaSourceType, std::numeric_limits<std::uint32_t>::max());
+    EXPECT_TRUE(result.empty());
+}
@@ -20,6 +20,9 @@
 #include "MainThread.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <vector>
 
 using namespace firebolt::rialto::server;
 
@@ -84,7 +87,8 @@ TEST_F(MainThreadTests, RegisterItself)
  */
 TEST_F(MainThreadTests, MultipleClients)
 {
-    m_mainThread = std::make_shared<MainThread>();
+    // With a single worker thread, strands are executed in the order they were scheduled
+    m_mainThread = std::make_shared<MainThread>(1);
 
     uint32_t clientId1 = m_mainThread->registerClient();
     uint32_t clientId2 = m_mainThread->registerClient();
@@ -134,3 +138,166 @@ TEST_F(MainThreadTests, IgnoreUnregisteredClients)
 
     unregisterClient(clientId2);
 }
+
+/**
+ * Test that the tasks of different clients run in parallel.
+ */
+TEST_F(MainThreadTests, ClientsRunInParallel)
+{
+    m_mainThread = std::make_shared<MainThread>(2);
+
+    uint32_t clientId1 = m_mainThread->registerClient();
+    uint32_t clientId2 = m_mainThread->registerClient();
+
+    std::promise<void> blockingTaskStarted;
+    std::promise<void> releaseBlockingTask;
+    std::shared_future<void> release{releaseBlockingTask.get_future()};
+    m_mainThread->enqueueTask(clientId1,
+                              [&, release]()
+                              {
+                                  blockingTaskStarted.set_value();
+                                  release.wait();
+                              });
+    blockingTaskStarted.get_future().wait();
+
+    // Client 2 is not stalled by the blocked task of client 1
+    std::shared_ptr<DummyMock> dummyMock2 = std::make_shared<DummyMock>();
+    EXPECT_CALL(*dummyMock2, mockMethod());
+    enqueueTaskAndWaitOnDummyMock(clientId2, dummyMock2);
+
+    releaseBlockingTask.set_value();
+    unregisterClient(clientId1);
+    unregisterClient(clientId2);
+}
+
+/**
+ * Test that the tasks of a client are executed in order and never concurrently.
+ */
+TEST_F(MainThreadTests, ClientTasksAreSerialised)
+{
+    constexpr int kNumOfTasks{200};
+    m_mainThread = std::make_shared<MainThread>(4);
+
+    uint32_t clientId = m_mainThread->registerClient();
+    std::vector<int> executionOrder;
+    std::atomic<int> runningTasks{0};
+    std::atomic<bool> concurrentExecution{false};
+    for (int i = 0; i < kNumOfTasks; ++i)
+    {
+        m_mainThread->enqueueTask(clientId,
+                                  [&, i]()
+                                  {
+                                      if (++runningTasks > 1)
+                                      {
+                                          concurrentExecution = true;
+                                      }
+                                      executionOrder.push_back(i);
+                                      --runningTasks;
+                                  });
+    }
+    m_mainThread->enqueueTaskAndWait(clientId, []() {});
+
+    EXPECT_FALSE(concurrentExecution);
+    ASSERT_EQ(executionOrder.size(), kNumOfTasks);
+    for (int i = 0; i < kNumOfTasks; ++i)
+    {
+        EXPECT_EQ(executionOrder[i], i);
+    }
+
+    unregisterClient(clientId);
+}
+
+/**
+ * Test that a client registered from within a task shares the strand of the client running the task.
+ */
+TEST_F(MainThreadTests, ClientRegisteredFromTaskSharesStrand)
+{
+    m_mainThread = std::make_shared<MainThread>(2);
+
+    uint32_t parentClientId = m_mainThread->registerClient();
+    uint32_t childClientId{0};
+    m_mainThread->enqueueTaskAndWait(parentClientId, [&]() { childClientId = m_mainThread->registerClient(); });
+
+    std::shared_ptr<DummyMock> dummyMock = std::make_shared<DummyMock>();
+    EXPECT_CALL(*dummyMock, mockMethod());
+    enqueueTaskAndWaitOnDummyMock(childClientId, dummyMock);
+
+    IMainThread::StrandMetrics parentMetrics;
+    IMainThread::StrandMetrics childMetrics;
+    ASSERT_TRUE(m_mainThread->getStrandMetrics(parentClientId, parentMetrics));
+    ASSERT_TRUE(m_mainThread->getStrandMetrics(childClientId, childMetrics));
+    EXPECT_EQ(parentMetrics.executedTasks, 2U);
+    EXPECT_EQ(childMetrics.executedTasks, 2U);
+
+    unregisterClient(childClientId);
+    unregisterClient(parentClientId);
+}
+
+/**
+ * Test that a task enqueued and waited for from the strand of the client is executed immediately.
+ */
+TEST_F(MainThreadTests, EnqueueTaskAndWaitFromOwnStrandRunsInPlace)
+{
+    m_mainThread = std::make_shared<MainThread>(1);
+
+    uint32_t parentClientId = m_mainThread->registerClient();
+    bool isNestedTaskDone{false};
+    m_mainThread->enqueueTaskAndWait(parentClientId,
+                                     [&]()
+                                     {
+                                         uint32_t childClientId = m_mainThread->registerClient();
+                                         m_mainThread->enqueueTaskAndWait(childClientId,
+                                                                          [&]() { isNestedTaskDone = true; });
+                                         EXPECT_TRUE(isNestedTaskDone);
+                                         m_mainThread->unregisterClient(childClientId);
+                                     });
+    EXPECT_TRUE(isNestedTaskDone);
+
+    unregisterClient(parentClientId);
+}
+
+/**
+ * Test that the queue depth and wait time metrics of a strand are collected.
+ */
+TEST_F(MainThreadTests, StrandMetrics)
+{
+    constexpr std::size_t kNumOfQueuedTasks{3};
+    m_mainThread = std::make_shared<MainThread>(2);
+
+    uint32_t clientId = m_mainThread->registerClient();
+
+    std::promise<void> blockingTaskStarted;
+    std::promise<void> releaseBlockingTask;
+    std::shared_future<void> release{releaseBlockingTask.get_future()};
+    m_mainThread->enqueueTask(clientId,
+                              [&, release]()
+                              {
+                                  blockingTaskStarted.set_value();
+                                  release.wait();
+                              });
+    blockingTaskStarted.get_future().wait();
+    for (std::size_t i = 0; i < kNumOfQueuedTasks; ++i)
+    {
+        m_mainThread->enqueueTask(clientId, []() {});
+    }
+
+    IMainThread::StrandMetrics metrics;
+    ASSERT_TRUE(m_mainThread->getStrandMetrics(clientId, metrics));
+    EXPECT_EQ(metrics.queueDepth, kNumOfQueuedTasks);
+    EXPECT_EQ(metrics.maxQueueDepth, kNumOfQueuedTasks);
+    EXPECT_EQ(metrics.executedTasks, 1U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    releaseBlockingTask.set_value();
+    m_mainThread->enqueueTaskAndWait(clientId, []() {});
+
+    ASSERT_TRUE(m_mainThread->getStrandMetrics(clientId, metrics));
+    EXPECT_EQ(metrics.queueDepth, 0U);
+    EXPECT_GE(metrics.maxQueueDepth, kNumOfQueuedTasks);
+    EXPECT_EQ(metrics.executedTasks, kNumOfQueuedTasks + 2);
+    EXPECT_GE(metrics.maxWaitTime, std::chrono::milliseconds(10));
+    EXPECT_GE(metrics.totalWaitTime, metrics.maxWaitTime);
+
+    unregisterClient(clientId);
+    EXPECT_FALSE(m_mainThread->getStrandMetrics(clientId, metrics));
+}
@@ -18,6 +18,7 @@
  */
 
 #include "MediaKeysTestBase.h"
+#include <thread>
 
 class RialtoServerMediaKeysCloseKeySessionTest : public MediaKeysTestBase
 {
@@ -67,7 +68,6 @@ TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionFailure)
 TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionNotClosedWhenBuffersUsed)
 {
     mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
 
     m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
     EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
@@ -80,7 +80,6 @@ TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionClosedAfterDecrement)
 {
     mainThreadWillEnqueueTaskAndWait();
     mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
 
     m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
     EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
@@ -95,9 +94,6 @@ TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionClosedAfterDecrement)
 TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionNotClosedAfterDecrementWhenBuffersStillInUse)
 {
     mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
 
     m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
     m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
@@ -111,8 +107,6 @@ TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionNotClosedAfterDecrementW
  */
 TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionNotClosedAfterDecrementWhenCloseNotRequested)
 {
-    mainThreadWillEnqueueTaskAndWait();
-
     m_mediaKeys->decrementSessionIdUsageCounter(m_kKeySessionId);
 }
 
@@ -122,7 +116,6 @@ TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionNotClosedAfterDecrementW
 TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionClosedWhenIncrementFails)
 {
     mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
 
     m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId + 1);
     EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession()).WillOnce(Return(MediaKeyErrorStatus::OK));
@@ -135,10 +128,42 @@ TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionClosedWhenIncrementFails
 TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionNotClosedWhenDeccrementFails)
 {
     mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
-    mainThreadWillEnqueueTaskAndWait();
 
     m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
     m_mediaKeys->decrementSessionIdUsageCounter(m_kKeySessionId + 1);
     EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
 }
+
+/**
+ * Test that buffers counted and released on the streaming threads close a deferred session once, on the main thread
+ * only for the last release.
+ */
+TEST_F(RialtoServerMediaKeysCloseKeySessionTest, SessionClosedOnceAfterBuffersReleasedOnStreamingThreads)
+{
+    constexpr int kNumOfBuffers{100};
+
+    mainThreadWillEnqueueTaskAndWait();
+    mainThreadWillEnqueueTaskAndWait();
+
+    auto stream = [this]()
+    {
+        for (int i = 0; i < kNumOfBuffers; i++)
+            m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
+    };
+    std::thread audioThread{stream};
+    std::thread videoThread{stream};
+    audioThread.join();
+    videoThread.join();
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
+
+    EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession()).WillOnce(Return(MediaKeyErrorStatus::OK));
+    auto release = [this]()
+    {
+        for (int i = 0; i < kNumOfBuffers; i++)
+            m_mediaKeys->decrementSessionIdUsageCounter(m_kKeySessionId);
+    };
+    audioThread = std::thread{release};
+    videoThread = std::thread{release};
+    audioThread.join();
+    videoThread.join();
+}
@@ -18,6 +18,9 @@
  */
 
 #include "MediaKeysTestBase.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 class RialtoServerMediaKeysDecryptTest : public MediaKeysTestBase
 {
@@ -42,7 +45,6 @@ protected:
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, Success)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock,
                 decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
         .WillOnce(Return(MediaKeyErrorStatus::OK));
@@ -56,7 +58,6 @@ TEST_F(RialtoServerMediaKeysDecryptTest, Success)
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, SessionDoesNotExistFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID,
               m_mediaKeys->decrypt(m_kKeySessionId + 1, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
                                    m_initWithLast15));
@@ -67,7 +68,6 @@ TEST_F(RialtoServerMediaKeysDecryptTest, SessionDoesNotExistFailure)
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, DecryptFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock,
                 decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
         .WillOnce(Return(MediaKeyErrorStatus::INVALID_STATE));
@@ -76,3 +76,87 @@ TEST_F(RialtoServerMediaKeysDecryptTest, DecryptFailure)
               m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
                                    m_initWithLast15));
 }
+
+/**
+ * Test that Decrypt fails after the key session is closed.
+ */
+TEST_F(RialtoServerMediaKeysDecryptTest, SessionClosedFailure)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession()).WillOnce(Return(MediaKeyErrorStatus::OK));
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
+
+    EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID,
+              m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
+                                   m_initWithLast15));
+}
+
+/**
+ * Test that Decrypt succeeds when closing of the key session is deferred, because buffers still use it.
+ */
+TEST_F(RialtoServerMediaKeysDecryptTest, SuccessWhenCloseIsDeferred)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    m_mediaKeys->incrementSessionIdUsageCounter(m_kKeySessionId);
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
+
+    EXPECT_CALL(*m_mediaKeySessionMock,
+                decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
+        .WillOnce(Return(MediaKeyErrorStatus::OK));
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample,
+                                                            m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15));
+}
+
+/**
+ * Test that Decrypt succeeds when closing of the key session fails, so the session is still open.
+ */
+TEST_F(RialtoServerMediaKeysDecryptTest, SuccessAfterCloseFailure)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession()).WillOnce(Return(MediaKeyErrorStatus::FAIL));
+    EXPECT_EQ(MediaKeyErrorStatus::FAIL, m_mediaKeys->closeKeySession(m_kKeySessionId));
+
+    EXPECT_CALL(*m_mediaKeySessionMock,
+                decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
+        .WillOnce(Return(MediaKeyErrorStatus::OK));
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample,
+                                                            m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15));
+}
+
+/**
+ * Test that closing of the key session waits for a decryption in progress on another thread.
+ */
+TEST_F(RialtoServerMediaKeysDecryptTest, CloseWaitsForDecryptInProgress)
+{
+    std::atomic<bool> decryptFinished{false};
+    std::thread closeThread;
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_mediaKeySessionMock,
+                decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
+        .WillOnce(Invoke(
+            [&](GstBuffer *, GstBuffer *, const uint32_t, GstBuffer *, GstBuffer *, uint32_t)
+            {
+                closeThread = std::thread{[&]()
+                                          { EXPECT_EQ(MediaKeyErrorStatus::OK,
+                                                      m_mediaKeys->closeKeySession(m_kKeySessionId)); }};
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                decryptFinished = true;
+                return MediaKeyErrorStatus::OK;
+            }));
+    EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession())
+        .WillOnce(Invoke(
+            [&]()
+            {
+                EXPECT_TRUE(decryptFinished);
+                return MediaKeyErrorStatus::OK;
+            }));
+
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample,
+                                                            m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15));
+    closeThread.join();
+
+    EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID,
+              m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
+                                   m_initWithLast15));
+}
@@ -70,6 +70,8 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, NotifyPlaybackState)
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(state));
 
     m_gstPlayerCallback->notifyPlaybackState(state);
+
+    EXPECT_EQ(readStatusPage().playbackState, state);
 }
 
 /**
@@ -82,6 +84,10 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyPosition)
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(position));
 
     m_gstPlayerCallback->notifyPosition(position);
+
+    const firebolt::rialto::common::PlaybackStatus kStatus{readStatusPage()};
+    EXPECT_EQ(kStatus.position, position);
+    EXPECT_NE(kStatus.positionTimestamp, 0);
 }
 
 /**
@@ -94,6 +100,8 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNetworkState)
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyNetworkState(state));
 
     m_gstPlayerCallback->notifyNetworkState(state);
+
+    EXPECT_EQ(readStatusPage().networkState, state);
 }
 
 /**
@@ -106,6 +114,9 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataInPrerollingSta
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
 
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
 
@@ -115,16 +126,19 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataInPrerollingSta
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(1));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 0)).WillOnce(Return(false));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                clearSlotData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
         .WillOnce(Return(true));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
         .WillOnce(Return(7 * 1024 * 1024));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
         .WillOnce(Return(0));
-    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, 0)).WillOnce(Return(0));
     EXPECT_CALL(*m_mediaPipelineClientMock,
                 notifyNeedMediaData(sourceId, numFrames, 0, _)); // params tested in NeedMediaDataTests
 
@@ -141,6 +155,9 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataInPlayingState)
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
 
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
 
@@ -154,16 +171,19 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataInPlayingState)
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(1));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 0)).WillOnce(Return(false));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                clearSlotData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
         .WillOnce(Return(true));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
         .WillOnce(Return(7 * 1024 * 1024));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
         .WillOnce(Return(0));
-    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, 0)).WillOnce(Return(0));
     EXPECT_CALL(*m_mediaPipelineClientMock,
                 notifyNeedMediaData(sourceId, numFrames, 0, _)); // params tested in NeedMediaDataTests
 
@@ -177,15 +197,133 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataFailureDueToSou
 {
     auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
     mainThreadWillEnqueueTaskAndWait();
+
+    m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType);
+}
+
+/**
+ * Test a notification of the need media data requests data for every free shm ring slot.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataForAllFreeShmSlots)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceVideo>(-1, "video/h264");
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+
+    auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    int sourceId{mediaSource->getId()};
+    int numFrames{1};
+    constexpr std::uint32_t kSlotLen{2 * 1024 * 1024};
+    mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(3));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 0)).WillOnce(Return(false));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 1)).WillOnce(Return(true));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 2)).WillOnce(Return(false));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
-        .WillOnce(Return(true));
+                getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+        .Times(2)
+        .WillRepeatedly(Return(kSlotLen));
+    for (std::uint32_t slot : {0u, 2u})
+    {
+        EXPECT_CALL(*m_sharedMemoryBufferMock,
+                    clearSlotData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, slot))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*m_sharedMemoryBufferMock,
+                    getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType,
+                                      slot))
+            .WillOnce(Return(slot * kSlotLen));
+        EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, slot)).WillOnce(Return(slot));
+        EXPECT_CALL(*m_mediaPipelineClientMock,
+                    notifyNeedMediaData(sourceId, numFrames, slot, _)); // params tested in NeedMediaDataTests
+    }
 
     m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType);
 }
 
+/**
+ * Test a notification of the need media data succeeds without a new request, when every slot has an outstanding one.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataWhenAllShmSlotsHaveOutstandingRequests)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceVideo>(-1, "video/h264");
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+
+    auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(2));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 0)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 1)).WillRepeatedly(Return(true));
+
+    EXPECT_TRUE(m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType));
+}
+
+/**
+ * Test a notification of the need media data fails, when every slot is still held by the player.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataFailsWhenAllShmSlotsAreUsedByPlayer)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceVideo>(-1, "video/h264");
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+
+    auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    constexpr std::uint32_t kNeedDataRequestId{0};
+    constexpr std::uint32_t kNumFrames{1};
+    constexpr std::uint32_t kMaxSlotDataLen{1024};
+    std::uint8_t data{123};
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_activeRequestsMock, getType(kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(kNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+        .WillOnce(Return(kMaxSlotDataLen));
+    EXPECT_CALL(*m_dataReaderFactoryMock, createDataReader(mediaSourceType, &data, 0, kMaxSlotDataLen, kNumFrames))
+        .WillOnce(Return(dataReader));
+    // The player keeps the reader it was given, as long as it uses the slot
+    std::shared_ptr<IDataReader> attachedDataReader;
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader)).WillOnce(SaveArg<0>(&attachedDataReader));
+    EXPECT_TRUE(m_mediaPipeline->haveData(MediaSourceStatus::OK, kNumFrames, kNeedDataRequestId));
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(1));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 0)).WillRepeatedly(Return(false));
+
+    EXPECT_FALSE(m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType));
+}
+
 /**
  * Test a notification of qos is forwarded to the registered client.
  */
@@ -196,6 +334,9 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyQos)
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
 
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
 
@@ -207,6 +348,10 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyQos)
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyQos(sourceId, QosInfoMatcher(qosInfo)));
 
     m_gstPlayerCallback->notifyQos(mediaSourceType, qosInfo);
+
+    const firebolt::rialto::common::PlaybackStatus kStatus{readStatusPage()};
+    EXPECT_EQ(kStatus.videoQos.processed, qosInfo.processed);
+    EXPECT_EQ(kStatus.videoQos.dropped, qosInfo.dropped);
 }
 
 /**
@@ -222,6 +367,24 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyQosFailureSourceIdNotFound)
     m_gstPlayerCallback->notifyQos(mediaSourceType, qosInfo);
 }
 
+/**
+ * Test a notification of the buffer level is published in the status page.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, notifyBufferLevel)
+{
+    constexpr std::uint64_t kAudioQueuedBytes{1024};
+    constexpr std::uint64_t kVideoQueuedBytes{4096};
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+
+    m_gstPlayerCallback->notifyBufferLevel(MediaSourceType::AUDIO, kAudioQueuedBytes);
+    m_gstPlayerCallback->notifyBufferLevel(MediaSourceType::VIDEO, kVideoQueuedBytes);
+
+    const firebolt::rialto::common::PlaybackStatus kStatus{readStatusPage()};
+    EXPECT_EQ(kStatus.audioQueuedBytes, kAudioQueuedBytes);
+    EXPECT_EQ(kStatus.videoQueuedBytes, kVideoQueuedBytes);
+}
+
 /**
  * Tests if active request cache is cleared.
  */
@@ -232,3 +395,204 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, clearActiveRequestsCache)
 
     m_gstPlayerCallback->clearActiveRequestsCache();
 }
+
+/**
+ * Test that the position notified while playing is served without a main thread hop.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, getPositionFromPlayerSnapshot)
+{
+    constexpr int64_t kPosition{12345};
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PLAYING));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kPosition));
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PLAYING);
+    m_gstPlayerCallback->notifyPosition(kPosition);
+
+    int64_t position{};
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_GE(position, kPosition);
+}
+
+/**
+ * Test that the position is queried from the player when the playback is not playing.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, getPositionFromPlayerWhenNotPlaying)
+{
+    constexpr int64_t kPosition{12345};
+    constexpr int64_t kPausedPosition{12400};
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kPosition));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PAUSED));
+    m_gstPlayerCallback->notifyPosition(kPosition);
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PAUSED);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, getPosition(_))
+        .WillOnce(Invoke(
+            [&](int64_t &pos)
+            {
+                pos = kPausedPosition;
+                return true;
+            }));
+    int64_t position{};
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_EQ(position, kPausedPosition);
+}
+
+/**
+ * Test that the position notified before a seek is not served from the snapshot.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, getPositionFromPlayerAfterSetPosition)
+{
+    constexpr int64_t kPosition{12345};
+    constexpr int64_t kSeekPosition{67890};
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PLAYING));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kPosition));
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PLAYING);
+    m_gstPlayerCallback->notifyPosition(kPosition);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, setPosition(kSeekPosition));
+    EXPECT_TRUE(m_mediaPipeline->setPosition(kSeekPosition));
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, getPosition(_))
+        .WillOnce(Invoke(
+            [&](int64_t &pos)
+            {
+                pos = kSeekPosition;
+                return true;
+            }));
+    int64_t position{};
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_EQ(position, kSeekPosition);
+}
+
+/**
+ * Test that the position notified before a pause or a resume is not served from the snapshot.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, getPositionFromPlayerAfterPauseAndResume)
+{
+    constexpr int64_t kPosition{12345};
+    constexpr int64_t kPausedPosition{12400};
+    constexpr int64_t kResumedPosition{12500};
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PLAYING)).Times(2);
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PAUSED));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kPosition));
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PLAYING);
+    m_gstPlayerCallback->notifyPosition(kPosition);
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PAUSED);
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PLAYING);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, getPosition(_))
+        .WillOnce(Invoke(
+            [&](int64_t &pos)
+            {
+                pos = kPausedPosition;
+                return true;
+            }));
+    int64_t position{};
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_EQ(position, kPausedPosition);
+
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kResumedPosition));
+    m_gstPlayerCallback->notifyPosition(kResumedPosition);
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_GE(position, kResumedPosition);
+}
+
+/**
+ * Test that a position reported by the player before it starts a seek is dropped.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, positionReportedBeforeSeekIsDropped)
+{
+    constexpr int64_t kPosition{12345};
+    constexpr int64_t kSeekPosition{67890};
+    constexpr int64_t kPositionAfterSeek{67900};
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PLAYING));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kPosition));
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PLAYING);
+    m_gstPlayerCallback->notifyPosition(kPosition);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, setPosition(kSeekPosition));
+    EXPECT_TRUE(m_mediaPipeline->setPosition(kSeekPosition));
+
+    // Sampled by the player before it executed the seek
+    m_gstPlayerCallback->notifyPosition(kPosition);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, getPosition(_))
+        .WillOnce(Invoke(
+            [&](int64_t &pos)
+            {
+                pos = kSeekPosition;
+                return true;
+            }));
+    int64_t position{};
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_EQ(position, kSeekPosition);
+
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::SEEKING));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::PLAYING));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPosition(kPositionAfterSeek));
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::SEEKING);
+    m_gstPlayerCallback->notifyPlaybackState(PlaybackState::PLAYING);
+    m_gstPlayerCallback->notifyPosition(kPositionAfterSeek);
+    EXPECT_TRUE(m_mediaPipeline->getPosition(position));
+    EXPECT_GE(position, kPositionAfterSeek);
+}
+
+/**
+ * Test that the notified volume is served without a main thread hop.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, getVolumeFromPlayerSnapshot)
+{
+    constexpr double kVolume{0.7};
+    m_gstPlayerCallback->notifyVolume(kVolume);
+
+    double volume{};
+    EXPECT_TRUE(m_mediaPipeline->getVolume(volume));
+    EXPECT_EQ(volume, kVolume);
+}
+
+/**
+ * Test that the volume notified before a volume change is not served from the snapshot.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, getVolumeFromPlayerAfterSetVolume)
+{
+    constexpr double kVolume{0.7};
+    constexpr double kNewVolume{0.2};
+    m_gstPlayerCallback->notifyVolume(kVolume);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, setVolume(kNewVolume));
+    EXPECT_TRUE(m_mediaPipeline->setVolume(kNewVolume));
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, getVolume(_))
+        .WillOnce(Invoke(
+            [&](double &vol)
+            {
+                vol = kNewVolume;
+                return true;
+            }));
+    double volume{};
+    EXPECT_TRUE(m_mediaPipeline->getVolume(volume));
+    EXPECT_EQ(volume, kNewVolume);
+}
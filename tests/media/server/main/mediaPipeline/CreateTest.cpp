@@ -19,6 +19,8 @@
 
 #include "MediaPipelineTestBase.h"
 
+using ::testing::Throw;
+
 class RialtoServerCreateMediaPipelineTest : public MediaPipelineTestBase
 {
 };
@@ -33,6 +35,7 @@ TEST_F(RialtoServerCreateMediaPipelineTest, Create)
     EXPECT_CALL(*m_mainThreadMock, registerClient()).WillOnce(Return(m_kMainThreadClientId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, mapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
         .WillOnce(Return(true));
+    statusPageWillBeMapped();
     EXPECT_NO_THROW(
         m_mediaPipeline =
             std::make_unique<MediaPipelineServerInternal>(m_mediaPipelineClientMock, m_videoReq, m_gstPlayerFactoryMock,
@@ -47,3 +50,44 @@ TEST_F(RialtoServerCreateMediaPipelineTest, Create)
     // Objects are destroyed on the main thread
     mainThreadWillEnqueueTaskAndWait();
 }
+
+/**
+ * Test that the initial status is published in the status page and the page is invalidated on destruction.
+ */
+TEST_F(RialtoServerCreateMediaPipelineTest, PublishStatusPage)
+{
+    createMediaPipeline();
+
+    const firebolt::rialto::common::PlaybackStatus kStatus{readStatusPage()};
+    EXPECT_EQ(kStatus.playbackState, PlaybackState::UNKNOWN);
+    EXPECT_EQ(kStatus.position, 0);
+
+    destroyMediaPipeline();
+
+    firebolt::rialto::common::PlaybackStatus status;
+    EXPECT_FALSE(firebolt::rialto::common::ShmStatusPage{m_statusPageBuffer}.read(status));
+}
+
+/**
+ * Test that a MediaPipeline object can be created when the status page is not available.
+ */
+TEST_F(RialtoServerCreateMediaPipelineTest, CreateWithoutStatusPage)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_mainThreadFactoryMock, getMainThread()).WillOnce(Return(m_mainThreadMock));
+    EXPECT_CALL(*m_mainThreadMock, registerClient()).WillOnce(Return(m_kMainThreadClientId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, mapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getStatusPageOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Throw(std::runtime_error("Status page not found")));
+    EXPECT_NO_THROW(
+        m_mediaPipeline =
+            std::make_unique<MediaPipelineServerInternal>(m_mediaPipelineClientMock, m_videoReq, m_gstPlayerFactoryMock,
+                                                          m_kSessionId, m_sharedMemoryBufferMock, m_mainThreadFactoryMock,
+                                                          m_timerFactoryMock, std::move(m_dataReaderFactory),
+                                                          std::move(m_activeRequests), m_decryptionServiceMock););
+    EXPECT_NE(m_mediaPipeline, nullptr);
+
+    destroyMediaPipeline();
+}
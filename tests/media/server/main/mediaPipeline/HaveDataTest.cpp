@@ -23,12 +23,14 @@ using ::testing::A;
 using ::testing::ByMove;
 using ::testing::Ref;
 using ::testing::ReturnRef;
+using ::testing::SaveArg;
 using ::testing::Throw;
 
 class RialtoServerMediaPipelineHaveDataTest : public MediaPipelineTestBase
 {
 protected:
     const uint32_t m_kNumFrames{1};
+    const uint32_t m_kMaxSlotDataLen{1024};
     const uint32_t m_kNeedDataRequestId{0};
     const std::chrono::milliseconds m_kNeedMediaDataResendTimeout{100};
 
@@ -173,6 +175,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithS
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_timerMock, isActive()).WillOnce(Return(true));
     EXPECT_CALL(*m_timerMock, cancel());
@@ -190,6 +193,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithS
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_timerMock, isActive()).Times(2).WillRepeatedly(Return(true));
     EXPECT_CALL(*m_timerMock, cancel());
@@ -198,6 +202,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithS
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
     mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_activeRequestsMock, getType(kNextNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(kNextNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(kNextNeedDataRequestId));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, kNextNeedDataRequestId));
 }
@@ -214,6 +219,9 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithR
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::VIDEO, _))
+        .WillOnce(Return(true));
 
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
     int sourceId{mediaSource->getId()};
@@ -221,6 +229,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithR
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_timerFactoryMock, createTimer(m_kNeedMediaDataResendTimeout, _, _))
         .WillOnce(Invoke(
@@ -234,16 +243,19 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithR
     ASSERT_TRUE(resendCallback);
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getNumOfSlots(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(1));
+    EXPECT_CALL(*m_activeRequestsMock, isShmSlotUsed(mediaSourceType, 0)).WillOnce(Return(false));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                clearSlotData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
         .WillOnce(Return(true));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
         .WillOnce(Return(7 * 1024 * 1024));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
-                getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType, 0))
         .WillOnce(Return(0));
-    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, 0)).WillOnce(Return(0));
     EXPECT_CALL(*m_mediaPipelineClientMock,
                 notifyNeedMediaData(sourceId, m_kNumFrames, 0, _)); // params tested in NeedMediaDataTests
     mainThreadWillEnqueueTask();
@@ -259,6 +271,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(nullptr));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
@@ -275,10 +288,12 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
-                                                         firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Throw(std::runtime_error("runtime_error")));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
     EXPECT_FALSE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -296,13 +311,19 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
-                                                         firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kMaxSlotDataLen,
+                                 m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
     EXPECT_FALSE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -319,13 +340,89 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccess)
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, 0))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kMaxSlotDataLen,
+                                 m_kNumFrames))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ShouldUnmapPartitionWhenPlayerReleasesDataReader)
+{
+    auto status = firebolt::rialto::MediaSourceStatus::OK;
+    std::uint8_t data{123};
+    int offset = 0;
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    std::shared_ptr<IDataReader> attachedDataReader;
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, 0))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kMaxSlotDataLen,
+                                 m_kNumFrames))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader)).WillOnce(SaveArg<0>(&attachedDataReader));
+    EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
+    dataReader.reset();
+
+    // Zero copy buffers may still wrap the partition, so it can't be unmapped with the pipeline
+    EXPECT_CALL(*m_mainThreadMock, unregisterClient(m_kMainThreadClientId));
+    mainThreadWillEnqueueTaskAndWait();
+    m_mediaPipeline.reset();
+
+    EXPECT_CALL(*m_sharedMemoryBufferMock, unmapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
+        .WillOnce(Return(true));
+    attachedDataReader.reset();
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFromRingSlotSuccess)
+{
+    auto status = firebolt::rialto::MediaSourceStatus::OK;
+    std::uint8_t data{123};
+    constexpr std::uint32_t kShmSlot{2};
+    int offset = 2 * 1024 * 1024;
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(kShmSlot));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
-                                                         firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, kShmSlot))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kMaxSlotDataLen,
+                                 m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -342,13 +439,19 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataAudioSuccess
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
-                                                         firebolt::rialto::MediaSourceType::AUDIO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::AUDIO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::AUDIO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::AUDIO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::AUDIO, &data, offset, m_kMaxSlotDataLen,
+                                 m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -365,13 +468,19 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithE
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
-                                                         firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kMaxSlotDataLen,
+                                 m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::VIDEO));
@@ -389,11 +498,16 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessEosWi
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
-                                                         firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                  firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kMaxSlotDataLen));
     EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::VIDEO));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, 0, m_kNeedDataRequestId));
 }
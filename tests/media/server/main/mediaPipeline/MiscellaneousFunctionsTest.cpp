@@ -143,6 +143,7 @@ TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, SetPositionSuccess)
 
     EXPECT_CALL(*m_gstPlayerMock, setPosition(m_kPosition));
     EXPECT_TRUE(m_mediaPipeline->setPosition(m_kPosition));
+    EXPECT_EQ(readStatusPage().position, m_kPosition);
 }
 
 /**
@@ -173,6 +174,7 @@ TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, SetPlaybackRateSucce
 
     EXPECT_CALL(*m_gstPlayerMock, setPlaybackRate(m_kPlaybackRate));
     EXPECT_TRUE(m_mediaPipeline->setPlaybackRate(m_kPlaybackRate));
+    EXPECT_EQ(readStatusPage().playbackRate, m_kPlaybackRate);
 }
 
 /**
@@ -20,6 +20,7 @@
 #include "MediaPipelineTestBase.h"
 
 using ::testing::Ref;
+using ::testing::SaveArg;
 
 class RialtoServerMediaPipelineSourceTest : public MediaPipelineTestBase
 {
@@ -27,9 +28,17 @@ protected:
     int32_t m_id = 456;
     MediaSourceType m_type = MediaSourceType::AUDIO;
     const char *m_kMimeType = "video/mpeg";
+    const std::uint32_t m_kAudioRegionSize{1 * 1024 * 1024};
 
     RialtoServerMediaPipelineSourceTest() { createMediaPipeline(); }
 
+    void shmRegionWillBeResized(MediaSourceType type, std::uint32_t dataLen, bool result = true)
+    {
+        EXPECT_CALL(*m_sharedMemoryBufferMock,
+                    resizeData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, type, dataLen))
+            .WillOnce(Return(result));
+    }
+
     ~RialtoServerMediaPipelineSourceTest() { destroyMediaPipeline(); }
 };
 
@@ -45,6 +54,7 @@ TEST_F(RialtoServerMediaPipelineSourceTest, AttachSourceSuccess)
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
 
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
     EXPECT_NE(mediaSource->getId(), -1);
@@ -63,6 +73,7 @@ TEST_F(RialtoServerMediaPipelineSourceTest, AttachAudioSourceWitSpecificConfigur
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
 
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
     EXPECT_NE(mediaSource->getId(), -1);
@@ -93,6 +104,7 @@ TEST_F(RialtoServerMediaPipelineSourceTest, RemoveSourceSuccess)
     mainThreadWillEnqueueTaskAndWait();
 
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
     std::int32_t sourceId{mediaSource->getId()};
 
@@ -133,6 +145,7 @@ TEST_F(RialtoServerMediaPipelineSourceTest, AttachRemoveAttachSourceDifferentId)
 
     mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
     std::int32_t firstSourceId{mediaSource->getId()};
 
@@ -142,11 +155,73 @@ TEST_F(RialtoServerMediaPipelineSourceTest, AttachRemoveAttachSourceDifferentId)
 
     mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
 
     EXPECT_NE(mediaSource->getId(), firstSourceId);
 }
 
+/**
+ * Test that shm region is not resized on re-attach, while the player still uses data of the removed source.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AttachRemoveAttachSourceKeepsShmRegionUsedByPlayer)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>(-1, m_kMimeType);
+    constexpr std::uint32_t kNeedDataRequestId{0};
+    constexpr std::uint32_t kNumFrames{1};
+    constexpr std::uint32_t kMaxSlotDataLen{1024};
+    std::uint8_t data{123};
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    std::shared_ptr<IDataReader> attachedDataReader;
+
+    loadGstPlayer();
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_activeRequestsMock, getType(kNeedDataRequestId)).WillOnce(Return(MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(kNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getSlotDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::AUDIO,
+                                  0))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                             m_kSessionId, MediaSourceType::AUDIO))
+        .WillOnce(Return(kMaxSlotDataLen));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(MediaSourceType::AUDIO, &data, 0, kMaxSlotDataLen, kNumFrames))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader)).WillOnce(SaveArg<0>(&attachedDataReader));
+    EXPECT_TRUE(m_mediaPipeline->haveData(MediaSourceStatus::OK, kNumFrames, kNeedDataRequestId));
+    dataReader.reset();
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, removeSource(MediaSourceType::AUDIO));
+    EXPECT_EQ(m_mediaPipeline->removeSource(mediaSource->getId()), true);
+
+    // Region is still wrapped by the buffers of the removed source
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, removeSource(MediaSourceType::AUDIO));
+    EXPECT_EQ(m_mediaPipeline->removeSource(mediaSource->getId()), true);
+
+    // Region can be resized, once the player released it
+    attachedDataReader.reset();
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+}
+
 /**
  * Test that source id remains unchanged when source is updated only.
  */
@@ -159,6 +234,7 @@ TEST_F(RialtoServerMediaPipelineSourceTest, UpdateSourceIdNotChanged)
 
     mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize);
     EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
     std::int32_t firstSourceId{mediaSource->getId()};
 
@@ -170,3 +246,75 @@ TEST_F(RialtoServerMediaPipelineSourceTest, UpdateSourceIdNotChanged)
 
     EXPECT_EQ(mediaSource->getId(), firstSourceId);
 }
+
+/**
+ * Test that AttachSource succeeds with the previous shm region size when the region cannot be resized.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AttachSourceSuccessWhenShmRegionResizeFails)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>(-1, m_kMimeType);
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, m_kAudioRegionSize, false);
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+    EXPECT_NE(mediaSource->getId(), -1);
+}
+
+/**
+ * Test that the shm region of low bitrate audio codecs is smaller.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AttachLowBitrateAudioSourceResizesShmRegion)
+{
+    constexpr std::uint32_t kLowBitrateAudioRegionSize{256 * 1024};
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>(-1, "audio/mp4");
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::AUDIO, kLowBitrateAudioRegionSize);
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+}
+
+/**
+ * Test that the shm region of video source is sized for the maximum resolution of the session.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AttachVideoSourceResizesShmRegionForResolution)
+{
+    constexpr std::uint32_t kHdVideoRegionSize{4 * 1024 * 1024};
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceVideo>(-1, "video/h264");
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::VIDEO, kHdVideoRegionSize);
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+}
+
+/**
+ * Test that the shm region of high bitrate video codecs is bigger.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AttachHighBitrateVideoSourceResizesShmRegion)
+{
+    constexpr std::uint32_t kUhdVideoRegionSize{7 * 1024 * 1024};
+    std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+        std::make_unique<IMediaPipeline::MediaSourceVideo>(-1, "video/h265");
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(mediaSource)));
+    shmRegionWillBeResized(MediaSourceType::VIDEO, kUhdVideoRegionSize);
+
+    EXPECT_EQ(m_mediaPipeline->attachSource(mediaSource), true);
+}
@@ -48,6 +48,7 @@ void MediaPipelineTestBase::createMediaPipeline()
     EXPECT_CALL(*m_mainThreadMock, registerClient()).WillOnce(Return(m_kMainThreadClientId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, mapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
         .WillOnce(Return(true));
+    statusPageWillBeMapped();
     EXPECT_NO_THROW(
         m_mediaPipeline =
             std::make_unique<MediaPipelineServerInternal>(m_mediaPipelineClientMock, m_videoReq, m_gstPlayerFactoryMock,
@@ -59,6 +60,11 @@ void MediaPipelineTestBase::createMediaPipeline()
 
 void MediaPipelineTestBase::destroyMediaPipeline()
 {
+    if (!m_mediaPipeline)
+    {
+        // Already destroyed by the test
+        return;
+    }
     EXPECT_CALL(*m_sharedMemoryBufferMock, unmapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
         .WillOnce(Return(true));
     EXPECT_CALL(*m_mainThreadMock, unregisterClient(m_kMainThreadClientId));
@@ -68,6 +74,22 @@ void MediaPipelineTestBase::destroyMediaPipeline()
     m_mediaPipeline.reset();
 }
 
+void MediaPipelineTestBase::statusPageWillBeMapped()
+{
+    // The status page is placed at the beginning of the test buffer
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getStatusPageOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                                               m_kSessionId))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(m_statusPageBuffer));
+}
+
+firebolt::rialto::common::PlaybackStatus MediaPipelineTestBase::readStatusPage()
+{
+    firebolt::rialto::common::PlaybackStatus status;
+    EXPECT_TRUE(firebolt::rialto::common::ShmStatusPage{m_statusPageBuffer}.read(status));
+    return status;
+}
+
 void MediaPipelineTestBase::mainThreadWillEnqueueTask()
 {
     EXPECT_CALL(*m_mainThreadMock, enqueueTask(m_kMainThreadClientId, _))
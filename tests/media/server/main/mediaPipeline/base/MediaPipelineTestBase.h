@@ -82,12 +82,15 @@ protected:
     const int m_kSessionId{1};
     const int32_t m_kMainThreadClientId = {5};
     VideoRequirements m_videoReq = {123, 456};
+    alignas(8) std::uint8_t m_statusPageBuffer[firebolt::rialto::common::STATUS_PAGE_SIZE_BYTES] = {0};
 
     void createMediaPipeline();
     void destroyMediaPipeline();
     void mainThreadWillEnqueueTask();
     void mainThreadWillEnqueueTaskAndWait();
     void loadGstPlayer();
+    void statusPageWillBeMapped();
+    firebolt::rialto::common::PlaybackStatus readStatusPage();
 };
 
 #endif // MEDIA_PIPELINE_TEST_BASE_H_
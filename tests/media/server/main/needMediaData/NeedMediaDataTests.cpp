@@ -36,3 +36,9 @@ TEST_F(NeedMediaDataTests, shouldSendMessageInPrerollingState)
     initialize(firebolt::rialto::PlaybackState::PAUSED);
     needMediaDataWillBeSentBelowPlayingState();
 }
+
+TEST_F(NeedMediaDataTests, shouldSendMessageForRingSlot)
+{
+    initialize(firebolt::rialto::PlaybackState::PLAYING, 2);
+    needMediaDataWillBeSentInPlayingState();
+}
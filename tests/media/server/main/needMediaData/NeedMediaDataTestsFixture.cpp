@@ -55,17 +55,20 @@ NeedMediaDataTests::NeedMediaDataTests()
 {
 }
 
-void NeedMediaDataTests::initialize(firebolt::rialto::PlaybackState playbackState)
+void NeedMediaDataTests::initialize(firebolt::rialto::PlaybackState playbackState, std::uint32_t shmSlot)
 {
-    EXPECT_CALL(shmBufferMock, getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
-                                             kSessionId, kValidMediaSourceType))
+    m_shmSlot = shmSlot;
+    EXPECT_CALL(shmBufferMock,
+                getMaxSlotDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSessionId,
+                                  kValidMediaSourceType))
         .WillOnce(Return(kBufferLen));
-    EXPECT_CALL(shmBufferMock, getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
-                                             kSessionId, kValidMediaSourceType))
-        .WillOnce(Return(kMetadataOffset));
+    EXPECT_CALL(shmBufferMock,
+                getSlotDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSessionId,
+                                  kValidMediaSourceType, shmSlot))
+        .WillOnce(Return(kMetadataOffset + shmSlot * kBufferLen));
     m_sut = std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
                                                                       kSessionId, kValidMediaSourceType, kSourceId,
-                                                                      playbackState);
+                                                                      playbackState, shmSlot);
 }
 
 void NeedMediaDataTests::initializeWithWrongType()
@@ -73,7 +76,8 @@ void NeedMediaDataTests::initializeWithWrongType()
     m_sut =
         std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
                                                                   kSessionId, firebolt::rialto::MediaSourceType::UNKNOWN,
-                                                                  kSourceId, firebolt::rialto::PlaybackState::PLAYING);
+                                                                  kSourceId, firebolt::rialto::PlaybackState::PLAYING,
+                                                                  0);
 }
 
 void NeedMediaDataTests::needMediaDataWillBeSentInPlayingState()
@@ -81,10 +85,10 @@ void NeedMediaDataTests::needMediaDataWillBeSentInPlayingState()
     std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> expectedShmInfo{
         std::make_shared<firebolt::rialto::MediaPlayerShmInfo>()};
     expectedShmInfo->maxMetadataBytes = kMaxMetadataBytes;
-    expectedShmInfo->metadataOffset = kMetadataOffset;
-    expectedShmInfo->mediaDataOffset = kMetadataOffset + kMaxMetadataBytes;
+    expectedShmInfo->metadataOffset = kMetadataOffset + m_shmSlot * kBufferLen;
+    expectedShmInfo->mediaDataOffset = expectedShmInfo->metadataOffset + kMaxMetadataBytes;
     ASSERT_TRUE(m_sut);
-    EXPECT_CALL(activeRequestsMock, insert(kValidMediaSourceType, _)).WillOnce(Return(kRequestId));
+    EXPECT_CALL(activeRequestsMock, insert(kValidMediaSourceType, _, m_shmSlot)).WillOnce(Return(kRequestId));
     EXPECT_CALL(*m_clientMock, notifyNeedMediaData(kSourceId, kMaxFrames, kRequestId, expectedShmInfo));
     EXPECT_TRUE(m_sut->send());
 }
@@ -94,10 +98,10 @@ void NeedMediaDataTests::needMediaDataWillBeSentBelowPlayingState()
     std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> expectedShmInfo{
         std::make_shared<firebolt::rialto::MediaPlayerShmInfo>()};
     expectedShmInfo->maxMetadataBytes = kMaxMetadataBytes;
-    expectedShmInfo->metadataOffset = kMetadataOffset;
-    expectedShmInfo->mediaDataOffset = kMetadataOffset + kMaxMetadataBytes;
+    expectedShmInfo->metadataOffset = kMetadataOffset + m_shmSlot * kBufferLen;
+    expectedShmInfo->mediaDataOffset = expectedShmInfo->metadataOffset + kMaxMetadataBytes;
     ASSERT_TRUE(m_sut);
-    EXPECT_CALL(activeRequestsMock, insert(kValidMediaSourceType, _)).WillOnce(Return(kRequestId));
+    EXPECT_CALL(activeRequestsMock, insert(kValidMediaSourceType, _, m_shmSlot)).WillOnce(Return(kRequestId));
     EXPECT_CALL(*m_clientMock, notifyNeedMediaData(kSourceId, kPrerollingNumFrames, kRequestId, expectedShmInfo));
     EXPECT_TRUE(m_sut->send());
 }
@@ -25,6 +25,7 @@
 #include "MediaPipelineClientMock.h"
 #include "NeedMediaData.h"
 #include "SharedMemoryBufferMock.h"
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -36,7 +37,7 @@ public:
     NeedMediaDataTests();
     ~NeedMediaDataTests() override = default;
 
-    void initialize(firebolt::rialto::PlaybackState playbackState);
+    void initialize(firebolt::rialto::PlaybackState playbackState, std::uint32_t shmSlot = 0);
     void initializeWithWrongType();
 
     void needMediaDataWillBeSentInPlayingState();
@@ -45,6 +46,7 @@ public:
 
 private:
     std::unique_ptr<firebolt::rialto::server::NeedMediaData> m_sut;
+    std::uint32_t m_shmSlot{0};
     std::shared_ptr<StrictMock<firebolt::rialto::MediaPipelineClientMock>> m_clientMock;
     StrictMock<firebolt::rialto::server::ActiveRequestsMock> activeRequestsMock;
     StrictMock<firebolt::rialto::server::SharedMemoryBufferMock> shmBufferMock;
@@ -0,0 +1,172 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PlayerSnapshot.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::server;
+
+namespace
+{
+constexpr std::chrono::milliseconds kMaxAge{500};
+constexpr std::int64_t kPosition{1234};
+constexpr double kVolume{0.7};
+constexpr std::uint64_t kQueuedBytes{4096};
+} // namespace
+
+class RialtoServerPlayerSnapshotTest : public ::testing::Test
+{
+protected:
+    PlayerSnapshot m_snapshot;
+};
+
+/**
+ * Test that no values are served before they are published.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, EmptySnapshot)
+{
+    std::int64_t position{};
+    double volume{};
+    std::uint64_t queuedBytes{};
+    m_snapshot.setPlaybackState(PlaybackState::PLAYING);
+    EXPECT_FALSE(m_snapshot.getPosition(position, kMaxAge));
+    EXPECT_FALSE(m_snapshot.getVolume(volume, kMaxAge));
+    EXPECT_FALSE(m_snapshot.getQueuedBytes(queuedBytes, kMaxAge));
+}
+
+/**
+ * Test that the published values are served while they are fresh.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, PublishAndGet)
+{
+    m_snapshot.setPlaybackState(PlaybackState::PLAYING);
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    m_snapshot.setVolume(kVolume);
+    m_snapshot.setQueuedBytes(kQueuedBytes);
+
+    std::int64_t position{};
+    double volume{};
+    std::uint64_t queuedBytes{};
+    EXPECT_TRUE(m_snapshot.getPosition(position, kMaxAge));
+    EXPECT_GE(position, kPosition);
+    EXPECT_LT(position, kPosition + std::chrono::nanoseconds{kMaxAge}.count());
+    EXPECT_TRUE(m_snapshot.getVolume(volume, kMaxAge));
+    EXPECT_EQ(volume, kVolume);
+    EXPECT_TRUE(m_snapshot.getQueuedBytes(queuedBytes, kMaxAge));
+    EXPECT_EQ(queuedBytes, kQueuedBytes);
+}
+
+/**
+ * Test that the position is only served while playing.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, PositionNotServedWhenNotPlaying)
+{
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    std::int64_t position{};
+    EXPECT_FALSE(m_snapshot.getPosition(position, kMaxAge));
+
+    m_snapshot.setPlaybackState(PlaybackState::PAUSED);
+    EXPECT_FALSE(m_snapshot.getPosition(position, kMaxAge));
+}
+
+/**
+ * Test that the position is extrapolated with the playback rate.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, PositionExtrapolatedWithPlaybackRate)
+{
+    constexpr std::chrono::milliseconds kSleepTime{5};
+    m_snapshot.setPlaybackState(PlaybackState::PLAYING);
+    m_snapshot.setPlaybackRate(2.0);
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    std::this_thread::sleep_for(kSleepTime);
+
+    std::int64_t position{};
+    EXPECT_TRUE(m_snapshot.getPosition(position, kMaxAge));
+    EXPECT_GE(position, kPosition + 2 * std::chrono::nanoseconds{kSleepTime}.count());
+}
+
+/**
+ * Test that values older than the accepted age are not served.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, StaleValuesNotServed)
+{
+    constexpr std::chrono::milliseconds kShortMaxAge{1};
+    m_snapshot.setPlaybackState(PlaybackState::PLAYING);
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    m_snapshot.setVolume(kVolume);
+    m_snapshot.setQueuedBytes(kQueuedBytes);
+    std::this_thread::sleep_for(2 * kShortMaxAge);
+
+    std::int64_t position{};
+    double volume{};
+    std::uint64_t queuedBytes{};
+    EXPECT_FALSE(m_snapshot.getPosition(position, kShortMaxAge));
+    EXPECT_FALSE(m_snapshot.getVolume(volume, kShortMaxAge));
+    EXPECT_FALSE(m_snapshot.getQueuedBytes(queuedBytes, kShortMaxAge));
+}
+
+/**
+ * Test that invalidated and reset values are not served until published again.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, InvalidateAndReset)
+{
+    m_snapshot.setPlaybackState(PlaybackState::PLAYING);
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    m_snapshot.setVolume(kVolume);
+    m_snapshot.setQueuedBytes(kQueuedBytes);
+
+    std::int64_t position{};
+    double volume{};
+    std::uint64_t queuedBytes{};
+    m_snapshot.invalidatePosition();
+    EXPECT_FALSE(m_snapshot.getPosition(position, kMaxAge));
+    m_snapshot.invalidateVolume();
+    EXPECT_FALSE(m_snapshot.getVolume(volume, kMaxAge));
+    EXPECT_TRUE(m_snapshot.getQueuedBytes(queuedBytes, kMaxAge));
+
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    EXPECT_TRUE(m_snapshot.getPosition(position, kMaxAge));
+
+    m_snapshot.reset();
+    EXPECT_FALSE(m_snapshot.getQueuedBytes(queuedBytes, kMaxAge));
+    m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration());
+    EXPECT_FALSE(m_snapshot.getPosition(position, kMaxAge));
+}
+
+/**
+ * Test that a position sampled before the last invalidation is dropped.
+ */
+TEST_F(RialtoServerPlayerSnapshotTest, PositionOfOlderGenerationDropped)
+{
+    m_snapshot.setPlaybackState(PlaybackState::PLAYING);
+    const std::uint64_t kGeneration{m_snapshot.getPositionGeneration()};
+    m_snapshot.invalidatePosition();
+    EXPECT_NE(kGeneration, m_snapshot.getPositionGeneration());
+
+    std::int64_t position{};
+    EXPECT_FALSE(m_snapshot.setPosition(kPosition, kGeneration));
+    EXPECT_FALSE(m_snapshot.getPosition(position, kMaxAge));
+
+    EXPECT_TRUE(m_snapshot.setPosition(kPosition, m_snapshot.getPositionGeneration()));
+    EXPECT_TRUE(m_snapshot.getPosition(position, kMaxAge));
+    EXPECT_GE(position, kPosition);
+}
@@ -266,7 +266,7 @@ TEST_F(SharedMemoryBufferTests, shouldReturnAudioDataOffsetForOneGenericPlayback
 {
     constexpr int session1{0};
     // Audio buffer for first mapped session is after video buffer
-    constexpr std::uint32_t expectedOffset{m_videoBufferLen};
+    constexpr std::uint32_t expectedOffset{m_videoRegionCapacity};
     initialize();
     mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
     shouldReturnAudioDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1,
@@ -277,7 +277,7 @@ TEST_F(SharedMemoryBufferTests, shouldReturnAudioDataOffsetForOneWebAudioPlayer)
 {
     constexpr int handle1{0};
     // Audio buffer for first mapped session is after generic playback session buffer
-    constexpr std::uint32_t expectedOffset{m_audioBufferLen + m_videoBufferLen};
+    constexpr std::uint32_t expectedOffset{m_audioBufferLen + m_videoRegionCapacity};
     initialize();
     mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, handle1);
     shouldReturnAudioDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, handle1,
@@ -289,7 +289,7 @@ TEST_F(SharedMemoryBufferTests, shouldReturnVideoDataOffsetForTwoGenericPlayback
     constexpr int maxPlaybacks{2};
     constexpr int session1{0}, session2{1};
     // Video buffer for second mapped session is after video and audio buffer of 1st session
-    constexpr std::uint32_t expectedOffset{m_audioBufferLen + m_videoBufferLen};
+    constexpr std::uint32_t expectedOffset{m_audioBufferLen + m_videoRegionCapacity};
     initialize(maxPlaybacks);
     mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
     mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session2);
@@ -305,10 +305,10 @@ TEST_F(SharedMemoryBufferTests, shouldReturnAudioDataOffsetForTwoGenericPlayback
     constexpr int handle1{0}, handle2{1};
     // Audio buffer for second mapped session is after video and audio buffer of 1st session
     // and video buffer of 2nd session
-    constexpr std::uint32_t expectedOffsetSecondGeneric{m_audioBufferLen + 2 * m_videoBufferLen};
+    constexpr std::uint32_t expectedOffsetSecondGeneric{m_audioBufferLen + 2 * m_videoRegionCapacity};
     // Audio buffer for second mapped web audio player is after video and audio buffer of 1st and 2nd generic playback
     // sessions and the audio buffer of the 1st web audio player
-    constexpr std::uint32_t expectedOffsetSecondWebAudio{2 * m_audioBufferLen + 2 * m_videoBufferLen +
+    constexpr std::uint32_t expectedOffsetSecondWebAudio{2 * m_audioBufferLen + 2 * m_videoRegionCapacity +
                                                          m_webAudioBufferLen};
     initialize(maxPlaybacks, maxWebAudioPlayers);
     mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
@@ -376,10 +376,10 @@ TEST_F(SharedMemoryBufferTests, shouldGetDataPtrForGenericPlaybackSessions)
     EXPECT_NE(nullptr, session1Audio);
     EXPECT_NE(nullptr, session2Video);
     EXPECT_NE(nullptr, session2Audio);
-    EXPECT_EQ((session1Audio - session1Video), (m_videoBufferLen));
+    EXPECT_EQ((session1Audio - session1Video), (m_videoRegionCapacity));
     EXPECT_EQ((session2Video - session1Audio), (m_audioBufferLen));
-    EXPECT_EQ((session2Video - session1Video), (m_videoBufferLen + m_audioBufferLen));
-    EXPECT_EQ((session2Audio - session2Video), (m_videoBufferLen));
+    EXPECT_EQ((session2Video - session1Video), (m_videoRegionCapacity + m_audioBufferLen));
+    EXPECT_EQ((session2Audio - session2Video), (m_videoRegionCapacity));
 }
 
 TEST_F(SharedMemoryBufferTests, shouldGetAudioDataPtrForWebAudioPlayers)
@@ -416,3 +416,129 @@ TEST_F(SharedMemoryBufferTests, shouldGetBuffer)
     initialize();
     shouldGetBuffer();
 }
+
+TEST_F(SharedMemoryBufferTests, shouldUseSingleSlotPerRegionByDefault)
+{
+    constexpr int session1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldReturnNumOfSlots(session1, 1);
+    shouldReturnVideoSlot(session1, 0, m_videoBufferLen);
+    shouldFailToReturnVideoSlotOffset(session1, 1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldDivideRegionsIntoRingSlots)
+{
+    constexpr int session1{0};
+    setenv("RIALTO_SHM_RING_SLOTS", "4", 1);
+    initialize();
+    unsetenv("RIALTO_SHM_RING_SLOTS");
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldReturnNumOfSlots(session1, 4);
+    shouldReturnVideoSlot(session1, 3, m_videoBufferLen / 4);
+    shouldFailToReturnVideoSlotOffset(session1, 4);
+    shouldClearVideoSlotData(session1, 1);
+    shouldFailToClearVideoSlotData(session1, 4);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldNotReturnSlotsForNotMappedGenericPlaybackSession)
+{
+    constexpr int session1{0};
+    initialize();
+    shouldReturnNumOfSlots(session1, 0);
+    shouldFailToClearVideoSlotData(session1, 0);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldResizeVideoDataWithinReservedCapacity)
+{
+    constexpr int session1{0};
+    constexpr std::uint32_t kSmallVideoLen{3 * 1024 * 1024};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldResizeVideoData(session1, kSmallVideoLen, kSmallVideoLen);
+    shouldReturnVideoSlot(session1, 0, kSmallVideoLen);
+    shouldResizeVideoData(session1, m_videoRegionCapacity, m_videoRegionCapacity);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldLimitResizedVideoDataToReservedCapacity)
+{
+    constexpr int session1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldResizeVideoData(session1, 2 * m_videoRegionCapacity, m_videoRegionCapacity);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldFailToResizeVideoData)
+{
+    constexpr int session1{0};
+    constexpr int handle1{0};
+    initialize();
+    shouldFailToResizeVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1,
+                                m_videoBufferLen);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldFailToResizeVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1, 0);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, handle1);
+    shouldFailToResizeVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, handle1,
+                                m_videoBufferLen);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldReleaseMemoryWhenVideoDataIsShrunk)
+{
+    constexpr int session1{0};
+    constexpr std::uint32_t kSmallVideoLen{1 * 1024 * 1024};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldReleaseVideoDataAfterShrinking(session1, kSmallVideoLen);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldRestoreDefaultDataLenAfterUnmap)
+{
+    constexpr int session1{0};
+    constexpr std::uint32_t kSmallVideoLen{3 * 1024 * 1024};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldResizeVideoData(session1, kSmallVideoLen, kSmallVideoLen);
+    unmapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldReturnMaxGenericVideoDataLen(session1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldReturnStatusPageOffsetAfterDataOfAllPartitions)
+{
+    constexpr int session1{0};
+    constexpr int session2{1};
+    constexpr std::uint32_t kDataSize{2 * (m_audioBufferLen + m_videoRegionCapacity) + m_webAudioBufferLen};
+    initialize(2, 1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session2);
+    shouldReturnStatusPageOffset(session1, kDataSize);
+    shouldReturnStatusPageOffset(session2, kDataSize + firebolt::rialto::common::STATUS_PAGE_SIZE_BYTES);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldFailToReturnStatusPageOffset)
+{
+    constexpr int session1{0};
+    constexpr int handle1{0};
+    initialize();
+    shouldFailToReturnStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                       session1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, handle1);
+    shouldFailToReturnStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO,
+                                       handle1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldClearStatusPageWhenPartitionIsUnmapped)
+{
+    constexpr int session1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, session1);
+    shouldClearStatusPageAfterUnmap(session1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldMapAndUnmapPartitionsFromManyThreads)
+{
+    constexpr int kNumOfSessions{4};
+    constexpr int kNumOfIterations{200};
+    initialize(kNumOfSessions);
+    shouldMapAndUnmapPartitionsConcurrently(kNumOfSessions, kNumOfIterations);
+}
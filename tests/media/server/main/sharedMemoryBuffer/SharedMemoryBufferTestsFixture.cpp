@@ -18,6 +18,10 @@
  */
 
 #include "SharedMemoryBufferTestsFixture.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 void SharedMemoryBufferTests::initialize(int maxPlaybacks, int maxWebAudioPlayers)
 {
@@ -163,6 +167,164 @@ void SharedMemoryBufferTests::shouldFailToGetDataPtr(
     EXPECT_EQ(nullptr, m_sut->getDataPtr(playbackType, id, mediaSourceType));
 }
 
+void SharedMemoryBufferTests::shouldReturnNumOfSlots(int id, std::uint32_t expectedNumOfSlots)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_EQ(m_sut->getNumOfSlots(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id),
+              expectedNumOfSlots);
+}
+
+void SharedMemoryBufferTests::shouldReturnVideoSlot(int id, std::uint32_t slot, std::uint32_t expectedSlotLen)
+{
+    ASSERT_TRUE(m_sut);
+    const std::uint32_t kRegionOffset{
+        m_sut->getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                             firebolt::rialto::MediaSourceType::VIDEO)};
+    EXPECT_EQ(m_sut->getMaxSlotDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                       firebolt::rialto::MediaSourceType::VIDEO),
+              expectedSlotLen);
+    EXPECT_EQ(m_sut->getSlotDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                       firebolt::rialto::MediaSourceType::VIDEO, slot),
+              kRegionOffset + slot * expectedSlotLen);
+}
+
+void SharedMemoryBufferTests::shouldFailToReturnVideoSlotOffset(int id, std::uint32_t slot)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_THROW(m_sut->getSlotDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                          firebolt::rialto::MediaSourceType::VIDEO, slot),
+                 std::runtime_error);
+}
+
+void SharedMemoryBufferTests::shouldClearVideoSlotData(int id, std::uint32_t slot)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_TRUE(m_sut->clearSlotData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                     firebolt::rialto::MediaSourceType::VIDEO, slot));
+}
+
+void SharedMemoryBufferTests::shouldFailToClearVideoSlotData(int id, std::uint32_t slot)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_FALSE(m_sut->clearSlotData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                      firebolt::rialto::MediaSourceType::VIDEO, slot));
+}
+
+void SharedMemoryBufferTests::shouldResizeVideoData(int id, std::uint32_t dataLen, std::uint32_t expectedDataLen)
+{
+    ASSERT_TRUE(m_sut);
+    const int kFd{m_sut->getFd()};
+    const std::uint32_t kSize{m_sut->getSize()};
+    const std::uint32_t kOffset{
+        m_sut->getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                             firebolt::rialto::MediaSourceType::VIDEO)};
+    EXPECT_TRUE(m_sut->resizeData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                  firebolt::rialto::MediaSourceType::VIDEO, dataLen));
+    EXPECT_EQ(m_sut->getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                   firebolt::rialto::MediaSourceType::VIDEO),
+              expectedDataLen);
+    EXPECT_EQ(m_sut->getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                   firebolt::rialto::MediaSourceType::VIDEO),
+              kOffset);
+    EXPECT_EQ(m_sut->getFd(), kFd);
+    EXPECT_EQ(m_sut->getSize(), kSize);
+}
+
+void SharedMemoryBufferTests::shouldFailToResizeVideoData(
+    firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id, std::uint32_t dataLen)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_FALSE(m_sut->resizeData(playbackType, id, firebolt::rialto::MediaSourceType::VIDEO, dataLen));
+}
+
+void SharedMemoryBufferTests::shouldReleaseVideoDataAfterShrinking(int id, std::uint32_t dataLen)
+{
+    ASSERT_TRUE(m_sut);
+    std::uint8_t *videoData{m_sut->getDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                              id, firebolt::rialto::MediaSourceType::VIDEO)};
+    ASSERT_NE(nullptr, videoData);
+    const std::uint32_t kDataLen{
+        m_sut->getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                             firebolt::rialto::MediaSourceType::VIDEO)};
+    memset(videoData, 0xAB, kDataLen);
+    EXPECT_TRUE(m_sut->resizeData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                  firebolt::rialto::MediaSourceType::VIDEO, dataLen));
+    // Data in the still used part is kept, released pages read back as zeroes
+    EXPECT_EQ(videoData[0], 0xAB);
+    EXPECT_EQ(videoData[dataLen - 1], 0xAB);
+    EXPECT_EQ(videoData[kDataLen - 1], 0x00);
+}
+
+void SharedMemoryBufferTests::shouldReturnStatusPageOffset(int id, std::uint32_t expectedOffset)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_EQ(m_sut->getStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id),
+              expectedOffset);
+}
+
+void SharedMemoryBufferTests::shouldFailToReturnStatusPageOffset(
+    firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_THROW(m_sut->getStatusPageOffset(playbackType, id), std::runtime_error);
+}
+
+void SharedMemoryBufferTests::shouldClearStatusPageAfterUnmap(int id)
+{
+    ASSERT_TRUE(m_sut);
+    const std::uint32_t kOffset{
+        m_sut->getStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id)};
+    std::uint8_t *statusPage{m_sut->getBuffer() + kOffset};
+    memset(statusPage, 0xAB, firebolt::rialto::common::STATUS_PAGE_SIZE_BYTES);
+    EXPECT_TRUE(m_sut->unmapPartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id));
+    EXPECT_EQ(statusPage[0], 0x00);
+    EXPECT_EQ(statusPage[firebolt::rialto::common::STATUS_PAGE_SIZE_BYTES - 1], 0x00);
+}
+
+void SharedMemoryBufferTests::shouldMapAndUnmapPartitionsConcurrently(int numOfSessions, int numOfIterations)
+{
+    ASSERT_TRUE(m_sut);
+    constexpr auto kGeneric{firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> sessions;
+    for (int id = 0; id < numOfSessions; ++id)
+    {
+        sessions.emplace_back(
+            [&, id]()
+            {
+                for (int i = 0; i < numOfIterations; ++i)
+                {
+                    // Two sessions claiming the same free partition would make one of the unmaps fail
+                    try
+                    {
+                        if (!m_sut->mapPartition(kGeneric, id) ||
+                            !m_sut->getDataPtr(kGeneric, id, firebolt::rialto::MediaSourceType::VIDEO) ||
+                            !m_sut->resizeData(kGeneric, id, firebolt::rialto::MediaSourceType::AUDIO,
+                                               m_audioBufferLen / 2) ||
+                            m_sut->getStatusPageOffset(kGeneric, id) >= m_sut->getSize() ||
+                            !m_sut->unmapPartition(kGeneric, id))
+                        {
+                            ++failures;
+                        }
+                    }
+                    catch (const std::exception &e)
+                    {
+                        ++failures;
+                    }
+                }
+            });
+    }
+    for (auto &session : sessions)
+    {
+        session.join();
+    }
+    EXPECT_EQ(failures, 0);
+    for (int id = 0; id < numOfSessions; ++id)
+    {
+        EXPECT_TRUE(m_sut->mapPartition(kGeneric, id));
+    }
+}
+
 void SharedMemoryBufferTests::shouldGetFd()
 {
     ASSERT_TRUE(m_sut);
@@ -172,7 +334,8 @@ void SharedMemoryBufferTests::shouldGetFd()
 void SharedMemoryBufferTests::shouldGetSize()
 {
     ASSERT_TRUE(m_sut);
-    EXPECT_EQ(m_audioBufferLen + m_videoBufferLen + m_webAudioBufferLen,
+    EXPECT_EQ(m_audioBufferLen + m_videoRegionCapacity + m_webAudioBufferLen +
+                  firebolt::rialto::common::STATUS_PAGE_SIZE_BYTES,
               m_sut->getSize()); // Size for one session & one webaudio
 }
 
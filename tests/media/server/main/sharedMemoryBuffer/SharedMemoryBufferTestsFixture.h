@@ -21,12 +21,14 @@
 #define SHARED_MEMORY_BUFFER_TESTS_FIXTURE_H_
 
 #include "SharedMemoryBuffer.h"
+#include "ShmStatusPage.h"
 #include <gtest/gtest.h>
 #include <memory>
 
-constexpr std::uint32_t m_audioBufferLen{1 * 1024 * 1024}; // 1MB
-constexpr std::uint32_t m_videoBufferLen{7 * 1024 * 1024}; // 7MB
-constexpr std::uint32_t m_webAudioBufferLen{10 * 1024};    // 10KB
+constexpr std::uint32_t m_audioBufferLen{1 * 1024 * 1024};       // 1MB
+constexpr std::uint32_t m_videoBufferLen{7 * 1024 * 1024};       // 7MB
+constexpr std::uint32_t m_webAudioBufferLen{10 * 1024};          // 10KB
+constexpr std::uint32_t m_videoRegionCapacity{14 * 1024 * 1024}; // 14MB
 
 class SharedMemoryBufferTests : public testing::Test
 {
@@ -66,6 +68,20 @@ public:
                               const firebolt::rialto::MediaSourceType &mediaSourceType);
     void shouldFailToGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id,
                                 const firebolt::rialto::MediaSourceType &mediaSourceType);
+    void shouldReturnNumOfSlots(int id, std::uint32_t expectedNumOfSlots);
+    void shouldReturnVideoSlot(int id, std::uint32_t slot, std::uint32_t expectedSlotLen);
+    void shouldFailToReturnVideoSlotOffset(int id, std::uint32_t slot);
+    void shouldClearVideoSlotData(int id, std::uint32_t slot);
+    void shouldFailToClearVideoSlotData(int id, std::uint32_t slot);
+    void shouldResizeVideoData(int id, std::uint32_t dataLen, std::uint32_t expectedDataLen);
+    void shouldFailToResizeVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
+                                     int id, std::uint32_t dataLen);
+    void shouldReleaseVideoDataAfterShrinking(int id, std::uint32_t dataLen);
+    void shouldReturnStatusPageOffset(int id, std::uint32_t expectedOffset);
+    void shouldFailToReturnStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
+                                            int id);
+    void shouldClearStatusPageAfterUnmap(int id);
+    void shouldMapAndUnmapPartitionsConcurrently(int numOfSessions, int numOfIterations);
     void shouldGetFd();
     void shouldGetSize();
     void shouldGetBuffer();
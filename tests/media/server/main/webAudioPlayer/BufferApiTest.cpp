@@ -440,3 +440,27 @@ TEST_F(RialtoServerWebAudioPlayerBufferApiTest, getBufferDelayQueuedBytes)
 
     expectCancelTimer();
 }
+
+/**
+ * Test that getBufferDelay returns the delayed frames from the player snapshot, without a main thread hop.
+ */
+TEST_F(RialtoServerWebAudioPlayerBufferApiTest, getBufferDelayFromPlayerSnapshot)
+{
+    // Fill the shared memory with data
+    getBufferAvailableSuccess(m_maxFrame);
+    expectWriteNewFrames(m_maxFrame / 2, 0);
+    expectStartTimer();
+    writeBufferSuccess(m_maxFrame / 2);
+
+    uint32_t returnDelayFrames{};
+    const uint64_t kFramesInGst = 400;
+    const uint64_t kFramesInShm = m_maxFrame / 2;
+
+    m_webAudioPlayer->notifyBufferLevel(kFramesInGst * m_bytesPerFrame);
+
+    bool status = m_webAudioPlayer->getBufferDelay(returnDelayFrames);
+    EXPECT_EQ(status, true);
+    EXPECT_EQ(returnDelayFrames, kFramesInShm + kFramesInGst);
+
+    expectCancelTimer();
+}
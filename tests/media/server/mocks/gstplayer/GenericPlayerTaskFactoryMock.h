@@ -55,6 +55,8 @@ public:
                 (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createPause, (IGstGenericPlayerPrivate & player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createPlay, (IGstGenericPlayerPrivate & player), (const, override));
+    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createNotifyNeedMediaData,
+                (IGstGenericPlayerPrivate & player, const firebolt::rialto::MediaSourceType &type), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createReadShmDataAndAttachSamples,
                 (GenericPlayerContext & context, IGstGenericPlayerPrivate &player,
                  const std::shared_ptr<IDataReader> &dataReader),
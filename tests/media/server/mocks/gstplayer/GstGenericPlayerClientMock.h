@@ -38,6 +38,8 @@ public:
     MOCK_METHOD(void, clearActiveRequestsCache, (), (override));
     MOCK_METHOD(void, invalidateActiveRequests, (const MediaSourceType &type), (override));
     MOCK_METHOD(void, notifyQos, (MediaSourceType mediaSourceType, const QosInfo &qosInfo), (override));
+    MOCK_METHOD(void, notifyBufferLevel, (MediaSourceType mediaSourceType, std::uint64_t queuedBytes), (override));
+    MOCK_METHOD(void, notifyVolume, (double volume), (override));
 };
 } // namespace firebolt::rialto::server
 
@@ -30,6 +30,7 @@ class GstGenericPlayerPrivateMock : public IGstGenericPlayerPrivate
 public:
     MOCK_METHOD(void, scheduleSourceSetupFinish, (), (override));
     MOCK_METHOD(void, scheduleNeedMediaData, (GstAppSrc * src), (override));
+    MOCK_METHOD(void, scheduleNotifyNeedMediaData, (MediaSourceType type), (override));
     MOCK_METHOD(void, scheduleEnoughData, (GstAppSrc * src), (override));
     MOCK_METHOD(void, scheduleAudioUnderflow, (), (override));
     MOCK_METHOD(void, scheduleVideoUnderflow, (), (override));
@@ -37,6 +38,9 @@ public:
     MOCK_METHOD(bool, setWesterossinkSecondaryVideo, (), (override));
     MOCK_METHOD(void, notifyNeedMediaData, (bool audioNotificationNeeded, bool videoNotificationNeeded), (override));
     MOCK_METHOD(GstBuffer *, createBuffer, (const IMediaPipeline::MediaSegment &mediaSegment), (const, override));
+    MOCK_METHOD(GstBuffer *, createZeroCopyBuffer,
+                (const IMediaPipeline::MediaSegment &mediaSegment, const std::shared_ptr<IDataReader> &dataReader),
+                (const, override));
     MOCK_METHOD(void, attachAudioData, (), (override));
     MOCK_METHOD(void, attachVideoData, (), (override));
     MOCK_METHOD(void, updateAudioCaps, (int32_t rate, int32_t channels), (override));
@@ -32,6 +32,7 @@ public:
     virtual ~GstWebAudioPlayerClientMock() = default;
 
     MOCK_METHOD(void, notifyState, (WebAudioPlayerState state), (override));
+    MOCK_METHOD(void, notifyBufferLevel, (uint64_t queuedBytes), (override));
 };
 } // namespace firebolt::rialto::server
 
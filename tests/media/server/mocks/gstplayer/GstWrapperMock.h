@@ -90,6 +90,7 @@ public:
     MOCK_METHOD(void, gstMessageUnref, (GstMessage *), (override));
     MOCK_METHOD(GstMessage *, gstBusTimedPopFiltered, (GstBus * bus, GstClockTime timeout, GstMessageType types),
                 (override));
+    MOCK_METHOD(void, gstBusGetPollfd, (GstBus * bus, GPollFD * fd), (override));
     MOCK_METHOD(void, gstDebugBinToDotFileWithTs, (GstBin * bin, GstDebugGraphDetails details, const gchar *file_name),
                 (override));
     MOCK_METHOD(GstElementFactory *, gstElementGetFactory, (GstElement * element), (const, override));
@@ -133,6 +134,10 @@ public:
     MOCK_METHOD(gboolean, gstByteWriterPutUint16Be, (GstByteWriter * writer, guint16 val), (const, override));
     MOCK_METHOD(gboolean, gstByteWriterPutUint32Be, (GstByteWriter * writer, guint32 val), (const, override));
     MOCK_METHOD(GstBuffer *, gstBufferNewWrapped, (gpointer data, gsize size), (const, override));
+    MOCK_METHOD(GstBuffer *, gstBufferNewWrappedFull,
+                (GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset, gsize size, gpointer user_data,
+                 GDestroyNotify notify),
+                (const, override));
     MOCK_METHOD(GstCaps *, gstCodecUtilsOpusCreateCapsFromHeader, (gconstpointer data, guint size), (const, override));
     MOCK_METHOD(gboolean, gstCapsIsSubset, (const GstCaps *subset, const GstCaps *superset), (const));
     MOCK_METHOD(gboolean, gstCapsIsStrictlyEqual, (const GstCaps *caps1, const GstCaps *caps2), (const));
@@ -32,6 +32,7 @@ public:
     MOCK_METHOD(void, stop, (), (override));
     MOCK_METHOD(void, join, (), (override));
     MOCK_METHOD(void, enqueueTask, (std::unique_ptr<IPlayerTask> && task), (override));
+    MOCK_METHOD(Metrics, getMetrics, (), (const, override));
 };
 } // namespace firebolt::rialto::server
 
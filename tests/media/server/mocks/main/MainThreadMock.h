@@ -34,6 +34,7 @@ public:
     MOCK_METHOD(void, unregisterClient, (uint32_t clientId), (override));
     MOCK_METHOD(void, enqueueTask, (uint32_t clientId, Task task), (override));
     MOCK_METHOD(void, enqueueTaskAndWait, (uint32_t clientId, Task task), (override));
+    MOCK_METHOD(bool, getStrandMetrics, (uint32_t clientId, StrandMetrics &metrics), (const, override));
 };
 } // namespace firebolt::rialto::server::mock
 
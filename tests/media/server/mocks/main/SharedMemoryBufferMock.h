@@ -38,6 +38,19 @@ public:
                 (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType), (const, override));
     MOCK_METHOD(std::uint8_t *, getDataPtr,
                 (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType), (const, override));
+    MOCK_METHOD(bool, resizeData,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType, std::uint32_t dataLen),
+                (override));
+    MOCK_METHOD(std::uint32_t, getNumOfSlots, (MediaPlaybackType playbackType, int id), (const, override));
+    MOCK_METHOD(bool, clearSlotData,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType, std::uint32_t slot),
+                (const, override));
+    MOCK_METHOD(std::uint32_t, getSlotDataOffset,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType, std::uint32_t slot),
+                (const, override));
+    MOCK_METHOD(std::uint32_t, getMaxSlotDataLen,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType), (const, override));
+    MOCK_METHOD(std::uint32_t, getStatusPageOffset, (MediaPlaybackType playbackType, int id), (const, override));
     MOCK_METHOD(int, getFd, (), (const, override));
     MOCK_METHOD(std::uint32_t, getSize, (), (const, override));
     MOCK_METHOD(std::uint8_t *, getBuffer, (), (const, override));
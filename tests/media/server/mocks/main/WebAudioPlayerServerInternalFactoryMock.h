@@ -35,7 +35,7 @@ public:
                 (std::weak_ptr<IWebAudioPlayerClient> client, const std::string &audioMimeType, const uint32_t priority,
                  const WebAudioConfig *config),
                 (const, override));
-    MOCK_METHOD(std::unique_ptr<IWebAudioPlayer>, createWebAudioPlayerServerInternal,
+    MOCK_METHOD(std::unique_ptr<IWebAudioPlayerServerInternal>, createWebAudioPlayerServerInternal,
                 (std::weak_ptr<IWebAudioPlayerClient> client, const std::string &audioMimeType, const uint32_t priority,
                  const WebAudioConfig *config, const std::shared_ptr<ISharedMemoryBuffer> &shmBuffer, int handle),
                 (const, override));
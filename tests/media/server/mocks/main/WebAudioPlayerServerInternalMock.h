@@ -20,7 +20,7 @@
 #ifndef FIREBOLT_RIALTO_SERVER_WEB_AUDIO_PLAYER_SERVER_INTERNAL_MOCK_H_
 #define FIREBOLT_RIALTO_SERVER_WEB_AUDIO_PLAYER_SERVER_INTERNAL_MOCK_H_
 
-#include "IWebAudioPlayer.h"
+#include "IWebAudioPlayerServerInternalFactory.h"
 #include <gmock/gmock.h>
 #include <memory>
 #include <string>
@@ -28,7 +28,7 @@
 
 namespace firebolt::rialto::server
 {
-class WebAudioPlayerServerInternalMock : public IWebAudioPlayer
+class WebAudioPlayerServerInternalMock : public IWebAudioPlayerServerInternal
 {
 public:
     MOCK_METHOD(bool, play, (), (override));
@@ -37,6 +37,7 @@ public:
     MOCK_METHOD(bool, getBufferAvailable,
                 (uint32_t & availableFrames, std::shared_ptr<WebAudioShmInfo> &webAudioShmInfo), (override));
     MOCK_METHOD(bool, getBufferDelay, (uint32_t & delayFrames), (override));
+    MOCK_METHOD(bool, getBufferDelayFromSnapshot, (uint32_t & delayFrames), (override));
     MOCK_METHOD(bool, writeBuffer, (const uint32_t numberOfFrames, void *data), (override));
     MOCK_METHOD(bool, getDeviceInfo, (uint32_t & preferredFrames, uint32_t &maximumFrames, bool &supportDeferredPlay),
                 (override));
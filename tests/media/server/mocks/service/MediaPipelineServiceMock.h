@@ -43,11 +43,14 @@ public:
     MOCK_METHOD(bool, setPlaybackRate, (int, double), (override));
     MOCK_METHOD(bool, setPosition, (int, int64_t), (override));
     MOCK_METHOD(bool, getPosition, (int sessionId, int64_t &position), (override));
+    MOCK_METHOD(bool, getPositionFromSnapshot, (int sessionId, int64_t &position), (override));
     MOCK_METHOD(bool, setVideoWindow, (int, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t), (override));
     MOCK_METHOD(bool, haveData, (int, MediaSourceStatus, std::uint32_t, std::uint32_t), (override));
     MOCK_METHOD(bool, renderFrame, (int), (override));
     MOCK_METHOD(bool, setVolume, (int sessionId, double volume), (override));
     MOCK_METHOD(bool, getVolume, (int sessionId, double &volume), (override));
+    MOCK_METHOD(bool, getVolumeFromSnapshot, (int sessionId, double &volume), (override));
+    MOCK_METHOD(bool, getStatusPageOffset, (int sessionId, std::uint32_t &offset), (override));
     MOCK_METHOD(std::vector<std::string>, getSupportedMimeTypes, (MediaSourceType type), (override));
     MOCK_METHOD(bool, isMimeTypeSupported, (const std::string &mimeType), (override));
 };
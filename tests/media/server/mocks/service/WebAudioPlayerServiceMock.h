@@ -42,6 +42,7 @@ public:
     MOCK_METHOD(bool, getBufferAvailable,
                 (int handle, uint32_t &availableFrames, std::shared_ptr<WebAudioShmInfo> &webAudioShmInfo), (override));
     MOCK_METHOD(bool, getBufferDelay, (int handle, uint32_t &delayFrames), (override));
+    MOCK_METHOD(bool, getBufferDelayFromSnapshot, (int handle, uint32_t &delayFrames), (override));
     MOCK_METHOD(bool, writeBuffer, (int handle, const uint32_t numberOfFrames, void *data), (override));
     MOCK_METHOD(bool, getDeviceInfo,
                 (int handle, uint32_t &preferredFrames, uint32_t &maximumFrames, bool &supportDeferredPlay), (override));
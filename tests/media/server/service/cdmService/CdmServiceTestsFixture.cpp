@@ -199,24 +199,22 @@ void CdmServiceTests::mediaKeysWillGetDrmTimeWithStatus(firebolt::rialto::MediaK
 
 void CdmServiceTests::mediaKeysWillDecryptWithStatus(firebolt::rialto::MediaKeyErrorStatus status)
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, decrypt(keySessionId, _, _, subSampleCount, _, _, initWithLast15)).WillOnce(Return(status));
 }
 
 void CdmServiceTests::mediaKeysWillSelectKeyIdWithStatus(firebolt::rialto::MediaKeyErrorStatus status)
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, selectKeyId(keySessionId, keyId)).WillOnce(Return(status));
 }
 
-void CdmServiceTests::mediaKeysWillNotFindMediaKeySession()
+void CdmServiceTests::keySessionWillBeCreated()
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(false));
+    mediaKeysWillCreateKeySessionWithStatus(firebolt::rialto::MediaKeyErrorStatus::OK);
+    createKeySessionShouldSucceed();
 }
 
 void CdmServiceTests::mediaKeysWillCheckIfKeySystemIsNetflix(bool result)
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, isNetflixKeySystem(keySessionId)).WillOnce(Return(result));
 }
 
@@ -391,26 +389,22 @@ void CdmServiceTests::getSupportedKeySystemVersionShouldFail()
 
 void CdmServiceTests::incrementSessionIdUsageCounter()
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, incrementSessionIdUsageCounter(keySessionId));
     m_sut.incrementSessionIdUsageCounter(keySessionId);
 }
 
 void CdmServiceTests::incrementSessionIdUsageCounterFails()
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(false));
     m_sut.incrementSessionIdUsageCounter(keySessionId);
 }
 
 void CdmServiceTests::decrementSessionIdUsageCounter()
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, decrementSessionIdUsageCounter(keySessionId));
     m_sut.decrementSessionIdUsageCounter(keySessionId);
 }
 
 void CdmServiceTests::decrementSessionIdUsageCounterFails()
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(false));
     m_sut.decrementSessionIdUsageCounter(keySessionId);
 }
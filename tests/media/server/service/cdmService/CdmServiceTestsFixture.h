@@ -60,7 +60,7 @@ public:
     void mediaKeysWillGetDrmTimeWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillDecryptWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillSelectKeyIdWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
-    void mediaKeysWillNotFindMediaKeySession();
+    void keySessionWillBeCreated();
     void mediaKeysWillCheckIfKeySystemIsNetflix(bool result);
 
     void mediaKeysCapabilitiesFactoryWillCreateMediaKeysCapabilities();
@@ -0,0 +1,66 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ContentionCountingMutex.h"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+
+using firebolt::rialto::server::service::ContentionCountingMutex;
+
+TEST(ContentionCountingMutexTests, shouldCountUncontendedLocks)
+{
+    ContentionCountingMutex mutex;
+    {
+        std::lock_guard<ContentionCountingMutex> lock{mutex};
+    }
+    {
+        std::lock_guard<ContentionCountingMutex> lock{mutex};
+    }
+    EXPECT_EQ(mutex.getLocks(), 2u);
+    EXPECT_EQ(mutex.getContendedLocks(), 0u);
+}
+
+TEST(ContentionCountingMutexTests, shouldNotCountFailedTryLock)
+{
+    ContentionCountingMutex mutex;
+    std::unique_lock<ContentionCountingMutex> lock{mutex};
+    std::thread thread{[&]() { EXPECT_FALSE(mutex.try_lock()); }};
+    thread.join();
+    lock.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+    EXPECT_EQ(mutex.getLocks(), 2u);
+    EXPECT_EQ(mutex.getContendedLocks(), 0u);
+}
+
+TEST(ContentionCountingMutexTests, shouldCountContendedLock)
+{
+    ContentionCountingMutex mutex;
+    std::unique_lock<ContentionCountingMutex> lock{mutex};
+    std::thread thread{[&]() { std::lock_guard<ContentionCountingMutex> threadLock{mutex}; }};
+    while (mutex.getContendedLocks() == 0)
+    {
+        std::this_thread::yield();
+    }
+    lock.unlock();
+    thread.join();
+    EXPECT_EQ(mutex.getLocks(), 2u);
+    EXPECT_EQ(mutex.getContendedLocks(), 1u);
+}
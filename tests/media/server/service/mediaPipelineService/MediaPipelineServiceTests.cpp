@@ -302,6 +302,19 @@ TEST_F(MediaPipelineServiceTests, shouldGetPosition)
     getPositionShouldSucceed();
 }
 
+TEST_F(MediaPipelineServiceTests, shouldFailToGetPositionFromSnapshotForNotExistingSession)
+{
+    createMediaPipelineShouldSuccess();
+    getPositionFromSnapshotShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldGetPositionFromSnapshot)
+{
+    initSession();
+    mediaPipelineWillGetPositionFromSnapshot();
+    getPositionFromSnapshotShouldSucceed();
+}
+
 TEST_F(MediaPipelineServiceTests, shouldGetSupportedMimeTypes)
 {
     createMediaPipelineShouldSuccess();
@@ -373,3 +386,54 @@ TEST_F(MediaPipelineServiceTests, shouldGetVolume)
     mediaPipelineWillGetVolume();
     getVolumeShouldSucceed();
 }
+
+TEST_F(MediaPipelineServiceTests, shouldFailToGetVolumeFromSnapshotForNotExistingSession)
+{
+    createMediaPipelineShouldSuccess();
+    getVolumeFromSnapshotShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldGetVolumeFromSnapshot)
+{
+    initSession();
+    mediaPipelineWillGetVolumeFromSnapshot();
+    getVolumeFromSnapshotShouldSucceed();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldFailToGetStatusPageOffsetForNotExistingSession)
+{
+    createMediaPipelineShouldSuccess();
+    getStatusPageOffsetShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldFailToGetStatusPageOffset)
+{
+    initSession();
+    playbackServiceWillReturnSharedMemoryBuffer();
+    shmBufferWillFailToReturnStatusPageOffset();
+    getStatusPageOffsetShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldGetStatusPageOffset)
+{
+    initSession();
+    playbackServiceWillReturnSharedMemoryBuffer();
+    shmBufferWillReturnStatusPageOffset();
+    getStatusPageOffsetShouldSucceed();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldNotHoldSessionLockWhileCallingMediaPipeline)
+{
+    initSession();
+    mediaPipelineWillGetPosition();
+    mediaPipelineWillGetPositionDuringPlay();
+    playShouldSucceed();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldKeepMediaPipelineAliveWhenSessionIsDestroyedDuringCall)
+{
+    initSession();
+    mediaPipelineWillDestroySessionDuringPlay();
+    playShouldSucceed();
+    playShouldFail();
+}
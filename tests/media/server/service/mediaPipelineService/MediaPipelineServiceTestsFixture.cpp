@@ -25,8 +25,10 @@
 
 using testing::_;
 using testing::ByMove;
+using testing::DoAll;
 using testing::Invoke;
 using testing::Return;
+using testing::SetArgReferee;
 using testing::Throw;
 
 namespace
@@ -48,6 +50,7 @@ constexpr firebolt::rialto::MediaSourceStatus status{firebolt::rialto::MediaSour
 constexpr std::uint32_t needDataRequestId{17};
 constexpr std::uint32_t numFrames{1};
 constexpr double volume{0.7};
+constexpr std::uint32_t statusPageOffset{16 * 1024 * 1024};
 } // namespace
 
 namespace firebolt::rialto
@@ -190,6 +193,12 @@ void MediaPipelineServiceTests::mediaPipelineWillFailToGetPosition()
     EXPECT_CALL(m_mediaPipelineMock, getPosition(_)).WillOnce(Return(false));
 }
 
+void MediaPipelineServiceTests::mediaPipelineWillGetPositionFromSnapshot()
+{
+    EXPECT_CALL(m_mediaPipelineMock, getPositionFromSnapshot(_))
+        .WillOnce(DoAll(SetArgReferee<0>(position), Return(true)));
+}
+
 void MediaPipelineServiceTests::mediaPipelineWillRenderFrame()
 {
     EXPECT_CALL(m_mediaPipelineMock, renderFrame()).WillOnce(Return(true));
@@ -221,11 +230,40 @@ void MediaPipelineServiceTests::mediaPipelineWillGetVolume()
             }));
 }
 
+void MediaPipelineServiceTests::mediaPipelineWillGetVolumeFromSnapshot()
+{
+    EXPECT_CALL(m_mediaPipelineMock, getVolumeFromSnapshot(_)).WillOnce(DoAll(SetArgReferee<0>(volume), Return(true)));
+}
+
 void MediaPipelineServiceTests::mediaPipelineWillFailToGetVolume()
 {
     EXPECT_CALL(m_mediaPipelineMock, getVolume(_)).WillOnce(Return(false));
 }
 
+void MediaPipelineServiceTests::mediaPipelineWillGetPositionDuringPlay()
+{
+    EXPECT_CALL(m_mediaPipelineMock, play())
+        .WillOnce(Invoke(
+            [&]()
+            {
+                std::int64_t currentPosition{};
+                EXPECT_TRUE(m_sut->getPosition(sessionId, currentPosition));
+                EXPECT_EQ(currentPosition, position);
+                return true;
+            }));
+}
+
+void MediaPipelineServiceTests::mediaPipelineWillDestroySessionDuringPlay()
+{
+    EXPECT_CALL(m_mediaPipelineMock, play())
+        .WillOnce(Invoke(
+            [&]()
+            {
+                EXPECT_TRUE(m_sut->destroySession(sessionId));
+                return true;
+            }));
+}
+
 void MediaPipelineServiceTests::mediaPipelineFactoryWillCreateMediaPipeline()
 {
     EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipelineServerInternal(_, requirements, _, _, _))
@@ -418,6 +456,19 @@ void MediaPipelineServiceTests::getPositionShouldFail()
     EXPECT_FALSE(m_sut->getPosition(sessionId, targetPosition));
 }
 
+void MediaPipelineServiceTests::getPositionFromSnapshotShouldSucceed()
+{
+    std::int64_t targetPosition{};
+    EXPECT_TRUE(m_sut->getPositionFromSnapshot(sessionId, targetPosition));
+    EXPECT_EQ(targetPosition, position);
+}
+
+void MediaPipelineServiceTests::getPositionFromSnapshotShouldFail()
+{
+    std::int64_t targetPosition{};
+    EXPECT_FALSE(m_sut->getPositionFromSnapshot(sessionId, targetPosition));
+}
+
 void MediaPipelineServiceTests::getSupportedMimeTypesSucceed()
 {
     firebolt::rialto::MediaSourceType type = firebolt::rialto::MediaSourceType::VIDEO;
@@ -466,6 +517,48 @@ void MediaPipelineServiceTests::getVolumeShouldFail()
     EXPECT_FALSE(m_sut->getVolume(sessionId, targetVolume));
 }
 
+void MediaPipelineServiceTests::getVolumeFromSnapshotShouldSucceed()
+{
+    double targetVolume{};
+    EXPECT_TRUE(m_sut->getVolumeFromSnapshot(sessionId, targetVolume));
+    EXPECT_EQ(targetVolume, volume);
+}
+
+void MediaPipelineServiceTests::getVolumeFromSnapshotShouldFail()
+{
+    double targetVolume{};
+    EXPECT_FALSE(m_sut->getVolumeFromSnapshot(sessionId, targetVolume));
+}
+
+void MediaPipelineServiceTests::shmBufferWillReturnStatusPageOffset()
+{
+    EXPECT_CALL(m_shmBufferMock,
+                getStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                    sessionId))
+        .WillOnce(Return(statusPageOffset));
+}
+
+void MediaPipelineServiceTests::shmBufferWillFailToReturnStatusPageOffset()
+{
+    EXPECT_CALL(m_shmBufferMock,
+                getStatusPageOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                    sessionId))
+        .WillOnce(Throw(std::runtime_error("Status page not found")));
+}
+
+void MediaPipelineServiceTests::getStatusPageOffsetShouldSucceed()
+{
+    std::uint32_t offset{};
+    EXPECT_TRUE(m_sut->getStatusPageOffset(sessionId, offset));
+    EXPECT_EQ(offset, statusPageOffset);
+}
+
+void MediaPipelineServiceTests::getStatusPageOffsetShouldFail()
+{
+    std::uint32_t offset{};
+    EXPECT_FALSE(m_sut->getStatusPageOffset(sessionId, offset));
+}
+
 void MediaPipelineServiceTests::clearMediaPipelines()
 {
     m_sut->clearMediaPipelines();
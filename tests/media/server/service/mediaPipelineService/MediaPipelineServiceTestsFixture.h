@@ -61,12 +61,16 @@ public:
     void mediaPipelineWillFailToHaveData();
     void mediaPipelineWillGetPosition();
     void mediaPipelineWillFailToGetPosition();
+    void mediaPipelineWillGetPositionFromSnapshot();
     void mediaPipelineWillRenderFrame();
     void mediaPipelineWillFailToRenderFrame();
     void mediaPipelineWillSetVolume();
     void mediaPipelineWillFailToSetVolume();
     void mediaPipelineWillGetVolume();
     void mediaPipelineWillFailToGetVolume();
+    void mediaPipelineWillGetVolumeFromSnapshot();
+    void mediaPipelineWillGetPositionDuringPlay();
+    void mediaPipelineWillDestroySessionDuringPlay();
 
     void mediaPipelineFactoryWillCreateMediaPipeline();
     void mediaPipelineFactoryWillReturnNullptr();
@@ -105,6 +109,8 @@ public:
     void haveDataShouldFail();
     void getPositionShouldSucceed();
     void getPositionShouldFail();
+    void getPositionFromSnapshotShouldSucceed();
+    void getPositionFromSnapshotShouldFail();
     void getSupportedMimeTypesSucceed();
     void isMimeTypeSupportedSucceed();
     void renderFrameShouldSucceed();
@@ -113,6 +119,12 @@ public:
     void setVolumeShouldFail();
     void getVolumeShouldSucceed();
     void getVolumeShouldFail();
+    void getVolumeFromSnapshotShouldSucceed();
+    void getVolumeFromSnapshotShouldFail();
+    void shmBufferWillReturnStatusPageOffset();
+    void shmBufferWillFailToReturnStatusPageOffset();
+    void getStatusPageOffsetShouldSucceed();
+    void getStatusPageOffsetShouldFail();
     void clearMediaPipelines();
     void initSession();
 
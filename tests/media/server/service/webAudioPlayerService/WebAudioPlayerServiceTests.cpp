@@ -177,6 +177,19 @@ TEST_F(WebAudioPlayerServiceTests, shouldGetBufferDelay)
     getBufferDelayShouldSucceed();
 }
 
+TEST_F(WebAudioPlayerServiceTests, shouldFailToGetBufferDelayFromSnapshotForNotExistingWebAudioPlayer)
+{
+    createWebAudioPlayerService();
+    getBufferDelayFromSnapshotShouldFail();
+}
+
+TEST_F(WebAudioPlayerServiceTests, shouldGetBufferDelayFromSnapshot)
+{
+    initWebAudioPlayer();
+    webAudioPlayerWillGetBufferDelayFromSnapshot();
+    getBufferDelayFromSnapshotShouldSucceed();
+}
+
 TEST_F(WebAudioPlayerServiceTests, shouldFailToWriteBufferForNotExistingWebAudioPlayer)
 {
     createWebAudioPlayerService();
@@ -256,3 +269,11 @@ TEST_F(WebAudioPlayerServiceTests, shouldGetVolume)
     webAudioPlayerWillGetVolume();
     getVolumeShouldSucceed();
 }
+
+TEST_F(WebAudioPlayerServiceTests, shouldNotHoldPlayerLockWhileCallingWebAudioPlayer)
+{
+    initWebAudioPlayer();
+    webAudioPlayerWillGetVolume();
+    webAudioPlayerWillGetVolumeDuringPlay();
+    playShouldSucceed();
+}
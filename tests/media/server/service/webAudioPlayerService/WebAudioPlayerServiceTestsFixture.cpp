@@ -112,6 +112,12 @@ void WebAudioPlayerServiceTests::webAudioPlayerWillFailToGetBufferDelay()
     EXPECT_CALL(m_webAudioPlayerMock, getBufferDelay(_)).WillOnce(Return(false));
 }
 
+void WebAudioPlayerServiceTests::webAudioPlayerWillGetBufferDelayFromSnapshot()
+{
+    EXPECT_CALL(m_webAudioPlayerMock, getBufferDelayFromSnapshot(_))
+        .WillOnce(DoAll(SetArgReferee<0>(delayFrames), Return(true)));
+}
+
 void WebAudioPlayerServiceTests::webAudioPlayerWillWriteBuffer()
 {
     EXPECT_CALL(m_webAudioPlayerMock, writeBuffer(numberOfFrames, _)).WillOnce(Return(true));
@@ -154,6 +160,19 @@ void WebAudioPlayerServiceTests::webAudioPlayerWillFailToGetVolume()
     EXPECT_CALL(m_webAudioPlayerMock, getVolume(_)).WillOnce(Return(false));
 }
 
+void WebAudioPlayerServiceTests::webAudioPlayerWillGetVolumeDuringPlay()
+{
+    EXPECT_CALL(m_webAudioPlayerMock, play())
+        .WillOnce(Invoke(
+            [&]()
+            {
+                double currentVolume{};
+                EXPECT_TRUE(m_sut->getVolume(webAudioPlayerHandle, currentVolume));
+                EXPECT_EQ(currentVolume, volume);
+                return true;
+            }));
+}
+
 void WebAudioPlayerServiceTests::webAudioPlayerFactoryWillCreateWebAudioPlayer()
 {
     EXPECT_CALL(*m_webAudioPlayerFactoryMock,
@@ -165,7 +184,7 @@ void WebAudioPlayerServiceTests::webAudioPlayerFactoryWillReturnNullptr()
 {
     EXPECT_CALL(*m_webAudioPlayerFactoryMock,
                 createWebAudioPlayerServerInternal(_, audioMimeType, priority, _, _, webAudioPlayerHandle))
-        .WillOnce(Return(ByMove(std::unique_ptr<firebolt::rialto::IWebAudioPlayer>())));
+        .WillOnce(Return(ByMove(std::unique_ptr<firebolt::rialto::server::IWebAudioPlayerServerInternal>())));
 }
 
 void WebAudioPlayerServiceTests::playbackServiceWillReturnActive()
@@ -277,6 +296,19 @@ void WebAudioPlayerServiceTests::getBufferDelayShouldFail()
     EXPECT_FALSE(m_sut->getBufferDelay(webAudioPlayerHandle, delayFramesReturn));
 }
 
+void WebAudioPlayerServiceTests::getBufferDelayFromSnapshotShouldSucceed()
+{
+    uint32_t delayFramesReturn{};
+    EXPECT_TRUE(m_sut->getBufferDelayFromSnapshot(webAudioPlayerHandle, delayFramesReturn));
+    EXPECT_EQ(delayFramesReturn, delayFrames);
+}
+
+void WebAudioPlayerServiceTests::getBufferDelayFromSnapshotShouldFail()
+{
+    uint32_t delayFramesReturn{};
+    EXPECT_FALSE(m_sut->getBufferDelayFromSnapshot(webAudioPlayerHandle, delayFramesReturn));
+}
+
 void WebAudioPlayerServiceTests::writeBufferShouldSucceed()
 {
     EXPECT_TRUE(m_sut->writeBuffer(webAudioPlayerHandle, numberOfFrames, nullptr));
@@ -46,6 +46,7 @@ public:
     void webAudioPlayerWillFailToGetBufferAvailable();
     void webAudioPlayerWillGetBufferDelay();
     void webAudioPlayerWillFailToGetBufferDelay();
+    void webAudioPlayerWillGetBufferDelayFromSnapshot();
     void webAudioPlayerWillWriteBuffer();
     void webAudioPlayerWillFailToWriteBuffer();
     void webAudioPlayerWillGetDeviceInfo();
@@ -54,6 +55,7 @@ public:
     void webAudioPlayerWillFailToSetVolume();
     void webAudioPlayerWillGetVolume();
     void webAudioPlayerWillFailToGetVolume();
+    void webAudioPlayerWillGetVolumeDuringPlay();
 
     void webAudioPlayerFactoryWillCreateWebAudioPlayer();
     void webAudioPlayerFactoryWillReturnNullptr();
@@ -79,6 +81,8 @@ public:
     void getBufferAvailableShouldFail();
     void getBufferDelayShouldSucceed();
     void getBufferDelayShouldFail();
+    void getBufferDelayFromSnapshotShouldSucceed();
+    void getBufferDelayFromSnapshotShouldFail();
     void writeBufferShouldSucceed();
     void writeBufferShouldFail();
     void getDeviceInfoShouldSucceed();
@@ -94,7 +98,7 @@ private:
     std::shared_ptr<StrictMock<firebolt::rialto::server::WebAudioPlayerServerInternalFactoryMock>> m_webAudioPlayerFactoryMock;
     std::shared_ptr<firebolt::rialto::server::ISharedMemoryBuffer> m_shmBuffer;
     StrictMock<firebolt::rialto::server::SharedMemoryBufferMock> &m_shmBufferMock;
-    std::unique_ptr<firebolt::rialto::IWebAudioPlayer> m_webAudioPlayer;
+    std::unique_ptr<firebolt::rialto::server::IWebAudioPlayerServerInternal> m_webAudioPlayer;
     StrictMock<firebolt::rialto::server::WebAudioPlayerServerInternalMock> &m_webAudioPlayerMock;
     StrictMock<firebolt::rialto::server::service::PlaybackServiceMock> m_playbackServiceMock;
     std::unique_ptr<firebolt::rialto::server::service::WebAudioPlayerService> m_sut;